@@ -96,6 +96,8 @@ set(OGRE_STATIC_LIB 0)
 set(OGRE_SET_PROFILING 0)
 set(OGRE_SET_PROFILING_EXHAUSTIVE 0)
 set(OGRE_SET_USE_SIMD 0)
+set(OGRE_SET_USE_AVX2 0)
+set(OGRE_SET_USE_AVX512 0)
 set(OGRE_SET_RESTRICT_ALIASING 0)
 set(OGRE_SET_IDSTRING_ALWAYS_READABLE 0)
 set(OGRE_SET_DISABLE_AMD_AGS 0)
@@ -199,6 +201,11 @@ endif()
 if (OGRE_SIMD_SSE2 OR OGRE_SIMD_NEON)
   set(OGRE_SET_USE_SIMD 1)
 endif()
+if (OGRE_SIMD_SSE2 AND OGRE_SIMD_AVX512)
+  set(OGRE_SET_USE_AVX512 1)
+elseif (OGRE_SIMD_SSE2 AND OGRE_SIMD_AVX2)
+  set(OGRE_SET_USE_AVX2 1)
+endif()
 if (OGRE_RESTRICT_ALIASING)
   set(OGRE_SET_RESTRICT_ALIASING 1)
 endif()
@@ -200,6 +200,8 @@ var_to_string(OGRE_CONFIG_MEMTRACK_RELEASE _memtrack_release)
 var_to_string(OGRE_CONFIG_STRING_USE_CUSTOM_ALLOCATOR _string)
 var_to_string(OGRE_SIMD_SSE2 _simdsse2)
 var_to_string(OGRE_SIMD_NEON _simdneon)
+var_to_string(OGRE_SIMD_AVX2 _simdavx2)
+var_to_string(OGRE_SIMD_AVX512 _simdavx512)
 # threading settings
 if (OGRE_CONFIG_THREADS EQUAL 0)
 	set(_threads "none")
@@ -227,6 +229,8 @@ set(_features "${_features}Memory tracker (debug):          ${_memtrack_debug}\n
 set(_features "${_features}Memory tracker (release):        ${_memtrack_release}\n")
 set(_features "${_features}Use SIMD (SSE2):                 ${_simdsse2}\n")
 set(_features "${_features}Use SIMD (NEON):                 ${_simdneon}\n")
+set(_features "${_features}Use SIMD (AVX2):                 ${_simdavx2}\n")
+set(_features "${_features}Use SIMD (AVX-512):              ${_simdavx512}\n")
 
 
 set(_features "${_features}\n----------------------------------------------------------------------------\n")
@@ -0,0 +1,234 @@
+/* AVX2 (8-wide) implementation of sin & cos
+
+   Straight port of sse_mathfun.h (see Math/Array/SSE2/Single) to 256-bit
+   registers. Only the functions used by MathlibAVX2 were ported (log_ps &
+   exp_ps are not needed), and the polynomials use the FMA3 instructions
+   that are always available alongside AVX2.
+
+   Inspired by Intel Approximate Math library, and based on the
+   corresponding algorithms of the cephes math library
+*/
+
+/* Copyright (C) 2007  Julien Pommier
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+
+  (this is the zlib license)
+*/
+
+#if __OGRE_HAVE_AVX2
+
+#    include <immintrin.h>
+
+typedef __m256  v8sf;  // vector of 8 float (avx)
+typedef __m256i v8si;  // vector of 8 int (avx2)
+
+#    define _PS256_CONST( Name, Val ) static const v8sf _ps256_##Name = _mm256_set1_ps( Val )
+#    define _PI32_256_CONST( Name, Val ) \
+        static const v8si _pi32_256_##Name = _mm256_set1_epi32( Val )
+
+_PS256_CONST( 1, 1.0f );
+_PS256_CONST( 0p5, 0.5f );
+_PS256_CONST( sign_mask, -0.0f );
+
+_PI32_256_CONST( 1, 1 );
+_PI32_256_CONST( inv1, ~1 );
+_PI32_256_CONST( 2, 2 );
+_PI32_256_CONST( 4, 4 );
+
+_PS256_CONST( minus_cephes_DP1, -0.78515625f );
+_PS256_CONST( minus_cephes_DP2, -2.4187564849853515625e-4f );
+_PS256_CONST( minus_cephes_DP3, -3.77489497744594108e-8f );
+_PS256_CONST( sincof_p0, -1.9515295891E-4f );
+_PS256_CONST( sincof_p1, 8.3321608736E-3f );
+_PS256_CONST( sincof_p2, -1.6666654611E-1f );
+_PS256_CONST( coscof_p0, 2.443315711809948E-005f );
+_PS256_CONST( coscof_p1, -1.388731625493765E-003f );
+_PS256_CONST( coscof_p2, 4.166664568298827E-002f );
+_PS256_CONST( cephes_FOPI, 1.27323954473516f );  // 4 / M_PI
+
+/* "Extended precision modular arithmetic"
+   x = ((x - y * DP1) - y * DP2) - y * DP3; */
+static inline v8sf sincos256_reduce( v8sf x, v8sf y )
+{
+    x = _mm256_fmadd_ps( y, _ps256_minus_cephes_DP1, x );
+    x = _mm256_fmadd_ps( y, _ps256_minus_cephes_DP2, x );
+    x = _mm256_fmadd_ps( y, _ps256_minus_cephes_DP3, x );
+    return x;
+}
+
+/* Evaluate the first polynom  (0 <= x <= Pi/4), z = x * x */
+static inline v8sf cos256_poly( v8sf z )
+{
+    v8sf y = _mm256_fmadd_ps( _ps256_coscof_p0, z, _ps256_coscof_p1 );
+    y = _mm256_fmadd_ps( y, z, _ps256_coscof_p2 );
+    y = _mm256_mul_ps( _mm256_mul_ps( y, z ), z );
+    y = _mm256_fnmadd_ps( z, _ps256_0p5, y );
+    return _mm256_add_ps( y, _ps256_1 );
+}
+
+/* Evaluate the second polynom  (Pi/4 <= x <= 0), z = x * x */
+static inline v8sf sin256_poly( v8sf x, v8sf z )
+{
+    v8sf y2 = _mm256_fmadd_ps( _ps256_sincof_p0, z, _ps256_sincof_p1 );
+    y2 = _mm256_fmadd_ps( y2, z, _ps256_sincof_p2 );
+    y2 = _mm256_mul_ps( y2, z );
+    return _mm256_fmadd_ps( y2, x, x );
+}
+
+/* evaluation of 8 sines at onces. Precision is excellent as long as x < 8192 */
+static inline v8sf sin256_ps( v8sf x )
+{  // any x
+    v8sf sign_bit = _mm256_and_ps( x, _ps256_sign_mask );
+    /* take the absolute value */
+    x = _mm256_andnot_ps( _ps256_sign_mask, x );
+
+    /* scale by 4/Pi */
+    v8sf y = _mm256_mul_ps( x, _ps256_cephes_FOPI );
+
+    /* store the integer part of y in emm2 */
+    v8si emm2 = _mm256_cvttps_epi32( y );
+    /* j=(j+1) & (~1) (see the cephes sources) */
+    emm2 = _mm256_add_epi32( emm2, _pi32_256_1 );
+    emm2 = _mm256_and_si256( emm2, _pi32_256_inv1 );
+    y = _mm256_cvtepi32_ps( emm2 );
+    /* get the swap sign flag */
+    v8si emm0 = _mm256_and_si256( emm2, _pi32_256_4 );
+    emm0 = _mm256_slli_epi32( emm0, 29 );
+    /* get the polynom selection mask
+       there is one polynom for 0 <= x <= Pi/4
+       and another one for Pi/4<x<=Pi/2
+
+       Both branches will be computed.
+    */
+    emm2 = _mm256_and_si256( emm2, _pi32_256_2 );
+    emm2 = _mm256_cmpeq_epi32( emm2, _mm256_setzero_si256() );
+
+    v8sf swap_sign_bit = _mm256_castsi256_ps( emm0 );
+    v8sf poly_mask = _mm256_castsi256_ps( emm2 );
+    sign_bit = _mm256_xor_ps( sign_bit, swap_sign_bit );
+
+    x = sincos256_reduce( x, y );
+
+    v8sf z = _mm256_mul_ps( x, x );
+    y = cos256_poly( z );
+    v8sf y2 = sin256_poly( x, z );
+
+    /* select the correct result from the two polynoms */
+    y = _mm256_blendv_ps( y, y2, poly_mask );
+    /* update the sign */
+    return _mm256_xor_ps( y, sign_bit );
+}
+
+/* almost the same as sin256_ps */
+static inline v8sf cos256_ps( v8sf x )
+{  // any x
+    /* take the absolute value */
+    x = _mm256_andnot_ps( _ps256_sign_mask, x );
+
+    /* scale by 4/Pi */
+    v8sf y = _mm256_mul_ps( x, _ps256_cephes_FOPI );
+
+    /* store the integer part of y in emm2 */
+    v8si emm2 = _mm256_cvttps_epi32( y );
+    /* j=(j+1) & (~1) (see the cephes sources) */
+    emm2 = _mm256_add_epi32( emm2, _pi32_256_1 );
+    emm2 = _mm256_and_si256( emm2, _pi32_256_inv1 );
+    y = _mm256_cvtepi32_ps( emm2 );
+
+    emm2 = _mm256_sub_epi32( emm2, _pi32_256_2 );
+
+    /* get the swap sign flag */
+    v8si emm0 = _mm256_andnot_si256( emm2, _pi32_256_4 );
+    emm0 = _mm256_slli_epi32( emm0, 29 );
+    /* get the polynom selection mask */
+    emm2 = _mm256_and_si256( emm2, _pi32_256_2 );
+    emm2 = _mm256_cmpeq_epi32( emm2, _mm256_setzero_si256() );
+
+    v8sf sign_bit = _mm256_castsi256_ps( emm0 );
+    v8sf poly_mask = _mm256_castsi256_ps( emm2 );
+
+    x = sincos256_reduce( x, y );
+
+    v8sf z = _mm256_mul_ps( x, x );
+    y = cos256_poly( z );
+    v8sf y2 = sin256_poly( x, z );
+
+    /* select the correct result from the two polynoms */
+    y = _mm256_blendv_ps( y, y2, poly_mask );
+    /* update the sign */
+    return _mm256_xor_ps( y, sign_bit );
+}
+
+/* since sin256_ps and cos256_ps are almost identical, sincos256_ps could replace both of them..
+   it is almost as fast, and gives you a free cosine with your sine */
+static inline void sincos256_ps( v8sf x, v8sf *s, v8sf *c )
+{
+    v8sf sign_bit_sin = _mm256_and_ps( x, _ps256_sign_mask );
+    /* take the absolute value */
+    x = _mm256_andnot_ps( _ps256_sign_mask, x );
+
+    /* scale by 4/Pi */
+    v8sf y = _mm256_mul_ps( x, _ps256_cephes_FOPI );
+
+    /* store the integer part of y in emm2 */
+    v8si emm2 = _mm256_cvttps_epi32( y );
+
+    /* j=(j+1) & (~1) (see the cephes sources) */
+    emm2 = _mm256_add_epi32( emm2, _pi32_256_1 );
+    emm2 = _mm256_and_si256( emm2, _pi32_256_inv1 );
+    y = _mm256_cvtepi32_ps( emm2 );
+
+    v8si emm4 = emm2;
+
+    /* get the swap sign flag for the sine */
+    v8si emm0 = _mm256_and_si256( emm2, _pi32_256_4 );
+    emm0 = _mm256_slli_epi32( emm0, 29 );
+    v8sf swap_sign_bit_sin = _mm256_castsi256_ps( emm0 );
+
+    /* get the polynom selection mask for the sine*/
+    emm2 = _mm256_and_si256( emm2, _pi32_256_2 );
+    emm2 = _mm256_cmpeq_epi32( emm2, _mm256_setzero_si256() );
+    v8sf poly_mask = _mm256_castsi256_ps( emm2 );
+
+    x = sincos256_reduce( x, y );
+
+    /* get the sign flag for the cosine */
+    emm4 = _mm256_sub_epi32( emm4, _pi32_256_2 );
+    emm4 = _mm256_andnot_si256( emm4, _pi32_256_4 );
+    emm4 = _mm256_slli_epi32( emm4, 29 );
+    v8sf sign_bit_cos = _mm256_castsi256_ps( emm4 );
+
+    sign_bit_sin = _mm256_xor_ps( sign_bit_sin, swap_sign_bit_sin );
+
+    v8sf z = _mm256_mul_ps( x, x );
+    y = cos256_poly( z );
+    v8sf y2 = sin256_poly( x, z );
+
+    /* select the correct result from the two polynoms */
+    v8sf ysin = _mm256_blendv_ps( y, y2, poly_mask );
+    v8sf ycos = _mm256_blendv_ps( y2, y, poly_mask );
+
+    /* update the sign */
+    *s = _mm256_xor_ps( ysin, sign_bit_sin );
+    *c = _mm256_xor_ps( ycos, sign_bit_cos );
+}
+
+#    undef _PS256_CONST
+#    undef _PI32_256_CONST
+
+#endif
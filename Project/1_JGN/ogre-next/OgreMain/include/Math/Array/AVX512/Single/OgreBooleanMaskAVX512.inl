@@ -0,0 +1,69 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE-Next
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+namespace Ogre
+{
+    inline ArrayMaskR BooleanMask4::getMask( bool b[ARRAY_PACKED_REALS] )
+    {
+        static_assert( sizeof( bool ) == 1, "This code relies on correct casting!" );
+        // Zero-extend the 16 bytes (each 0 or 1) to 32-bit and negate: 1 -> 0xffffffff
+        const __m512i asInt32 =
+            _mm512_cvtepu8_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i *>( b ) ) );
+        return _mm512_castsi512_ps( _mm512_sub_epi32( _mm512_setzero_si512(), asInt32 ) );
+    }
+    //--------------------------------------------------------------------------------------
+    inline ArrayMaskR BooleanMask4::getAllSetMask()
+    {
+        return _mm512_castsi512_ps( _mm512_set1_epi32( -1 ) );
+    }
+    //--------------------------------------------------------------------------------------
+    inline bool BooleanMask4::allBitsSet( bool mask0[ARRAY_PACKED_REALS],
+                                          bool mask1[ARRAY_PACKED_REALS] )
+    {
+        static_assert( sizeof( bool ) == 1 && sizeof( uint64 ) == 8,
+                       "This code relies on correct casting!" );
+        uint64 m0[2], m1[2];
+        memcpy( m0, mask0, sizeof( m0 ) );
+        memcpy( m1, mask1, sizeof( m1 ) );
+        return ( m0[0] & m1[0] & m0[1] & m1[1] ) == 0x0101010101010101ull;
+    }
+    //--------------------------------------------------------------------------------------
+    inline uint32 BooleanMask4::getScalarMask( ArrayMaskR mask )
+    {
+        return static_cast<uint32>( _ogre_mm512_movemask_ps( mask ) );
+    }
+    //--------------------------------------------------------------------------------------
+    inline uint32 BooleanMask4::getScalarMask( ArrayInt mask )
+    {
+        return static_cast<uint32>( _ogre_mm512_movemask_ps( _mm512_castsi512_ps( mask ) ) );
+    }
+
+    #define MASK_ALL_BITS_SET 16
+
+    #define IS_BIT_SET( bit, intMask ) ( (intMask & (1 << bit) ) != 0)
+}
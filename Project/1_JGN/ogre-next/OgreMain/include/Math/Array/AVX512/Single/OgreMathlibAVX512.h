@@ -0,0 +1,611 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE-Next
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef __MathlibAVX512_H__
+#define __MathlibAVX512_H__
+
+#if __OGRE_HAVE_AVX512
+
+#    ifndef __Mathlib_H__
+#        error "Don't include this file directly. include Math/Array/OgreMathlib.h"
+#    endif
+
+#    include "OgrePrerequisites.h"
+
+namespace Ogre
+{
+    class ArrayRadian
+    {
+        ArrayReal mRad;
+
+    public:
+        explicit ArrayRadian( ArrayReal r ) : mRad( r ) {}
+        // ArrayRadian ( const ArrayDegree& d );
+        ArrayRadian &operator=( const ArrayReal &f )
+        {
+            mRad = f;
+            return *this;
+        }
+        // ArrayRadian& operator = ( const ArrayDegree& d );
+
+        // ArrayReal valueDegrees() const; // see bottom of this file
+        ArrayReal valueRadians() const { return mRad; }
+
+        /** Wraps the given value to the range [-pi; pi]
+            The algorithm is:
+                const float signedPi = std::copysign( _PI, mRad );
+                const float wrappedValue = fmod( mRad + signedPi, TWO_PI );
+                mRad = wrappedValue - signedPi;
+        */
+        inline void wrapToRangeNPI_PI();
+
+        inline const ArrayRadian &operator+() const;
+        inline ArrayRadian        operator+( const ArrayRadian &r ) const;
+        // inline ArrayRadian operator + ( const ArrayDegree& d ) const;
+        inline ArrayRadian &operator+=( const ArrayRadian &r );
+        // inline ArrayRadian& operator += ( const ArrayDegree& d );
+        inline ArrayRadian operator-() const;
+        inline ArrayRadian operator-( const ArrayRadian &r ) const;
+        // inline ArrayRadian operator - ( const ArrayDegree& d ) const;
+        inline ArrayRadian &operator-=( const ArrayRadian &r );
+        // inline ArrayRadian& operator -= ( const ArrayDegree& d );
+        inline ArrayRadian  operator*( ArrayReal f ) const;
+        inline ArrayRadian  operator*( const ArrayRadian &f ) const;
+        inline ArrayRadian &operator*=( ArrayReal f );
+        inline ArrayRadian  operator/( ArrayReal f ) const;
+        inline ArrayRadian &operator/=( ArrayReal f );
+
+        inline ArrayReal operator<( const ArrayRadian &r ) const;
+        inline ArrayReal operator<=( const ArrayRadian &r ) const;
+        inline ArrayReal operator==( const ArrayRadian &r ) const;
+        inline ArrayReal operator!=( const ArrayRadian &r ) const;
+        inline ArrayReal operator>=( const ArrayRadian &r ) const;
+        inline ArrayReal operator>( const ArrayRadian &r ) const;
+    };
+
+    class _OgreExport MathlibAVX512
+    {
+    public:
+        static const ArrayReal HALF;             // 0.5f (x16)
+        static const ArrayReal ONE;              // 1.0f (x16)
+        static const ArrayReal THREE;            // 3.0f (x16)
+        static const ArrayReal NEG_ONE;          //-1.0f (x16)
+        static const ArrayReal PI;               // PI (x16)
+        static const ArrayReal TWO_PI;           // 2*PI (x16)
+        static const ArrayReal ONE_DIV_2PI;      // 1 / 2PI (x16)
+        static const ArrayReal fEpsilon;         // 1e-6f (x16)
+        static const ArrayReal fSqEpsilon;       // 1e-12f (x16)
+        static const ArrayReal OneMinusEpsilon;  // 1 - 1e-6f (x16)
+        static const ArrayReal fDeg2Rad;         // Math::fDeg2Rad (x16)
+        static const ArrayReal fRad2Deg;         // Math::fRad2Deg (x16)
+        static const ArrayReal FLOAT_MIN;        // FLT_MIN (x16)
+        static const ArrayReal SIGN_MASK;        // 0x80000000 (x16)
+        // INFINITE is taken in Windows, INFINITY by C99 (bloody macros). A joke on Infinite Tea
+        static const ArrayReal INFINITEA;  // Inf (x16)
+        static const ArrayReal MAX_NEG;    // Max negative number (x16)
+        static const ArrayReal MAX_POS;    // Max negative number (x16)
+        /// 0, 0, 0, 1. Only 128-bit wide: it's the last row of a single SimpleMatrixAf4x3
+        static const __m128 LAST_AFFINE_COLUMN;
+
+        /** Returns the absolute values of each 16 floats
+            @param
+                16 floating point values
+            @return
+                abs( a )
+        */
+        static inline ArrayReal Abs4( ArrayReal a ) { return _mm512_andnot_ps( _mm512_set1_ps( -0.0f ), a ); }
+
+        /** Branchless conditional move for 16 floating point values
+            @remarks
+                Will NOT work if any of the arguments contains Infinite
+                or NaNs or non-floating point values. If an exact binary
+                copy is needed, @see CmovRobust
+            @param
+                16 floating point values. Can't be NaN or Inf
+            @param
+                16 floating point values. Can't be NaN or Inf
+            @param
+                16 values containing either 0 or 0xffffffff
+                Any other value, the result is undefined
+            @return
+                r[i] = mask[i] != 0 ? arg1[i] : arg2[i]
+                Another way to say it:
+                    if( maskCondition[i] == true )
+                        r[i] = arg1[i];
+                    else
+                        arg2[i];
+        */
+        static inline ArrayReal Cmov4( ArrayReal arg1, ArrayReal arg2, ArrayMaskR mask )
+        {
+            assert( _ogre_mm512_movemask_ps( _ogre_mm512_cmpeq_ps( arg1, arg1 ) ) == 0xffff &&
+                    _ogre_mm512_movemask_ps( _ogre_mm512_cmpeq_ps( arg2, arg2 ) ) == 0xffff &&
+                    "Passing NaN values to CMov4" );
+#    ifndef NDEBUG
+            ArrayReal newNan1 = _mm512_mul_ps( arg1, _mm512_setzero_ps() );  //+-Inf * 0 = nan
+            ArrayReal newNan2 = _mm512_mul_ps( arg2, _mm512_setzero_ps() );  //+-Inf * 0 = nan
+            assert( _ogre_mm512_movemask_ps( _ogre_mm512_cmpeq_ps( newNan1, newNan1 ) ) == 0xffff &&
+                    _ogre_mm512_movemask_ps( _ogre_mm512_cmpeq_ps( newNan2, newNan2 ) ) == 0xffff &&
+                    "Passing +/- Infinity values to CMov4" );
+#    endif
+
+            ArrayReal t = _mm512_sub_ps( arg1, arg2 );            // t = arg1 - arg2
+            return _mm512_add_ps( arg2, _mm512_and_ps( t, mask ) );  // r = arg2 + (t & mask)
+        }
+
+        /** Robust, branchless conditional move for a 512-bit value.
+            @remarks
+                If you're looking to copy 16 floating point values that do
+                not contain Inf or Nans, @see Cmov4 which is faster.
+                This is because switching between registers flagged as
+                floating point to integer and back has a latency delay
+
+                For more information refer to Chapter 3.5.2.3
+                Bypass between Execution Domains, Intel® 64 and IA-32
+                Architectures Optimization Reference Manual Order
+                Number: 248966-026 April (and also Table 2-12)
+            @param
+                A value containing 512 bits
+            @param
+                A value containing 512 bits
+            @param
+                Mask, each bit is evaluated
+            @return
+                For each bit:
+                r[i] = mask[i] != 0 ? arg1[i] : arg2[i]
+                Another way to say it:
+                    if( maskCondition[i] == true )
+                        r[i] = arg1[i];
+                    else
+                        arg2[i];
+        */
+        static inline __m512 CmovRobust( __m512 arg1, __m512 arg2, __m512 mask )
+        {
+            return _mm512_or_ps( _mm512_and_ps( arg1, mask ), _mm512_andnot_ps( mask, arg2 ) );
+        }
+        static inline __m512d CmovRobust( __m512d arg1, __m512d arg2, __m512d mask )
+        {
+            return _mm512_or_pd( _mm512_and_pd( arg1, mask ), _mm512_andnot_pd( mask, arg2 ) );
+        }
+        static inline ArrayInt CmovRobust( ArrayInt arg1, ArrayInt arg2, ArrayMaskI mask )
+        {
+            return _mm512_or_si512( _mm512_and_si512( arg1, mask ), _mm512_andnot_si512( mask, arg2 ) );
+        }
+
+        /** Returns the result of "a & b"
+        @return
+            r[i] = a[i] & b[i];
+        */
+        static inline ArrayReal And( ArrayReal a, ArrayReal b ) { return _mm512_and_ps( a, b ); }
+        static inline ArrayInt  And( ArrayInt a, ArrayInt b ) { return _mm512_and_si512( a, b ); }
+
+        /** Returns the result of "a & b"
+        @return
+            r[i] = a[i] & b;
+        */
+        static inline __m512i And( __m512i a, uint32 b )
+        {
+            return _mm512_and_si512( a, _mm512_set1_epi32( static_cast<int>( b ) ) );
+        }
+
+        /** Test if "a AND b" will result in non-zero, returning 0xffffffff on those cases
+        @remarks
+            AVX-512 has a native test instruction (vptestmd), so unlike SSE2 & AVX2 no bit
+            flipping is needed; the resulting k mask is expanded back into a full register.
+        @par
+            Do not try to do a floating-point variation of this one. I already tried, but hit
+            a wall: 0x80000000 & 0x80000000 => returns 0, because in floating point, -0 == 0
+        @return
+            r[i] = (a[i] & b[i]) ? 0xffffffff : 0;
+        */
+        static inline __m512i TestFlags4( __m512i a, __m512i b )
+        {
+            return _mm512_movm_epi32( _mm512_test_epi32_mask( a, b ) );
+        }
+
+        /** Returns the result of "a & ~b"
+        @return
+            r[i] = a[i] & ~b[i];
+        */
+        static inline __m512i AndNot( __m512i a, __m512i b ) { return _mm512_andnot_si512( b, a ); }
+
+        /** Returns the result of "a | b"
+        @return
+            r[i] = a[i] | b[i];
+        */
+        static inline __m512  Or( __m512 a, __m512 b ) { return _mm512_or_ps( a, b ); }
+        static inline __m512i Or( __m512i a, __m512i b ) { return _mm512_or_si512( a, b ); }
+
+        /** Returns the result of "a < b"
+        @return
+            r[i] = a[i] < b[i] ? 0xffffffff : 0;
+        */
+        static inline __m512 CompareLess( __m512 a, __m512 b ) { return _ogre_mm512_cmplt_ps( a, b ); }
+
+        /** Returns the result of "a <= b"
+        @return
+            r[i] = a[i] <= b[i] ? 0xffffffff : 0;
+        */
+        static inline __m512 CompareLessEqual( __m512 a, __m512 b ) { return _ogre_mm512_cmple_ps( a, b ); }
+
+        /** Returns the result of "a > b"
+        @return
+            r[i] = a[i] > b[i] ? 0xffffffff : 0;
+        */
+        static inline __m512 CompareGreater( __m512 a, __m512 b ) { return _ogre_mm512_cmpgt_ps( a, b ); }
+
+        /** Returns the result of "a >= b"
+        @return
+            r[i] = a[i] >= b[i] ? 0xffffffff : 0;
+        */
+        static inline __m512 CompareGreaterEqual( __m512 a, __m512 b ) { return _ogre_mm512_cmpge_ps( a, b ); }
+
+        static inline ArrayReal SetAll( Real val ) { return _mm512_set1_ps( val ); }
+
+        static inline ArrayInt SetAll( uint32 val ) { return _mm512_set1_epi32( static_cast<int>( val ) ); }
+
+        static inline void Set( ArrayReal &_dst, Real val, size_t index )
+        {
+            float *dst = reinterpret_cast<float *>( &_dst );
+            dst[index] = val;
+        }
+
+        /** Returns the first entry in src
+        @return
+            src[0]
+        */
+        static inline Real Get0( ArrayReal src )
+        {
+            return _mm_cvtss_f32( _mm512_castps512_ps128( src ) );
+        }
+
+        /** Returns the result of "a == std::numeric_limits<float>::infinity()"
+        @return
+            r[i] = a[i] == Inf ? 0xffffffff : 0;
+        */
+        static inline ArrayReal isInfinity( ArrayReal a )
+        {
+            return _ogre_mm512_cmpeq_ps( a, MathlibAVX512::INFINITEA );
+        }
+
+        /// Truncates float to 32-bit integer
+        static inline ArrayInt Truncate( ArrayReal a ) { return _mm512_cvttps_epi32( a ); }
+
+        /// Converts 32-bit integer to float
+        static inline ArrayReal ConvertToF32( ArrayInt a ) { return _mm512_cvtepi32_ps( a ); }
+
+        /// Returns the maximum value between a and b
+        static inline ArrayReal Max( ArrayReal a, ArrayReal b ) { return _mm512_max_ps( a, b ); }
+
+        /// Returns the minimum value between a and b
+        static inline ArrayReal Min( ArrayReal a, ArrayReal b ) { return _mm512_min_ps( a, b ); }
+
+        /// Clamps the value to the range [0; 1]
+        static inline ArrayReal Saturate( ArrayReal a )
+        {
+            return _mm512_max_ps( _mm512_min_ps( a, ONE ), _mm512_setzero_ps() );
+        }
+
+        /// Returns:
+        ///     (int16)( saturate( a ) * 32767.5f );
+        static inline ArrayToS16 ToSnorm16( ArrayReal a )
+        {
+            // _mm512_cvtsepi32_epi16 already performs saturation. No need for us to do it.
+            a = _mm512_mul_ps( a, _mm512_set1_ps( 32767.5f ) );
+            return _mm512_cvtsepi32_epi16( _mm512_cvtps_epi32( a ) );
+        }
+
+        /// Returns:
+        ///     (int16)( saturate( a ) * 127.5f );
+        ///
+        /// Input a MUST be in range (-256.996; 256.996) for saturation to properly work.
+        /// Otherwise result will be wrong.
+        static inline ArrayToS8 ToSnorm8Unsafe( ArrayReal a )
+        {
+            // AVX-512 can saturate 32 -> 8 bit directly, so the range limitation of the
+            // other backends doesn't apply here. It's kept in the contract for consistency.
+            a = _mm512_mul_ps( a, _mm512_set1_ps( 127.5f ) );
+            return _mm512_cvtsepi32_epi8( _mm512_cvtps_epi32( a ) );
+        }
+
+        /** Extracts ARRAY_PACKED_REALS int16.
+        @param a
+            a must contain integers. Not floats.
+        @param outValues [out]
+            outValues[0] = (int16)a[0];
+            ...
+            outValues[15] = (int16)a[15];
+        */
+        static inline void extractS16( ArrayToS16 a, int16 outValues[ARRAY_PACKED_REALS] )
+        {
+            _mm256_storeu_si256( reinterpret_cast<__m256i *>( outValues ), a );
+        }
+
+        /** Extracts ARRAY_PACKED_REALS int8.
+        @param a
+            a must contain integers. Not floats.
+        @param outValues [out]
+            outValues[0] = (int8)a[0];
+            ...
+            outValues[15] = (int8)a[15];
+        */
+        static inline void extractS8( ArrayToS8 a, int8 outValues[ARRAY_PACKED_REALS] )
+        {
+            _mm_storeu_si128( reinterpret_cast<__m128i *>( outValues ), a );
+        }
+
+        /** Folds the four 128-bit lanes of a into one
+        @return
+            r[i] = min( a[i], a[i + 4], a[i + 8], a[i + 12] )
+        */
+        static inline __m128 FoldMin128( ArrayReal a )
+        {
+            __m256 t = _mm256_min_ps( _mm512_castps512_ps256( a ), _mm512_extractf32x8_ps( a, 1 ) );
+            return _mm_min_ps( _mm256_castps256_ps128( t ), _mm256_extractf128_ps( t, 1 ) );
+        }
+
+        /** Folds the four 128-bit lanes of a into one
+        @return
+            r[i] = max( a[i], a[i + 4], a[i + 8], a[i + 12] )
+        */
+        static inline __m128 FoldMax128( ArrayReal a )
+        {
+            __m256 t = _mm256_max_ps( _mm512_castps512_ps256( a ), _mm512_extractf32x8_ps( a, 1 ) );
+            return _mm_max_ps( _mm256_castps256_ps128( t ), _mm256_extractf128_ps( t, 1 ) );
+        }
+
+        /** Returns the minimum value of all elements in a
+        @return
+            r[0] = min( a[0], a[1], ..., a[15] )
+        */
+        static inline Real CollapseMin( ArrayReal a )
+        {
+            // Fold the upper 128-bit lanes onto the lowest one, then proceed as in SSE2
+            __m128 t1 = FoldMin128( a );
+            __m128 t0 = _mm_shuffle_ps( t1, t1, _MM_SHUFFLE( 2, 3, 2, 3 ) );
+            t0 = _mm_min_ps( t1, t0 );
+            t1 = _mm_shuffle_ps( t0, t0, _MM_SHUFFLE( 1, 1, 0, 0 ) );
+            t0 = _mm_min_ps( t1, t0 );
+            return _mm_cvtss_f32( t0 );
+        }
+
+        /** Returns the maximum value of all elements in a
+        @return
+            r[0] = max( a[0], a[1], ..., a[15] )
+        */
+        static inline Real CollapseMax( ArrayReal a )
+        {
+            // Fold the upper 128-bit lanes onto the lowest one, then proceed as in SSE2
+            __m128 t1 = FoldMax128( a );
+            __m128 t0 = _mm_shuffle_ps( t1, t1, _MM_SHUFFLE( 2, 3, 2, 3 ) );
+            t0 = _mm_max_ps( t1, t0 );
+            t1 = _mm_shuffle_ps( t0, t0, _MM_SHUFFLE( 1, 1, 0, 0 ) );
+            t0 = _mm_max_ps( t1, t0 );
+            return _mm_cvtss_f32( t0 );
+        }
+
+        /** Returns the reciprocal of x
+            @remarks
+                If you have a very rough guarantees that you won't be feeding a zero,
+                consider using @see InvNonZero4 because it's faster.
+
+                Use SSE Newton-Raphson reciprocal estimate, accurate to 23 significant
+                bits of the mantissa after an extra iteration, instead of the little
+                14 bits of accuracy that _mm512_rcp14_ps gives us
+                In short, one Newton-Raphson Iteration:
+                 f( i+1 ) = 2 * rcp( f ) - f * rcp( f ) * rcp( f )
+                See Intel AP-803 (Application note), Order N° 243637-002 (if you can get it!)
+                 "x0 = RCPSS(d)
+                x1 = x0 * (2 - d * x0) = 2 * x0 - d * x0 * x0
+                where x0 is the first approximation to the reciprocal of the divisor d, and x1 is a
+                better approximation. You must use this formula before multiplying with the dividend."
+            @param val
+                16 floating point values. If it's zero, the returned value will be infinite,
+                which is the correct result, but it's slower than InvNonZero4
+            @return
+                1 / x (packed as 16 floats)
+        */
+        static inline ArrayReal Inv4( ArrayReal val )
+        {
+            ArrayReal inv = _mm512_rcp14_ps( val );
+            ArrayReal twoRcp = _mm512_add_ps( inv, inv );                        // 2 * rcp( f )
+            ArrayReal rightSide = _mm512_mul_ps( val, _mm512_mul_ps( inv, inv ) );  // f * rcp( f ) * rcp( f )
+            rightSide = _mm512_and_ps( rightSide, _ogre_mm512_cmpneq_ps( val, _mm512_setzero_ps() ) );  // Nuke this
+                                                                                          // NaN
+            return _mm512_sub_ps( twoRcp, rightSide );
+        }
+
+        /** Returns the reciprocal of x
+            @remarks
+                If the input is zero, it will produce a NaN!!! (but it's faster)
+                Note: Some architectures may slowdown when a NaN is produced, making this
+                function slower than Inv4 for those cases
+                @see Inv4
+
+                Use SSE Newton-Raphson reciprocal estimate, accurate to 23 significant
+                bits of the mantissa after an extra iteration, instead of the little
+                14 bits of accuracy that _mm512_rcp14_ps gives us
+                In short, one Newton-Raphson Iteration:
+                 f( i+1 ) = 2 * rcp( f ) - f * rcp( f ) * rcp( f )
+                See Intel AP-803 (Application note), Order N° 243637-002 (if you can get it!)
+                 "x0 = RCPSS(d)
+                x1 = x0 * (2 - d * x0) = 2 * x0 - d * x0 * x0
+                where x0 is the first approximation to the reciprocal of the divisor d, and x1 is a
+                better approximation. You must use this formula before multiplying with the dividend."
+            @param val
+                16 floating point values. If it's zero, the returned value will be NaN
+            @return
+                1 / x (packed as 16 floats)
+        */
+        static inline ArrayReal InvNonZero4( ArrayReal val )
+        {
+            ArrayReal inv = _mm512_rcp14_ps( val );
+            ArrayReal twoRcp = _mm512_add_ps( inv, inv );                        // 2 * rcp( f )
+            ArrayReal rightSide = _mm512_mul_ps( val, _mm512_mul_ps( inv, inv ) );  // f * rcp( f ) * rcp( f )
+            return _mm512_sub_ps( twoRcp, rightSide );
+        }
+
+        /** Returns the squared root of the reciprocal of x
+            @remarks
+                Use SSE Newton-Raphson reciprocal estimate, accurate to 23 significant
+                bits of the mantissa after an extra iteration, instead of the little
+                14 bits of accuracy that _mm512_rcp14_ps gives us
+                In short, one Newton-Raphson Iteration:
+                     f( i+1 ) = 0.5 * rsqrt( f ) * ( 3 - f * rsqrt( f ) * rsqrt( f ) )
+                See Intel AP-803 (Application note), Order N° 243637-002 (if you can get it!)
+                "x0 = RSQRTSS(a)
+                x1 = 0.5 * x0 * ( 3 - ( a * x0 ) * x0 )
+                where x0 is the first approximation to the reciprocal square root of a, and x1 is a
+                better approximation. The order of evaluation is important. You must use this formula
+                before multiplying with a to get the square root."
+            @param f
+                16 floating point values
+            @return
+                1 / sqrt( x ) (packed as 16 floats)
+        */
+        static inline ArrayReal InvSqrt4( ArrayReal f )
+        {
+            ArrayReal invSqrt = _mm512_rsqrt14_ps( f );
+
+            ArrayReal halfInvSqrt = _mm512_mul_ps( HALF, invSqrt );  // 0.5 * rsqrt( f )
+            ArrayReal rightSide =
+                _mm512_mul_ps( invSqrt, _mm512_mul_ps( f, invSqrt ) );  // f * rsqrt( f ) * rsqrt( f )
+            rightSide = _mm512_and_ps( rightSide, _ogre_mm512_cmpneq_ps( f, _mm512_setzero_ps() ) );  // Nuke this NaN
+            return _mm512_mul_ps( halfInvSqrt,
+                               _mm512_sub_ps( THREE, rightSide ) );  // halfInvSqrt*(3 - rightSide)
+        }
+
+        /** Returns the squared root of the reciprocal of x
+            @remarks
+                Use SSE Newton-Raphson reciprocal estimate, accurate to 23 significant
+                bits of the mantissa after an extra iteration, instead of the little
+                14 bits of accuracy that _mm512_rcp14_ps gives us
+                In short, one Newton-Raphson Iteration:
+                     f( i+1 ) = 0.5 * rsqrt( f ) * ( 3 - f * rsqrt( f ) * rsqrt( f ) )
+                See Intel AP-803 (Application note), Order N° 243637-002 (if you can get it!)
+                "x0 = RSQRTSS(a)
+                x1 = 0.5 * x0 * ( 3 - ( a * x0 ) * x0 )
+                where x0 is the first approximation to the reciprocal square root of a, and x1 is a
+                better approximation. The order of evaluation is important. You must use this formula
+                before multiplying with a to get the square root."
+
+                Warning: Passing a zero will return a NaN instead of infinity
+            @param f
+                16 floating point values
+            @return
+                1 / sqrt( x ) (packed as 16 floats)
+        */
+        static inline ArrayReal InvSqrtNonZero4( ArrayReal f )
+        {
+            ArrayReal invSqrt = _mm512_rsqrt14_ps( f );
+
+            ArrayReal halfInvSqrt = _mm512_mul_ps( HALF, invSqrt );  // 0.5 * rsqrt( f )
+            ArrayReal rightSide =
+                _mm512_mul_ps( invSqrt, _mm512_mul_ps( f, invSqrt ) );  // f * rsqrt( f ) * rsqrt( f )
+            return _mm512_mul_ps( halfInvSqrt,
+                               _mm512_sub_ps( THREE, rightSide ) );  // halfInvSqrt*(3 - rightSide)
+        }
+
+        /** Break x into fractional and integral parts
+            @param x
+                16 floating point values. i.e. "2.57" (x16)
+            @param outIntegral
+                The integral part of x. i.e. 2
+            @return
+                The fractional part of x. i.e. 0.57
+        */
+        static inline ArrayReal Modf4( ArrayReal x, ArrayReal &outIntegral );
+
+        /** Like std::copysign, composes a value of magnitude mag and sign sig
+        @param mag
+            Magnitude of the returned value.
+        @param sig
+            Sign of the returned value.
+        @return
+            A value of magnitude mag and sign sig
+        */
+        static inline ArrayReal CopySign4( ArrayReal mag, ArrayReal sig );
+
+        /** Returns the arccos of x
+            @param x
+                16 floating point values
+            @return
+                arccos( x ) (packed as 16 floats)
+        */
+        static inline ArrayReal ACos4( ArrayReal x );
+
+        /** Returns the sine of x
+            @param x
+                16 floating point values
+            @return
+                sin( x ) (packed as 16 floats)
+        */
+        static ArrayReal Sin4( ArrayReal x );
+
+        /** Returns the cosine of x
+            @param x
+                16 floating point values
+            @return
+                cos( x ) (packed as 16 floats)
+        */
+        static ArrayReal Cos4( ArrayReal x );
+
+        /** Calculates the cosine & sine of x. Use this function if you need to calculate
+            both, as it is faster than calling Cos4 & Sin4 together.
+            @param x
+                16 floating point values
+            @param outSin
+                Output value, sin( x ) (packed as 16 floats)
+            @param outCos
+                Output value, cos( x ) (packed as 16 floats)
+        */
+        static void SinCos4( ArrayReal x, ArrayReal &outSin, ArrayReal &outCos );
+    };
+
+#    if OGRE_COMPILER != OGRE_COMPILER_CLANG && OGRE_COMPILER != OGRE_COMPILER_GNUC
+    // clang-format off
+    inline ArrayReal operator - ( ArrayReal l )                 { return _mm512_xor_ps( l, MathlibAVX512::SIGN_MASK ); }
+    inline ArrayReal operator + ( ArrayReal l, Real r )         { return _mm512_add_ps( l, _mm512_set1_ps( r ) ); }
+//  inline ArrayReal operator + ( Real l, ArrayReal r )         { return _mm512_add_ps( _mm512_set1_ps( l ), r ); }
+    inline ArrayReal operator + ( ArrayReal l, ArrayReal r )    { return _mm512_add_ps( l, r ); }
+//  inline ArrayReal operator - ( ArrayReal l, Real r )         { return _mm512_sub_ps( l, _mm512_set1_ps( r ) ); }
+//  inline ArrayReal operator - ( Real l, ArrayReal r )         { return _mm512_sub_ps( _mm512_set1_ps( l ), r ); }
+    inline ArrayReal operator - ( ArrayReal l, ArrayReal r )    { return _mm512_sub_ps( l, r ); }
+//  inline ArrayReal operator * ( ArrayReal l, Real r )         { return _mm512_mul_ps( l, _mm512_set1_ps( r ) ); }
+    inline ArrayReal operator * ( Real l, ArrayReal r )         { return _mm512_mul_ps( _mm512_set1_ps( l ), r ); }
+    inline ArrayReal operator * ( ArrayReal l, ArrayReal r )    { return _mm512_mul_ps( l, r ); }
+    inline ArrayReal operator / ( ArrayReal l, Real r )         { return _mm512_div_ps( l, _mm512_set1_ps( r ) ); }
+//  inline ArrayReal operator / ( Real l, ArrayReal r )         { return _mm512_div_ps( _mm512_set1_ps( l ), r ); }
+    inline ArrayReal operator / ( ArrayReal l, ArrayReal r )    { return _mm512_div_ps( l, r ); }
+// clang-format on
+#    endif
+}  // namespace Ogre
+
+#    include "OgreMathlibAVX512.inl"
+
+#endif
+#endif
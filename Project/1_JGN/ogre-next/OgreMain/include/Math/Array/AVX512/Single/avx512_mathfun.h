@@ -0,0 +1,231 @@
+/* AVX-512 (16-wide) implementation of sin & cos
+
+   Straight port of sse_mathfun.h (see Math/Array/SSE2/Single) to 512-bit
+   registers. Only the functions used by MathlibAVX512 were ported (log_ps &
+   exp_ps are not needed), the polynomials use AVX-512F's fused multiply-add
+   and the polynom selection uses k masks instead of and/andnot/or.
+
+   Inspired by Intel Approximate Math library, and based on the
+   corresponding algorithms of the cephes math library
+*/
+
+/* Copyright (C) 2007  Julien Pommier
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+
+  (this is the zlib license)
+*/
+
+#if __OGRE_HAVE_AVX512
+
+#    include <immintrin.h>
+
+typedef __m512  v16sf;  // vector of 16 float (avx512)
+typedef __m512i v16si;  // vector of 16 int (avx512)
+
+#    define _PS512_CONST( Name, Val ) static const v16sf _ps512_##Name = _mm512_set1_ps( Val )
+#    define _PI32_512_CONST( Name, Val ) \
+        static const v16si _pi32_512_##Name = _mm512_set1_epi32( Val )
+
+_PS512_CONST( 1, 1.0f );
+_PS512_CONST( 0p5, 0.5f );
+_PS512_CONST( sign_mask, -0.0f );
+
+_PI32_512_CONST( 1, 1 );
+_PI32_512_CONST( inv1, ~1 );
+_PI32_512_CONST( 2, 2 );
+_PI32_512_CONST( 4, 4 );
+
+_PS512_CONST( minus_cephes_DP1, -0.78515625f );
+_PS512_CONST( minus_cephes_DP2, -2.4187564849853515625e-4f );
+_PS512_CONST( minus_cephes_DP3, -3.77489497744594108e-8f );
+_PS512_CONST( sincof_p0, -1.9515295891E-4f );
+_PS512_CONST( sincof_p1, 8.3321608736E-3f );
+_PS512_CONST( sincof_p2, -1.6666654611E-1f );
+_PS512_CONST( coscof_p0, 2.443315711809948E-005f );
+_PS512_CONST( coscof_p1, -1.388731625493765E-003f );
+_PS512_CONST( coscof_p2, 4.166664568298827E-002f );
+_PS512_CONST( cephes_FOPI, 1.27323954473516f );  // 4 / M_PI
+
+/* "Extended precision modular arithmetic"
+   x = ((x - y * DP1) - y * DP2) - y * DP3; */
+static inline v16sf sincos512_reduce( v16sf x, v16sf y )
+{
+    x = _mm512_fmadd_ps( y, _ps512_minus_cephes_DP1, x );
+    x = _mm512_fmadd_ps( y, _ps512_minus_cephes_DP2, x );
+    x = _mm512_fmadd_ps( y, _ps512_minus_cephes_DP3, x );
+    return x;
+}
+
+/* Evaluate the first polynom  (0 <= x <= Pi/4), z = x * x */
+static inline v16sf cos512_poly( v16sf z )
+{
+    v16sf y = _mm512_fmadd_ps( _ps512_coscof_p0, z, _ps512_coscof_p1 );
+    y = _mm512_fmadd_ps( y, z, _ps512_coscof_p2 );
+    y = _mm512_mul_ps( _mm512_mul_ps( y, z ), z );
+    y = _mm512_fnmadd_ps( z, _ps512_0p5, y );
+    return _mm512_add_ps( y, _ps512_1 );
+}
+
+/* Evaluate the second polynom  (Pi/4 <= x <= 0), z = x * x */
+static inline v16sf sin512_poly( v16sf x, v16sf z )
+{
+    v16sf y2 = _mm512_fmadd_ps( _ps512_sincof_p0, z, _ps512_sincof_p1 );
+    y2 = _mm512_fmadd_ps( y2, z, _ps512_sincof_p2 );
+    y2 = _mm512_mul_ps( y2, z );
+    return _mm512_fmadd_ps( y2, x, x );
+}
+
+/* evaluation of 16 sines at onces. Precision is excellent as long as x < 8192 */
+static inline v16sf sin512_ps( v16sf x )
+{  // any x
+    v16sf sign_bit = _mm512_and_ps( x, _ps512_sign_mask );
+    /* take the absolute value */
+    x = _mm512_andnot_ps( _ps512_sign_mask, x );
+
+    /* scale by 4/Pi */
+    v16sf y = _mm512_mul_ps( x, _ps512_cephes_FOPI );
+
+    /* store the integer part of y in emm2 */
+    v16si emm2 = _mm512_cvttps_epi32( y );
+    /* j=(j+1) & (~1) (see the cephes sources) */
+    emm2 = _mm512_add_epi32( emm2, _pi32_512_1 );
+    emm2 = _mm512_and_si512( emm2, _pi32_512_inv1 );
+    y = _mm512_cvtepi32_ps( emm2 );
+    /* get the swap sign flag */
+    v16si emm0 = _mm512_and_si512( emm2, _pi32_512_4 );
+    emm0 = _mm512_slli_epi32( emm0, 29 );
+    /* get the polynom selection mask
+       there is one polynom for 0 <= x <= Pi/4
+       and another one for Pi/4<x<=Pi/2
+
+       Both branches will be computed.
+    */
+    emm2 = _mm512_and_si512( emm2, _pi32_512_2 );
+    __mmask16 poly_mask = _mm512_cmpeq_epi32_mask( emm2, _mm512_setzero_si512() );
+
+    v16sf swap_sign_bit = _mm512_castsi512_ps( emm0 );
+    sign_bit = _mm512_xor_ps( sign_bit, swap_sign_bit );
+
+    x = sincos512_reduce( x, y );
+
+    v16sf z = _mm512_mul_ps( x, x );
+    y = cos512_poly( z );
+    v16sf y2 = sin512_poly( x, z );
+
+    /* select the correct result from the two polynoms */
+    y = _mm512_mask_blend_ps( poly_mask, y, y2 );
+    /* update the sign */
+    return _mm512_xor_ps( y, sign_bit );
+}
+
+/* almost the same as sin512_ps */
+static inline v16sf cos512_ps( v16sf x )
+{  // any x
+    /* take the absolute value */
+    x = _mm512_andnot_ps( _ps512_sign_mask, x );
+
+    /* scale by 4/Pi */
+    v16sf y = _mm512_mul_ps( x, _ps512_cephes_FOPI );
+
+    /* store the integer part of y in emm2 */
+    v16si emm2 = _mm512_cvttps_epi32( y );
+    /* j=(j+1) & (~1) (see the cephes sources) */
+    emm2 = _mm512_add_epi32( emm2, _pi32_512_1 );
+    emm2 = _mm512_and_si512( emm2, _pi32_512_inv1 );
+    y = _mm512_cvtepi32_ps( emm2 );
+
+    emm2 = _mm512_sub_epi32( emm2, _pi32_512_2 );
+
+    /* get the swap sign flag */
+    v16si emm0 = _mm512_andnot_si512( emm2, _pi32_512_4 );
+    emm0 = _mm512_slli_epi32( emm0, 29 );
+    /* get the polynom selection mask */
+    emm2 = _mm512_and_si512( emm2, _pi32_512_2 );
+    __mmask16 poly_mask = _mm512_cmpeq_epi32_mask( emm2, _mm512_setzero_si512() );
+
+    v16sf sign_bit = _mm512_castsi512_ps( emm0 );
+
+    x = sincos512_reduce( x, y );
+
+    v16sf z = _mm512_mul_ps( x, x );
+    y = cos512_poly( z );
+    v16sf y2 = sin512_poly( x, z );
+
+    /* select the correct result from the two polynoms */
+    y = _mm512_mask_blend_ps( poly_mask, y, y2 );
+    /* update the sign */
+    return _mm512_xor_ps( y, sign_bit );
+}
+
+/* since sin512_ps and cos512_ps are almost identical, sincos512_ps could replace both of them..
+   it is almost as fast, and gives you a free cosine with your sine */
+static inline void sincos512_ps( v16sf x, v16sf *s, v16sf *c )
+{
+    v16sf sign_bit_sin = _mm512_and_ps( x, _ps512_sign_mask );
+    /* take the absolute value */
+    x = _mm512_andnot_ps( _ps512_sign_mask, x );
+
+    /* scale by 4/Pi */
+    v16sf y = _mm512_mul_ps( x, _ps512_cephes_FOPI );
+
+    /* store the integer part of y in emm2 */
+    v16si emm2 = _mm512_cvttps_epi32( y );
+
+    /* j=(j+1) & (~1) (see the cephes sources) */
+    emm2 = _mm512_add_epi32( emm2, _pi32_512_1 );
+    emm2 = _mm512_and_si512( emm2, _pi32_512_inv1 );
+    y = _mm512_cvtepi32_ps( emm2 );
+
+    v16si emm4 = emm2;
+
+    /* get the swap sign flag for the sine */
+    v16si emm0 = _mm512_and_si512( emm2, _pi32_512_4 );
+    emm0 = _mm512_slli_epi32( emm0, 29 );
+    v16sf swap_sign_bit_sin = _mm512_castsi512_ps( emm0 );
+
+    /* get the polynom selection mask for the sine*/
+    emm2 = _mm512_and_si512( emm2, _pi32_512_2 );
+    __mmask16 poly_mask = _mm512_cmpeq_epi32_mask( emm2, _mm512_setzero_si512() );
+
+    x = sincos512_reduce( x, y );
+
+    /* get the sign flag for the cosine */
+    emm4 = _mm512_sub_epi32( emm4, _pi32_512_2 );
+    emm4 = _mm512_andnot_si512( emm4, _pi32_512_4 );
+    emm4 = _mm512_slli_epi32( emm4, 29 );
+    v16sf sign_bit_cos = _mm512_castsi512_ps( emm4 );
+
+    sign_bit_sin = _mm512_xor_ps( sign_bit_sin, swap_sign_bit_sin );
+
+    v16sf z = _mm512_mul_ps( x, x );
+    y = cos512_poly( z );
+    v16sf y2 = sin512_poly( x, z );
+
+    /* select the correct result from the two polynoms */
+    v16sf ysin = _mm512_mask_blend_ps( poly_mask, y, y2 );
+    v16sf ycos = _mm512_mask_blend_ps( poly_mask, y2, y );
+
+    /* update the sign */
+    *s = _mm512_xor_ps( ysin, sign_bit_sin );
+    *c = _mm512_xor_ps( ycos, sign_bit_cos );
+}
+
+#    undef _PS512_CONST
+#    undef _PI32_512_CONST
+
+#endif
@@ -31,7 +31,132 @@ THE SOFTWARE.
 #include "OgrePrerequisites.h"
 
 #if OGRE_USE_SIMD == 1
-#    if OGRE_CPU == OGRE_CPU_X86
+#    if OGRE_CPU == OGRE_CPU_X86 && __OGRE_HAVE_AVX512
+// x86/x64 - AVX-512 (F + DQ). Masks are kept as full registers (like SSE2 & AVX2)
+// rather than k registers so that all backends share the same ArrayMaskR semantics.
+#        if !defined( __AVX512F__ ) || !defined( __AVX512DQ__ )
+#            error "OGRE_USE_AVX512 requires compiling with -mavx512f -mavx512dq (/arch:AVX512 on MSVC)"
+#        endif
+#        include <immintrin.h>
+#        define ARRAY_PACKED_REALS 16
+namespace Ogre
+{
+    typedef __m512 ArrayReal;
+    typedef __m512 ArrayMaskR;
+
+    typedef __m512i ArrayInt;
+    typedef __m512i ArrayMaskI;
+
+    /// To store the result of ToSnorm8, can be consumed by extractS8
+    typedef __m128i ArrayToS8;
+    /// To store the result of ToSnorm16, can be consumed by extractS16
+    typedef __m256i ArrayToS16;
+
+#        define ARRAY_REAL_ZERO _mm512_setzero_ps()
+#        define ARRAY_INT_ZERO _mm512_setzero_si512()
+#        define ARRAY_MASK_ZERO _mm512_setzero_ps()
+
+    class ArrayRadian;
+}  // namespace Ogre
+
+#        define OGRE_PREFETCH_T0( x ) _mm_prefetch( x, _MM_HINT_T0 )
+#        define OGRE_PREFETCH_T1( x ) _mm_prefetch( x, _MM_HINT_T1 )
+#        define OGRE_PREFETCH_T2( x ) _mm_prefetch( x, _MM_HINT_T2 )
+#        define OGRE_PREFETCH_NTA( x ) _mm_prefetch( x, _MM_HINT_NTA )
+
+// Distance (in ArrayMemoryManager's slots) used to keep fetching data. This also
+// means the memory manager needs to allocate extra memory for them.
+// Same amount of objects ahead as SSE2 (16)
+#        define OGRE_PREFETCH_SLOT_DISTANCE \
+            1 * ARRAY_PACKED_REALS  // Must be multiple of ARRAY_PACKED_REALS
+
+/// r = (a * b) + c
+#        define _mm512_madd_ps( a, b, c ) _mm512_fmadd_ps( a, b, c )
+/// r = -(a * b) + c
+#        define _ogre_mm512_nmsub_ps( a, b, c ) _mm512_fnmadd_ps( a, b, c )
+
+/// Comparisons returning a full register mask (0 or 0xffffffff) like SSE2 does
+#        define _ogre_mm512_cmp_ps( a, b, pred ) \
+            _mm512_castsi512_ps( _mm512_movm_epi32( _mm512_cmp_ps_mask( a, b, pred ) ) )
+#        define _ogre_mm512_cmpeq_ps( a, b ) _ogre_mm512_cmp_ps( a, b, _CMP_EQ_OQ )
+#        define _ogre_mm512_cmpneq_ps( a, b ) _ogre_mm512_cmp_ps( a, b, _CMP_NEQ_UQ )
+#        define _ogre_mm512_cmplt_ps( a, b ) _ogre_mm512_cmp_ps( a, b, _CMP_LT_OS )
+#        define _ogre_mm512_cmple_ps( a, b ) _ogre_mm512_cmp_ps( a, b, _CMP_LE_OS )
+#        define _ogre_mm512_cmpgt_ps( a, b ) _ogre_mm512_cmp_ps( a, b, _CMP_GT_OS )
+#        define _ogre_mm512_cmpge_ps( a, b ) _ogre_mm512_cmp_ps( a, b, _CMP_GE_OS )
+#        define _ogre_mm512_cmpeq_epi32( a, b ) _mm512_movm_epi32( _mm512_cmpeq_epi32_mask( a, b ) )
+/// Equivalent of _mm_movemask_ps: one bit per lane, taken from the sign bit
+#        define _ogre_mm512_movemask_ps( a ) \
+            static_cast<int>( _mm512_movepi32_mask( _mm512_castps_si512( a ) ) )
+
+/// Does not convert, just cast ArrayReal to ArrayInt
+#        define CastRealToInt( x ) _mm512_castps_si512( x )
+#        define CastIntToReal( x ) _mm512_castsi512_ps( x )
+/// Input must be 64-byte aligned
+#        define CastArrayToReal( outFloatPtr, arraySimd ) _mm512_store_ps( outFloatPtr, arraySimd )
+#        define CastArrayToInt32( outInt32Ptr, arraySimd ) \
+            _mm512_store_si512( reinterpret_cast<__m512i *>( outInt32Ptr ), arraySimd )
+
+#    elif OGRE_CPU == OGRE_CPU_X86 && __OGRE_HAVE_AVX2
+// x86/x64 - AVX2 + FMA3
+#        if !defined( __AVX2__ ) || ( !defined( __FMA__ ) && OGRE_COMPILER != OGRE_COMPILER_MSVC )
+#            error "OGRE_USE_AVX2 requires compiling with -mavx2 -mfma (/arch:AVX2 on MSVC)"
+#        endif
+#        include <immintrin.h>
+#        define ARRAY_PACKED_REALS 8
+namespace Ogre
+{
+    typedef __m256 ArrayReal;
+    typedef __m256 ArrayMaskR;
+
+    typedef __m256i ArrayInt;
+    typedef __m256i ArrayMaskI;
+
+    /// To store the result of ToSnorm8, can be consumed by extractS8
+    typedef __m128i ArrayToS8;
+    /// To store the result of ToSnorm16, can be consumed by extractS16
+    typedef __m128i ArrayToS16;
+
+#        define ARRAY_REAL_ZERO _mm256_setzero_ps()
+#        define ARRAY_INT_ZERO _mm256_setzero_si256()
+#        define ARRAY_MASK_ZERO _mm256_setzero_ps()
+
+    class ArrayRadian;
+}  // namespace Ogre
+
+#        define OGRE_PREFETCH_T0( x ) _mm_prefetch( x, _MM_HINT_T0 )
+#        define OGRE_PREFETCH_T1( x ) _mm_prefetch( x, _MM_HINT_T1 )
+#        define OGRE_PREFETCH_T2( x ) _mm_prefetch( x, _MM_HINT_T2 )
+#        define OGRE_PREFETCH_NTA( x ) _mm_prefetch( x, _MM_HINT_NTA )
+
+// Distance (in ArrayMemoryManager's slots) used to keep fetching data. This also
+// means the memory manager needs to allocate extra memory for them.
+// Same amount of objects ahead as SSE2 (16)
+#        define OGRE_PREFETCH_SLOT_DISTANCE \
+            2 * ARRAY_PACKED_REALS  // Must be multiple of ARRAY_PACKED_REALS
+
+/// r = (a * b) + c
+#        define _mm256_madd_ps( a, b, c ) _mm256_fmadd_ps( a, b, c )
+/// r = -(a * b) + c
+#        define _ogre_mm256_nmsub_ps( a, b, c ) _mm256_fnmadd_ps( a, b, c )
+
+/// AVX only has the generic _mm256_cmp_ps. These match the predicates of the SSE2 versions
+#        define _ogre_mm256_cmpeq_ps( a, b ) _mm256_cmp_ps( a, b, _CMP_EQ_OQ )
+#        define _ogre_mm256_cmpneq_ps( a, b ) _mm256_cmp_ps( a, b, _CMP_NEQ_UQ )
+#        define _ogre_mm256_cmplt_ps( a, b ) _mm256_cmp_ps( a, b, _CMP_LT_OS )
+#        define _ogre_mm256_cmple_ps( a, b ) _mm256_cmp_ps( a, b, _CMP_LE_OS )
+#        define _ogre_mm256_cmpgt_ps( a, b ) _mm256_cmp_ps( a, b, _CMP_GT_OS )
+#        define _ogre_mm256_cmpge_ps( a, b ) _mm256_cmp_ps( a, b, _CMP_GE_OS )
+
+/// Does not convert, just cast ArrayReal to ArrayInt
+#        define CastRealToInt( x ) _mm256_castps_si256( x )
+#        define CastIntToReal( x ) _mm256_castsi256_ps( x )
+/// Input must be 32-byte aligned
+#        define CastArrayToReal( outFloatPtr, arraySimd ) _mm256_store_ps( outFloatPtr, arraySimd )
+#        define CastArrayToInt32( outInt32Ptr, arraySimd ) \
+            _mm256_store_si256( reinterpret_cast<__m256i *>( outInt32Ptr ), arraySimd )
+
+#    elif OGRE_CPU == OGRE_CPU_X86
 // x86/x64 - SSE2
 #        if OGRE_DOUBLE_PRECISION == 1
 #            include <emmintrin.h>
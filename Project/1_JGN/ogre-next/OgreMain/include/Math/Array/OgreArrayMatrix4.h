@@ -34,6 +34,10 @@ THE SOFTWARE.
 #if OGRE_CPU == OGRE_CPU_X86 && OGRE_USE_SIMD == 1
 #    if OGRE_DOUBLE_PRECISION == 1
 #        include "SSE2/Double/OgreArrayMatrix4SSE2.h"
+#    elif __OGRE_HAVE_AVX512
+#        include "AVX512/Single/OgreArrayMatrix4AVX512.h"
+#    elif __OGRE_HAVE_AVX2
+#        include "AVX2/Single/OgreArrayMatrix4AVX2.h"
 #    else
 #        include "SSE2/Single/OgreArrayMatrix4SSE2.h"
 #    endif
@@ -34,13 +34,23 @@ THE SOFTWARE.
 #if OGRE_CPU == OGRE_CPU_X86 && OGRE_USE_SIMD == 1
 #    if OGRE_DOUBLE_PRECISION == 1
 #        include "SSE2/Double/OgreMathlibSSE2.h"
+#    elif __OGRE_HAVE_AVX512
+#        include "AVX512/Single/OgreMathlibAVX512.h"
+#    elif __OGRE_HAVE_AVX2
+#        include "AVX2/Single/OgreMathlibAVX2.h"
 #    else
 #        include "SSE2/Single/OgreMathlibSSE2.h"
 #    endif
 
 namespace Ogre
 {
+#    if OGRE_DOUBLE_PRECISION == 0 && __OGRE_HAVE_AVX512
+    typedef MathlibAVX512 Mathlib;
+#    elif OGRE_DOUBLE_PRECISION == 0 && __OGRE_HAVE_AVX2
+    typedef MathlibAVX2 Mathlib;
+#    else
     typedef MathlibSSE2 Mathlib;
+#    endif
 }
 #elif OGRE_CPU == OGRE_CPU_ARM && OGRE_USE_SIMD == 1
 #    if OGRE_DOUBLE_PRECISION == 1
@@ -62,6 +62,9 @@ namespace Ogre
         /// Tracks total number of objects in all render queues.
         size_t mTotalObjects;
 
+        /// Incremented every time an object may have changed its slot. @see getLayoutVersion
+        size_t mLayoutVersion;
+
         /// Dummy node where to point ObjectData::mParents[i] when they're unused slots.
         SceneNode  *mDummyNode;
         Transform   mDummyTransformPtrs;
@@ -165,6 +168,13 @@ namespace Ogre
         */
         size_t getTotalNumObjects() const { return mTotalObjects; }
 
+        /** Returns a value that changes every time objects are created, destroyed, change
+            render queue, or get moved around by defragment/shrinkToFit.
+        @remarks
+            Useful to know whether data cached per slot (e.g. a CullBvh) is still valid.
+        */
+        size_t getLayoutVersion() const { return mLayoutVersion; }
+
         /// This is the opposite of getTotalNumObjects. This function returns the sum
         /// of the return values of getFirstObjectData
         size_t calculateTotalNumObjectDataIncludingFragmentedSlots() const;
@@ -0,0 +1,140 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE-Next
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef _OgreCullBvh_H_
+#define _OgreCullBvh_H_
+
+#include "OgrePrerequisites.h"
+
+#include "Math/Array/OgreArrayAabb.h"
+#include "OgreFastArray.h"
+#include "OgreRawPtr.h"
+
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre
+{
+    struct ArrayPlane;
+    class bitset64;
+
+    /** \addtogroup Core
+     *  @{
+     */
+    /** \addtogroup Scene
+     *  @{
+     */
+
+    /** Bounding volume hierarchy over a contiguous range of ObjectData, used by
+        SceneManager::cullFrustum to skip the packs of SCENE_STATIC objects that are
+        outside the frustum instead of testing every one of them.
+    @remarks
+        Nodes are c_nodeWidth wide (ARRAY_PACKED_REALS, but at least 4) and store the
+        bounds of their children in SoA form, so a node is tested against a frustum
+        plane with the same SIMD code MovableObject::cullFrustum uses for objects.
+        @par
+        The output is the set of packs (groups of ARRAY_PACKED_REALS objects) that may be
+        visible. Those packs must still go through MovableObject::cullFrustum, which does
+        the exact per-object test (plus visibility flags & rendering distance), so culling
+        with or without the BVH produces exactly the same list of objects.
+        @par
+        The world Aabbs are only read while building. The tree must be rebuilt whenever
+        the objects move or the ObjectMemoryManager layout changes (@see isBuiltFor).
+    */
+    class _OgreExport CullBvh
+    {
+    public:
+        static const size_t c_nodeWidth = ARRAY_PACKED_REALS < 4u ? 4u : ARRAY_PACKED_REALS;
+        static const size_t c_numChildPacks = c_nodeWidth / ARRAY_PACKED_REALS;
+
+    protected:
+        /// Value of Node::children for children that are a single object, not another node.
+        /// Node 0 is the root, thus it can never be the child of another node.
+        static const uint32 c_leafChild = 0u;
+
+        struct Node
+        {
+            ArrayAabb aabb[c_numChildPacks];
+            /// Index to mNodes or c_leafChild
+            uint32 children[c_nodeWidth];
+            /// Range in mObjectPacks of all the objects under each child
+            uint32 firstObject[c_nodeWidth];
+            uint32 numObjects[c_nodeWidth];
+            /// Bit i is set if children[i] is used
+            uint32 childMask;
+        };
+
+        RawSimdUniquePtr<Node, MEMCATEGORY_SCENE_CONTROL> mNodes;
+        /// Pack index of every object in the tree, sorted so that every node's
+        /// objects are contiguous
+        FastArray<uint32> mObjectPacks;
+        /// Packs containing an object with infinite bounds. They're always visible.
+        FastArray<uint32> mAlwaysVisiblePacks;
+
+        size_t mNumObjects;
+        size_t mLayoutVersion;
+
+    public:
+        CullBvh();
+
+        /** Rebuilds the tree.
+        @param worldAabb
+            ObjectData::mWorldAabb of the first pack of the range.
+            Pack indices set by cull are relative to it.
+        @param numObjects
+            Number of objects (slots) in the range, as in MovableObject::cullFrustum
+        @param layoutVersion
+            ObjectMemoryManager::getLayoutVersion at the time of the build
+        */
+        void build( const ArrayAabb *worldAabb, size_t numObjects, size_t layoutVersion );
+
+        /// Releases the tree. isBuiltFor will return false until the next build.
+        void clear();
+
+        /// Returns true if the tree was built for the same range and memory layout.
+        bool isBuiltFor( size_t numObjects, size_t layoutVersion ) const
+        {
+            return mNumObjects == numObjects && mLayoutVersion == layoutVersion && mNumObjects != 0u;
+        }
+
+        /** Marks the packs that may be inside the frustum.
+        @param planes
+            The 6 frustum planes, as prepared by MovableObject::cullFrustumPrepare
+        @param inOutVisiblePacks
+            Must be able to hold ceil( numObjects / ARRAY_PACKED_REALS ) bits.
+            Bits are set, never cleared.
+        */
+        void cull( const ArrayPlane *RESTRICT_ALIAS planes, bitset64 &inOutVisiblePacks ) const;
+    };
+
+    /** @} */
+    /** @} */
+}  // namespace Ogre
+
+#include "OgreHeaderSuffix.h"
+
+#endif
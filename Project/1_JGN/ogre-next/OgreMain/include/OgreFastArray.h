@@ -113,12 +113,17 @@ namespace Ogre
             std::swap( this->mCapacity, other.mCapacity );
         }
 
-        FastArray( const FastArray<T> &copy ) : mSize( copy.mSize ), mCapacity( copy.mSize )
+        FastArray( const FastArray<T> &copy ) : mData( 0 ), mSize( copy.mSize ), mCapacity( copy.mSize )
         {
-            mData = (T *)::operator new( mSize * sizeof( T ) );
-            for( size_t i = 0; i < mSize; ++i )
+            // Copying an empty array is common (i.e. resize( n, T() )); skipping the
+            // zero-sized allocation also keeps GCC 12 from a false -Warray-bounds
+            if( mSize )
             {
-                new( &mData[i] ) T( copy.mData[i] );
+                mData = (T *)::operator new( mSize * sizeof( T ) );
+                for( size_t i = 0; i < mSize; ++i )
+                {
+                    new( &mData[i] ) T( copy.mData[i] );
+                }
             }
         }
 
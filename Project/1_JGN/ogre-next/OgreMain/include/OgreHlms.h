@@ -155,6 +155,21 @@ namespace Ogre
 #    endif
 #endif
 
+        /// Counters of the lookups into mRenderableCache done by addRenderableCache.
+        /// @see Hlms::getRenderableCacheStats
+        struct RenderableCacheStats
+        {
+            /// Lookups that found an existing entry
+            uint64 hits;
+            /// Lookups that had to create a new entry
+            uint64 misses;
+            /// Slots of the hash table visited by all lookups. probes / (hits + misses)
+            /// is the average probe length, which should stay close to 1.
+            uint64 probes;
+
+            RenderableCacheStats() : hits( 0 ), misses( 0 ), probes( 0 ) {}
+        };
+
     protected:
         struct RenderableCache
         {
@@ -179,6 +194,22 @@ namespace Ogre
 
                 return setProperties == _r.setProperties && piecesEqual;
             }
+
+            /// Same as operator== but without having to build a RenderableCache first.
+            /// _pieces can be null, which is the same as all of them being empty.
+            bool equals( const HlmsPropertyVec &properties, const PiecesMap *_pieces ) const
+            {
+                if( setProperties != properties )
+                    return false;
+
+                for( size_t i = 0; i < NumShaderTypes; ++i )
+                {
+                    if( _pieces ? pieces[i] != _pieces[i] : !pieces[i].empty() )
+                        return false;
+                }
+
+                return true;
+            }
         };
 
         struct PassCache
@@ -230,6 +261,15 @@ namespace Ogre
         ShaderCodeCacheVec mShaderCodeCache;  // GUARDED_BY( mMutex )
         HlmsCacheVec       mShaderCache;      // GUARDED_BY( mMutex )
 
+        /// Open addressing (linear probing) hash table indexing mRenderableCache, so that
+        /// addRenderableCache doesn't have to compare against every entry.
+        /// Each slot holds 1 + the index into mRenderableCache, or 0 if empty.
+        /// Its size is a power of 2 and it is kept at most half full.
+        vector<uint32>::type mRenderableCacheTable;
+        /// mRenderableCacheHashes[i] is the hash of mRenderableCache[i]
+        vector<uint32>::type mRenderableCacheHashes;
+        RenderableCacheStats mRenderableCacheStats;
+
         typedef std::vector<HlmsPropertyVec> HlmsPropertyVecVec;
         typedef std::vector<PiecesMap>       PiecesMapVec;
 
@@ -450,6 +490,12 @@ namespace Ogre
         /// Retrieves a cache entry using the returned value from @addRenderableCache
         const RenderableCache &getRenderableCache( uint32 hash ) const;
 
+        /// Hashes the contents of a would-be RenderableCache entry for mRenderableCacheTable.
+        static uint32 calculateRenderableCacheHash( const HlmsPropertyVec &renderableSetProperties,
+                                                    const PiecesMap       *pieces );
+        /// Doubles the size of mRenderableCacheTable and reinserts all entries.
+        void growRenderableCacheTable();
+
         HlmsCache       *addStubShaderCache( uint32 hash );
         const HlmsCache *addShaderCache( uint32 hash, const HlmsPso &pso );
         const HlmsCache *getShaderCache( uint32 hash ) const;
@@ -803,6 +849,13 @@ namespace Ogre
         void _setNumThreads( size_t numThreads );
         void _setShadersGenerated( uint32 shadersGenerated );
 
+        /// Returns the hit / miss / probe counters of the renderable cache lookups
+        /// (i.e. every Renderable::setDatablock) since the last resetRenderableCacheStats.
+        const RenderableCacheStats &getRenderableCacheStats() const { return mRenderableCacheStats; }
+        void resetRenderableCacheStats() { mRenderableCacheStats = RenderableCacheStats(); }
+        /// Number of unique entries in the renderable cache. It never shrinks.
+        size_t getRenderableCacheSize() const { return mRenderableCache.size(); }
+
         /** Creates a unique datablock that can be shared by multiple renderables.
         @remarks
             The name of the datablock must be in paramVec["name"] and must be unique
@@ -100,8 +100,7 @@ namespace Ogre
             if( !count )
                 return 0;
 
-            size_t _alignment =
-                Alignment ? Alignment : 16;  // Should be OGRE_SIMD_ALIGNMENT, but compiler error
+            size_t _alignment = Alignment ? Alignment : OGRE_SIMD_ALIGNMENT;
             uint8 *tmp = (uint8 *)TrackAllocPolicy::allocateBytes( count + _alignment
 #    if OGRE_MEMORY_TRACKER
                                                                    ,
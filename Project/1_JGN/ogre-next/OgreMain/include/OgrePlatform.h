@@ -512,7 +512,13 @@ THE SOFTWARE.
 
 // Find perfect alignment (should supports SIMD alignment if SIMD available)
 #if OGRE_CPU == OGRE_CPU_X86
-#    define OGRE_SIMD_ALIGNMENT 16
+#    if OGRE_USE_SIMD == 1 && OGRE_DOUBLE_PRECISION == 0 && OGRE_USE_AVX512
+#        define OGRE_SIMD_ALIGNMENT 64
+#    elif OGRE_USE_SIMD == 1 && OGRE_DOUBLE_PRECISION == 0 && OGRE_USE_AVX2
+#        define OGRE_SIMD_ALIGNMENT 32
+#    else
+#        define OGRE_SIMD_ALIGNMENT 16
+#    endif
 #else
 #    define OGRE_SIMD_ALIGNMENT 16
 #endif
@@ -524,6 +530,13 @@ THE SOFTWARE.
 // Define whether or not Ogre compiled with SSE support.
 #    if OGRE_DOUBLE_PRECISION == 0 && OGRE_CPU == OGRE_CPU_X86
 #        define __OGRE_HAVE_SSE 1
+// Define whether or not the ArrayMath library uses the 8-wide (AVX2 + FMA3)
+// or the 16-wide (AVX-512F + DQ) backend instead of the 4-wide SSE2 one.
+#        if OGRE_USE_AVX512
+#            define __OGRE_HAVE_AVX512 1
+#        elif OGRE_USE_AVX2
+#            define __OGRE_HAVE_AVX2 1
+#        endif
 #    endif
 
 // Define whether or not Ogre compiled with NEON support.
@@ -539,6 +552,14 @@ THE SOFTWARE.
 #    define __OGRE_HAVE_SSE 0
 #endif
 
+#ifndef __OGRE_HAVE_AVX2
+#    define __OGRE_HAVE_AVX2 0
+#endif
+
+#ifndef __OGRE_HAVE_AVX512
+#    define __OGRE_HAVE_AVX512 0
+#endif
+
 #if OGRE_USE_SIMD == 0 || !defined( __OGRE_HAVE_NEON )
 #    define __OGRE_HAVE_NEON 0
 #endif
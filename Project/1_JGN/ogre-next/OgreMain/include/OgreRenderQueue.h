@@ -225,9 +225,63 @@ namespace Ogre
             StableSort,
         };
 
+        /// Counts which algorithm render() used every time it sorted a render queue group.
+        /// @see RenderQueue::getSortStats
+        struct SortStats
+        {
+            /// The camera's order from its previous frame only needed an insertion sort fixup.
+            uint32 temporalSorts;
+            /// The camera's previous order was tried, but too much had changed so it fell back
+            /// to a radix sort (also counted in radixSorts or parallelRadixSorts).
+            uint32 temporalFallbacks;
+            /// The keys were already in order when gathered from the worker threads.
+            uint32 alreadySorted;
+            /// LSD radix sorts performed on the render thread.
+            uint32 radixSorts;
+            /// LSD radix sorts split across SceneManager's worker threads.
+            uint32 parallelRadixSorts;
+            /// std::sort / std::stable_sort, used for groups too small to be worth a radix sort.
+            uint32 comparisonSorts;
+            /// Total number of elements shifted by the insertion sort fixups.
+            uint64 insertionMoves;
+
+            SortStats() :
+                temporalSorts( 0 ),
+                temporalFallbacks( 0 ),
+                alreadySorted( 0 ),
+                radixSorts( 0 ),
+                parallelRadixSorts( 0 ),
+                comparisonSorts( 0 ),
+                insertionMoves( 0 )
+            {
+            }
+        };
+
     private:
         typedef FastArray<QueuedRenderable> QueuedRenderableArray;
 
+        /// What actually gets sorted: the key and where the QueuedRenderable was before sorting.
+        struct RqSortEntry
+        {
+            uint64 hash;
+            uint32 idx;
+
+            bool operator<( const RqSortEntry &_r ) const { return this->hash < _r.hash; }
+        };
+        typedef FastArray<RqSortEntry> RqSortEntryArray;
+
+        /// Order in which a camera saw a render queue group the last time it got sorted.
+        /// sortedIndices[i] is the index (in gathering order) of the i-th sorted renderable.
+        struct TemporalSortCache
+        {
+            Camera const     *camera;
+            uint32            lastUsedFrame;
+            FastArray<uint32> sortedIndices;
+        };
+        typedef FastArray<TemporalSortCache> TemporalSortCacheArray;
+
+        class RadixSortTask;
+
         struct ThreadRenderQueue
         {
             QueuedRenderableArray q;
@@ -244,6 +298,8 @@ namespace Ogre
             RqSortMode                     mSortMode;
             bool                           mSorted;
             Modes                          mMode;
+            /// One per camera that rendered this group recently (NormalSort only).
+            TemporalSortCacheArray         mTemporalSortCaches;
 
             RenderQueueGroup() : mSortMode( NormalSort ), mSorted( false ), mMode( FAST ) {}
         };
@@ -287,6 +343,15 @@ namespace Ogre
 
         ParallelHlmsCompileQueue mParallelHlmsCompileQueue;
 
+        /// Scratch memory for sortRenderQueueGroup. Shared by all groups since they're
+        /// sorted one at a time from the render thread.
+        RqSortEntryArray      mSortEntries[2];
+        FastArray<uint32>     mRadixHistograms;
+        QueuedRenderableArray mSortedRenderables;
+        /// Incremented in frameEnded(), used to forget cameras that stopped rendering.
+        uint32    mFrameCount;
+        SortStats mSortStats;
+
         /** Returns a new (or an existing) indirect buffer that can hold the requested number of
         draws.
         @param numDraws
@@ -323,6 +388,26 @@ namespace Ogre
 
         void warmUpShaders( bool casterPass, const RenderQueueGroup &renderQueueGroup );
 
+        /** Sorts renderQueueGroup.mQueuedRenderables according to its mSortMode.
+        @remarks
+            For NormalSort the order the same camera got on its previous frame is reused and
+            fixed up with an insertion sort, which is nearly free when the set of renderables
+            barely changed. When there's no previous order, or it's too different, the keys
+            get an LSD radix sort which is split across the worker threads for large groups.
+            StableSort always goes through the radix sort, which is stable.
+        @param camera
+            Camera currently rendering. May be null, in which case nothing is remembered.
+        */
+        void sortRenderQueueGroup( RenderQueueGroup &renderQueueGroup, const Camera *camera );
+
+        /// Sorts mSortEntries[0] by hash. Returns the index of the mSortEntries holding the result.
+        /// keyDiff has a bit set for every bit that is not equal across all keys.
+        size_t radixSort( uint64 keyDiff );
+
+        /// Insertion sort of the first numEntries of mSortEntries[0]. Gives up (returning false)
+        /// after maxMoves shifts, leaving the array partially sorted.
+        bool insertionSort( size_t numEntries, size_t maxMoves );
+
     public:
         RenderQueue( HlmsManager *hlmsManager, SceneManager *sceneManager, VaoManager *vaoManager );
         ~RenderQueue();
@@ -434,6 +519,10 @@ namespace Ogre
         */
         void       setSortRenderQueue( uint8 rqId, RqSortMode sortMode );
         RqSortMode getSortRenderQueue( uint8 rqId ) const;
+
+        /// Returns how many times each sorting algorithm ran since the last resetSortStats().
+        const SortStats &getSortStats() const { return mSortStats; }
+        void             resetSortStats() { mSortStats = SortStats(); }
     };
 
 #define OGRE_RQ_MAKE_MASK( x ) ( ( 1 << ( x ) ) - 1 )
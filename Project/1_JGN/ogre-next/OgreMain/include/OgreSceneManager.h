@@ -39,7 +39,9 @@ Torus Knot Software Ltd.
 #include "Math/Array/OgreObjectMemoryManager.h"
 #include "OgreAnimationState.h"
 #include "OgreAutoParamDataSource.h"
+#include "OgreBitset.h"
 #include "OgreColourValue.h"
+#include "OgreCullBvh.h"
 #include "OgreLodListener.h"
 #include "OgrePlane.h"
 #include "OgreQuaternion.h"
@@ -48,6 +50,7 @@ Torus Knot Software Ltd.
 #include "OgreResourceGroupManager.h"
 #include "OgreSceneQuery.h"
 #include "Threading/OgreThreads.h"
+#include "Threading/OgreWorkStealingScheduler.h"
 
 #include "OgreHeaderPrefix.h"
 
@@ -813,10 +816,52 @@ namespace Ogre
             PARALLEL_HLMS_COMPILE,
             PARTICLE_SYSTEM_MANAGER2,
             USER_UNIFORM_SCALABLE_TASK,
-            STOP_THREADS,
             NUM_REQUESTS
         };
 
+        /// One depth level of a NodeMemoryManager, scheduled as a JobBatch.
+        /// request.numNodesPerThread is the number of nodes per job.
+        struct ScheduledNodeLevel
+        {
+            SceneManager          *sceneManager;
+            RequestType            requestType;
+            UpdateTransformRequest request;
+            /// First level of its NodeMemoryManager (does not depend on the previous level)
+            bool startsChain;
+        };
+
+        /// A slice of ObjectData (multiple of ARRAY_PACKED_REALS unless it's the last one)
+        struct ObjectRange
+        {
+            ObjectData objData;
+            size_t     numObjs;
+        };
+
+        /// One JobBatch per stage; each job processes mObjectRanges[firstRange + jobIdx]
+        struct ScheduledObjectRanges
+        {
+            SceneManager *sceneManager;
+            RequestType   requestType;
+            size_t        firstRange;
+            size_t        numRanges;
+        };
+
+        /// One CullBvh to (re)build, job jobIdx builds mScheduledCullBvhBuilds[jobIdx]
+        struct ScheduledCullBvhBuild
+        {
+            CullBvh         *bvh;
+            const ArrayAabb *worldAabb;
+            size_t           numObjs;
+            size_t           layoutVersion;
+        };
+
+        typedef vector<ScheduledNodeLevel>::type    ScheduledNodeLevelVec;
+        typedef vector<ObjectRange>::type           ObjectRangeVec;
+        typedef vector<ScheduledObjectRanges>::type ScheduledObjectRangesVec;
+        typedef vector<ScheduledCullBvhBuild>::type ScheduledCullBvhBuildVec;
+        typedef vector<CullBvh>::type               CullBvhVec;
+        typedef vector<bitset64>::type              bitset64Vec;
+
         size_t mNumWorkerThreads;
         bool   mForceMainThread;
         /// Performance optimization. When true, ParticleSystemManager2::_prepareParallel()
@@ -825,13 +870,36 @@ namespace Ogre
 
         CullFrustumRequest            mCurrentCullFrustumRequest;
         UpdateLodRequest              mUpdateLodRequest;
-        UpdateTransformRequest        mUpdateTransformRequest;
-        ObjectMemoryManagerVec const *mUpdateBoundsRequest;
         UniformScalableTask          *mUserTask;
         RequestType                   mRequestType;
+        /// Only used by PARTICLE_SYSTEM_MANAGER2 to sync between its two stages
         Barrier                      *mWorkerThreadsBarrier;
         ThreadHandleVec               mWorkerThreads;
 
+        /// Worker threads run jobs from here. Stages submit JobBatches (depth levels are
+        /// chained through dependencies) instead of firing all threads through a barrier.
+        WorkStealingScheduler *mJobScheduler;
+        /// Work still running after returning to the caller
+        /// (executeUserScalableTask with bBlock = false, _fireParallelHlmsCompile)
+        JobCounter mAsyncJobCounter;
+
+        ScheduledNodeLevelVec    mScheduledNodeLevels;
+        ObjectRangeVec           mObjectRanges;
+        ScheduledObjectRangesVec mScheduledObjectRanges;
+        ScheduledCullBvhBuildVec mScheduledCullBvhBuilds;
+
+        /// @see setStaticCullBvhEnabled
+        bool mStaticCullBvhEnabled;
+        /** BVHs over mEntityMemoryManager[SCENE_STATIC] ([0]) and
+            mForwardPlusMemoryManager[SCENE_STATIC] ([1]).
+            There is one per render queue and cullFrustum partition, i.e.
+            mStaticCullBvhs[i][rq * mNumWorkerThreads + threadIdx]. Partitions that are too
+            small to be worth it are left empty and go through the flat path.
+        */
+        CullBvhVec mStaticCullBvhs[2];
+        /// One per worker thread. Packs that survived CullBvh::cull
+        bitset64Vec mCullBvhVisiblePacks;
+
         /** Contains MovableObjects to be visited and rendered.
         @rermarks
             Declared here to avoid allocating and deallocating every frame. Declared as array of
@@ -918,19 +986,55 @@ namespace Ogre
         void updateAllTransformsTagOnTagThread( const UpdateTransformRequest &request,
                                                 size_t                        threadIdx );
 
-        /** Updates the world aabbs from the given request inside a thread. @see updateAllTransforms
-        @param threadIdx
-            Thread index so we know at which point we should start at.
-            Must be unique for each worker thread
+        /// Number of elements per job so that each thread gets a few jobs (leaving something
+        /// to steal when the split is uneven), but no less than minPerJob.
+        /// Always a multiple of ARRAY_PACKED_REALS.
+        size_t calculateElementsPerJob( size_t numElements, size_t minPerJob ) const;
+
+        /** Appends every non-empty depth level in [firstDepth; numDepths) of nodeMemoryManager
+            to mScheduledNodeLevels. requestType is used for the first level, nextRequestType
+            for the rest (TagPoints use a different update for children of bones).
         */
-        void updateAllBoundsThread( const ObjectMemoryManagerVec &objectMemManager, size_t threadIdx );
+        void gatherNodeLevels( NodeMemoryManager *nodeMemoryManager, size_t firstDepth,
+                               RequestType requestType, RequestType nextRequestType );
 
-        /**
-        @param threadIdx
-            Thread index so we know at which point we should start at.
-            Must be unique for each worker thread
+        /// Creates & submits one JobBatch per entry of mScheduledNodeLevels. Each level waits
+        /// for the previous one of the same NodeMemoryManager; different managers overlap.
+        void submitNodeLevels( JobCounter &counter );
+
+        /// Splits all ObjectData in [firstRq; lastRq) into mObjectRanges and adds
+        /// an entry to mScheduledObjectRanges.
+        void gatherObjectRanges( RequestType requestType, const ObjectMemoryManagerVec &objectMemManager,
+                                 size_t firstRq, size_t lastRq );
+
+        /// Creates & submits one JobBatch per entry of mScheduledObjectRanges. They run concurrently.
+        void submitObjectRanges( JobCounter &counter );
+
+        /** Returns the first object cullFrustum's threadIdx handles out of totalObjs,
+            and how many (a multiple of ARRAY_PACKED_REALS unless it's the last one).
         */
-        void updateAllLodsThread( const UpdateLodRequest &request, size_t threadIdx );
+        size_t calculateCullFrustumPartition( size_t totalObjs, size_t threadIdx,
+                                              size_t &outNumObjs ) const;
+
+        /// Returns the entry of mStaticCullBvhs for that memory manager, null if it has none.
+        const CullBvhVec *getStaticCullBvhs( const ObjectMemoryManager *memoryManager ) const;
+
+        /** Rebuilds the mStaticCullBvhs that are out of date: all of them if static nodes
+            or entities are dirty, otherwise only those whose ObjectMemoryManager layout changed.
+            Must be called after the static bounds have been updated.
+        */
+        void updateStaticCullBvhs();
+
+        /// Same as MovableObject::cullFrustum, but only for the packs that pass the BVH
+        void cullFrustumBvh( const CullBvh &bvh, size_t numObjs, ObjectData objData,
+                             const Camera *camera, MovableObject::MovableObjectArray &outVisibleObjects,
+                             const CullFrustumPreparedData &preparedData, size_t threadIdx );
+
+        static void updateNodeLevelJob( void *userData, size_t jobIdx, size_t threadIdx );
+        static void updateObjectRangeJob( void *userData, size_t jobIdx, size_t threadIdx );
+        static void buildCullBvhJob( void *userData, size_t jobIdx, size_t threadIdx );
+        /// jobIdx is used as the threadIdx of updateWorkerThreadImpl
+        static void updateWorkerThreadJob( void *userData, size_t jobIdx, size_t threadIdx );
 
         /** Low level culling, culls all objects against the given frustum active cameras. This
             includes checking visibility flags (both scene and viewport's)
@@ -953,7 +1057,6 @@ namespace Ogre
 
         void buildLightListThread01( const BuildLightListRequest &buildLightListRequest,
                                      size_t                       threadIdx );
-        void buildLightListThread02( size_t threadIdx );
 
         /** Gathers all objects that match the given scene visibility flags and render queue IDs.
         @param request
@@ -1890,6 +1993,17 @@ namespace Ogre
         */
         void notifyStaticDirty( Node *node );
 
+        /** Enables culling SCENE_STATIC Items, Entities, Decals and probes through a BVH
+            (@see CullBvh) instead of testing every one of them. Enabled by default.
+        @remarks
+            The BVH is rebuilt whenever static nodes or objects are flagged as dirty (and when
+            static objects are created, destroyed or change render queue), so it only pays off
+            when the static scene rarely changes. Dynamic objects always use the flat path.
+            The set of visible objects is exactly the same with or without the BVH.
+        */
+        void setStaticCullBvhEnabled( bool bEnabled );
+        bool getStaticCullBvhEnabled() const { return mStaticCullBvhEnabled; }
+
         /** Updates all skeletal animations in the scene. This is typically called once
             per frame during render, but the user might want to manually call this function.
         @remarks
@@ -2707,8 +2821,14 @@ namespace Ogre
         IlluminationRenderStage _getCurrentRenderStage() const { return mIlluminationStage; }
 
     protected:
+        /// Runs mRequestType as mNumWorkerThreads jobs (one per partition of the data).
+        /// Idle threads steal partitions; the calling thread executes jobs while waiting.
         void fireWorkerThreadsAndWait();
 
+        /// Runs mRequestType in every worker thread at the same time (pinned, never stolen).
+        /// For requests that block on a Barrier or wait for the main thread to feed them.
+        void fireWorkerThreadsPinned( JobCounter &counter );
+
         /** Launches cullFrustum on all worker threads with the requested parameters
         @remarks
             Will block until all threads are done.
@@ -2739,13 +2859,13 @@ namespace Ogre
         */
         void waitForPendingUserScalableTask();
 
-        /** Called from the worker thread, polls to process frustum culling
-            requests when a sync is performed
+        /** Called from the worker thread, runs jobs from mJobScheduler until the
+            SceneManager is destroyed
         */
         unsigned long _updateWorkerThread( ThreadHandle *threadHandle );
 
     protected:
-        inline bool updateWorkerThreadImpl( size_t threadIdx );
+        inline void updateWorkerThreadImpl( size_t threadIdx );
     };
 
     /** Default implementation of IntersectionSceneQuery. */
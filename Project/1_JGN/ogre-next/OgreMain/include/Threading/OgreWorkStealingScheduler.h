@@ -0,0 +1,215 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE-Next
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef _OgreWorkStealingScheduler_H_
+#define _OgreWorkStealingScheduler_H_
+
+#include "OgrePrerequisites.h"
+
+#include "OgreFastArray.h"
+#include "Threading/OgreLightweightMutex.h"
+#include "Threading/OgreWaitableEvent.h"
+
+#include <atomic>
+#include <deque>
+
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre
+{
+    /** Counts the JobBatches that have been created but have not finished yet.
+        Each batch is counted from WorkStealingScheduler::createBatch until its last job
+        returns, so a counter also covers batches still waiting on their dependencies.
+    */
+    struct JobCounter
+    {
+        std::atomic<size_t> pendingBatches;
+
+        JobCounter() : pendingBatches( 0u ) {}
+
+        bool isDone() const { return pendingBatches.load( std::memory_order_acquire ) == 0u; }
+    };
+
+    /** Job system used by SceneManager's worker threads.
+    @remarks
+        Work is submitted in batches: a JobBatch is a function that will be called numJobs
+        times with jobIdx in range [0; numJobs). Each thread (workers + the thread that calls
+        wait, which helps while it waits) owns a job queue. The owner pops from the back while
+        idle threads steal from the front of everyone else's queue, so an uneven split doesn't
+        leave cores idle until the slowest thread finishes.
+    @par
+        Batches can depend on other batches (e.g. node depth level N + 1 depends on level N).
+        A dependent batch is pushed by whichever thread finishes the last job of its last
+        dependency, so chains of batches run without going back to the main thread.
+    @par
+        broadcast() runs a job pinned to every worker thread at the same time, for legacy
+        requests that need all threads to be running (i.e. they sync on a Barrier or wait
+        for the main thread to feed them). Pinned jobs are never stolen.
+    @par
+        createBatch, addDependency, submit, broadcast and wait must all be called from the
+        same thread (Ogre's main thread). Jobs run in any thread, including the main one.
+    */
+    class _OgreExport WorkStealingScheduler
+    {
+    public:
+        /// threadIdx is the index of the thread running the job, in range [0; getNumThreads())
+        typedef void ( *JobFunc )( void *userData, size_t jobIdx, size_t threadIdx );
+
+        struct JobBatch
+        {
+            JobFunc func;
+            void   *userData;
+            size_t  numJobs;
+
+            std::atomic<size_t> remainingJobs;
+            /// Unfinished dependencies + 1 until submit() is called
+            std::atomic<size_t> unmetDependencies;
+
+            JobCounter           *counter;
+            FastArray<JobBatch *> successors;
+
+            JobBatch() :
+                func( 0 ),
+                userData( 0 ),
+                numJobs( 0 ),
+                remainingJobs( 0u ),
+                unmetDependencies( 0u ),
+                counter( 0 )
+            {
+            }
+        };
+
+    protected:
+        struct Job
+        {
+            JobBatch *batch;
+            size_t    jobIdx;
+        };
+
+        /// Ring-less deque: jobs in [head; jobs.size()). Reset when it becomes empty
+        /// so the steady state doesn't allocate.
+        struct ThreadQueue
+        {
+            LightweightMutex mutex;
+            FastArray<Job>   jobs;
+            size_t           head;
+
+            /// Pinned job from broadcast(). Only used by worker threads
+            JobBatch         *pinnedBatch;
+            size_t            pinnedJobIdx;
+            std::atomic<bool> pinnedPending;
+
+            std::atomic<bool> sleeping;
+            WaitableEvent     wakeEvent;
+
+            ThreadQueue() :
+                head( 0 ),
+                pinnedBatch( 0 ),
+                pinnedJobIdx( 0 ),
+                pinnedPending( false ),
+                sleeping( false )
+            {
+            }
+        };
+
+        size_t mNumWorkerThreads;
+        /// mNumWorkerThreads + 1. The last queue belongs to the thread calling wait()
+        std::deque<ThreadQueue> mQueues;
+
+        /// Number of jobs sitting in all queues (approximate while jobs are being pushed)
+        std::atomic<size_t> mQueuedJobs;
+        std::atomic<bool>   mStop;
+
+        /// Batches are recycled once every batch has finished (see wait)
+        std::deque<JobBatch> mBatchPool;
+        size_t               mNumUsedBatches;
+        std::atomic<size_t>  mLiveBatches;
+
+        /// Set while wait() sleeps, so that batches launched from a worker (i.e. chained
+        /// successors) wake the main thread up to help with them
+        std::atomic<bool> mMainThreadSleeping;
+        WaitableEvent     mMainThreadEvent;
+
+        void launchBatch( JobBatch *batch, size_t threadIdx );
+        void finishJob( JobBatch *batch, size_t threadIdx );
+        void finishBatch( JobBatch *batch, size_t threadIdx );
+
+        /// Pops a job from our own queue or steals one from another thread's.
+        /// Returns false if every queue was empty.
+        bool executeOneJob( size_t threadIdx );
+
+        void wakeWorkers( size_t maxWorkers );
+
+    public:
+        /// Does not create threads. The owner creates numWorkerThreads threads that call
+        /// _workerThreadLoop. numWorkerThreads = 0 runs everything inside wait().
+        WorkStealingScheduler( size_t numWorkerThreads );
+        ~WorkStealingScheduler();
+
+        size_t getNumWorkerThreads() const { return mNumWorkerThreads; }
+        /// Worker threads + the main thread
+        size_t getNumThreads() const { return mNumWorkerThreads + 1u; }
+
+        /** Creates a batch that calls func( userData, jobIdx, threadIdx ) numJobs times.
+            The batch does not run until submit() is called.
+        @param counter
+            Incremented now and decremented once every job in the batch finished.
+            Must outlive the batch.
+        @return
+            Pointer valid until wait() returns with no batch left in flight.
+        */
+        JobBatch *createBatch( JobFunc func, void *userData, size_t numJobs, JobCounter &counter );
+
+        /** Makes 'batch' wait until 'dependsOn' finished.
+            Both must have been created but 'dependsOn' must not have been submitted yet.
+        */
+        void addDependency( JobBatch *batch, JobBatch *dependsOn );
+
+        /// Queues the batch's jobs, or leaves them pending until its dependencies finish.
+        void submit( JobBatch *batch );
+
+        /** Runs func( userData, workerIdx, workerIdx ) once in every worker thread.
+            Requires getNumWorkerThreads() > 0 and every previously submitted batch
+            to have finished (otherwise some workers may take a long time to pick it up).
+        */
+        void broadcast( JobFunc func, void *userData, JobCounter &counter );
+
+        /// Executes jobs in the calling thread until the counter reaches zero.
+        void wait( JobCounter &counter );
+
+        /// Wakes up and terminates all _workerThreadLoop calls. No job may be in flight.
+        void stop();
+
+        /// Called by each worker thread. Returns after stop().
+        void _workerThreadLoop( size_t threadIdx );
+    };
+}  // namespace Ogre
+
+#include "OgreHeaderSuffix.h"
+
+#endif
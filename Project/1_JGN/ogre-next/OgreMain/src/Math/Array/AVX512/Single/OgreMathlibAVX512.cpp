@@ -0,0 +1,122 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE-Next
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include <OgreStableHeaders.h>
+
+#include "OgrePlatformInformation.h"
+
+#if __OGRE_HAVE_AVX512
+#    define __Mathlib_H__  // Neded to directly include OgreMathlibAVX512
+
+#    include "Math/Array/OgreArrayConfig.h"
+#    include "Math/Array/OgreBooleanMask.h"
+#    include "Math/Array/AVX512/Single/OgreMathlibAVX512.h"
+#    include "Math/Array/AVX512/Single/avx512_mathfun.h"
+
+namespace Ogre
+{
+    const ArrayReal MathlibAVX512::HALF = _mm512_set1_ps( 0.5f );
+    const ArrayReal MathlibAVX512::ONE = _mm512_set1_ps( 1.0f );
+    const ArrayReal MathlibAVX512::THREE = _mm512_set1_ps( 3.0f );
+    const ArrayReal MathlibAVX512::NEG_ONE = _mm512_set1_ps( -1.0f );
+    const ArrayReal MathlibAVX512::fEpsilon = _mm512_set1_ps( 1e-6f );
+    const ArrayReal MathlibAVX512::fSqEpsilon = _mm512_set1_ps( 1e-12f );
+    const ArrayReal MathlibAVX512::OneMinusEpsilon = _mm512_set1_ps( 1.0f - 1e-6f );
+    const ArrayReal MathlibAVX512::FLOAT_MIN = _mm512_set1_ps( std::numeric_limits<Real>::min() );
+    const ArrayReal MathlibAVX512::SIGN_MASK = _mm512_set1_ps( -0.0f );
+    const ArrayReal MathlibAVX512::INFINITEA = _mm512_set1_ps( std::numeric_limits<Real>::infinity() );
+    const ArrayReal MathlibAVX512::MAX_NEG = _mm512_set1_ps( -std::numeric_limits<Real>::max() );
+    const ArrayReal MathlibAVX512::MAX_POS = _mm512_set1_ps( std::numeric_limits<Real>::max() );
+    const __m128 MathlibAVX512::LAST_AFFINE_COLUMN = _mm_setr_ps( 0, 0, 0, 1 );
+
+    static const Real _PI = Real( 3.14159265358979323846264338327950288 );
+    // We can't use Math::fDeg2Rad & Math::fRad2Deg directly because
+    // it's not guaranteed to have been initialized first
+    const ArrayReal MathlibAVX512::PI = _mm512_set1_ps( _PI );
+    const ArrayReal MathlibAVX512::TWO_PI = _mm512_set1_ps( 2.0f * _PI );
+    const ArrayReal MathlibAVX512::fDeg2Rad = _mm512_set1_ps( _PI / 180.0f );
+    const ArrayReal MathlibAVX512::fRad2Deg = _mm512_set1_ps( 180.0f / _PI );
+
+    const ArrayReal MathlibAVX512::ONE_DIV_2PI = _mm512_set1_ps( 1.0f / ( 2.0f * _PI ) );
+
+    //-----------------------------------------------------------------------------------
+    ArrayReal MathlibAVX512::Sin4( ArrayReal x )
+    {
+        // Map arbitrary angle x to the range [-pi; +pi] without using division.
+        // Code taken from MSDN's HLSL trick. AVX-512F has fused multiply-add, so
+        // the add, the sub, & the two muls become two fused mads
+        ArrayReal integralPart;
+        x = _mm512_madd_ps( x, ONE_DIV_2PI, HALF );
+        x = Modf4( x, integralPart );
+        x = _mm512_fmsub_ps( x, TWO_PI, PI );
+
+        return sin512_ps( x );
+    }
+    //-----------------------------------------------------------------------------------
+    ArrayReal MathlibAVX512::Cos4( ArrayReal x )
+    {
+        // Map arbitrary angle x to the range [-pi; +pi] without using division.
+        // Code taken from MSDN's HLSL trick. AVX-512F has fused multiply-add, so
+        // the add, the sub, & the two muls become two fused mads
+        ArrayReal integralPart;
+        x = _mm512_madd_ps( x, ONE_DIV_2PI, HALF );
+        x = Modf4( x, integralPart );
+        x = _mm512_fmsub_ps( x, TWO_PI, PI );
+
+        return cos512_ps( x );
+    }
+    //-----------------------------------------------------------------------------------
+    void MathlibAVX512::SinCos4( ArrayReal x, ArrayReal &outSin, ArrayReal &outCos )
+    {
+        // TODO: Improve accuracy by mapping to the range [-pi/4, pi/4] and swap
+        // between cos & sin depending on which quadrant it fell:
+        // Quadrant | sin     |  cos
+        // n = 0 ->  sin( x ),  cos( x )
+        // n = 1 ->  cos( x ), -sin( x )
+        // n = 2 -> -sin( x ), -cos( x )
+        // n = 3 -> -sin( x ),  sin( x )
+        // See ARGUMENT REDUCTION FOR HUGE ARGUMENTS:
+        // Good to the Last Bit
+        // K. C. Ng and themembers of the FP group of SunPro
+        // http://www.derekroconnor.net/Software/Ng--ArgReduction.pdf
+
+        // -- Perhaps we can leave this to GSoC students? --
+
+        // Map arbitrary angle x to the range [-pi; +pi] without using division.
+        // Code taken from MSDN's HLSL trick. AVX-512F has fused multiply-add, so
+        // the add, the sub, & the two muls become two fused mads
+        ArrayReal integralPart;
+        x = _mm512_madd_ps( x, ONE_DIV_2PI, HALF );
+        x = Modf4( x, integralPart );
+        x = _mm512_fmsub_ps( x, TWO_PI, PI );
+
+        sincos512_ps( x, &outSin, &outCos );
+    }
+
+}  // namespace Ogre
+#endif
@@ -36,6 +36,7 @@ namespace Ogre
 {
     ObjectMemoryManager::ObjectMemoryManager() :
         mTotalObjects( 0 ),
+        mLayoutVersion( 0 ),
         mDummyNode( 0 ),
         mDummyObject( 0 ),
         mMemoryManagerType( SCENE_DYNAMIC ),
@@ -134,6 +135,7 @@ namespace Ogre
         mgr.createNewNode( outObjectData );
 
         ++mTotalObjects;
+        ++mLayoutVersion;
     }
     //-----------------------------------------------------------------------------------
     void ObjectMemoryManager::objectMoved( ObjectData &inOutObjectData, size_t oldRenderQueue,
@@ -150,6 +152,7 @@ namespace Ogre
         mgr.destroyNode( inOutObjectData );
 
         inOutObjectData = tmp;
+        ++mLayoutVersion;
     }
     //-----------------------------------------------------------------------------------
     void ObjectMemoryManager::objectDestroyed( ObjectData &outObjectData, size_t renderQueue )
@@ -158,6 +161,7 @@ namespace Ogre
         mgr.destroyNode( outObjectData );
 
         --mTotalObjects;
+        ++mLayoutVersion;
     }
     //-----------------------------------------------------------------------------------
     void ObjectMemoryManager::migrateTo( ObjectData &inOutObjectData, size_t renderQueue,
@@ -180,6 +184,8 @@ namespace Ogre
             itor->defragment();
             ++itor;
         }
+
+        ++mLayoutVersion;
     }
     //-----------------------------------------------------------------------------------
     void ObjectMemoryManager::shrinkToFit()
@@ -192,6 +198,8 @@ namespace Ogre
             itor->shrinkToFit();
             ++itor;
         }
+
+        ++mLayoutVersion;
     }
     //-----------------------------------------------------------------------------------
     size_t ObjectMemoryManager::getNumRenderQueues() const
@@ -0,0 +1,313 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE-Next
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "OgreStableHeaders.h"
+
+#include "OgreCullBvh.h"
+
+#include "Math/Array/OgreBooleanMask.h"
+#include "OgreBitset.h"
+#include "OgreBitset.inl"
+#include "OgreMovableObject.h"
+
+#include <cmath>
+
+namespace Ogre
+{
+    /// Splits are done at the median, so the tree is at most log2( numObjects ) / log2( c_nodeWidth )
+    /// levels deep and the traversal stack never holds more than (c_nodeWidth - 1) nodes per level.
+    static const size_t c_maxStackSize = 32u * CullBvh::c_nodeWidth;
+
+    namespace
+    {
+        struct BuildObject
+        {
+            Aabb   aabb;
+            uint32 pack;
+        };
+
+        struct BuildNode
+        {
+            Aabb   aabb[CullBvh::c_nodeWidth];
+            uint32 children[CullBvh::c_nodeWidth];
+            uint32 firstObject[CullBvh::c_nodeWidth];
+            uint32 numObjects[CullBvh::c_nodeWidth];
+            uint32 numChildren;
+        };
+
+        struct CenterLess
+        {
+            size_t axis;
+            CenterLess( size_t _axis ) : axis( _axis ) {}
+            bool operator()( const BuildObject &a, const BuildObject &b ) const
+            {
+                return a.aabb.mCenter[axis] < b.aabb.mCenter[axis];
+            }
+        };
+
+        bool isFinite( const Vector3 &v )
+        {
+            return std::isfinite( v.x ) && std::isfinite( v.y ) && std::isfinite( v.z );
+        }
+
+        /// Recursively halves [first; first + count) along the axis where the centers
+        /// are most spread out, until there are numGroups groups.
+        void splitObjects( BuildObject *objects, size_t first, size_t count, size_t numGroups,
+                           uint32 *outFirst, uint32 *outCount, size_t &inOutNumGroups )
+        {
+            if( numGroups <= 1u || count <= 1u )
+            {
+                outFirst[inOutNumGroups] = static_cast<uint32>( first );
+                outCount[inOutNumGroups] = static_cast<uint32>( count );
+                ++inOutNumGroups;
+                return;
+            }
+
+            Vector3 centerMin = objects[first].aabb.mCenter;
+            Vector3 centerMax = centerMin;
+            for( size_t i = first + 1u; i < first + count; ++i )
+            {
+                centerMin.makeFloor( objects[i].aabb.mCenter );
+                centerMax.makeCeil( objects[i].aabb.mCenter );
+            }
+
+            const Vector3 spread = centerMax - centerMin;
+            size_t axis = 0u;
+            if( spread.y > spread[axis] )
+                axis = 1u;
+            if( spread.z > spread[axis] )
+                axis = 2u;
+
+            const size_t half = count >> 1u;
+            std::nth_element( objects + first, objects + first + half, objects + first + count,
+                              CenterLess( axis ) );
+
+            splitObjects( objects, first, half, numGroups >> 1u, outFirst, outCount, inOutNumGroups );
+            splitObjects( objects, first + half, count - half, numGroups >> 1u, outFirst, outCount,
+                          inOutNumGroups );
+        }
+
+        uint32 buildNode( BuildObject *objects, size_t first, size_t count,
+                          FastArray<BuildNode> &nodes )
+        {
+            const uint32 nodeIdx = static_cast<uint32>( nodes.size() );
+            nodes.push_back( BuildNode() );
+
+            uint32 groupFirst[CullBvh::c_nodeWidth];
+            uint32 groupCount[CullBvh::c_nodeWidth];
+            size_t numGroups = 0u;
+            splitObjects( objects, first, count, CullBvh::c_nodeWidth, groupFirst, groupCount,
+                          numGroups );
+
+            for( size_t i = 0u; i < numGroups; ++i )
+            {
+                Aabb   aabb = objects[groupFirst[i]].aabb;
+                uint32 child = 0u;  // CullBvh::c_leafChild
+
+                if( groupCount[i] > 1u )
+                {
+                    Vector3 vMin = aabb.getMinimum();
+                    Vector3 vMax = aabb.getMaximum();
+                    for( size_t j = groupFirst[i] + 1u; j < groupFirst[i] + groupCount[i]; ++j )
+                    {
+                        vMin.makeFloor( objects[j].aabb.getMinimum() );
+                        vMax.makeCeil( objects[j].aabb.getMaximum() );
+                    }
+                    aabb.setExtents( vMin, vMax );
+
+                    // Converting back to center + half size rounds; grow the box slightly
+                    // so it never ends up smaller than the objects inside it.
+                    const Vector3 margin( Math::Abs( aabb.mCenter.x ) + aabb.mHalfSize.x,
+                                          Math::Abs( aabb.mCenter.y ) + aabb.mHalfSize.y,
+                                          Math::Abs( aabb.mCenter.z ) + aabb.mHalfSize.z );
+                    aabb.mHalfSize += margin * Real( 1e-5 );
+
+                    child = buildNode( objects, groupFirst[i], groupCount[i], nodes );
+                }
+
+                BuildNode &node = nodes[nodeIdx];
+                node.aabb[i] = aabb;
+                node.children[i] = child;
+                node.firstObject[i] = groupFirst[i];
+                node.numObjects[i] = groupCount[i];
+            }
+
+            nodes[nodeIdx].numChildren = static_cast<uint32>( numGroups );
+
+            return nodeIdx;
+        }
+    }  // namespace
+    //-----------------------------------------------------------------------------------
+    CullBvh::CullBvh() : mNumObjects( 0u ), mLayoutVersion( 0u ) {}
+    //-----------------------------------------------------------------------------------
+    void CullBvh::build( const ArrayAabb *worldAabb, size_t numObjects, size_t layoutVersion )
+    {
+        clear();
+
+        FastArray<BuildObject> objects;
+        objects.reserve( numObjects );
+
+        for( size_t i = 0u; i < numObjects; i += ARRAY_PACKED_REALS )
+        {
+            const uint32 pack = static_cast<uint32>( i / ARRAY_PACKED_REALS );
+            const size_t numInPack = std::min<size_t>( ARRAY_PACKED_REALS, numObjects - i );
+
+            bool alwaysVisible = false;
+            for( size_t j = 0u; j < numInPack; ++j )
+            {
+                BuildObject object;
+                worldAabb[pack].getAsAabb( object.aabb, j );
+                object.pack = pack;
+
+                // MovableObject::cullFrustum lets infinite boxes through. Objects whose
+                // bounds haven't been calculated yet are also infinite.
+                if( isFinite( object.aabb.mCenter ) && isFinite( object.aabb.mHalfSize ) )
+                    objects.push_back( object );
+                else
+                    alwaysVisible = true;
+            }
+
+            if( alwaysVisible )
+                mAlwaysVisiblePacks.push_back( pack );
+        }
+
+        if( !objects.empty() )
+        {
+            FastArray<BuildNode> buildNodes;
+            buildNodes.reserve( ( objects.size() * 2u ) / ( c_nodeWidth - 1u ) + 1u );
+            buildNode( objects.begin(), 0u, objects.size(), buildNodes );
+
+            RawSimdUniquePtr<Node, MEMCATEGORY_SCENE_CONTROL> nodes( buildNodes.size() );
+            for( size_t i = 0u; i < buildNodes.size(); ++i )
+            {
+                const BuildNode &buildNode = buildNodes[i];
+                Node &node = nodes.get()[i];
+
+                for( size_t j = 0u; j < c_nodeWidth; ++j )
+                {
+                    const bool used = j < buildNode.numChildren;
+                    node.aabb[j / ARRAY_PACKED_REALS].setFromAabb(
+                        used ? buildNode.aabb[j] : Aabb::BOX_ZERO, j % ARRAY_PACKED_REALS );
+                    node.children[j] = used ? buildNode.children[j] : c_leafChild;
+                    node.firstObject[j] = used ? buildNode.firstObject[j] : 0u;
+                    node.numObjects[j] = used ? buildNode.numObjects[j] : 0u;
+                }
+                node.childMask = ( 1u << buildNode.numChildren ) - 1u;
+            }
+            mNodes.swap( nodes );
+
+            mObjectPacks.resizePOD( objects.size() );
+            for( size_t i = 0u; i < objects.size(); ++i )
+                mObjectPacks[i] = objects[i].pack;
+        }
+
+        mNumObjects = numObjects;
+        mLayoutVersion = layoutVersion;
+    }
+    //-----------------------------------------------------------------------------------
+    void CullBvh::clear()
+    {
+        RawSimdUniquePtr<Node, MEMCATEGORY_SCENE_CONTROL> emptyNodes;
+        mNodes.swap( emptyNodes );
+        mObjectPacks.clear();
+        mAlwaysVisiblePacks.clear();
+        mNumObjects = 0u;
+        mLayoutVersion = 0u;
+    }
+    //-----------------------------------------------------------------------------------
+    void CullBvh::cull( const ArrayPlane *RESTRICT_ALIAS planes, bitset64 &inOutVisiblePacks ) const
+    {
+        FastArray<uint32>::const_iterator itor = mAlwaysVisiblePacks.begin();
+        FastArray<uint32>::const_iterator endt = mAlwaysVisiblePacks.end();
+        while( itor != endt )
+            inOutVisiblePacks.set( *itor++ );
+
+        if( !mNodes.size() )
+            return;
+
+        const Node *RESTRICT_ALIAS nodes = mNodes.get();
+        const uint32 *RESTRICT_ALIAS objectPacks = mObjectPacks.begin();
+
+        uint32 stack[c_maxStackSize];
+        size_t stackSize = 1u;
+        stack[0] = 0u;
+
+        while( stackSize )
+        {
+            const Node &node = nodes[stack[--stackSize]];
+
+            for( size_t i = 0u; i < c_numChildPacks; ++i )
+            {
+                const ArrayAabb &aabb = node.aabb[i];
+
+                // Same test as MovableObject::cullFrustum for 'intersects'. A box is fully
+                // inside if its corner nearest to each plane is in front of it too.
+                ArrayMaskR intersects = BooleanMask4::getAllSetMask();
+                ArrayMaskR inside = BooleanMask4::getAllSetMask();
+                for( size_t p = 0u; p < 6u; ++p )
+                {
+                    const ArrayVector3 flippedHalfSize = aabb.mHalfSize * planes[p].signFlip;
+                    ArrayReal dotResult =
+                        planes[p].planeNormal.dotProduct( aabb.mCenter + flippedHalfSize );
+                    intersects = Mathlib::And(
+                        intersects, Mathlib::CompareGreater( dotResult, planes[p].planeNegD ) );
+                    dotResult = planes[p].planeNormal.dotProduct( aabb.mCenter - flippedHalfSize );
+                    inside =
+                        Mathlib::And( inside, Mathlib::CompareGreater( dotResult, planes[p].planeNegD ) );
+                }
+
+                const uint32 intersectsMask = BooleanMask4::getScalarMask( intersects ) &
+                                              ( node.childMask >> ( i * ARRAY_PACKED_REALS ) );
+                const uint32 insideMask = BooleanMask4::getScalarMask( inside );
+
+                for( size_t j = 0u; j < ARRAY_PACKED_REALS; ++j )
+                {
+                    if( IS_BIT_SET( j, intersectsMask ) )
+                    {
+                        const size_t childIdx = i * ARRAY_PACKED_REALS + j;
+                        const uint32 child = node.children[childIdx];
+
+                        if( child == c_leafChild || IS_BIT_SET( j, insideMask ) )
+                        {
+                            const uint32 *RESTRICT_ALIAS packs =
+                                objectPacks + node.firstObject[childIdx];
+                            const uint32 numObjects = node.numObjects[childIdx];
+                            for( uint32 k = 0u; k < numObjects; ++k )
+                                inOutVisiblePacks.set( packs[k] );
+                        }
+                        else
+                        {
+                            OGRE_ASSERT_MEDIUM( stackSize < c_maxStackSize );
+                            stack[stackSize++] = child;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}  // namespace Ogre
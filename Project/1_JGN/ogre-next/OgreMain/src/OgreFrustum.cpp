@@ -942,10 +942,11 @@ namespace Ogre
 
         ArrayVector3 corners[( 8 + ARRAY_PACKED_REALS - 1 ) / ARRAY_PACKED_REALS];
 
-        // We need 32 scalarCorners (8 vertices x 4 elements per vertex) but starting
-        // ARRAY_PACKED_REALS > 8; we need more to prevent buffer overruns
+        // We need 32 scalarCorners (8 vertices x 4 elements per vertex) but loadFromAoS
+        // reads ARRAY_PACKED_REALS * 4 at a time; with ARRAY_PACKED_REALS > 8 we need more
+        // to prevent buffer overruns
         OGRE_ALIGNED_DECL(
-            Real, scalarCorners[8 * 4 * ( ARRAY_PACKED_REALS <= 8 ? 1 : ( ARRAY_PACKED_REALS / 8 ) )],
+            Real, scalarCorners[ARRAY_PACKED_REALS * 4 > 32 ? ARRAY_PACKED_REALS * 4 : 32],
             OGRE_SIMD_ALIGNMENT );
         memset( scalarCorners, 0, sizeof( scalarCorners ) );
 
@@ -969,7 +970,7 @@ namespace Ogre
 
         // For ARRAY_PACKED_REALS > 8; repeat the last point (to make
         // functions like CollapseMin & CollapseMax work correctly)
-        for( size_t i = 32; i < ARRAY_PACKED_REALS * 8; i += 4 )
+        for( size_t i = 32; i < ARRAY_PACKED_REALS * 4; i += 4 )
         {
             scalarCorners[i + 0] = farRight;
             scalarCorners[i + 1] = farBottom;
@@ -1729,24 +1729,115 @@ namespace Ogre
         return syntaxError;
     }
     //-----------------------------------------------------------------------------------
+    uint32 Hlms::calculateRenderableCacheHash( const HlmsPropertyVec &renderableSetProperties,
+                                               const PiecesMap *pieces )
+    {
+        uint32 hash = HashCombine( 0u, static_cast<uint32>( renderableSetProperties.size() ) );
+
+        // setProperties is always sorted by key, so equal vectors hash the same
+        HlmsPropertyVec::const_iterator itor = renderableSetProperties.begin();
+        HlmsPropertyVec::const_iterator endt = renderableSetProperties.end();
+        while( itor != endt )
+        {
+            hash = HashCombine( hash, itor->keyName.mHash );
+            hash = HashCombine( hash, itor->value );
+            ++itor;
+        }
+
+        if( pieces )
+        {
+            for( uint32 i = 0u; i < NumShaderTypes; ++i )
+            {
+                // Empty maps don't contribute so that null pieces hash the same as empty ones
+                if( pieces[i].empty() )
+                    continue;
+
+                hash = HashCombine( hash, i );
+
+                PiecesMap::const_iterator itPiece = pieces[i].begin();
+                PiecesMap::const_iterator enPiece = pieces[i].end();
+                while( itPiece != enPiece )
+                {
+                    hash = HashCombine( hash, itPiece->first.mHash );
+                    hash = FastHash( itPiece->second.c_str(),
+                                     static_cast<int>( itPiece->second.size() ), hash );
+                    ++itPiece;
+                }
+            }
+        }
+
+        return hash;
+    }
+    //-----------------------------------------------------------------------------------
+    void Hlms::growRenderableCacheTable()
+    {
+        const size_t newSize = std::max<size_t>( mRenderableCacheTable.size() * 2u, 64u );
+        const size_t mask = newSize - 1u;
+
+        mRenderableCacheTable.clear();
+        mRenderableCacheTable.resize( newSize, 0u );
+
+        const size_t numEntries = mRenderableCacheHashes.size();
+        for( size_t i = 0u; i < numEntries; ++i )
+        {
+            size_t slot = mRenderableCacheHashes[i] & mask;
+            while( mRenderableCacheTable[slot] != 0u )
+                slot = ( slot + 1u ) & mask;
+            mRenderableCacheTable[slot] = static_cast<uint32>( i + 1u );
+        }
+    }
+    //-----------------------------------------------------------------------------------
     uint32 Hlms::addRenderableCache( const HlmsPropertyVec &renderableSetProperties,
                                      const PiecesMap *pieces )
     {
         assert( mRenderableCache.size() <= HlmsBits::RenderableMask );
+        assert( mRenderableCache.size() == mRenderableCacheHashes.size() &&
+                "mRenderableCache modified without going through addRenderableCache" );
+
+        // Keep the table at most half full (counting the entry we may be about to add)
+        if( ( mRenderableCache.size() + 1u ) * 2u > mRenderableCacheTable.size() )
+            growRenderableCacheTable();
+
+        const uint32 hash = calculateRenderableCacheHash( renderableSetProperties, pieces );
 
-        RenderableCache cacheEntry( renderableSetProperties, pieces );
+        const size_t mask = mRenderableCacheTable.size() - 1u;
+        size_t slot = hash & mask;
+        uint32 entryIdx = std::numeric_limits<uint32>::max();
+
+        while( mRenderableCacheTable[slot] != 0u )
+        {
+            ++mRenderableCacheStats.probes;
 
-        RenderableCacheVec::iterator it =
-            std::find( mRenderableCache.begin(), mRenderableCache.end(), cacheEntry );
-        if( it == mRenderableCache.end() )
+            const uint32 idx = mRenderableCacheTable[slot] - 1u;
+            if( mRenderableCacheHashes[idx] == hash &&
+                mRenderableCache[idx].equals( renderableSetProperties, pieces ) )
+            {
+                entryIdx = idx;
+                break;
+            }
+
+            slot = ( slot + 1u ) & mask;
+        }
+
+        if( entryIdx == std::numeric_limits<uint32>::max() )
+        {
+            // Reached an empty slot, it's not in the cache
+            ++mRenderableCacheStats.probes;
+            ++mRenderableCacheStats.misses;
+
+            entryIdx = static_cast<uint32>( mRenderableCache.size() );
+            mRenderableCache.push_back( RenderableCache( renderableSetProperties, pieces ) );
+            mRenderableCacheHashes.push_back( hash );
+            mRenderableCacheTable[slot] = entryIdx + 1u;
+        }
+        else
         {
-            mRenderableCache.push_back( cacheEntry );
-            it = mRenderableCache.end() - 1;
+            ++mRenderableCacheStats.hits;
         }
 
         // 3 bits for mType (see getMaterial)
         return ( static_cast<uint32>( mType ) << HlmsBits::HlmsTypeShift ) |
-               ( static_cast<uint32>( it - mRenderableCache.begin() ) << HlmsBits::RenderableShift );
+               ( entryIdx << HlmsBits::RenderableShift );
     }
     //-----------------------------------------------------------------------------------
     const Hlms::RenderableCache &Hlms::getRenderableCache( uint32 hash ) const
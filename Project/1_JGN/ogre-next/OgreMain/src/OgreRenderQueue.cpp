@@ -48,6 +48,7 @@ THE SOFTWARE.
 #include "OgreTechnique.h"
 #include "OgreTimer.h"
 #include "ParticleSystem/OgreParticleSystem2.h"
+#include "Threading/OgreUniformScalableTask.h"
 #include "Vao/OgreConstBufferPacked.h"
 #include "Vao/OgreIndexBufferPacked.h"
 #include "Vao/OgreIndirectBufferPacked.h"
@@ -85,6 +86,70 @@ namespace Ogre
     const int RqBits::TextureShiftTransp    = MeshShiftTransp   - TextureBits;      //0
     // clang-format on
 
+    /// Below this size std::sort beats the fixed cost of the radix sort passes.
+    static const size_t c_minRadixSortSize = 256u;
+    /// Below this size waking up the worker threads costs more than what they save.
+    static const size_t c_minParallelRadixSortSize = 16384u;
+    /// How many shifts per renderable (on average) the temporal insertion sort may do
+    /// before we consider the previous frame's order useless and fall back to radix sort.
+    static const size_t c_maxInsertionMovesPerEntry = 8u;
+    /// Cameras that didn't render a group for this many frames lose their cached order.
+    static const uint32 c_temporalSortCacheMaxAge = 60u;
+
+    /** One phase of an LSD radix pass over 8 bits of RqSortEntry::hash.
+        Each thread works on its own contiguous slice of the source and owns one
+        256-entry row of the histogram, so the slices stay in order within each
+        bucket and the sort is stable.
+    */
+    class RenderQueue::RadixSortTask final : public UniformScalableTask
+    {
+    public:
+        enum Phase
+        {
+            /// Count how many keys of the slice fall in each bucket
+            Histogram,
+            /// Move the keys to the offsets computed from the histograms
+            Scatter
+        };
+
+        RqSortEntry const *mSrc;
+        RqSortEntry       *mDst;
+        uint32            *mHistograms;
+        size_t             mNumEntries;
+        uint32             mShift;
+        Phase              mPhase;
+
+        RadixSortTask( uint32 *histograms, size_t numEntries ) :
+            mSrc( 0 ),
+            mDst( 0 ),
+            mHistograms( histograms ),
+            mNumEntries( numEntries ),
+            mShift( 0u ),
+            mPhase( Histogram )
+        {
+        }
+
+        void execute( size_t threadId, size_t numThreads ) override
+        {
+            const size_t begin = ( mNumEntries * threadId ) / numThreads;
+            const size_t end = ( mNumEntries * ( threadId + 1u ) ) / numThreads;
+
+            uint32 *RESTRICT_ALIAS histogram = mHistograms + threadId * 256u;
+
+            if( mPhase == Histogram )
+            {
+                memset( histogram, 0, sizeof( uint32 ) * 256u );
+                for( size_t i = begin; i < end; ++i )
+                    ++histogram[( mSrc[i].hash >> mShift ) & 0xFFu];
+            }
+            else
+            {
+                for( size_t i = begin; i < end; ++i )
+                    mDst[histogram[( mSrc[i].hash >> mShift ) & 0xFFu]++] = mSrc[i];
+            }
+        }
+    };
+
     //---------------------------------------------------------------------
     RenderQueue::RenderQueue( HlmsManager *hlmsManager, SceneManager *sceneManager,
                               VaoManager *vaoManager ) :
@@ -98,7 +163,8 @@ namespace Ogre
         mLastIndexData( 0 ),
         mLastTextureHash( 0 ),
         mCommandBuffer( 0 ),
-        mRenderingStarted( 0u )
+        mRenderingStarted( 0u ),
+        mFrameCount( 0u )
     {
         mCommandBuffer = new CommandBuffer();
 
@@ -343,6 +409,235 @@ namespace Ogre
         }
     }
     //-----------------------------------------------------------------------
+    bool RenderQueue::insertionSort( size_t numEntries, size_t maxMoves )
+    {
+        RqSortEntry *RESTRICT_ALIAS entries = mSortEntries[0].begin();
+
+        size_t numMoves = 0u;
+        for( size_t i = 1u; i < numEntries && numMoves <= maxMoves; ++i )
+        {
+            const RqSortEntry entry = entries[i];
+            size_t j = i;
+            while( j > 0u && entry.hash < entries[j - 1u].hash )
+            {
+                entries[j] = entries[j - 1u];
+                --j;
+            }
+            entries[j] = entry;
+            numMoves += i - j;
+        }
+
+        mSortStats.insertionMoves += numMoves;
+        return numMoves <= maxMoves;
+    }
+    //-----------------------------------------------------------------------
+    size_t RenderQueue::radixSort( uint64 keyDiff )
+    {
+        const size_t numEntries = mSortEntries[0].size();
+        mSortEntries[1].resizePOD( numEntries );
+
+        const size_t numWorkerThreads = mSceneManager->getNumWorkerThreads();
+        const bool bParallel = numEntries >= c_minParallelRadixSortSize && numWorkerThreads > 1u;
+        const size_t numThreads = bParallel ? numWorkerThreads : 1u;
+
+        mRadixHistograms.resizePOD( numThreads * 256u );
+        uint32 *histograms = mRadixHistograms.begin();
+
+        RadixSortTask task( histograms, numEntries );
+
+        size_t srcIdx = 0u;
+        for( uint32 byteIdx = 0u; byteIdx < 8u; ++byteIdx )
+        {
+            // All keys have the same value in these 8 bits. The pass wouldn't change the order.
+            if( ( ( keyDiff >> ( byteIdx * 8u ) ) & 0xFFu ) == 0u )
+                continue;
+
+            task.mSrc = mSortEntries[srcIdx].begin();
+            task.mDst = mSortEntries[srcIdx ^ 1u].begin();
+            task.mShift = byteIdx * 8u;
+
+            task.mPhase = RadixSortTask::Histogram;
+            if( bParallel )
+                mSceneManager->executeUserScalableTask( &task, true );
+            else
+                task.execute( 0u, 1u );
+
+            // Turn the per-thread counts into per-thread offsets. Within a bucket
+            // thread 0's keys go first, then thread 1's, etc. to keep it stable.
+            uint32 offset = 0u;
+            for( size_t bucket = 0u; bucket < 256u; ++bucket )
+            {
+                for( size_t threadIdx = 0u; threadIdx < numThreads; ++threadIdx )
+                {
+                    uint32 &count = histograms[threadIdx * 256u + bucket];
+                    const uint32 numInBucket = count;
+                    count = offset;
+                    offset += numInBucket;
+                }
+            }
+
+            task.mPhase = RadixSortTask::Scatter;
+            if( bParallel )
+                mSceneManager->executeUserScalableTask( &task, true );
+            else
+                task.execute( 0u, 1u );
+
+            srcIdx ^= 1u;
+        }
+
+        if( bParallel )
+            ++mSortStats.parallelRadixSorts;
+        else
+            ++mSortStats.radixSorts;
+
+        return srcIdx;
+    }
+    //-----------------------------------------------------------------------
+    void RenderQueue::sortRenderQueueGroup( RenderQueueGroup &renderQueueGroup, const Camera *camera )
+    {
+        QueuedRenderableArray &queuedRenderables = renderQueueGroup.mQueuedRenderables;
+        const size_t numRenderables = queuedRenderables.size();
+        const bool bStable = renderQueueGroup.mSortMode == StableSort;
+
+        if( numRenderables < 2u )
+            return;
+
+        // Temporal coherence (as explained by L. Spiro in
+        // http://www.gamedev.net/topic/661114-temporal-coherence-and-render-queue-sorting/?view=findpost&p=5181408)
+        // Keep the sorted order of the previous frame (one per camera). If we have the sorted
+        // list "5, 1, 4, 3, 2, 0" and the group grew, we start from "5, 1, 4, 3, 2, 0, 6, 7".
+        // If it shrank, the indices that no longer exist are skipped. The insertion sort
+        // mostly has nothing to do when the camera and objects barely moved.
+        // Not used by StableSort because equal keys would keep last frame's relative order.
+        TemporalSortCache *temporalCache = 0;
+        if( !bStable && camera )
+        {
+            TemporalSortCacheArray &caches = renderQueueGroup.mTemporalSortCaches;
+            TemporalSortCacheArray::iterator itor = caches.begin();
+            TemporalSortCacheArray::iterator endt = caches.end();
+            while( itor != endt && itor->camera != camera )
+                ++itor;
+
+            if( itor == endt )
+            {
+                caches.resize( caches.size() + 1u );
+                temporalCache = &caches.back();
+                temporalCache->camera = camera;
+            }
+            else
+            {
+                temporalCache = &( *itor );
+            }
+
+            temporalCache->lastUsedFrame = mFrameCount;
+        }
+
+        RqSortEntryArray &entries = mSortEntries[0];
+        entries.resizePOD( numRenderables );
+
+        bool bSorted = false;
+        size_t resultIdx = 0u;
+
+        if( temporalCache && !temporalCache->sortedIndices.empty() )
+        {
+            size_t numOld = 0u;
+            FastArray<uint32>::const_iterator itor = temporalCache->sortedIndices.begin();
+            FastArray<uint32>::const_iterator endt = temporalCache->sortedIndices.end();
+            while( itor != endt )
+            {
+                const uint32 idx = *itor;
+                if( idx < numRenderables )
+                {
+                    entries[numOld].hash = queuedRenderables[idx].hash;
+                    entries[numOld].idx = idx;
+                    ++numOld;
+                }
+                ++itor;
+            }
+
+            for( size_t i = numOld; i < numRenderables; ++i )
+            {
+                entries[i].hash = queuedRenderables[i].hash;
+                entries[i].idx = static_cast<uint32>( i );
+            }
+
+            if( insertionSort( numOld, numOld * c_maxInsertionMovesPerEntry ) )
+            {
+                if( numOld < numRenderables )
+                {
+                    // New renderables were appended. Sort them alone, then merge both halves.
+                    std::sort( entries.begin() + numOld, entries.end() );
+                    mSortEntries[1].resizePOD( numRenderables );
+                    std::merge( entries.begin(), entries.begin() + numOld, entries.begin() + numOld,
+                                entries.end(), mSortEntries[1].begin() );
+                    resultIdx = 1u;
+                }
+                ++mSortStats.temporalSorts;
+                bSorted = true;
+            }
+            else
+            {
+                ++mSortStats.temporalFallbacks;
+            }
+        }
+        else
+        {
+            for( size_t i = 0u; i < numRenderables; ++i )
+            {
+                entries[i].hash = queuedRenderables[i].hash;
+                entries[i].idx = static_cast<uint32>( i );
+            }
+        }
+
+        if( !bSorted )
+        {
+            // Cheap check to see if it needs sorting at all, and which bytes differ
+            uint64 keyAnd = ~uint64( 0u );
+            uint64 keyOr = 0u;
+            bool bInOrder = true;
+            uint64 prevHash = 0u;
+            for( size_t i = 0u; i < numRenderables; ++i )
+            {
+                const uint64 hash = entries[i].hash;
+                bInOrder &= prevHash <= hash;
+                keyAnd &= hash;
+                keyOr |= hash;
+                prevHash = hash;
+            }
+
+            if( bInOrder )
+            {
+                ++mSortStats.alreadySorted;
+            }
+            else if( numRenderables < c_minRadixSortSize )
+            {
+                if( bStable )
+                    std::stable_sort( entries.begin(), entries.end() );
+                else
+                    std::sort( entries.begin(), entries.end() );
+                ++mSortStats.comparisonSorts;
+            }
+            else
+            {
+                resultIdx = radixSort( keyAnd ^ keyOr );
+            }
+        }
+
+        const RqSortEntryArray &sortedEntries = mSortEntries[resultIdx];
+
+        if( temporalCache )
+        {
+            temporalCache->sortedIndices.resizePOD( numRenderables );
+            for( size_t i = 0u; i < numRenderables; ++i )
+                temporalCache->sortedIndices[i] = sortedEntries[i].idx;
+        }
+
+        mSortedRenderables.resizePOD( numRenderables );
+        for( size_t i = 0u; i < numRenderables; ++i )
+            mSortedRenderables[i] = queuedRenderables[sortedEntries[i].idx];
+        queuedRenderables.swap( mSortedRenderables );
+    }
+    //-----------------------------------------------------------------------
     void RenderQueue::render( RenderSystem *rs, uint8 firstRq, uint8 lastRq, bool casterPass,
                               bool dualParaboloid )
     {
@@ -381,6 +676,46 @@ namespace Ogre
 
         numNeededDraws = numNeededV2Draws + numNeededParticleDraws;
 
+        // Sort before the parallel Hlms compile queue starts, as it keeps the worker threads
+        // busy and the radix sort of large queues wants them.
+        const Camera *camera = mSceneManager->getCamerasInProgress().renderingCamera;
+        for( size_t i = firstRq; i < lastRq; ++i )
+        {
+            if( !mRenderQueues[i].mSorted )
+            {
+                OgreProfileGroupAggregate( "Sorting", OGREPROF_RENDERING );
+
+                QueuedRenderableArray &queuedRenderables = mRenderQueues[i].mQueuedRenderables;
+                const QueuedRenderableArrayPerThread &perThreadQueue =
+                    mRenderQueues[i].mQueuedRenderablesPerThread;
+
+                size_t numRenderables = 0;
+                QueuedRenderableArrayPerThread::const_iterator itor = perThreadQueue.begin();
+                QueuedRenderableArrayPerThread::const_iterator endt = perThreadQueue.end();
+
+                while( itor != endt )
+                {
+                    numRenderables += itor->q.size();
+                    ++itor;
+                }
+
+                queuedRenderables.reserve( numRenderables );
+
+                itor = perThreadQueue.begin();
+                while( itor != endt )
+                {
+                    queuedRenderables.appendPOD( itor->q.begin(), itor->q.end() );
+                    ++itor;
+                }
+
+                if( mRenderQueues[i].mSortMode != DisableSort )
+                {
+                    sortRenderQueueGroup( mRenderQueues[i], camera );
+                    mRenderQueues[i].mSorted = true;
+                }
+            }
+        }
+
         mCommandBuffer->setCurrentRenderSystem( rs );
 
         ParallelHlmsCompileQueue *parallelCompileQueue = 0;
@@ -416,56 +751,6 @@ namespace Ogre
 
         for( size_t i = firstRq; i < lastRq; ++i )
         {
-            QueuedRenderableArray &queuedRenderables = mRenderQueues[i].mQueuedRenderables;
-            QueuedRenderableArrayPerThread &perThreadQueue =
-                mRenderQueues[i].mQueuedRenderablesPerThread;
-
-            if( !mRenderQueues[i].mSorted )
-            {
-                OgreProfileGroupAggregate( "Sorting", OGREPROF_RENDERING );
-
-                size_t numRenderables = 0;
-                QueuedRenderableArrayPerThread::const_iterator itor = perThreadQueue.begin();
-                QueuedRenderableArrayPerThread::const_iterator endt = perThreadQueue.end();
-
-                while( itor != endt )
-                {
-                    numRenderables += itor->q.size();
-                    ++itor;
-                }
-
-                queuedRenderables.reserve( numRenderables );
-
-                itor = perThreadQueue.begin();
-                while( itor != endt )
-                {
-                    queuedRenderables.appendPOD( itor->q.begin(), itor->q.end() );
-                    ++itor;
-                }
-
-                // TODO: Exploit temporal coherence across frames then use insertion sorts.
-                // As explained by L. Spiro in
-                // http://www.gamedev.net/topic/661114-temporal-coherence-and-render-queue-sorting/?view=findpost&p=5181408
-                // Keep a list of sorted indices from the previous frame (one per camera).
-                // If we have the sorted list "5, 1, 4, 3, 2, 0":
-                //  * If it grew from last frame, append: 5, 1, 4, 3, 2, 0, 6, 7 and use insertion sort.
-                //  * If it's the same, leave it as is, and use insertion sort just in case.
-                //  * If it's shorter, reset the indices 0, 1, 2, 3, 4; probably use quicksort or other
-                //  generic sort
-                //
-                // TODO2: Explore sorting first on multiple threads, then merge sort into one.
-                if( mRenderQueues[i].mSortMode == NormalSort )
-                {
-                    std::sort( queuedRenderables.begin(), queuedRenderables.end() );
-                    mRenderQueues[i].mSorted = true;
-                }
-                else if( mRenderQueues[i].mSortMode == StableSort )
-                {
-                    std::stable_sort( queuedRenderables.begin(), queuedRenderables.end() );
-                    mRenderQueues[i].mSorted = true;
-                }
-            }
-
             if( mRenderQueues[i].mMode == V1_LEGACY )
             {
                 if( mLastVaoName )
@@ -1503,6 +1788,20 @@ namespace Ogre
         mUsedIndirectBuffers.clear();
 
         mParallelHlmsCompileQueue.frameEnded();
+
+        ++mFrameCount;
+        for( size_t i = 0; i < 256; ++i )
+        {
+            TemporalSortCacheArray &caches = mRenderQueues[i].mTemporalSortCaches;
+            TemporalSortCacheArray::iterator itor = caches.begin();
+            while( itor != caches.end() )
+            {
+                if( mFrameCount - itor->lastUsedFrame > c_temporalSortCacheMaxAge )
+                    itor = efficientVectorRemove( caches, itor );
+                else
+                    ++itor;
+            }
+        }
     }
     //-----------------------------------------------------------------------
     void RenderQueue::setRenderQueueMode( uint8 rqId, Modes newMode )
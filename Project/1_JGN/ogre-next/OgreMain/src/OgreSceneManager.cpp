@@ -39,6 +39,7 @@ THE SOFTWARE.
 #include "OgreAtmosphereComponent.h"
 #include "OgreBillboardChain.h"
 #include "OgreBillboardSet.h"
+#include "OgreBitset.inl"
 #include "OgreCamera.h"
 #include "OgreControllerManager.h"
 #include "OgreDataStream.h"
@@ -170,10 +171,11 @@ namespace Ogre
         mNumWorkerThreads( std::max<size_t>( numWorkerThreads, 1u ) ),
         mForceMainThread( numWorkerThreads == 0u ? true : false ),
         mPrepareParticleFx( false ),
-        mUpdateBoundsRequest( 0 ),
         mUserTask( 0 ),
         mRequestType( NUM_REQUESTS ),
         mWorkerThreadsBarrier( 0 ),
+        mJobScheduler( 0 ),
+        mStaticCullBvhEnabled( true ),
         mSuppressRenderStateChanges( false ),
         mLastLightHash( 0 ),
         mLastLightLimit( 0 ),
@@ -214,6 +216,7 @@ namespace Ogre
         mBuildLightListRequestPerThread.resize( mNumWorkerThreads );
         mVisibleObjects.resize( mNumWorkerThreads );
         mTmpVisibleObjects.resize( mNumWorkerThreads );
+        mCullBvhVisiblePacks.resize( mNumWorkerThreads );
 
         startWorkerThreads();
 
@@ -1697,8 +1700,9 @@ namespace Ogre
             updateWorkerThreadImpl( 0 );
         else
         {
-            mWorkerThreadsBarrier->sync();  // Fire threads
-            mWorkerThreadsBarrier->sync();  // Wait them to complete
+            JobCounter counter;
+            fireWorkerThreadsPinned( counter );
+            mJobScheduler->wait( counter );
         }
     }
     //-----------------------------------------------------------------------
@@ -1709,7 +1713,7 @@ namespace Ogre
         if( mForceMainThread )
             updateWorkerThreadImpl( 0 );
         else
-            mWorkerThreadsBarrier->sync();  // Fire threads
+            fireWorkerThreadsPinned( mAsyncJobCounter );
     }
     //-----------------------------------------------------------------------
     void SceneManager::waitForParallelHlmsCompile()
@@ -1717,7 +1721,7 @@ namespace Ogre
         if( !mForceMainThread )
         {
             OGRE_ASSERT_LOW( mRequestType == PARALLEL_HLMS_COMPILE );
-            mWorkerThreadsBarrier->sync();  // Wait them to complete
+            mJobScheduler->wait( mAsyncJobCounter );
         }
     }
     //-----------------------------------------------------------------------
@@ -1729,9 +1733,10 @@ namespace Ogre
             updateWorkerThreadImpl( 0 );
         else
         {
-            mWorkerThreadsBarrier->sync();  // Fire threads.
+            JobCounter counter;
+            fireWorkerThreadsPinned( counter );
             mWorkerThreadsBarrier->sync();  // Wait them to complete stage 01.
-            mWorkerThreadsBarrier->sync();  // Wait them to complete stage 02.
+            mJobScheduler->wait( counter );  // Wait them to complete stage 02.
         }
     }
     //-----------------------------------------------------------------------
@@ -1808,6 +1813,17 @@ namespace Ogre
         node->_notifyStaticDirty();
     }
     //-----------------------------------------------------------------------
+    void SceneManager::setStaticCullBvhEnabled( bool bEnabled )
+    {
+        mStaticCullBvhEnabled = bEnabled;
+        if( !bEnabled )
+        {
+            // Free the memory. They'll get rebuilt in the next updateSceneGraph if re-enabled
+            for( size_t i = 0; i < 2u; ++i )
+                mStaticCullBvhs[i].clear();
+        }
+    }
+    //-----------------------------------------------------------------------
     void SceneManager::updateAllAnimationsThread( size_t threadIdx )
     {
         SkeletonAnimManagerVec::const_iterator it = mSkeletonAnimManagerCulledList.begin();
@@ -1914,43 +1930,31 @@ namespace Ogre
     //-----------------------------------------------------------------------
     void SceneManager::updateAllTransforms()
     {
-        mRequestType = UPDATE_ALL_TRANSFORMS;
+        mScheduledNodeLevels.clear();
+
         NodeMemoryManagerVec::const_iterator it = mNodeMemoryManagerUpdateList.begin();
         NodeMemoryManagerVec::const_iterator en = mNodeMemoryManagerUpdateList.end();
 
         while( it != en )
         {
             NodeMemoryManager *nodeMemoryManager = *it;
-            const size_t numDepths = nodeMemoryManager->getNumDepths();
-
-            size_t start = nodeMemoryManager->getMemoryManagerType() == SCENE_STATIC
-                               ? mStaticMinDepthLevelDirty
-                               : 0;
 
             // Start from the zeroth level (root) unless static (start from first dirty)
-            for( size_t i = start; i < numDepths; ++i )
-            {
-                Transform t;
-                const size_t numNodes = nodeMemoryManager->getFirstNode( t, i );
-
-                // nodesPerThread must be multiple of ARRAY_PACKED_REALS
-                size_t nodesPerThread = ( numNodes + ( mNumWorkerThreads - 1 ) ) / mNumWorkerThreads;
-                nodesPerThread = ( ( nodesPerThread + ARRAY_PACKED_REALS - 1 ) / ARRAY_PACKED_REALS ) *
-                                 ARRAY_PACKED_REALS;
-
-                if( numNodes )
-                {
-                    // Send them to worker threads. We need to go depth by depth because
-                    // we may depend on parents which could be processed by different threads.
-                    mUpdateTransformRequest = UpdateTransformRequest( t, nodesPerThread, numNodes );
-                    fireWorkerThreadsAndWait();
-                    // Node::updateAllTransforms( numNodes, t );
-                }
-            }
+            const size_t start = nodeMemoryManager->getMemoryManagerType() == SCENE_STATIC
+                                     ? mStaticMinDepthLevelDirty
+                                     : 0;
+            gatherNodeLevels( nodeMemoryManager, start, UPDATE_ALL_TRANSFORMS, UPDATE_ALL_TRANSFORMS );
 
             ++it;
         }
 
+        // We need to go depth by depth because we may depend on parents which could be processed
+        // by different threads. But that's expressed as dependencies between the levels' batches,
+        // so the worker threads move on to the next level without waiting for us.
+        JobCounter counter;
+        submitNodeLevels( counter );
+        mJobScheduler->wait( counter );
+
         // Call all listeners
         SceneNodeList::const_iterator itor = mSceneNodesWithListeners.begin();
         SceneNodeList::const_iterator endt = mSceneNodesWithListeners.end();
@@ -1964,38 +1968,111 @@ namespace Ogre
     //-----------------------------------------------------------------------
     void SceneManager::updateAllTagPoints()
     {
+        mScheduledNodeLevels.clear();
+
         NodeMemoryManagerVec::const_iterator it = mTagPointNodeMemoryManagerUpdateList.begin();
         NodeMemoryManagerVec::const_iterator en = mTagPointNodeMemoryManagerUpdateList.end();
 
         while( it != en )
         {
-            NodeMemoryManager *nodeMemoryManager = *it;
-            const size_t numDepths = nodeMemoryManager->getNumDepths();
+            // Level 0 are children of bones, the rest are children of other TagPoints
+            gatherNodeLevels( *it, 0, UPDATE_ALL_BONE_TO_TAG_TRANSFORMS,
+                              UPDATE_ALL_TAG_ON_TAG_TRANSFORMS );
+            ++it;
+        }
 
-            // Start from the first level (not root) unless static (start from first dirty)
-            for( size_t i = 0; i < numDepths; ++i )
+        JobCounter counter;
+        submitNodeLevels( counter );
+        mJobScheduler->wait( counter );
+    }
+    //-----------------------------------------------------------------------
+    size_t SceneManager::calculateElementsPerJob( size_t numElements, size_t minPerJob ) const
+    {
+        // A few jobs per thread, so threads that finish early have something to steal
+        const size_t numJobs = mJobScheduler->getNumThreads() * 4u;
+        size_t elementsPerJob = std::max( ( numElements + numJobs - 1u ) / numJobs, minPerJob );
+        elementsPerJob =
+            ( ( elementsPerJob + ARRAY_PACKED_REALS - 1 ) / ARRAY_PACKED_REALS ) * ARRAY_PACKED_REALS;
+        return elementsPerJob;
+    }
+    //-----------------------------------------------------------------------
+    void SceneManager::gatherNodeLevels( NodeMemoryManager *nodeMemoryManager, size_t firstDepth,
+                                         RequestType requestType, RequestType nextRequestType )
+    {
+        // Updating a node is cheap; don't make jobs so small that the
+        // scheduling overhead dominates.
+        const size_t c_minNodesPerJob = 256u;
+
+        bool startsChain = true;
+        const size_t numDepths = nodeMemoryManager->getNumDepths();
+        for( size_t i = firstDepth; i < numDepths; ++i )
+        {
+            Transform t;
+            const size_t numNodes = nodeMemoryManager->getFirstNode( t, i );
+
+            if( numNodes )
             {
-                mRequestType =
-                    i == 0 ? UPDATE_ALL_BONE_TO_TAG_TRANSFORMS : UPDATE_ALL_TAG_ON_TAG_TRANSFORMS;
+                ScheduledNodeLevel level;
+                level.sceneManager = this;
+                level.requestType = i == 0 ? requestType : nextRequestType;
+                level.request = UpdateTransformRequest(
+                    t, calculateElementsPerJob( numNodes, c_minNodesPerJob ), numNodes );
+                level.startsChain = startsChain;
+                mScheduledNodeLevels.push_back( level );
+                startsChain = false;
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
+    void SceneManager::submitNodeLevels( JobCounter &counter )
+    {
+        // Each batch is submitted only after its successor was attached to it
+        WorkStealingScheduler::JobBatch *prevBatch = 0;
 
-                Transform t;
-                const size_t numNodes = nodeMemoryManager->getFirstNode( t, i );
+        ScheduledNodeLevelVec::iterator itor = mScheduledNodeLevels.begin();
+        ScheduledNodeLevelVec::iterator endt = mScheduledNodeLevels.end();
 
-                // nodesPerThread must be multiple of ARRAY_PACKED_REALS
-                size_t nodesPerThread = ( numNodes + ( mNumWorkerThreads - 1 ) ) / mNumWorkerThreads;
-                nodesPerThread = ( ( nodesPerThread + ARRAY_PACKED_REALS - 1 ) / ARRAY_PACKED_REALS ) *
-                                 ARRAY_PACKED_REALS;
+        while( itor != endt )
+        {
+            const UpdateTransformRequest &request = itor->request;
+            const size_t numJobs =
+                ( request.numTotalNodes + request.numNodesPerThread - 1u ) / request.numNodesPerThread;
 
-                if( numNodes )
-                {
-                    // Send them to worker threads. We need to go depth by depth because
-                    // we may depend on parents which could be processed by different threads.
-                    mUpdateTransformRequest = UpdateTransformRequest( t, nodesPerThread, numNodes );
-                    fireWorkerThreadsAndWait();
-                }
+            WorkStealingScheduler::JobBatch *batch =
+                mJobScheduler->createBatch( updateNodeLevelJob, &( *itor ), numJobs, counter );
+            if( prevBatch )
+            {
+                if( !itor->startsChain )
+                    mJobScheduler->addDependency( batch, prevBatch );
+                mJobScheduler->submit( prevBatch );
             }
+            prevBatch = batch;
+            ++itor;
+        }
 
-            ++it;
+        if( prevBatch )
+            mJobScheduler->submit( prevBatch );
+    }
+    //-----------------------------------------------------------------------
+    void SceneManager::updateNodeLevelJob( void *userData, size_t jobIdx, size_t threadIdx )
+    {
+        const ScheduledNodeLevel &level = *reinterpret_cast<const ScheduledNodeLevel *>( userData );
+        SceneManager *sceneManager = level.sceneManager;
+
+        switch( level.requestType )
+        {
+        case UPDATE_ALL_TRANSFORMS:
+            sceneManager->updateAllTransformsThread( level.request, jobIdx );
+            break;
+        case UPDATE_ALL_BONE_TO_TAG_TRANSFORMS:
+            sceneManager->updateAllTransformsBoneToTagThread( level.request, jobIdx );
+            break;
+        case UPDATE_ALL_TAG_ON_TAG_TRANSFORMS:
+            sceneManager->updateAllTransformsTagOnTagThread( level.request, jobIdx );
+            break;
+        default:
+            OGRE_ASSERT_LOW( false && "Not a node request" );
+            break;
         }
     }
     //-----------------------------------------------------------------------
@@ -2029,9 +2106,17 @@ namespace Ogre
         TagPoint::updateAllTransformsTagOnTag( numNodes, t );
     }
     //-----------------------------------------------------------------------
-    void SceneManager::updateAllBoundsThread( const ObjectMemoryManagerVec &objectMemManager,
-                                              size_t threadIdx )
+    void SceneManager::gatherObjectRanges( RequestType requestType,
+                                           const ObjectMemoryManagerVec &objectMemManager,
+                                           size_t firstRq, size_t lastRq )
     {
+        const size_t c_minObjsPerJob = 128u;
+
+        ScheduledObjectRanges scheduled;
+        scheduled.sceneManager = this;
+        scheduled.requestType = requestType;
+        scheduled.firstRange = mObjectRanges.size();
+
         ObjectMemoryManagerVec::const_iterator it = objectMemManager.begin();
         ObjectMemoryManagerVec::const_iterator en = objectMemManager.end();
 
@@ -2040,90 +2125,103 @@ namespace Ogre
             ObjectMemoryManager *memoryManager = *it;
             const size_t numRenderQueues = memoryManager->getNumRenderQueues();
 
-            for( size_t i = 0; i < numRenderQueues; ++i )
-            {
-                ObjectData objData;
-                const size_t totalObjs = memoryManager->getFirstObjectData( objData, i );
+            const size_t realLastRq = std::min( lastRq, numRenderQueues );
 
-                // Distribute the work evenly across all threads (not perfect), taking into
-                // account we need to distribute in multiples of ARRAY_PACKED_REALS
-                size_t numObjs = ( totalObjs + ( mNumWorkerThreads - 1 ) ) / mNumWorkerThreads;
-                numObjs =
-                    ( ( numObjs + ARRAY_PACKED_REALS - 1 ) / ARRAY_PACKED_REALS ) * ARRAY_PACKED_REALS;
+            for( size_t i = firstRq; i < realLastRq; ++i )
+            {
+                ObjectRange range;
+                const size_t totalObjs = memoryManager->getFirstObjectData( range.objData, i );
 
-                const size_t toAdvance = std::min( threadIdx * numObjs, totalObjs );
+                // Distribute the work in multiples of ARRAY_PACKED_REALS
+                const size_t objsPerJob = calculateElementsPerJob( totalObjs, c_minObjsPerJob );
 
-                // Prevent going out of bounds (usually in the last threadIdx, or
-                // when there are less entities than ARRAY_PACKED_REALS
-                numObjs = std::min( numObjs, totalObjs - toAdvance );
-                objData.advancePack( toAdvance / ARRAY_PACKED_REALS );
-
-                MovableObject::updateAllBounds( numObjs, objData );
+                for( size_t toAdvance = 0; toAdvance < totalObjs; toAdvance += objsPerJob )
+                {
+                    if( toAdvance )
+                        range.objData.advancePack( objsPerJob / ARRAY_PACKED_REALS );
+                    range.numObjs = std::min( objsPerJob, totalObjs - toAdvance );
+                    mObjectRanges.push_back( range );
+                }
             }
 
             ++it;
         }
+
+        scheduled.numRanges = mObjectRanges.size() - scheduled.firstRange;
+        mScheduledObjectRanges.push_back( scheduled );
     }
     //-----------------------------------------------------------------------
-    void SceneManager::updateAllBounds( const ObjectMemoryManagerVec &objectMemManager )
+    void SceneManager::submitObjectRanges( JobCounter &counter )
     {
-        mUpdateBoundsRequest = &objectMemManager;
-        mRequestType = UPDATE_ALL_BOUNDS;
-        fireWorkerThreadsAndWait();
+        ScheduledObjectRangesVec::iterator itor = mScheduledObjectRanges.begin();
+        ScheduledObjectRangesVec::iterator endt = mScheduledObjectRanges.end();
+
+        while( itor != endt )
+        {
+            mJobScheduler->submit( mJobScheduler->createBatch( updateObjectRangeJob, &( *itor ),
+                                                               itor->numRanges, counter ) );
+            ++itor;
+        }
     }
     //-----------------------------------------------------------------------
-    void SceneManager::updateAllLodsThread( const UpdateLodRequest &request, size_t threadIdx )
+    void SceneManager::updateObjectRangeJob( void *userData, size_t jobIdx, size_t threadIdx )
     {
-        LodStrategy *lodStrategy = LodStrategyManager::getSingleton().getDefaultStrategy();
-
-        const Camera *lodCamera = request.lodCamera;
-        ObjectMemoryManagerVec::const_iterator it = request.objectMemManager->begin();
-        ObjectMemoryManagerVec::const_iterator en = request.objectMemManager->end();
+        const ScheduledObjectRanges &scheduled =
+            *reinterpret_cast<const ScheduledObjectRanges *>( userData );
+        SceneManager *sceneManager = scheduled.sceneManager;
+        const ObjectRange &range = sceneManager->mObjectRanges[scheduled.firstRange + jobIdx];
 
-        while( it != en )
+        switch( scheduled.requestType )
         {
-            ObjectMemoryManager *memoryManager = *it;
-            const size_t numRenderQueues = memoryManager->getNumRenderQueues();
-
-            size_t firstRq = std::min<size_t>( request.firstRq, numRenderQueues );
-            size_t lastRq = std::min<size_t>( request.lastRq, numRenderQueues );
-
-            for( size_t i = firstRq; i < lastRq; ++i )
-            {
-                ObjectData objData;
-                const size_t totalObjs = memoryManager->getFirstObjectData( objData, i );
-
-                // Distribute the work evenly across all threads (not perfect), taking into
-                // account we need to distribute in multiples of ARRAY_PACKED_REALS
-                size_t numObjs = ( totalObjs + ( mNumWorkerThreads - 1 ) ) / mNumWorkerThreads;
-                numObjs =
-                    ( ( numObjs + ARRAY_PACKED_REALS - 1 ) / ARRAY_PACKED_REALS ) * ARRAY_PACKED_REALS;
-
-                const size_t toAdvance = std::min( threadIdx * numObjs, totalObjs );
-
-                // Prevent going out of bounds (usually in the last threadIdx, or
-                // when there are less entities than ARRAY_PACKED_REALS
-                numObjs = std::min( numObjs, totalObjs - toAdvance );
-                objData.advancePack( toAdvance / ARRAY_PACKED_REALS );
-
-                lodStrategy->lodUpdateImpl( numObjs, objData, lodCamera, request.lodBias );
-            }
-
-            ++it;
+        case UPDATE_ALL_BOUNDS:
+            MovableObject::updateAllBounds( range.numObjs, range.objData );
+            break;
+        case UPDATE_ALL_LODS:
+        {
+            const UpdateLodRequest &request = sceneManager->mUpdateLodRequest;
+            LodStrategy *lodStrategy = LodStrategyManager::getSingleton().getDefaultStrategy();
+            lodStrategy->lodUpdateImpl( range.numObjs, range.objData, request.lodCamera,
+                                        request.lodBias );
+            break;
+        }
+        case BUILD_LIGHT_LIST02:
+            MovableObject::buildLightList( range.numObjs, range.objData,
+                                           sceneManager->mGlobalLightList );
+            break;
+        default:
+            OGRE_ASSERT_LOW( false && "Not an object range request" );
+            break;
         }
     }
     //-----------------------------------------------------------------------
+    void SceneManager::updateAllBounds( const ObjectMemoryManagerVec &objectMemManager )
+    {
+        mObjectRanges.clear();
+        mScheduledObjectRanges.clear();
+        gatherObjectRanges( UPDATE_ALL_BOUNDS, objectMemManager, 0,
+                            std::numeric_limits<size_t>::max() );
+
+        JobCounter counter;
+        submitObjectRanges( counter );
+        mJobScheduler->wait( counter );
+    }
+    //-----------------------------------------------------------------------
     void SceneManager::updateAllLods( const Camera *lodCamera, Real lodBias, uint8 firstRq,
                                       uint8 lastRq )
     {
-        mRequestType = UPDATE_ALL_LODS;
         mUpdateLodRequest = UpdateLodRequest( firstRq, lastRq, &mEntitiesMemoryManagerCulledList,
                                               lodCamera, lodCamera, lodBias );
 
         mUpdateLodRequest.camera->getFrustumPlanes();
         mUpdateLodRequest.lodCamera->getFrustumPlanes();
 
-        fireWorkerThreadsAndWait();
+        mObjectRanges.clear();
+        mScheduledObjectRanges.clear();
+        gatherObjectRanges( UPDATE_ALL_LODS, mEntitiesMemoryManagerCulledList, firstRq, lastRq );
+
+        JobCounter counter;
+        submitObjectRanges( counter );
+        mJobScheduler->wait( counter );
     }
     //-----------------------------------------------------------------------
     void SceneManager::cullFrustum( const CullFrustumRequest &request, size_t threadIdx )
@@ -2165,6 +2263,9 @@ namespace Ogre
             size_t firstRq = std::min<size_t>( request.firstRq, numRenderQueues );
             size_t lastRq = std::min<size_t>( request.lastRq, numRenderQueues );
 
+            const CullBvhVec *staticCullBvhs = getStaticCullBvhs( memoryManager );
+            const size_t layoutVersion = memoryManager->getLayoutVersion();
+
             for( size_t i = firstRq; i < lastRq; ++i )
             {
                 MovableObject::MovableObjectArray &outVisibleObjects =
@@ -2179,21 +2280,23 @@ namespace Ogre
                 // Too much (255 queues, most of them empty, multiples scene passes...)
                 if( totalObjs > 0u )
                 {
-                    // Distribute the work evenly across all threads (not perfect), taking into
-                    // account we need to distribute in multiples of ARRAY_PACKED_REALS
-                    size_t numObjs = ( totalObjs + ( mNumWorkerThreads - 1 ) ) / mNumWorkerThreads;
-                    numObjs = ( ( numObjs + ARRAY_PACKED_REALS - 1 ) / ARRAY_PACKED_REALS ) *
-                              ARRAY_PACKED_REALS;
-
-                    const size_t toAdvance = std::min( threadIdx * numObjs, totalObjs );
-
-                    // Prevent going out of bounds (usually in the last threadIdx, or
-                    // when there are less entities than ARRAY_PACKED_REALS
-                    numObjs = std::min( numObjs, totalObjs - toAdvance );
+                    size_t numObjs;
+                    const size_t toAdvance =
+                        calculateCullFrustumPartition( totalObjs, threadIdx, numObjs );
                     objData.advancePack( toAdvance / ARRAY_PACKED_REALS );
 
-                    MovableObject::cullFrustum( numObjs, objData, camera, outVisibleObjects,
-                                                preparedData );
+                    const size_t bvhIdx = i * mNumWorkerThreads + threadIdx;
+                    if( staticCullBvhs && bvhIdx < staticCullBvhs->size() &&
+                        ( *staticCullBvhs )[bvhIdx].isBuiltFor( numObjs, layoutVersion ) )
+                    {
+                        cullFrustumBvh( ( *staticCullBvhs )[bvhIdx], numObjs, objData, camera,
+                                        outVisibleObjects, preparedData, threadIdx );
+                    }
+                    else
+                    {
+                        MovableObject::cullFrustum( numObjs, objData, camera, outVisibleObjects,
+                                                    preparedData );
+                    }
 
                     if( mRenderQueue->getRenderQueueMode( currRqId ) == RenderQueue::FAST &&
                         request.addToRenderQueue )
@@ -2238,6 +2341,140 @@ namespace Ogre
         }
     }
     //-----------------------------------------------------------------------
+    size_t SceneManager::calculateCullFrustumPartition( size_t totalObjs, size_t threadIdx,
+                                                        size_t &outNumObjs ) const
+    {
+        // Distribute the work evenly across all threads (not perfect), taking into
+        // account we need to distribute in multiples of ARRAY_PACKED_REALS
+        size_t numObjs = ( totalObjs + ( mNumWorkerThreads - 1 ) ) / mNumWorkerThreads;
+        numObjs = ( ( numObjs + ARRAY_PACKED_REALS - 1 ) / ARRAY_PACKED_REALS ) * ARRAY_PACKED_REALS;
+
+        const size_t toAdvance = std::min( threadIdx * numObjs, totalObjs );
+
+        // Prevent going out of bounds (usually in the last threadIdx, or
+        // when there are less entities than ARRAY_PACKED_REALS
+        outNumObjs = std::min( numObjs, totalObjs - toAdvance );
+        return toAdvance;
+    }
+    //-----------------------------------------------------------------------
+    const SceneManager::CullBvhVec *SceneManager::getStaticCullBvhs(
+        const ObjectMemoryManager *memoryManager ) const
+    {
+        if( memoryManager == &mEntityMemoryManager[SCENE_STATIC] )
+            return &mStaticCullBvhs[0];
+        if( memoryManager == &mForwardPlusMemoryManager[SCENE_STATIC] )
+            return &mStaticCullBvhs[1];
+        return 0;
+    }
+    //-----------------------------------------------------------------------
+    void SceneManager::updateStaticCullBvhs()
+    {
+        OgreProfile( "Static Cull BVH" );
+
+        // Below this the flat path is already fast and the BVH won't skip much
+        const size_t c_minObjsPerCullBvh = 256u;
+
+        const bool staticDirty =
+            mStaticEntitiesDirty ||
+            mStaticMinDepthLevelDirty < mNodeMemoryManager[SCENE_STATIC].getNumDepths();
+
+        ObjectMemoryManager *memoryManagers[2] = { &mEntityMemoryManager[SCENE_STATIC],
+                                                   &mForwardPlusMemoryManager[SCENE_STATIC] };
+
+        mScheduledCullBvhBuilds.clear();
+
+        for( size_t i = 0; i < 2u; ++i )
+        {
+            ObjectMemoryManager *memoryManager = memoryManagers[i];
+            CullBvhVec &cullBvhs = mStaticCullBvhs[i];
+
+            const size_t numRenderQueues = memoryManager->getNumRenderQueues();
+            const size_t layoutVersion = memoryManager->getLayoutVersion();
+
+            if( cullBvhs.size() != numRenderQueues * mNumWorkerThreads )
+            {
+                cullBvhs.clear();
+                cullBvhs.resize( numRenderQueues * mNumWorkerThreads );
+            }
+
+            for( size_t rq = 0; rq < numRenderQueues; ++rq )
+            {
+                ObjectData objData;
+                const size_t totalObjs = memoryManager->getFirstObjectData( objData, rq );
+
+                for( size_t threadIdx = 0; threadIdx < mNumWorkerThreads; ++threadIdx )
+                {
+                    CullBvh &cullBvh = cullBvhs[rq * mNumWorkerThreads + threadIdx];
+
+                    size_t numObjs;
+                    const size_t toAdvance =
+                        calculateCullFrustumPartition( totalObjs, threadIdx, numObjs );
+
+                    if( numObjs < c_minObjsPerCullBvh )
+                    {
+                        cullBvh.clear();
+                    }
+                    else if( staticDirty || !cullBvh.isBuiltFor( numObjs, layoutVersion ) )
+                    {
+                        ScheduledCullBvhBuild build;
+                        build.bvh = &cullBvh;
+                        build.worldAabb = objData.mWorldAabb + toAdvance / ARRAY_PACKED_REALS;
+                        build.numObjs = numObjs;
+                        build.layoutVersion = layoutVersion;
+                        mScheduledCullBvhBuilds.push_back( build );
+                    }
+                }
+            }
+        }
+
+        if( !mScheduledCullBvhBuilds.empty() )
+        {
+            JobCounter counter;
+            mJobScheduler->submit( mJobScheduler->createBatch(
+                buildCullBvhJob, this, mScheduledCullBvhBuilds.size(), counter ) );
+            mJobScheduler->wait( counter );
+        }
+    }
+    //-----------------------------------------------------------------------
+    void SceneManager::buildCullBvhJob( void *userData, size_t jobIdx, size_t threadIdx )
+    {
+        SceneManager *sceneManager = reinterpret_cast<SceneManager *>( userData );
+        const ScheduledCullBvhBuild &build = sceneManager->mScheduledCullBvhBuilds[jobIdx];
+        build.bvh->build( build.worldAabb, build.numObjs, build.layoutVersion );
+    }
+    //-----------------------------------------------------------------------
+    void SceneManager::cullFrustumBvh( const CullBvh &bvh, size_t numObjs, ObjectData objData,
+                                       const Camera *camera,
+                                       MovableObject::MovableObjectArray &outVisibleObjects,
+                                       const CullFrustumPreparedData &preparedData, size_t threadIdx )
+    {
+        const size_t numPacks = ( numObjs + ARRAY_PACKED_REALS - 1u ) / ARRAY_PACKED_REALS;
+
+        bitset64 &visiblePacks = mCullBvhVisiblePacks[threadIdx];
+        visiblePacks.reset( numPacks );
+        bvh.cull( preparedData.planes, visiblePacks );
+
+        // Cull each run of consecutive packs in one go, in order. This way objects
+        // get appended to outVisibleObjects in the same order as the flat path.
+        size_t currentPack = 0u;
+        size_t pack = visiblePacks.findFirstBitSet( 0u );
+        while( pack < numPacks )
+        {
+            size_t runEnd = pack + 1u;
+            while( runEnd < numPacks && visiblePacks.test( runEnd ) )
+                ++runEnd;
+
+            objData.advancePack( pack - currentPack );
+            currentPack = pack;
+
+            const size_t firstObj = pack * ARRAY_PACKED_REALS;
+            const size_t runObjs = std::min( runEnd * ARRAY_PACKED_REALS, numObjs ) - firstObj;
+            MovableObject::cullFrustum( runObjs, objData, camera, outVisibleObjects, preparedData );
+
+            pack = runEnd < numPacks ? visiblePacks.findFirstBitSet( runEnd ) : numPacks;
+        }
+    }
+    //-----------------------------------------------------------------------
     inline bool OrderLightByShadowCastThenId( const Light *_l, const Light *_r )
     {
         if( _l->getCastShadows() && !_r->getCastShadows() )
@@ -2416,13 +2653,7 @@ namespace Ogre
             }
         }
 
-        if( mForceMainThread )
-            updateWorkerThreadImpl( 0 );
-        else
-        {
-            mWorkerThreadsBarrier->sync();  // Fire threads
-            mWorkerThreadsBarrier->sync();  // Wait them to complete
-        }
+        fireWorkerThreadsAndWait();
 
         // Now merge the results into a single list.
 
@@ -2453,14 +2684,14 @@ namespace Ogre
         if( mBuildLegacyLightList )
         {
             // Now fire the threads again, to build the per-MovableObject lists
-            mRequestType = BUILD_LIGHT_LIST02;
-            if( mForceMainThread )
-                updateWorkerThreadImpl( 0 );
-            else
-            {
-                mWorkerThreadsBarrier->sync();  // Fire threads
-                mWorkerThreadsBarrier->sync();  // Wait them to complete
-            }
+            mObjectRanges.clear();
+            mScheduledObjectRanges.clear();
+            gatherObjectRanges( BUILD_LIGHT_LIST02, mEntitiesMemoryManagerCulledList, 0,
+                                std::numeric_limits<size_t>::max() );
+
+            JobCounter counter;
+            submitObjectRanges( counter );
+            mJobScheduler->wait( counter );
         }
     }
     //-----------------------------------------------------------------------
@@ -2517,41 +2748,6 @@ namespace Ogre
         threadLocalLightList.boundingSphere = 0;
     }
     //-----------------------------------------------------------------------
-    void SceneManager::buildLightListThread02( size_t threadIdx )
-    {
-        // Global light list built. Now build a per-movable object light list
-        ObjectMemoryManagerVec::const_iterator it = mEntitiesMemoryManagerCulledList.begin();
-        ObjectMemoryManagerVec::const_iterator en = mEntitiesMemoryManagerCulledList.end();
-        while( it != en )
-        {
-            ObjectMemoryManager *objMemoryManager = *it;
-            const size_t numRenderQueues = objMemoryManager->getNumRenderQueues();
-
-            for( size_t i = 0; i < numRenderQueues; ++i )
-            {
-                ObjectData objData;
-                const size_t totalObjs = objMemoryManager->getFirstObjectData( objData, i );
-
-                // Distribute the work evenly across all threads (not perfect), taking into
-                // account we need to distribute in multiples of ARRAY_PACKED_REALS
-                size_t numObjs = ( totalObjs + ( mNumWorkerThreads - 1 ) ) / mNumWorkerThreads;
-                numObjs =
-                    ( ( numObjs + ARRAY_PACKED_REALS - 1 ) / ARRAY_PACKED_REALS ) * ARRAY_PACKED_REALS;
-
-                const size_t toAdvance = std::min( threadIdx * numObjs, totalObjs );
-
-                // Prevent going out of bounds (usually in the last threadIdx, or
-                // when there are less entities than ARRAY_PACKED_REALS
-                numObjs = std::min( numObjs, totalObjs - toAdvance );
-                objData.advancePack( toAdvance / ARRAY_PACKED_REALS );
-
-                MovableObject::buildLightList( numObjs, objData, mGlobalLightList );
-            }
-
-            ++it;
-        }
-    }
-    //-----------------------------------------------------------------------
     void SceneManager::warmUpShaders( const CullFrustumRequest &request, size_t threadIdx )
     {
         VisibleObjectsPerRq &visibleObjectsPerRq = *( mVisibleObjects.begin() + threadIdx );
@@ -2730,8 +2926,23 @@ namespace Ogre
         updateAllTransforms();
         updateAllAnimations();
         updateAllTagPoints();
-        updateAllBounds( mEntitiesMemoryManagerUpdateList );
-        updateAllBounds( mLightsMemoryManagerCulledList );
+
+        {
+            // Entities & lights don't depend on each other; update both in one go
+            mObjectRanges.clear();
+            mScheduledObjectRanges.clear();
+            gatherObjectRanges( UPDATE_ALL_BOUNDS, mEntitiesMemoryManagerUpdateList, 0,
+                                std::numeric_limits<size_t>::max() );
+            gatherObjectRanges( UPDATE_ALL_BOUNDS, mLightsMemoryManagerCulledList, 0,
+                                std::numeric_limits<size_t>::max() );
+
+            JobCounter counter;
+            submitObjectRanges( counter );
+            mJobScheduler->wait( counter );
+        }
+
+        if( mStaticCullBvhEnabled )
+            updateStaticCullBvhs();
 
         mPrepareParticleFx = false;
 
@@ -4637,11 +4848,23 @@ namespace Ogre
             updateWorkerThreadImpl( 0 );
         else
         {
-            mWorkerThreadsBarrier->sync();  // Fire threads
-            mWorkerThreadsBarrier->sync();  // Wait them to complete
+            JobCounter counter;
+            mJobScheduler->submit(
+                mJobScheduler->createBatch( updateWorkerThreadJob, this, mNumWorkerThreads, counter ) );
+            mJobScheduler->wait( counter );
         }
     }
     //---------------------------------------------------------------------
+    void SceneManager::fireWorkerThreadsPinned( JobCounter &counter )
+    {
+        mJobScheduler->broadcast( updateWorkerThreadJob, this, counter );
+    }
+    //---------------------------------------------------------------------
+    void SceneManager::updateWorkerThreadJob( void *userData, size_t jobIdx, size_t threadIdx )
+    {
+        reinterpret_cast<SceneManager *>( userData )->updateWorkerThreadImpl( jobIdx );
+    }
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     void SceneManager::fireCullFrustumThreads( const CullFrustumRequest &request )
     {
@@ -4664,9 +4887,10 @@ namespace Ogre
             updateWorkerThreadImpl( 0 );
         else
         {
-            mWorkerThreadsBarrier->sync();  // Fire threads
+            mJobScheduler->submit( mJobScheduler->createBatch( updateWorkerThreadJob, this,
+                                                               mNumWorkerThreads, mAsyncJobCounter ) );
             if( bBlock )
-                mWorkerThreadsBarrier->sync();  // Wait them to complete
+                mJobScheduler->wait( mAsyncJobCounter );
         }
     }
     //---------------------------------------------------------------------
@@ -4675,7 +4899,7 @@ namespace Ogre
         if( !mForceMainThread )
         {
             assert( mRequestType == USER_UNIFORM_SCALABLE_TASK );
-            mWorkerThreadsBarrier->sync();  // Wait them to complete
+            mJobScheduler->wait( mAsyncJobCounter );
         }
     }
     //---------------------------------------------------------------------
@@ -4691,6 +4915,8 @@ namespace Ogre
     //---------------------------------------------------------------------
     void SceneManager::startWorkerThreads()
     {
+        mJobScheduler = new WorkStealingScheduler( mForceMainThread ? 0u : mNumWorkerThreads );
+
         if( !mForceMainThread )
         {
             mWorkerThreadsBarrier = new Barrier( mNumWorkerThreads + 1 );
@@ -4707,34 +4933,26 @@ namespace Ogre
     {
         if( !mForceMainThread )
         {
-            mRequestType = STOP_THREADS;
-            fireWorkerThreadsAndWait();
+            mJobScheduler->stop();
 
             Threads::WaitForThreads( mWorkerThreads );
 
             delete mWorkerThreadsBarrier;
             mWorkerThreadsBarrier = 0;
         }
+
+        delete mJobScheduler;
+        mJobScheduler = 0;
     }
     //---------------------------------------------------------------------
     unsigned long SceneManager::_updateWorkerThread( ThreadHandle *threadHandle )
     {
-        bool exitThread = false;
-        size_t threadIdx = threadHandle->getThreadIdx();
-        while( !exitThread )
-        {
-            mWorkerThreadsBarrier->sync();
-            exitThread = updateWorkerThreadImpl( threadIdx );
-            mWorkerThreadsBarrier->sync();
-        }
-
+        mJobScheduler->_workerThreadLoop( threadHandle->getThreadIdx() );
         return 0;
     }
     //---------------------------------------------------------------------
-    inline bool SceneManager::updateWorkerThreadImpl( size_t threadIdx )
+    inline void SceneManager::updateWorkerThreadImpl( size_t threadIdx )
     {
-        bool exitThread = false;
-
         switch( mRequestType )
         {
         case CULL_FRUSTUM:
@@ -4745,27 +4963,9 @@ namespace Ogre
             if( mPrepareParticleFx )
                 mParticleSystemManager2->_prepareParallel();
             break;
-        case UPDATE_ALL_TRANSFORMS:
-            updateAllTransformsThread( mUpdateTransformRequest, threadIdx );
-            break;
-        case UPDATE_ALL_BONE_TO_TAG_TRANSFORMS:
-            updateAllTransformsBoneToTagThread( mUpdateTransformRequest, threadIdx );
-            break;
-        case UPDATE_ALL_TAG_ON_TAG_TRANSFORMS:
-            updateAllTransformsTagOnTagThread( mUpdateTransformRequest, threadIdx );
-            break;
-        case UPDATE_ALL_BOUNDS:
-            updateAllBoundsThread( *mUpdateBoundsRequest, threadIdx );
-            break;
-        case UPDATE_ALL_LODS:
-            updateAllLodsThread( mUpdateLodRequest, threadIdx );
-            break;
         case BUILD_LIGHT_LIST01:
             buildLightListThread01( mBuildLightListRequestPerThread[threadIdx], threadIdx );
             break;
-        case BUILD_LIGHT_LIST02:
-            buildLightListThread02( threadIdx );
-            break;
         case WARM_UP_SHADERS:
             warmUpShaders( mCurrentCullFrustumRequest, threadIdx );
             break;
@@ -4784,14 +4984,9 @@ namespace Ogre
         case USER_UNIFORM_SCALABLE_TASK:
             mUserTask->execute( threadIdx, mNumWorkerThreads );
             break;
-        case STOP_THREADS:
-            exitThread = true;
-            break;
         default:
             break;
         }
-
-        return exitThread;
     }
     SceneManagerFactory::~SceneManagerFactory() {}
 }  // namespace Ogre
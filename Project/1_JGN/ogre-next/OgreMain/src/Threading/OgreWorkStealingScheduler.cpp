@@ -0,0 +1,333 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE-Next
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "OgreStableHeaders.h"
+
+#include "Threading/OgreWorkStealingScheduler.h"
+
+namespace Ogre
+{
+    /// Iterations an idle thread keeps polling before going to sleep. Jobs of the next depth
+    /// level usually show up within a few microseconds, so sleeping right away only adds latency.
+    static const size_t c_numSpinIterations = 256u;
+
+    WorkStealingScheduler::WorkStealingScheduler( size_t numWorkerThreads ) :
+        mNumWorkerThreads( numWorkerThreads ),
+        mQueuedJobs( 0u ),
+        mStop( false ),
+        mNumUsedBatches( 0u ),
+        mLiveBatches( 0u ),
+        mMainThreadSleeping( false )
+    {
+        for( size_t i = 0u; i < numWorkerThreads + 1u; ++i )
+            mQueues.emplace_back();
+    }
+    //-----------------------------------------------------------------------------------
+    WorkStealingScheduler::~WorkStealingScheduler()
+    {
+        OGRE_ASSERT_LOW( mLiveBatches.load() == 0u && "Destroying scheduler with jobs in flight" );
+    }
+    //-----------------------------------------------------------------------------------
+    WorkStealingScheduler::JobBatch *WorkStealingScheduler::createBatch( JobFunc func, void *userData,
+                                                                         size_t numJobs,
+                                                                         JobCounter &counter )
+    {
+        if( mNumUsedBatches == mBatchPool.size() )
+            mBatchPool.emplace_back();
+
+        JobBatch *batch = &mBatchPool[mNumUsedBatches++];
+        batch->func = func;
+        batch->userData = userData;
+        batch->numJobs = numJobs;
+        batch->remainingJobs.store( numJobs, std::memory_order_relaxed );
+        batch->unmetDependencies.store( 1u, std::memory_order_relaxed );
+        batch->counter = &counter;
+        batch->successors.clear();
+
+        counter.pendingBatches.fetch_add( 1u, std::memory_order_relaxed );
+        mLiveBatches.fetch_add( 1u, std::memory_order_relaxed );
+
+        return batch;
+    }
+    //-----------------------------------------------------------------------------------
+    void WorkStealingScheduler::addDependency( JobBatch *batch, JobBatch *dependsOn )
+    {
+        OGRE_ASSERT_LOW( dependsOn->unmetDependencies.load( std::memory_order_relaxed ) > 0u &&
+                         "dependsOn was already submitted" );
+        batch->unmetDependencies.fetch_add( 1u, std::memory_order_relaxed );
+        dependsOn->successors.push_back( batch );
+    }
+    //-----------------------------------------------------------------------------------
+    void WorkStealingScheduler::submit( JobBatch *batch )
+    {
+        if( batch->unmetDependencies.fetch_sub( 1u, std::memory_order_acq_rel ) == 1u )
+            launchBatch( batch, mNumWorkerThreads );
+    }
+    //-----------------------------------------------------------------------------------
+    void WorkStealingScheduler::broadcast( JobFunc func, void *userData, JobCounter &counter )
+    {
+        OGRE_ASSERT_LOW( mNumWorkerThreads > 0u );
+
+        JobBatch *batch = createBatch( func, userData, mNumWorkerThreads, counter );
+        batch->unmetDependencies.store( 0u, std::memory_order_relaxed );
+
+        for( size_t i = 0u; i < mNumWorkerThreads; ++i )
+        {
+            ThreadQueue &queue = mQueues[i];
+            OGRE_ASSERT_LOW( !queue.pinnedPending.load( std::memory_order_relaxed ) );
+            queue.pinnedBatch = batch;
+            queue.pinnedJobIdx = i;
+            queue.pinnedPending.store( true, std::memory_order_seq_cst );
+            // Pairs with the sleeping store + pinnedPending load in _workerThreadLoop
+            if( queue.sleeping.load( std::memory_order_seq_cst ) )
+                queue.wakeEvent.wake();
+        }
+    }
+    //-----------------------------------------------------------------------------------
+    void WorkStealingScheduler::launchBatch( JobBatch *batch, size_t threadIdx )
+    {
+        const size_t numJobs = batch->numJobs;
+        if( numJobs == 0u )
+        {
+            finishBatch( batch, threadIdx );
+            return;
+        }
+
+        // Count them before they become visible, so that a thief never takes mQueuedJobs below 0
+        mQueuedJobs.fetch_add( numJobs, std::memory_order_seq_cst );
+
+        // Split in contiguous ranges across all queues, starting with our own. Jobs that
+        // process consecutive memory stay together, and everyone has something to pop
+        // without stealing.
+        const size_t numQueues = mQueues.size();
+        const size_t numTargets = std::min( numQueues, numJobs );
+        for( size_t i = 0u; i < numTargets; ++i )
+        {
+            const size_t jobStart = ( i * numJobs ) / numTargets;
+            const size_t jobEnd = ( ( i + 1u ) * numJobs ) / numTargets;
+
+            ThreadQueue &queue = mQueues[( threadIdx + i ) % numQueues];
+            queue.mutex.lock();
+            // Pushed in reverse so the owner (who pops from the back) walks memory forward
+            for( size_t jobIdx = jobEnd; jobIdx-- > jobStart; )
+            {
+                Job job;
+                job.batch = batch;
+                job.jobIdx = jobIdx;
+                queue.jobs.push_back( job );
+            }
+            queue.mutex.unlock();
+        }
+
+        wakeWorkers( numJobs );
+
+        // A successor launched by a worker must not be left to the workers alone
+        // while the main thread sleeps in wait(). Same handshake as with the workers.
+        if( threadIdx != mNumWorkerThreads &&
+            mMainThreadSleeping.load( std::memory_order_seq_cst ) )
+        {
+            mMainThreadEvent.wake();
+        }
+    }
+    //-----------------------------------------------------------------------------------
+    void WorkStealingScheduler::wakeWorkers( size_t maxWorkers )
+    {
+        for( size_t i = 0u; i < mNumWorkerThreads && maxWorkers > 0u; ++i )
+        {
+            ThreadQueue &queue = mQueues[i];
+            if( queue.sleeping.load( std::memory_order_seq_cst ) )
+            {
+                queue.wakeEvent.wake();
+                --maxWorkers;
+            }
+        }
+    }
+    //-----------------------------------------------------------------------------------
+    void WorkStealingScheduler::finishJob( JobBatch *batch, size_t threadIdx )
+    {
+        if( batch->remainingJobs.fetch_sub( 1u, std::memory_order_acq_rel ) == 1u )
+            finishBatch( batch, threadIdx );
+    }
+    //-----------------------------------------------------------------------------------
+    void WorkStealingScheduler::finishBatch( JobBatch *batch, size_t threadIdx )
+    {
+        // Successors are pushed into this thread's queue first; it's the one
+        // whose cache holds the data they most likely depend on.
+        const size_t numSuccessors = batch->successors.size();
+        for( size_t i = 0u; i < numSuccessors; ++i )
+        {
+            JobBatch *successor = batch->successors[i];
+            if( successor->unmetDependencies.fetch_sub( 1u, std::memory_order_acq_rel ) == 1u )
+                launchBatch( successor, threadIdx );
+        }
+
+        JobCounter *counter = batch->counter;
+        mLiveBatches.fetch_sub( 1u, std::memory_order_acq_rel );
+        if( counter->pendingBatches.fetch_sub( 1u, std::memory_order_acq_rel ) == 1u )
+            mMainThreadEvent.wake();
+    }
+    //-----------------------------------------------------------------------------------
+    bool WorkStealingScheduler::executeOneJob( size_t threadIdx )
+    {
+        Job job;
+        bool bFound = false;
+
+        {
+            // Our own queue: newest first
+            ThreadQueue &queue = mQueues[threadIdx];
+            queue.mutex.lock();
+            if( queue.jobs.size() > queue.head )
+            {
+                job = queue.jobs.back();
+                queue.jobs.pop_back();
+                bFound = true;
+                if( queue.jobs.size() == queue.head )
+                {
+                    queue.jobs.clear();
+                    queue.head = 0u;
+                }
+            }
+            queue.mutex.unlock();
+        }
+
+        const size_t numQueues = mQueues.size();
+        for( size_t i = 1u; i < numQueues && !bFound; ++i )
+        {
+            // Steal the oldest job from someone else
+            ThreadQueue &queue = mQueues[( threadIdx + i ) % numQueues];
+            if( !queue.mutex.tryLock() )
+                continue;
+            if( queue.jobs.size() > queue.head )
+            {
+                job = queue.jobs[queue.head++];
+                bFound = true;
+                if( queue.jobs.size() == queue.head )
+                {
+                    queue.jobs.clear();
+                    queue.head = 0u;
+                }
+            }
+            queue.mutex.unlock();
+        }
+
+        if( bFound )
+        {
+            mQueuedJobs.fetch_sub( 1u, std::memory_order_relaxed );
+            job.batch->func( job.batch->userData, job.jobIdx, threadIdx );
+            finishJob( job.batch, threadIdx );
+        }
+
+        return bFound;
+    }
+    //-----------------------------------------------------------------------------------
+    void WorkStealingScheduler::wait( JobCounter &counter )
+    {
+        const size_t threadIdx = mNumWorkerThreads;
+
+        while( !counter.isDone() )
+        {
+            if( executeOneJob( threadIdx ) )
+                continue;
+
+            // Nothing left to steal; the remaining jobs are running in the workers.
+            // mMainThreadEvent is set whenever any counter reaches zero or a worker
+            // launches a dependent batch; if it was set before we got here,
+            // wait() returns immediately and we loop again.
+            size_t spin = 0u;
+            while( spin < c_numSpinIterations && !counter.isDone() &&
+                   mQueuedJobs.load( std::memory_order_relaxed ) == 0u )
+            {
+                ++spin;
+            }
+
+            if( spin == c_numSpinIterations && mNumWorkerThreads > 0u )
+            {
+                mMainThreadSleeping.store( true, std::memory_order_seq_cst );
+                if( !counter.isDone() && mQueuedJobs.load( std::memory_order_seq_cst ) == 0u )
+                    mMainThreadEvent.wait();
+                mMainThreadSleeping.store( false, std::memory_order_relaxed );
+            }
+        }
+
+        // Only the main thread creates batches, so once nothing is in flight
+        // the whole pool can be reused.
+        if( mLiveBatches.load( std::memory_order_acquire ) == 0u )
+            mNumUsedBatches = 0u;
+    }
+    //-----------------------------------------------------------------------------------
+    void WorkStealingScheduler::stop()
+    {
+        mStop.store( true, std::memory_order_seq_cst );
+        for( size_t i = 0u; i < mNumWorkerThreads; ++i )
+            mQueues[i].wakeEvent.wake();
+    }
+    //-----------------------------------------------------------------------------------
+    void WorkStealingScheduler::_workerThreadLoop( size_t threadIdx )
+    {
+        ThreadQueue &queue = mQueues[threadIdx];
+
+        while( true )
+        {
+            if( queue.pinnedPending.load( std::memory_order_acquire ) )
+            {
+                JobBatch *batch = queue.pinnedBatch;
+                batch->func( batch->userData, queue.pinnedJobIdx, threadIdx );
+                queue.pinnedPending.store( false, std::memory_order_release );
+                finishJob( batch, threadIdx );
+                continue;
+            }
+
+            if( executeOneJob( threadIdx ) )
+                continue;
+
+            if( mStop.load( std::memory_order_relaxed ) )
+                break;
+
+            size_t spin = 0u;
+            while( spin < c_numSpinIterations && mQueuedJobs.load( std::memory_order_relaxed ) == 0u &&
+                   !queue.pinnedPending.load( std::memory_order_relaxed ) )
+            {
+                ++spin;
+            }
+
+            if( spin == c_numSpinIterations )
+            {
+                // Dekker-style handshake with launchBatch / broadcast: either we see the
+                // new work after announcing we're asleep, or they see us sleeping and wake us.
+                queue.sleeping.store( true, std::memory_order_seq_cst );
+                if( mQueuedJobs.load( std::memory_order_seq_cst ) == 0u &&
+                    !queue.pinnedPending.load( std::memory_order_seq_cst ) &&
+                    !mStop.load( std::memory_order_seq_cst ) )
+                {
+                    queue.wakeEvent.wait();
+                }
+                queue.sleeping.store( false, std::memory_order_relaxed );
+            }
+        }
+    }
+}  // namespace Ogre
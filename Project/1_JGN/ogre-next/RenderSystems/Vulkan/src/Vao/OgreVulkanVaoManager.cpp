@@ -1131,6 +1131,18 @@ namespace Ogre
             memAllocInfo.allocationSize = poolSize;
             memAllocInfo.memoryTypeIndex = chosenMemoryTypeIdx;
 
+            // [PRISM] Pool buffers are created with SHADER_DEVICE_ADDRESS so ray tracing can use
+            // vertex/index data in place (BLAS build input, closest-hit fetch). Querying the
+            // address of such a buffer requires its memory to be allocated with DEVICE_ADDRESS.
+            VkMemoryAllocateFlagsInfo memAllocFlags;
+            makeVkStruct( memAllocFlags, VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO );
+            memAllocFlags.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+            if( !bIsTextureOnly && vboFlag != CPU_READ_WRITE &&
+                mDevice->mDeviceExtraFeatures.bufferDeviceAddress )
+            {
+                memAllocInfo.pNext = &memAllocFlags;
+            }
+
             VkResult result = vkAllocateMemory( mDevice->mDevice, &memAllocInfo, NULL, &newVbo.vboName );
             checkVkResult( mDevice, result, "vkAllocateMemory" );
 
@@ -0,0 +1,307 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE-Next
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+/*  Standalone check of the ArrayMath backend selected at build time (OGRE_SIMD_SSE2 / _AVX2 /
+    _AVX512) against the scalar math classes, plus a small throughput benchmark.
+
+    The CppUnit suites under Tests/ are not part of the build, so this one has its own
+    main() and CMake target (Test_ArrayMath, run by ctest). Comparing the backends means
+    running it from each build and comparing the "ArrayMath benchmark" lines.
+*/
+#include "Math/Array/OgreArrayMatrixAf4x3.h"
+#include "Math/Array/OgreArrayQuaternion.h"
+#include "Math/Array/OgreArrayVector3.h"
+#include "Math/Array/OgreMathlib.h"
+#include "OgreMath.h"
+#include "OgreMatrix4.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace Ogre;
+
+static int g_failures = 0;
+
+#define ARRAYMATH_CHECK( condition ) \
+    do \
+    { \
+        if( !( condition ) ) \
+        { \
+            printf( "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition ); \
+            ++g_failures; \
+        } \
+    } while( 0 )
+
+#if __OGRE_HAVE_AVX512
+static const char *c_arrayMathBackend = "AVX-512";
+#elif __OGRE_HAVE_AVX2
+static const char *c_arrayMathBackend = "AVX2";
+#elif __OGRE_HAVE_SSE
+static const char *c_arrayMathBackend = "SSE2";
+#elif __OGRE_HAVE_NEON
+static const char *c_arrayMathBackend = "NEON";
+#else
+static const char *c_arrayMathBackend = "C";
+#endif
+
+//--------------------------------------------------------------------------
+static Vector3 randomVector3( Real range )
+{
+    return Vector3( Math::RangeRandom( -range, range ), Math::RangeRandom( -range, range ),
+                    Math::RangeRandom( -range, range ) );
+}
+//--------------------------------------------------------------------------
+static Quaternion randomQuaternion()
+{
+    Vector3 axis = randomVector3( 1.0f ) + Vector3( 0.0f, 0.0f, 1.5f );
+    axis.normalise();
+    return Quaternion( Radian( Math::RangeRandom( -Math::PI, Math::PI ) ), axis );
+}
+//--------------------------------------------------------------------------
+static Matrix4 randomAffineMatrix()
+{
+    Matrix4 m;
+    m.makeTransform( randomVector3( 10.0f ), Vector3( Math::RangeRandom( 0.5f, 2.0f ) ),
+                     randomQuaternion() );
+    return m;
+}
+//--------------------------------------------------------------------------
+static void testVector3Lanes()
+{
+    // Every lane must be independently addressable, whatever the backend's width
+    Vector3 values[ARRAY_PACKED_REALS];
+    ArrayVector3 v( ArrayVector3::ZERO );
+    for( size_t i = 0; i < ARRAY_PACKED_REALS; ++i )
+    {
+        values[i] = randomVector3( 100.0f );
+        v.setFromVector3( values[i], i );
+    }
+
+    for( size_t i = 0; i < ARRAY_PACKED_REALS; ++i )
+        ARRAYMATH_CHECK( values[i] == v.getAsVector3( i ) );
+
+    const ArrayVector3 sum = v + v;
+    ArrayVector3 normalised = v;
+    normalised.normalise();
+    for( size_t i = 0; i < ARRAY_PACKED_REALS; ++i )
+    {
+        ARRAYMATH_CHECK( values[i] * 2.0f == sum.getAsVector3( i ) );
+        ARRAYMATH_CHECK( values[i].normalisedCopy().positionEquals( normalised.getAsVector3( i ),
+                                                                   1e-3f ) );
+    }
+}
+//--------------------------------------------------------------------------
+static void testVector3Collapse()
+{
+    ArrayVector3 v( ArrayVector3::ZERO );
+    Vector3 minimum( Math::POS_INFINITY );
+    Vector3 maximum( Math::NEG_INFINITY );
+    for( size_t i = 0; i < ARRAY_PACKED_REALS; ++i )
+    {
+        const Vector3 value = randomVector3( 100.0f );
+        v.setFromVector3( value, i );
+        minimum.makeFloor( value );
+        maximum.makeCeil( value );
+    }
+
+    // collapseMin/Max must fold every lane, not just the lowest 128 bits
+    ARRAYMATH_CHECK( minimum == v.collapseMin() );
+    ARRAYMATH_CHECK( maximum == v.collapseMax() );
+}
+//--------------------------------------------------------------------------
+static void testQuaternionRotate()
+{
+    Quaternion quats[ARRAY_PACKED_REALS];
+    Vector3 values[ARRAY_PACKED_REALS];
+    ArrayQuaternion q( ArrayQuaternion::IDENTITY );
+    ArrayVector3 v( ArrayVector3::ZERO );
+    for( size_t i = 0; i < ARRAY_PACKED_REALS; ++i )
+    {
+        quats[i] = randomQuaternion();
+        values[i] = randomVector3( 10.0f );
+        q.setFromQuaternion( quats[i], i );
+        v.setFromVector3( values[i], i );
+    }
+
+    const ArrayVector3 rotated = q * v;
+    const ArrayQuaternion concatenated = q * q;
+    for( size_t i = 0; i < ARRAY_PACKED_REALS; ++i )
+    {
+        ARRAYMATH_CHECK( ( quats[i] * values[i] ).positionEquals( rotated.getAsVector3( i ), 1e-3f ) );
+
+        Quaternion expected = quats[i] * quats[i];
+        Quaternion actual;
+        concatenated.getAsQuaternion( actual, i );
+        for( size_t j = 0; j < 4; ++j )
+            ARRAYMATH_CHECK( Math::RealEqual( expected[j], actual[j], 1e-4f ) );
+    }
+}
+//--------------------------------------------------------------------------
+static void testMatrixAf4x3LoadStore()
+{
+    // The SIMD backends transpose through registers wider than one Matrix4 row,
+    // which is easy to get wrong for lanes other than the first ones
+    OGRE_ALIGNED_DECL( Matrix4, src[ARRAY_PACKED_REALS], OGRE_SIMD_ALIGNMENT );
+    OGRE_ALIGNED_DECL( Matrix4, dst[ARRAY_PACKED_REALS], OGRE_SIMD_ALIGNMENT );
+    for( size_t i = 0; i < ARRAY_PACKED_REALS; ++i )
+    {
+        src[i] = randomAffineMatrix();
+        dst[i] = Matrix4::ZERO;
+    }
+
+    ArrayMatrixAf4x3 m;
+    m.loadFromAoS( src );
+    m.streamToAoS( dst );
+
+    for( size_t i = 0; i < ARRAY_PACKED_REALS; ++i )
+        ARRAYMATH_CHECK( src[i] == dst[i] );
+
+    OGRE_ALIGNED_DECL( SimpleMatrixAf4x3, simple[ARRAY_PACKED_REALS], OGRE_SIMD_ALIGNMENT );
+    m.storeToAoS( simple );
+    for( size_t i = 0; i < ARRAY_PACKED_REALS; ++i )
+    {
+        Matrix4 stored;
+        simple[i].store( &stored );
+        ARRAYMATH_CHECK( src[i] == stored );
+    }
+
+    ArrayMatrixAf4x3 fromSimple;
+    fromSimple.loadFromAoS( simple );
+    fromSimple.streamToAoS( dst );
+    for( size_t i = 0; i < ARRAY_PACKED_REALS; ++i )
+        ARRAYMATH_CHECK( src[i] == dst[i] );
+}
+//--------------------------------------------------------------------------
+static void testMatrixAf4x3Transform()
+{
+    OGRE_ALIGNED_DECL( Matrix4, lhs[ARRAY_PACKED_REALS], OGRE_SIMD_ALIGNMENT );
+    OGRE_ALIGNED_DECL( Matrix4, rhs[ARRAY_PACKED_REALS], OGRE_SIMD_ALIGNMENT );
+    OGRE_ALIGNED_DECL( Matrix4, dst[ARRAY_PACKED_REALS], OGRE_SIMD_ALIGNMENT );
+    Vector3 values[ARRAY_PACKED_REALS];
+    ArrayVector3 v( ArrayVector3::ZERO );
+    for( size_t i = 0; i < ARRAY_PACKED_REALS; ++i )
+    {
+        lhs[i] = randomAffineMatrix();
+        rhs[i] = randomAffineMatrix();
+        values[i] = randomVector3( 10.0f );
+        v.setFromVector3( values[i], i );
+    }
+
+    ArrayMatrixAf4x3 arrayLhs, arrayRhs;
+    arrayLhs.loadFromAoS( lhs );
+    arrayRhs.loadFromAoS( rhs );
+
+    const ArrayVector3 transformed = arrayLhs * v;
+    ( arrayLhs * arrayRhs ).streamToAoS( dst );
+
+    for( size_t i = 0; i < ARRAY_PACKED_REALS; ++i )
+    {
+        ARRAYMATH_CHECK( lhs[i].transformAffine( values[i] )
+                            .positionEquals( transformed.getAsVector3( i ), 1e-3f ) );
+
+        // FMA backends round differently, compare with a tolerance
+        const Matrix4 expected = lhs[i].concatenateAffine( rhs[i] );
+        for( size_t row = 0; row < 4; ++row )
+        {
+            for( size_t col = 0; col < 4; ++col )
+            {
+                ARRAYMATH_CHECK( Math::RealEqual( expected[row][col], dst[i][row][col], 1e-3f ) );
+            }
+        }
+    }
+}
+//--------------------------------------------------------------------------
+static void testBenchmark()
+{
+    // Mimics Node::updateAllTransforms: build the local transform from position, scale &
+    // orientation, concatenate it with the parent's and transform a point by it
+    const size_t numObjects = 16384u;
+    const size_t numPacks = numObjects / ARRAY_PACKED_REALS;
+    const size_t numIterations = 50u;
+
+    ArrayVector3 *positions = reinterpret_cast<ArrayVector3 *>(
+        OGRE_MALLOC_SIMD( sizeof( ArrayVector3 ) * numPacks, MEMCATEGORY_GENERAL ) );
+    ArrayVector3 *scales = reinterpret_cast<ArrayVector3 *>(
+        OGRE_MALLOC_SIMD( sizeof( ArrayVector3 ) * numPacks, MEMCATEGORY_GENERAL ) );
+    ArrayQuaternion *orientations = reinterpret_cast<ArrayQuaternion *>(
+        OGRE_MALLOC_SIMD( sizeof( ArrayQuaternion ) * numPacks, MEMCATEGORY_GENERAL ) );
+    ArrayMatrixAf4x3 *transforms = reinterpret_cast<ArrayMatrixAf4x3 *>(
+        OGRE_MALLOC_SIMD( sizeof( ArrayMatrixAf4x3 ) * numPacks, MEMCATEGORY_GENERAL ) );
+
+    for( size_t i = 0; i < numPacks; ++i )
+    {
+        for( size_t j = 0; j < ARRAY_PACKED_REALS; ++j )
+        {
+            positions[i].setFromVector3( randomVector3( 10.0f ), j );
+            scales[i].setFromVector3( Vector3( Math::RangeRandom( 0.5f, 2.0f ) ), j );
+            orientations[i].setFromQuaternion( randomQuaternion(), j );
+        }
+    }
+
+    const ArrayMatrixAf4x3 parent = ArrayMatrixAf4x3::createAllFromMatrix4( randomAffineMatrix() );
+    ArrayVector3 checksum( ArrayVector3::ZERO );
+
+    const auto start = std::chrono::steady_clock::now();
+    for( size_t iteration = 0; iteration < numIterations; ++iteration )
+    {
+        for( size_t i = 0; i < numPacks; ++i )
+        {
+            transforms[i].makeTransform( positions[i], scales[i], orientations[i] );
+            transforms[i] = parent * transforms[i];
+            checksum += transforms[i] * positions[i];
+        }
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    const Vector3 collapsed = checksum.collapseMax();
+    ARRAYMATH_CHECK( !collapsed.isNaN() );
+
+    const double nsPerObject = elapsed.count() / double( numObjects * numIterations );
+    printf( "ArrayMath benchmark (%s, %d wide): %.3f ns per transform\n", c_arrayMathBackend,
+            int( ARRAY_PACKED_REALS ), nsPerObject );
+
+    OGRE_FREE_SIMD( transforms, MEMCATEGORY_GENERAL );
+    OGRE_FREE_SIMD( orientations, MEMCATEGORY_GENERAL );
+    OGRE_FREE_SIMD( scales, MEMCATEGORY_GENERAL );
+    OGRE_FREE_SIMD( positions, MEMCATEGORY_GENERAL );
+}
+//--------------------------------------------------------------------------
+int main()
+{
+    srand( 0 );
+    testVector3Lanes();
+    testVector3Collapse();
+    testQuaternionRotate();
+    testMatrixAf4x3LoadStore();
+    testMatrixAf4x3Transform();
+    testBenchmark();
+
+    if( g_failures )
+        printf( "ArrayMath (%s): %d checks failed\n", c_arrayMathBackend, g_failures );
+    return g_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Constraints.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Prism {
+
+    // 구운(baked) 소프트바디 파일 (.prsb)
+    // TetGen 텍스트 파싱 + 제약 조건 생성 + 컬러링 결과를 그대로 저장. 로드는 파일을 매핑하고 포인터만 잡으므로
+    // 파싱/컬러링 비용이 없고, 섹션을 바로 스테이징 버퍼로 memcpy 할 수 있음
+    //
+    // [BakedSoftbodyHeader][섹션 0][섹션 1]... 각 섹션은 16 bytes 정렬, little-endian
+    // 섹션 내용은 ParticleStore 스트림 / GPU SSBO 레이아웃과 동일 (DistanceConstraint, VolumeConstraint 32 bytes)
+
+    constexpr uint32_t kBakedSoftbodyMagic = 0x42535250;   // "PRSB"
+    constexpr uint32_t kBakedSoftbodyVersion = 1;
+
+    enum class BakedSection : uint32_t {
+        PosInvMass,
+        Velocity,
+        PrevPos,
+        Color,
+        OriginPos,
+        Normal,
+        InvMass,
+        IsFixed,
+        IsSurface,
+        Indices,
+        DistanceConstraints,
+        VolumeConstraints,
+        DistanceColorGroups,
+        VolumeColorGroups,
+        Count
+    };
+
+    struct BakedSectionEntry {
+        uint64_t offset;    // 파일 시작 기준
+        uint64_t size;      // bytes
+    };
+
+    struct BakedSoftbodyHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t particleCount;
+        uint32_t sectionCount;
+        float stiffness;        // 제약 조건 compliance 를 만들 때 쓴 값 (캐시 무효화 판단용)
+        uint32_t padding;
+        BakedSectionEntry sections[static_cast<size_t>(BakedSection::Count)];
+    };
+
+    // 실패 시 std::runtime_error
+    void saveBakedSoftbody(const std::string& path, const Softbody& body, float stiffness);
+
+    // 구운 파일이 없거나 TetGen 원본(.node/.ele/.edge/.face) 중 하나라도 더 최신이면 true
+    bool isBakedSoftbodyStale(const std::string& bakedPath, const std::string& meshBasePath);
+
+    // 읽기 전용 메모리 매핑. 뷰는 이 객체가 살아 있는 동안만 유효
+    // 헤더, 섹션 범위/크기, 색상 그룹 테이블을 열 때 검증하고 실패 시 std::runtime_error
+    class BakedSoftbodyFile {
+    public:
+        explicit BakedSoftbodyFile(const std::string& path);
+        ~BakedSoftbodyFile();
+
+        BakedSoftbodyFile(const BakedSoftbodyFile&) = delete;
+        BakedSoftbodyFile& operator=(const BakedSoftbodyFile&) = delete;
+
+        const SoftbodyView& view() const { return bodyView; }
+        size_t fileSize() const { return mappedSize; }
+        float stiffness() const { return bakedStiffness; }
+
+    private:
+        void unmap();
+
+        const std::byte* mappedData = nullptr;
+        size_t mappedSize = 0;
+        float bakedStiffness = 0.0f;
+#ifdef _WIN32
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+#endif
+        SoftbodyView bodyView;
+    };
+
+    // 매핑한 파일을 CpuSolver 용 Softbody 로 복사
+    Softbody loadBakedSoftbody(const std::string& path);
+
+}
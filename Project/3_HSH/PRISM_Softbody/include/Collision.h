@@ -0,0 +1,114 @@
+#pragma once
+
+#include "Constraints.h"
+#include "SoftbodyWorld.h"
+#include "SpatialHash.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Prism {
+
+    class ThreadPool;
+
+    struct CollisionParams {
+        float thickness = 0.0f;         // 접촉 거리. 0 이하면 거리 제약 평균 길이의 절반
+        bool selfCollision = true;      // 같은 body 안의 표면끼리도 검사 (휴지 상태에서 질의 반경 안쪽인 쌍은 제외)
+        bool particleTriangle = true;   // 파티클-표면 삼각형 접촉 (끄면 파티클-파티클만)
+    };
+
+    // GPU 업로드용 표면 삼각형 (CollisionSolve.comp 의 레이아웃과 동일)
+    struct CollisionTriangle {
+        uint32_t p0, p1, p2;
+        uint32_t body;
+    };
+
+    // 표면 파티클 + 표면 삼각형 충돌
+    // 서브스텝마다 (솔브 이터레이션 뒤) 표면 파티클마다 주변 접촉의 보정량을 모아 평균을 한 번에 적용 (Jacobi).
+    // 파티클별로 자기 보정량만 쓰므로 CPU parallelFor / GPU 스레드 모두 경쟁 없음
+    //
+    // 해시 두 개: 파티클 해시 = 표면 파티클 S 개 (점, 셀 하나), 삼각형 해시 = 표면 삼각형 T 개 (넓힌 AABB 가 덮는
+    // 셀 전부). 셀 크기를 따로 잡아 작은 파티클 질의가 큰 삼각형 항목을 훑지 않도록 함
+    // 객체 AABB 배열은 [0, S) 파티클, [S, S+T) 삼각형 순서로 하나
+    //
+    // CPU 는 해시 질의 결과를 후보 목록으로 저장해 두고 (질의 반경 = thickness + skin), 마지막 재구성 이후
+    // 어떤 쌍의 거리든 skin 이상 줄 수 있을 때만 해시와 목록을 다시 만듦 (Verlet list). 이동량에서 body 별 평균 이동을
+    // 빼고 재므로 body 들이 함께 떨어지는 동안에는 재구성하지 않음. 그 전까지는 목록 밖에서 새 접촉이 생기지 않음
+    // GPU 경로(Collision*.comp)는 서브스텝마다 해시를 다시 만들고 후보 목록 없이 바로 접촉을 계산
+    //
+    // 파티클-삼각형 접촉은 파티클 쪽만 움직임 (삼각형 꼭짓점은 파티클-파티클 접촉으로 밀려남)
+    class CollisionSystem {
+    public:
+        // bodies 가 비어 있으면 전체를 body 하나로 취급
+        CollisionSystem(const SoftbodyView& body, std::span<const SoftbodyRange> bodies, const CollisionParams& params = {});
+
+        // 필요하면 후보 목록 재구성 + 접촉 보정
+        void solve(ParticleStore& particles, ThreadPool& pool);
+
+        // 마지막 solve 에서 접촉이 하나 이상 있었던 표면 파티클 수
+        uint32_t contactCount() const { return lastContactCount; }
+        // 후보 목록을 다시 만든 횟수
+        uint32_t rebuildCount() const { return rebuilds; }
+
+        // GPU 경로용 데이터
+        std::span<const uint32_t> surfaceParticles() const { return surfaceIds; }
+        std::span<const CollisionTriangle> triangles() const { return surfaceTriangles; }
+        std::span<const uint32_t> particleBodies() const { return bodyIds; }
+        std::span<const uint32_t> restExclusionStart() const { return restExcludeStart; }
+        std::span<const uint32_t> restExclusions() const { return restExclude; }
+        uint32_t objectCount() const { return static_cast<uint32_t>(surfaceIds.size() + surfaceTriangles.size()); }
+        float thickness() const { return contactDistance; }
+        const SpatialHash& particleGrid() const { return particleHash; }
+        const SpatialHash& triangleGrid() const { return triangleHash; }
+        bool selfCollision() const { return collisionParams.selfCollision; }
+        bool particleTriangle() const { return collisionParams.particleTriangle; }
+
+    private:
+        // 객체 [begin, end) 의 AABB (파티클 = 점, 삼각형 = radius 만큼 넓힌 상자)
+        void computeBounds(const glm::vec4* pos, float radius, uint32_t begin, uint32_t end);
+        void buildHashes();
+
+        // 표면 파티클 s 와 현재 거리 < radius 인 객체마다 fn(o). excluded (정렬된 객체 인덱스) 는 거리 계산 전에 건너뜀
+        template<typename Fn>
+        void forEachNeighbor(const glm::vec4* pos, float radius, uint32_t s, std::span<const uint32_t> excluded, Fn&& fn) const;
+
+        bool needsRebuild(const glm::vec4* pos);
+        void rebuildCandidates(const glm::vec4* pos, ThreadPool& pool);
+
+        CollisionParams collisionParams;
+        float contactDistance = 0.0f;
+        float skin = 0.0f;
+
+        std::vector<uint32_t> surfaceIds;
+        std::vector<CollisionTriangle> surfaceTriangles;
+        std::vector<uint32_t> bodyIds;      // 파티클별
+        std::vector<uint32_t> surfaceBodies;    // 표면 파티클별 body
+        std::vector<glm::vec4> restPos;     // originPos 복사
+
+        // 표면 파티클별로, 휴지 상태에서 이미 질의 반경(thickness + skin) 안쪽인 같은 body 객체 (CSR, 정렬).
+        // 메쉬 이웃이라 거리 제약이 간격을 유지하므로 접촉이 아님. 이 쌍들이 후보 목록을 채우지 않도록 thickness 가 아닌 질의 반경 기준
+        std::vector<uint32_t> restExcludeStart;
+        std::vector<uint32_t> restExclude;
+
+        SpatialHash particleHash;
+        SpatialHash triangleHash;
+        std::vector<glm::vec4> boxMin;      // 해시 객체별 AABB
+        std::vector<glm::vec4> boxMax;
+
+        // 표면 파티클별 후보 (CSR). 값 < S 이면 표면 파티클 인덱스, 아니면 S + 삼각형 인덱스
+        std::vector<uint32_t> candidateStart;
+        std::vector<uint32_t> candidates;
+        std::vector<glm::vec4> buildPos;    // 재구성 시점의 표면 파티클 위치
+        std::vector<glm::vec4> bodyShift;   // body 별 재구성 이후 평균 이동 (needsRebuild 작업 공간)
+        bool candidatesValid = false;
+        uint32_t rebuilds = 0;
+
+        std::vector<glm::vec4> corrections; // 표면 파티클별, w = 접촉 수
+        uint32_t lastContactCount = 0;
+    };
+
+    // p 에서 삼각형 (a, b, c) 의 가장 가까운 점 (Ericson, Real-Time Collision Detection 5.1.5)
+    glm::vec3 closestPointOnTriangle(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, glm::vec3& outBary);
+
+}
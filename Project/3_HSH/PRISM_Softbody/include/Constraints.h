@@ -0,0 +1,100 @@
+#pragma once
+
+#include "GraphColoring.h"
+#include "ParticleStore.h"
+#include "TetMesh.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Prism {
+
+    // SolveDist.comp / SolveVol.comp 의 SSBO 레이아웃과 동일 (32 bytes)
+    struct DistanceConstraint {
+        uint32_t p1, p2;
+        float restLen;
+        float compliance;
+        float lambda;
+        float padding[3];
+    };
+
+    struct VolumeConstraint {
+        uint32_t p1, p2, p3, p4;
+        float restVol;
+        float compliance;
+        float lambda;
+        float padding;
+    };
+
+    // 같은 색상 그룹 안의 제약 조건끼리는 파티클을 공유하지 않음 -> 병렬 처리 가능
+    struct ColorGroup {
+        uint32_t offset;
+        uint32_t count;
+    };
+
+    struct ColoredDistanceResult {
+        std::vector<DistanceConstraint> reorderedConstraints;
+        std::vector<ColorGroup> groups;
+        ColoringStats stats;
+    };
+
+    struct ColoredVolumeResult {
+        std::vector<VolumeConstraint> reorderedConstraints;
+        std::vector<ColorGroup> groups;
+        ColoringStats stats;
+    };
+
+    bool generateDistanceConstraints(const std::vector<Particle>& particles, const std::vector<Edge>& edges, const float& stiffness, std::vector<DistanceConstraint>& outConstraints);
+    bool generateVolumeConstraints(const std::vector<Particle>& particles, const std::vector<Tetrahedron>& tetras, const float& stiffness, std::vector<VolumeConstraint>& outConstraints);
+
+    // 그룹 안의 순서는 원래 제약 조건 순서를 유지
+    ColoredDistanceResult colorDistanceConstraints(const std::vector<DistanceConstraint>& constraints, uint32_t numParticles, const ColoringOptions& options = {});
+    ColoredVolumeResult colorVolumeConstraints(const std::vector<VolumeConstraint>& constraints, uint32_t numParticles, const ColoringOptions& options = {});
+
+    // 시뮬레이션 한 덩어리에 필요한 데이터 (CPU/GPU 솔버 공용)
+    // 제약 조건 배열은 색상 그룹 순서로 정렬되어 있음
+    struct Softbody {
+        ParticleStore particles;
+        std::vector<uint32_t> indices;
+
+        std::vector<DistanceConstraint> distanceConstraints;
+        std::vector<VolumeConstraint> volumeConstraints;
+        std::vector<ColorGroup> distanceColorGroups;
+        std::vector<ColorGroup> volumeColorGroups;
+    };
+
+    // Softbody 또는 매핑된 .prsb 파일(BakedSoftbodyFile) 위의 읽기 전용 뷰 (GPU 업로드용)
+    struct SoftbodyView {
+        std::span<const glm::vec4> posInvMass;
+        std::span<const glm::vec4> velocity;
+        std::span<const glm::vec4> prevPos;
+        std::span<const glm::vec4> color;
+        std::span<const glm::vec4> originPos;
+        std::span<const glm::vec4> normal;
+        std::span<const float> invMass;
+        std::span<const float> isFixed;
+        std::span<const float> isSurface;
+
+        std::span<const uint32_t> indices;
+
+        std::span<const DistanceConstraint> distanceConstraints;
+        std::span<const VolumeConstraint> volumeConstraints;
+        std::span<const ColorGroup> distanceColorGroups;
+        std::span<const ColorGroup> volumeColorGroups;
+
+        size_t particleCount() const { return posInvMass.size(); }
+    };
+
+    SoftbodyView makeSoftbodyView(const Softbody& body);
+
+    struct SoftbodyBuildStats {
+        ColoringStats distance;
+        ColoringStats volume;
+    };
+
+    // 제약 조건 생성 + 그래프 컬러링, 실패 시 std::runtime_error
+    // pool 이 있으면 컬러링을 병렬로 실행, outStats 가 있으면 컬러링 통계를 채움 (출력은 호출 측에서)
+    Softbody buildSoftbody(const TetMesh& mesh, float stiffness, ThreadPool* pool = nullptr, SoftbodyBuildStats* outStats = nullptr);
+
+}
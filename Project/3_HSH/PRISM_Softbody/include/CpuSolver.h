@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Collision.h"
+#include "Constraints.h"
+#include "ThreadPool.h"
+
+#include <cstdint>
+#include <memory>
+#include <span>
+
+namespace Prism {
+
+    // 기본값은 Vulkan_XPBD_TetraSim 의 recordCommandBuffer / 셰이더 상수와 동일
+    struct SolverParams {
+        float dt = 0.016f;
+        int subStepCnt = 16;
+        int iterations = 4;
+        float damping = 0.98f;                  // 서브스텝마다 pow(damping, 1/subStepCnt) 적용
+        glm::vec3 gravity = glm::vec3(0.0f, -9.8f, 0.0f);
+        float groundY = -1.5f;
+
+        uint32_t grainSize = 256;               // parallelFor 청크 크기 (SIMD 폭의 배수로)
+    };
+
+    // GPU 경로(Predict -> 색상 그룹별 SolveDist/SolveVol -> Update)를 그대로 CPU 에서 실행
+    // 색상 그룹 하나 = vkCmdDispatch 하나 = parallelFor 하나, 그룹 사이의 barrier 는 parallelFor 의 join
+    class CpuSolver {
+    public:
+        CpuSolver(Softbody body, ThreadPool& pool, const SolverParams& params = {});
+
+        // 표면 충돌 켜기 (서브스텝마다 솔브 이터레이션 뒤에 CollisionSystem::solve)
+        // bodies 는 SoftbodyWorld::bodies, 비어 있으면 전체를 body 하나로 취급 (자기 충돌만)
+        void enableCollision(std::span<const SoftbodyRange> bodies, const CollisionParams& params = {});
+
+        // 한 프레임 (dt) 진행
+        void step();
+
+        const Softbody& softbody() const { return body; }
+        const ParticleStore& particles() const { return body.particles; }
+        const SolverParams& params() const { return solverParams; }
+        const CollisionSystem* collision() const { return collisionSystem.get(); }
+
+        uint64_t frameCount() const { return frames; }
+        float elapsedTime() const { return time; }
+
+        // 빌드된 제약 조건 커널 종류 ("sse2" / "scalar")
+        static const char* kernelName();
+
+    private:
+        void predict(float sdt, float dampingFactor);
+        void solveDistance(float sdt, bool resetLambda);
+        void solveVolume(float sdt, bool resetLambda);
+        void update(float sdt);
+
+        Softbody body;
+        std::unique_ptr<CollisionSystem> collisionSystem;
+        ThreadPool& pool;
+        SolverParams solverParams;
+
+        uint64_t frames = 0;
+        float time = 0.0f;
+    };
+
+}
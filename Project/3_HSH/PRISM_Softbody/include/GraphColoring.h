@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+namespace Prism {
+
+    class ThreadPool;
+
+    // 제약 조건 그래프 컬러링
+    // 두 제약 조건이 파티클을 하나라도 공유하면 인접. 간선을 만들지 않고 파티클별 "사용 중인 색" 비트마스크로 판단
+    //   1. first-fit: 제약 조건 순서대로 파티클 마스크 OR 의 첫 빈 비트 (기존 greedy 와 같은 결과, O(제약 조건 수))
+    //   2. 색 수 줄이기: 색상 그룹 단위 iterated greedy (Culberson), 그룹 안은 병렬
+    //   3. 균등화: 큰 그룹의 제약 조건을 겹치지 않는 작은 그룹으로 옮김, 후보 계산은 병렬
+    // 병렬 구간은 그룹 안에서만 나뉘므로 스레드 수가 달라도 결과는 같음
+    struct ColoringOptions {
+        ThreadPool* pool = nullptr;     // nullptr 이면 호출 스레드에서 실행
+        bool balance = true;            // 큰 색상 그룹의 제약 조건을 작은 그룹으로 옮겨 크기를 맞춤
+    };
+
+    struct ColoringStats {
+        uint32_t colorCount = 0;
+        uint32_t minGroupSize = 0;
+        uint32_t maxGroupSize = 0;
+        float imbalance = 0.0f;         // maxGroupSize / 평균 그룹 크기 (1.0 이 완전 균등)
+        uint32_t firstFitColors = 0;    // 색 수 줄이기 전 (기존 greedy 결과)
+        uint32_t recolorPasses = 0;     // 색 수 줄이기 패스 수
+        double milliseconds = 0.0;
+    };
+
+    // "N (group min~max, imbalance x, first-fit n, p passes, t ms)" 한 줄 요약
+    std::ostream& operator<<(std::ostream& os, const ColoringStats& stats);
+
+    // particleIndices[i * particlesPerConstraint + k] = 제약 조건 i 의 k 번째 파티클
+    // 반환값: 제약 조건별 색상 (0 ~ colorCount-1)
+    std::vector<uint32_t> colorConstraintGraph(const std::vector<uint32_t>& particleIndices, uint32_t particlesPerConstraint,
+                                               uint32_t numParticles, const ColoringOptions& options, ColoringStats* outStats);
+
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "TetMesh.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Prism {
+
+    // SoA 파티클 저장소
+    // 제약 조건 솔브(SolveDist/SolveVol)는 위치와 역질량만 필요하므로 이 둘을 vec4 하나로 묶은
+    // posInvMass 스트림만 읽고 쓴다. 파티클 하나당 112 bytes -> 16 bytes
+    //
+    // 고정점은 posInvMass.w 를 0 으로 미리 접어 둠 (셰이더가 매 서브스텝 isFixed 로 invMass 를 다시 쓰던 것 대신)
+    struct ParticleStore {
+        // hot: 솔브, Predict, Update, 버텍스 입력
+        std::vector<glm::vec4> posInvMass;      // xyz = 위치, w = 역질량 (고정점은 0)
+
+        // warm: Predict / Update 에서만 사용
+        std::vector<glm::vec4> velocity;
+        std::vector<glm::vec4> prevPos;
+
+        // cold: 렌더링 / 초기화 전용
+        std::vector<glm::vec4> color;
+        std::vector<glm::vec4> originPos;
+        std::vector<glm::vec4> normal;
+        std::vector<float> invMass;             // 고정 해제 시 복원할 원래 역질량
+        std::vector<float> isFixed;
+        std::vector<float> isSurface;
+
+        size_t size() const { return posInvMass.size(); }
+
+        void setFixed(uint32_t index, bool fixed);
+    };
+
+    ParticleStore makeParticleStore(const std::vector<Particle>& particles);
+
+    // 디버그 / 비교용 AoS 로 되돌리기
+    std::vector<Particle> toParticles(const ParticleStore& store);
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Constraints.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Prism {
+
+    // 월드에 넣을 body 하나 (같은 메쉬를 여러 번 넣어도 됨)
+    struct SoftbodyPlacement {
+        SoftbodyView body;
+        glm::vec3 translation = glm::vec3(0.0f);
+    };
+
+    // 합쳐진 버퍼 안에서 body 하나가 차지하는 범위
+    struct SoftbodyRange {
+        uint32_t particleOffset;
+        uint32_t particleCount;
+        uint32_t indexOffset;       // 표면 인덱스 (값은 이미 particleOffset 만큼 더해져 있음)
+        uint32_t indexCount;
+    };
+
+    // 여러 softbody 를 파티클/제약 조건 버퍼 하나로 합친 것
+    // 서로 다른 body 는 파티클을 공유하지 않으므로, 모든 body 의 k 번째 색상 그룹을 이어 붙여도 여전히 독립.
+    // 그래서 combined 의 색상 그룹 수 = body 들 중 최대 색 수 이고, body 수와 관계없이 색상당 dispatch 하나로 끝남
+    struct SoftbodyWorld {
+        Softbody combined;                  // CpuSolver / GPU 버퍼 생성에 그대로 사용
+        std::vector<SoftbodyRange> bodies;
+    };
+
+    // 병합 색상 그룹 k 안의 순서는 body 순서 -> body 안의 원래 순서
+    SoftbodyWorld buildSoftbodyWorld(std::span<const SoftbodyPlacement> placements);
+
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Prism {
+
+    // 균일 격자 공간 해시 (counting sort)
+    // 객체마다 AABB 가 겹치는 셀에 넣고, 셀 좌표를 해시해 tableSize 개의 버킷으로 접음.
+    // 어느 축이든 kMaxCellsPerAxis 개를 넘게 덮는 객체는 셀 대신 oversizedBucket() 하나에만 넣으므로
+    // 질의 측은 자기 셀 버킷과 함께 oversized 버킷도 훑어야 함
+    // 버킷별 객체 목록은 cellStart / cellEntries 두 배열. 다른 셀이 같은 버킷에 섞일 수 있으므로
+    // 질의 결과는 호출 측에서 거리 검사로 다시 걸러야 함
+    //
+    // 해시 함수, 셀 좌표(p * invCellSize), 셀 범위 규칙은 Collision*.comp 와 동일
+    // (GPU 는 파티클/삼각형 두 테이블과 삼각형 oversized 버킷을 버퍼 하나에 이어 붙임)
+    class SpatialHash {
+    public:
+        static constexpr int kMaxCellsPerAxis = 8;    // 폭주한(터진) 삼각형이 셀을 무한정 덮지 않도록. 넘으면 oversized 버킷
+
+        void reset(float cellSize, uint32_t tableSize);
+
+        // 객체 i 의 AABB = [boxMin[i], boxMax[i]] (점이면 둘이 같음). 버킷 안은 객체 인덱스 오름차순
+        void build(std::span<const glm::vec4> boxMin, std::span<const glm::vec4> boxMax);
+
+        template<typename Fn>
+        void forEachInBucket(uint32_t bucket, Fn&& fn) const {
+            for (uint32_t e = cellStart[bucket]; e < cellStart[bucket + 1]; e++) {
+                fn(cellEntries[e]);
+            }
+        }
+
+        glm::ivec3 cellCoord(const glm::vec3& p) const {
+            return glm::ivec3(glm::floor(p * invCellSize));
+        }
+
+        // 어느 축이든 kMaxCellsPerAxis 개를 넘으면 false (build 는 이런 객체를 oversized 버킷에 넣음)
+        bool cellRange(const glm::vec3& lo, const glm::vec3& hi, glm::ivec3& outMin, glm::ivec3& outMax) const {
+            outMin = cellCoord(lo);
+            outMax = cellCoord(hi);
+            return glm::all(glm::lessThan(outMax - outMin, glm::ivec3(kMaxCellsPerAxis)));
+        }
+
+        uint32_t hashCell(const glm::ivec3& c) const {
+            uint32_t h = (uint32_t(c.x) * 92837111u) ^ (uint32_t(c.y) * 689287499u) ^ (uint32_t(c.z) * 283923481u);
+            return h % tableSize;
+        }
+
+        // 셀에 들어가지 않은 큰 객체들. 일반 버킷 인덱스 [0, tableSize) 다음
+        uint32_t oversizedBucket() const { return tableSize; }
+
+        float getCellSize() const { return cellSize; }
+        float getInvCellSize() const { return invCellSize; }
+        uint32_t getTableSize() const { return tableSize; }
+        uint32_t entryCount() const { return static_cast<uint32_t>(cellEntries.size()); }
+
+    private:
+        float cellSize = 1.0f;
+        float invCellSize = 1.0f;
+        uint32_t tableSize = 1;
+
+        std::vector<uint32_t> cellStart;      // tableSize + 2 (마지막 일반 버킷 다음이 oversized 버킷)
+        std::vector<uint32_t> cellEntries;
+    };
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Prism {
+
+    // .node 파서 출력 (AoS, 112 bytes). 시뮬레이션은 ParticleStore(SoA)로 변환해서 사용
+    struct Particle {
+        glm::vec4 pos;
+        glm::vec4 color;
+
+        glm::vec4 vel;
+        glm::vec4 originPos;
+        glm::vec4 prevPos;
+        glm::vec4 normal;
+        float invMass;
+        float isFixed;
+        float isSurface;
+        float padding;
+    };
+
+    struct Edge {
+        uint32_t indices[2];
+        int32_t marker;
+        int32_t padding;
+    };
+
+    struct Tetrahedron {
+        uint32_t indices[4];
+    };
+
+    struct Face {
+        uint32_t indices[3];
+        int32_t marker;
+    };
+
+    // TetGen 출력 (.node / .ele / .edge / .face) 한 세트
+    struct TetMesh {
+        std::vector<Particle> particles;
+        std::vector<Tetrahedron> tetras;
+        std::vector<Edge> edges;
+        std::vector<Face> faces;
+
+        std::vector<uint32_t> indices; // 표면 삼각형 인덱스 (faces 를 펼친 것)
+    };
+
+    bool parseNodeFile(const std::string& filename, std::vector<Particle>& outParticles, int& outStartIndex);
+    bool parseEleFile(const std::string& filename, int startIndex, std::vector<Tetrahedron>& outTetras);
+    bool parseEdgeFile(const std::string& filename, int startIndex, std::vector<Edge>& outEdges);
+    bool parseFaceFile(const std::string& filename, int startIndex, std::vector<Face>& outFaces);
+
+    // 네 파일을 모두 읽어 TetMesh 구성, 실패 시 std::runtime_error
+    TetMesh loadTetMesh(const std::string& nodeFile, const std::string& eleFile,
+                        const std::string& edgeFile, const std::string& faceFile);
+
+    // "models/bunny_1k.1" 처럼 확장자를 뺀 경로
+    TetMesh loadTetMesh(const std::string& basePath);
+
+}
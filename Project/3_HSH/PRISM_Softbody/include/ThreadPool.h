@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Prism {
+
+    // 색상 그룹 하나 = parallelFor 한 번. 서브스텝마다 수십 번 호출되므로
+    // 스레드는 미리 만들어 두고 재사용 (매번 std::thread 생성하면 생성 비용이 솔브 비용보다 큼)
+    class ThreadPool {
+    public:
+        // threadCount == 0 이면 hardware_concurrency 사용, 호출 스레드도 작업자 하나로 취급
+        explicit ThreadPool(uint32_t threadCount = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        uint32_t threadCount() const { return static_cast<uint32_t>(workers.size()) + 1; }
+
+        // [0, count) 를 grain 크기 청크로 나눠 fn(begin, end) 호출, 모든 청크가 끝나야 반환
+        void parallelFor(uint32_t count, uint32_t grain, const std::function<void(uint32_t, uint32_t)>& fn);
+
+    private:
+        void workerLoop();
+        void runChunks();
+
+        std::vector<std::thread> workers;
+
+        std::mutex mutex;
+        std::condition_variable wakeCv;
+        std::condition_variable doneCv;
+        uint64_t generation = 0;
+        uint32_t activeWorkers = 0;
+        bool stopping = false;
+
+        // 현재 작업
+        const std::function<void(uint32_t, uint32_t)>* job = nullptr;
+        uint32_t jobCount = 0;
+        uint32_t jobGrain = 1;
+        std::atomic<uint32_t> nextChunk{ 0 };
+    };
+
+}
@@ -0,0 +1,299 @@
+#include "BakedSoftbody.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Prism {
+
+    namespace {
+
+        constexpr uint64_t kSectionAlignment = 16;
+        constexpr size_t kSectionCount = static_cast<size_t>(BakedSection::Count);
+
+        struct SectionBytes {
+            const void* data;
+            uint64_t size;
+        };
+
+        template<typename T>
+        SectionBytes bytesOf(std::span<const T> s) {
+            return { s.data(), s.size_bytes() };
+        }
+
+        std::array<SectionBytes, kSectionCount> collectSections(const SoftbodyView& v) {
+            std::array<SectionBytes, kSectionCount> sections;
+            sections[size_t(BakedSection::PosInvMass)] = bytesOf(v.posInvMass);
+            sections[size_t(BakedSection::Velocity)] = bytesOf(v.velocity);
+            sections[size_t(BakedSection::PrevPos)] = bytesOf(v.prevPos);
+            sections[size_t(BakedSection::Color)] = bytesOf(v.color);
+            sections[size_t(BakedSection::OriginPos)] = bytesOf(v.originPos);
+            sections[size_t(BakedSection::Normal)] = bytesOf(v.normal);
+            sections[size_t(BakedSection::InvMass)] = bytesOf(v.invMass);
+            sections[size_t(BakedSection::IsFixed)] = bytesOf(v.isFixed);
+            sections[size_t(BakedSection::IsSurface)] = bytesOf(v.isSurface);
+            sections[size_t(BakedSection::Indices)] = bytesOf(v.indices);
+            sections[size_t(BakedSection::DistanceConstraints)] = bytesOf(v.distanceConstraints);
+            sections[size_t(BakedSection::VolumeConstraints)] = bytesOf(v.volumeConstraints);
+            sections[size_t(BakedSection::DistanceColorGroups)] = bytesOf(v.distanceColorGroups);
+            sections[size_t(BakedSection::VolumeColorGroups)] = bytesOf(v.volumeColorGroups);
+            return sections;
+        }
+
+        uint64_t alignUp(uint64_t value) {
+            return (value + kSectionAlignment - 1) / kSectionAlignment * kSectionAlignment;
+        }
+
+        template<typename T>
+        std::span<const T> sectionSpan(const std::byte* base, const BakedSoftbodyHeader& header, BakedSection section) {
+            const BakedSectionEntry& entry = header.sections[size_t(section)];
+            if (entry.size % sizeof(T) != 0) {
+                throw std::runtime_error("Baked softbody section has an invalid size!");
+            }
+            return { reinterpret_cast<const T*>(base + entry.offset), size_t(entry.size / sizeof(T)) };
+        }
+
+        void validateGroups(std::span<const ColorGroup> groups, size_t constraintCount) {
+            for (const ColorGroup& g : groups) {
+                if (uint64_t(g.offset) + g.count > constraintCount) {
+                    throw std::runtime_error("Baked softbody color group is out of range!");
+                }
+            }
+        }
+
+        // 제약 조건이 참조하는 파티클 인덱스가 범위 밖이면 솔버가 범위 밖 메모리를 읽고 씀
+        void validateParticleIndices(const SoftbodyView& v, size_t particleCount) {
+            auto outOfRange = [particleCount](uint32_t i) { return i >= particleCount; };
+            for (uint32_t i : v.indices) {
+                if (outOfRange(i)) throw std::runtime_error("Baked softbody index is out of range!");
+            }
+            for (const DistanceConstraint& c : v.distanceConstraints) {
+                if (outOfRange(c.p1) || outOfRange(c.p2)) {
+                    throw std::runtime_error("Baked softbody distance constraint is out of range!");
+                }
+            }
+            for (const VolumeConstraint& c : v.volumeConstraints) {
+                if (outOfRange(c.p1) || outOfRange(c.p2) || outOfRange(c.p3) || outOfRange(c.p4)) {
+                    throw std::runtime_error("Baked softbody volume constraint is out of range!");
+                }
+            }
+        }
+
+    }
+
+    void saveBakedSoftbody(const std::string& path, const Softbody& body, float stiffness) {
+        auto sections = collectSections(makeSoftbodyView(body));
+
+        BakedSoftbodyHeader header{};
+        header.magic = kBakedSoftbodyMagic;
+        header.version = kBakedSoftbodyVersion;
+        header.particleCount = static_cast<uint32_t>(body.particles.size());
+        header.sectionCount = static_cast<uint32_t>(kSectionCount);
+        header.stiffness = stiffness;
+
+        uint64_t offset = alignUp(sizeof(BakedSoftbodyHeader));
+        for (size_t i = 0; i < kSectionCount; i++) {
+            header.sections[i].offset = offset;
+            header.sections[i].size = sections[i].size;
+            offset = alignUp(offset + sections[i].size);
+        }
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open baked softbody file for writing: " + path);
+        }
+
+        static const char zeros[kSectionAlignment] = {};
+        auto padTo = [&](uint64_t target) {
+            uint64_t pos = static_cast<uint64_t>(file.tellp());
+            file.write(zeros, static_cast<std::streamsize>(target - pos));
+        };
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (size_t i = 0; i < kSectionCount; i++) {
+            padTo(header.sections[i].offset);
+            file.write(static_cast<const char*>(sections[i].data), static_cast<std::streamsize>(sections[i].size));
+        }
+        padTo(offset);
+
+        if (!file) {
+            throw std::runtime_error("Failed to write baked softbody file: " + path);
+        }
+    }
+
+    bool isBakedSoftbodyStale(const std::string& bakedPath, const std::string& meshBasePath) {
+        std::error_code ec;
+        auto bakedTime = std::filesystem::last_write_time(bakedPath, ec);
+        if (ec) return true;
+
+        for (const char* ext : { ".node", ".ele", ".edge", ".face" }) {
+            auto sourceTime = std::filesystem::last_write_time(meshBasePath + ext, ec);
+            if (!ec && sourceTime > bakedTime) return true;
+        }
+        return false;
+    }
+
+    BakedSoftbodyFile::BakedSoftbodyFile(const std::string& path) {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Failed to open baked softbody file: " + path);
+        }
+        fileHandle = file;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+            unmap();
+            throw std::runtime_error("Failed to read baked softbody file size: " + path);
+        }
+        mappedSize = static_cast<size_t>(size.QuadPart);
+
+        mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mappingHandle) {
+            unmap();
+            throw std::runtime_error("Failed to map baked softbody file: " + path);
+        }
+        mappedData = static_cast<const std::byte*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+        if (!mappedData) {
+            unmap();
+            throw std::runtime_error("Failed to map baked softbody file: " + path);
+        }
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Failed to open baked softbody file: " + path);
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            close(fd);
+            throw std::runtime_error("Failed to read baked softbody file size: " + path);
+        }
+        mappedSize = static_cast<size_t>(st.st_size);
+
+        void* data = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);  // 매핑은 fd 를 닫아도 유지됨
+        if (data == MAP_FAILED) {
+            mappedSize = 0;
+            throw std::runtime_error("Failed to map baked softbody file: " + path);
+        }
+        mappedData = static_cast<const std::byte*>(data);
+        // 로드 직후 전체를 스테이징 버퍼로 복사하므로 미리 읽어 둠
+        madvise(data, mappedSize, MADV_WILLNEED);
+#endif
+
+        try {
+            if (mappedSize < sizeof(BakedSoftbodyHeader)) {
+                throw std::runtime_error("Baked softbody file is truncated: " + path);
+            }
+
+            BakedSoftbodyHeader header;
+            std::memcpy(&header, mappedData, sizeof(header));
+            if (header.magic != kBakedSoftbodyMagic) {
+                throw std::runtime_error("Not a baked softbody file: " + path);
+            }
+            if (header.version != kBakedSoftbodyVersion || header.sectionCount != kSectionCount) {
+                throw std::runtime_error("Unsupported baked softbody version (re-bake the mesh): " + path);
+            }
+            for (const BakedSectionEntry& entry : header.sections) {
+                if (entry.offset % kSectionAlignment != 0 || entry.offset > mappedSize || entry.size > mappedSize - entry.offset) {
+                    throw std::runtime_error("Baked softbody section is out of range: " + path);
+                }
+            }
+
+            bakedStiffness = header.stiffness;
+
+            SoftbodyView& v = bodyView;
+            v.posInvMass = sectionSpan<glm::vec4>(mappedData, header, BakedSection::PosInvMass);
+            v.velocity = sectionSpan<glm::vec4>(mappedData, header, BakedSection::Velocity);
+            v.prevPos = sectionSpan<glm::vec4>(mappedData, header, BakedSection::PrevPos);
+            v.color = sectionSpan<glm::vec4>(mappedData, header, BakedSection::Color);
+            v.originPos = sectionSpan<glm::vec4>(mappedData, header, BakedSection::OriginPos);
+            v.normal = sectionSpan<glm::vec4>(mappedData, header, BakedSection::Normal);
+            v.invMass = sectionSpan<float>(mappedData, header, BakedSection::InvMass);
+            v.isFixed = sectionSpan<float>(mappedData, header, BakedSection::IsFixed);
+            v.isSurface = sectionSpan<float>(mappedData, header, BakedSection::IsSurface);
+            v.indices = sectionSpan<uint32_t>(mappedData, header, BakedSection::Indices);
+            v.distanceConstraints = sectionSpan<DistanceConstraint>(mappedData, header, BakedSection::DistanceConstraints);
+            v.volumeConstraints = sectionSpan<VolumeConstraint>(mappedData, header, BakedSection::VolumeConstraints);
+            v.distanceColorGroups = sectionSpan<ColorGroup>(mappedData, header, BakedSection::DistanceColorGroups);
+            v.volumeColorGroups = sectionSpan<ColorGroup>(mappedData, header, BakedSection::VolumeColorGroups);
+
+            const size_t n = header.particleCount;
+            bool streamsMatch = v.posInvMass.size() == n && v.velocity.size() == n && v.prevPos.size() == n
+                && v.color.size() == n && v.originPos.size() == n && v.normal.size() == n
+                && v.invMass.size() == n && v.isFixed.size() == n && v.isSurface.size() == n;
+            if (!streamsMatch) {
+                throw std::runtime_error("Baked softbody particle streams do not match the particle count: " + path);
+            }
+            validateGroups(v.distanceColorGroups, v.distanceConstraints.size());
+            validateGroups(v.volumeColorGroups, v.volumeConstraints.size());
+            validateParticleIndices(v, n);
+        }
+        catch (...) {
+            unmap();
+            throw;
+        }
+    }
+
+    BakedSoftbodyFile::~BakedSoftbodyFile() {
+        unmap();
+    }
+
+    void BakedSoftbodyFile::unmap() {
+#ifdef _WIN32
+        if (mappedData) UnmapViewOfFile(mappedData);
+        if (mappingHandle) CloseHandle(mappingHandle);
+        if (fileHandle) CloseHandle(fileHandle);
+        mappingHandle = nullptr;
+        fileHandle = nullptr;
+#else
+        if (mappedData) munmap(const_cast<std::byte*>(mappedData), mappedSize);
+#endif
+        mappedData = nullptr;
+        mappedSize = 0;
+        bodyView = {};
+    }
+
+    Softbody loadBakedSoftbody(const std::string& path) {
+        BakedSoftbodyFile file(path);
+        const SoftbodyView& v = file.view();
+
+        Softbody body;
+        body.particles.posInvMass.assign(v.posInvMass.begin(), v.posInvMass.end());
+        body.particles.velocity.assign(v.velocity.begin(), v.velocity.end());
+        body.particles.prevPos.assign(v.prevPos.begin(), v.prevPos.end());
+        body.particles.color.assign(v.color.begin(), v.color.end());
+        body.particles.originPos.assign(v.originPos.begin(), v.originPos.end());
+        body.particles.normal.assign(v.normal.begin(), v.normal.end());
+        body.particles.invMass.assign(v.invMass.begin(), v.invMass.end());
+        body.particles.isFixed.assign(v.isFixed.begin(), v.isFixed.end());
+        body.particles.isSurface.assign(v.isSurface.begin(), v.isSurface.end());
+        body.indices.assign(v.indices.begin(), v.indices.end());
+        body.distanceConstraints.assign(v.distanceConstraints.begin(), v.distanceConstraints.end());
+        body.volumeConstraints.assign(v.volumeConstraints.begin(), v.volumeConstraints.end());
+        body.distanceColorGroups.assign(v.distanceColorGroups.begin(), v.distanceColorGroups.end());
+        body.volumeColorGroups.assign(v.volumeColorGroups.begin(), v.volumeColorGroups.end());
+        return body;
+    }
+
+}
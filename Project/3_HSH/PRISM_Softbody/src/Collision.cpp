@@ -0,0 +1,361 @@
+#include "Collision.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+
+namespace Prism {
+
+    namespace {
+
+        constexpr uint32_t kGrainSize = 256;
+        constexpr float kMinDistance = 1e-6f;
+
+    }
+
+    glm::vec3 closestPointOnTriangle(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, glm::vec3& outBary) {
+        glm::vec3 ab = b - a;
+        glm::vec3 ac = c - a;
+        glm::vec3 ap = p - a;
+        float d1 = glm::dot(ab, ap);
+        float d2 = glm::dot(ac, ap);
+        if (d1 <= 0.0f && d2 <= 0.0f) { outBary = glm::vec3(1, 0, 0); return a; }
+
+        glm::vec3 bp = p - b;
+        float d3 = glm::dot(ab, bp);
+        float d4 = glm::dot(ac, bp);
+        if (d3 >= 0.0f && d4 <= d3) { outBary = glm::vec3(0, 1, 0); return b; }
+
+        float vc = d1 * d4 - d3 * d2;
+        if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+            float v = d1 / (d1 - d3);
+            outBary = glm::vec3(1.0f - v, v, 0.0f);
+            return a + v * ab;
+        }
+
+        glm::vec3 cp = p - c;
+        float d5 = glm::dot(ab, cp);
+        float d6 = glm::dot(ac, cp);
+        if (d6 >= 0.0f && d5 <= d6) { outBary = glm::vec3(0, 0, 1); return c; }
+
+        float vb = d5 * d2 - d1 * d6;
+        if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+            float w = d2 / (d2 - d6);
+            outBary = glm::vec3(1.0f - w, 0.0f, w);
+            return a + w * ac;
+        }
+
+        float va = d3 * d6 - d5 * d4;
+        if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+            float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+            outBary = glm::vec3(0.0f, 1.0f - w, w);
+            return b + w * (c - b);
+        }
+
+        float denom = 1.0f / (va + vb + vc);
+        float v = vb * denom;
+        float w = vc * denom;
+        outBary = glm::vec3(1.0f - v - w, v, w);
+        return a + ab * v + ac * w;
+    }
+
+    CollisionSystem::CollisionSystem(const SoftbodyView& body, std::span<const SoftbodyRange> bodies, const CollisionParams& params)
+        : collisionParams(params) {
+        const uint32_t particleCount = static_cast<uint32_t>(body.particleCount());
+        if (body.indices.size() % 3 != 0) {
+            throw std::runtime_error("Surface index count is not a multiple of 3!");
+        }
+
+        bodyIds.assign(particleCount, 0);
+        for (uint32_t b = 0; b < bodies.size(); b++) {
+            const SoftbodyRange& range = bodies[b];
+            if (uint64_t(range.particleOffset) + range.particleCount > particleCount) {
+                throw std::runtime_error("Softbody range is out of range!");
+            }
+            std::fill_n(bodyIds.begin() + range.particleOffset, range.particleCount, b);
+        }
+        restPos.assign(body.originPos.begin(), body.originPos.end());
+
+        // 표면 = 표면 삼각형이 참조하는 파티클
+        std::vector<uint8_t> isSurface(particleCount, 0);
+        for (uint32_t index : body.indices) {
+            if (index >= particleCount) {
+                throw std::runtime_error("Surface index is out of range!");
+            }
+            isSurface[index] = 1;
+        }
+        for (uint32_t i = 0; i < particleCount; i++) {
+            if (isSurface[i]) surfaceIds.push_back(i);
+        }
+        for (uint32_t i : surfaceIds) {
+            surfaceBodies.push_back(bodyIds[i]);
+        }
+        bodyShift.resize(std::max<size_t>(bodies.size(), 1));
+
+        contactDistance = params.thickness;
+        if (contactDistance <= 0.0f) {
+            double sum = 0.0;
+            for (const auto& c : body.distanceConstraints) sum += c.restLen;
+            contactDistance = body.distanceConstraints.empty() ? 0.01f : float(0.5 * sum / double(body.distanceConstraints.size()));
+        }
+        skin = 0.5f * contactDistance;      // 클수록 목록이 길고, 작을수록 재구성이 잦음
+        const float queryRadius = contactDistance + skin;
+
+        std::vector<float> triangleExtents;
+        if (params.particleTriangle) {
+            surfaceTriangles.reserve(body.indices.size() / 3);
+            for (size_t t = 0; t + 2 < body.indices.size(); t += 3) {
+                CollisionTriangle tri{ body.indices[t], body.indices[t + 1], body.indices[t + 2], bodyIds[body.indices[t]] };
+                surfaceTriangles.push_back(tri);
+
+                glm::vec3 a(restPos[tri.p0]), b(restPos[tri.p1]), c(restPos[tri.p2]);
+                glm::vec3 extent = glm::max(a, glm::max(b, c)) - glm::min(a, glm::min(b, c));
+                triangleExtents.push_back(std::max({ extent.x, extent.y, extent.z }));
+            }
+        }
+
+        // 셀 크기: 파티클 해시는 질의 상자(2 x 질의 반경)가 축마다 셀 2 개 이하가 되도록,
+        //          삼각형 해시는 보통 크기(중앙값) 삼각형의 넓힌 AABB 가 축마다 셀 3 개 정도가 되도록.
+        //          가장 큰 삼각형에 맞추면 셀이 커져 후보가 급격히 늘어남
+        float medianExtent = 0.0f;
+        if (!triangleExtents.empty()) {
+            auto mid = triangleExtents.begin() + triangleExtents.size() / 2;
+            std::nth_element(triangleExtents.begin(), mid, triangleExtents.end());
+            medianExtent = *mid;
+        }
+        particleHash.reset(2.0f * queryRadius, 2 * static_cast<uint32_t>(surfaceIds.size()) + 1);
+        triangleHash.reset((medianExtent + 2.0f * queryRadius) * 0.5f, 8 * static_cast<uint32_t>(surfaceTriangles.size()) + 1);
+
+        boxMin.resize(objectCount());
+        boxMax.resize(objectCount());
+        candidateStart.assign(surfaceIds.size() + 1, 0);
+        buildPos.resize(surfaceIds.size());
+        corrections.resize(surfaceIds.size());
+
+        // 휴지 상태 제외 목록 (한 번만, 직렬)
+        const uint32_t surfaceCount = static_cast<uint32_t>(surfaceIds.size());
+        computeBounds(restPos.data(), queryRadius, 0, objectCount());
+        buildHashes();
+        restExcludeStart.assign(surfaceCount + 1, 0);
+        for (uint32_t s = 0; s < surfaceCount; s++) {
+            const uint32_t bi = bodyIds[surfaceIds[s]];
+            size_t first = restExclude.size();
+            forEachNeighbor(restPos.data(), queryRadius, s, {}, [&](uint32_t o) {
+                uint32_t bo = o < surfaceCount ? bodyIds[surfaceIds[o]] : surfaceTriangles[o - surfaceCount].body;
+                if (bo == bi) restExclude.push_back(o);
+            });
+            std::sort(restExclude.begin() + first, restExclude.end());
+            restExcludeStart[s + 1] = static_cast<uint32_t>(restExclude.size());
+        }
+    }
+
+    void CollisionSystem::computeBounds(const glm::vec4* pos, float radius, uint32_t begin, uint32_t end) {
+        const uint32_t surfaceCount = static_cast<uint32_t>(surfaceIds.size());
+        for (uint32_t o = begin; o < end; o++) {
+            if (o < surfaceCount) {
+                boxMin[o] = boxMax[o] = pos[surfaceIds[o]];
+            }
+            else {
+                const CollisionTriangle& tri = surfaceTriangles[o - surfaceCount];
+                glm::vec4 a = pos[tri.p0], b = pos[tri.p1], c = pos[tri.p2];
+                boxMin[o] = glm::min(a, glm::min(b, c)) - glm::vec4(radius);
+                boxMax[o] = glm::max(a, glm::max(b, c)) + glm::vec4(radius);
+            }
+        }
+    }
+
+    void CollisionSystem::buildHashes() {
+        const size_t surfaceCount = surfaceIds.size();
+        particleHash.build(std::span(boxMin).first(surfaceCount), std::span(boxMax).first(surfaceCount));
+        triangleHash.build(std::span(boxMin).subspan(surfaceCount), std::span(boxMax).subspan(surfaceCount));
+    }
+
+    // 파티클은 자기 셀 하나에만 들어가므로 주변 셀(최대 2x2x2)을 훑고, 셀 좌표가 맞는 것만 처리 (버킷 충돌 중복 제거)
+    // 삼각형은 넓힌 AABB 가 겹치는 모든 셀에 들어가 있으므로 자기 셀 하나만 보면 됨 (AABB 는 같은 radius 로 만든 것).
+    // 단 축마다 kMaxCellsPerAxis 개를 넘게 덮는 삼각형은 셀이 아니라 oversized 버킷에만 있으므로 그것도 훑음
+    template<typename Fn>
+    void CollisionSystem::forEachNeighbor(const glm::vec4* pos, float radius, uint32_t s, std::span<const uint32_t> excluded, Fn&& fn) const {
+        const uint32_t surfaceCount = static_cast<uint32_t>(surfaceIds.size());
+        const uint32_t i = surfaceIds[s];
+        const glm::vec3 xi(pos[i]);
+        const uint32_t bi = bodyIds[i];
+        const bool selfCollision = collisionParams.selfCollision;
+
+        auto isExcluded = [&](uint32_t o) {
+            return !excluded.empty() && std::binary_search(excluded.begin(), excluded.end(), o);
+        };
+
+        glm::ivec3 cell, c0, c1;
+        particleHash.cellRange(xi - glm::vec3(radius), xi + glm::vec3(radius), c0, c1);
+        for (cell.z = c0.z; cell.z <= c1.z; cell.z++)
+            for (cell.y = c0.y; cell.y <= c1.y; cell.y++)
+                for (cell.x = c0.x; cell.x <= c1.x; cell.x++)
+                    particleHash.forEachInBucket(particleHash.hashCell(cell), [&](uint32_t o) {
+                        const uint32_t j = surfaceIds[o];
+                        if (j == i) return;
+                        if (bodyIds[j] == bi && !selfCollision) return;
+
+                        glm::vec3 dir = xi - glm::vec3(pos[j]);
+                        if (glm::dot(dir, dir) >= radius * radius) return;
+                        if (particleHash.cellCoord(glm::vec3(pos[j])) != cell) return;
+                        if (isExcluded(o)) return;
+                        fn(o);
+                    });
+
+        if (surfaceTriangles.empty()) return;
+        auto visitTriangle = [&](uint32_t t) {
+            const CollisionTriangle& tri = surfaceTriangles[t];
+            if (tri.p0 == i || tri.p1 == i || tri.p2 == i) return;
+            if (tri.body == bi && !selfCollision) return;
+            const uint32_t o = surfaceCount + t;
+            if (glm::any(glm::lessThan(xi, glm::vec3(boxMin[o]))) || glm::any(glm::greaterThan(xi, glm::vec3(boxMax[o])))) return;
+            if (isExcluded(o)) return;
+
+            glm::vec3 bary;
+            glm::vec3 q = closestPointOnTriangle(xi, glm::vec3(pos[tri.p0]), glm::vec3(pos[tri.p1]), glm::vec3(pos[tri.p2]), bary);
+            if (glm::dot(xi - q, xi - q) >= radius * radius) return;
+            fn(o);
+        };
+        triangleHash.forEachInBucket(triangleHash.hashCell(triangleHash.cellCoord(xi)), visitTriangle);
+        triangleHash.forEachInBucket(triangleHash.oversizedBucket(), visitTriangle);
+    }
+
+    // 쌍 (i, j) 의 거리 변화 <= |d_i - d_j|. d_i = T_b + r_i (T_b = body 의 평균 이동) 로 나누면
+    // 같은 body 쌍은 |r_i| + |r_j|, 다른 body 쌍은 |T_a - T_b| + |r_i| + |r_j| 이하 (삼각형은 꼭짓점 중 최대).
+    // 전체가 함께 떨어지거나 움직이는 동안(강체 이동)은 이 값이 거의 늘지 않으므로 재구성하지 않음
+    bool CollisionSystem::needsRebuild(const glm::vec4* pos) {
+        if (!candidatesValid) return true;
+
+        const size_t surfaceCount = surfaceIds.size();
+        std::fill(bodyShift.begin(), bodyShift.end(), glm::vec4(0.0f));
+        for (size_t s = 0; s < surfaceCount; s++) {
+            bodyShift[surfaceBodies[s]] += glm::vec4(glm::vec3(pos[surfaceIds[s]] - buildPos[s]), 1.0f);
+        }
+        for (glm::vec4& t : bodyShift) {
+            if (t.w > 0.0f) t /= t.w;
+        }
+
+        float maxLocal2 = 0.0f;
+        for (size_t s = 0; s < surfaceCount; s++) {
+            glm::vec3 local = glm::vec3(pos[surfaceIds[s]] - buildPos[s]) - glm::vec3(bodyShift[surfaceBodies[s]]);
+            maxLocal2 = std::max(maxLocal2, glm::dot(local, local));
+        }
+        float maxRelative2 = 0.0f;
+        for (size_t a = 0; a < bodyShift.size(); a++) {
+            for (size_t b = a + 1; b < bodyShift.size(); b++) {
+                glm::vec3 d(bodyShift[a] - bodyShift[b]);
+                maxRelative2 = std::max(maxRelative2, glm::dot(d, d));
+            }
+        }
+        return 2.0f * std::sqrt(maxLocal2) + std::sqrt(maxRelative2) >= skin;
+    }
+
+    void CollisionSystem::rebuildCandidates(const glm::vec4* pos, ThreadPool& pool) {
+        const uint32_t surfaceCount = static_cast<uint32_t>(surfaceIds.size());
+        const float radius = contactDistance + skin;
+
+        pool.parallelFor(objectCount(), kGrainSize, [&](uint32_t begin, uint32_t end) {
+            computeBounds(pos, radius, begin, end);
+        });
+        buildHashes();
+
+        // 청크별로 모은 뒤 개수의 prefix sum 으로 CSR 에 이어 붙임 (질의는 한 번만)
+        std::mutex chunkMutex;
+        std::vector<std::pair<uint32_t, std::vector<uint32_t>>> chunks;
+        pool.parallelFor(surfaceCount, kGrainSize, [&](uint32_t begin, uint32_t end) {
+            std::vector<uint32_t> local;
+            for (uint32_t s = begin; s < end; s++) {
+                const size_t first = local.size();
+                std::span<const uint32_t> excluded(restExclude.data() + restExcludeStart[s], restExcludeStart[s + 1] - restExcludeStart[s]);
+                forEachNeighbor(pos, radius, s, excluded, [&](uint32_t o) { local.push_back(o); });
+                candidateStart[s + 1] = static_cast<uint32_t>(local.size() - first);
+            }
+            std::lock_guard<std::mutex> lock(chunkMutex);
+            chunks.emplace_back(begin, std::move(local));
+        });
+
+        candidateStart[0] = 0;
+        for (uint32_t s = 0; s < surfaceCount; s++) {
+            candidateStart[s + 1] += candidateStart[s];
+        }
+        candidates.resize(candidateStart[surfaceCount]);
+        for (const auto& [begin, local] : chunks) {
+            std::copy(local.begin(), local.end(), candidates.begin() + candidateStart[begin]);
+        }
+
+        for (uint32_t s = 0; s < surfaceCount; s++) {
+            buildPos[s] = pos[surfaceIds[s]];
+        }
+        candidatesValid = true;
+        rebuilds++;
+    }
+
+    void CollisionSystem::solve(ParticleStore& particles, ThreadPool& pool) {
+        const glm::vec4* pos = particles.posInvMass.data();
+        const uint32_t surfaceCount = static_cast<uint32_t>(surfaceIds.size());
+        const float thickness = contactDistance;
+
+        if (needsRebuild(pos)) {
+            rebuildCandidates(pos, pool);
+        }
+
+        // 1) 표면 파티클마다 후보와의 접촉 보정량 수집
+        pool.parallelFor(surfaceCount, kGrainSize, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t s = begin; s < end; s++) {
+                const uint32_t i = surfaceIds[s];
+                const glm::vec3 xi(pos[i]);
+                const float wi = pos[i].w;
+                glm::vec3 delta(0.0f);
+                float contacts = 0.0f;
+
+                for (uint32_t k = candidateStart[s]; wi > 0.0f && k < candidateStart[s + 1]; k++) {
+                    const uint32_t o = candidates[k];
+                    if (o < surfaceCount) {
+                        const uint32_t j = surfaceIds[o];
+                        glm::vec3 dir = xi - glm::vec3(pos[j]);
+                        float d = glm::length(dir);
+                        if (d >= thickness || d < kMinDistance) continue;
+
+                        float wj = pos[j].w;
+                        delta += (thickness - d) * (wi / (wi + wj)) * (dir / d);
+                        contacts += 1.0f;
+                    }
+                    else {
+                        const CollisionTriangle& tri = surfaceTriangles[o - surfaceCount];
+                        const glm::vec4& a = pos[tri.p0];
+                        const glm::vec4& b = pos[tri.p1];
+                        const glm::vec4& c = pos[tri.p2];
+                        glm::vec3 bary;
+                        glm::vec3 q = closestPointOnTriangle(xi, glm::vec3(a), glm::vec3(b), glm::vec3(c), bary);
+                        glm::vec3 dir = xi - q;
+                        float d = glm::length(dir);
+                        if (d >= thickness || d < kMinDistance) continue;
+
+                        float wTri = bary.x * bary.x * a.w + bary.y * bary.y * b.w + bary.z * bary.z * c.w;
+                        delta += (thickness - d) * (wi / (wi + wTri)) * (dir / d);
+                        contacts += 1.0f;
+                    }
+                }
+                corrections[s] = glm::vec4(delta, contacts);
+            }
+        });
+
+        // 2) 평균 보정량 적용 (Jacobi)
+        std::atomic<uint32_t> contactCounter{ 0 };
+        pool.parallelFor(surfaceCount, kGrainSize, [&](uint32_t begin, uint32_t end) {
+            uint32_t localContacts = 0;
+            for (uint32_t s = begin; s < end; s++) {
+                const glm::vec4& c = corrections[s];
+                if (c.w > 0.0f) {
+                    particles.posInvMass[surfaceIds[s]] += glm::vec4(glm::vec3(c) / c.w, 0.0f);
+                    localContacts++;
+                }
+            }
+            contactCounter += localContacts;
+        });
+        lastContactCount = contactCounter.load();
+    }
+
+}
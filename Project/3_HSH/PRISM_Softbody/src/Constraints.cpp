@@ -0,0 +1,143 @@
+#include "Constraints.h"
+
+#include <stdexcept>
+
+namespace Prism {
+
+    bool generateDistanceConstraints(const std::vector<Particle>& particles, const std::vector<Edge>& edges, const float& stiffness, std::vector<DistanceConstraint>& outConstraints) {
+        for (const auto& edge : edges) {
+            DistanceConstraint dc{};
+            dc.p1 = edge.indices[0];
+            dc.p2 = edge.indices[1];
+            dc.restLen = glm::length(glm::vec3(particles[dc.p1].pos - particles[dc.p2].pos));
+            dc.compliance = dc.restLen / stiffness;
+            dc.lambda = 0.0f;
+            outConstraints.push_back(dc);
+        }
+        return true;
+    }
+
+    bool generateVolumeConstraints(const std::vector<Particle>& particles, const std::vector<Tetrahedron>& tetras, const float& stiffness, std::vector<VolumeConstraint>& outConstraints) {
+        for (const auto& tetra : tetras) {
+            VolumeConstraint vc{};
+            vc.p1 = tetra.indices[0];
+            vc.p2 = tetra.indices[1];
+            vc.p3 = tetra.indices[2];
+            vc.p4 = tetra.indices[3];
+            vc.restVol = glm::dot(glm::cross(glm::vec3(particles[vc.p2].pos - particles[vc.p1].pos),
+                glm::vec3(particles[vc.p3].pos - particles[vc.p1].pos)),
+                glm::vec3(particles[vc.p4].pos - particles[vc.p1].pos)) / 6.0f;
+            vc.compliance = vc.restVol / stiffness;
+            vc.lambda = 0.0f;
+            outConstraints.push_back(vc);
+        }
+        return true;
+    }
+
+    // 색상별 counting sort 로 재배치 + 그룹 테이블 구성
+    template<typename Constraint>
+    static void reorderByColor(const std::vector<Constraint>& constraints, const std::vector<uint32_t>& colors, uint32_t colorCount,
+                               std::vector<Constraint>& outConstraints, std::vector<ColorGroup>& outGroups) {
+        outGroups.assign(colorCount, ColorGroup{ 0, 0 });
+        for (uint32_t c : colors) {
+            outGroups[c].count++;
+        }
+
+        uint32_t currentOffset = 0;
+        for (auto& group : outGroups) {
+            group.offset = currentOffset;
+            currentOffset += group.count;
+        }
+
+        std::vector<uint32_t> cursor(colorCount);
+        for (uint32_t k = 0; k < colorCount; k++) {
+            cursor[k] = outGroups[k].offset;
+        }
+        outConstraints.resize(constraints.size());
+        for (size_t i = 0; i < constraints.size(); i++) {
+            outConstraints[cursor[colors[i]]++] = constraints[i];
+        }
+    }
+
+    // 1. 거리 제약 조건 컬러링
+    ColoredDistanceResult colorDistanceConstraints(const std::vector<DistanceConstraint>& constraints, uint32_t numParticles, const ColoringOptions& options) {
+        std::vector<uint32_t> particleIndices;
+        particleIndices.reserve(constraints.size() * 2);
+        for (const auto& c : constraints) {
+            particleIndices.push_back(c.p1);
+            particleIndices.push_back(c.p2);
+        }
+
+        ColoredDistanceResult result;
+        std::vector<uint32_t> colors = colorConstraintGraph(particleIndices, 2, numParticles, options, &result.stats);
+        reorderByColor(constraints, colors, result.stats.colorCount, result.reorderedConstraints, result.groups);
+        return result;
+    }
+
+    // 2. 부피 제약 조건 컬러링
+    ColoredVolumeResult colorVolumeConstraints(const std::vector<VolumeConstraint>& constraints, uint32_t numParticles, const ColoringOptions& options) {
+        std::vector<uint32_t> particleIndices;
+        particleIndices.reserve(constraints.size() * 4);
+        for (const auto& c : constraints) {
+            particleIndices.push_back(c.p1);
+            particleIndices.push_back(c.p2);
+            particleIndices.push_back(c.p3);
+            particleIndices.push_back(c.p4);
+        }
+
+        ColoredVolumeResult result;
+        std::vector<uint32_t> colors = colorConstraintGraph(particleIndices, 4, numParticles, options, &result.stats);
+        reorderByColor(constraints, colors, result.stats.colorCount, result.reorderedConstraints, result.groups);
+        return result;
+    }
+
+    SoftbodyView makeSoftbodyView(const Softbody& body) {
+        SoftbodyView v;
+        v.posInvMass = body.particles.posInvMass;
+        v.velocity = body.particles.velocity;
+        v.prevPos = body.particles.prevPos;
+        v.color = body.particles.color;
+        v.originPos = body.particles.originPos;
+        v.normal = body.particles.normal;
+        v.invMass = body.particles.invMass;
+        v.isFixed = body.particles.isFixed;
+        v.isSurface = body.particles.isSurface;
+        v.indices = body.indices;
+        v.distanceConstraints = body.distanceConstraints;
+        v.volumeConstraints = body.volumeConstraints;
+        v.distanceColorGroups = body.distanceColorGroups;
+        v.volumeColorGroups = body.volumeColorGroups;
+        return v;
+    }
+
+    Softbody buildSoftbody(const TetMesh& mesh, float stiffness, ThreadPool* pool, SoftbodyBuildStats* outStats) {
+        Softbody body;
+        body.particles = makeParticleStore(mesh.particles);
+        body.indices = mesh.indices;
+
+        if (!generateDistanceConstraints(mesh.particles, mesh.edges, stiffness, body.distanceConstraints)) {
+            throw std::runtime_error("Failed to generate distance constraints!");
+        }
+        if (!generateVolumeConstraints(mesh.particles, mesh.tetras, stiffness, body.volumeConstraints)) {
+            throw std::runtime_error("Failed to generate volume constraints!");
+        }
+
+        ColoringOptions options;
+        options.pool = pool;
+
+        auto distResult = colorDistanceConstraints(body.distanceConstraints, (uint32_t)body.particles.size(), options);
+        body.distanceConstraints = distResult.reorderedConstraints;
+        body.distanceColorGroups = distResult.groups;
+
+        auto volResult = colorVolumeConstraints(body.volumeConstraints, (uint32_t)body.particles.size(), options);
+        body.volumeConstraints = volResult.reorderedConstraints;
+        body.volumeColorGroups = volResult.groups;
+
+        if (outStats) {
+            outStats->distance = distResult.stats;
+            outStats->volume = volResult.stats;
+        }
+        return body;
+    }
+
+}
@@ -0,0 +1,83 @@
+#include "CpuSolver.h"
+#include "XPBDKernels.h"
+
+#include <cmath>
+
+namespace Prism {
+
+    CpuSolver::CpuSolver(Softbody body, ThreadPool& pool, const SolverParams& params)
+        : body(std::move(body)), pool(pool), solverParams(params) {
+    }
+
+    void CpuSolver::enableCollision(std::span<const SoftbodyRange> bodies, const CollisionParams& params) {
+        collisionSystem = std::make_unique<CollisionSystem>(makeSoftbodyView(body), bodies, params);
+    }
+
+    const char* CpuSolver::kernelName() {
+        return Kernels::simdName();
+    }
+
+    void CpuSolver::step() {
+        const float sdt = solverParams.dt / float(solverParams.subStepCnt);
+        const float dampingFactor = std::pow(solverParams.damping, 1.0f / float(solverParams.subStepCnt));
+
+        for (int s = 0; s < solverParams.subStepCnt; s++) {
+            predict(sdt, dampingFactor);
+
+            for (int iter = 0; iter < solverParams.iterations; iter++) {
+                solveDistance(sdt, iter == 0);
+                solveVolume(sdt, iter == 0);
+            }
+
+            if (collisionSystem) {
+                collisionSystem->solve(body.particles, pool);
+            }
+
+            update(sdt);
+        }
+
+        time += solverParams.dt;
+        frames++;
+    }
+
+    void CpuSolver::predict(float sdt, float dampingFactor) {
+        ParticleStore& particles = body.particles;
+        const glm::vec3 gravity = solverParams.gravity;
+        pool.parallelFor(static_cast<uint32_t>(body.particles.size()), solverParams.grainSize,
+            [&](uint32_t begin, uint32_t end) {
+                Kernels::predictRange(particles, begin, end, sdt, dampingFactor, gravity);
+            });
+    }
+
+    void CpuSolver::solveDistance(float sdt, bool resetLambda) {
+        glm::vec4* posInvMass = body.particles.posInvMass.data();
+        DistanceConstraint* constraints = body.distanceConstraints.data();
+        for (const auto& group : body.distanceColorGroups) {
+            pool.parallelFor(group.count, solverParams.grainSize,
+                [&](uint32_t begin, uint32_t end) {
+                    Kernels::solveDistanceRange(posInvMass, constraints, group.offset + begin, group.offset + end, sdt, resetLambda);
+                });
+        }
+    }
+
+    void CpuSolver::solveVolume(float sdt, bool resetLambda) {
+        glm::vec4* posInvMass = body.particles.posInvMass.data();
+        VolumeConstraint* constraints = body.volumeConstraints.data();
+        for (const auto& group : body.volumeColorGroups) {
+            pool.parallelFor(group.count, solverParams.grainSize,
+                [&](uint32_t begin, uint32_t end) {
+                    Kernels::solveVolumeRange(posInvMass, constraints, group.offset + begin, group.offset + end, sdt, resetLambda);
+                });
+        }
+    }
+
+    void CpuSolver::update(float sdt) {
+        ParticleStore& particles = body.particles;
+        const float groundY = solverParams.groundY;
+        pool.parallelFor(static_cast<uint32_t>(body.particles.size()), solverParams.grainSize,
+            [&](uint32_t begin, uint32_t end) {
+                Kernels::updateRange(particles, begin, end, sdt, groundY);
+            });
+    }
+
+}
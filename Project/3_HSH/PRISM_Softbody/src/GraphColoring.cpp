@@ -0,0 +1,229 @@
+#include "GraphColoring.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <functional>
+#include <numeric>
+#include <ostream>
+
+namespace Prism {
+
+    namespace {
+
+        constexpr uint32_t kGrainSize = 1024;
+        constexpr uint32_t kMaxRecolorPasses = 8;
+
+        void runParallel(ThreadPool* pool, uint32_t count, uint32_t grain, const std::function<void(uint32_t, uint32_t)>& fn) {
+            if (pool) {
+                pool->parallelFor(count, grain, fn);
+            }
+            else if (count > 0) {
+                fn(0, count);
+            }
+        }
+
+        // 파티클별 "이미 쓰인 색" 비트마스크 (파티클 -> 색상 인접 정보)
+        // 기존 greedy 의 색상별 std::vector<bool>(numParticles) 를 뒤집은 것. 제약 조건 하나의 first-fit 이
+        // 파티클 수(2 또는 4) x 워드 수 만큼의 OR 로 끝나고, 색을 새로 열 때마다 배열을 할당하지 않음
+        struct ColorMasks {
+            uint32_t words = 1;
+            std::vector<uint64_t> bits;
+
+            void reset(uint32_t numParticles, uint32_t colorCapacity) {
+                words = std::max(1u, (colorCapacity + 63) / 64);
+                bits.assign(size_t(numParticles) * words, 0);
+            }
+
+            void grow(uint32_t numParticles) {
+                std::vector<uint64_t> grown(size_t(numParticles) * words * 2, 0);
+                for (size_t p = 0; p < numParticles; p++) {
+                    std::copy_n(&bits[p * words], words, &grown[p * words * 2]);
+                }
+                bits.swap(grown);
+                words *= 2;
+            }
+
+            // 모든 워드가 꽉 차 있으면 words * 64 반환
+            uint32_t firstFree(const uint32_t* particles, uint32_t particleCount) const {
+                for (uint32_t w = 0; w < words; w++) {
+                    uint64_t used = 0;
+                    for (uint32_t k = 0; k < particleCount; k++) {
+                        used |= bits[size_t(particles[k]) * words + w];
+                    }
+                    if (~used != 0) return w * 64 + static_cast<uint32_t>(std::countr_zero(~used));
+                }
+                return words * 64;
+            }
+
+            void set(const uint32_t* particles, uint32_t particleCount, uint32_t color) {
+                for (uint32_t k = 0; k < particleCount; k++) {
+                    bits[size_t(particles[k]) * words + color / 64] |= 1ull << (color % 64);
+                }
+            }
+
+            void clear(const uint32_t* particles, uint32_t particleCount, uint32_t color) {
+                for (uint32_t k = 0; k < particleCount; k++) {
+                    bits[size_t(particles[k]) * words + color / 64] &= ~(1ull << (color % 64));
+                }
+            }
+        };
+
+        // 색이 부족하면 마스크를 늘려서라도 칠함
+        uint32_t assignFirstFree(ColorMasks& masks, uint32_t numParticles, const uint32_t* particles, uint32_t particleCount) {
+            uint32_t color = masks.firstFree(particles, particleCount);
+            while (color == masks.words * 64) {
+                masks.grow(numParticles);
+                color = masks.firstFree(particles, particleCount);
+            }
+            masks.set(particles, particleCount, color);
+            return color;
+        }
+
+        uint32_t countColors(const std::vector<uint32_t>& colors) {
+            uint32_t colorCount = 0;
+            for (uint32_t c : colors) colorCount = std::max(colorCount, c + 1);
+            return colorCount;
+        }
+
+    }
+
+    std::vector<uint32_t> colorConstraintGraph(const std::vector<uint32_t>& particleIndices, uint32_t particlesPerConstraint,
+                                               uint32_t numParticles, const ColoringOptions& options, ColoringStats* outStats) {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        const uint32_t count = static_cast<uint32_t>(particleIndices.size() / particlesPerConstraint);
+        auto constraintParticles = [&](uint32_t c) { return &particleIndices[size_t(c) * particlesPerConstraint]; };
+
+        std::vector<uint32_t> colors(count, 0);
+
+        // 1) first-fit (기존 greedy 와 같은 결과)
+        ColorMasks masks;
+        masks.reset(numParticles, 64);
+        for (uint32_t c = 0; c < count; c++) {
+            colors[c] = assignFirstFree(masks, numParticles, constraintParticles(c), particlesPerConstraint);
+        }
+
+        uint32_t colorCount = countColors(colors);
+        const uint32_t firstFitColors = colorCount;
+
+        // 같은 색상 그룹의 제약 조건 목록 (그룹 안은 인덱스 오름차순)
+        std::vector<uint32_t> members(count);
+        std::vector<uint32_t> memberOffsets;
+        auto buildMembers = [&]() {
+            memberOffsets.assign(colorCount + 1, 0);
+            for (uint32_t c : colors) memberOffsets[c + 1]++;
+            std::partial_sum(memberOffsets.begin(), memberOffsets.end(), memberOffsets.begin());
+            std::vector<uint32_t> cursor(memberOffsets.begin(), memberOffsets.end() - 1);
+            for (uint32_t c = 0; c < count; c++) members[cursor[colors[c]]++] = c;
+        };
+
+        // 2) 색 수 줄이기 (Culberson iterated greedy)
+        //    색상 그룹을 역순으로 돌며 first-fit 으로 다시 칠함. 같은 그룹 안의 제약 조건은 파티클을 공유하지 않으므로
+        //    그룹 하나를 통째로 병렬 처리해도 서로의 마스크를 건드리지 않고, 색 수는 절대 늘지 않음
+        uint32_t passes = 0;
+        std::vector<uint32_t> newColors(count);
+        while (passes < kMaxRecolorPasses && colorCount > 1) {
+            buildMembers();
+
+            masks.reset(numParticles, colorCount);
+            for (uint32_t k = colorCount; k-- > 0;) {
+                const uint32_t groupBegin = memberOffsets[k];
+                runParallel(options.pool, memberOffsets[k + 1] - groupBegin, kGrainSize, [&](uint32_t begin, uint32_t end) {
+                    for (uint32_t m = groupBegin + begin; m < groupBegin + end; m++) {
+                        uint32_t c = members[m];
+                        const uint32_t* particles = constraintParticles(c);
+                        uint32_t color = masks.firstFree(particles, particlesPerConstraint);
+                        masks.set(particles, particlesPerConstraint, color);
+                        newColors[c] = color;
+                    }
+                });
+            }
+
+            passes++;
+            uint32_t newColorCount = countColors(newColors);
+            colors.swap(newColors);
+            if (newColorCount >= colorCount) break;
+            colorCount = newColorCount;
+        }
+
+        std::vector<uint32_t> groupSizes(colorCount, 0);
+        for (uint32_t c : colors) groupSizes[c]++;
+
+        // 3) 균등화: 평균보다 큰 그룹의 제약 조건을, 파티클이 겹치지 않는 가장 작은 그룹으로 옮김 (색 수는 늘지 않음)
+        //    그룹 하나씩: 멤버별로 옮겨 갈 수 있는 색(마스크 OR)을 병렬로 구한 뒤, 순서대로 배정.
+        //    같은 그룹 멤버끼리는 파티클을 공유하지 않으므로 여러 개가 같은 그룹으로 옮겨가도 충돌 없음
+        if (options.balance && colorCount > 1) {
+            const uint32_t target = (count + colorCount - 1) / colorCount;
+            masks.reset(numParticles, colorCount);
+            for (uint32_t c = 0; c < count; c++) {
+                masks.set(constraintParticles(c), particlesPerConstraint, colors[c]);
+            }
+            buildMembers();
+
+            const uint32_t words = masks.words;
+            std::vector<uint64_t> freeColors;
+            for (uint32_t from = 0; from < colorCount; from++) {
+                if (groupSizes[from] <= target) continue;
+
+                const uint32_t groupBegin = memberOffsets[from];
+                const uint32_t groupCount = memberOffsets[from + 1] - groupBegin;
+                freeColors.assign(size_t(groupCount) * words, 0);
+                runParallel(options.pool, groupCount, kGrainSize, [&](uint32_t begin, uint32_t end) {
+                    for (uint32_t m = begin; m < end; m++) {
+                        const uint32_t* particles = constraintParticles(members[groupBegin + m]);
+                        for (uint32_t w = 0; w < words; w++) {
+                            uint64_t used = 0;
+                            for (uint32_t k = 0; k < particlesPerConstraint; k++) {
+                                used |= masks.bits[size_t(particles[k]) * words + w];
+                            }
+                            freeColors[size_t(m) * words + w] = ~used;
+                        }
+                    }
+                });
+
+                for (uint32_t m = 0; m < groupCount && groupSizes[from] > target; m++) {
+                    uint32_t best = from;
+                    for (uint32_t k = 0; k < colorCount; k++) {
+                        bool isFree = (freeColors[size_t(m) * words + k / 64] >> (k % 64)) & 1;
+                        if (isFree && groupSizes[k] < target && (best == from || groupSizes[k] < groupSizes[best])) {
+                            best = k;
+                        }
+                    }
+                    if (best != from) {
+                        uint32_t c = members[groupBegin + m];
+                        masks.clear(constraintParticles(c), particlesPerConstraint, from);
+                        masks.set(constraintParticles(c), particlesPerConstraint, best);
+                        groupSizes[from]--;
+                        groupSizes[best]++;
+                        colors[c] = best;
+                    }
+                }
+            }
+        }
+
+        if (outStats) {
+            ColoringStats stats;
+            stats.colorCount = colorCount;
+            stats.firstFitColors = firstFitColors;
+            stats.recolorPasses = passes;
+            if (colorCount > 0) {
+                stats.minGroupSize = *std::min_element(groupSizes.begin(), groupSizes.end());
+                stats.maxGroupSize = *std::max_element(groupSizes.begin(), groupSizes.end());
+                stats.imbalance = float(stats.maxGroupSize) / (float(count) / float(colorCount));
+            }
+            stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+            *outStats = stats;
+        }
+        return colors;
+    }
+
+    std::ostream& operator<<(std::ostream& os, const ColoringStats& stats) {
+        return os << stats.colorCount
+            << " (group " << stats.minGroupSize << "~" << stats.maxGroupSize
+            << ", imbalance " << stats.imbalance
+            << ", first-fit " << stats.firstFitColors << ", " << stats.recolorPasses << " passes, " << stats.milliseconds << " ms)";
+    }
+
+}
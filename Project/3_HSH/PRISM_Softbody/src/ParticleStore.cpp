@@ -0,0 +1,59 @@
+#include "ParticleStore.h"
+
+namespace Prism {
+
+    void ParticleStore::setFixed(uint32_t index, bool fixed) {
+        isFixed[index] = fixed ? 1.0f : 0.0f;
+        posInvMass[index].w = fixed ? 0.0f : invMass[index];
+    }
+
+    ParticleStore makeParticleStore(const std::vector<Particle>& particles) {
+        ParticleStore store;
+        const size_t count = particles.size();
+
+        store.posInvMass.resize(count);
+        store.velocity.resize(count);
+        store.prevPos.resize(count);
+        store.color.resize(count);
+        store.originPos.resize(count);
+        store.normal.resize(count);
+        store.invMass.resize(count);
+        store.isFixed.resize(count);
+        store.isSurface.resize(count);
+
+        for (size_t i = 0; i < count; i++) {
+            const Particle& p = particles[i];
+            float w = (p.isFixed > 0.5f) ? 0.0f : p.invMass;
+
+            store.posInvMass[i] = glm::vec4(glm::vec3(p.pos), w);
+            store.velocity[i] = p.vel;
+            store.prevPos[i] = p.prevPos;
+            store.color[i] = p.color;
+            store.originPos[i] = p.originPos;
+            store.normal[i] = p.normal;
+            store.invMass[i] = p.invMass;
+            store.isFixed[i] = p.isFixed;
+            store.isSurface[i] = p.isSurface;
+        }
+        return store;
+    }
+
+    std::vector<Particle> toParticles(const ParticleStore& store) {
+        std::vector<Particle> particles(store.size());
+        for (size_t i = 0; i < store.size(); i++) {
+            Particle& p = particles[i];
+            p.pos = glm::vec4(glm::vec3(store.posInvMass[i]), 1.0f);
+            p.color = store.color[i];
+            p.vel = store.velocity[i];
+            p.originPos = store.originPos[i];
+            p.prevPos = store.prevPos[i];
+            p.normal = store.normal[i];
+            p.invMass = store.invMass[i];
+            p.isFixed = store.isFixed[i];
+            p.isSurface = store.isSurface[i];
+            p.padding = 0.0f;
+        }
+        return particles;
+    }
+
+}
@@ -0,0 +1,132 @@
+#include "SoftbodyWorld.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Prism {
+
+    namespace {
+
+        DistanceConstraint offsetConstraint(DistanceConstraint c, uint32_t offset) {
+            c.p1 += offset;
+            c.p2 += offset;
+            return c;
+        }
+
+        VolumeConstraint offsetConstraint(VolumeConstraint c, uint32_t offset) {
+            c.p1 += offset;
+            c.p2 += offset;
+            c.p3 += offset;
+            c.p4 += offset;
+            return c;
+        }
+
+        // 색상 k 마다 모든 body 의 k 번째 그룹을 이어 붙임
+        template<typename Constraint>
+        void mergeColorGroups(std::span<const SoftbodyPlacement> placements, const std::vector<SoftbodyRange>& ranges,
+                              std::span<const Constraint> SoftbodyView::* constraintsOf,
+                              std::span<const ColorGroup> SoftbodyView::* groupsOf,
+                              std::vector<Constraint>& outConstraints, std::vector<ColorGroup>& outGroups) {
+            size_t totalConstraints = 0;
+            size_t colorCount = 0;
+            for (const auto& placement : placements) {
+                totalConstraints += (placement.body.*constraintsOf).size();
+                colorCount = std::max(colorCount, (placement.body.*groupsOf).size());
+            }
+
+            outConstraints.clear();
+            outConstraints.reserve(totalConstraints);
+            outGroups.assign(colorCount, ColorGroup{ 0, 0 });
+
+            for (size_t k = 0; k < colorCount; k++) {
+                outGroups[k].offset = static_cast<uint32_t>(outConstraints.size());
+                for (size_t b = 0; b < placements.size(); b++) {
+                    std::span<const ColorGroup> groups = placements[b].body.*groupsOf;
+                    if (k >= groups.size()) continue;
+
+                    std::span<const Constraint> constraints = placements[b].body.*constraintsOf;
+                    const ColorGroup& group = groups[k];
+                    if (size_t(group.offset) + group.count > constraints.size()) {
+                        throw std::runtime_error("Softbody color group is out of range!");
+                    }
+                    for (uint32_t i = group.offset; i < group.offset + group.count; i++) {
+                        outConstraints.push_back(offsetConstraint(constraints[i], ranges[b].particleOffset));
+                    }
+                }
+                outGroups[k].count = static_cast<uint32_t>(outConstraints.size()) - outGroups[k].offset;
+            }
+        }
+
+        template<typename T>
+        void append(std::vector<T>& dst, std::span<const T> src) {
+            dst.insert(dst.end(), src.begin(), src.end());
+        }
+
+        void appendTranslated(std::vector<glm::vec4>& dst, std::span<const glm::vec4> src, const glm::vec3& translation) {
+            for (const glm::vec4& v : src) {
+                dst.push_back(glm::vec4(glm::vec3(v) + translation, v.w));
+            }
+        }
+
+    }
+
+    SoftbodyWorld buildSoftbodyWorld(std::span<const SoftbodyPlacement> placements) {
+        SoftbodyWorld world;
+        world.bodies.reserve(placements.size());
+
+        size_t totalParticles = 0;
+        size_t totalIndices = 0;
+        for (const auto& placement : placements) {
+            totalParticles += placement.body.particleCount();
+            totalIndices += placement.body.indices.size();
+        }
+        if (totalParticles > UINT32_MAX || totalIndices > UINT32_MAX) {
+            throw std::runtime_error("Softbody world is too large for 32-bit indices!");
+        }
+
+        ParticleStore& particles = world.combined.particles;
+        particles.posInvMass.reserve(totalParticles);
+        particles.velocity.reserve(totalParticles);
+        particles.prevPos.reserve(totalParticles);
+        particles.color.reserve(totalParticles);
+        particles.originPos.reserve(totalParticles);
+        particles.normal.reserve(totalParticles);
+        particles.invMass.reserve(totalParticles);
+        particles.isFixed.reserve(totalParticles);
+        particles.isSurface.reserve(totalParticles);
+        world.combined.indices.reserve(totalIndices);
+
+        for (const auto& placement : placements) {
+            const SoftbodyView& body = placement.body;
+
+            SoftbodyRange range;
+            range.particleOffset = static_cast<uint32_t>(particles.size());
+            range.particleCount = static_cast<uint32_t>(body.particleCount());
+            range.indexOffset = static_cast<uint32_t>(world.combined.indices.size());
+            range.indexCount = static_cast<uint32_t>(body.indices.size());
+            world.bodies.push_back(range);
+
+            // 위치 계열만 이동 (color 는 원래 메쉬 좌표 기반 색을 유지)
+            appendTranslated(particles.posInvMass, body.posInvMass, placement.translation);
+            appendTranslated(particles.prevPos, body.prevPos, placement.translation);
+            appendTranslated(particles.originPos, body.originPos, placement.translation);
+            append(particles.velocity, body.velocity);
+            append(particles.color, body.color);
+            append(particles.normal, body.normal);
+            append(particles.invMass, body.invMass);
+            append(particles.isFixed, body.isFixed);
+            append(particles.isSurface, body.isSurface);
+
+            for (uint32_t index : body.indices) {
+                world.combined.indices.push_back(index + range.particleOffset);
+            }
+        }
+
+        mergeColorGroups(placements, world.bodies, &SoftbodyView::distanceConstraints, &SoftbodyView::distanceColorGroups,
+                         world.combined.distanceConstraints, world.combined.distanceColorGroups);
+        mergeColorGroups(placements, world.bodies, &SoftbodyView::volumeConstraints, &SoftbodyView::volumeColorGroups,
+                         world.combined.volumeConstraints, world.combined.volumeColorGroups);
+        return world;
+    }
+
+}
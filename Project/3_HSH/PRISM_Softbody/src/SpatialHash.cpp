@@ -0,0 +1,49 @@
+#include "SpatialHash.h"
+
+#include <algorithm>
+
+namespace Prism {
+
+    void SpatialHash::reset(float size, uint32_t buckets) {
+        cellSize = size;
+        invCellSize = 1.0f / size;
+        tableSize = std::max(1u, buckets);
+        cellStart.assign(size_t(tableSize) + 2, 0);
+    }
+
+    void SpatialHash::build(std::span<const glm::vec4> boxMin, std::span<const glm::vec4> boxMax) {
+        const uint32_t count = static_cast<uint32_t>(boxMin.size());
+
+        auto forEachCell = [&](uint32_t i, auto&& fn) {
+            glm::ivec3 c0, c1;
+            if (!cellRange(glm::vec3(boxMin[i]), glm::vec3(boxMax[i]), c0, c1)) {
+                fn(oversizedBucket());
+                return;
+            }
+            for (int z = c0.z; z <= c1.z; z++)
+                for (int y = c0.y; y <= c1.y; y++)
+                    for (int x = c0.x; x <= c1.x; x++)
+                        fn(hashCell(glm::ivec3(x, y, z)));
+        };
+
+        // 1) 버킷별 개수
+        std::fill(cellStart.begin(), cellStart.end(), 0u);
+        for (uint32_t i = 0; i < count; i++) {
+            forEachCell(i, [&](uint32_t h) { cellStart[h]++; });
+        }
+
+        // 2) inclusive prefix sum -> 각 버킷의 끝
+        uint32_t sum = 0;
+        for (size_t h = 0; h < cellStart.size(); h++) {
+            sum += cellStart[h];
+            cellStart[h] = sum;
+        }
+        cellEntries.resize(sum);
+
+        // 3) 뒤에서부터 채우면 cellStart[h] 가 버킷 시작으로 내려오고, 버킷 안은 인덱스 오름차순
+        for (uint32_t i = count; i-- > 0;) {
+            forEachCell(i, [&](uint32_t h) { cellEntries[--cellStart[h]] = i; });
+        }
+    }
+
+}
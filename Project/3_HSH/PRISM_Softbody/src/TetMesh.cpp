@@ -0,0 +1,223 @@
+#include "TetMesh.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace Prism {
+
+    static bool getValidLine(std::ifstream& file, std::string& line) {
+        while (std::getline(file, line)) {
+            if (line.empty()) continue;
+
+            size_t first = line.find_first_not_of(" \t\r\n");
+            if (first == std::string::npos) continue;
+            if (line[first] == '#') continue;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    bool parseNodeFile(const std::string& filename, std::vector<Particle>& outParticles, int& outStartIndex) {
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open NODE file: " << filename << std::endl;
+            return false;
+        }
+
+        std::string line;
+        if (!getValidLine(file, line)) return false;
+
+        // 헤더 파싱: [점의 개수] [차원] [속성 개수] [경계 마커 개수]
+        int numPoints, dim, numAttributes, numBoundaryMarkers;
+        std::istringstream headerSS(line);
+        headerSS >> numPoints >> dim >> numAttributes >> numBoundaryMarkers;
+
+        outParticles.reserve(numPoints);
+        bool isFirstNode = true;
+
+        for (int i = 0; i < numPoints; ++i) {
+            if (!getValidLine(file, line)) break;
+            std::istringstream iss(line);
+
+            int index;
+            Particle p{};
+            p.invMass = float(numPoints); // 기본 역질량 설정
+            p.isFixed = 0.0f;
+            p.isSurface = 0.0f;
+
+            iss >> index >> p.pos.x >> p.pos.y >> p.pos.z;
+
+            p.color = glm::vec4(p.pos.x, p.pos.y, p.pos.z, 1.0f);
+            p.vel = glm::vec4(0.0f);
+            p.originPos = p.pos;
+            p.prevPos = p.pos;
+
+            // 첫 번째 정점의 인덱스가 0인지 1인지 기록 (ele 파일 파싱 시 사용)
+            if (isFirstNode) {
+                outStartIndex = index;
+                isFirstNode = false;
+            }
+
+            outParticles.push_back(p);
+        }
+
+        std::cout << "Loaded " << outParticles.size() << " particles." << std::endl;
+        return true;
+    }
+
+    // .ele 파일 파싱
+    bool parseEleFile(const std::string& filename, int startIndex, std::vector<Tetrahedron>& outTetras) {
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open ELE file: " << filename << std::endl;
+            return false;
+        }
+
+        std::string line;
+        if (!getValidLine(file, line)) return false;
+
+        // 헤더 파싱: [사면체 개수] [정점 개수(보통 4)] [속성 개수]
+        int numTetras, nodesPerTetra, numAttributes;
+        std::istringstream headerSS(line);
+        headerSS >> numTetras >> nodesPerTetra >> numAttributes;
+
+        if (nodesPerTetra != 4) {
+            std::cerr << "Error: Not a tetrahedral mesh (nodes per element != 4)" << std::endl;
+            return false;
+        }
+
+        outTetras.reserve(numTetras);
+
+        for (int i = 0; i < numTetras; ++i) {
+            if (!getValidLine(file, line)) break;
+            std::istringstream ss(line);
+
+            int index;
+            Tetrahedron tet;
+
+            ss >> index >> tet.indices[0] >> tet.indices[1] >> tet.indices[2] >> tet.indices[3];
+
+            // 0-based 인덱싱으로 정규화 (Vulkan 배열 접근을 위해)
+            for (int j = 0; j < 4; ++j) {
+                tet.indices[j] -= startIndex;
+            }
+
+            outTetras.push_back(tet);
+        }
+
+        std::cout << "Loaded " << outTetras.size() << " tetrahedra." << std::endl;
+        return true;
+    }
+
+    // .edge 파일 파싱
+    bool parseEdgeFile(const std::string& filename, int startIndex, std::vector<Edge>& outEdges) {
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open EDGE file: " << filename << std::endl;
+            return false;
+        }
+
+        std::string line;
+        if (!getValidLine(file, line)) return false;
+
+        // 헤더 파싱: [사면체 개수] [정점 개수(보통 4)] [속성 개수]
+        int numEdges, boundaryMarker;
+        std::istringstream headerSS(line);
+        headerSS >> numEdges >> boundaryMarker;
+
+        outEdges.reserve(numEdges);
+
+        for (int i = 0; i < numEdges; ++i) {
+            if (!getValidLine(file, line)) break;
+            std::istringstream ss(line);
+
+            int index;
+            Edge edge;
+
+            ss >> index >> edge.indices[0] >> edge.indices[1] >> edge.marker;
+
+            // 0-based 인덱싱으로 정규화 (Vulkan 배열 접근을 위해)
+            for (int j = 0; j < 2; ++j) {
+                edge.indices[j] -= startIndex;
+            }
+
+            outEdges.push_back(edge);
+        }
+
+        std::cout << "Loaded " << outEdges.size() << " edges." << std::endl;
+        return true;
+    }
+
+    bool parseFaceFile(const std::string& filename, int startIndex, std::vector<Face>& outFaces) {
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open FACE file: " << filename << std::endl;
+            return false;
+        }
+
+        std::string line;
+        if (!getValidLine(file, line)) return false;
+
+        // 헤더 파싱: [사면체 개수] [정점 개수(보통 4)] [속성 개수]
+        int numEdges, boundaryMarker;
+        std::istringstream headerSS(line);
+        headerSS >> numEdges >> boundaryMarker;
+
+        outFaces.reserve(numEdges);
+
+        for (int i = 0; i < numEdges; ++i) {
+            if (!getValidLine(file, line)) break;
+            std::istringstream ss(line);
+
+            int index;
+            Face face;
+
+            ss >> index >> face.indices[0] >> face.indices[1] >> face.indices[2] >> face.marker;
+
+            // 0-based 인덱싱으로 정규화 (Vulkan 배열 접근을 위해)
+            for (int j = 0; j < 3; ++j) {
+                face.indices[j] -= startIndex;
+            }
+
+            outFaces.push_back(face);
+        }
+
+        std::cout << "Loaded " << outFaces.size() << " faces." << std::endl;
+        return true;
+    }
+
+    TetMesh loadTetMesh(const std::string& nodeFile, const std::string& eleFile,
+                        const std::string& edgeFile, const std::string& faceFile) {
+        TetMesh mesh;
+        int startIndex;
+        if (!parseNodeFile(nodeFile, mesh.particles, startIndex)) {
+            throw std::runtime_error("Failed to load node file!");
+        }
+        if (!parseEleFile(eleFile, startIndex, mesh.tetras)) {
+            throw std::runtime_error("Failed to load ele file!");
+        }
+        if (!parseEdgeFile(edgeFile, startIndex, mesh.edges)) {
+            throw std::runtime_error("Failed to load edge file!");
+        }
+        if (!parseFaceFile(faceFile, startIndex, mesh.faces)) {
+            throw std::runtime_error("Failed to load face file!");
+        }
+
+        mesh.indices.reserve(mesh.faces.size() * 3);
+        for (const auto& face : mesh.faces) {
+            mesh.indices.push_back(face.indices[0]);
+            mesh.indices.push_back(face.indices[1]);
+            mesh.indices.push_back(face.indices[2]);
+        }
+        return mesh;
+    }
+
+    TetMesh loadTetMesh(const std::string& basePath) {
+        return loadTetMesh(basePath + ".node", basePath + ".ele", basePath + ".edge", basePath + ".face");
+    }
+
+}
@@ -0,0 +1,86 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace Prism {
+
+    ThreadPool::ThreadPool(uint32_t threadCount) {
+        if (threadCount == 0) {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        workers.reserve(threadCount - 1);
+        for (uint32_t i = 1; i < threadCount; ++i) {
+            workers.emplace_back(&ThreadPool::workerLoop, this);
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeCv.notify_all();
+        for (auto& t : workers) {
+            t.join();
+        }
+    }
+
+    void ThreadPool::parallelFor(uint32_t count, uint32_t grain, const std::function<void(uint32_t, uint32_t)>& fn) {
+        if (count == 0) return;
+        grain = std::max(1u, grain);
+
+        // 청크가 하나뿐이거나 작업자가 없으면 깨우는 비용이 더 큼 -> 그냥 호출 스레드에서 실행
+        if (workers.empty() || count <= grain) {
+            fn(0, count);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = &fn;
+            jobCount = count;
+            jobGrain = grain;
+            nextChunk.store(0, std::memory_order_relaxed);
+            activeWorkers = static_cast<uint32_t>(workers.size());
+            ++generation;
+        }
+        wakeCv.notify_all();
+
+        runChunks();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        doneCv.wait(lock, [this] { return activeWorkers == 0; });
+        job = nullptr;
+    }
+
+    void ThreadPool::runChunks() {
+        while (true) {
+            uint32_t begin = nextChunk.fetch_add(jobGrain, std::memory_order_relaxed);
+            if (begin >= jobCount) break;
+            uint32_t end = std::min(jobCount, begin + jobGrain);
+            (*job)(begin, end);
+        }
+    }
+
+    void ThreadPool::workerLoop() {
+        uint64_t seenGeneration = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wakeCv.wait(lock, [&] { return stopping || generation != seenGeneration; });
+                if (stopping) return;
+                seenGeneration = generation;
+            }
+
+            runChunks();
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (--activeWorkers == 0) {
+                    doneCv.notify_one();
+                }
+            }
+        }
+    }
+
+}
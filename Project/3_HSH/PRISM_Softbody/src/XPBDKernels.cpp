@@ -0,0 +1,329 @@
+#include "XPBDKernels.h"
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PRISM_SOFTBODY_SSE 1
+#include <emmintrin.h>
+#else
+#define PRISM_SOFTBODY_SSE 0
+#endif
+
+namespace Prism::Kernels {
+
+    void predictRange(ParticleStore& particles, uint32_t begin, uint32_t end,
+                      float sdt, float dampingFactor, const glm::vec3& gravity) {
+        glm::vec4* posInvMass = particles.posInvMass.data();
+        const glm::vec4* velocity = particles.velocity.data();
+        glm::vec4* prevPos = particles.prevPos.data();
+
+        for (uint32_t i = begin; i < end; ++i) {
+            glm::vec4 current = posInvMass[i];
+            glm::vec3 p = glm::vec3(current);
+            glm::vec3 v = glm::vec3(velocity[i]);
+            prevPos[i] = glm::vec4(p, 1.0f);
+
+            // 감쇠된 속도는 위치 예측에만 쓰고 저장하지 않음 (Predict.comp 와 동일)
+            v *= dampingFactor;
+            if (current.w > 0.0f) {
+                p = p + v * sdt + gravity * sdt * sdt;
+            }
+            posInvMass[i] = glm::vec4(p, current.w);
+        }
+    }
+
+    void updateRange(ParticleStore& particles, uint32_t begin, uint32_t end,
+                     float sdt, float groundY) {
+        glm::vec4* posInvMass = particles.posInvMass.data();
+        glm::vec4* velocity = particles.velocity.data();
+        const glm::vec4* prevPos = particles.prevPos.data();
+
+        for (uint32_t i = begin; i < end; ++i) {
+            glm::vec3 p = glm::vec3(posInvMass[i]);
+            glm::vec3 prevP = glm::vec3(prevPos[i]);
+
+            // 바닥 충돌: 이전 위치로 되돌림
+            if (p.y < groundY) {
+                p = prevP;
+            }
+            glm::vec3 v = (p - prevP) / sdt;
+
+            posInvMass[i] = glm::vec4(p, posInvMass[i].w);
+            velocity[i] = glm::vec4(v, 0.0f);
+        }
+    }
+
+    // ---------------------------------------------------------------------
+    // 스칼라 버전 (SIMD 폭에 못 미치는 꼬리 + SSE 없는 플랫폼)
+    // ---------------------------------------------------------------------
+
+    // 고정점은 w == 0 이므로 변위도 0 (셰이더의 isFixed 검사와 같은 결과)
+    static void solveDistanceScalar(glm::vec4* posInvMass, DistanceConstraint& c, float sdt, bool resetLambda) {
+        if (resetLambda) {
+            c.lambda = 0.0f;
+        }
+
+        float w1 = posInvMass[c.p1].w;
+        float w2 = posInvMass[c.p2].w;
+        float w = w1 + w2;
+        if (w == 0.0f) return;
+
+        glm::vec3 x1 = glm::vec3(posInvMass[c.p1]);
+        glm::vec3 x2 = glm::vec3(posInvMass[c.p2]);
+        glm::vec3 dir = x1 - x2;
+        float currentLen = glm::length(dir);
+        if (currentLen < 0.0001f) return;
+        glm::vec3 n = dir / currentLen;
+
+        float C = currentLen - c.restLen;
+        float alpha_tilde = c.compliance / (sdt * sdt);
+        float dlambda = (-C - alpha_tilde * c.lambda) / (w + alpha_tilde);
+        c.lambda += dlambda;
+
+        posInvMass[c.p1] += glm::vec4(dlambda * w1 * n, 0.0f);
+        posInvMass[c.p2] += glm::vec4(-dlambda * w2 * n, 0.0f);
+    }
+
+    static void solveVolumeScalar(glm::vec4* posInvMass, VolumeConstraint& c, float sdt, bool resetLambda) {
+        if (resetLambda) {
+            c.lambda = 0.0f;
+        }
+
+        float w1 = posInvMass[c.p1].w;
+        float w2 = posInvMass[c.p2].w;
+        float w3 = posInvMass[c.p3].w;
+        float w4 = posInvMass[c.p4].w;
+        if (w1 + w2 + w3 + w4 < 0.5f) return;
+
+        glm::vec3 x1 = glm::vec3(posInvMass[c.p1]);
+        glm::vec3 x2 = glm::vec3(posInvMass[c.p2]);
+        glm::vec3 x3 = glm::vec3(posInvMass[c.p3]);
+        glm::vec3 x4 = glm::vec3(posInvMass[c.p4]);
+
+        glm::vec3 grad4 = glm::cross(x2 - x1, x3 - x1) / 6.0f;
+        glm::vec3 grad3 = glm::cross(x4 - x1, x2 - x1) / 6.0f;
+        glm::vec3 grad2 = glm::cross(x3 - x1, x4 - x1) / 6.0f;
+        glm::vec3 grad1 = -grad2 - grad3 - grad4;
+
+        float w = w1 * glm::dot(grad1, grad1) +
+                  w2 * glm::dot(grad2, grad2) +
+                  w3 * glm::dot(grad3, grad3) +
+                  w4 * glm::dot(grad4, grad4);
+        if (w < 0.0000001f) return;
+
+        float currentVol = glm::dot(glm::cross(x2 - x1, x3 - x1), x4 - x1) / 6.0f;
+        float C = currentVol - c.restVol;
+        float alpha_tilde = c.compliance / (sdt * sdt);
+        float dlambda = (-C - alpha_tilde * c.lambda) / (w + alpha_tilde);
+        c.lambda += dlambda;
+
+        posInvMass[c.p1] += glm::vec4(dlambda * w1 * grad1, 0.0f);
+        posInvMass[c.p2] += glm::vec4(dlambda * w2 * grad2, 0.0f);
+        posInvMass[c.p3] += glm::vec4(dlambda * w3 * grad3, 0.0f);
+        posInvMass[c.p4] += glm::vec4(dlambda * w4 * grad4, 0.0f);
+    }
+
+#if PRISM_SOFTBODY_SSE
+
+    // ---------------------------------------------------------------------
+    // SSE2 4-wide: 제약 조건 4개를 레인 하나씩 맡아 처리
+    // posInvMass 4개를 읽어 전치(transpose)하면 x/y/z/역질량 벡터가 한 번에 나오고,
+    // 결과 변위도 다시 전치해 각 파티클에 더함 (w 행은 0 이라 역질량은 그대로)
+    // ---------------------------------------------------------------------
+
+    struct Vec3x4 {
+        __m128 x, y, z;
+    };
+
+    static inline Vec3x4 sub(const Vec3x4& a, const Vec3x4& b) {
+        return { _mm_sub_ps(a.x, b.x), _mm_sub_ps(a.y, b.y), _mm_sub_ps(a.z, b.z) };
+    }
+
+    static inline Vec3x4 scale(const Vec3x4& a, __m128 s) {
+        return { _mm_mul_ps(a.x, s), _mm_mul_ps(a.y, s), _mm_mul_ps(a.z, s) };
+    }
+
+    static inline Vec3x4 divide(const Vec3x4& a, __m128 s) {
+        return { _mm_div_ps(a.x, s), _mm_div_ps(a.y, s), _mm_div_ps(a.z, s) };
+    }
+
+    static inline __m128 dot(const Vec3x4& a, const Vec3x4& b) {
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a.x, b.x), _mm_mul_ps(a.y, b.y)), _mm_mul_ps(a.z, b.z));
+    }
+
+    static inline Vec3x4 cross(const Vec3x4& a, const Vec3x4& b) {
+        return {
+            _mm_sub_ps(_mm_mul_ps(a.y, b.z), _mm_mul_ps(a.z, b.y)),
+            _mm_sub_ps(_mm_mul_ps(a.z, b.x), _mm_mul_ps(a.x, b.z)),
+            _mm_sub_ps(_mm_mul_ps(a.x, b.y), _mm_mul_ps(a.y, b.x))
+        };
+    }
+
+    struct Vec4x4 {
+        Vec3x4 xyz;
+        __m128 w;
+    };
+
+    static inline Vec4x4 gather(const glm::vec4* posInvMass, uint32_t i0, uint32_t i1, uint32_t i2, uint32_t i3) {
+        __m128 r0 = _mm_loadu_ps(&posInvMass[i0].x);
+        __m128 r1 = _mm_loadu_ps(&posInvMass[i1].x);
+        __m128 r2 = _mm_loadu_ps(&posInvMass[i2].x);
+        __m128 r3 = _mm_loadu_ps(&posInvMass[i3].x);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        return { { r0, r1, r2 }, r3 };
+    }
+
+    static inline void scatterAdd(glm::vec4* posInvMass, uint32_t i0, uint32_t i1, uint32_t i2, uint32_t i3, const Vec3x4& d) {
+        __m128 r0 = d.x;
+        __m128 r1 = d.y;
+        __m128 r2 = d.z;
+        __m128 r3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(&posInvMass[i0].x, _mm_add_ps(_mm_loadu_ps(&posInvMass[i0].x), r0));
+        _mm_storeu_ps(&posInvMass[i1].x, _mm_add_ps(_mm_loadu_ps(&posInvMass[i1].x), r1));
+        _mm_storeu_ps(&posInvMass[i2].x, _mm_add_ps(_mm_loadu_ps(&posInvMass[i2].x), r2));
+        _mm_storeu_ps(&posInvMass[i3].x, _mm_add_ps(_mm_loadu_ps(&posInvMass[i3].x), r3));
+    }
+
+    static inline __m128 loadLambda(bool resetLambda, float l0, float l1, float l2, float l3) {
+        return resetLambda ? _mm_setzero_ps() : _mm_set_ps(l3, l2, l1, l0);
+    }
+
+    static inline void storeLambda(__m128 lambda, float& l0, float& l1, float& l2, float& l3) {
+        alignas(16) float out[4];
+        _mm_store_ps(out, lambda);
+        l0 = out[0]; l1 = out[1]; l2 = out[2]; l3 = out[3];
+    }
+
+    void solveDistanceRange(glm::vec4* posInvMass, DistanceConstraint* constraints, uint32_t begin, uint32_t end,
+                            float sdt, bool resetLambda) {
+        const __m128 sdt2 = _mm_set1_ps(sdt * sdt);
+        const __m128 minLen = _mm_set1_ps(0.0001f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+
+        uint32_t i = begin;
+        for (; i + 4 <= end; i += 4) {
+            DistanceConstraint& c0 = constraints[i + 0];
+            DistanceConstraint& c1 = constraints[i + 1];
+            DistanceConstraint& c2 = constraints[i + 2];
+            DistanceConstraint& c3 = constraints[i + 3];
+
+            Vec4x4 x1 = gather(posInvMass, c0.p1, c1.p1, c2.p1, c3.p1);
+            Vec4x4 x2 = gather(posInvMass, c0.p2, c1.p2, c2.p2, c3.p2);
+            __m128 w = _mm_add_ps(x1.w, x2.w);
+
+            Vec3x4 dir = sub(x1.xyz, x2.xyz);
+            __m128 currentLen = _mm_sqrt_ps(dot(dir, dir));
+
+            // 스칼라 버전의 early return 두 개를 레인 마스크로 처리
+            __m128 valid = _mm_and_ps(_mm_cmpneq_ps(w, zero), _mm_cmpge_ps(currentLen, minLen));
+            __m128 safeLen = _mm_or_ps(_mm_and_ps(valid, currentLen), _mm_andnot_ps(valid, one));
+            Vec3x4 n = divide(dir, safeLen);
+
+            __m128 restLen = _mm_set_ps(c3.restLen, c2.restLen, c1.restLen, c0.restLen);
+            __m128 compliance = _mm_set_ps(c3.compliance, c2.compliance, c1.compliance, c0.compliance);
+            __m128 lambda = loadLambda(resetLambda, c0.lambda, c1.lambda, c2.lambda, c3.lambda);
+
+            __m128 C = _mm_sub_ps(currentLen, restLen);
+            __m128 alpha = _mm_div_ps(compliance, sdt2);
+            __m128 numer = _mm_sub_ps(_mm_sub_ps(zero, C), _mm_mul_ps(alpha, lambda));
+            __m128 dlambda = _mm_and_ps(valid, _mm_div_ps(numer, _mm_add_ps(w, alpha)));
+
+            storeLambda(_mm_add_ps(lambda, dlambda), c0.lambda, c1.lambda, c2.lambda, c3.lambda);
+
+            scatterAdd(posInvMass, c0.p1, c1.p1, c2.p1, c3.p1, scale(n, _mm_mul_ps(dlambda, x1.w)));
+            scatterAdd(posInvMass, c0.p2, c1.p2, c2.p2, c3.p2, scale(n, _mm_mul_ps(_mm_sub_ps(zero, dlambda), x2.w)));
+        }
+
+        for (; i < end; ++i) {
+            solveDistanceScalar(posInvMass, constraints[i], sdt, resetLambda);
+        }
+    }
+
+    void solveVolumeRange(glm::vec4* posInvMass, VolumeConstraint* constraints, uint32_t begin, uint32_t end,
+                          float sdt, bool resetLambda) {
+        const __m128 sdt2 = _mm_set1_ps(sdt * sdt);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 six = _mm_set1_ps(6.0f);
+        const __m128 minMass = _mm_set1_ps(0.5f);
+        const __m128 minW = _mm_set1_ps(0.0000001f);
+
+        uint32_t i = begin;
+        for (; i + 4 <= end; i += 4) {
+            VolumeConstraint& c0 = constraints[i + 0];
+            VolumeConstraint& c1 = constraints[i + 1];
+            VolumeConstraint& c2 = constraints[i + 2];
+            VolumeConstraint& c3 = constraints[i + 3];
+
+            Vec4x4 x1 = gather(posInvMass, c0.p1, c1.p1, c2.p1, c3.p1);
+            Vec4x4 x2 = gather(posInvMass, c0.p2, c1.p2, c2.p2, c3.p2);
+            Vec4x4 x3 = gather(posInvMass, c0.p3, c1.p3, c2.p3, c3.p3);
+            Vec4x4 x4 = gather(posInvMass, c0.p4, c1.p4, c2.p4, c3.p4);
+            __m128 massSum = _mm_add_ps(_mm_add_ps(x1.w, x2.w), _mm_add_ps(x3.w, x4.w));
+
+            Vec3x4 e21 = sub(x2.xyz, x1.xyz);
+            Vec3x4 e31 = sub(x3.xyz, x1.xyz);
+            Vec3x4 e41 = sub(x4.xyz, x1.xyz);
+
+            Vec3x4 cross23 = cross(e21, e31);
+            Vec3x4 grad4 = divide(cross23, six);
+            Vec3x4 grad3 = divide(cross(e41, e21), six);
+            Vec3x4 grad2 = divide(cross(e31, e41), six);
+            Vec3x4 grad1 = {
+                _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(zero, grad2.x), grad3.x), grad4.x),
+                _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(zero, grad2.y), grad3.y), grad4.y),
+                _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(zero, grad2.z), grad3.z), grad4.z)
+            };
+
+            __m128 w = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(x1.w, dot(grad1, grad1)), _mm_mul_ps(x2.w, dot(grad2, grad2))),
+                _mm_add_ps(_mm_mul_ps(x3.w, dot(grad3, grad3)), _mm_mul_ps(x4.w, dot(grad4, grad4))));
+
+            __m128 valid = _mm_and_ps(_mm_cmpge_ps(massSum, minMass), _mm_cmpge_ps(w, minW));
+
+            __m128 restVol = _mm_set_ps(c3.restVol, c2.restVol, c1.restVol, c0.restVol);
+            __m128 compliance = _mm_set_ps(c3.compliance, c2.compliance, c1.compliance, c0.compliance);
+            __m128 lambda = loadLambda(resetLambda, c0.lambda, c1.lambda, c2.lambda, c3.lambda);
+
+            __m128 C = _mm_sub_ps(_mm_div_ps(dot(cross23, e41), six), restVol);
+            __m128 alpha = _mm_div_ps(compliance, sdt2);
+            __m128 numer = _mm_sub_ps(_mm_sub_ps(zero, C), _mm_mul_ps(alpha, lambda));
+            __m128 dlambda = _mm_and_ps(valid, _mm_div_ps(numer, _mm_add_ps(w, alpha)));
+
+            storeLambda(_mm_add_ps(lambda, dlambda), c0.lambda, c1.lambda, c2.lambda, c3.lambda);
+
+            scatterAdd(posInvMass, c0.p1, c1.p1, c2.p1, c3.p1, scale(grad1, _mm_mul_ps(dlambda, x1.w)));
+            scatterAdd(posInvMass, c0.p2, c1.p2, c2.p2, c3.p2, scale(grad2, _mm_mul_ps(dlambda, x2.w)));
+            scatterAdd(posInvMass, c0.p3, c1.p3, c2.p3, c3.p3, scale(grad3, _mm_mul_ps(dlambda, x3.w)));
+            scatterAdd(posInvMass, c0.p4, c1.p4, c2.p4, c3.p4, scale(grad4, _mm_mul_ps(dlambda, x4.w)));
+        }
+
+        for (; i < end; ++i) {
+            solveVolumeScalar(posInvMass, constraints[i], sdt, resetLambda);
+        }
+    }
+
+    const char* simdName() { return "sse2"; }
+
+#else
+
+    void solveDistanceRange(glm::vec4* posInvMass, DistanceConstraint* constraints, uint32_t begin, uint32_t end,
+                            float sdt, bool resetLambda) {
+        for (uint32_t i = begin; i < end; ++i) {
+            solveDistanceScalar(posInvMass, constraints[i], sdt, resetLambda);
+        }
+    }
+
+    void solveVolumeRange(glm::vec4* posInvMass, VolumeConstraint* constraints, uint32_t begin, uint32_t end,
+                          float sdt, bool resetLambda) {
+        for (uint32_t i = begin; i < end; ++i) {
+            solveVolumeScalar(posInvMass, constraints[i], sdt, resetLambda);
+        }
+    }
+
+    const char* simdName() { return "scalar"; }
+
+#endif
+
+}
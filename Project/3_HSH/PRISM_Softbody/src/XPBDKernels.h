@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Constraints.h"
+
+#include <cstdint>
+
+// CpuSolver 내부용. 각 함수는 Predict/SolveDist/SolveVol/Update.comp 의 main() 한 번을
+// [begin, end) 범위에 대해 실행한 것과 같음
+// 솔브 커널은 ParticleStore::posInvMass 스트림만 건드림
+namespace Prism::Kernels {
+
+    void predictRange(ParticleStore& particles, uint32_t begin, uint32_t end,
+                      float sdt, float dampingFactor, const glm::vec3& gravity);
+
+    void updateRange(ParticleStore& particles, uint32_t begin, uint32_t end,
+                     float sdt, float groundY);
+
+    // 같은 색상 그룹 범위만 넘길 것 (레인끼리 파티클을 공유하지 않는다는 가정으로 scatter 함)
+    void solveDistanceRange(glm::vec4* posInvMass, DistanceConstraint* constraints, uint32_t begin, uint32_t end,
+                            float sdt, bool resetLambda);
+
+    void solveVolumeRange(glm::vec4* posInvMass, VolumeConstraint* constraints, uint32_t begin, uint32_t end,
+                          float sdt, bool resetLambda);
+
+    // 현재 빌드에서 사용하는 커널 이름 ("sse2" / "scalar")
+    const char* simdName();
+
+}
@@ -0,0 +1,185 @@
+// GPU 없이 XPBD 사면체 소프트바디를 N 프레임 돌리고 처리량(steps/sec)을 출력
+//
+// 사용법: PRISM_Softbody_Headless [--mesh models/bunny_1k.1] [--frames 600] [--threads 0]
+//                                 [--stiffness 1024] [--bodies 1] [--collision] [--dump out.txt]
+//   --threads 0 이면 hardware_concurrency
+//   --mesh    확장자 없는 TetGen 경로, 또는 PRISM_Softbody_Bake 로 구운 .prsb 파일
+//   --bodies  같은 메쉬를 XZ 격자로 N 개 배치해 한 월드로 합침 (색상당 dispatch 하나로 N 개 처리)
+//   --collision 표면 파티클/삼각형 충돌 (spatial hash) 켜기
+//   --dump    마지막 프레임의 파티클 위치를 텍스트로 저장 (GPU 결과와 비교용)
+
+#include "BakedSoftbody.h"
+#include "CpuSolver.h"
+#include "SoftbodyWorld.h"
+#include "TetMesh.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+    struct Options {
+        std::string mesh = "models/bunny_1k.1";
+        int frames = 600;
+        uint32_t threads = 0;
+        float stiffness = 1024.0f;
+        int bodies = 1;
+        bool collision = false;
+        std::string dumpPath;
+    };
+
+    void printUsage(const char* exe) {
+        std::cout << "Usage: " << exe
+            << " [--mesh <path without extension | file.prsb>] [--frames N] [--threads N] [--stiffness K] [--bodies N] [--collision] [--dump <file>]" << std::endl;
+    }
+
+    bool parseArgs(int argc, char** argv, Options& opt) {
+        for (int i = 1; i < argc; i++) {
+            const char* arg = argv[i];
+            bool hasValue = (i + 1 < argc);
+            if (std::strcmp(arg, "--mesh") == 0 && hasValue) opt.mesh = argv[++i];
+            else if (std::strcmp(arg, "--frames") == 0 && hasValue) opt.frames = std::atoi(argv[++i]);
+            else if (std::strcmp(arg, "--threads") == 0 && hasValue) opt.threads = static_cast<uint32_t>(std::atoi(argv[++i]));
+            else if (std::strcmp(arg, "--stiffness") == 0 && hasValue) opt.stiffness = static_cast<float>(std::atof(argv[++i]));
+            else if (std::strcmp(arg, "--bodies") == 0 && hasValue) opt.bodies = std::atoi(argv[++i]);
+            else if (std::strcmp(arg, "--collision") == 0) opt.collision = true;
+            else if (std::strcmp(arg, "--dump") == 0 && hasValue) opt.dumpPath = argv[++i];
+            else return false;
+        }
+        return opt.frames > 0 && opt.stiffness > 0.0f && opt.bodies > 0;
+    }
+
+    // 메쉬 크기의 1.5 배 간격으로 XZ 격자에 배치
+    Prism::SoftbodyWorld replicate(const Prism::Softbody& body, int count) {
+        glm::vec3 lo(std::numeric_limits<float>::max());
+        glm::vec3 hi(std::numeric_limits<float>::lowest());
+        for (const auto& p : body.particles.posInvMass) {
+            lo = glm::min(lo, glm::vec3(p));
+            hi = glm::max(hi, glm::vec3(p));
+        }
+        const glm::vec3 spacing = (hi - lo) * 1.5f;
+        const int side = static_cast<int>(std::ceil(std::sqrt(float(count))));
+
+        std::vector<Prism::SoftbodyPlacement> placements(count);
+        const Prism::SoftbodyView view = Prism::makeSoftbodyView(body);
+        for (int i = 0; i < count; i++) {
+            placements[i].body = view;
+            placements[i].translation = glm::vec3(float(i % side) * spacing.x, 0.0f, float(i / side) * spacing.z);
+        }
+        return Prism::buildSoftbodyWorld(placements);
+    }
+
+    void dumpPositions(const std::string& path, const Prism::ParticleStore& particles) {
+        std::ofstream out(path);
+        if (!out.is_open()) {
+            throw std::runtime_error("Failed to open dump file!");
+        }
+        out << std::setprecision(9);
+        for (const auto& p : particles.posInvMass) {
+            out << p.x << " " << p.y << " " << p.z << "\n";
+        }
+    }
+
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    try {
+        Prism::ThreadPool pool(opt.threads);
+
+        auto loadStart = std::chrono::high_resolution_clock::now();
+        Prism::Softbody body;
+        if (opt.mesh.ends_with(".prsb")) {
+            body = Prism::loadBakedSoftbody(opt.mesh);
+        }
+        else {
+            Prism::TetMesh mesh = Prism::loadTetMesh(opt.mesh);
+            Prism::SoftbodyBuildStats buildStats;
+            body = Prism::buildSoftbody(mesh, opt.stiffness, &pool, &buildStats);
+            std::cout << "[PRISM] Distance colors: " << buildStats.distance << std::endl;
+            std::cout << "[PRISM] Volume colors: " << buildStats.volume << std::endl;
+        }
+        std::vector<Prism::SoftbodyRange> bodyRanges;
+        if (opt.bodies > 1) {
+            Prism::SoftbodyWorld world = replicate(body, opt.bodies);
+            body = std::move(world.combined);
+            bodyRanges = std::move(world.bodies);
+        }
+        auto loadEnd = std::chrono::high_resolution_clock::now();
+
+        std::cout << "[PRISM] Mesh: " << opt.mesh
+            << " (particles " << body.particles.size()
+            << ", dist " << body.distanceConstraints.size()
+            << ", vol " << body.volumeConstraints.size()
+            << ", bodies " << opt.bodies
+            << ", colors " << body.distanceColorGroups.size() << "/" << body.volumeColorGroups.size() << ")" << std::endl;
+        std::cout << "[PRISM] Setup: "
+            << std::chrono::duration<double, std::milli>(loadEnd - loadStart).count() << " ms" << std::endl;
+
+        Prism::SolverParams params;
+        Prism::CpuSolver solver(std::move(body), pool, params);
+        if (opt.collision) {
+            solver.enableCollision(bodyRanges);
+            std::cout << "[PRISM] Collision: thickness " << solver.collision()->thickness()
+                << ", cell " << solver.collision()->particleGrid().getCellSize() << "/" << solver.collision()->triangleGrid().getCellSize()
+                << ", surface particles " << solver.collision()->surfaceParticles().size()
+                << ", triangles " << solver.collision()->triangles().size() << std::endl;
+        }
+
+        std::cout << "[PRISM] Threads: " << pool.threadCount()
+            << ", kernel: " << Prism::CpuSolver::kernelName()
+            << ", substeps: " << params.subStepCnt
+            << ", iterations: " << params.iterations << std::endl;
+
+        auto simStart = std::chrono::high_resolution_clock::now();
+        for (int frame = 0; frame < opt.frames; frame++) {
+            solver.step();
+        }
+        auto simEnd = std::chrono::high_resolution_clock::now();
+
+        double seconds = std::chrono::duration<double>(simEnd - simStart).count();
+        double stepsPerSec = opt.frames / seconds;
+
+        glm::vec3 centroid(0.0f);
+        for (const auto& p : solver.particles().posInvMass) {
+            centroid += glm::vec3(p);
+        }
+        centroid /= float(solver.particles().size());
+
+        std::cout << std::fixed << std::setprecision(2)
+            << "[PRISM] " << opt.frames << " frames in " << seconds * 1000.0 << " ms -> "
+            << stepsPerSec << " steps/sec (" << stepsPerSec * params.subStepCnt << " substeps/sec)" << std::endl;
+        std::cout << std::setprecision(5)
+            << "[PRISM] Centroid: (" << centroid.x << ", " << centroid.y << ", " << centroid.z << ")" << std::endl;
+        if (solver.collision()) {
+            std::cout << "[PRISM] Collision: " << solver.collision()->rebuildCount() << " rebuilds, "
+                << solver.collision()->contactCount() << " contacts in last substep" << std::endl;
+        }
+
+        if (!opt.dumpPath.empty()) {
+            dumpPositions(opt.dumpPath, solver.particles());
+            std::cout << "[PRISM] Positions written to " << opt.dumpPath << std::endl;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -18,9 +18,17 @@
 #include <cstdint>
 #include <limits>
 #include <array>
+#include <memory>
 #include <optional>
 #include <set>
 
+#include "TetMesh.h"
+#include "Constraints.h"
+#include "ParticleStore.h"
+#include "BakedSoftbody.h"
+#include "SoftbodyWorld.h"
+#include "Collision.h"
+
 const uint32_t WIDTH = 800;
 const uint32_t HEIGHT = 600;
 
@@ -88,385 +96,73 @@ struct MeshPushConstants {
     float padding[2];
 };
 
-
-struct Particle {
-    glm::vec4 pos;
-    glm::vec4 color;
-
-    glm::vec4 vel;
-    glm::vec4 originPos;
-    glm::vec4 prevPos;
-    glm::vec4 normal;
-    float invMass;
-    float isFixed;
-    float isSurface;
-    float padding;
-
-    static VkVertexInputBindingDescription getBindingDescription() {
-        VkVertexInputBindingDescription bindingDescription{};
-        bindingDescription.binding = 0;
-        bindingDescription.stride = sizeof(Particle);
-        bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-
-        return bindingDescription;
-    }
-
-    static std::array<VkVertexInputAttributeDescription, 2> getAttributeDescriptions() {
-        std::array<VkVertexInputAttributeDescription, 2> attributeDescriptions{};
-
-        attributeDescriptions[0].binding = 0;
-        attributeDescriptions[0].location = 0;
-        attributeDescriptions[0].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-        attributeDescriptions[0].offset = offsetof(Particle, pos);
-
-        attributeDescriptions[1].binding = 0;
-        attributeDescriptions[1].location = 1;
-        attributeDescriptions[1].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-        attributeDescriptions[1].offset = offsetof(Particle, color);
-
-        return attributeDescriptions;
-    }
-};
-
-struct Edge {
-    uint32_t indices[2];
-    int32_t marker;
-    int32_t padding;
-};
-
-struct Tetrahedron {
-    uint32_t indices[4];
-};
-
-struct Face {
-    uint32_t indices[3];
-    int32_t marker;
+// Collision*.comp . ؽ ̺  (ƼŬ, ﰢ) ﰢ oversized Ŷ ϳ Ŷ 迭 ϳ ̾ 
+struct CollisionPushConstants {
+    float thickness;
+    float particleInvCellSize;
+    float triangleInvCellSize;
+    uint32_t surfaceCount;
+    uint32_t triangleCount;
+    uint32_t particleTableSize;
+    uint32_t triangleTableSize;
+    uint32_t entryCapacity;
+    uint32_t selfCollision;
+    uint32_t padding[3];
 };
 
-struct DistanceConstraint {
-    uint32_t p1, p2;
-    float restLen;
-    float compliance;
-    float lambda;
-    float padding[3];
+// Collision*.comp ε ȣ (0  posInvMass  ,  collisionBuffers ε)
+enum CollisionBinding : uint32_t {
+    CollisionPositions = 0,
+    CollisionSurfaceParticles,
+    CollisionTriangles,
+    CollisionParticleBodies,
+    CollisionRestExcludeStart,
+    CollisionRestExclude,
+    CollisionBoxes,
+    CollisionCellStart,
+    CollisionCellCursor,
+    CollisionCellEntries,
+    CollisionCorrections,
+    CollisionBindingCount
 };
 
-struct VolumeConstraint {
-    uint32_t p1, p2, p3, p4;
-    float restVol;
-    float compliance;
-    float lambda;
-    float padding;
-};
-
-bool getValidLine(std::ifstream& file, std::string& line) {
-    while (std::getline(file, line)) {
-        if (line.empty()) continue;
-
-        size_t first = line.find_first_not_of(" \t\r\n");
-        if (first == std::string::npos) continue;
-        if (line[first] == '#') continue;
-
-        return true;
-    }
-
-    return false;
-}
-
-bool parseNodeFile(const std::string& filename, std::vector<Particle>& outParticles, int& outStartIndex) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open NODE file: " << filename << std::endl;
-        return false;
-    }
-
-    std::string line;
-    if (!getValidLine(file, line)) return false;
 
-    //  Ľ: [ ] [] [Ӽ ] [ Ŀ ]
-    int numPoints, dim, numAttributes, numBoundaryMarkers;
-    std::istringstream headerSS(line);
-    headerSS >> numPoints >> dim >> numAttributes >> numBoundaryMarkers;
+// ƼŬ/  ü .node/.ele/.edge/.face ļ, ׷ ÷ PRISM_Softbody ̺귯 ̵
+// (CPU ֹ ̾ƿ )
+using Prism::DistanceConstraint;
+using Prism::VolumeConstraint;
+using Prism::ColorGroup;
 
-    outParticles.reserve(numPoints);
-    bool isFirstNode = true;
+// ؽ Է SoA Ʈ  : binding 0 = posInvMass (ùķ̼ ), binding 1 = color ( )
+static std::array<VkVertexInputBindingDescription, 2> getParticleBindingDescriptions() {
+    std::array<VkVertexInputBindingDescription, 2> bindingDescriptions{};
+    bindingDescriptions[0].binding = 0;
+    bindingDescriptions[0].stride = sizeof(glm::vec4);
+    bindingDescriptions[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
 
-    for (int i = 0; i < numPoints; ++i) {
-        if (!getValidLine(file, line)) break;
-        std::istringstream iss(line);
+    bindingDescriptions[1].binding = 1;
+    bindingDescriptions[1].stride = sizeof(glm::vec4);
+    bindingDescriptions[1].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
 
-        int index;
-        Particle p;
-        p.invMass = float(numPoints); // ⺻  
-        p.isFixed = 0.0f;
-        p.isSurface = 0.0f;
-
-        iss >> index >> p.pos.x >> p.pos.y >> p.pos.z;
-
-        p.color = glm::vec4(p.pos.x, p.pos.y, p.pos.z, 1.0f);
-        p.vel = glm::vec4(0.0f);
-        p.originPos = p.pos;
-        p.prevPos = p.pos;
-
-        // ù °  ε 0 1  (ele  Ľ  )
-        if (isFirstNode) {
-            outStartIndex = index;
-            isFirstNode = false;
-        }
-
-        outParticles.push_back(p);
-    }
-
-    std::cout << "Loaded " << outParticles.size() << " particles." << std::endl;
-    return true;
+    return bindingDescriptions;
 }
 
-// .ele  Ľ
-bool parseEleFile(const std::string& filename, int startIndex, std::vector<Tetrahedron>& outTetras) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open ELE file: " << filename << std::endl;
-        return false;
-    }
-
-    std::string line;
-    if (!getValidLine(file, line)) return false;
-
-    //  Ľ: [ü ] [ ( 4)] [Ӽ ]
-    int numTetras, nodesPerTetra, numAttributes;
-    std::istringstream headerSS(line);
-    headerSS >> numTetras >> nodesPerTetra >> numAttributes;
-
-    if (nodesPerTetra != 4) {
-        std::cerr << "Error: Not a tetrahedral mesh (nodes per element != 4)" << std::endl;
-        return false;
-    }
-
-    outTetras.reserve(numTetras);
-
-    for (int i = 0; i < numTetras; ++i) {
-        if (!getValidLine(file, line)) break;
-        std::istringstream ss(line);
+static std::array<VkVertexInputAttributeDescription, 2> getParticleAttributeDescriptions() {
+    std::array<VkVertexInputAttributeDescription, 2> attributeDescriptions{};
 
-        int index;
-        Tetrahedron tet;
+    attributeDescriptions[0].binding = 0;
+    attributeDescriptions[0].location = 0;
+    attributeDescriptions[0].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+    attributeDescriptions[0].offset = 0;
 
-        ss >> index >> tet.indices[0] >> tet.indices[1] >> tet.indices[2] >> tet.indices[3];
+    attributeDescriptions[1].binding = 1;
+    attributeDescriptions[1].location = 1;
+    attributeDescriptions[1].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+    attributeDescriptions[1].offset = 0;
 
-        // 0-based ε ȭ (Vulkan 迭  )
-        for (int j = 0; j < 4; ++j) {
-            tet.indices[j] -= startIndex;
-        }
-
-        outTetras.push_back(tet);
-    }
-
-    std::cout << "Loaded " << outTetras.size() << " tetrahedra." << std::endl;
-    return true;
+    return attributeDescriptions;
 }
 
-// .edge  Ľ
-bool parseEdgeFile(const std::string& filename, int startIndex, std::vector<Edge>& outEdges) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open EDGE file: " << filename << std::endl;
-        return false;
-    }
-
-    std::string line;
-    if (!getValidLine(file, line)) return false;
-
-    //  Ľ: [ü ] [ ( 4)] [Ӽ ]
-    int numEdges, boundaryMarker;
-    std::istringstream headerSS(line);
-    headerSS >> numEdges >> boundaryMarker;
-
-    outEdges.reserve(numEdges);
-
-    for (int i = 0; i < numEdges; ++i) {
-        if (!getValidLine(file, line)) break;
-        std::istringstream ss(line);
-
-        int index;
-        Edge edge;
-
-        ss >> index >> edge.indices[0] >> edge.indices[1] >> edge.marker;
-
-        // 0-based ε ȭ (Vulkan 迭  )
-        for (int j = 0; j < 2; ++j) {
-            edge.indices[j] -= startIndex;
-        }
-
-        outEdges.push_back(edge);
-    }
-
-    std::cout << "Loaded " << outEdges.size() << " edges." << std::endl;
-    return true;
-}
-
-bool parseFaceFile(const std::string& filename, int startIndex, std::vector<Face>& outFaces) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open FACE file: " << filename << std::endl;
-        return false;
-    }
-
-    std::string line;
-    if (!getValidLine(file, line)) return false;
-
-    //  Ľ: [ü ] [ ( 4)] [Ӽ ]
-    int numEdges, boundaryMarker;
-    std::istringstream headerSS(line);
-    headerSS >> numEdges >> boundaryMarker;
-
-    outFaces.reserve(numEdges);
-
-    for (int i = 0; i < numEdges; ++i) {
-        if (!getValidLine(file, line)) break;
-        std::istringstream ss(line);
-
-        int index;
-        Face face;
-
-        ss >> index >> face.indices[0] >> face.indices[1] >> face.indices[2] >> face.marker;
-
-        // 0-based ε ȭ (Vulkan 迭  )
-        for (int j = 0; j < 3; ++j) {
-            face.indices[j] -= startIndex;
-        }
-
-        outFaces.push_back(face);
-    }
-
-    std::cout << "Loaded " << outFaces.size() << " faces." << std::endl;
-    return true;
-}
-
-bool generateDistanceConstraints(const std::vector<Particle>& particles, const std::vector<Edge>& edges, const float& stiffness, std::vector<DistanceConstraint>& outConstraints) {
-    for (const auto& edge : edges) {
-        DistanceConstraint dc{};
-        dc.p1 = edge.indices[0];
-        dc.p2 = edge.indices[1];
-        dc.restLen = glm::length(glm::vec3(particles[dc.p1].pos - particles[dc.p2].pos));
-        dc.compliance = dc.restLen / stiffness;
-        dc.lambda = 0.0f;
-        outConstraints.push_back(dc);
-    }
-    return true;
-}
-
-bool generateVolumeConstraints(const std::vector<Particle>& particles, const std::vector<Tetrahedron>& tetras, const float& stiffness, std::vector<VolumeConstraint>& outConstraints) {
-    for (const auto& tetra : tetras) {
-        VolumeConstraint vc{};
-        vc.p1 = tetra.indices[0];
-        vc.p2 = tetra.indices[1];
-        vc.p3 = tetra.indices[2];
-        vc.p4 = tetra.indices[3];
-        vc.restVol = glm::dot(glm::cross(glm::vec3(particles[vc.p2].pos - particles[vc.p1].pos),
-            glm::vec3(particles[vc.p3].pos - particles[vc.p1].pos)),
-            glm::vec3(particles[vc.p4].pos - particles[vc.p1].pos)) / 6.0f;
-        vc.compliance = vc.restVol / stiffness;
-        vc.lambda = 0.0f;
-        outConstraints.push_back(vc);
-    }
-    return true;
-}
-
-struct ColorGroup {
-    uint32_t offset;
-    uint32_t count;
-};
-
-struct ColoredDistanceResult {
-    std::vector<DistanceConstraint> reorderedConstraints;
-    std::vector<ColorGroup> groups;
-};
-
-struct ColoredVolumeResult {
-    std::vector<VolumeConstraint> reorderedConstraints;
-    std::vector<ColorGroup> groups;
-};
-
-// 1. Ÿ   ÷
-ColoredDistanceResult colorDistanceConstraints(const std::vector<DistanceConstraint>& constraints, uint32_t numParticles) {
-    std::vector<std::vector<DistanceConstraint>> colorGroups;
-    std::vector<std::vector<bool>> particleUsed;
-
-    for (const auto& c : constraints) {
-        int color = 0;
-        while (true) {
-            // ο  ʿϸ ߰
-            if (color == colorGroups.size()) {
-                colorGroups.push_back(std::vector<DistanceConstraint>());
-                particleUsed.push_back(std::vector<bool>(numParticles, false));
-            }
-
-            //   ׷쿡 ش  ̹   Ȯ
-            if (!particleUsed[color][c.p1] && !particleUsed[color][c.p2]) {
-                colorGroups[color].push_back(c);
-                particleUsed[color][c.p1] = true;
-                particleUsed[color][c.p2] = true;
-                break; //  ãǷ    Ѿ
-            }
-            color++;
-        }
-    }
-
-    ColoredDistanceResult result;
-    uint32_t currentOffset = 0;
-    for (const auto& group : colorGroups) {
-        ColorGroup cg;
-        cg.offset = currentOffset;
-        cg.count = static_cast<uint32_t>(group.size());
-        result.groups.push_back(cg);
-
-        result.reorderedConstraints.insert(result.reorderedConstraints.end(), group.begin(), group.end());
-        currentOffset += cg.count;
-    }
-    return result;
-}
-
-// 2.    ÷
-ColoredVolumeResult colorVolumeConstraints(const std::vector<VolumeConstraint>& constraints, uint32_t numParticles) {
-    std::vector<std::vector<VolumeConstraint>> colorGroups;
-    std::vector<std::vector<bool>> particleUsed;
-
-    for (const auto& c : constraints) {
-        int color = 0;
-        while (true) {
-            if (color == colorGroups.size()) {
-                colorGroups.push_back(std::vector<VolumeConstraint>());
-                particleUsed.push_back(std::vector<bool>(numParticles, false));
-            }
-
-            if (!particleUsed[color][c.p1] && !particleUsed[color][c.p2] &&
-                !particleUsed[color][c.p3] && !particleUsed[color][c.p4]) {
-                colorGroups[color].push_back(c);
-                particleUsed[color][c.p1] = true;
-                particleUsed[color][c.p2] = true;
-                particleUsed[color][c.p3] = true;
-                particleUsed[color][c.p4] = true;
-                break;
-            }
-            color++;
-        }
-    }
-
-    ColoredVolumeResult result;
-    uint32_t currentOffset = 0;
-    for (const auto& group : colorGroups) {
-        ColorGroup cg;
-        cg.offset = currentOffset;
-        cg.count = static_cast<uint32_t>(group.size());
-        result.groups.push_back(cg);
-
-        result.reorderedConstraints.insert(result.reorderedConstraints.end(), group.begin(), group.end());
-        currentOffset += cg.count;
-    }
-    return result;
-}
-
-
 class HelloTriangleApplication {
 public:
     void run() {
@@ -510,27 +206,41 @@ private:
     VkPipeline solveVolPipeline;
     VkPipeline updatePipeline;
 
+    // ǥ 浹 (Collision*.comp). ֹ ε  ޶ ̾ƿ  
+    VkDescriptorSetLayout collisionDescriptorSetLayout;
+    VkPipelineLayout collisionPipelineLayout;
+    VkPipeline collisionHashPipeline;
+    VkPipeline collisionScanPipeline;
+    VkPipeline collisionFillPipeline;
+    VkPipeline collisionSolvePipeline;
+    VkPipeline collisionApplyPipeline;
+
     VkDescriptorSetLayout descriptorSetLayout;
     VkPipelineLayout pipelineLayout;
     VkPipeline graphicsPipeline;
 
     VkCommandPool commandPool;
 
-    std::vector<Particle> particles;
-    std::vector<Tetrahedron> tetras;
-    std::vector<Edge> edges;
-    std::vector<Face> faces;
-
-    std::vector<uint32_t> indices;
+    //  (.prsb) ̸ֽ  , ƴϸ ؽƮ   softbody  body  Ŵ
+    //   ġϸ world.combined  Ŵ.   / ġ  body  
+    Prism::Softbody softbody;
+    std::unique_ptr<Prism::BakedSoftbodyFile> bakedFile;
+    Prism::SoftbodyWorld world;
+    Prism::SoftbodyView body;
 
-    std::vector<VolumeConstraint> volumeConstraints;
-    std::vector<DistanceConstraint> distanceConstraints;
-
-    std::vector<ColorGroup> distanceColorGroups;
-    std::vector<ColorGroup> volumeColorGroups;
+    // ؽ ũ / ǥ  /    ϸ   (CPU  solve  ȣ )
+    std::unique_ptr<Prism::CollisionSystem> collision;
+    uint32_t collisionEntryCapacity = 0;
 
+    // posInvMass   (ֺ갡 а  hot Ʈ)
     std::vector<VkBuffer> shaderStorageBuffers;
     std::vector<VkDeviceMemory> shaderStorageBuffersMemory;
+    VkBuffer velocityBuffer;
+    VkDeviceMemory velocityBufferMemory;
+    VkBuffer prevPosBuffer;
+    VkDeviceMemory prevPosBufferMemory;
+    VkBuffer colorBuffer;
+    VkDeviceMemory colorBufferMemory;
     VkBuffer indexBuffer;
     VkDeviceMemory indexBufferMemory;
     VkBuffer tetraBuffer;
@@ -543,6 +253,8 @@ private:
     VkDeviceMemory volumeConstraintsBufferMemory;
     VkBuffer distanceConstraintsBuffer;
     VkDeviceMemory distanceConstraintsBufferMemory;
+    std::array<VkBuffer, CollisionBindingCount> collisionBuffers{};
+    std::array<VkDeviceMemory, CollisionBindingCount> collisionBuffersMemory{};
 
     std::vector<VkBuffer> uniformBuffers;
     std::vector<VkDeviceMemory> uniformBuffersMemory;
@@ -550,6 +262,7 @@ private:
 
     VkDescriptorPool descriptorPool;
     std::vector<VkDescriptorSet> computeDescriptorSets;
+    std::vector<VkDescriptorSet> collisionDescriptorSets;
     std::vector<VkDescriptorSet> descriptorSets;
 
     std::vector<VkCommandBuffer> commandBuffers;
@@ -560,50 +273,103 @@ private:
     uint32_t currentFrame = 0;
 
     const float stiffness = 1024.0f;
+    const int bodyGridSize = 3;     // XZ    body  (1 ̸ ϳ)
+    const bool enableCollision = true;  // body  / ڱ ǥ 浹
 
     bool framebufferResized = false;
 
-    void loadMesh(const std::string& nodeFile, const std::string& eleFile, const std::string& edgeFile, const std::string& faceFile) {
-        int startIndex;
-        if (!parseNodeFile(nodeFile, particles, startIndex)) {
-            throw std::runtime_error("Failed to load node file!");
-        }
-        if (!parseEleFile(eleFile, startIndex, tetras)) {
-            throw std::runtime_error("Failed to load ele file!");
-        }
-        if (!parseEdgeFile(edgeFile, startIndex, edges)) {
-            throw std::runtime_error("Failed to load edge file!");
+    // TetGen ؽƮ Ľ + ÷  "<basePath>.prsb"  ĳ
+    //  ޽  ֽ̰ų stiffness  ٸ ٽ  
+    void loadSoftbody(const std::string& basePath) {
+        const std::string bakedPath = basePath + ".prsb";
+        auto loadStart = std::chrono::high_resolution_clock::now();
+
+        if (!Prism::isBakedSoftbodyStale(bakedPath, basePath)) {
+            try {
+                bakedFile = std::make_unique<Prism::BakedSoftbodyFile>(bakedPath);
+                if (bakedFile->stiffness() != stiffness) {
+                    bakedFile.reset();
+                }
+            }
+            catch (const std::exception& e) {
+                std::cerr << e.what() << std::endl;
+                bakedFile.reset();
+            }
         }
-        if (!parseFaceFile(faceFile, startIndex, faces)) {
-            throw std::runtime_error("Failed to load face file!");
+
+        if (bakedFile) {
+            body = bakedFile->view();
         }
-        indices.clear();
-        indices.reserve(faces.size() * 3);
-        for (const auto& face : faces) {
-            indices.push_back(face.indices[0]);
-            indices.push_back(face.indices[1]);
-            indices.push_back(face.indices[2]);
+        else {
+            Prism::SoftbodyBuildStats buildStats;
+            softbody = Prism::buildSoftbody(Prism::loadTetMesh(basePath), stiffness, nullptr, &buildStats);
+            std::cout << "Distance Colors: " << buildStats.distance << std::endl;
+            std::cout << "Volume Colors: " << buildStats.volume << std::endl;
+            body = Prism::makeSoftbodyView(softbody);
+            try {
+                Prism::saveBakedSoftbody(bakedPath, softbody, stiffness);
+            }
+            catch (const std::exception& e) {
+                std::cerr << e.what() << std::endl;
+            }
         }
+
+        auto loadEnd = std::chrono::high_resolution_clock::now();
+        std::cout << (bakedFile ? "Mapped " : "Built ") << basePath
+            << " in " << std::chrono::duration<double, std::milli>(loadEnd - loadStart).count() << " ms"
+            << " (Distance Colors: " << body.distanceColorGroups.size()
+            << ", Volume Colors: " << body.volumeColorGroups.size() << ")" << std::endl;
     }
 
-    void createConstraints() {
-        if (!generateDistanceConstraints(particles, edges, stiffness, distanceConstraints)) {
-            throw std::runtime_error("Failed to generate distance constraints!");
+    //  ޽ bodyGridSize x bodyGridSize  ġ  ϳ ħ
+    //  ׷쵵 Ƿ body  þ recordCommandBuffer  dispatch / barrier  ״
+    void createWorld() {
+        if (bodyGridSize <= 1) return;
+
+        glm::vec3 lo(std::numeric_limits<float>::max());
+        glm::vec3 hi(std::numeric_limits<float>::lowest());
+        for (const auto& p : body.posInvMass) {
+            lo = glm::min(lo, glm::vec3(p));
+            hi = glm::max(hi, glm::vec3(p));
         }
-        if (!generateVolumeConstraints(particles, tetras, stiffness, volumeConstraints)) {
-            throw std::runtime_error("Failed to generate volume constraints!");
+        const glm::vec3 spacing = (hi - lo) * 1.5f;
+        const float center = float(bodyGridSize - 1) * 0.5f;
+
+        std::vector<Prism::SoftbodyPlacement> placements;
+        for (int z = 0; z < bodyGridSize; z++) {
+            for (int x = 0; x < bodyGridSize; x++) {
+                Prism::SoftbodyPlacement placement;
+                placement.body = body;
+                placement.translation = glm::vec3((float(x) - center) * spacing.x, 0.0f, (float(z) - center) * spacing.z);
+                placements.push_back(placement);
+            }
         }
 
-        auto distResult = colorDistanceConstraints(distanceConstraints, particles.size());
-        distanceConstraints = distResult.reorderedConstraints;
-        distanceColorGroups = distResult.groups;
+        world = Prism::buildSoftbodyWorld(placements);
+        body = Prism::makeSoftbodyView(world.combined);
+
+        //   ̻  
+        bakedFile.reset();
+        softbody = {};
+
+        std::cout << "World: " << world.bodies.size() << " bodies, " << body.particleCount() << " particles"
+            << " (Distance Colors: " << body.distanceColorGroups.size()
+            << ", Volume Colors: " << body.volumeColorGroups.size() << ")" << std::endl;
+    }
+
+    // ؽ  ũ / ̺ ũ CPU  CollisionSystem  ޽   ״ 
+    void createCollision() {
+        if (!enableCollision) return;
+
+        collision = std::make_unique<Prism::CollisionSystem>(body, world.bodies);
 
-        auto volResult = colorVolumeConstraints(volumeConstraints, particles.size());
-        volumeConstraints = volResult.reorderedConstraints;
-        volumeColorGroups = volResult.groups;
+        //    ·  ؽ ׸  ,  þ ŭ   (ģ ׸ ̴ )
+        collisionEntryCapacity = 4 * (collision->particleGrid().entryCount() + collision->triangleGrid().entryCount());
 
-        std::cout << "Distance Colors: " << distanceColorGroups.size()
-            << ", Volume Colors: " << volumeColorGroups.size() << std::endl;
+        std::cout << "Collision: thickness " << collision->thickness()
+            << ", surface particles " << collision->surfaceParticles().size()
+            << ", triangles " << collision->triangles().size()
+            << ", entry capacity " << collisionEntryCapacity << std::endl;
     }
 
     void initWindow() {
@@ -622,12 +388,9 @@ private:
     }
 
     void initVulkan() {
-        loadMesh(
-            "models/bunny_1k.1.node",
-            "models/bunny_1k.1.ele",
-            "models/bunny_1k.1.edge",
-            "models/bunny_1k.1.face");
-        createConstraints();
+        loadSoftbody("models/bunny_1k.1");
+        createWorld();
+        createCollision();
         createInstance();
         setupDebugMessenger();
         createSurface();
@@ -638,6 +401,7 @@ private:
         createDepthResources();
         createRenderPass();
         createComputeDescriptorSetLayout();
+        createCollisionDescriptorSetLayout();
         createDescriptorSetLayout();
         //createComputePipeline();
         createComputePipelines();
@@ -645,12 +409,14 @@ private:
         createFramebuffers();
         createCommandPool();
         createShaderStorageBuffer();
+        createCollisionBuffers();
         createDistanceConstraintBuffer();
         createVolumeConstraintBuffer();
         createIndexBuffer();
         createUniformBuffers();
         createDescriptorPool();
         createComputeDescriptorSets();
+        createCollisionDescriptorSets();
         createDescriptorSets();
         createCommandBuffers();
         createSyncObjects();
@@ -687,6 +453,14 @@ private:
         vkDestroyPipeline(device, solveVolPipeline, nullptr);
         vkDestroyPipeline(device, updatePipeline, nullptr);
         vkDestroyPipelineLayout(device, computePipelineLayout, nullptr);
+        if (collision) {
+            vkDestroyPipeline(device, collisionHashPipeline, nullptr);
+            vkDestroyPipeline(device, collisionScanPipeline, nullptr);
+            vkDestroyPipeline(device, collisionFillPipeline, nullptr);
+            vkDestroyPipeline(device, collisionSolvePipeline, nullptr);
+            vkDestroyPipeline(device, collisionApplyPipeline, nullptr);
+            vkDestroyPipelineLayout(device, collisionPipelineLayout, nullptr);
+        }
         vkDestroyRenderPass(device, renderPass, nullptr);
 
         vkDestroyImageView(device, depthImageView, nullptr);
@@ -700,16 +474,32 @@ private:
             vkFreeMemory(device, shaderStorageBuffersMemory[i], nullptr);
         }
 
+        vkDestroyBuffer(device, velocityBuffer, nullptr);
+        vkFreeMemory(device, velocityBufferMemory, nullptr);
+        vkDestroyBuffer(device, prevPosBuffer, nullptr);
+        vkFreeMemory(device, prevPosBufferMemory, nullptr);
+        vkDestroyBuffer(device, colorBuffer, nullptr);
+        vkFreeMemory(device, colorBufferMemory, nullptr);
+
         vkDestroyBuffer(device, indexBuffer, nullptr);
         vkFreeMemory(device, indexBufferMemory, nullptr);
         vkDestroyBuffer(device, distanceConstraintsBuffer, nullptr);
         vkFreeMemory(device, distanceConstraintsBufferMemory, nullptr);
         vkDestroyBuffer(device, volumeConstraintsBuffer, nullptr);
         vkFreeMemory(device, volumeConstraintsBufferMemory, nullptr);
+        if (collision) {
+            for (uint32_t binding = 1; binding < CollisionBindingCount; binding++) {
+                vkDestroyBuffer(device, collisionBuffers[binding], nullptr);
+                vkFreeMemory(device, collisionBuffersMemory[binding], nullptr);
+            }
+        }
 
         vkDestroyDescriptorPool(device, descriptorPool, nullptr);
         vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
         vkDestroyDescriptorSetLayout(device, computeDescriptorSetLayout, nullptr);
+        if (collision) {
+            vkDestroyDescriptorSetLayout(device, collisionDescriptorSetLayout, nullptr);
+        }
 
         for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
             vkDestroySemaphore(device, imageAvailableSemaphores[i], nullptr);
@@ -1146,7 +936,7 @@ private:
         vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &computePipelineLayout);
 
         // 2.     Լ
-        auto createPipeline = [&](const std::string& shaderPath, VkPipeline& pipeline) {
+        auto createPipeline = [&](const std::string& shaderPath, VkPipelineLayout layout, VkPipeline& pipeline) {
             auto shaderCode = readFile(shaderPath);
             VkShaderModule shaderModule = createShaderModule(shaderCode);
 
@@ -1158,7 +948,7 @@ private:
 
             VkComputePipelineCreateInfo pipelineInfo{};
             pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
-            pipelineInfo.layout = computePipelineLayout;
+            pipelineInfo.layout = layout;
             pipelineInfo.stage = stageInfo;
 
             if (vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
@@ -1168,10 +958,35 @@ private:
             };
 
         // 3.    ȣ
-        createPipeline("shaders/Predict.comp.spv", predictPipeline); // 
-        createPipeline("shaders/SolveDist.comp.spv", solveDistPipeline); //
-        createPipeline("shaders/SolveVol.comp.spv", solveVolPipeline);     // 
-        createPipeline("shaders/Update.comp.spv", updatePipeline);   // 
+        createPipeline("shaders/Predict.comp.spv", computePipelineLayout, predictPipeline); // 
+        createPipeline("shaders/SolveDist.comp.spv", computePipelineLayout, solveDistPipeline); //
+        createPipeline("shaders/SolveVol.comp.spv", computePipelineLayout, solveVolPipeline);     // 
+        createPipeline("shaders/Update.comp.spv", computePipelineLayout, updatePipeline);   // 
+
+        // 4. 浹  (5 ̾ƿ ϳ )
+        if (collision) {
+            VkPushConstantRange collisionPushConstantRange{};
+            collisionPushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+            collisionPushConstantRange.offset = 0;
+            collisionPushConstantRange.size = sizeof(CollisionPushConstants);
+
+            VkPipelineLayoutCreateInfo collisionLayoutInfo{};
+            collisionLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+            collisionLayoutInfo.setLayoutCount = 1;
+            collisionLayoutInfo.pSetLayouts = &collisionDescriptorSetLayout;
+            collisionLayoutInfo.pushConstantRangeCount = 1;
+            collisionLayoutInfo.pPushConstantRanges = &collisionPushConstantRange;
+
+            if (vkCreatePipelineLayout(device, &collisionLayoutInfo, nullptr, &collisionPipelineLayout) != VK_SUCCESS) {
+                throw std::runtime_error("failed to create collision pipeline layout!");
+            }
+
+            createPipeline("shaders/CollisionHash.comp.spv", collisionPipelineLayout, collisionHashPipeline);
+            createPipeline("shaders/CollisionScan.comp.spv", collisionPipelineLayout, collisionScanPipeline);
+            createPipeline("shaders/CollisionFill.comp.spv", collisionPipelineLayout, collisionFillPipeline);
+            createPipeline("shaders/CollisionSolve.comp.spv", collisionPipelineLayout, collisionSolvePipeline);
+            createPipeline("shaders/CollisionApply.comp.spv", collisionPipelineLayout, collisionApplyPipeline);
+        }
     }
 
     void createGraphicsPipeline() {
@@ -1198,12 +1013,12 @@ private:
         VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
         vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
 
-        auto bindingDescription = Particle::getBindingDescription();
-        auto attributeDescriptions = Particle::getAttributeDescriptions();
+        auto bindingDescriptions = getParticleBindingDescriptions();
+        auto attributeDescriptions = getParticleAttributeDescriptions();
 
-        vertexInputInfo.vertexBindingDescriptionCount = 1;
+        vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(bindingDescriptions.size());
         vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
-        vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
+        vertexInputInfo.pVertexBindingDescriptions = bindingDescriptions.data();
         vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
 
         VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
@@ -1334,14 +1149,14 @@ private:
         }
     }
 
-    void createShaderStorageBuffer() {
-        VkDeviceSize bufferSize = sizeof(Particle) * particles.size();
-
+    // ¡ ۸  DEVICE_LOCAL ۷ ε
+    // srcData  .prsb    ų   (߰ std::vector  )
+    void createDeviceLocalBuffer(const void* srcData, VkDeviceSize bufferSize, VkBufferUsageFlags usage, VkBuffer& buffer, VkDeviceMemory& bufferMemory) {
         VkBuffer stagingBuffer;
         VkDeviceMemory stagingBufferMemory;
         createBuffer(
             bufferSize,
-            VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
             stagingBuffer,
             stagingBufferMemory
@@ -1349,28 +1164,81 @@ private:
 
         void* data;
         vkMapMemory(device, stagingBufferMemory, 0, bufferSize, 0, &data);
-        memcpy(data, particles.data(), (size_t)bufferSize);
+        memcpy(data, srcData, (size_t)bufferSize);
         vkUnmapMemory(device, stagingBufferMemory);
 
+        createBuffer(
+            bufferSize,
+            usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            buffer,
+            bufferMemory
+        );
+        copyBuffer(stagingBuffer, buffer, bufferSize);
+        vkDestroyBuffer(device, stagingBuffer, nullptr);
+        vkFreeMemory(device, stagingBufferMemory, nullptr);
+    }
+
+    // ƼŬ SoA Ʈ ε
+    // posInvMass   (Predict/Update  а   ٲ), velocity/prevPos  ƼŬ  常 ϹǷ ϳ
+    void createShaderStorageBuffer() {
+        VkDeviceSize streamSize = sizeof(glm::vec4) * body.particleCount();
+
         shaderStorageBuffers.resize(MAX_FRAMES_IN_FLIGHT);
         shaderStorageBuffersMemory.resize(MAX_FRAMES_IN_FLIGHT);
 
         for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-            createBuffer(
-                bufferSize,
-                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-                shaderStorageBuffers[i],
-                shaderStorageBuffersMemory[i]
-            );
-            copyBuffer(stagingBuffer, shaderStorageBuffers[i], bufferSize);
-        }
-        vkDestroyBuffer(device, stagingBuffer, nullptr);
-        vkFreeMemory(device, stagingBufferMemory, nullptr);
+            createDeviceLocalBuffer(body.posInvMass.data(), streamSize,
+                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                shaderStorageBuffers[i], shaderStorageBuffersMemory[i]);
+        }
+        createDeviceLocalBuffer(body.velocity.data(), streamSize,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, velocityBuffer, velocityBufferMemory);
+        createDeviceLocalBuffer(body.prevPos.data(), streamSize,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, prevPosBuffer, prevPosBufferMemory);
+        createDeviceLocalBuffer(body.color.data(), streamSize,
+            VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, colorBuffer, colorBufferMemory);
+    }
+
+    // 浹 : ǥ  / ﰢ / body id /     ε,  꽺ܸ ̴ ä
+    void createCollisionBuffers() {
+        if (!collision) return;
+
+        const uint32_t zero = 0;
+        auto upload = [&](CollisionBinding binding, const void* data, VkDeviceSize size) {
+            if (size == 0) {    // ũ 0 ۴    (ﰢ 浹   )
+                data = &zero;
+                size = sizeof(zero);
+            }
+            createDeviceLocalBuffer(data, size, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                collisionBuffers[binding], collisionBuffersMemory[binding]);
+        };
+        auto allocate = [&](CollisionBinding binding, VkDeviceSize size, VkBufferUsageFlags extraUsage) {
+            createBuffer(std::max<VkDeviceSize>(size, sizeof(uint32_t)), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | extraUsage,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, collisionBuffers[binding], collisionBuffersMemory[binding]);
+        };
+
+        auto surface = collision->surfaceParticles();
+        auto triangles = collision->triangles();
+        auto bodies = collision->particleBodies();
+        auto excludeStart = collision->restExclusionStart();
+        auto exclude = collision->restExclusions();
+        upload(CollisionSurfaceParticles, surface.data(), surface.size_bytes());
+        upload(CollisionTriangles, triangles.data(), triangles.size_bytes());
+        upload(CollisionParticleBodies, bodies.data(), bodies.size_bytes());
+        upload(CollisionRestExcludeStart, excludeStart.data(), excludeStart.size_bytes());
+        upload(CollisionRestExclude, exclude.data(), exclude.size_bytes());
+
+        const VkDeviceSize bucketCount = VkDeviceSize(collision->particleGrid().getTableSize()) + collision->triangleGrid().getTableSize() + 1;
+        allocate(CollisionBoxes, sizeof(glm::vec4) * 2 * collision->objectCount(), 0);
+        allocate(CollisionCellStart, sizeof(uint32_t) * (bucketCount + 1), 0);
+        allocate(CollisionCellCursor, sizeof(uint32_t) * bucketCount, VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+        allocate(CollisionCellEntries, sizeof(uint32_t) * collisionEntryCapacity, 0);
+        allocate(CollisionCorrections, sizeof(glm::vec4) * surface.size(), 0);
     }
 
     void createDistanceConstraintBuffer() {
-        VkDeviceSize CONSTRAINT_COUNT = distanceConstraints.size();
+        VkDeviceSize CONSTRAINT_COUNT = body.distanceConstraints.size();
         std::vector<DistanceConstraint> constraints(CONSTRAINT_COUNT);
 
         VkDeviceSize bufferSize = sizeof(DistanceConstraint) * constraints.size();
@@ -1387,7 +1255,7 @@ private:
 
         void* data;
         vkMapMemory(device, stagingBufferMemory, 0, bufferSize, 0, &data);
-        memcpy(data, distanceConstraints.data(), (size_t)bufferSize);
+        memcpy(data, body.distanceConstraints.data(), (size_t)bufferSize);
         vkUnmapMemory(device, stagingBufferMemory);
 
         createBuffer(
@@ -1403,7 +1271,7 @@ private:
     }
 
     void createVolumeConstraintBuffer() {
-        VkDeviceSize CONSTRAINT_COUNT = volumeConstraints.size();
+        VkDeviceSize CONSTRAINT_COUNT = body.volumeConstraints.size();
         std::vector<VolumeConstraint> constraints(CONSTRAINT_COUNT);
 
         VkDeviceSize bufferSize = sizeof(VolumeConstraint) * constraints.size();
@@ -1420,7 +1288,7 @@ private:
 
         void* data;
         vkMapMemory(device, stagingBufferMemory, 0, bufferSize, 0, &data);
-        memcpy(data, volumeConstraints.data(), (size_t)bufferSize);
+        memcpy(data, body.volumeConstraints.data(), (size_t)bufferSize);
         vkUnmapMemory(device, stagingBufferMemory);
 
 
@@ -1437,7 +1305,7 @@ private:
     }
 
     void createIndexBuffer() {
-        VkDeviceSize bufferSize = sizeof(uint32_t) * indices.size();
+        VkDeviceSize bufferSize = sizeof(uint32_t) * body.indices.size();
 
         VkBuffer stagingBuffer;
         VkDeviceMemory stagingBufferMemory;
@@ -1445,7 +1313,7 @@ private:
 
         void* data;
         vkMapMemory(device, stagingBufferMemory, 0, bufferSize, 0, &data);
-        memcpy(data, indices.data(), (size_t)bufferSize);
+        memcpy(data, body.indices.data(), (size_t)bufferSize);
         vkUnmapMemory(device, stagingBufferMemory);
 
         createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, indexBuffer, indexBufferMemory);
@@ -1476,14 +1344,14 @@ private:
         poolSizes[0].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
 
         poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-        poolSizes[1].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT) * 4;
+        poolSizes[1].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT) * (6 + CollisionBindingCount);
 
         VkDescriptorPoolCreateInfo poolInfo{};
         poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
         poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
         poolInfo.pPoolSizes = poolSizes.data();
 
-        poolInfo.maxSets = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT) * 2;
+        poolInfo.maxSets = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT) * 3;
 
         if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
             throw std::runtime_error("failed to create descriptor pool!");
@@ -1522,7 +1390,7 @@ private:
         }
     }
     void createComputeDescriptorSetLayout() {
-        std::array<VkDescriptorSetLayoutBinding, 4> layoutBindings{};
+        std::array<VkDescriptorSetLayoutBinding, 6> layoutBindings{};
         layoutBindings[0].binding = 0;
         layoutBindings[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
         layoutBindings[0].descriptorCount = 1;
@@ -1543,9 +1411,19 @@ private:
         layoutBindings[3].descriptorCount = 1;
         layoutBindings[3].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
 
+        layoutBindings[4].binding = 4;
+        layoutBindings[4].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        layoutBindings[4].descriptorCount = 1;
+        layoutBindings[4].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+        layoutBindings[5].binding = 5;
+        layoutBindings[5].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        layoutBindings[5].descriptorCount = 1;
+        layoutBindings[5].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
         VkDescriptorSetLayoutCreateInfo layoutInfo{};
         layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-        layoutInfo.bindingCount = 4;
+        layoutInfo.bindingCount = static_cast<uint32_t>(layoutBindings.size());
         layoutInfo.pBindings = layoutBindings.data();
 
         if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &computeDescriptorSetLayout) != VK_SUCCESS) {
@@ -1553,6 +1431,27 @@ private:
         }
     }
 
+    void createCollisionDescriptorSetLayout() {
+        if (!collision) return;
+
+        std::array<VkDescriptorSetLayoutBinding, CollisionBindingCount> layoutBindings{};
+        for (uint32_t binding = 0; binding < CollisionBindingCount; binding++) {
+            layoutBindings[binding].binding = binding;
+            layoutBindings[binding].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            layoutBindings[binding].descriptorCount = 1;
+            layoutBindings[binding].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        }
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = static_cast<uint32_t>(layoutBindings.size());
+        layoutInfo.pBindings = layoutBindings.data();
+
+        if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &collisionDescriptorSetLayout) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create collision descriptor set layout!");
+        }
+    }
+
     void createComputeDescriptorSets() {
         computeDescriptorSets.resize(MAX_FRAMES_IN_FLIGHT);
 
@@ -1572,24 +1471,34 @@ private:
             VkDescriptorBufferInfo inBufferInfo{};
             inBufferInfo.buffer = shaderStorageBuffers[(i + 1) % MAX_FRAMES_IN_FLIGHT]; // 츮  SSBO
             inBufferInfo.offset = 0;
-            inBufferInfo.range = sizeof(Particle) * particles.size();
+            inBufferInfo.range = sizeof(glm::vec4) * body.particleCount();
 
             VkDescriptorBufferInfo outBufferInfo{};
             outBufferInfo.buffer = shaderStorageBuffers[i]; // 츮  SSBO
             outBufferInfo.offset = 0;
-            outBufferInfo.range = sizeof(Particle) * particles.size();
+            outBufferInfo.range = sizeof(glm::vec4) * body.particleCount();
 
             VkDescriptorBufferInfo DistanceConstraintBufferInfo{};
             DistanceConstraintBufferInfo.buffer = distanceConstraintsBuffer;
             DistanceConstraintBufferInfo.offset = 0;
-            DistanceConstraintBufferInfo.range = sizeof(DistanceConstraint) * distanceConstraints.size();
+            DistanceConstraintBufferInfo.range = sizeof(DistanceConstraint) * body.distanceConstraints.size();
 
             VkDescriptorBufferInfo VolumeConstraintBufferInfo{};
             VolumeConstraintBufferInfo.buffer = volumeConstraintsBuffer;
             VolumeConstraintBufferInfo.offset = 0;
-            VolumeConstraintBufferInfo.range = sizeof(VolumeConstraint) * volumeConstraints.size();
+            VolumeConstraintBufferInfo.range = sizeof(VolumeConstraint) * body.volumeConstraints.size();
 
-            std::array<VkWriteDescriptorSet, 4> descriptorWrites{};
+            VkDescriptorBufferInfo velocityBufferInfo{};
+            velocityBufferInfo.buffer = velocityBuffer;
+            velocityBufferInfo.offset = 0;
+            velocityBufferInfo.range = sizeof(glm::vec4) * body.particleCount();
+
+            VkDescriptorBufferInfo prevPosBufferInfo{};
+            prevPosBufferInfo.buffer = prevPosBuffer;
+            prevPosBufferInfo.offset = 0;
+            prevPosBufferInfo.range = sizeof(glm::vec4) * body.particleCount();
+
+            std::array<VkWriteDescriptorSet, 6> descriptorWrites{};
             descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
             descriptorWrites[0].dstSet = computeDescriptorSets[i];
             descriptorWrites[0].dstBinding = 0;
@@ -1614,8 +1523,56 @@ private:
             descriptorWrites[3].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
             descriptorWrites[3].descriptorCount = 1;
             descriptorWrites[3].pBufferInfo = &VolumeConstraintBufferInfo;
+            descriptorWrites[4].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            descriptorWrites[4].dstSet = computeDescriptorSets[i];
+            descriptorWrites[4].dstBinding = 4;
+            descriptorWrites[4].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            descriptorWrites[4].descriptorCount = 1;
+            descriptorWrites[4].pBufferInfo = &velocityBufferInfo;
+            descriptorWrites[5].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            descriptorWrites[5].dstSet = computeDescriptorSets[i];
+            descriptorWrites[5].dstBinding = 5;
+            descriptorWrites[5].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            descriptorWrites[5].descriptorCount = 1;
+            descriptorWrites[5].pBufferInfo = &prevPosBufferInfo;
+
+            vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+        }
+    }
+
+    //  i  Ʈ ֺ갡  shaderStorageBuffers[i] (= writeIdx)  浹 ǯ
+    void createCollisionDescriptorSets() {
+        if (!collision) return;
+
+        std::vector<VkDescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT, collisionDescriptorSetLayout);
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = descriptorPool;
+        allocInfo.descriptorSetCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
+        allocInfo.pSetLayouts = layouts.data();
+
+        collisionDescriptorSets.resize(MAX_FRAMES_IN_FLIGHT);
+        if (vkAllocateDescriptorSets(device, &allocInfo, collisionDescriptorSets.data()) != VK_SUCCESS) {
+            throw std::runtime_error("failed to allocate collision descriptor sets!");
+        }
 
-            vkUpdateDescriptorSets(device, 4, descriptorWrites.data(), 0, nullptr);
+        for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+            std::array<VkDescriptorBufferInfo, CollisionBindingCount> bufferInfos{};
+            std::array<VkWriteDescriptorSet, CollisionBindingCount> descriptorWrites{};
+            for (uint32_t binding = 0; binding < CollisionBindingCount; binding++) {
+                bufferInfos[binding].buffer = binding == CollisionPositions ? shaderStorageBuffers[i] : collisionBuffers[binding];
+                bufferInfos[binding].offset = 0;
+                bufferInfos[binding].range = VK_WHOLE_SIZE;
+
+                descriptorWrites[binding].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                descriptorWrites[binding].dstSet = collisionDescriptorSets[i];
+                descriptorWrites[binding].dstBinding = binding;
+                descriptorWrites[binding].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                descriptorWrites[binding].descriptorCount = 1;
+                descriptorWrites[binding].pBufferInfo = &bufferInfos[binding];
+            }
+
+            vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
         }
     }
     void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory) {
@@ -1733,8 +1690,9 @@ private:
             vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelineLayout,
                 0, 1, &computeDescriptorSets[writeIdx], 0, nullptr);
             vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(MeshPushConstants), &pc);
-            vkCmdDispatch(commandBuffer, (particles.size() + 63) / 64, 1, 1);
+            vkCmdDispatch(commandBuffer, (body.particleCount() + 63) / 64, 1, 1);
             addComputeBarrier(commandBuffer, shaderStorageBuffers[writeIdx]);
+            addComputeBarrier(commandBuffer, prevPosBuffer);
 
             // Step 2. Solve (Iterative)
             int constraintCount = 4;
@@ -1744,7 +1702,7 @@ private:
                 vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelineLayout,
                     0, 1, &computeDescriptorSets[writeIdx], 0, nullptr);
 
-                for (const auto& group : distanceColorGroups) {
+                for (const auto& group : body.distanceColorGroups) {
                     pc.constraintOffset = group.offset;
                     pc.constraintCount = group.count;
                     vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(MeshPushConstants), &pc);
@@ -1755,7 +1713,7 @@ private:
                 vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, solveVolPipeline);
                 vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelineLayout,
                     0, 1, &computeDescriptorSets[writeIdx], 0, nullptr);
-                for (const auto& group : volumeColorGroups) {
+                for (const auto& group : body.volumeColorGroups) {
                     pc.constraintOffset = group.offset;
                     pc.constraintCount = group.count;
                     vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(MeshPushConstants), &pc);
@@ -1763,13 +1721,19 @@ private:
                     addComputeBarrier(commandBuffer, shaderStorageBuffers[writeIdx]);
                 }
             }
+            // Step 2.5. ǥ 浹 (ֺ ͷ̼   꽺ܸ  )
+            if (collision) {
+                recordCollision(commandBuffer, writeIdx);
+            }
+
             // Step 3. Update
             vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, updatePipeline);
             vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelineLayout,
                 0, 1, &computeDescriptorSets[readIdx], 0, nullptr); // Update readIdx а writeIdx  ̹Ƿ, readIdx ε
             vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(MeshPushConstants), &pc);
-            vkCmdDispatch(commandBuffer, (particles.size() + 63) / 64, 1, 1);
+            vkCmdDispatch(commandBuffer, (body.particleCount() + 63) / 64, 1, 1);
             addComputeBarrier(commandBuffer, shaderStorageBuffers[readIdx]);
+            addComputeBarrier(commandBuffer, velocityBuffer);
         }
 
         VkBufferMemoryBarrier barrier{};
@@ -1823,20 +1787,106 @@ private:
         scissor.extent = swapChainExtent;
         vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
 
-        VkBuffer SSBuffers[] = { shaderStorageBuffers[readIdx] };
-        VkDeviceSize offsets[] = { 0 };
-        vkCmdBindVertexBuffers(commandBuffer, 0, 1, SSBuffers, offsets);
+        VkBuffer SSBuffers[] = { shaderStorageBuffers[readIdx], colorBuffer };
+        VkDeviceSize offsets[] = { 0, 0 };
+        vkCmdBindVertexBuffers(commandBuffer, 0, 2, SSBuffers, offsets);
         //VkBuffer vertexBuffers[] = { vertexBuffer };
         //VkDeviceSize offsets[] = { 0 };
         vkCmdBindIndexBuffer(commandBuffer, indexBuffer, 0, VK_INDEX_TYPE_UINT32);
         vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descriptorSets[currentFrame], 0, nullptr);
-        vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(indices.size()), 1, 0, 0, 0);
+        vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(body.indices.size()), 1, 0, 0, 0);
         vkCmdEndRenderPass(commandBuffer);
         if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
             throw std::runtime_error("failed to record command buffer!");
         }
     }
 
+    // ؽ 籸 ( -> prefix sum -> ä)     / . ܰ踶  ܰ谡 д ۿ 踮
+    void recordCollision(VkCommandBuffer commandBuffer, uint32_t writeIdx) {
+        CollisionPushConstants pc{};
+        pc.thickness = collision->thickness();
+        pc.particleInvCellSize = collision->particleGrid().getInvCellSize();
+        pc.triangleInvCellSize = collision->triangleGrid().getInvCellSize();
+        pc.surfaceCount = static_cast<uint32_t>(collision->surfaceParticles().size());
+        pc.triangleCount = static_cast<uint32_t>(collision->triangles().size());
+        pc.particleTableSize = collision->particleGrid().getTableSize();
+        pc.triangleTableSize = collision->triangleGrid().getTableSize();
+        pc.entryCapacity = collisionEntryCapacity;
+        pc.selfCollision = collision->selfCollision() ? 1u : 0u;
+
+        const uint32_t objectGroups = (collision->objectCount() + 63) / 64;
+        const uint32_t surfaceGroups = (pc.surfaceCount + 63) / 64;
+
+        //  substep  hash/scan н CellCursor    ڿ 0  ä
+        addComputeToTransferBarrier(commandBuffer, collisionBuffers[CollisionCellCursor]);
+        vkCmdFillBuffer(commandBuffer, collisionBuffers[CollisionCellCursor], 0, VK_WHOLE_SIZE, 0);
+        addTransferToComputeBarrier(commandBuffer, collisionBuffers[CollisionCellCursor]);
+
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, collisionPipelineLayout,
+            0, 1, &collisionDescriptorSets[writeIdx], 0, nullptr);
+        vkCmdPushConstants(commandBuffer, collisionPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CollisionPushConstants), &pc);
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, collisionHashPipeline);
+        vkCmdDispatch(commandBuffer, objectGroups, 1, 1);
+        addComputeBarrier(commandBuffer, collisionBuffers[CollisionCellCursor]);
+        addComputeBarrier(commandBuffer, collisionBuffers[CollisionBoxes]);
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, collisionScanPipeline);
+        vkCmdDispatch(commandBuffer, 1, 1, 1);
+        addComputeBarrier(commandBuffer, collisionBuffers[CollisionCellCursor]);
+        addComputeBarrier(commandBuffer, collisionBuffers[CollisionCellStart]);
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, collisionFillPipeline);
+        vkCmdDispatch(commandBuffer, objectGroups, 1, 1);
+        addComputeBarrier(commandBuffer, collisionBuffers[CollisionCellEntries]);
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, collisionSolvePipeline);
+        vkCmdDispatch(commandBuffer, surfaceGroups, 1, 1);
+        addComputeBarrier(commandBuffer, collisionBuffers[CollisionCorrections]);
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, collisionApplyPipeline);
+        vkCmdDispatch(commandBuffer, surfaceGroups, 1, 1);
+        addComputeBarrier(commandBuffer, shaderStorageBuffers[writeIdx]);
+    }
+
+    void addComputeToTransferBarrier(VkCommandBuffer commandBuffer, VkBuffer buffer) {
+        VkBufferMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.buffer = buffer;
+        barrier.offset = 0;
+        barrier.size = VK_WHOLE_SIZE;
+
+        vkCmdPipelineBarrier(
+            commandBuffer,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0, 0, nullptr, 1, &barrier, 0, nullptr
+        );
+    }
+
+    void addTransferToComputeBarrier(VkCommandBuffer commandBuffer, VkBuffer buffer) {
+        VkBufferMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.buffer = buffer;
+        barrier.offset = 0;
+        barrier.size = VK_WHOLE_SIZE;
+
+        vkCmdPipelineBarrier(
+            commandBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, 0, nullptr, 1, &barrier, 0, nullptr
+        );
+    }
+
     void addComputeBarrier(VkCommandBuffer commandBuffer, VkBuffer buffer) {
         VkBufferMemoryBarrier barrier{};
         barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Prism {
+
+    // 외부 라이브러리 없이 쓰는 최소 이미지 저장. 실패하면 std::runtime_error
+
+    // 8-bit RGBA PNG (무압축 deflate 블록). rgba = width * height * 4, 위 행부터
+    void writePng(const std::string& path, uint32_t width, uint32_t height, const std::vector<uint8_t>& rgba);
+
+    // 32-bit float RGB OpenEXR (scanline, NO_COMPRESSION). rgb = width * height * 3, 위 행부터
+    void writeExr(const std::string& path, uint32_t width, uint32_t height, const std::vector<float>& rgb);
+
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "RefScene.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Prism {
+
+    struct RefRay {
+        Float3 origin;
+        Float3 dir;
+        float tMin = 0.001f;
+        float tMax = 10000.0f;
+    };
+
+    struct RefHit {
+        float t = 0.0f;
+        uint32_t prim = 0;
+        float u = 0.0f, v = 0.0f;       // = hitAttributeEXT (bary = 1-u-v, u, v)
+    };
+
+    // 4-wide BVH (BVH4). 이진 binned-SAH 로 만든 뒤 자식 4 개씩 묶어 접음
+    // 노드의 자식 박스 4 개를 SoA 로 저장해 광선 하나로 박스 4 개를 SSE 한 번에 검사 (SSE 가 없으면 같은 식을 스칼라로)
+    // 삼각형은 양면, 불투명 (gl_RayFlagsOpaqueEXT). 인스턴스 마스크는 삼각형마다 복사해 두고 cullMask 와 겹칠 때만 검사
+    class RefBvh {
+    public:
+        static constexpr int kWidth = 4;
+        static constexpr uint32_t kMaxLeafSize = 4;
+
+        void build(const RefScene& scene);
+
+        // anyHit = gl_RayFlagsTerminateOnFirstHitEXT (그림자 광선). 맞으면 hit 에 가장 가까운 (anyHit 이면 처음 찾은) 교차
+        bool intersect(const RefRay& ray, uint8_t cullMask, bool anyHit, RefHit& hit) const;
+
+        uint32_t nodeCount() const { return static_cast<uint32_t>(nodes.size()); }
+        uint32_t maxDepth() const { return depth; }
+        static const char* simdName();
+
+    private:
+        struct alignas(16) Node {
+            float boxMin[3][kWidth];        // [axis][child]
+            float boxMax[3][kWidth];
+            uint32_t child[kWidth];         // count == 0 이면 자식 노드 인덱스, 아니면 첫 삼각형 인덱스
+            uint32_t count[kWidth];         // 잎 삼각형 수
+            uint32_t validMask = 0;         // 비어 있지 않은 슬롯 비트
+        };
+
+        struct Triangle {
+            Float3 v0, e1, e2;
+            uint32_t prim;                  // RefScene 삼각형 인덱스
+            uint8_t mask;
+        };
+
+        struct BuildNode {
+            Float3 boxMin, boxMax;
+            uint32_t left = 0, right = 0;
+            uint32_t start = 0, count = 0;  // count > 0 이면 잎
+        };
+
+        uint32_t buildBinary(std::vector<BuildNode>& out, std::vector<uint32_t>& order,
+                             const std::vector<Float3>& centroids, const std::vector<Float3>& boxMin,
+                             const std::vector<Float3>& boxMax, uint32_t start, uint32_t count);
+        uint32_t collapse(const std::vector<BuildNode>& binary, uint32_t index, uint32_t level);
+
+        std::vector<Node> nodes;
+        std::vector<Triangle> triangles;
+        uint32_t depth = 0;
+    };
+
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "PrismDenoiseParams.h"
+#include "PrismScene.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Prism {
+
+    // 디노이저 edge-stopping 입력 (GPU 의 G-Buffer normal / material + surface 이미지 거리)
+    // 픽셀 중심 1st hit 기준, 위 행부터. 하늘 픽셀은 distance < 0
+    struct RefGBuffer {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<Float3> normal;         // 월드 법선 (GPU 는 view-space 지만 dot 만 쓰므로 같음)
+        std::vector<float> distance;        // 카메라 ~ 1st hit 거리
+        std::vector<float> roughness;       // gbufferMaterial.r
+        std::vector<float> metallic;        // gbufferMaterial.g
+    };
+
+    // svgf_variance.comp + svgf_atrous.comp 의 CPU 버전 (같은 식, 같은 DenoiseParams)
+    // rgb = 누적 선형 radiance (width * height * 3). 결과도 같은 형식 (톤매핑 전)
+    // 셰이더를 고치면 이 파일(RefDenoiser.cpp) 도 같이 고칠 것
+    std::vector<float> denoiseSvgf(const std::vector<float>& rgb, const RefGBuffer& gbuffer, const DenoiseParams& params);
+
+    // 이미지 비교 (선형 radiance RMSE). 크기가 다르면 예외
+    double imageRmse(const std::vector<float>& a, const std::vector<float>& b);
+
+}
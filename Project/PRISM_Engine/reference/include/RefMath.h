@@ -0,0 +1,51 @@
+#pragma once
+
+#include "PrismScene.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// GLSL 내장 함수와 같은 의미의 float3 연산 (raygenbsdf.rgen 을 줄 단위로 옮길 수 있도록)
+
+namespace Prism {
+
+    inline Float3 operator+(const Float3& a, const Float3& b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+    inline Float3 operator-(const Float3& a, const Float3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+    inline Float3 operator-(const Float3& a) { return { -a.x, -a.y, -a.z }; }
+    inline Float3 operator*(const Float3& a, const Float3& b) { return { a.x * b.x, a.y * b.y, a.z * b.z }; }
+    inline Float3 operator*(const Float3& a, float s) { return { a.x * s, a.y * s, a.z * s }; }
+    inline Float3 operator*(float s, const Float3& a) { return { a.x * s, a.y * s, a.z * s }; }
+    inline Float3 operator/(const Float3& a, const Float3& b) { return { a.x / b.x, a.y / b.y, a.z / b.z }; }
+    inline Float3 operator/(const Float3& a, float s) { return { a.x / s, a.y / s, a.z / s }; }
+    inline Float3& operator+=(Float3& a, const Float3& b) { a = a + b; return a; }
+    inline Float3& operator*=(Float3& a, const Float3& b) { a = a * b; return a; }
+    inline Float3& operator/=(Float3& a, float s) { a = a / s; return a; }
+
+    inline Float3 splat(float s) { return { s, s, s }; }
+    inline float dot(const Float3& a, const Float3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    inline Float3 cross(const Float3& a, const Float3& b) {
+        return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+    }
+    inline float length(const Float3& a) { return std::sqrt(dot(a, a)); }
+    inline Float3 normalize(const Float3& a) { return a / length(a); }
+    inline Float3 min(const Float3& a, const Float3& b) { return { std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z) }; }
+    inline Float3 max(const Float3& a, const Float3& b) { return { std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z) }; }
+    inline Float3 min(const Float3& a, float s) { return min(a, splat(s)); }
+    inline Float3 mix(const Float3& a, const Float3& b, float t) { return a + (b - a) * t; }
+    inline float mix(float a, float b, float t) { return a + (b - a) * t; }
+    inline float clamp(float v, float lo, float hi) { return std::min(std::max(v, lo), hi); }
+    inline float sign(float v) { return float(v > 0.0f) - float(v < 0.0f); }
+    inline float component(const Float3& a, int axis) { return axis == 0 ? a.x : (axis == 1 ? a.y : a.z); }
+
+    inline Float3 reflect(const Float3& i, const Float3& n) { return i - n * (2.0f * dot(n, i)); }
+    inline Float3 refract(const Float3& i, const Float3& n, float eta) {
+        float ni = dot(n, i);
+        float k = 1.0f - eta * eta * (1.0f - ni * ni);
+        if (k < 0.0f) return {};
+        return i * eta - n * (eta * ni + std::sqrt(k));
+    }
+
+    inline bool isFinite(const Float3& a) { return std::isfinite(a.x) && std::isfinite(a.y) && std::isfinite(a.z); }
+
+}
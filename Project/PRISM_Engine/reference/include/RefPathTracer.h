@@ -0,0 +1,105 @@
+#pragma once
+
+#include "PrismAdaptiveParams.h"
+#include "PrismPathParams.h"
+#include "PrismWavefrontQueues.h"
+#include "RefBvh.h"
+#include "RefDenoiser.h"
+#include "RefScene.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Prism {
+
+    struct RenderSettings {
+        uint32_t width = 1280;
+        uint32_t height = 720;
+        uint32_t spp = 64;              // 픽셀당 샘플 = GPU 누적 프레임 수
+        uint32_t threads = 0;           // 0 이면 hardware_concurrency
+        uint32_t tileSize = 16;
+        uint32_t frameOffset = 0;       // 샘플 s 의 시드는 frameCount = frameOffset + s (GPU 와 같은 시드 규칙)
+
+        // true : renderMode 1/2 하이브리드 경로와 G-Buffer 기반 바운스 수(path.maxBounces / 3)를 raygenbsdf.rgen 그대로 따름
+        // false: 모든 오브젝트를 mode 0 (풀 PT) 로, 바운스 수는 path.maxBounces 고정 (오프라인 정답 이미지용)
+        bool hybridModes = true;
+        // 경로 종료 (바운스 상한 + Russian roulette). 재질별 깊이는 InstanceMaterial.pbrParams1.w 를 GPU 와 같이 따름
+        PathTerminationParams path;
+
+        // true: light BVH 대신 광원을 균등 확률로 고름 (다광원 샘플링 비교용, GPU 에는 없는 경로)
+        bool uniformLightSelection = false;
+
+        // raygenbsdf.rgen 의 적응형 샘플링 (spp = 프레임 수, 프레임마다 픽셀별 경로 0 ~ maxSamples). 기본은 꺼짐 (프레임당 1 경로)
+        AdaptiveSamplingParams adaptive{ false };
+    };
+
+    struct RenderStats {
+        uint32_t threads = 0;
+        uint32_t tiles = 0;
+        uint64_t samples = 0;           // 경로 (= 카메라 광선) 수. 적응형이 꺼져 있으면 픽셀 수 * spp
+        uint64_t pixels = 0;
+        uint64_t convergedPixels = 0;   // 적응형 샘플링: 마지막 프레임 기준 수렴 (경로 0) 픽셀 수
+        uint64_t rays = 0;              // 그림자 광선 포함 전체 광선 수
+        uint64_t pathSegments = 0;      // 경로 세그먼트 (1st hit + 바운스 광선) 수
+        uint64_t rouletteTerminations = 0;
+        uint64_t steals = 0;            // 다른 스레드에서 훔친 타일 수
+        double seconds = 0.0;
+
+        double samplesPerSecond() const { return seconds > 0.0 ? samples / seconds : 0.0; }
+        double raysPerSecond() const { return seconds > 0.0 ? rays / seconds : 0.0; }
+        double pathsPerPixel() const { return pixels ? double(samples) / double(pixels) : 0.0; }
+        double convergedPercent() const { return pixels ? 100.0 * double(convergedPixels) / double(pixels) : 0.0; }
+        double averagePathLength() const { return samples ? double(pathSegments) / double(samples) : 0.0; }
+        double roulettePercent() const { return samples ? 100.0 * double(rouletteTerminations) / double(samples) : 0.0; }
+    };
+
+    // raygenbsdf.rgen + closesthitbsdf.rchit 의 CPU 버전 (GPU 없는 환경에서 검증 / 오프라인 렌더)
+    // 셰이더의 샘플링, Disney BSDF, NEE, 클램프, 누적 규칙을 그대로 옮겼으므로 같은 spp 에서 통계적으로 같은 이미지가 나와야 함
+    // 셰이더를 고치면 이 파일(RefPathTracer.cpp) 도 같이 고칠 것
+    //
+    // GPU 와 다른 점: mode 2 의 G-Buffer 래스터 색 (OGRE PBS 셰이딩) 은 CPU 에서 만들 수 없으므로
+    // mode 1 의 직접조명 + ambient (그림자 제외) 로 대신함
+    class RefPathTracer {
+    public:
+        // BVH 를 만듦. scene 은 참조로 들고 있으므로 RefPathTracer 보다 오래 살아야 함
+        explicit RefPathTracer(const RefScene& scene);
+
+        // outRgb = 누적된 선형 radiance (accumImage 와 같은 값), width * height * 3, 위 행부터
+        RenderStats render(const RenderSettings& settings, std::vector<float>& outRgb) const;
+
+        // 같은 이미지를 wavefront 단계 (PrismWavefront, wavefront_*.rgen / wavefront_*.comp) 로 렌더
+        // 프레임마다 화면 전체 경로를 GpuWavefrontPath 배열 + 큐 (PrismWavefrontQueues.h) 로 돌리고 단계마다 큐를 스레드에 나눔
+        // 적응형이어도 프레임당 픽셀 경로는 최대 1 (GPU wavefront 와 같음). wavefrontStats 가 있으면 큐 / bin 통계를 채움
+        RenderStats renderWavefront(const RenderSettings& settings, std::vector<float>& outRgb,
+                                    WavefrontStats* wavefrontStats = nullptr) const;
+
+        // 디노이저 입력: 픽셀 중심 1st hit 의 법선 / 거리 / G-Buffer 재질 (래스터 G-Buffer 와 같은 값)
+        void renderGBuffer(const RenderSettings& settings, RefGBuffer& out) const;
+
+        // raygenbsdf.rgen 의 최종 출력과 같은 톤매핑 (exposure 2.5, gamma 2.2) → RGBA8
+        static std::vector<uint8_t> tonemap(const std::vector<float>& rgb);
+
+        const RefBvh& bvh() const { return accel; }
+
+    private:
+        struct Payload;
+        struct Counters;
+        struct WavefrontQueues;
+
+        bool trace(const RefRay& ray, bool hybridModes, Payload& payload, Counters& counters) const;
+        bool occluded(const RefRay& ray, Counters& counters) const;
+        int32_t pickLight(const RenderSettings& settings, const Float3& P, const Float3& N, float u, float& pmf) const;
+        float pickLightPmf(const RenderSettings& settings, int32_t light, const Float3& P, const Float3& N) const;
+        int primaryBounces(const RenderSettings& settings, uint32_t x, uint32_t y, Counters& counters) const;
+        Float3 tracePath(const RenderSettings& settings, uint32_t x, uint32_t y, uint32_t& seed, int maxBounces, Counters& counters) const;
+
+        // wavefront 단계 (RefWavefront.cpp). path = 경로 (= 픽셀) 인덱스
+        void wavefrontGenerate(const RenderSettings& settings, WavefrontQueues& queues, uint32_t path, int maxBounces, Counters& counters) const;
+        void wavefrontShade(const RenderSettings& settings, WavefrontQueues& queues, uint32_t path, Counters& counters) const;
+        void wavefrontTrace(const RenderSettings& settings, WavefrontQueues& queues, uint32_t path, Counters& counters) const;
+
+        const RefScene& scene;
+        RefBvh accel;
+    };
+
+}
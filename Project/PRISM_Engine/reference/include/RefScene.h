@@ -0,0 +1,36 @@
+#pragma once
+
+#include "PrismLights.h"
+#include "PrismScene.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Prism {
+
+    // SceneObject 목록을 월드 공간 삼각형 하나로 펼친 씬 (인스턴스 변환을 미리 적용)
+    // GPU 쪽 TLAS/BLAS 와 같은 결과: 위치 = T * S * p, 법선 = normalize(n * WorldToObject) = normalize(n / scale)
+    struct RefScene {
+        // 삼각형별
+        std::vector<Float3> v0, v1, v2;
+        std::vector<Float3> n0, n1, n2;         // 정점 법선 (월드, 정규화)
+        std::vector<uint32_t> objectIds;        // = gl_InstanceCustomIndexEXT
+        std::vector<uint32_t> primitiveIds;     // = gl_PrimitiveID (오브젝트 메시 안에서의 삼각형 번호)
+
+        // 오브젝트별 (SceneObject 순서)
+        std::vector<InstanceMaterial> materials;
+        std::vector<uint8_t> instanceMasks;     // main.cpp 와 동일: emissive 면 0x02, 아니면 0xFF
+
+        LightSet lights;                        // RTPipeline 바인딩 13, 14 와 같은 광원 목록 + light BVH
+
+        SceneCamera camera;
+
+        uint32_t triangleCount() const { return static_cast<uint32_t>(v0.size()); }
+    };
+
+    // OBJ 를 읽어 (같은 경로는 한 번만) 펼침. 읽지 못한 모델은 경고 후 건너뜀 (오브젝트 인덱스는 유지)
+    // 광원 목록도 main.cpp 와 같이 buildLightSet 으로 만들고 재질에 광원 오프셋을 기록
+    RefScene buildRefScene(const std::vector<SceneObject>& objects, const SceneCamera& camera,
+                           const std::vector<PointLightDesc>& pointLights = {});
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Prism {
+
+    // 타일 work stealing
+    // 타일을 스레드 수만큼 연속 구간으로 나눠 스레드별 deque 에 넣고, 각 스레드는 자기 deque 앞에서 꺼냄.
+    // 비면 다른 스레드 deque 의 뒤(주인이 가장 늦게 볼 타일)에서 훔침. 유리/거울처럼 비싼 영역이 한 스레드에
+    // 몰려도 남는 스레드가 나눠 가지므로 정적 분할보다 끝나는 시점이 고름
+    class TileScheduler {
+    public:
+        TileScheduler(uint32_t tileCount, uint32_t threadCount);
+
+        // 더 이상 남은 타일이 없으면 false
+        bool next(uint32_t thread, uint32_t& outTile);
+
+        uint64_t stealCount() const { return steals.load(std::memory_order_relaxed); }
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<uint32_t> tiles;
+        };
+
+        std::vector<std::unique_ptr<Queue>> queues;
+        std::atomic<uint64_t> steals{ 0 };
+    };
+
+}
@@ -0,0 +1,168 @@
+#include "ImageIO.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace Prism {
+
+    namespace {
+
+        void putBE32(std::vector<uint8_t>& out, uint32_t v) {
+            out.push_back(uint8_t(v >> 24)); out.push_back(uint8_t(v >> 16));
+            out.push_back(uint8_t(v >> 8));  out.push_back(uint8_t(v));
+        }
+
+        template<typename T>
+        void putLE(std::vector<uint8_t>& out, T v) {
+            uint8_t bytes[sizeof(T)];
+            std::memcpy(bytes, &v, sizeof(T));      // EXR 은 리틀 엔디언 (x86 / ARM 기준)
+            out.insert(out.end(), bytes, bytes + sizeof(T));
+        }
+
+        void putString(std::vector<uint8_t>& out, const char* s) {
+            out.insert(out.end(), s, s + std::strlen(s) + 1);
+        }
+
+        uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0) {
+            static uint32_t table[256] = {};
+            if (!table[1]) {
+                for (uint32_t n = 0; n < 256; n++) {
+                    uint32_t c = n;
+                    for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                    table[n] = c;
+                }
+            }
+            crc = ~crc;
+            for (size_t i = 0; i < size; i++) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+            return ~crc;
+        }
+
+        void putChunk(std::vector<uint8_t>& out, const char* type, const std::vector<uint8_t>& data) {
+            putBE32(out, static_cast<uint32_t>(data.size()));
+            size_t typeStart = out.size();
+            out.insert(out.end(), type, type + 4);
+            out.insert(out.end(), data.begin(), data.end());
+            putBE32(out, crc32(out.data() + typeStart, out.size() - typeStart));
+        }
+
+        void writeFile(const std::string& path, const std::vector<uint8_t>& bytes) {
+            std::ofstream file(path, std::ios::binary);
+            if (!file.is_open()) {
+                throw std::runtime_error("Failed to open image file for writing: " + path);
+            }
+            file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            if (!file) {
+                throw std::runtime_error("Failed to write image file: " + path);
+            }
+        }
+
+    }
+
+    void writePng(const std::string& path, uint32_t width, uint32_t height, const std::vector<uint8_t>& rgba) {
+        if (rgba.size() != size_t(width) * height * 4) {
+            throw std::runtime_error("PNG pixel buffer size does not match the image size!");
+        }
+
+        // 행마다 필터 바이트(0 = None) + RGBA
+        const size_t stride = size_t(width) * 4;
+        std::vector<uint8_t> raw;
+        raw.reserve((stride + 1) * height);
+        for (uint32_t y = 0; y < height; y++) {
+            raw.push_back(0);
+            raw.insert(raw.end(), rgba.begin() + y * stride, rgba.begin() + (y + 1) * stride);
+        }
+
+        // zlib: 헤더 + 무압축 deflate 블록 (최대 65535 바이트) + Adler-32
+        std::vector<uint8_t> zlib = { 0x78, 0x01 };
+        size_t offset = 0;
+        do {
+            size_t len = std::min<size_t>(65535, raw.size() - offset);
+            bool last = offset + len == raw.size();
+            zlib.push_back(last ? 1 : 0);
+            zlib.push_back(uint8_t(len)); zlib.push_back(uint8_t(len >> 8));
+            zlib.push_back(uint8_t(~len)); zlib.push_back(uint8_t(~len >> 8));
+            zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + len);
+            offset += len;
+        } while (offset < raw.size());
+        uint32_t a = 1, b = 0;
+        for (uint8_t byte : raw) { a = (a + byte) % 65521u; b = (b + a) % 65521u; }
+        putBE32(zlib, (b << 16) | a);
+
+        std::vector<uint8_t> ihdr;
+        putBE32(ihdr, width);
+        putBE32(ihdr, height);
+        ihdr.insert(ihdr.end(), { 8, 6, 0, 0, 0 });     // 8-bit, RGBA, deflate, 필터 0, 인터레이스 없음
+
+        std::vector<uint8_t> png = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        putChunk(png, "IHDR", ihdr);
+        putChunk(png, "IDAT", zlib);
+        putChunk(png, "IEND", {});
+        writeFile(path, png);
+    }
+
+    void writeExr(const std::string& path, uint32_t width, uint32_t height, const std::vector<float>& rgb) {
+        if (rgb.size() != size_t(width) * height * 3) {
+            throw std::runtime_error("EXR pixel buffer size does not match the image size!");
+        }
+
+        std::vector<uint8_t> exr;
+        putLE<uint32_t>(exr, 20000630u);                // magic 0x762f3101
+        putLE<uint32_t>(exr, 2u);                       // version 2, scanline
+
+        auto attribute = [&](const char* name, const char* type, uint32_t size) {
+            putString(exr, name);
+            putString(exr, type);
+            putLE<uint32_t>(exr, size);
+        };
+
+        // 채널 목록은 이름순 (B, G, R), FLOAT(2)
+        const char* channels[3] = { "B", "G", "R" };
+        attribute("channels", "chlist", 3 * (2 + 16) + 1);
+        for (const char* ch : channels) {
+            putString(exr, ch);
+            putLE<int32_t>(exr, 2);                     // pixel type FLOAT
+            putLE<uint32_t>(exr, 0);                    // pLinear + reserved
+            putLE<int32_t>(exr, 1);                     // xSampling
+            putLE<int32_t>(exr, 1);                     // ySampling
+        }
+        exr.push_back(0);
+
+        attribute("compression", "compression", 1);
+        exr.push_back(0);                               // NO_COMPRESSION
+        for (const char* window : { "dataWindow", "displayWindow" }) {
+            attribute(window, "box2i", 16);
+            putLE<int32_t>(exr, 0);
+            putLE<int32_t>(exr, 0);
+            putLE<int32_t>(exr, int32_t(width) - 1);
+            putLE<int32_t>(exr, int32_t(height) - 1);
+        }
+        attribute("lineOrder", "lineOrder", 1);
+        exr.push_back(0);                               // INCREASING_Y
+        attribute("pixelAspectRatio", "float", 4);
+        putLE<float>(exr, 1.0f);
+        attribute("screenWindowCenter", "v2f", 8);
+        putLE<float>(exr, 0.0f);
+        putLE<float>(exr, 0.0f);
+        attribute("screenWindowWidth", "float", 4);
+        putLE<float>(exr, 1.0f);
+        exr.push_back(0);                               // 헤더 끝
+
+        // 행 하나 = 블록 하나. 오프셋 테이블 뒤에 (y, 크기, B 행, G 행, R 행)
+        const uint32_t lineBytes = width * 3 * sizeof(float);
+        uint64_t blockStart = exr.size() + uint64_t(height) * sizeof(uint64_t);
+        for (uint32_t y = 0; y < height; y++) {
+            putLE<uint64_t>(exr, blockStart + uint64_t(y) * (8 + lineBytes));
+        }
+        for (uint32_t y = 0; y < height; y++) {
+            putLE<int32_t>(exr, int32_t(y));
+            putLE<uint32_t>(exr, lineBytes);
+            for (int c = 2; c >= 0; c--) {
+                for (uint32_t x = 0; x < width; x++) putLE<float>(exr, rgb[(size_t(y) * width + x) * 3 + c]);
+            }
+        }
+        writeFile(path, exr);
+    }
+
+}
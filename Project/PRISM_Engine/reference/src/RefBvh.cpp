@@ -0,0 +1,308 @@
+#include "RefBvh.h"
+#include "RefMath.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <numeric>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PRISM_REF_SSE 1
+#else
+#define PRISM_REF_SSE 0
+#endif
+
+namespace Prism {
+
+    namespace {
+
+        constexpr int kBinCount = 16;
+        constexpr int kStackSize = 256;
+
+        float surfaceArea(const Float3& lo, const Float3& hi) {
+            Float3 e = max(hi - lo, splat(0.0f));
+            return 2.0f * (e.x * e.y + e.y * e.z + e.z * e.x);
+        }
+
+        float safeInverse(float d) {
+            return 1.0f / (std::fabs(d) > 1e-12f ? d : std::copysign(1e-12f, d));
+        }
+
+    }
+
+    const char* RefBvh::simdName() {
+        return PRISM_REF_SSE ? "BVH4 / SSE2" : "BVH4 / scalar";
+    }
+
+    void RefBvh::build(const RefScene& scene) {
+        nodes.clear();
+        triangles.clear();
+        depth = 0;
+
+        const uint32_t count = scene.triangleCount();
+        if (count == 0) return;
+
+        std::vector<Float3> centroids(count), boxMin(count), boxMax(count);
+        for (uint32_t i = 0; i < count; i++) {
+            boxMin[i] = min(min(scene.v0[i], scene.v1[i]), scene.v2[i]);
+            boxMax[i] = max(max(scene.v0[i], scene.v1[i]), scene.v2[i]);
+            centroids[i] = (boxMin[i] + boxMax[i]) * 0.5f;
+        }
+
+        std::vector<uint32_t> order(count);
+        std::iota(order.begin(), order.end(), 0u);
+        std::vector<BuildNode> binary;
+        binary.reserve(2 * count / kMaxLeafSize + 1);
+        buildBinary(binary, order, centroids, boxMin, boxMax, 0, count);
+
+        // 잎 구간이 order 를 가리키므로 삼각형도 같은 순서로 정렬해 저장
+        triangles.resize(count);
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t p = order[i];
+            Triangle& t = triangles[i];
+            t.v0 = scene.v0[p];
+            t.e1 = scene.v1[p] - scene.v0[p];
+            t.e2 = scene.v2[p] - scene.v0[p];
+            t.prim = p;
+            t.mask = scene.instanceMasks[scene.objectIds[p]];
+        }
+
+        nodes.reserve(binary.size() / 2 + 1);
+        collapse(binary, 0, 0);
+    }
+
+    uint32_t RefBvh::buildBinary(std::vector<BuildNode>& out, std::vector<uint32_t>& order,
+                                 const std::vector<Float3>& centroids, const std::vector<Float3>& boxMin,
+                                 const std::vector<Float3>& boxMax, uint32_t start, uint32_t count) {
+        BuildNode node;
+        node.boxMin = splat(FLT_MAX);
+        node.boxMax = splat(-FLT_MAX);
+        Float3 cMin = splat(FLT_MAX), cMax = splat(-FLT_MAX);
+        for (uint32_t i = start; i < start + count; i++) {
+            uint32_t p = order[i];
+            node.boxMin = min(node.boxMin, boxMin[p]);
+            node.boxMax = max(node.boxMax, boxMax[p]);
+            cMin = min(cMin, centroids[p]);
+            cMax = max(cMax, centroids[p]);
+        }
+
+        const uint32_t index = static_cast<uint32_t>(out.size());
+        out.push_back(node);
+        if (count <= kMaxLeafSize) {
+            out[index].start = start;
+            out[index].count = count;
+            return index;
+        }
+
+        // 중심점 범위가 가장 긴 축에서 binned SAH
+        Float3 extent = cMax - cMin;
+        int axis = (extent.x > extent.y && extent.x > extent.z) ? 0 : (extent.y > extent.z ? 1 : 2);
+        float axisMin = component(cMin, axis);
+        float axisExtent = component(extent, axis);
+
+        uint32_t mid = start + count / 2;
+        if (axisExtent > 1e-8f) {
+            struct Bin { Float3 lo = splat(FLT_MAX), hi = splat(-FLT_MAX); uint32_t count = 0; };
+            Bin bins[kBinCount];
+            const float scale = kBinCount / axisExtent;
+            auto binOf = [&](uint32_t p) {
+                return std::min(kBinCount - 1, static_cast<int>((component(centroids[p], axis) - axisMin) * scale));
+            };
+            for (uint32_t i = start; i < start + count; i++) {
+                uint32_t p = order[i];
+                Bin& b = bins[binOf(p)];
+                b.lo = min(b.lo, boxMin[p]);
+                b.hi = max(b.hi, boxMax[p]);
+                b.count++;
+            }
+
+            // 왼쪽 누적 -> 오른쪽 누적을 돌며 분할 비용 lA*lN + rA*rN 최소
+            float leftCost[kBinCount - 1];
+            Float3 lo = splat(FLT_MAX), hi = splat(-FLT_MAX);
+            uint32_t n = 0;
+            for (int b = 0; b < kBinCount - 1; b++) {
+                lo = min(lo, bins[b].lo); hi = max(hi, bins[b].hi); n += bins[b].count;
+                leftCost[b] = n ? surfaceArea(lo, hi) * n : 0.0f;
+            }
+            lo = splat(FLT_MAX); hi = splat(-FLT_MAX); n = 0;
+            float bestCost = FLT_MAX;
+            int bestSplit = -1;
+            for (int b = kBinCount - 1; b > 0; b--) {
+                lo = min(lo, bins[b].lo); hi = max(hi, bins[b].hi); n += bins[b].count;
+                float cost = leftCost[b - 1] + (n ? surfaceArea(lo, hi) * n : 0.0f);
+                if (cost < bestCost) { bestCost = cost; bestSplit = b; }
+            }
+
+            auto it = std::partition(order.begin() + start, order.begin() + start + count,
+                                     [&](uint32_t p) { return binOf(p) < bestSplit; });
+            mid = static_cast<uint32_t>(it - order.begin());
+        }
+
+        // 한쪽이 비면 (중심점이 모두 같음 등) 중앙값 분할
+        if (mid == start || mid == start + count) {
+            mid = start + count / 2;
+            std::nth_element(order.begin() + start, order.begin() + mid, order.begin() + start + count,
+                             [&](uint32_t a, uint32_t b) { return component(centroids[a], axis) < component(centroids[b], axis); });
+        }
+
+        uint32_t left = buildBinary(out, order, centroids, boxMin, boxMax, start, mid - start);
+        uint32_t right = buildBinary(out, order, centroids, boxMin, boxMax, mid, start + count - mid);
+        out[index].left = left;
+        out[index].right = right;
+        return index;
+    }
+
+    uint32_t RefBvh::collapse(const std::vector<BuildNode>& binary, uint32_t index, uint32_t level) {
+        depth = std::max(depth, level + 1);
+
+        // 표면적이 가장 큰 내부 자식을 그 두 자식으로 바꾸는 것을 슬롯 4 개가 찰 때까지 반복
+        uint32_t slots[kWidth];
+        int used = 0;
+        const BuildNode& self = binary[index];
+        if (self.count > 0) {
+            slots[used++] = index;
+        } else {
+            slots[used++] = self.left;
+            slots[used++] = self.right;
+        }
+        while (used < kWidth) {
+            int best = -1;
+            float bestArea = -1.0f;
+            for (int k = 0; k < used; k++) {
+                const BuildNode& c = binary[slots[k]];
+                float area = surfaceArea(c.boxMin, c.boxMax);
+                if (c.count == 0 && area > bestArea) { bestArea = area; best = k; }
+            }
+            if (best < 0) break;
+            const BuildNode& c = binary[slots[best]];
+            slots[best] = c.left;
+            slots[used++] = c.right;
+        }
+
+        const uint32_t nodeIndex = static_cast<uint32_t>(nodes.size());
+        nodes.emplace_back();
+
+        Node node{};
+        for (int k = 0; k < used; k++) {
+            const BuildNode& c = binary[slots[k]];
+            node.boxMin[0][k] = c.boxMin.x; node.boxMin[1][k] = c.boxMin.y; node.boxMin[2][k] = c.boxMin.z;
+            node.boxMax[0][k] = c.boxMax.x; node.boxMax[1][k] = c.boxMax.y; node.boxMax[2][k] = c.boxMax.z;
+            node.validMask |= 1u << k;
+            if (c.count > 0) {
+                node.child[k] = c.start;
+                node.count[k] = c.count;
+            } else {
+                node.child[k] = collapse(binary, slots[k], level + 1);   // nodes 가 재할당될 수 있으므로 node 는 지역 변수로
+                node.count[k] = 0;
+            }
+        }
+        nodes[nodeIndex] = node;
+        return nodeIndex;
+    }
+
+    bool RefBvh::intersect(const RefRay& ray, uint8_t cullMask, bool anyHit, RefHit& hit) const {
+        if (nodes.empty()) return false;
+
+        const Float3 inv{ safeInverse(ray.dir.x), safeInverse(ray.dir.y), safeInverse(ray.dir.z) };
+        float tMax = ray.tMax;
+        bool found = false;
+
+        uint32_t stack[kStackSize];
+        int sp = 0;
+        stack[sp++] = 0;
+
+#if PRISM_REF_SSE
+        const __m128 ox = _mm_set1_ps(ray.origin.x), oy = _mm_set1_ps(ray.origin.y), oz = _mm_set1_ps(ray.origin.z);
+        const __m128 ix = _mm_set1_ps(inv.x), iy = _mm_set1_ps(inv.y), iz = _mm_set1_ps(inv.z);
+        const __m128 tMinV = _mm_set1_ps(ray.tMin);
+#endif
+
+        while (sp > 0) {
+            const Node& node = nodes[stack[--sp]];
+
+            // 자식 박스 4 개 slab 검사
+            alignas(16) float tEnter[kWidth];
+            uint32_t mask;
+#if PRISM_REF_SSE
+            {
+                __m128 t0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.boxMin[0]), ox), ix);
+                __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.boxMax[0]), ox), ix);
+                __m128 lo = _mm_max_ps(_mm_min_ps(t0, t1), tMinV);
+                __m128 hi = _mm_min_ps(_mm_max_ps(t0, t1), _mm_set1_ps(tMax));
+                t0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.boxMin[1]), oy), iy);
+                t1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.boxMax[1]), oy), iy);
+                lo = _mm_max_ps(lo, _mm_min_ps(t0, t1));
+                hi = _mm_min_ps(hi, _mm_max_ps(t0, t1));
+                t0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.boxMin[2]), oz), iz);
+                t1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.boxMax[2]), oz), iz);
+                lo = _mm_max_ps(lo, _mm_min_ps(t0, t1));
+                hi = _mm_min_ps(hi, _mm_max_ps(t0, t1));
+                _mm_store_ps(tEnter, lo);
+                mask = static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(lo, hi))) & node.validMask;
+            }
+#else
+            mask = 0;
+            for (int k = 0; k < kWidth; k++) {
+                float lo = ray.tMin, hi = tMax;
+                for (int a = 0; a < 3; a++) {
+                    float o = component(ray.origin, a), i = component(inv, a);
+                    float t0 = (node.boxMin[a][k] - o) * i, t1 = (node.boxMax[a][k] - o) * i;
+                    lo = std::max(lo, std::min(t0, t1));
+                    hi = std::min(hi, std::max(t0, t1));
+                }
+                tEnter[k] = lo;
+                if (lo <= hi) mask |= 1u << k;
+            }
+            mask &= node.validMask;
+#endif
+            if (!mask) continue;
+
+            // 가까운 자식부터: 잎은 바로 검사 (tMax 를 빨리 줄임), 내부 노드는 먼 것부터 쌓아 가까운 것이 먼저 나오게
+            int sorted[kWidth];
+            int hitCount = 0;
+            for (int k = 0; k < kWidth; k++) {
+                if (!(mask & (1u << k))) continue;
+                int j = hitCount++;
+                while (j > 0 && tEnter[sorted[j - 1]] > tEnter[k]) { sorted[j] = sorted[j - 1]; j--; }
+                sorted[j] = k;
+            }
+
+            uint32_t inner[kWidth];
+            int innerCount = 0;
+            for (int s = 0; s < hitCount; s++) {
+                int k = sorted[s];
+                if (tEnter[k] > tMax) continue;
+                if (node.count[k] == 0) { inner[innerCount++] = node.child[k]; continue; }
+
+                for (uint32_t t = node.child[k]; t < node.child[k] + node.count[k]; t++) {
+                    const Triangle& tri = triangles[t];
+                    if (!(tri.mask & cullMask)) continue;
+
+                    // Moller-Trumbore (양면)
+                    Float3 p = cross(ray.dir, tri.e2);
+                    float det = dot(tri.e1, p);
+                    if (std::fabs(det) < 1e-12f) continue;
+                    float invDet = 1.0f / det;
+                    Float3 sv = ray.origin - tri.v0;
+                    float u = dot(sv, p) * invDet;
+                    if (u < 0.0f || u > 1.0f) continue;
+                    Float3 q = cross(sv, tri.e1);
+                    float v = dot(ray.dir, q) * invDet;
+                    if (v < 0.0f || u + v > 1.0f) continue;
+                    float dist = dot(tri.e2, q) * invDet;
+                    if (dist <= ray.tMin || dist >= tMax) continue;
+
+                    tMax = dist;
+                    hit.t = dist; hit.prim = tri.prim; hit.u = u; hit.v = v;
+                    found = true;
+                    if (anyHit) return true;
+                }
+            }
+            for (int s = innerCount - 1; s >= 0; s--) {
+                if (sp < kStackSize) stack[sp++] = inner[s];
+            }
+        }
+        return found;
+    }
+
+}
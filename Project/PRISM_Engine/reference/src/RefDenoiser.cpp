@@ -0,0 +1,161 @@
+#include "RefDenoiser.h"
+#include "RefMath.h"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace Prism {
+
+    namespace {
+
+        const float KERNEL[3] = { 3.0f / 8.0f, 1.0f / 4.0f, 1.0f / 16.0f };
+
+        float luminance(const Float3& c) { return dot(c, Float3{ 0.2126f, 0.7152f, 0.0722f }); }
+
+        // GPU 핑퐁 이미지 한 장 (rgb: 색, a: 분산)
+        struct Image4 {
+            std::vector<Float3> color;
+            std::vector<float> variance;
+        };
+
+        struct Pixels {
+            const RefGBuffer& gb;
+            int width, height;
+
+            bool inside(int x, int y) const { return x >= 0 && y >= 0 && x < width && y < height; }
+            size_t index(int x, int y) const { return size_t(y) * width + x; }
+        };
+
+        float normalWeight(const Float3& np, const Float3& nq, const DenoiseParams& params) {
+            return std::pow(std::max(dot(np, nq), 0.0f), params.phiNormal);
+        }
+
+        float depthWeight(float zp, float zq, float pixelDist, const DenoiseParams& params) {
+            return std::exp(-std::fabs(zp - zq) / (params.phiDepth * zp * pixelDist + 1e-4f));
+        }
+
+        // svgf_variance.comp
+        Image4 estimateVariance(const std::vector<Float3>& color, const Pixels& px, const DenoiseParams& params) {
+            Image4 out;
+            out.color = color;
+            out.variance.assign(color.size(), 0.0f);
+            for (int y = 0; y < px.height; y++) {
+                for (int x = 0; x < px.width; x++) {
+                    size_t p = px.index(x, y);
+                    float zp = px.gb.distance[p];
+                    if (zp < 0.0f) continue;
+
+                    float sumW = 0.0f, m1 = 0.0f, m2 = 0.0f;
+                    for (int dy = -1; dy <= 1; dy++) {
+                        for (int dx = -1; dx <= 1; dx++) {
+                            if (!px.inside(x + dx, y + dy)) continue;
+                            size_t q = px.index(x + dx, y + dy);
+                            float zq = px.gb.distance[q];
+                            if (zq < 0.0f) continue;
+
+                            float w = (dx == 0 && dy == 0) ? 1.0f
+                                : normalWeight(px.gb.normal[p], px.gb.normal[q], params)
+                                  * depthWeight(zp, zq, std::sqrt(float(dx * dx + dy * dy)), params);
+                            float l = luminance(color[q]);
+                            m1 += w * l; m2 += w * l * l; sumW += w;
+                        }
+                    }
+                    m1 /= sumW; m2 /= sumW;
+                    out.variance[p] = std::max(m2 - m1 * m1, 0.0f);
+                }
+            }
+            return out;
+        }
+
+        // svgf_atrous.comp 한 번
+        Image4 atrous(const Image4& in, int stepSize, const Pixels& px, const DenoiseParams& params) {
+            Image4 out = in;
+            for (int y = 0; y < px.height; y++) {
+                for (int x = 0; x < px.width; x++) {
+                    size_t p = px.index(x, y);
+                    float zp = px.gb.distance[p];
+                    if (zp < 0.0f) continue;        // 하늘은 필터링하지 않음
+
+                    float lp = luminance(in.color[p]);
+                    float filteredVar = 0.0f;
+                    for (int dy = -1; dy <= 1; dy++) {
+                        for (int dx = -1; dx <= 1; dx++) {
+                            int qx = std::min(std::max(x + dx, 0), px.width - 1);
+                            int qy = std::min(std::max(y + dy, 0), px.height - 1);
+                            float k = (dx == 0 ? 0.5f : 0.25f) * (dy == 0 ? 0.5f : 0.25f);
+                            filteredVar += k * in.variance[px.index(qx, qy)];
+                        }
+                    }
+                    float sigmaL = params.phiColor * std::sqrt(std::max(filteredVar, 0.0f)) + 1e-6f;
+
+                    float sumW = KERNEL[0] * KERNEL[0];
+                    Float3 sumC = in.color[p] * sumW;
+                    float sumV = in.variance[p] * sumW * sumW;
+                    for (int dy = -2; dy <= 2; dy++) {
+                        for (int dx = -2; dx <= 2; dx++) {
+                            if (dx == 0 && dy == 0) continue;
+                            int qx = x + dx * stepSize, qy = y + dy * stepSize;
+                            if (!px.inside(qx, qy)) continue;
+                            size_t q = px.index(qx, qy);
+                            float zq = px.gb.distance[q];
+                            if (zq < 0.0f) continue;
+
+                            float pixelDist = float(stepSize) * std::sqrt(float(dx * dx + dy * dy));
+                            float wn = normalWeight(px.gb.normal[p], px.gb.normal[q], params);
+                            float wz = depthWeight(zp, zq, pixelDist, params);
+                            float wm = std::exp(-(std::fabs(px.gb.roughness[p] - px.gb.roughness[q])
+                                                + std::fabs(px.gb.metallic[p] - px.gb.metallic[q])) / params.phiMaterial);
+                            float wl = std::exp(-std::fabs(lp - luminance(in.color[q])) / sigmaL);
+                            float w = KERNEL[std::abs(dx)] * KERNEL[std::abs(dy)] * wn * wz * wm * wl;
+
+                            sumC += in.color[q] * w;
+                            sumV += w * w * in.variance[q];
+                            sumW += w;
+                        }
+                    }
+                    out.color[p] = sumC / sumW;
+                    out.variance[p] = sumV / (sumW * sumW);
+                }
+            }
+            return out;
+        }
+
+    }
+
+    std::vector<float> denoiseSvgf(const std::vector<float>& rgb, const RefGBuffer& gbuffer, const DenoiseParams& params) {
+        const size_t count = size_t(gbuffer.width) * gbuffer.height;
+        if (rgb.size() != count * 3 || gbuffer.normal.size() != count || gbuffer.distance.size() != count
+            || gbuffer.roughness.size() != count || gbuffer.metallic.size() != count) {
+            throw std::runtime_error("Denoiser input size does not match the G-Buffer size!");
+        }
+
+        std::vector<Float3> color(count);
+        for (size_t i = 0; i < count; i++) color[i] = { rgb[i * 3], rgb[i * 3 + 1], rgb[i * 3 + 2] };
+
+        Pixels px{ gbuffer, int(gbuffer.width), int(gbuffer.height) };
+        Image4 image = estimateVariance(color, px, params);
+        for (int i = 0; i < std::max(params.iterations, 1); i++) {
+            image = atrous(image, 1 << i, px, params);
+        }
+
+        std::vector<float> out(count * 3);
+        for (size_t i = 0; i < count; i++) {
+            out[i * 3] = image.color[i].x; out[i * 3 + 1] = image.color[i].y; out[i * 3 + 2] = image.color[i].z;
+        }
+        return out;
+    }
+
+    double imageRmse(const std::vector<float>& a, const std::vector<float>& b) {
+        if (a.size() != b.size()) {
+            throw std::runtime_error("Cannot compare images of different sizes!");
+        }
+        if (a.empty()) return 0.0;
+        double sum = 0.0;
+        for (size_t i = 0; i < a.size(); i++) {
+            double d = double(a[i]) - double(b[i]);
+            sum += d * d;
+        }
+        return std::sqrt(sum / double(a.size()));
+    }
+
+}
@@ -0,0 +1,426 @@
+#include "RefPathTracer.h"
+#include "RefMath.h"
+#include "RefShading.h"
+#include "TileScheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace Prism {
+
+    using namespace shading;
+
+    RefPathTracer::RefPathTracer(const RefScene& scene) : scene(scene) {
+        accel.build(scene);
+    }
+
+    // closesthitbsdf.rchit + miss.rmiss
+    bool RefPathTracer::trace(const RefRay& ray, bool hybridModes, Payload& payload, Counters& counters) const {
+        counters.rays++;
+        RefHit hit;
+        if (!accel.intersect(ray, 0xFF, false, hit)) {
+            payload.hitT = -1.0f;
+            return false;
+        }
+
+        const uint32_t p = hit.prim;
+        const Float3 bary{ 1.0f - hit.u - hit.v, hit.u, hit.v };
+        Float3 worldNormal = normalize(scene.n0[p] * bary.x + scene.n1[p] * bary.y + scene.n2[p] * bary.z);
+        Float3 worldGeomNormal = normalize(cross(scene.v1[p] - scene.v0[p], scene.v2[p] - scene.v0[p]));
+        // cube.obj Top/Bottom face 의 와인딩 순서로 인해 geomNormal 이 정점 노말과 반대가 되는 경우 수정
+        if (dot(worldGeomNormal, worldNormal) < 0.0f) worldGeomNormal = -worldGeomNormal;
+
+        const InstanceMaterial& mat = scene.materials[scene.objectIds[p]];
+        const Float3 albedo{ mat.albedo[0], mat.albedo[1], mat.albedo[2] };
+
+        payload.hitPos     = ray.origin + ray.dir * hit.t;
+        payload.normal     = worldNormal;
+        payload.geomNormal = worldGeomNormal;
+        payload.hitT       = hit.t;
+        payload.maxDepth   = int(mat.pbrParams1[3]);
+
+        if (hybridModes && mat.pbrParams2[2] > 0.5f) {
+            payload.isRaster  = mat.pbrParams2[2];
+            payload.albedo    = albedo;
+            payload.roughness = std::max(mat.pbrParams1[1], 0.04f);
+            payload.metallic  = mat.pbrParams1[2];
+            payload.emissive  = {};
+            payload.specTrans = 0.0f;
+            payload.ior       = 1.5f;
+            payload.lightId   = -1;
+            return true;
+        }
+
+        // 면광원은 한 면(정점 법선 쪽)만 발광 → light BVH 의 삼각형 광원과 같은 규칙
+        bool frontFace = dot(worldNormal, ray.dir) < 0.0f;
+        payload.isRaster  = 0.0f;
+        payload.albedo    = albedo;
+        payload.roughness = mat.pbrParams1[1];
+        payload.metallic  = mat.pbrParams1[2];
+        payload.emissive  = frontFace ? albedo * mat.pbrParams1[0] : Float3{};
+        payload.lightId   = mat.pbrParams2[3] >= 0.0f ? int32_t(mat.pbrParams2[3]) + int32_t(scene.primitiveIds[p]) : -1;
+        payload.specTrans = mat.pbrParams2[0];
+        payload.ior       = mat.pbrParams2[1] > 0.0f ? mat.pbrParams2[1] : 1.5f;
+        return true;
+    }
+
+    bool RefPathTracer::occluded(const RefRay& ray, Counters& counters) const {
+        counters.rays++;
+        RefHit hit;
+        return accel.intersect(ray, kShadowCullMask, true, hit);
+    }
+
+    int32_t RefPathTracer::pickLight(const RenderSettings& settings, const Float3& P, const Float3& N, float u, float& pmf) const {
+        const uint32_t count = scene.lights.lightCount();
+        if (settings.uniformLightSelection) {
+            pmf = 1.0f / float(count);
+            return std::min(int32_t(u * float(count)), int32_t(count) - 1);
+        }
+        return sampleLightBvh(scene.lights, P, N, u, pmf);
+    }
+
+    float RefPathTracer::pickLightPmf(const RenderSettings& settings, int32_t light, const Float3& P, const Float3& N) const {
+        if (settings.uniformLightSelection) return 1.0f / float(scene.lights.lightCount());
+        return lightBvhPmf(scene.lights, light, P, N);
+    }
+
+    // G-Buffer(래스터 1st hit) 의 roughness / metallic 으로 바운스 수 결정. 래스터는 지터 없이 픽셀 중심
+    // HLMS 데이터블록은 roughness 를 0.02 이상으로, metallic 은 0.01 초과일 때만 넣음 (main.cpp)
+    int RefPathTracer::primaryBounces(const RenderSettings& settings, uint32_t x, uint32_t y, Counters& counters) const {
+        if (!settings.hybridModes) return settings.path.maxBounces;
+
+        RefRay ray;
+        ray.origin = scene.camera.eye;
+        ray.dir = cameraDir(scene.camera, settings, x + 0.5f, y + 0.5f);
+        counters.rays++;
+        RefHit hit;
+        if (!accel.intersect(ray, 0xFF, false, hit)) return settings.path.maxBounces;      // gbDataValid = false
+
+        float gbRoughness, gbMetallic;
+        gbufferMaterial(scene.materials[scene.objectIds[hit.prim]], gbRoughness, gbMetallic);
+        bool needsFullRT = (gbRoughness < 0.35f) || (gbMetallic > 0.30f);
+        return needsFullRT ? settings.path.maxBounces : std::min(3, settings.path.maxBounces);
+    }
+
+    // raygenbsdf.rgen 의 CameraRay + TracePath (경로 하나). 시드는 프레임 안에서 경로끼리 이어 씀
+    Float3 RefPathTracer::tracePath(const RenderSettings& settings, uint32_t x, uint32_t y, uint32_t& seed,
+                                    int maxBounces, Counters& counters) const {
+        float jx = rand(seed), jy = rand(seed);
+
+        Float3 rayOrigin = scene.camera.eye;
+        Float3 rayDir = cameraDir(scene.camera, settings, x + jx, y + jy);
+        Float3 throughput = splat(1.0f);
+        Float3 pixelColor{};
+        Payload payload;
+
+        // 직전 정점 (BSDF 샘플이 면광원에 맞았을 때 MIS 가중치 계산용)
+        bool   prevNee = false;
+        Float3 prevPos, prevN;
+        float  prevBsdfPdf = 0.0f;
+
+        for (int depth = 0; depth < maxBounces; depth++) {
+            counters.pathSegments++;
+            RefRay ray{ rayOrigin, rayDir, 0.001f, 10000.0f };
+            if (!trace(ray, settings.hybridModes, payload, counters)) {
+                pixelColor += throughput * kSkyColor;
+                break;
+            }
+
+            // ── [HYBRID] 래스터 오브젝트: shadow ray + specular RT bounce ─────────────────
+            if (depth == 0 && payload.isRaster > 0.5f) {
+                bool  modeB = payload.isRaster > 1.5f;
+                Float3 P1 = payload.hitPos, N1 = payload.normal, gN1 = payload.geomNormal, alb = payload.albedo;
+                float rou = payload.roughness, met = payload.metallic;
+                Float3 V = -rayDir;
+
+                Float3 lightPos{ 0.0f, 11.5f, 0.0f };
+                Float3 toLightV = lightPos - P1;
+                float lightDist = length(toLightV);
+                toLightV = normalize(toLightV);
+                float NdotL = std::max(dot(N1, toLightV), 0.0f);
+
+                float shadow = 0.15f;
+                if (NdotL > 0.0f) {
+                    shadow = occluded({ P1 + gN1 * 0.005f, toLightV, 0.001f, lightDist - 0.05f }, counters) ? 0.15f : 1.0f;
+                }
+
+                Payload bp;
+                bp.albedo = alb; bp.roughness = rou; bp.metallic = met;
+                bp.specTrans = 0.0f; bp.ior = 1.5f;
+                Float3 unshadowed = EvaluateDisneyBRDF(bp, V, toLightV, N1) * (NdotL * 4.0f);
+                Float3 direct  = unshadowed * shadow;
+                Float3 ambient = alb * ((1.0f - met) * 0.05f);
+
+                Float3 specBounce{};
+                if (rou < 0.35f || met > 0.3f) {
+                    Float3 specDir = reflect(-V, N1);
+                    if (dot(N1, specDir) > 0.0f) {
+                        Payload sp;
+                        Float3 indirectSpec;
+                        if (!trace({ P1 + gN1 * 0.005f, specDir, 0.001f, 10000.0f }, settings.hybridModes, sp, counters)) {
+                            indirectSpec = kSkyColor;
+                        } else if (length(sp.emissive) > 0.001f) {
+                            indirectSpec = sp.emissive;
+                        } else {
+                            indirectSpec = sp.albedo * 0.3f;
+                        }
+                        Float3 F0v  = mix(splat(0.04f), alb, met);
+                        Float3 Fres = F0v + (splat(1.0f) - F0v) * std::pow(1.0f - std::max(dot(N1, V), 0.0f), 5.0f);
+                        specBounce = indirectSpec * Fres * (1.0f - rou);
+                    }
+                }
+
+                if (modeB) {
+                    // G-Buffer 래스터 색 대신 그림자를 뺀 mode 1 셰이딩 (헤더 주석 참고)
+                    Float3 rasterColor = unshadowed + ambient;
+                    pixelColor = rasterColor * shadow + specBounce;
+                } else {
+                    pixelColor = direct + ambient + specBounce;
+                }
+                break;
+            }
+            // ── [END HYBRID] ────────────────────────────────────────────────────────────
+
+            if (length(payload.emissive) > 0.0f) {
+                // 직전 정점에서 NEE 도 이 광원을 고를 수 있었으면 BSDF 샘플 몫만 더함
+                float misWeight = 1.0f;
+                if (prevNee && payload.lightId >= 0) {
+                    const GpuLightEntry& le = scene.lights.lights[payload.lightId];
+                    float cosL = dot(lightVec(le.normal), -rayDir);
+                    float lightPdf = cosL > 0.0f
+                        ? pickLightPmf(settings, payload.lightId, prevPos, prevN) * payload.hitT * payload.hitT / std::max(le.area * cosL, 1e-6f)
+                        : 0.0f;
+                    misWeight = powerHeuristic(prevBsdfPdf, lightPdf);
+                }
+                pixelColor += throughput * payload.emissive * misWeight;
+                break;
+            }
+
+            // ── NEE: light BVH 로 광원 하나를 골라 직접 샘플링 (면광원은 BSDF 샘플과 MIS) ──────────
+            bool neeDone = false;
+            {
+                bool inside = dot(payload.geomNormal, rayDir) > 0.0f;
+                if (!inside && scene.lights.lightCount() > 0) {
+                    neeDone = true;
+                    float uPick = rand(seed), xiL0 = rand(seed), xiL1 = rand(seed);
+                    float pickPdf = 0.0f;
+                    int32_t li = pickLight(settings, payload.hitPos, payload.normal, uPick, pickPdf);
+                    if (li >= 0 && pickPdf > 0.0f) {
+                        const GpuLightEntry& le = scene.lights.lights[li];
+                        bool isPoint = le.type == LIGHT_POINT;
+                        Float3 lPos = lightVec(le.v0);
+                        if (!isPoint) {
+                            // 삼각형 위 균등 샘플
+                            float su = std::sqrt(xiL0);
+                            float b0 = 1.0f - su, b1 = xiL1 * su;
+                            lPos = lightVec(le.v0) * b0 + lightVec(le.v1) * b1 + lightVec(le.v2) * (1.0f - b0 - b1);
+                        }
+                        Float3 toL = lPos - payload.hitPos;
+                        float lDist = length(toL);
+                        toL /= lDist;
+                        float NdL = std::max(dot(payload.normal, toL), 0.0f);
+                        float cosL = isPoint ? 1.0f : dot(lightVec(le.normal), -toL);
+
+                        if (NdL > 0.0f && cosL > 0.0f &&
+                            !occluded({ payload.hitPos + payload.geomNormal * 0.005f, toL, 0.001f, lDist - 0.05f }, counters)) {
+                            Float3 brdfNEE = EvaluateDisneyBRDF(payload, -rayDir, toL, payload.normal);
+                            Float3 Le = lightVec(le.emission);
+                            float lightPdf, misWeight;
+                            if (isPoint) {
+                                Le = Le / (lDist * lDist);
+                                lightPdf = pickPdf;
+                                misWeight = 1.0f;
+                            } else {
+                                lightPdf = pickPdf * (lDist * lDist) / std::max(le.area * cosL, 1e-6f);
+                                misWeight = powerHeuristic(lightPdf,
+                                    CalculateBSDF_PDF(payload, -rayDir, toL, 1.0f, payload.ior, payload.normal));
+                            }
+                            Float3 neeC = throughput * brdfNEE * Le * (NdL * misWeight / std::max(lightPdf, 0.001f));
+                            if (!std::isnan(neeC.x) && !std::isinf(neeC.x))
+                                pixelColor += min(neeC, 20.0f);     // firefly 방지
+                        }
+                    }
+                }
+            }
+
+            // 재질별 최대 깊이: 이 면에서 더 이어갈 수 없으면 NEE 까지만
+            if (payload.maxDepth > 0 && depth + 1 >= payload.maxDepth) break;
+
+            Float3 V = -rayDir;
+            float xi0 = rand(seed), xi1 = rand(seed);
+            Float3 L;
+            Float3 bsdfValue{};
+            bool isInside = dot(payload.geomNormal, rayDir) > 0.0f;
+            Float3 N = isInside ? -payload.normal : payload.normal;
+            Float3 geomN = isInside ? -payload.geomNormal : payload.geomNormal;
+            float eta_i = isInside ? payload.ior : 1.0f;
+            float eta_o = isInside ? 1.0f : payload.ior;
+            float probReflection = mix(0.5f, 1.0f, payload.metallic);
+            float probTransmission = (1.0f - probReflection) * payload.specTrans;
+            float probDiffuse = (1.0f - probReflection) * (1.0f - payload.specTrans);
+            float totalProb = probReflection + probTransmission + probDiffuse;
+            probReflection /= totalProb; probTransmission /= totalProb; probDiffuse /= totalProb;
+            float randVal = rand(seed);
+            if (randVal < probReflection) L = SampleGGX(xi0, xi1, payload.roughness, N, V);
+            else if (randVal < probReflection + probTransmission) L = SampleBTDF(xi0, xi1, payload.roughness, N, V, eta_i, eta_o);
+            else L = SampleCosineHemisphere(xi0, xi1, N);
+
+            if (dot(N, L) > 0.0f) bsdfValue = EvaluateDisneyBRDF(payload, V, L, N);
+            else bsdfValue = EvaluateDisneyBTDF(payload, V, L, eta_i, eta_o, N);
+
+            float pdf = CalculateBSDF_PDF(payload, V, L, eta_i, eta_o, N);
+            // NEE 는 바깥쪽 반구 (payload.normal 기준) 만 샘플하므로 그 방향일 때만 MIS
+            prevNee     = neeDone && dot(payload.normal, L) > 0.0f;
+            prevPos     = payload.hitPos;
+            prevN       = payload.normal;
+            prevBsdfPdf = pdf;
+            float cosTheta = std::max(std::fabs(dot(N, L)), 0.001f);
+            throughput *= bsdfValue * (cosTheta / std::max(pdf, 0.0001f));
+            const float epsilon = 0.005f;
+            float directionSign = sign(dot(geomN, L));
+            rayOrigin = payload.hitPos + geomN * (epsilon * directionSign);
+            rayDir = L;
+
+            // Russian roulette (확률 q 로 이어가고 1/q 보정). 어차피 마지막 세그먼트면 굴리지 않음
+            if (settings.path.russianRoulette && depth + 1 >= settings.path.rouletteMinDepth && depth + 1 < maxBounces) {
+                float q = rouletteSurvival(std::max(throughput.x, std::max(throughput.y, throughput.z)));
+                if (rand(seed) >= q) {
+                    counters.rouletteTerminations++;
+                    break;
+                }
+                throughput = throughput / q;
+            }
+        }
+
+        if (std::isnan(pixelColor.x) || std::isinf(pixelColor.x)) pixelColor = {};
+        return min(pixelColor, 10.0f);
+    }
+
+    RenderStats RefPathTracer::render(const RenderSettings& settings, std::vector<float>& outRgb) const {
+        const uint32_t width = settings.width, height = settings.height;
+        const uint32_t tileSize = std::max(settings.tileSize, 1u);
+        const uint32_t tilesX = (width + tileSize - 1) / tileSize;
+        const uint32_t tilesY = (height + tileSize - 1) / tileSize;
+        uint32_t threadCount = settings.threads ? settings.threads : std::thread::hardware_concurrency();
+        threadCount = std::max(threadCount, 1u);
+
+        outRgb.assign(size_t(width) * height * 3, 0.0f);
+        TileScheduler scheduler(tilesX * tilesY, threadCount);
+        std::atomic<uint64_t> totalSamples{ 0 }, totalRays{ 0 }, totalConverged{ 0 }, totalSegments{ 0 }, totalRoulette{ 0 };
+
+        auto worker = [&](uint32_t thread) {
+            Counters counters;
+            uint32_t tile;
+            while (scheduler.next(thread, tile)) {
+                uint32_t x0 = (tile % tilesX) * tileSize, y0 = (tile / tilesX) * tileSize;
+                uint32_t x1 = std::min(x0 + tileSize, width), y1 = std::min(y0 + tileSize, height);
+                for (uint32_t y = y0; y < y1; y++) {
+                    for (uint32_t x = x0; x < x1; x++) {
+                        int maxBounces = primaryBounces(settings, x, y, counters);
+
+                        // accumImage (rgb, a = historyLen) + varianceImage (rg = 휘도 모멘트) 의 픽셀 하나
+                        // 카메라가 고정이므로 재투영은 항상 같은 픽셀, maxHistory 상한 없음
+                        Float3 accum{};
+                        float historyLen = 0.0f, m1 = 0.0f, m2 = 0.0f;
+                        for (uint32_t f = 0; f < settings.spp; f++) {
+                            uint32_t frame = settings.frameOffset + f;
+                            uint32_t seed = y * settings.width + x + frame * 719393u;
+                            int paths = adaptiveSampleCount(settings.adaptive, historyLen, m1, m2, frame, x, y);
+                            if (paths == 0) continue;
+
+                            Float3 sum{};
+                            float lumSum = 0.0f, lum2Sum = 0.0f;
+                            for (int s = 0; s < paths; s++) {
+                                Float3 c = tracePath(settings, x, y, seed, maxBounces, counters);
+                                float l = luminance(c);
+                                sum += c; lumSum += l; lum2Sum += l * l;
+                            }
+                            counters.samples += uint64_t(paths);
+
+                            // GPU 의 mix(history, frameMean, paths / (n + paths)) 누적 = 경로 전체의 산술 평균
+                            historyLen += float(paths);
+                            float w = float(paths) / historyLen;
+                            accum = mix(accum, sum / float(paths), w);
+                            m1 = mix(m1, lumSum / float(paths), w);
+                            m2 = mix(m2, lum2Sum / float(paths), w);
+                        }
+                        if (adaptiveConverged(settings.adaptive, historyLen, m1, m2)) counters.convergedPixels++;
+
+                        float* dst = &outRgb[(size_t(y) * width + x) * 3];
+                        dst[0] = accum.x; dst[1] = accum.y; dst[2] = accum.z;
+                    }
+                }
+            }
+            totalSamples.fetch_add(counters.samples, std::memory_order_relaxed);
+            totalRays.fetch_add(counters.rays, std::memory_order_relaxed);
+            totalConverged.fetch_add(counters.convergedPixels, std::memory_order_relaxed);
+            totalSegments.fetch_add(counters.pathSegments, std::memory_order_relaxed);
+            totalRoulette.fetch_add(counters.rouletteTerminations, std::memory_order_relaxed);
+        };
+
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<std::thread> threads;
+        for (uint32_t t = 1; t < threadCount; t++) threads.emplace_back(worker, t);
+        worker(0);
+        for (auto& t : threads) t.join();
+        auto end = std::chrono::high_resolution_clock::now();
+
+        RenderStats stats;
+        stats.threads = threadCount;
+        stats.tiles = tilesX * tilesY;
+        stats.samples = totalSamples.load();
+        stats.rays = totalRays.load();
+        stats.pixels = uint64_t(width) * height;
+        stats.convergedPixels = totalConverged.load();
+        stats.pathSegments = totalSegments.load();
+        stats.rouletteTerminations = totalRoulette.load();
+        stats.steals = scheduler.stealCount();
+        stats.seconds = std::chrono::duration<double>(end - start).count();
+        return stats;
+    }
+
+    void RefPathTracer::renderGBuffer(const RenderSettings& settings, RefGBuffer& out) const {
+        const size_t count = size_t(settings.width) * settings.height;
+        out.width = settings.width;
+        out.height = settings.height;
+        out.normal.assign(count, Float3{});
+        out.distance.assign(count, -1.0f);
+        out.roughness.assign(count, 0.0f);
+        out.metallic.assign(count, 0.0f);
+
+        for (uint32_t y = 0; y < settings.height; y++) {
+            for (uint32_t x = 0; x < settings.width; x++) {
+                RefRay ray;
+                ray.origin = scene.camera.eye;
+                ray.dir = cameraDir(scene.camera, settings, x + 0.5f, y + 0.5f);
+                RefHit hit;
+                if (!accel.intersect(ray, 0xFF, false, hit)) continue;
+
+                const size_t i = size_t(y) * settings.width + x;
+                const uint32_t p = hit.prim;
+                const Float3 bary{ 1.0f - hit.u - hit.v, hit.u, hit.v };
+                out.normal[i] = normalize(scene.n0[p] * bary.x + scene.n1[p] * bary.y + scene.n2[p] * bary.z);
+                out.distance[i] = hit.t;
+                gbufferMaterial(scene.materials[scene.objectIds[p]], out.roughness[i], out.metallic[i]);
+            }
+        }
+    }
+
+    std::vector<uint8_t> RefPathTracer::tonemap(const std::vector<float>& rgb) {
+        const float exposure = 2.5f;
+        std::vector<uint8_t> rgba(rgb.size() / 3 * 4);
+        for (size_t i = 0; i < rgb.size() / 3; i++) {
+            for (int c = 0; c < 3; c++) {
+                float v = 1.0f - std::exp(-rgb[i * 3 + c] * exposure);
+                v = std::pow(v, 1.0f / 2.2f);
+                rgba[i * 4 + c] = static_cast<uint8_t>(std::lround(clamp(v, 0.0f, 1.0f) * 255.0f));
+            }
+            rgba[i * 4 + 3] = 255;
+        }
+        return rgba;
+    }
+
+}
@@ -0,0 +1,49 @@
+#include "RefScene.h"
+#include "PrismObjLoader.h"
+#include "RefMath.h"
+
+#include <iostream>
+#include <unordered_map>
+
+namespace Prism {
+
+    RefScene buildRefScene(const std::vector<SceneObject>& objects, const SceneCamera& camera,
+                           const std::vector<PointLightDesc>& pointLights) {
+        RefScene scene;
+        scene.camera = camera;
+
+        std::unordered_map<std::string, RawObj> meshCache;
+        for (size_t i = 0; i < objects.size(); i++) {
+            const SceneObject& obj = objects[i];
+            scene.materials.push_back(makeInstanceMaterial(obj));
+            scene.instanceMasks.push_back(obj.emissive > 0.0f ? 0x02u : 0xFFu);
+
+            auto it = meshCache.find(obj.modelPath);
+            if (it == meshCache.end()) it = meshCache.emplace(obj.modelPath, parseObj(obj.modelPath)).first;
+            const RawObj& raw = it->second;
+            if (raw.pos.empty()) {
+                std::cerr << "[PRISM] Empty mesh: " << obj.modelPath << std::endl;
+                continue;
+            }
+
+            auto toWorld = [&](const Float3& p) { return p * obj.scale + obj.position; };
+            auto toWorldNormal = [&](const Float3& n) { return normalize(n / obj.scale); };
+            for (size_t t = 0; t + 2 < raw.indices.size(); t += 3) {
+                uint32_t i0 = raw.indices[t], i1 = raw.indices[t + 1], i2 = raw.indices[t + 2];
+                scene.v0.push_back(toWorld(raw.pos[i0]));
+                scene.v1.push_back(toWorld(raw.pos[i1]));
+                scene.v2.push_back(toWorld(raw.pos[i2]));
+                scene.n0.push_back(toWorldNormal(raw.normals[i0]));
+                scene.n1.push_back(toWorldNormal(raw.normals[i1]));
+                scene.n2.push_back(toWorldNormal(raw.normals[i2]));
+                scene.objectIds.push_back(static_cast<uint32_t>(i));
+                scene.primitiveIds.push_back(static_cast<uint32_t>(t / 3));
+            }
+        }
+
+        scene.lights = buildLightSet(objects, pointLights);
+        applyLightOffsets(scene.lights, scene.materials);
+        return scene;
+    }
+
+}
@@ -0,0 +1,227 @@
+#pragma once
+
+#include "RefMath.h"
+#include "RefPathTracer.h"
+
+#include <algorithm>
+#include <cmath>
+
+// RefPathTracer 의 두 실행 방식이 같이 쓰는 셰이더 함수 / payload (라이브러리 내부 헤더)
+//   RefPathTracer.cpp : 메가커널 (raygenbsdf.rgen TracePath)
+//   RefWavefront.cpp  : wavefront (wavefront_*.rgen / wavefront_*.comp)
+// 셰이더를 고치면 이 파일도 같이 고칠 것
+
+namespace Prism {
+
+    // closesthitbsdf.rchit 의 HitPayload
+    struct RefPathTracer::Payload {
+        Float3 hitPos;
+        Float3 normal;
+        Float3 geomNormal;
+        Float3 albedo;
+        float roughness = 0.0f;
+        float metallic = 0.0f;
+        Float3 emissive;
+        float hitT = -1.0f;
+        float specTrans = 0.0f;
+        float ior = 1.5f;
+        float isRaster = 0.0f;      // 1.0 = mode 1, 2.0 = mode 2
+        int32_t lightId = -1;       // 맞은 면광원 삼각형의 광원 인덱스 (MIS 용)
+        int maxDepth = 0;           // 이 면에서 경로를 이어갈 최대 세그먼트 수 (0: 제한 없음)
+    };
+
+    struct RefPathTracer::Counters {
+        uint64_t samples = 0;
+        uint64_t rays = 0;
+        uint64_t convergedPixels = 0;
+        uint64_t pathSegments = 0;
+        uint64_t rouletteTerminations = 0;
+    };
+
+    namespace shading {
+
+        // ── raygenbsdf.rgen 에서 옮긴 함수들 (이름, 상수, 식을 그대로 유지) ────────────────
+
+        const float PI = 3.14159265359f;
+        const Float3 kSkyColor{ 0.1f, 0.1f, 0.2f };
+        const uint8_t kShadowCullMask = 0xFD;      // 면광원(instanceMask=0x02) 제외
+
+        inline uint32_t pcg_hash(uint32_t& seed) {
+            uint32_t state = seed * 747796405u + 2891336453u;
+            uint32_t word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+            seed = state;
+            return (word >> 22u) ^ word;
+        }
+        inline float rand(uint32_t& seed) { return float(pcg_hash(seed)) / 4294967296.0f; }
+
+        inline void createCoordinateSystem(const Float3& N, Float3& Nt, Float3& Nb) {
+            Float3 up = std::fabs(N.z) < 0.9999999f ? Float3{ 0.0f, 0.0f, 1.0f } : Float3{ 1.0f, 0.0f, 0.0f };
+            Nt = normalize(cross(up, N));
+            Nb = cross(N, Nt);
+        }
+
+        inline Float3 SampleGGX(float xi0, float xi1, float roughness, const Float3& N, const Float3& V) {
+            float a = std::max(roughness * roughness, 0.001f);
+            float phi = 2.0f * PI * xi0;
+            float cosTheta = std::sqrt((1.0f - xi1) / (1.0f + (a * a - 1.0f) * xi1));
+            float sinTheta = std::sqrt(1.0f - cosTheta * cosTheta);
+            Float3 Nt, Nb;
+            createCoordinateSystem(N, Nt, Nb);
+            Float3 H = normalize(Nt * (std::cos(phi) * sinTheta) + Nb * (std::sin(phi) * sinTheta) + N * cosTheta);
+            return reflect(-V, H);
+        }
+
+        inline Float3 SampleCosineHemisphere(float xi0, float xi1, const Float3& N) {
+            float phi = 2.0f * PI * xi0;
+            float cosTheta = std::sqrt(xi1);
+            float sinTheta = std::sqrt(1.0f - xi1);
+            Float3 Nt, Nb;
+            createCoordinateSystem(N, Nt, Nb);
+            return normalize(Nt * (std::cos(phi) * sinTheta) + Nb * (std::sin(phi) * sinTheta) + N * cosTheta);
+        }
+
+        template<typename P>
+        inline Float3 EvaluateDisneyBRDF(const P& p, const Float3& V, const Float3& L, const Float3& N) {
+            Float3 H = normalize(V + L);
+            float NdotL = std::max(dot(N, L), 0.001f);
+            float NdotV = std::max(dot(N, V), 0.001f);
+            float NdotH = std::max(dot(N, H), 0.0f);
+            float LdotH = std::max(dot(L, H), 0.0f);
+            float r = std::max(p.roughness, 0.04f);
+            float fd90 = 0.5f + 2.0f * r * LdotH * LdotH;
+            float lightScatter = 1.0f + (fd90 - 1.0f) * std::pow(clamp(1.0f - NdotL, 0.0f, 1.0f), 5.0f);
+            float viewScatter  = 1.0f + (fd90 - 1.0f) * std::pow(clamp(1.0f - NdotV, 0.0f, 1.0f), 5.0f);
+            Float3 diffuse = (p.albedo / PI) * (lightScatter * viewScatter * (1.0f - p.metallic) * (1.0f - p.specTrans));
+            float a = r * r;
+            float a2 = a * a;
+            float dDenom = (NdotH * NdotH * (a2 - 1.0f) + 1.0f);
+            float D = a2 / (PI * dDenom * dDenom);
+            Float3 F0 = mix(splat(0.04f), p.albedo, p.metallic);
+            Float3 F = F0 + (splat(1.0f) - F0) * std::pow(clamp(1.0f - std::max(dot(H, V), 0.0f), 0.0f, 1.0f), 5.0f);
+            float r_k = (r + 1.0f);
+            float k = (r_k * r_k) / 8.0f;
+            float g1L = NdotL / (NdotL * (1.0f - k) + k);
+            float g1V = NdotV / (NdotV * (1.0f - k) + k);
+            float G = g1L * g1V;
+            Float3 specular = (F * (D * G)) / (4.0f * NdotL * NdotV + 0.0001f);
+            return diffuse + specular;
+        }
+
+        template<typename P>
+        inline float CalculateBSDF_PDF(const P& p, const Float3& V, const Float3& L, float eta_i, float eta_o, const Float3& N) {
+            float probReflection = mix(0.5f, 1.0f, p.metallic);
+            float probTransmission = (1.0f - probReflection) * p.specTrans;
+            float probDiffuse = (1.0f - probReflection) * (1.0f - p.specTrans);
+            float totalProb = probReflection + probTransmission + probDiffuse;
+            probReflection /= totalProb; probTransmission /= totalProb; probDiffuse /= totalProb;
+            float pdf = 0.0f;
+            float NdotL = dot(N, L);
+            if (NdotL > 0.0f) {
+                if (probReflection > 0.0f) {
+                    Float3 H = normalize(V + L);
+                    float NdotH = std::max(dot(N, H), 0.0f);
+                    float VdotH = std::max(dot(V, H), 0.0f);
+                    float a = std::max(p.roughness * p.roughness, 0.001f);
+                    float a2 = a * a;
+                    float denom = (NdotH * NdotH * (a2 - 1.0f) + 1.0f);
+                    float D = a2 / (PI * denom * denom);
+                    pdf += ((D * NdotH) / (4.0f * VdotH + 0.0001f)) * probReflection;
+                }
+                if (probDiffuse > 0.0f) pdf += (NdotL / PI) * probDiffuse;
+            } else if (NdotL < 0.0f && probTransmission > 0.0f) {
+                Float3 H = -normalize(V * eta_i + L * eta_o);
+                if (dot(H, N) < 0.0f) H = -H;
+                float NdotH = std::max(dot(N, H), 0.0f);
+                float VdotH_native = dot(V, H);
+                float LdotH_native = dot(L, H);
+                float a = std::max(p.roughness * p.roughness, 0.001f);
+                float a2 = a * a;
+                float denom = (NdotH * NdotH * (a2 - 1.0f) + 1.0f);
+                float D = a2 / (PI * denom * denom);
+                float denom_jacob = eta_i * VdotH_native + eta_o * LdotH_native;
+                float jacobian = (eta_o * eta_o * std::fabs(LdotH_native)) / (denom_jacob * denom_jacob + 0.0001f);
+                pdf += D * NdotH * jacobian * probTransmission;
+            }
+            return std::max(pdf, 0.0001f);
+        }
+
+        inline float ExactFresnelDielectric(float cosThetaI, float eta_i, float eta_o) {
+            float sinThetaI = std::sqrt(std::max(0.0f, 1.0f - cosThetaI * cosThetaI));
+            float sinThetaT = (eta_i / eta_o) * sinThetaI;
+            if (sinThetaT >= 1.0f) return 1.0f;
+            float cosThetaT = std::sqrt(std::max(0.0f, 1.0f - sinThetaT * sinThetaT));
+            float Rs = ((eta_i * cosThetaI) - (eta_o * cosThetaT)) / ((eta_i * cosThetaI) + (eta_o * cosThetaT));
+            float Rp = ((eta_o * cosThetaI) - (eta_i * cosThetaT)) / ((eta_o * cosThetaI) + (eta_i * cosThetaT));
+            return (Rs * Rs + Rp * Rp) / 2.0f;
+        }
+
+        inline Float3 SampleBTDF(float xi0, float xi1, float roughness, const Float3& N, const Float3& V, float eta_i, float eta_o) {
+            float a = std::max(roughness * roughness, 0.001f);
+            float phi = 2.0f * PI * xi0;
+            float cosTheta = std::sqrt((1.0f - xi1) / (1.0f + (a * a - 1.0f) * xi1));
+            float sinTheta = std::sqrt(1.0f - cosTheta * cosTheta);
+            Float3 Nt, Nb;
+            createCoordinateSystem(N, Nt, Nb);
+            Float3 H = normalize(Nt * (std::cos(phi) * sinTheta) + Nb * (std::sin(phi) * sinTheta) + N * cosTheta);
+            Float3 L = refract(-V, H, eta_i / eta_o);
+            if (length(L) < 0.001f) return reflect(-V, H);
+            return normalize(L);
+        }
+
+        template<typename P>
+        inline Float3 EvaluateDisneyBTDF(const P& p, const Float3& V, const Float3& L, float eta_i, float eta_o, const Float3& N) {
+            Float3 H = -normalize(V * eta_i + L * eta_o);
+            if (dot(H, N) < 0.0f) H = -H;
+            float absNdotV = std::max(std::fabs(dot(N, V)), 0.001f);
+            float absNdotL = std::max(std::fabs(dot(N, L)), 0.001f);
+            float VdotH_native = dot(V, H);
+            float LdotH_native = dot(L, H);
+            float NdotH = std::max(dot(N, H), 0.0f);
+            float F = ExactFresnelDielectric(std::fabs(VdotH_native), eta_i, eta_o);
+            float a = std::max(p.roughness * p.roughness, 0.001f);
+            float a2 = a * a;
+            float denom = (NdotH * NdotH * (a2 - 1.0f) + 1.0f);
+            float D = a2 / (PI * denom * denom);
+            float r_k = (p.roughness + 1.0f);
+            float k = (r_k * r_k) / 8.0f;
+            float g1L = absNdotL / (absNdotL * (1.0f - k) + k);
+            float g1V = absNdotV / (absNdotV * (1.0f - k) + k);
+            float G = g1L * g1V;
+            float term1 = (std::fabs(VdotH_native) * std::fabs(LdotH_native)) / (absNdotV * absNdotL + 0.0001f);
+            float denom_jacob = (eta_i * VdotH_native + eta_o * LdotH_native);
+            float term2 = (eta_o * eta_o) / (denom_jacob * denom_jacob + 0.0001f);
+            return p.albedo * (term1 * term2 * (1.0f - F) * G * D * (1.0f - p.metallic) * p.specTrans);
+        }
+
+        // 픽셀 좌표 (px, py) 를 지나는 광선 방향. main.cpp 의 카메라 기저와 동일 (zAxis = -forward)
+        // OGRE Vulkan 투영은 y 가 위로 +1 이므로 위 행(py = 0) 이 d.y = +1
+        inline Float3 cameraDir(const SceneCamera& cam, const RenderSettings& settings, float px, float py) {
+            Float3 zAxis = normalize(cam.eye - cam.target);
+            Float3 xAxis = normalize(cross(cam.up, zAxis));
+            Float3 yAxis = cross(zAxis, xAxis);
+            float tanHalf = std::tan(cam.fovY * 0.5f);
+            float aspect = float(settings.width) / float(settings.height);
+            float dx = (px / settings.width) * 2.0f - 1.0f;
+            float dy = -((py / settings.height) * 2.0f - 1.0f);
+            return normalize(xAxis * (dx * tanHalf * aspect) + yAxis * (dy * tanHalf) - zAxis);
+        }
+
+        // NEE / BSDF 샘플 결합 가중치 (power heuristic, β = 2)
+        inline float powerHeuristic(float pdfA, float pdfB) {
+            float a2 = pdfA * pdfA, b2 = pdfB * pdfB;
+            return a2 + b2 > 0.0f ? a2 / (a2 + b2) : 0.0f;
+        }
+
+        inline Float3 lightVec(const float v[3]) { return { v[0], v[1], v[2] }; }
+
+        inline float luminance(const Float3& c) { return dot(c, Float3{ 0.2126f, 0.7152f, 0.0722f }); }
+
+        // GBufferPrism_piece_ps.glsl 의 gbufferMaterial (r: roughness, g: metallic proxy)
+        inline void gbufferMaterial(const InstanceMaterial& mat, float& roughness, float& metallic) {
+            roughness = std::max(0.02f, mat.pbrParams1[1]);
+            metallic = mat.pbrParams1[2] > 0.01f ? mat.pbrParams1[2] : 0.0f;
+        }
+
+    }
+
+}
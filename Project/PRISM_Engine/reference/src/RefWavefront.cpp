@@ -0,0 +1,455 @@
+#include "RefPathTracer.h"
+#include "RefMath.h"
+#include "RefShading.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace Prism {
+
+    using namespace shading;
+
+    // GPU 의 wavefront 버퍼 (set 1) 와 같은 구성. 큐에는 경로 인덱스만 들어감
+    struct RefPathTracer::WavefrontQueues {
+        std::vector<GpuWavefrontPath> paths;
+        std::vector<uint32_t> rayQueue, hitQueue, sortedQueue, shadowQueue;
+
+        // GpuWavefrontCounters 의 앞쪽 (바운스마다 비움). 스레드끼리 atomicAdd 로 추가
+        std::atomic<uint32_t> rayCount{ 0 }, hitCount{ 0 }, shadowCount{ 0 };
+        std::atomic<uint32_t> binCount[WAVEFRONT_BIN_COUNT];
+        std::atomic<uint32_t> binCursor[WAVEFRONT_BIN_COUNT];
+        // 프레임 합계
+        std::atomic<uint64_t> raysTraced{ 0 }, shadowRays{ 0 };
+        std::atomic<uint64_t> binTotal[WAVEFRONT_BIN_COUNT];
+
+        uint32_t frame = 0;     // 시드용 frameCount
+
+        explicit WavefrontQueues(size_t count)
+            : paths(count), rayQueue(count), hitQueue(count), sortedQueue(count), shadowQueue(count) {
+            for (uint32_t b = 0; b < WAVEFRONT_BIN_COUNT; b++) binTotal[b] = 0;
+            resetHits();
+        }
+
+        void resetHits() {
+            hitCount = 0;
+            shadowCount = 0;
+            for (uint32_t b = 0; b < WAVEFRONT_BIN_COUNT; b++) binCount[b] = binCursor[b] = 0;
+        }
+
+        void pushHit(uint32_t path, uint32_t bin) {
+            hitQueue[hitCount.fetch_add(1, std::memory_order_relaxed)] = path;
+            binCount[bin].fetch_add(1, std::memory_order_relaxed);
+        }
+        void pushRay(uint32_t path) { rayQueue[rayCount.fetch_add(1, std::memory_order_relaxed)] = path; }
+        void pushShadow(uint32_t path) { shadowQueue[shadowCount.fetch_add(1, std::memory_order_relaxed)] = path; }
+    };
+
+    namespace {
+
+        Float3 load3(const float v[3]) { return { v[0], v[1], v[2] }; }
+        void store3(float v[3], const Float3& a) { v[0] = a.x; v[1] = a.y; v[2] = a.z; }
+
+        // GPU 스레드 그룹 하나 크기씩 스레드가 큐 구간을 가져감 (fn(thread, index))
+        template<typename F>
+        void parallelFor(uint32_t count, uint32_t threadCount, F&& fn) {
+            if (count == 0) return;
+            std::atomic<uint32_t> next{ 0 };
+            auto worker = [&](uint32_t thread) {
+                for (;;) {
+                    uint32_t begin = next.fetch_add(kWavefrontGroupSize, std::memory_order_relaxed);
+                    if (begin >= count) break;
+                    uint32_t end = std::min(begin + kWavefrontGroupSize, count);
+                    for (uint32_t i = begin; i < end; i++) fn(thread, i);
+                }
+            };
+            uint32_t used = std::min(threadCount, (count + kWavefrontGroupSize - 1) / kWavefrontGroupSize);
+            std::vector<std::thread> threads;
+            for (uint32_t t = 1; t < used; t++) threads.emplace_back(worker, t);
+            worker(0);
+            for (auto& t : threads) t.join();
+        }
+
+    }
+
+    // wavefront_generate.rgen: CameraRay + 1st hit. 1st hit 은 바로 히트 큐로 (메가커널이 재투영용 trace 를 이어 쓰는 것과 같음)
+    void RefPathTracer::wavefrontGenerate(const RenderSettings& settings, WavefrontQueues& queues, uint32_t path,
+                                          int maxBounces, Counters& counters) const {
+        const uint32_t x = path % settings.width, y = path / settings.width;
+        uint32_t seed = y * settings.width + x + queues.frame * 719393u;
+        float jx = rand(seed), jy = rand(seed);
+
+        GpuWavefrontPath& p = queues.paths[path];
+        p = GpuWavefrontPath{};
+        Float3 origin = scene.camera.eye;
+        Float3 dir = cameraDir(scene.camera, settings, x + jx, y + jy);
+        store3(p.origin, origin);
+        store3(p.dir, dir);
+        store3(p.throughput, splat(1.0f));
+        p.maxBounces = maxBounces;
+        p.seed = seed;
+        p.depth = 0;
+        p.flags = 0;
+
+        counters.samples++;
+        counters.pathSegments++;
+        wavefrontTrace(settings, queues, path, counters);
+    }
+
+    // wavefront_trace.rgen (+ closesthitbsdf.rchit / miss.rmiss): 광선 하나. 하늘이면 radiance 에 더하고 끝, 맞으면 히트 큐로
+    void RefPathTracer::wavefrontTrace(const RenderSettings& settings, WavefrontQueues& queues, uint32_t path,
+                                       Counters& counters) const {
+        GpuWavefrontPath& p = queues.paths[path];
+        Payload payload;
+        if (!trace({ load3(p.origin), load3(p.dir), 0.001f, 10000.0f }, settings.hybridModes, payload, counters)) {
+            store3(p.radiance, load3(p.radiance) + load3(p.throughput) * kSkyColor);
+            return;
+        }
+
+        store3(p.hitPos, payload.hitPos);       p.hitT = payload.hitT;
+        store3(p.normal, payload.normal);       p.roughness = payload.roughness;
+        store3(p.geomNormal, payload.geomNormal); p.metallic = payload.metallic;
+        store3(p.albedo, payload.albedo);       p.specTrans = payload.specTrans;
+        store3(p.emissive, payload.emissive);   p.ior = payload.ior;
+        p.lightId = payload.lightId;
+        p.maxDepth = payload.maxDepth;
+        p.isRaster = payload.isRaster;
+        p.bin = wavefrontBin(p.flags, p.depth, payload.isRaster, length(payload.emissive) > 0.0f,
+                             payload.specTrans, payload.roughness, payload.metallic);
+        queues.pushHit(path, p.bin);
+    }
+
+    // wavefront_shade.comp: 히트 하나 셰이딩 (TracePath 의 루프 본문). 그림자 광선은 큐에 넣고, 이어가면 광선 큐로
+    void RefPathTracer::wavefrontShade(const RenderSettings& settings, WavefrontQueues& queues, uint32_t path,
+                                       Counters& counters) const {
+        GpuWavefrontPath& p = queues.paths[path];
+        // trace 가 쓴 히트 필드 → payload (셰이딩 함수들이 HitPayload 를 받으므로)
+        Payload payload;
+        payload.hitPos = load3(p.hitPos);         payload.hitT = p.hitT;
+        payload.normal = load3(p.normal);         payload.roughness = p.roughness;
+        payload.geomNormal = load3(p.geomNormal); payload.metallic = p.metallic;
+        payload.albedo = load3(p.albedo);         payload.specTrans = p.specTrans;
+        payload.emissive = load3(p.emissive);     payload.ior = p.ior;
+        payload.lightId = p.lightId;
+        payload.maxDepth = p.maxDepth;
+        payload.isRaster = p.isRaster;
+        const Float3 rayDir = load3(p.dir);
+        const Float3 throughput = load3(p.throughput);
+        Float3 radiance = load3(p.radiance);
+        const int depth = p.depth;
+        uint32_t seed = p.seed;
+
+        switch (p.bin) {
+        case WAVEFRONT_BIN_PROBE: {
+            // 래스터 오브젝트의 반사 probe: throughput = Fresnel * (1 - roughness)
+            Float3 indirectSpec = length(payload.emissive) > 0.001f ? payload.emissive : payload.albedo * 0.3f;
+            store3(p.radiance, radiance + throughput * indirectSpec);
+            return;
+        }
+
+        case WAVEFRONT_BIN_RASTER: {
+            // ── [HYBRID] 래스터 오브젝트: shadow ray + specular probe ─────────────────
+            // 결과 = base * shadow (0.15 / 1) + extra + probe 이므로 base 는 그림자 큐로, extra 는 바로 더함
+            bool  modeB = payload.isRaster > 1.5f;
+            Float3 P1 = payload.hitPos, N1 = payload.normal, gN1 = payload.geomNormal, alb = payload.albedo;
+            float rou = payload.roughness, met = payload.metallic;
+            Float3 V = -rayDir;
+
+            Float3 lightPos{ 0.0f, 11.5f, 0.0f };
+            Float3 toLightV = lightPos - P1;
+            float lightDist = length(toLightV);
+            toLightV = normalize(toLightV);
+            float NdotL = std::max(dot(N1, toLightV), 0.0f);
+
+            Payload bp;
+            bp.albedo = alb; bp.roughness = rou; bp.metallic = met;
+            bp.specTrans = 0.0f; bp.ior = 1.5f;
+            Float3 unshadowed = EvaluateDisneyBRDF(bp, V, toLightV, N1) * (NdotL * 4.0f);
+            Float3 ambient = alb * ((1.0f - met) * 0.05f);
+            // mode 2 는 G-Buffer 래스터 색 대신 그림자를 뺀 mode 1 셰이딩 (RefPathTracer.h 참고)
+            Float3 base  = modeB ? unshadowed + ambient : unshadowed;
+            Float3 extra = modeB ? Float3{} : ambient;
+
+            if (NdotL > 0.0f) {
+                store3(p.shadowOrigin, P1 + gN1 * 0.005f);
+                store3(p.shadowDir, toLightV);
+                p.shadowTMax = lightDist - 0.05f;
+                store3(p.shadowRadiance, base);
+                p.shadowOccludedScale = 0.15f;
+                queues.pushShadow(path);
+            } else {
+                radiance += base * 0.15f;
+            }
+            store3(p.radiance, radiance + extra);
+
+            if (rou < 0.35f || met > 0.3f) {
+                Float3 specDir = reflect(-V, N1);
+                if (dot(N1, specDir) > 0.0f) {
+                    Float3 F0v  = mix(splat(0.04f), alb, met);
+                    Float3 Fres = F0v + (splat(1.0f) - F0v) * std::pow(1.0f - std::max(dot(N1, V), 0.0f), 5.0f);
+                    store3(p.origin, P1 + gN1 * 0.005f);
+                    store3(p.dir, specDir);
+                    store3(p.throughput, Fres * (1.0f - rou));
+                    p.flags = kWavefrontPathProbe;
+                    queues.pushRay(path);
+                }
+            }
+            return;
+        }
+
+        case WAVEFRONT_BIN_EMISSIVE: {
+            // 직전 정점에서 NEE 도 이 광원을 고를 수 있었으면 BSDF 샘플 몫만 더함
+            float misWeight = 1.0f;
+            if ((p.flags & kWavefrontPathPrevNee) && payload.lightId >= 0) {
+                const GpuLightEntry& le = scene.lights.lights[payload.lightId];
+                float cosL = dot(lightVec(le.normal), -rayDir);
+                float lightPdf = cosL > 0.0f
+                    ? pickLightPmf(settings, payload.lightId, load3(p.prevPos), load3(p.prevN)) * payload.hitT * payload.hitT / std::max(le.area * cosL, 1e-6f)
+                    : 0.0f;
+                misWeight = powerHeuristic(p.prevBsdfPdf, lightPdf);
+            }
+            store3(p.radiance, radiance + throughput * payload.emissive * misWeight);
+            return;
+        }
+
+        default:
+            break;
+        }
+
+        // ── DIFFUSE / GLOSSY / TRANSMISSIVE: NEE (그림자 큐) + BSDF 샘플 ──────────────
+        bool neeDone = false;
+        {
+            bool inside = dot(payload.geomNormal, rayDir) > 0.0f;
+            if (!inside && scene.lights.lightCount() > 0) {
+                neeDone = true;
+                float uPick = rand(seed), xiL0 = rand(seed), xiL1 = rand(seed);
+                float pickPdf = 0.0f;
+                int32_t li = pickLight(settings, payload.hitPos, payload.normal, uPick, pickPdf);
+                if (li >= 0 && pickPdf > 0.0f) {
+                    const GpuLightEntry& le = scene.lights.lights[li];
+                    bool isPoint = le.type == LIGHT_POINT;
+                    Float3 lPos = lightVec(le.v0);
+                    if (!isPoint) {
+                        float su = std::sqrt(xiL0);
+                        float b0 = 1.0f - su, b1 = xiL1 * su;
+                        lPos = lightVec(le.v0) * b0 + lightVec(le.v1) * b1 + lightVec(le.v2) * (1.0f - b0 - b1);
+                    }
+                    Float3 toL = lPos - payload.hitPos;
+                    float lDist = length(toL);
+                    toL /= lDist;
+                    float NdL = std::max(dot(payload.normal, toL), 0.0f);
+                    float cosL = isPoint ? 1.0f : dot(lightVec(le.normal), -toL);
+
+                    if (NdL > 0.0f && cosL > 0.0f) {
+                        // 기여를 미리 계산해 두고 shadow 단계는 가려졌는지만 봄
+                        Float3 brdfNEE = EvaluateDisneyBRDF(payload, -rayDir, toL, payload.normal);
+                        Float3 Le = lightVec(le.emission);
+                        float lightPdf, misWeight;
+                        if (isPoint) {
+                            Le = Le / (lDist * lDist);
+                            lightPdf = pickPdf;
+                            misWeight = 1.0f;
+                        } else {
+                            lightPdf = pickPdf * (lDist * lDist) / std::max(le.area * cosL, 1e-6f);
+                            misWeight = powerHeuristic(lightPdf,
+                                CalculateBSDF_PDF(payload, -rayDir, toL, 1.0f, payload.ior, payload.normal));
+                        }
+                        Float3 neeC = throughput * brdfNEE * Le * (NdL * misWeight / std::max(lightPdf, 0.001f));
+                        if (!std::isnan(neeC.x) && !std::isinf(neeC.x)) {
+                            store3(p.shadowOrigin, payload.hitPos + payload.geomNormal * 0.005f);
+                            store3(p.shadowDir, toL);
+                            p.shadowTMax = lDist - 0.05f;
+                            store3(p.shadowRadiance, min(neeC, 20.0f));     // firefly 방지
+                            p.shadowOccludedScale = 0.0f;
+                            queues.pushShadow(path);
+                        }
+                    }
+                }
+            }
+        }
+
+        // 재질별 최대 깊이: 이 면에서 더 이어갈 수 없으면 NEE 까지만
+        if (payload.maxDepth > 0 && depth + 1 >= payload.maxDepth) return;
+        // 세그먼트 상한 (메가커널 루프의 depth < maxBounces)
+        if (depth + 1 >= p.maxBounces) return;
+
+        Float3 V = -rayDir;
+        float xi0 = rand(seed), xi1 = rand(seed);
+        Float3 L;
+        Float3 bsdfValue{};
+        bool isInside = dot(payload.geomNormal, rayDir) > 0.0f;
+        Float3 N = isInside ? -payload.normal : payload.normal;
+        Float3 geomN = isInside ? -payload.geomNormal : payload.geomNormal;
+        float eta_i = isInside ? payload.ior : 1.0f;
+        float eta_o = isInside ? 1.0f : payload.ior;
+        float probReflection = mix(0.5f, 1.0f, payload.metallic);
+        float probTransmission = (1.0f - probReflection) * payload.specTrans;
+        float probDiffuse = (1.0f - probReflection) * (1.0f - payload.specTrans);
+        float totalProb = probReflection + probTransmission + probDiffuse;
+        probReflection /= totalProb; probTransmission /= totalProb; probDiffuse /= totalProb;
+        float randVal = rand(seed);
+        if (randVal < probReflection) L = SampleGGX(xi0, xi1, payload.roughness, N, V);
+        else if (randVal < probReflection + probTransmission) L = SampleBTDF(xi0, xi1, payload.roughness, N, V, eta_i, eta_o);
+        else L = SampleCosineHemisphere(xi0, xi1, N);
+
+        if (dot(N, L) > 0.0f) bsdfValue = EvaluateDisneyBRDF(payload, V, L, N);
+        else bsdfValue = EvaluateDisneyBTDF(payload, V, L, eta_i, eta_o, N);
+
+        float pdf = CalculateBSDF_PDF(payload, V, L, eta_i, eta_o, N);
+        p.flags = (neeDone && dot(payload.normal, L) > 0.0f) ? kWavefrontPathPrevNee : 0u;
+        store3(p.prevPos, payload.hitPos);
+        store3(p.prevN, payload.normal);
+        p.prevBsdfPdf = pdf;
+        float cosTheta = std::max(std::fabs(dot(N, L)), 0.001f);
+        Float3 nextThroughput = throughput * bsdfValue * (cosTheta / std::max(pdf, 0.0001f));
+        const float epsilon = 0.005f;
+        float directionSign = sign(dot(geomN, L));
+        store3(p.origin, payload.hitPos + geomN * (epsilon * directionSign));
+        store3(p.dir, L);
+
+        // Russian roulette (확률 q 로 이어가고 1/q 보정). 마지막 세그먼트는 위에서 이미 끝남
+        if (settings.path.russianRoulette && depth + 1 >= settings.path.rouletteMinDepth) {
+            float q = rouletteSurvival(std::max(nextThroughput.x, std::max(nextThroughput.y, nextThroughput.z)));
+            if (rand(seed) >= q) {
+                counters.rouletteTerminations++;
+                p.seed = seed;
+                return;
+            }
+            nextThroughput = nextThroughput / q;
+        }
+
+        store3(p.throughput, nextThroughput);
+        p.seed = seed;
+        p.depth = depth + 1;
+        counters.pathSegments++;
+        queues.pushRay(path);
+    }
+
+    RenderStats RefPathTracer::renderWavefront(const RenderSettings& settings, std::vector<float>& outRgb,
+                                               WavefrontStats* wavefrontStats) const {
+        const uint32_t width = settings.width, height = settings.height;
+        const uint32_t pixelCount = width * height;
+        uint32_t threadCount = settings.threads ? settings.threads : std::thread::hardware_concurrency();
+        threadCount = std::max(threadCount, 1u);
+
+        WavefrontQueues queues(pixelCount);
+        std::vector<Counters> counters(threadCount);
+        WavefrontStats wf;
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        // 픽셀별 고정 값 (G-Buffer 바운스 수) + accumImage / varianceImage 상태
+        std::vector<int> maxBounces(pixelCount);
+        parallelFor(pixelCount, threadCount, [&](uint32_t t, uint32_t i) {
+            maxBounces[i] = primaryBounces(settings, i % width, i / width, counters[t]);
+        });
+        std::vector<Float3> accum(pixelCount);
+        std::vector<float> historyLen(pixelCount, 0.0f), m1(pixelCount, 0.0f), m2(pixelCount, 0.0f);
+        std::vector<uint8_t> active(pixelCount);
+
+        // 경로가 바운스마다 한 세그먼트씩 나아가므로 maxBounces 번이면 모든 경로가 끝남
+        // 래스터 오브젝트의 반사 probe 는 1st hit 다음 바운스에서 셰이딩되므로 최소 2 번
+        const int bounceCount = std::max(settings.path.maxBounces, 2);
+
+        for (uint32_t f = 0; f < settings.spp; f++) {
+            queues.frame = settings.frameOffset + f;
+            queues.resetHits();
+            queues.rayCount = 0;
+
+            // ── generate: 적응형 경로 수 (최대 1) + 1st hit ──
+            parallelFor(pixelCount, threadCount, [&](uint32_t t, uint32_t i) {
+                int paths = adaptiveSampleCount(settings.adaptive, historyLen[i], m1[i], m2[i], queues.frame, i % width, i / width);
+                active[i] = paths > 0 ? 1 : 0;
+                if (active[i]) wavefrontGenerate(settings, queues, i, maxBounces[i], counters[t]);
+            });
+
+            for (int bounce = 0; bounce < bounceCount; bounce++) {
+                const uint32_t hits = queues.hitCount;
+                if (hits == 0) break;       // GPU 는 호스트가 큐 길이를 모르므로 항상 bounceCount 번 (빈 단계는 바로 끝남)
+                wf.bounces++;
+
+                // ── sort: bin 별 시작 위치 (개수의 prefix sum) 에 경로 인덱스를 흩어 씀 ──
+                uint32_t binOffset[WAVEFRONT_BIN_COUNT];
+                uint32_t offset = 0;
+                for (uint32_t b = 0; b < WAVEFRONT_BIN_COUNT; b++) {
+                    binOffset[b] = offset;
+                    offset += queues.binCount[b];
+                    queues.binTotal[b] += queues.binCount[b];
+                }
+                parallelFor(hits, threadCount, [&](uint32_t, uint32_t i) {
+                    uint32_t path = queues.hitQueue[i];
+                    uint32_t bin = queues.paths[path].bin;
+                    queues.sortedQueue[binOffset[bin] + queues.binCursor[bin].fetch_add(1, std::memory_order_relaxed)] = path;
+                });
+
+                // ── shade: bin 순서대로 ──
+                parallelFor(hits, threadCount, [&](uint32_t t, uint32_t i) {
+                    wavefrontShade(settings, queues, queues.sortedQueue[i], counters[t]);
+                });
+
+                // ── shadow: 가려지지 않았으면 미리 계산한 기여를 더함 ──
+                const uint32_t shadows = queues.shadowCount;
+                queues.shadowRays += shadows;
+                parallelFor(shadows, threadCount, [&](uint32_t t, uint32_t i) {
+                    GpuWavefrontPath& p = queues.paths[queues.shadowQueue[i]];
+                    bool blocked = occluded({ load3(p.shadowOrigin), load3(p.shadowDir), 0.001f, p.shadowTMax }, counters[t]);
+                    Float3 c = load3(p.shadowRadiance) * (blocked ? p.shadowOccludedScale : 1.0f);
+                    store3(p.radiance, load3(p.radiance) + c);
+                });
+
+                // ── trace: 광선 큐 → 히트 큐 ──
+                queues.resetHits();
+                const uint32_t rays = queues.rayCount;
+                queues.rayCount = 0;
+                queues.raysTraced += rays;
+                parallelFor(rays, threadCount, [&](uint32_t t, uint32_t i) {
+                    wavefrontTrace(settings, queues, queues.rayQueue[i], counters[t]);
+                });
+            }
+
+            // ── resolve: 경로 radiance 를 누적 (raygenbsdf.rgen 과 같은 가중치, 카메라 고정이라 재투영 없음) ──
+            for (uint32_t i = 0; i < pixelCount; i++) {
+                if (!active[i]) continue;
+                Float3 c = load3(queues.paths[i].radiance);
+                if (std::isnan(c.x) || std::isinf(c.x)) c = {};
+                c = min(c, 10.0f);
+                float l = luminance(c);
+                historyLen[i] += 1.0f;
+                float w = 1.0f / historyLen[i];
+                accum[i] = mix(accum[i], c, w);
+                m1[i] = mix(m1[i], l, w);
+                m2[i] = mix(m2[i], l * l, w);
+            }
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+
+        outRgb.assign(size_t(pixelCount) * 3, 0.0f);
+        RenderStats stats;
+        for (uint32_t i = 0; i < pixelCount; i++) {
+            outRgb[i * 3] = accum[i].x; outRgb[i * 3 + 1] = accum[i].y; outRgb[i * 3 + 2] = accum[i].z;
+            if (adaptiveConverged(settings.adaptive, historyLen[i], m1[i], m2[i])) stats.convergedPixels++;
+        }
+        for (const Counters& c : counters) {
+            stats.samples += c.samples;
+            stats.rays += c.rays;
+            stats.pathSegments += c.pathSegments;
+            stats.rouletteTerminations += c.rouletteTerminations;
+        }
+        stats.threads = threadCount;
+        stats.pixels = pixelCount;
+        stats.seconds = std::chrono::duration<double>(end - start).count();
+
+        if (wavefrontStats) {
+            wf.pathsStarted = stats.samples;
+            wf.raysTraced = queues.raysTraced;
+            wf.shadowRays = queues.shadowRays;
+            for (uint32_t b = 0; b < WAVEFRONT_BIN_COUNT; b++) wf.binHits[b] = queues.binTotal[b];
+            *wavefrontStats = wf;
+        }
+        return stats;
+    }
+
+}
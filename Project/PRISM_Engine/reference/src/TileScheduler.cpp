@@ -0,0 +1,44 @@
+#include "TileScheduler.h"
+
+#include <algorithm>
+
+namespace Prism {
+
+    TileScheduler::TileScheduler(uint32_t tileCount, uint32_t threadCount) {
+        threadCount = std::max(threadCount, 1u);
+        for (uint32_t t = 0; t < threadCount; t++) queues.push_back(std::make_unique<Queue>());
+
+        // 스레드 t 는 [t * n / T, (t + 1) * n / T) (화면 위에서 아래로 연속 띠)
+        for (uint32_t t = 0; t < threadCount; t++) {
+            uint32_t begin = static_cast<uint32_t>(uint64_t(tileCount) * t / threadCount);
+            uint32_t end = static_cast<uint32_t>(uint64_t(tileCount) * (t + 1) / threadCount);
+            for (uint32_t i = begin; i < end; i++) queues[t]->tiles.push_back(i);
+        }
+    }
+
+    bool TileScheduler::next(uint32_t thread, uint32_t& outTile) {
+        const uint32_t count = static_cast<uint32_t>(queues.size());
+        {
+            Queue& own = *queues[thread % count];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tiles.empty()) {
+                outTile = own.tiles.front();
+                own.tiles.pop_front();
+                return true;
+            }
+        }
+
+        for (uint32_t k = 1; k < count; k++) {
+            Queue& victim = *queues[(thread + k) % count];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tiles.empty()) {
+                outTile = victim.tiles.back();
+                victim.tiles.pop_back();
+                steals.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+}
@@ -0,0 +1,194 @@
+// GPU 없이 PRISM_Engine 의 Cornell 씬을 CPU 패스 트레이서로 렌더하고 처리량(samples/sec)을 출력
+//
+// 사용법: PRISM_RefRender [--models <dir>] [--width 640] [--height 360] [--spp 64] [--threads 0] [--tile 16]
+//                         [--full-pt] [--bounces 12] [--frame 0] [--png out.png] [--exr out.exr]
+//                         [--denoise] [--atrous 5] [--diff-spp 0] [--light-grid 0] [--uniform-lights]
+//                         [--adaptive] [--adaptive-threshold 0.02] [--adaptive-max 4] [--no-roulette]
+//                         [--wavefront]
+//   --models  cube.obj / bunny.obj 가 있는 폴더 (PRISM_Engine 실행 파일 옆과 같은 구성)
+//   --threads 0 이면 hardware_concurrency
+//   --full-pt 하이브리드 모드(renderMode 1/2) 를 끄고 전부 풀 PT, 바운스 수는 --bounces 로 고정
+//   --bounces 경로 세그먼트 상한 (GPU 의 PathTerminationParams::maxBounces). 재질별 깊이는 따로 적용됨
+//   --frame   첫 샘플의 frameCount (GPU 시드와 맞출 때)
+//   --png     톤매핑한 8-bit 결과 (GPU 화면 출력과 같은 톤매핑)
+//   --exr     누적된 선형 radiance (accumImage 와 같은 값)
+//   --denoise SVGF 디노이저 (svgf_*.comp 의 CPU 버전) 를 거친 결과를 --png / --exr 로 씀
+//   --atrous  디노이저 A-Trous 반복 수
+//   --diff-spp N 이면 N spp 정답 이미지를 따로 렌더해 노이즈 결과 / 디노이즈 결과의 RMSE 를 출력 (이미지 비교 테스트용)
+//   --light-grid N 이면 천장 면광원을 N x N 개로 나눈 씬 (makeCornellLightGrid, 다광원 샘플링 검증용)
+//   --uniform-lights light BVH 대신 광원을 균등하게 고름 (--diff-spp 와 같이 써서 수렴 속도 비교)
+//   --adaptive 적응형 샘플링: --spp 는 프레임 수, 프레임마다 픽셀별 0 ~ --adaptive-max 경로 (분산이 큰 곳에 몰아줌)
+//              --diff-spp 정답 이미지는 적응형을 끄고 렌더함
+//   --no-roulette Russian roulette 끔 (켠 결과와 평균이 같은지, 경로 길이가 얼마나 줄었는지 비교용)
+//   --wavefront 메가커널 (픽셀마다 경로 끝까지) 대신 wavefront 큐 (generate → sort → shade → shadow → trace) 로 렌더
+//               재질 bin 별 히트 비율을 출력. 적응형이어도 프레임당 픽셀 경로는 최대 1
+
+#include "ImageIO.h"
+#include "PrismScene.h"
+#include "RefBvh.h"
+#include "RefDenoiser.h"
+#include "RefPathTracer.h"
+#include "RefScene.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+    struct Options {
+        std::string models = "./";
+        Prism::RenderSettings render;
+        std::string pngPath = "reference.png";
+        std::string exrPath;
+        bool denoise = false;
+        Prism::DenoiseParams denoiseParams;
+        uint32_t diffSpp = 0;
+        int lightGrid = 0;
+        bool wavefront = false;
+    };
+
+    void printUsage(const char* exe) {
+        std::cout << "Usage: " << exe
+            << " [--models <dir>] [--width N] [--height N] [--spp N] [--threads N] [--tile N]"
+               " [--full-pt] [--bounces N] [--frame N] [--png <file>] [--exr <file>]"
+               " [--denoise] [--atrous N] [--diff-spp N] [--light-grid N] [--uniform-lights]"
+               " [--adaptive] [--adaptive-threshold X] [--adaptive-max N] [--no-roulette]"
+               " [--wavefront]" << std::endl;
+    }
+
+    bool parseArgs(int argc, char** argv, Options& opt) {
+        opt.render.width = 640;
+        opt.render.height = 360;
+        for (int i = 1; i < argc; i++) {
+            const char* arg = argv[i];
+            bool hasValue = (i + 1 < argc);
+            if (std::strcmp(arg, "--models") == 0 && hasValue) opt.models = argv[++i];
+            else if (std::strcmp(arg, "--width") == 0 && hasValue) opt.render.width = static_cast<uint32_t>(std::atoi(argv[++i]));
+            else if (std::strcmp(arg, "--height") == 0 && hasValue) opt.render.height = static_cast<uint32_t>(std::atoi(argv[++i]));
+            else if (std::strcmp(arg, "--spp") == 0 && hasValue) opt.render.spp = static_cast<uint32_t>(std::atoi(argv[++i]));
+            else if (std::strcmp(arg, "--threads") == 0 && hasValue) opt.render.threads = static_cast<uint32_t>(std::atoi(argv[++i]));
+            else if (std::strcmp(arg, "--tile") == 0 && hasValue) opt.render.tileSize = static_cast<uint32_t>(std::atoi(argv[++i]));
+            else if (std::strcmp(arg, "--full-pt") == 0) opt.render.hybridModes = false;
+            else if (std::strcmp(arg, "--bounces") == 0 && hasValue) opt.render.path.maxBounces = std::atoi(argv[++i]);
+            else if (std::strcmp(arg, "--frame") == 0 && hasValue) opt.render.frameOffset = static_cast<uint32_t>(std::atoi(argv[++i]));
+            else if (std::strcmp(arg, "--png") == 0 && hasValue) opt.pngPath = argv[++i];
+            else if (std::strcmp(arg, "--exr") == 0 && hasValue) opt.exrPath = argv[++i];
+            else if (std::strcmp(arg, "--denoise") == 0) opt.denoise = true;
+            else if (std::strcmp(arg, "--atrous") == 0 && hasValue) opt.denoiseParams.iterations = std::atoi(argv[++i]);
+            else if (std::strcmp(arg, "--diff-spp") == 0 && hasValue) opt.diffSpp = static_cast<uint32_t>(std::atoi(argv[++i]));
+            else if (std::strcmp(arg, "--light-grid") == 0 && hasValue) opt.lightGrid = std::atoi(argv[++i]);
+            else if (std::strcmp(arg, "--uniform-lights") == 0) opt.render.uniformLightSelection = true;
+            else if (std::strcmp(arg, "--adaptive") == 0) opt.render.adaptive.enabled = true;
+            else if (std::strcmp(arg, "--no-roulette") == 0) opt.render.path.russianRoulette = false;
+            else if (std::strcmp(arg, "--wavefront") == 0) opt.wavefront = true;
+            else if (std::strcmp(arg, "--adaptive-threshold") == 0 && hasValue) opt.render.adaptive.threshold = static_cast<float>(std::atof(argv[++i]));
+            else if (std::strcmp(arg, "--adaptive-max") == 0 && hasValue) opt.render.adaptive.maxSamples = std::atoi(argv[++i]);
+            else return false;
+        }
+        if (!opt.models.empty() && opt.models.back() != '/' && opt.models.back() != '\\') opt.models += '/';
+        return opt.render.width > 0 && opt.render.height > 0 && opt.render.spp > 0 && opt.render.path.maxBounces > 0
+            && opt.render.adaptive.maxSamples > 0 && opt.render.adaptive.threshold > 0.0f;
+    }
+
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    try {
+        auto loadStart = std::chrono::high_resolution_clock::now();
+        Prism::RefScene scene = Prism::buildRefScene(Prism::makeCornellLightGrid(opt.models, opt.lightGrid), Prism::makeCornellCamera());
+        if (scene.triangleCount() == 0) {
+            throw std::runtime_error("No geometry loaded from " + opt.models);
+        }
+        Prism::RefPathTracer tracer(scene);
+        auto loadEnd = std::chrono::high_resolution_clock::now();
+
+        std::cout << "[PRISM] Scene: " << scene.materials.size() << " objects, " << scene.triangleCount() << " triangles" << std::endl;
+        std::cout << "[PRISM] BVH: " << Prism::RefBvh::simdName() << ", " << tracer.bvh().nodeCount()
+            << " nodes, depth " << tracer.bvh().maxDepth() << std::endl;
+        std::cout << "[PRISM] Lights: " << scene.lights.lightCount() << " (" << scene.lights.nodeCount() << " BVH nodes), "
+            << (opt.render.uniformLightSelection ? "uniform selection" : "light BVH selection") << std::endl;
+        std::cout << "[PRISM] Setup: "
+            << std::chrono::duration<double, std::milli>(loadEnd - loadStart).count() << " ms" << std::endl;
+
+        std::vector<float> radiance;
+        Prism::WavefrontStats wavefrontStats;
+        Prism::RenderStats stats = opt.wavefront ? tracer.renderWavefront(opt.render, radiance, &wavefrontStats)
+                                                 : tracer.render(opt.render, radiance);
+
+        std::cout << "[PRISM] " << opt.render.width << "x" << opt.render.height << " @ " << opt.render.spp << " spp, "
+            << (opt.render.hybridModes ? "hybrid modes" : "full PT") << ", threads " << stats.threads;
+        if (opt.wavefront) std::cout << ", wavefront" << std::endl;
+        else std::cout << ", tiles " << stats.tiles << " (" << stats.steals << " stolen)" << std::endl;
+        std::cout << std::fixed << std::setprecision(2)
+            << "[PRISM] " << stats.samples << " samples in " << stats.seconds * 1000.0 << " ms -> "
+            << stats.samplesPerSecond() / 1e6 << " Msamples/sec, " << stats.raysPerSecond() / 1e6 << " Mrays/sec" << std::endl;
+        std::cout << "[PRISM] Paths: average length " << stats.averagePathLength() << " segments, "
+            << stats.roulettePercent() << "% ended by roulette" << (opt.render.path.russianRoulette ? "" : " (off)") << std::endl;
+        if (opt.render.adaptive.enabled) {
+            std::cout << "[PRISM] Adaptive: " << stats.pathsPerPixel() << " paths/pixel, "
+                << stats.convergedPercent() << "% pixels converged (threshold " << opt.render.adaptive.threshold << ")" << std::endl;
+        }
+        if (opt.wavefront) {
+            std::cout << "[PRISM] Wavefront: " << wavefrontStats.bounces << " bounce passes, "
+                << wavefrontStats.raysTraced << " queued rays, " << wavefrontStats.shadowRays << " shadow rays" << std::endl;
+            std::cout << "[PRISM] Wavefront bins:";
+            for (uint32_t b = 0; b < Prism::WAVEFRONT_BIN_COUNT; b++)
+                std::cout << " " << Prism::wavefrontBinName(b) << " " << wavefrontStats.binPercent(b) << "%";
+            std::cout << std::endl;
+        }
+
+        std::vector<float> denoised;
+        if (opt.denoise || opt.diffSpp > 0) {
+            Prism::RefGBuffer gbuffer;
+            tracer.renderGBuffer(opt.render, gbuffer);
+            auto denoiseStart = std::chrono::high_resolution_clock::now();
+            denoised = Prism::denoiseSvgf(radiance, gbuffer, opt.denoiseParams);
+            auto denoiseEnd = std::chrono::high_resolution_clock::now();
+            std::cout << "[PRISM] Denoise: " << opt.denoiseParams.iterations << " A-Trous iterations in "
+                << std::chrono::duration<double, std::milli>(denoiseEnd - denoiseStart).count() << " ms" << std::endl;
+        }
+
+        if (opt.diffSpp > 0) {
+            // 정답 이미지는 다른 시드 구간 (노이즈 결과와 샘플이 겹치지 않도록)
+            Prism::RenderSettings refSettings = opt.render;
+            refSettings.spp = opt.diffSpp;
+            refSettings.frameOffset = opt.render.frameOffset + opt.render.spp;
+            refSettings.adaptive.enabled = false;
+            std::vector<float> groundTruth;
+            tracer.render(refSettings, groundTruth);
+            double noisyRmse = Prism::imageRmse(radiance, groundTruth);
+            double denoisedRmse = Prism::imageRmse(denoised, groundTruth);
+            std::cout << std::setprecision(5)
+                << "[PRISM] RMSE vs " << opt.diffSpp << " spp: noisy " << noisyRmse << ", denoised " << denoisedRmse
+                << " (" << std::setprecision(2) << (denoisedRmse > 0.0 ? noisyRmse / denoisedRmse : 0.0) << "x)" << std::endl;
+        }
+        if (opt.denoise) radiance.swap(denoised);
+
+        if (!opt.pngPath.empty()) {
+            Prism::writePng(opt.pngPath, opt.render.width, opt.render.height, Prism::RefPathTracer::tonemap(radiance));
+            std::cout << "[PRISM] Image written to " << opt.pngPath << std::endl;
+        }
+        if (!opt.exrPath.empty()) {
+            Prism::writeExr(opt.exrPath, opt.render.width, opt.render.height, radiance);
+            std::cout << "[PRISM] Radiance written to " << opt.exrPath << std::endl;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// 적응형 샘플링 파라미터 + 픽셀당 경로 수 결정 규칙
+// GPU (raygenbsdf.rgen 의 AdaptiveSampleCount, CameraUBO) 와 CPU 레퍼런스 (reference/RefPathTracer) 가 같이 씀
+// Ogre / Vulkan 의존 없음
+
+namespace Prism {
+
+    struct AdaptiveSamplingParams {
+        bool  enabled    = true;
+        int   minSamples = 16;          // history 가 이만큼 쌓이기 전에는 항상 1 경로 (분산 추정이 불안정)
+        int   maxSamples = 4;           // 한 프레임에 한 픽셀이 쏠 수 있는 최대 경로 수
+        float threshold  = 0.02f;       // 평균의 상대 표준오차가 이보다 작으면 수렴 (경로 0)
+    };
+
+    // 수렴한 픽셀도 이 주기마다 (픽셀마다 어긋나게) 1 경로를 다시 쏴서 분산을 갱신 → 조명 변화 등에 영원히 멈추지 않게
+    constexpr uint32_t kAdaptiveRefreshInterval = 16;
+    // 상대오차 분모 하한 (어두운 픽셀이 끝없이 샘플을 잡아먹지 않도록)
+    constexpr float kAdaptiveMinLuminance = 0.05f;
+
+    // 누적 평균의 상대 표준오차 (raygenbsdf.rgen AdaptiveRelativeError 와 같은 식)
+    //   historyLen : 누적된 경로 수 (accumImage.a), m1 / m2 : 휘도 1, 2차 모멘트 (varianceImage.rg)
+    inline float adaptiveRelativeError(float historyLen, float m1, float m2) {
+        float variance = std::max(m2 - m1 * m1, 0.0f);
+        return std::sqrt(variance / std::max(historyLen, 1.0f)) / std::max(m1, kAdaptiveMinLuminance);
+    }
+
+    // 수렴 판정 (통계의 "converged" 픽셀). history 가 minSamples 보다 짧으면 수렴 아님
+    inline bool adaptiveConverged(const AdaptiveSamplingParams& params, float historyLen, float m1, float m2) {
+        return params.enabled && historyLen >= float(params.minSamples)
+            && adaptiveRelativeError(historyLen, m1, m2) < params.threshold;
+    }
+
+    // 픽셀 하나의 이번 프레임 경로 수 (raygenbsdf.rgen AdaptiveSampleCount 와 같은 식)
+    // 수렴했으면 0 (refresh 프레임만 1), 아니면 오차가 threshold 의 몇 배인지에 비례해 1 ~ maxSamples
+    inline int adaptiveSampleCount(const AdaptiveSamplingParams& params, float historyLen, float m1, float m2,
+                                   uint32_t frameCount, uint32_t pixelX, uint32_t pixelY) {
+        if (!params.enabled || historyLen < float(params.minSamples)) return 1;
+        float relErr = adaptiveRelativeError(historyLen, m1, m2);
+        if (relErr < params.threshold) {
+            bool refresh = (frameCount + pixelX * 7u + pixelY * 13u) % kAdaptiveRefreshInterval == 0u;
+            return refresh ? 1 : 0;
+        }
+        return std::min(std::max(int(std::ceil(relErr / params.threshold)) - 1, 1), params.maxSamples);
+    }
+
+}
@@ -15,7 +15,13 @@ namespace Prism {
                                                                Ogre::CompositorNodeDef* parentNodeDef) 
     {
         if (customId == "ray_tracing") {
-            return OGRE_NEW RTPassDef(Ogre::PASS_CUSTOM, parentTargetDef);
+            return OGRE_NEW RTPassDef(Ogre::PASS_CUSTOM, parentTargetDef, RTPassDef::STAGE_TRACE);
+        }
+        if (customId == "denoise") {
+            return OGRE_NEW RTPassDef(Ogre::PASS_CUSTOM, parentTargetDef, RTPassDef::STAGE_DENOISE);
+        }
+        if (customId == "rt_present") {
+            return OGRE_NEW RTPassDef(Ogre::PASS_CUSTOM, parentTargetDef, RTPassDef::STAGE_PRESENT);
         }
         return nullptr;
     }
@@ -26,7 +32,14 @@ namespace Prism {
                                                            const Ogre::RenderTargetViewDef* rtvDef,
                                                            Ogre::SceneManager* sceneManager)
     {
-        return OGRE_NEW RTPass(definition, parentNode, mRTPipeline, mWindow);
+        switch (static_cast<const RTPassDef*>(definition)->mStage) {
+        case RTPassDef::STAGE_DENOISE:
+            return OGRE_NEW DenoisePass(definition, parentNode, mRTPipeline, mDenoiser);
+        case RTPassDef::STAGE_PRESENT:
+            return OGRE_NEW RTPresentPass(definition, parentNode, mRTPipeline, mWindow);
+        default:
+            return OGRE_NEW RTPass(definition, parentNode, mRTPipeline, mWavefront, mWindow);
+        }
     }
 
     void RTPass::execute(const Ogre::Camera* lodCamera) {
@@ -45,6 +58,13 @@ namespace Prism {
         VkCommandBuffer cmdBuf = device->mGraphicsQueue.getCurrentCmdBuffer();
         if (cmdBuf == VK_NULL_HANDLE) return;
 
+        // 변형 메시(소프트바디) BLAS refit/재빌드 + TLAS 갱신 (등록된 것이 없으면 아무것도 기록 안 함)
+        mRTPipeline->recordDeformableUpdates(cmdBuf);
+        // 움직인 인스턴스만 반영해 TLAS UPDATE
+        mRTPipeline->recordTLASUpdate(cmdBuf);
+        // 렌더 모드 스케줄러가 바꾼 재질만 반영
+        mRTPipeline->recordMaterialUpdates(cmdBuf);
+
         uint32_t width  = mRTPipeline->getRTWidth();
         uint32_t height = mRTPipeline->getRTHeight();
 
@@ -71,13 +91,57 @@ namespace Prism {
                 }
                 vkCmdPipelineBarrier(cmdBuf,
                     VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-                    VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR,
+                    VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,   // wavefront_shade 가 albedo 를 읽음
                     0, 0, nullptr, 0, nullptr, 3, barriers);
             }
         }
 
-        // ── Phase 3: Ray Tracing 실행 ──────────────────────────────────────
-        mRTPipeline->recordRayTracingCommands(cmdBuf, mRTPipeline->getDescriptorSet(), width, height);
+        // ── Phase 3: Ray Tracing 실행 (메가커널 또는 wavefront 단계들) ──────────
+        // 타임스탬프로 감싸서 렌더 모드 스케줄러의 비용 모델 보정에 씀
+        mRTPipeline->recordTraceTimerBegin(cmdBuf);
+        if (mWavefront && mWavefront->isEnabled())
+            mWavefront->recordWavefront(cmdBuf);
+        else
+            mRTPipeline->recordRayTracingCommands(cmdBuf, mRTPipeline->getDescriptorSet(), width, height);
+        mRTPipeline->recordTraceTimerEnd(cmdBuf);
+        // 이번 프레임 누적 결과를 다음 프레임 재투영용 history 로 복사
+        mRTPipeline->recordHistoryCopy(cmdBuf);
+    }
+
+    void DenoisePass::execute(const Ogre::Camera* lodCamera) {
+        if (!mDenoiser || !mRTPipeline || mRTPipeline->getPipeline() == VK_NULL_HANDLE) return;
+        if (mRTPipeline->getDescriptorSet() == VK_NULL_HANDLE) return;
+
+        Ogre::VulkanRenderSystem* rs = static_cast<Ogre::VulkanRenderSystem*>(
+            Ogre::Root::getSingleton().getRenderSystem());
+        Ogre::VulkanDevice* device = rs->getVulkanDevice();
+        if (!device) return;
+
+        device->mGraphicsQueue.endAllEncoders();
+        VkCommandBuffer cmdBuf = device->mGraphicsQueue.getCurrentCmdBuffer();
+        if (cmdBuf == VK_NULL_HANDLE) return;
+
+        // ── SVGF: accumImage → mStorageImage (톤매핑까지) ─────────────────
+        mDenoiser->recordDenoise(cmdBuf);
+    }
+
+    void RTPresentPass::execute(const Ogre::Camera* lodCamera) {
+        // RTPass 와 같은 조건: RTPass 가 G-Buffer 를 SHADER_READ 로 바꾼 프레임에서만 복원
+        if (!mRTPipeline || mRTPipeline->getPipeline() == VK_NULL_HANDLE) return;
+        if (mRTPipeline->getDescriptorSet() == VK_NULL_HANDLE) return;
+        if (!mWindow) return;
+
+        Ogre::VulkanRenderSystem* rs = static_cast<Ogre::VulkanRenderSystem*>(
+            Ogre::Root::getSingleton().getRenderSystem());
+        Ogre::VulkanDevice* device = rs->getVulkanDevice();
+        if (!device) return;
+
+        device->mGraphicsQueue.endAllEncoders();
+        VkCommandBuffer cmdBuf = device->mGraphicsQueue.getCurrentCmdBuffer();
+        if (cmdBuf == VK_NULL_HANDLE) return;
+
+        uint32_t width  = mRTPipeline->getRTWidth();
+        uint32_t height = mRTPipeline->getRTHeight();
 
         // ── Phase 4: StorageImage → SwapChain Blit ────────────────────────
         Ogre::TextureGpu* winTex = mWindow->getTexture();
@@ -113,8 +177,9 @@ namespace Prism {
         dstBarrier.dstAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
 
         VkImageMemoryBarrier preCopyBarriers[] = { srcBarrier, dstBarrier };
+        // StorageImage 는 raygen 또는 디노이저(compute) 가 마지막으로 씀
         vkCmdPipelineBarrier(cmdBuf,
-            VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+            VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
             VK_PIPELINE_STAGE_TRANSFER_BIT,
             0, 0, nullptr, 0, nullptr, 2, preCopyBarriers);
 
@@ -184,7 +249,7 @@ namespace Prism {
                     barriers[i].dstAccessMask       = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
                 }
                 vkCmdPipelineBarrier(cmdBuf,
-                    VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR,
+                    VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
                     VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
                     0, 0, nullptr, 0, nullptr, 3, barriers);
             }
@@ -5,13 +5,23 @@
 #include <OgreCompositorPassDef.h>
 #include <OgreWindow.h>
 #include "PrismRTPipeline.h"
+#include "PrismDenoiser.h"
+#include "PrismWavefront.h"
 
 namespace Prism {
 
+    // customId 별 단계. 노드에는 ray_tracing → denoise → rt_present 순으로 넣음
+    //   ray_tracing : BLAS/TLAS 갱신, G-Buffer → SHADER_READ, traceRays (wavefront 모드면 WavefrontTracer), history 복사
+    //   denoise     : SVGF 디노이저 (꺼져 있으면 아무것도 안 함)
+    //   rt_present  : mStorageImage → SwapChain blit, G-Buffer → COLOR_ATTACHMENT 복원
     class RTPassDef : public Ogre::CompositorPassDef {
     public:
-        RTPassDef(Ogre::CompositorPassType type, Ogre::CompositorTargetDef* parentTargetDef)
-            : Ogre::CompositorPassDef(type, parentTargetDef) {}
+        enum Stage { STAGE_TRACE, STAGE_DENOISE, STAGE_PRESENT };
+
+        RTPassDef(Ogre::CompositorPassType type, Ogre::CompositorTargetDef* parentTargetDef, Stage stage)
+            : Ogre::CompositorPassDef(type, parentTargetDef), mStage(stage) {}
+
+        Stage mStage;
     };
 
     class RTPass : public Ogre::CompositorPass {
@@ -19,9 +29,46 @@ namespace Prism {
         RTPass(const Ogre::CompositorPassDef* definition,
                Ogre::CompositorNode* parentNode,
                RTPipeline* rtPipeline,
+               WavefrontTracer* wavefront,
                Ogre::Window* window)
             : Ogre::CompositorPass(definition, parentNode)
             , mRTPipeline(rtPipeline)
+            , mWavefront(wavefront)
+            , mWindow(window) {}
+
+        virtual void execute(const Ogre::Camera* lodCamera) override;
+
+    private:
+        RTPipeline*      mRTPipeline;
+        WavefrontTracer* mWavefront;
+        Ogre::Window*    mWindow;
+    };
+
+    class DenoisePass : public Ogre::CompositorPass {
+    public:
+        DenoisePass(const Ogre::CompositorPassDef* definition,
+                    Ogre::CompositorNode* parentNode,
+                    RTPipeline* rtPipeline,
+                    Denoiser* denoiser)
+            : Ogre::CompositorPass(definition, parentNode)
+            , mRTPipeline(rtPipeline)
+            , mDenoiser(denoiser) {}
+
+        virtual void execute(const Ogre::Camera* lodCamera) override;
+
+    private:
+        RTPipeline* mRTPipeline;
+        Denoiser*   mDenoiser;
+    };
+
+    class RTPresentPass : public Ogre::CompositorPass {
+    public:
+        RTPresentPass(const Ogre::CompositorPassDef* definition,
+                      Ogre::CompositorNode* parentNode,
+                      RTPipeline* rtPipeline,
+                      Ogre::Window* window)
+            : Ogre::CompositorPass(definition, parentNode)
+            , mRTPipeline(rtPipeline)
             , mWindow(window) {}
 
         virtual void execute(const Ogre::Camera* lodCamera) override;
@@ -33,8 +80,8 @@ namespace Prism {
 
     class RTCompositorPassProvider : public Ogre::CompositorPassProvider {
     public:
-        RTCompositorPassProvider(RTPipeline* rtPipeline, Ogre::Window* window)
-            : mRTPipeline(rtPipeline), mWindow(window) {}
+        RTCompositorPassProvider(RTPipeline* rtPipeline, Denoiser* denoiser, WavefrontTracer* wavefront, Ogre::Window* window)
+            : mRTPipeline(rtPipeline), mDenoiser(denoiser), mWavefront(wavefront), mWindow(window) {}
 
         virtual Ogre::CompositorPassDef* addPassDef(Ogre::CompositorPassType passType,
                                                   Ogre::IdString customId,
@@ -48,8 +95,10 @@ namespace Prism {
                                              Ogre::SceneManager* sceneManager) override;
 
     private:
-        RTPipeline*   mRTPipeline;
-        Ogre::Window* mWindow;
+        RTPipeline*      mRTPipeline;
+        Denoiser*        mDenoiser;
+        WavefrontTracer* mWavefront;
+        Ogre::Window*    mWindow;
     };
 
 }
@@ -0,0 +1,17 @@
+#pragma once
+
+// SVGF(A-Trous) 디노이저 파라미터
+// GPU (svgf_variance.comp / svgf_atrous.comp push constant) 와 CPU 레퍼런스 (reference/RefDenoiser) 가 같이 씀
+// Ogre / Vulkan 의존 없음
+
+namespace Prism {
+
+    struct DenoiseParams {
+        int   iterations  = 5;          // wavelet 반복 수 (step 1, 2, 4, 8, 16 → 유효 반경 62 px)
+        float phiColor    = 4.0f;       // 휘도 edge-stopping: |l_p - l_q| / (phiColor * sigma_l)
+        float phiNormal   = 128.0f;     // 법선 edge-stopping: max(dot(n_p, n_q), 0) ^ phiNormal
+        float phiDepth    = 0.05f;      // 깊이 edge-stopping: |z_p - z_q| / (phiDepth * z_p * 픽셀 거리)
+        float phiMaterial = 0.1f;       // 재질 edge-stopping: (|roughness 차| + |metallic 차|) / phiMaterial
+    };
+
+}
@@ -0,0 +1,257 @@
+#include "PrismDenoiser.h"
+#include "PrismMemoryPool.h"
+#include <OgreVulkanDevice.h>
+#include <OgreLogManager.h>
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Prism {
+
+    Denoiser::Denoiser(RTPipeline* rtPipeline) : mRTPipeline(rtPipeline) {}
+    Denoiser::~Denoiser() { cleanup(); }
+
+    void Denoiser::initialize() {
+        if (!mRTPipeline || !mRTPipeline->getDevice()) return;
+        mDevice = mRTPipeline->getDevice();
+        mWidth  = mRTPipeline->getRTWidth();
+        mHeight = mRTPipeline->getRTHeight();
+
+        createImages();
+        createPipelines();
+        createDescriptorSets();
+    }
+
+    void Denoiser::cleanup() {
+        if (!mDevice || mDevice->mDevice == VK_NULL_HANDLE) return;
+        VkDevice device = mDevice->mDevice;
+
+        if (mVariancePipeline    != VK_NULL_HANDLE) vkDestroyPipeline(device, mVariancePipeline, nullptr);
+        if (mAtrousPipeline      != VK_NULL_HANDLE) vkDestroyPipeline(device, mAtrousPipeline, nullptr);
+        if (mPipelineLayout      != VK_NULL_HANDLE) vkDestroyPipelineLayout(device, mPipelineLayout, nullptr);
+        if (mDescriptorPool      != VK_NULL_HANDLE) vkDestroyDescriptorPool(device, mDescriptorPool, nullptr);
+        if (mDescriptorSetLayout != VK_NULL_HANDLE) vkDestroyDescriptorSetLayout(device, mDescriptorSetLayout, nullptr);
+        if (mGBufferSampler      != VK_NULL_HANDLE) vkDestroySampler(device, mGBufferSampler, nullptr);
+        for (int i = 0; i < 2; i++) {
+            if (mPingPongViews[i]  != VK_NULL_HANDLE) vkDestroyImageView(device, mPingPongViews[i], nullptr);
+            if (mPingPongImages[i] != VK_NULL_HANDLE) vkDestroyImage(device, mPingPongImages[i], nullptr);
+            if (mPingPongMemory[i] != VK_NULL_HANDLE) vkFreeMemory(device, mPingPongMemory[i], nullptr);
+            mPingPongViews[i] = VK_NULL_HANDLE; mPingPongImages[i] = VK_NULL_HANDLE; mPingPongMemory[i] = VK_NULL_HANDLE;
+        }
+        mVariancePipeline = mAtrousPipeline = VK_NULL_HANDLE;
+        mPipelineLayout = VK_NULL_HANDLE;
+        mDescriptorPool = VK_NULL_HANDLE;
+        mDescriptorSetLayout = VK_NULL_HANDLE;
+        mGBufferSampler = VK_NULL_HANDLE;
+        mDevice = nullptr;
+    }
+
+    void Denoiser::createImages() {
+        VkDevice device = mDevice->mDevice;
+        for (int i = 0; i < 2; i++) {
+            VkImageCreateInfo imgInfo = { VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
+            imgInfo.imageType   = VK_IMAGE_TYPE_2D; imgInfo.format = VK_FORMAT_R32G32B32A32_SFLOAT; imgInfo.extent = { mWidth, mHeight, 1 };
+            imgInfo.mipLevels   = 1; imgInfo.arrayLayers = 1; imgInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+            imgInfo.tiling      = VK_IMAGE_TILING_OPTIMAL; imgInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT;
+            if (vkCreateImage(device, &imgInfo, nullptr, &mPingPongImages[i]) != VK_SUCCESS) {
+                throw std::runtime_error("PRISM: Failed to create denoiser image!");
+            }
+            VkMemoryRequirements memReqs; vkGetImageMemoryRequirements(device, mPingPongImages[i], &memReqs);
+            VkMemoryAllocateInfo allocInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+            allocInfo.allocationSize = memReqs.size;
+            allocInfo.memoryTypeIndex = findMemoryType(mDevice->mPhysicalDevice, memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+            if (vkAllocateMemory(device, &allocInfo, nullptr, &mPingPongMemory[i]) != VK_SUCCESS) {
+                throw std::runtime_error("PRISM: Denoiser image memory allocation failed!");
+            }
+            vkBindImageMemory(device, mPingPongImages[i], mPingPongMemory[i], 0);
+            VkImageViewCreateInfo viewInfo = { VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO };
+            viewInfo.image    = mPingPongImages[i]; viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D; viewInfo.format = VK_FORMAT_R32G32B32A32_SFLOAT;
+            viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+            vkCreateImageView(device, &viewInfo, nullptr, &mPingPongViews[i]);
+        }
+
+        // G-Buffer 는 texelFetch 로만 읽지만 combined sampler 바인딩에 필요
+        VkSamplerCreateInfo si = { VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO };
+        si.magFilter    = VK_FILTER_NEAREST;
+        si.minFilter    = VK_FILTER_NEAREST;
+        si.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        si.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        si.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        si.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        vkCreateSampler(device, &si, nullptr, &mGBufferSampler);
+    }
+
+    void Denoiser::createPipelines() {
+        VkDevice device = mDevice->mDevice;
+
+        std::vector<VkDescriptorSetLayoutBinding> b;
+        auto add = [&](uint32_t i, VkDescriptorType t) {
+            VkDescriptorSetLayoutBinding bind{}; bind.binding = i; bind.descriptorType = t; bind.descriptorCount = 1; bind.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT; b.push_back(bind);
+        };
+        add(0, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE);           // input color
+        add(1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE);           // output color
+        add(2, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE);           // surface (w: 거리)
+        add(3, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);  // G-Buffer normal
+        add(4, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);  // G-Buffer material
+        add(5, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE);           // LDR output (mStorageImage)
+        VkDescriptorSetLayoutCreateInfo lci = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
+        lci.bindingCount = (uint32_t)b.size(); lci.pBindings = b.data();
+        vkCreateDescriptorSetLayout(device, &lci, nullptr, &mDescriptorSetLayout);
+
+        VkPushConstantRange pcr = { VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstants) };
+        VkPipelineLayoutCreateInfo plci = { VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
+        plci.setLayoutCount = 1; plci.pSetLayouts = &mDescriptorSetLayout;
+        plci.pushConstantRangeCount = 1; plci.pPushConstantRanges = &pcr;
+        vkCreatePipelineLayout(device, &plci, nullptr, &mPipelineLayout);
+
+        auto createCompute = [&](const std::string& path) -> VkPipeline {
+            std::ifstream file(path, std::ios::ate | std::ios::binary);
+            if (!file.is_open()) {
+                Ogre::LogManager::getSingleton().logMessage("[PRISM] Shader not found: " + path);
+                return VK_NULL_HANDLE;
+            }
+            size_t size = (size_t)file.tellg();
+            std::vector<char> buf(size); file.seekg(0); file.read(buf.data(), size);
+            VkShaderModuleCreateInfo ci = { VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO };
+            ci.codeSize = buf.size(); ci.pCode = reinterpret_cast<const uint32_t*>(buf.data());
+            VkShaderModule sm; vkCreateShaderModule(device, &ci, nullptr, &sm);
+
+            VkComputePipelineCreateInfo pci = { VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO };
+            pci.stage = { VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO };
+            pci.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT; pci.stage.module = sm; pci.stage.pName = "main";
+            pci.layout = mPipelineLayout;
+            VkPipeline pipeline = VK_NULL_HANDLE;
+            vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pci, nullptr, &pipeline);
+            vkDestroyShaderModule(device, sm, nullptr);
+            return pipeline;
+        };
+        mVariancePipeline = createCompute("shaders/svgf_variance.comp.spv");
+        mAtrousPipeline   = createCompute("shaders/svgf_atrous.comp.spv");
+    }
+
+    void Denoiser::createDescriptorSets() {
+        VkDevice device = mDevice->mDevice;
+
+        std::vector<VkDescriptorPoolSize> poolSizes = {
+            { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 4 * SET_COUNT },            // input, output, surface, LDR
+            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 2 * SET_COUNT }    // G-Buffer normal, material
+        };
+        VkDescriptorPoolCreateInfo pci = { VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+        pci.maxSets = SET_COUNT; pci.poolSizeCount = (uint32_t)poolSizes.size(); pci.pPoolSizes = poolSizes.data();
+        vkCreateDescriptorPool(device, &pci, nullptr, &mDescriptorPool);
+
+        VkDescriptorSetLayout layouts[SET_COUNT] = { mDescriptorSetLayout, mDescriptorSetLayout, mDescriptorSetLayout };
+        VkDescriptorSetAllocateInfo ai = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+        ai.descriptorPool = mDescriptorPool; ai.descriptorSetCount = SET_COUNT; ai.pSetLayouts = layouts;
+        vkAllocateDescriptorSets(device, &ai, mDescriptorSets);
+
+        auto storage = [](VkImageView view) {
+            VkDescriptorImageInfo info{}; info.imageView = view; info.imageLayout = VK_IMAGE_LAYOUT_GENERAL; return info;
+        };
+        const VkImageView inputs[SET_COUNT]  = { mRTPipeline->getAccumImageView(), mPingPongViews[0], mPingPongViews[1] };
+        const VkImageView outputs[SET_COUNT] = { mPingPongViews[0], mPingPongViews[1], mPingPongViews[0] };
+
+        // G-Buffer 바인딩(3, 4) 은 setGBufferViews() 에서
+        std::vector<VkDescriptorImageInfo> infos; infos.reserve(SET_COUNT * 4);
+        std::vector<VkWriteDescriptorSet> writes;
+        for (int s = 0; s < SET_COUNT; s++) {
+            const VkImageView views[4] = { inputs[s], outputs[s], mRTPipeline->getSurfaceImageView(), mRTPipeline->getStorageImageView() };
+            const uint32_t bindings[4] = { 0, 1, 2, 5 };
+            for (int k = 0; k < 4; k++) {
+                infos.push_back(storage(views[k]));
+                VkWriteDescriptorSet w = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+                w.dstSet = mDescriptorSets[s]; w.dstBinding = bindings[k]; w.descriptorCount = 1;
+                w.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE; w.pImageInfo = &infos.back();
+                writes.push_back(w);
+            }
+        }
+        vkUpdateDescriptorSets(device, (uint32_t)writes.size(), writes.data(), 0, nullptr);
+    }
+
+    void Denoiser::setGBufferViews(VkImageView normalView, VkImageView materialView) {
+        if (mDescriptorPool == VK_NULL_HANDLE) return;
+
+        VkDescriptorImageInfo infos[2] = {};
+        infos[0].sampler = mGBufferSampler; infos[0].imageView = normalView;   infos[0].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        infos[1].sampler = mGBufferSampler; infos[1].imageView = materialView; infos[1].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+        VkWriteDescriptorSet writes[SET_COUNT * 2] = {};
+        for (int s = 0; s < SET_COUNT; s++) {
+            for (int k = 0; k < 2; k++) {
+                VkWriteDescriptorSet& w = writes[s * 2 + k];
+                w.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                w.dstSet = mDescriptorSets[s]; w.dstBinding = 3 + k; w.descriptorCount = 1;
+                w.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER; w.pImageInfo = &infos[k];
+            }
+        }
+        vkUpdateDescriptorSets(mDevice->mDevice, SET_COUNT * 2, writes, 0, nullptr);
+        mGBufferBound = true;
+
+        Ogre::LogManager::getSingleton().logMessage("[PRISM] Denoiser: G-Buffer normal/material bound");
+    }
+
+    void Denoiser::recordDenoise(VkCommandBuffer cmd) {
+        if (!mEnabled || !mGBufferBound) return;
+        if (mVariancePipeline == VK_NULL_HANDLE || mAtrousPipeline == VK_NULL_HANDLE) return;
+
+        // raygen 쓰기 / 히스토리 복사 / 이전 프레임 디노이즈 → 이번 compute 읽기·쓰기
+        VkMemoryBarrier mb = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+        mb.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+        mb.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        if (!mImagesInitialized) {
+            VkImageMemoryBarrier ib[2] = {};
+            for (int i = 0; i < 2; i++) {
+                ib[i].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                ib[i].oldLayout = VK_IMAGE_LAYOUT_UNDEFINED; ib[i].newLayout = VK_IMAGE_LAYOUT_GENERAL;
+                ib[i].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED; ib[i].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                ib[i].dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+                ib[i].image = mPingPongImages[i]; ib[i].subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+            }
+            vkCmdPipelineBarrier(cmd,
+                VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &mb, 0, nullptr, 2, ib);
+            mImagesInitialized = true;
+        } else {
+            vkCmdPipelineBarrier(cmd,
+                VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &mb, 0, nullptr, 0, nullptr);
+        }
+
+        PushConstants pc{};
+        pc.phiColor    = mParams.phiColor;
+        pc.phiNormal   = mParams.phiNormal;
+        pc.phiDepth    = mParams.phiDepth;
+        pc.phiMaterial = mParams.phiMaterial;
+        pc.exposure    = 2.5f;      // raygenbsdf.rgen 과 같은 노출
+
+        const uint32_t groupsX = (mWidth + 7) / 8, groupsY = (mHeight + 7) / 8;
+        VkMemoryBarrier passBarrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+        passBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        passBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+        // 분산 추정: accum → A
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, mVariancePipeline);
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, mPipelineLayout, 0, 1, &mDescriptorSets[SET_VARIANCE], 0, nullptr);
+        pc.stepSize = 1; pc.finalPass = 0;
+        vkCmdPushConstants(cmd, mPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstants), &pc);
+        vkCmdDispatch(cmd, groupsX, groupsY, 1);
+
+        // A-Trous: A → B → A → ... (마지막 단계가 mStorageImage 에 톤매핑 결과를 씀)
+        const int iterations = std::max(mParams.iterations, 1);
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, mAtrousPipeline);
+        for (int i = 0; i < iterations; i++) {
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                0, 1, &passBarrier, 0, nullptr, 0, nullptr);
+            VkDescriptorSet ds = mDescriptorSets[(i % 2 == 0) ? SET_A_TO_B : SET_B_TO_A];
+            vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, mPipelineLayout, 0, 1, &ds, 0, nullptr);
+            pc.stepSize = 1 << i;
+            pc.finalPass = (i == iterations - 1) ? 1 : 0;
+            vkCmdPushConstants(cmd, mPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstants), &pc);
+            vkCmdDispatch(cmd, groupsX, groupsY, 1);
+        }
+        // mStorageImage 의 compute 쓰기 → blit 동기화는 present 패스의 GENERAL → TRANSFER_SRC 배리어가 함
+    }
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include "PrismDenoiseParams.h"
+#include "PrismRTPipeline.h"
+
+namespace Prism {
+
+    // SVGF 스타일 디노이저 (compute)
+    //   1) svgf_variance.comp : accumImage → 분산 추정 (rgb + 분산)
+    //   2) svgf_atrous.comp   : A-Trous wavelet 을 iterations 번 (step 1, 2, 4, ...) 핑퐁, 마지막에 톤매핑해서 mStorageImage 에 씀
+    // 입력은 RTPipeline 의 accumImage / surface 이미지 (재투영 누적 결과) 와 G-Buffer normal / material
+    // CPU 레퍼런스: reference/RefDenoiser (같은 식, 같은 DenoiseParams)
+    class Denoiser {
+    public:
+        explicit Denoiser(RTPipeline* rtPipeline);
+        ~Denoiser();
+
+        // RTPipeline::initialize() 이후 호출 (RT 이미지 뷰를 descriptor 에 연결)
+        void initialize();
+        void cleanup();
+
+        // G-Buffer 텍스처 연동 (addWorkspace 이후, RTPipeline::setGBufferImages 와 같은 시점)
+        void setGBufferViews(VkImageView normalView, VkImageView materialView);
+
+        // traceRays + recordHistoryCopy 뒤에 호출. 꺼져 있거나 G-Buffer 가 아직 없으면 아무것도 기록 안 함
+        // (이 경우 raygen 이 직접 톤매핑한 mStorageImage 가 그대로 화면에 나감)
+        void recordDenoise(VkCommandBuffer cmdBuf);
+
+        void setEnabled(bool enabled) { mEnabled = enabled; }
+        bool isEnabled() const { return mEnabled; }
+        DenoiseParams& getParams() { return mParams; }
+
+    private:
+        struct PushConstants {
+            int   stepSize;
+            int   finalPass;
+            float phiColor;
+            float phiNormal;
+            float phiDepth;
+            float phiMaterial;
+            float exposure;
+        };
+
+        // 0: accum → A (분산), 1: A → B, 2: B → A
+        enum { SET_VARIANCE, SET_A_TO_B, SET_B_TO_A, SET_COUNT };
+
+        void createImages();
+        void createPipelines();
+        void createDescriptorSets();
+
+        RTPipeline*         mRTPipeline;
+        Ogre::VulkanDevice* mDevice = nullptr;
+
+        DenoiseParams mParams;
+        bool mEnabled = true;
+        bool mGBufferBound = false;
+        bool mImagesInitialized = false;    // 핑퐁 이미지 UNDEFINED → GENERAL 전환 여부 (첫 recordDenoise 에서)
+
+        // 핑퐁 이미지 (RGBA32F, rgb: 색, a: 분산)
+        VkImage        mPingPongImages[2] = { VK_NULL_HANDLE, VK_NULL_HANDLE };
+        VkDeviceMemory mPingPongMemory[2] = { VK_NULL_HANDLE, VK_NULL_HANDLE };
+        VkImageView    mPingPongViews[2]  = { VK_NULL_HANDLE, VK_NULL_HANDLE };
+
+        VkSampler             mGBufferSampler      = VK_NULL_HANDLE;
+        VkDescriptorSetLayout mDescriptorSetLayout = VK_NULL_HANDLE;
+        VkDescriptorPool      mDescriptorPool      = VK_NULL_HANDLE;
+        VkDescriptorSet       mDescriptorSets[SET_COUNT] = {};
+        VkPipelineLayout      mPipelineLayout      = VK_NULL_HANDLE;
+        VkPipeline            mVariancePipeline    = VK_NULL_HANDLE;
+        VkPipeline            mAtrousPipeline      = VK_NULL_HANDLE;
+
+        uint32_t mWidth = 0;
+        uint32_t mHeight = 0;
+    };
+
+}
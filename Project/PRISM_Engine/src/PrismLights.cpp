@@ -0,0 +1,261 @@
+#include "PrismLights.h"
+#include "PrismObjLoader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <unordered_map>
+
+namespace Prism {
+
+    namespace {
+
+        const float PI = 3.14159265359f;
+        const int   kMaxTraversal = 64;        // 셰이더 LIGHT_BVH_MAX_DEPTH 와 같음
+
+        // reference/RefMath.h 는 엔진 쪽에서 쓸 수 없으므로 필요한 것만
+        Float3 add(const Float3& a, const Float3& b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+        Float3 sub(const Float3& a, const Float3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+        Float3 mul(const Float3& a, const Float3& b) { return { a.x * b.x, a.y * b.y, a.z * b.z }; }
+        Float3 scale(const Float3& a, float s) { return { a.x * s, a.y * s, a.z * s }; }
+        float  dot(const Float3& a, const Float3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+        Float3 cross(const Float3& a, const Float3& b) {
+            return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+        }
+        float  length(const Float3& a) { return std::sqrt(dot(a, a)); }
+        Float3 minOf(const Float3& a, const Float3& b) { return { std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z) }; }
+        Float3 maxOf(const Float3& a, const Float3& b) { return { std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z) }; }
+        float  component(const Float3& a, int axis) { return axis == 0 ? a.x : (axis == 1 ? a.y : a.z); }
+        float  luminance(const Float3& c) { return dot(c, Float3{ 0.2126f, 0.7152f, 0.0722f }); }
+        float  clampf(float v, float lo, float hi) { return std::min(std::max(v, lo), hi); }
+
+        Float3 load3(const float v[3]) { return { v[0], v[1], v[2] }; }
+        void store3(float dst[3], const Float3& v) { dst[0] = v.x; dst[1] = v.y; dst[2] = v.z; }
+
+        // BVH 빌드용 광원 요약
+        struct BuildLight {
+            Float3 boxMin, boxMax, centroid;
+            Float3 normal;
+            bool   omni = false;        // 점광원: 법선 콘 없음
+        };
+
+        int32_t buildNode(LightSet& set, const std::vector<BuildLight>& info, std::vector<uint32_t>& order,
+                          uint32_t start, uint32_t count, int32_t parent) {
+            const int32_t index = static_cast<int32_t>(set.nodes.size());
+            set.nodes.emplace_back();
+
+            GpuLightNode node{};
+            node.parent = parent;
+            Float3 boxMin = info[order[start]].boxMin, boxMax = info[order[start]].boxMax;
+            Float3 centroidMin = info[order[start]].centroid, centroidMax = centroidMin;
+            Float3 normalSum{};
+            bool omni = false;
+            float power = 0.0f;
+            for (uint32_t i = start; i < start + count; i++) {
+                const BuildLight& l = info[order[i]];
+                boxMin = minOf(boxMin, l.boxMin);
+                boxMax = maxOf(boxMax, l.boxMax);
+                centroidMin = minOf(centroidMin, l.centroid);
+                centroidMax = maxOf(centroidMax, l.centroid);
+                normalSum = add(normalSum, l.normal);
+                omni = omni || l.omni;
+                power += set.lights[order[i]].power;
+            }
+            store3(node.boxMin, boxMin);
+            store3(node.boxMax, boxMax);
+            node.power = power;
+
+            // 법선 콘: 평균 법선을 축으로, 가장 벌어진 법선까지의 각
+            float normalLen = length(normalSum);
+            if (omni || normalLen < 1e-4f) {
+                store3(node.axis, Float3{ 0.0f, 1.0f, 0.0f });
+                node.cosCone = -1.0f;
+            } else {
+                Float3 axis = scale(normalSum, 1.0f / normalLen);
+                float cosCone = 1.0f;
+                for (uint32_t i = start; i < start + count; i++) cosCone = std::min(cosCone, dot(axis, info[order[i]].normal));
+                store3(node.axis, axis);
+                node.cosCone = cosCone;
+            }
+
+            if (count == 1) {
+                node.left = -static_cast<int32_t>(order[start]) - 1;
+                node.right = -1;
+                set.lights[order[start]].leafNode = index;
+                set.nodes[index] = node;
+                return index;
+            }
+
+            // 중심점 범위가 가장 긴 축의 중앙값으로 나눔 (광원 수 기준 균형 트리 → 깊이 log2 N)
+            Float3 extent = sub(centroidMax, centroidMin);
+            int axis = (extent.x > extent.y && extent.x > extent.z) ? 0 : (extent.y > extent.z ? 1 : 2);
+            uint32_t mid = start + count / 2;
+            std::nth_element(order.begin() + start, order.begin() + mid, order.begin() + start + count,
+                [&](uint32_t a, uint32_t b) { return component(info[a].centroid, axis) < component(info[b].centroid, axis); });
+
+            node.left = buildNode(set, info, order, start, mid - start, index);
+            node.right = buildNode(set, info, order, mid, start + count - mid, index);
+            set.nodes[index] = node;
+            return index;
+        }
+
+    }
+
+    LightSet buildLightSet(const std::vector<SceneObject>& objects, const std::vector<PointLightDesc>& pointLights) {
+        LightSet set;
+        std::vector<BuildLight> info;
+        set.objectLightOffsets.assign(objects.size(), -1);
+
+        std::unordered_map<std::string, RawObj> meshCache;
+        for (size_t i = 0; i < objects.size(); i++) {
+            const SceneObject& obj = objects[i];
+            if (obj.emissive <= 0.0f) continue;
+
+            auto it = meshCache.find(obj.modelPath);
+            if (it == meshCache.end()) it = meshCache.emplace(obj.modelPath, parseObj(obj.modelPath)).first;
+            const RawObj& raw = it->second;
+            if (raw.pos.empty()) {
+                std::cerr << "[PRISM] Empty emissive mesh: " << obj.modelPath << std::endl;
+                continue;
+            }
+
+            set.objectLightOffsets[i] = static_cast<int32_t>(set.lights.size());
+            const Float3 emission = scale(obj.albedo, obj.emissive);
+            auto toWorld = [&](const Float3& p) { return add(mul(p, obj.scale), obj.position); };
+            for (size_t t = 0; t + 2 < raw.indices.size(); t += 3) {
+                uint32_t i0 = raw.indices[t], i1 = raw.indices[t + 1], i2 = raw.indices[t + 2];
+                Float3 v0 = toWorld(raw.pos[i0]), v1 = toWorld(raw.pos[i1]), v2 = toWorld(raw.pos[i2]);
+
+                // 발광 면 = 정점 법선 쪽 (closesthitbsdf.rchit 의 geomNormal 뒤집기와 같은 규칙)
+                // 법선 변환 n / scale 은 방향 판정에만 쓰므로 정규화하지 않음
+                Float3 c = cross(sub(v1, v0), sub(v2, v0));
+                float cLen = length(c);
+                Float3 vertexNormal = add(add(raw.normals[i0], raw.normals[i1]), raw.normals[i2]);
+                vertexNormal = { vertexNormal.x / obj.scale.x, vertexNormal.y / obj.scale.y, vertexNormal.z / obj.scale.z };
+                Float3 normal = cLen > 0.0f ? scale(c, 1.0f / cLen) : Float3{ 0.0f, 1.0f, 0.0f };
+                if (dot(normal, vertexNormal) < 0.0f) normal = scale(normal, -1.0f);
+
+                GpuLightEntry e{};
+                store3(e.v0, v0); store3(e.v1, v1); store3(e.v2, v2);
+                store3(e.emission, emission);
+                store3(e.normal, normal);
+                e.type = LIGHT_TRIANGLE;
+                e.area = 0.5f * cLen;
+                e.power = luminance(emission) * e.area * PI;   // 한 면 Lambertian 발광
+                set.lights.push_back(e);
+
+                BuildLight b;
+                b.boxMin = minOf(minOf(v0, v1), v2);
+                b.boxMax = maxOf(maxOf(v0, v1), v2);
+                b.centroid = scale(add(add(v0, v1), v2), 1.0f / 3.0f);
+                b.normal = normal;
+                info.push_back(b);
+            }
+        }
+
+        for (const PointLightDesc& p : pointLights) {
+            GpuLightEntry e{};
+            store3(e.v0, p.position); store3(e.v1, p.position); store3(e.v2, p.position);
+            store3(e.emission, scale(p.color, p.intensity));
+            e.type = LIGHT_POINT;
+            e.power = luminance(scale(p.color, p.intensity)) * 4.0f * PI;
+            set.lights.push_back(e);
+
+            BuildLight b;
+            b.boxMin = b.boxMax = b.centroid = p.position;
+            b.omni = true;
+            info.push_back(b);
+        }
+
+        for (const GpuLightEntry& e : set.lights) set.totalPower += e.power;
+        if (set.lights.empty()) return set;
+
+        std::vector<uint32_t> order(set.lights.size());
+        for (uint32_t i = 0; i < order.size(); i++) order[i] = i;
+        set.nodes.reserve(set.lights.size() * 2 - 1);
+        buildNode(set, info, order, 0, static_cast<uint32_t>(order.size()), -1);
+        return set;
+    }
+
+    void applyLightOffsets(const LightSet& lightSet, std::vector<InstanceMaterial>& materials) {
+        size_t count = std::min(materials.size(), lightSet.objectLightOffsets.size());
+        for (size_t i = 0; i < count; i++) materials[i].pbrParams2[3] = static_cast<float>(lightSet.objectLightOffsets[i]);
+    }
+
+    float lightNodeImportance(const GpuLightNode& node, const Float3& P, const Float3& N) {
+        if (node.power <= 0.0f) return 0.0f;
+        Float3 boxMin = load3(node.boxMin), boxMax = load3(node.boxMax);
+        Float3 center = scale(add(boxMin, boxMax), 0.5f);
+        Float3 extent = sub(boxMax, boxMin);
+        Float3 toP = sub(P, center);
+        float d2 = dot(toP, toP);
+        float r2 = 0.25f * dot(extent, extent);
+
+        // 경계구 안: 방향 항 없이 거리를 경계구 반지름으로 제한
+        if (d2 <= r2) return node.power / std::max(r2, 1e-4f);
+
+        float d = std::sqrt(d2);
+        Float3 dir = scale(toP, 1.0f / d);                  // 광원 → P
+        float thetaU = std::asin(std::sqrt(r2 / d2));        // 경계구가 P 에서 차지하는 반각
+
+        // 발광 방향 항: 법선 콘을 경계구만큼 넓혀도 P 를 향하지 못하면 0
+        float thetaE = std::acos(clampf(dot(load3(node.axis), dir), -1.0f, 1.0f))
+                     - std::acos(clampf(node.cosCone, -1.0f, 1.0f)) - thetaU;
+        thetaE = std::max(thetaE, 0.0f);
+        if (thetaE >= 0.5f * PI) return 0.0f;
+
+        // 수신 면 항: 경계구 전체가 P 의 접평면 아래면 0
+        float thetaR = std::max(std::acos(clampf(-dot(N, dir), -1.0f, 1.0f)) - thetaU, 0.0f);
+        if (thetaR >= 0.5f * PI) return 0.0f;
+
+        return node.power * std::cos(thetaE) * std::cos(thetaR) / d2;
+    }
+
+    int32_t sampleLightBvh(const LightSet& lightSet, const Float3& P, const Float3& N, float u, float& pmf) {
+        pmf = 0.0f;
+        if (lightSet.nodes.empty()) return -1;
+
+        int32_t index = 0;
+        float p = 1.0f;
+        for (int guard = 0; guard < kMaxTraversal; guard++) {
+            const GpuLightNode& node = lightSet.nodes[index];
+            if (node.left < 0) {
+                pmf = p;
+                return -node.left - 1;
+            }
+            float wl = lightNodeImportance(lightSet.nodes[node.left], P, N);
+            float wr = lightNodeImportance(lightSet.nodes[node.right], P, N);
+            float sum = wl + wr;
+            if (sum <= 0.0f) return -1;
+            float pl = wl / sum;
+            if (u < pl) {
+                u = std::min(u / pl, 0.99999994f);
+                p *= pl;
+                index = node.left;
+            } else {
+                u = std::min((u - pl) / (1.0f - pl), 0.99999994f);
+                p *= 1.0f - pl;
+                index = node.right;
+            }
+        }
+        return -1;
+    }
+
+    float lightBvhPmf(const LightSet& lightSet, int32_t light, const Float3& P, const Float3& N) {
+        if (light < 0 || light >= static_cast<int32_t>(lightSet.lights.size())) return 0.0f;
+        int32_t index = lightSet.lights[light].leafNode;
+        float p = 1.0f;
+        for (int guard = 0; guard < kMaxTraversal && lightSet.nodes[index].parent >= 0; guard++) {
+            int32_t parentIndex = lightSet.nodes[index].parent;
+            const GpuLightNode& parent = lightSet.nodes[parentIndex];
+            float wl = lightNodeImportance(lightSet.nodes[parent.left], P, N);
+            float wr = lightNodeImportance(lightSet.nodes[parent.right], P, N);
+            float sum = wl + wr;
+            if (sum <= 0.0f) return 0.0f;
+            p *= (index == parent.left ? wl : wr) / sum;
+            index = parentIndex;
+        }
+        return p;
+    }
+
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "PrismScene.h"
+
+#include <cstdint>
+#include <vector>
+
+// Ogre / Vulkan 을 포함하지 않는 광원 목록 + light BVH
+// PRISM_Engine(main.cpp → RTPipeline 바인딩 13, 14) 과 CPU 레퍼런스 렌더러(reference/) 가 같은 빌드 결과와 같은 샘플링 식을 씀
+//
+// - emissive SceneObject 의 삼각형을 월드 공간으로 펼쳐 삼각형 광원 하나씩 (한 면만 발광: 바깥쪽 정점 법선 방향)
+// - 해석적 점광원 (PointLightDesc)
+// - 광원 하나가 잎 하나인 이진 BVH. 노드마다 박스 / 전체 power / 법선 콘을 들고 있어서
+//   셰이더는 루트부터 두 자식의 중요도 비율로 내려가며 광원 하나를 고름 (광원 수 N 에 대해 O(log N))
+
+namespace Prism {
+
+    enum LightType : int32_t {
+        LIGHT_TRIANGLE = 0,
+        LIGHT_POINT    = 1,
+    };
+
+    // raygenbsdf.rgen: layout(binding=13) buffer LightBuffer (std430, 80 bytes)
+    struct GpuLightEntry {
+        float   v0[3];          // 점광원이면 위치
+        float   area;
+        float   v1[3];
+        int32_t type;           // LightType
+        float   v2[3];
+        int32_t leafNode;       // 이 광원의 BVH 잎 노드 (MIS 에서 선택 확률 역산용)
+        float   emission[3];    // 삼각형: radiance, 점광원: intensity * color
+        float   power;
+        float   normal[3];      // 발광 방향 (삼각형만)
+        float   padding;
+    };
+
+    // raygenbsdf.rgen: layout(binding=14) buffer LightNodeBuffer (std430, 64 bytes). 0 번이 루트
+    struct GpuLightNode {
+        float   boxMin[3];
+        float   power;          // 서브트리 광원 power 합
+        float   boxMax[3];
+        int32_t left;           // >= 0: 왼쪽 자식 노드, < 0: 잎 (광원 인덱스 = -left - 1)
+        float   axis[3];        // 법선 콘 축
+        float   cosCone;        // 법선 콘 반각의 cos (-1 = 전 방향)
+        int32_t right;
+        int32_t parent;         // 루트는 -1
+        int32_t padding[2];
+    };
+
+    struct PointLightDesc {
+        Float3 position;
+        Float3 color{ 1.0f, 1.0f, 1.0f };
+        float intensity = 1.0f;
+    };
+
+    struct LightSet {
+        std::vector<GpuLightEntry> lights;
+        std::vector<GpuLightNode> nodes;
+        // SceneObject 별 첫 삼각형 광원 인덱스 (emissive 가 아니면 -1)
+        // 셰이더에서 광원 인덱스 = offset + gl_PrimitiveID → InstanceMaterial.pbrParams2.w 로 전달
+        std::vector<int32_t> objectLightOffsets;
+        float totalPower = 0.0f;
+
+        uint32_t lightCount() const { return static_cast<uint32_t>(lights.size()); }
+        uint32_t nodeCount() const { return static_cast<uint32_t>(nodes.size()); }
+    };
+
+    // emissive 오브젝트의 OBJ 를 읽어 (같은 경로는 한 번) 삼각형 광원으로 펼치고 점광원을 더한 뒤 BVH 를 만듦
+    // 삼각형 순서는 OBJ 인덱스 순서 그대로 (= BLAS 의 gl_PrimitiveID)
+    LightSet buildLightSet(const std::vector<SceneObject>& objects, const std::vector<PointLightDesc>& pointLights);
+
+    // objectLightOffsets 를 재질의 pbrParams2.w 에 기록 (materials 는 SceneObject 순서)
+    void applyLightOffsets(const LightSet& lightSet, std::vector<InstanceMaterial>& materials);
+
+    // ── raygenbsdf.rgen 의 light BVH 함수와 같은 식 (셰이더를 고치면 같이 고칠 것) ─────────────
+
+    // 점 P (법선 N) 에서 본 노드의 중요도: power / 거리² 에 법선 콘 / 수신 면 방향 항을 곱함
+    float lightNodeImportance(const GpuLightNode& node, const Float3& P, const Float3& N);
+
+    // 루트부터 중요도 비율로 내려가 광원 하나를 고름. u 는 [0,1) 난수 (내려가면서 다시 씀)
+    // 고를 수 없으면 (모든 광원의 중요도 0) -1
+    int32_t sampleLightBvh(const LightSet& lightSet, const Float3& P, const Float3& N, float u, float& pmf);
+
+    // sampleLightBvh 가 P 에서 light 를 고를 확률 (잎에서 부모를 따라 올라가며 곱함)
+    float lightBvhPmf(const LightSet& lightSet, int32_t light, const Float3& P, const Float3& N);
+
+}
@@ -0,0 +1,152 @@
+#include "PrismMemoryPool.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace Prism {
+
+    uint32_t findMemoryType(VkPhysicalDevice physicalDevice, uint32_t typeFilter, VkMemoryPropertyFlags properties) {
+        VkPhysicalDeviceMemoryProperties memProperties;
+        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
+        for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+            if ((typeFilter & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties) return i;
+        }
+        return 0;
+    }
+
+    void GpuMemoryPool::initialize(VkDevice device, VkPhysicalDevice physicalDevice, VkDeviceSize blockSize) {
+        mDevice = device;
+        mPhysicalDevice = physicalDevice;
+        mBlockSize = blockSize;
+    }
+
+    void GpuMemoryPool::cleanup() {
+        for (auto& b : mBlocks) {
+            if (b.memory == VK_NULL_HANDLE) continue;
+            if (b.mapped) vkUnmapMemory(mDevice, b.memory);
+            vkFreeMemory(mDevice, b.memory, nullptr);
+        }
+        mBlocks.clear();
+    }
+
+    bool GpuMemoryPool::allocateBlock(uint32_t memoryType, VkMemoryPropertyFlags properties, VkDeviceSize size, bool dedicated, uint32_t& outIndex) {
+        VkMemoryAllocateFlagsInfo flagsInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO };
+        flagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+        VkMemoryAllocateInfo allocInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, &flagsInfo };
+        allocInfo.allocationSize = size;
+        allocInfo.memoryTypeIndex = memoryType;
+
+        Block block;
+        if (vkAllocateMemory(mDevice, &allocInfo, nullptr, &block.memory) != VK_SUCCESS) return false;
+        block.size = size;
+        block.memoryType = memoryType;
+        block.dedicated = dedicated;
+        block.freeRanges.push_back({ 0, size });
+        if (properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+            vkMapMemory(mDevice, block.memory, 0, VK_WHOLE_SIZE, 0, &block.mapped);
+
+        // 비어 있는 자리(해제된 전용 블록) 재사용
+        for (uint32_t i = 0; i < (uint32_t)mBlocks.size(); i++) {
+            if (mBlocks[i].memory == VK_NULL_HANDLE) { mBlocks[i] = std::move(block); outIndex = i; return true; }
+        }
+        outIndex = (uint32_t)mBlocks.size();
+        mBlocks.push_back(std::move(block));
+        return true;
+    }
+
+    bool GpuMemoryPool::carve(Block& block, VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& outOffset) {
+        for (size_t r = 0; r < block.freeRanges.size(); r++) {
+            auto [start, length] = block.freeRanges[r];
+            VkDeviceSize aligned = (start + alignment - 1) / alignment * alignment;
+            if (aligned + size > start + length) continue;
+
+            // 앞쪽 정렬 여백과 뒤쪽 남는 부분을 free 목록에 남김
+            VkDeviceSize tailStart = aligned + size, tailSize = start + length - tailStart;
+            block.freeRanges.erase(block.freeRanges.begin() + r);
+            if (tailSize > 0) block.freeRanges.insert(block.freeRanges.begin() + r, { tailStart, tailSize });
+            if (aligned > start) block.freeRanges.insert(block.freeRanges.begin() + r, { start, aligned - start });
+
+            block.used += size;
+            outOffset = aligned;
+            return true;
+        }
+        return false;
+    }
+
+    GpuAllocation GpuMemoryPool::allocate(const VkMemoryRequirements& reqs, VkMemoryPropertyFlags properties) {
+        uint32_t memoryType = findMemoryType(mPhysicalDevice, reqs.memoryTypeBits, properties);
+        VkDeviceSize alignment = std::max<VkDeviceSize>(reqs.alignment, 1);
+
+        GpuAllocation alloc;
+        auto fill = [&](uint32_t blockIdx, VkDeviceSize offset) {
+            Block& b = mBlocks[blockIdx];
+            alloc.memory = b.memory;
+            alloc.offset = offset;
+            alloc.size   = reqs.size;
+            alloc.block  = blockIdx;
+            alloc.mapped = b.mapped ? static_cast<char*>(b.mapped) + offset : nullptr;
+        };
+
+        VkDeviceSize offset = 0;
+        if (reqs.size <= mBlockSize) {
+            for (uint32_t i = 0; i < (uint32_t)mBlocks.size(); i++) {
+                Block& b = mBlocks[i];
+                if (b.memory == VK_NULL_HANDLE || b.dedicated || b.memoryType != memoryType) continue;
+                if (carve(b, reqs.size, alignment, offset)) { fill(i, offset); return alloc; }
+            }
+        }
+
+        bool dedicated = reqs.size > mBlockSize;
+        uint32_t blockIdx = 0;
+        if (!allocateBlock(memoryType, properties, dedicated ? reqs.size : mBlockSize, dedicated, blockIdx)) {
+            throw std::runtime_error("PRISM: Memory allocation failed!");
+        }
+        carve(mBlocks[blockIdx], reqs.size, alignment, offset);
+        fill(blockIdx, offset);
+        return alloc;
+    }
+
+    void GpuMemoryPool::free(GpuAllocation& alloc) {
+        if (!alloc.valid() || alloc.block >= mBlocks.size()) return;
+        Block& b = mBlocks[alloc.block];
+
+        auto it = std::lower_bound(b.freeRanges.begin(), b.freeRanges.end(), std::make_pair(alloc.offset, VkDeviceSize(0)));
+        it = b.freeRanges.insert(it, { alloc.offset, alloc.size });
+        // 뒤, 앞 이웃과 병합
+        if (it + 1 != b.freeRanges.end() && it->first + it->second == (it + 1)->first) {
+            it->second += (it + 1)->second;
+            b.freeRanges.erase(it + 1);
+        }
+        if (it != b.freeRanges.begin() && (it - 1)->first + (it - 1)->second == it->first) {
+            (it - 1)->second += it->second;
+            b.freeRanges.erase(it);
+        }
+        b.used -= alloc.size;
+
+        // 전용 블록은 비면 바로 반납 (공용 블록은 다음 할당을 위해 유지)
+        if (b.dedicated && b.used == 0) {
+            if (b.mapped) vkUnmapMemory(mDevice, b.memory);
+            vkFreeMemory(mDevice, b.memory, nullptr);
+            b = Block{};
+        }
+        alloc = GpuAllocation{};
+    }
+
+    VkDeviceSize GpuMemoryPool::getUsedBytes() const {
+        VkDeviceSize sum = 0;
+        for (const auto& b : mBlocks) sum += b.used;
+        return sum;
+    }
+
+    VkDeviceSize GpuMemoryPool::getReservedBytes() const {
+        VkDeviceSize sum = 0;
+        for (const auto& b : mBlocks) if (b.memory != VK_NULL_HANDLE) sum += b.size;
+        return sum;
+    }
+
+    uint32_t GpuMemoryPool::getBlockCount() const {
+        uint32_t n = 0;
+        for (const auto& b : mBlocks) if (b.memory != VK_NULL_HANDLE) n++;
+        return n;
+    }
+
+}
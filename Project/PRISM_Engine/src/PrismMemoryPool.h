@@ -0,0 +1,59 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Prism {
+
+    uint32_t findMemoryType(VkPhysicalDevice physicalDevice, uint32_t typeFilter, VkMemoryPropertyFlags properties);
+
+    // 풀에서 잘라 준 메모리 조각. 버퍼는 (memory, offset) 에 바인딩
+    struct GpuAllocation {
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkDeviceSize   offset = 0;
+        VkDeviceSize   size   = 0;
+        void*          mapped = nullptr;        // HOST_VISIBLE 블록이면 offset 이 반영된 포인터 (블록 전체가 영구 매핑)
+        uint32_t       block  = UINT32_MAX;
+
+        bool valid() const { return memory != VK_NULL_HANDLE; }
+    };
+
+    // 메모리 타입별 큰 블록(기본 64MB)을 잡아 두고 버퍼 단위로 잘라 쓰는 풀
+    // 메시 수백 개 = vkAllocateMemory 수백 번 (maxMemoryAllocationCount 제한, 드라이버 비용) 을 블록 몇 개로 줄임
+    // 버퍼 전용 (이미지는 bufferImageGranularity 를 따지지 않으므로 넣지 않음). 모든 블록은 DEVICE_ADDRESS 로 할당
+    // 블록 안은 offset 순 free 목록 first-fit, 해제 시 이웃과 병합. 블록보다 큰 요청은 그 크기의 전용 블록
+    class GpuMemoryPool {
+    public:
+        void initialize(VkDevice device, VkPhysicalDevice physicalDevice, VkDeviceSize blockSize = 64ull << 20);
+        void cleanup();
+
+        GpuAllocation allocate(const VkMemoryRequirements& reqs, VkMemoryPropertyFlags properties);
+        void free(GpuAllocation& alloc);
+
+        VkDeviceSize getUsedBytes() const;
+        VkDeviceSize getReservedBytes() const;
+        uint32_t getBlockCount() const;
+
+    private:
+        struct Block {
+            VkDeviceMemory memory     = VK_NULL_HANDLE;
+            VkDeviceSize   size       = 0;
+            VkDeviceSize   used       = 0;
+            uint32_t       memoryType = 0;
+            void*          mapped     = nullptr;
+            bool           dedicated  = false;
+            std::vector<std::pair<VkDeviceSize, VkDeviceSize>> freeRanges;   // (offset, size), offset 오름차순
+        };
+
+        bool allocateBlock(uint32_t memoryType, VkMemoryPropertyFlags properties, VkDeviceSize size, bool dedicated, uint32_t& outIndex);
+        bool carve(Block& block, VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& outOffset);
+
+        VkDevice         mDevice         = VK_NULL_HANDLE;
+        VkPhysicalDevice mPhysicalDevice = VK_NULL_HANDLE;
+        VkDeviceSize     mBlockSize      = 0;
+        std::vector<Block> mBlocks;          // 해제된 전용 블록 자리는 memory = VK_NULL_HANDLE 로 남김 (인덱스 유지)
+    };
+
+}
@@ -0,0 +1,576 @@
+#include "PrismObjLoader.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Prism {
+
+    namespace {
+
+        // 스레드 하나가 맡을 최소 바이트 (작은 OBJ 는 스레드 생성 비용이 더 큼)
+        const size_t kMinChunkBytes = 1 << 20;
+        // 캐시 키용 해시는 원본 앞뒤 이만큼만 읽음
+        const size_t kHashWindow = 64 * 1024;
+
+        // fn(t) 를 t = 0 .. count-1 로 병렬 실행 (t = 0 은 호출 스레드)
+        template <typename Fn>
+        void parallelFor(unsigned count, Fn&& fn) {
+            std::vector<std::thread> workers;
+            workers.reserve(count > 0 ? count - 1 : 0);
+            for (unsigned t = 1; t < count; t++) workers.emplace_back([&fn, t]() { fn(t); });
+            if (count > 0) fn(0);
+            for (std::thread& w : workers) w.join();
+        }
+
+        unsigned resolveThreads(unsigned requested, size_t work, size_t minWorkPerThread) {
+            unsigned threads = requested ? requested : std::max(std::thread::hardware_concurrency(), 1u);
+            size_t   limit   = std::max<size_t>(work / std::max<size_t>(minWorkPerThread, 1), 1);
+            return (unsigned)std::min<size_t>(threads, limit);
+        }
+
+        // ── 숫자 파싱 (std::stof / istringstream 대신. 로케일 무시, 예외 없음) ──────────
+        inline bool isBlank(char c) { return c == ' ' || c == '\t'; }
+        inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+        const char* skipBlank(const char* p, const char* end) {
+            while (p < end && isBlank(*p)) p++;
+            return p;
+        }
+
+        double pow10(int e) {
+            static const double kTable[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                             1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+            if (e >= 0 && e <= 22) return kTable[e];
+            if (e < 0 && e >= -22) return 1.0 / kTable[-e];
+            return std::pow(10.0, e);
+        }
+
+        // [+-]digits[.digits][(e|E)[+-]digits]. 숫자가 없으면 p 그대로 반환 (out = 0)
+        const char* parseFloat(const char* p, const char* end, float& out) {
+            const char* start = p;
+            bool negative = false;
+            if (p < end && (*p == '-' || *p == '+')) negative = (*p++ == '-');
+
+            uint64_t mantissa = 0;
+            int exponent = 0, digits = 0;
+            for (; p < end && isDigit(*p); p++, digits++) {
+                if (mantissa < 100000000000000000ull) mantissa = mantissa * 10 + uint64_t(*p - '0');
+                else exponent++;
+            }
+            if (p < end && *p == '.') {
+                for (p++; p < end && isDigit(*p); p++, digits++) {
+                    if (mantissa < 100000000000000000ull) { mantissa = mantissa * 10 + uint64_t(*p - '0'); exponent--; }
+                }
+            }
+            if (digits == 0) { out = 0.0f; return start; }
+
+            if (p < end && (*p == 'e' || *p == 'E')) {
+                const char* q = p + 1;
+                bool expNegative = false;
+                if (q < end && (*q == '-' || *q == '+')) expNegative = (*q++ == '-');
+                if (q < end && isDigit(*q)) {
+                    int e = 0;
+                    for (; q < end && isDigit(*q); q++) e = std::min(e * 10 + (*q - '0'), 9999);
+                    exponent += expNegative ? -e : e;
+                    p = q;
+                }
+            }
+            double value = double(mantissa) * pow10(exponent);
+            out = float(negative ? -value : value);
+            return p;
+        }
+
+        const char* parseInt(const char* p, const char* end, int64_t& out) {
+            const char* start = p;
+            bool negative = false;
+            if (p < end && (*p == '-' || *p == '+')) negative = (*p++ == '-');
+            int64_t value = 0;
+            const char* digitsStart = p;
+            for (; p < end && isDigit(*p); p++) value = std::min<int64_t>(value * 10 + (*p - '0'), INT32_MAX);
+            if (p == digitsStart) { out = 0; return start; }
+            out = negative ? -value : value;
+            return p;
+        }
+
+        // ── 청크 파싱 ────────────────────────────────────────────────────
+        // 면 인덱스: 양수는 파일 전체 기준이라 바로 0 기반 절대 인덱스로, 음수 (상대) 는 청크 안에서 본 v / vn 수 기준으로 적고
+        // rel* 목록에 남겨 병합할 때 앞 청크들의 개수를 더함
+        struct ObjChunk {
+            std::vector<Float3>   pos;
+            std::vector<Float3>   normals;
+            std::vector<int32_t>  triV;     // 삼각형당 3
+            std::vector<int32_t>  triN;     // 삼각형당 3 (-1 = 법선 없음)
+            std::vector<uint32_t> relV;     // triV 중 청크 상대 인덱스 위치
+            std::vector<uint32_t> relN;
+        };
+
+        // OBJ 인덱스 (1 기반, 음수 = 뒤에서부터) → 0 기반. relative 면 청크 로컬 기준
+        int32_t resolveIndex(int64_t idx, size_t localCount, bool& relative) {
+            relative = idx < 0;
+            if (idx > 0) return int32_t(idx - 1);
+            if (idx < 0) return int32_t(int64_t(localCount) + idx);
+            return INT32_MIN;   // 0 은 잘못된 인덱스 (범위 검사에서 버림)
+        }
+
+        void parseChunk(const char* p, const char* end, ObjChunk& chunk) {
+            std::vector<int32_t> faceV, faceN;
+            std::vector<uint8_t> faceRelV, faceRelN;
+
+            while (p < end) {
+                const char* lineEnd = static_cast<const char*>(memchr(p, '\n', size_t(end - p)));
+                if (!lineEnd) lineEnd = end;
+                const char* q = skipBlank(p, lineEnd);
+
+                if (q + 1 < lineEnd && q[0] == 'v' && isBlank(q[1])) {
+                    Float3 v;
+                    q = parseFloat(skipBlank(q + 2, lineEnd), lineEnd, v.x);
+                    q = parseFloat(skipBlank(q, lineEnd), lineEnd, v.y);
+                    parseFloat(skipBlank(q, lineEnd), lineEnd, v.z);
+                    chunk.pos.push_back(v);
+                }
+                else if (q + 2 < lineEnd && q[0] == 'v' && q[1] == 'n' && isBlank(q[2])) {
+                    Float3 n;
+                    q = parseFloat(skipBlank(q + 3, lineEnd), lineEnd, n.x);
+                    q = parseFloat(skipBlank(q, lineEnd), lineEnd, n.y);
+                    parseFloat(skipBlank(q, lineEnd), lineEnd, n.z);
+                    chunk.normals.push_back(n);
+                }
+                else if (q + 1 < lineEnd && q[0] == 'f' && isBlank(q[1])) {
+                    // "v", "v/vt", "v//vn", "v/vt/vn" 토큰
+                    faceV.clear(); faceN.clear(); faceRelV.clear(); faceRelN.clear();
+                    q = skipBlank(q + 2, lineEnd);
+                    while (q < lineEnd && *q != '\r') {
+                        int64_t vi = 0, ti = 0, ni = 0;
+                        const char* next = parseInt(q, lineEnd, vi);
+                        if (next == q) break;
+                        q = next;
+                        if (q < lineEnd && *q == '/') {
+                            q = parseInt(q + 1, lineEnd, ti);
+                            if (q < lineEnd && *q == '/') q = parseInt(q + 1, lineEnd, ni);
+                        }
+                        bool relV = false, relN = false;
+                        faceV.push_back(resolveIndex(vi, chunk.pos.size(), relV));
+                        faceN.push_back(ni != 0 ? resolveIndex(ni, chunk.normals.size(), relN) : -1);
+                        faceRelV.push_back(relV);
+                        faceRelN.push_back(relN);
+                        q = skipBlank(q, lineEnd);
+                    }
+                    // Fan triangulation
+                    for (size_t i = 1; i + 1 < faceV.size(); i++) {
+                        const size_t corners[3] = { 0, i, i + 1 };
+                        for (size_t c : corners) {
+                            if (faceRelV[c]) chunk.relV.push_back((uint32_t)chunk.triV.size());
+                            if (faceRelN[c]) chunk.relN.push_back((uint32_t)chunk.triN.size());
+                            chunk.triV.push_back(faceV[c]);
+                            chunk.triN.push_back(faceN[c]);
+                        }
+                    }
+                }
+                p = lineEnd + 1;
+            }
+        }
+
+        // ── (v, vn) 중복 제거용 open addressing 해시 ─────────────────────────────
+        class CornerTable {
+        public:
+            explicit CornerTable(size_t expected) { rehash(std::max<size_t>(expected * 2, 64)); }
+
+            // 없으면 nextId 로 넣고 true
+            bool insert(uint64_t key, uint32_t nextId, uint32_t& outId) {
+                if ((mCount + 1) * 2 > mKeys.size()) rehash(mKeys.size() * 2);
+                size_t mask = mKeys.size() - 1;
+                for (size_t i = hash(key) & mask;; i = (i + 1) & mask) {
+                    if (mKeys[i] == kEmpty) {
+                        mKeys[i] = key; mValues[i] = nextId; mCount++;
+                        outId = nextId;
+                        return true;
+                    }
+                    if (mKeys[i] == key) { outId = mValues[i]; return false; }
+                }
+            }
+
+        private:
+            static constexpr uint64_t kEmpty = ~0ull;
+
+            static size_t hash(uint64_t key) {
+                key ^= key >> 33; key *= 0xff51afd7ed558ccdull;
+                key ^= key >> 33; key *= 0xc4ceb9fe1a85ec53ull;
+                return size_t(key ^ (key >> 33));
+            }
+
+            void rehash(size_t minSize) {
+                size_t size = 64;
+                while (size < minSize) size <<= 1;
+                std::vector<uint64_t> keys(size, kEmpty);
+                std::vector<uint32_t> values(size);
+                for (size_t i = 0; i < mKeys.size(); i++) {
+                    if (mKeys[i] == kEmpty) continue;
+                    size_t j = hash(mKeys[i]) & (size - 1);
+                    while (keys[j] != kEmpty) j = (j + 1) & (size - 1);
+                    keys[j] = mKeys[i]; values[j] = mValues[i];
+                }
+                mKeys.swap(keys);
+                mValues.swap(values);
+            }
+
+            std::vector<uint64_t> mKeys;
+            std::vector<uint32_t> mValues;
+            size_t mCount = 0;
+        };
+
+        uint64_t fnv1a(const uint8_t* data, size_t size, uint64_t h = 14695981039346656037ull) {
+            for (size_t i = 0; i < size; i++) { h ^= data[i]; h *= 1099511628211ull; }
+            return h;
+        }
+
+        // 원본 파일 식별: 크기 / 수정 시각 / 앞뒤 kHashWindow 해시
+        bool sourceKey(const std::string& path, const MappedFile& source, uint64_t& size, int64_t& time, uint64_t& hash) {
+            std::error_code ec;
+            auto writeTime = std::filesystem::last_write_time(path, ec);
+            if (ec) return false;
+            size = source.size();
+            time = int64_t(writeTime.time_since_epoch().count());
+            size_t head = std::min(size_t(size), kHashWindow);
+            hash = fnv1a(source.data(), head);
+            if (size > head) {
+                size_t tail = std::min(size_t(size) - head, kHashWindow);
+                hash = fnv1a(source.data() + size - tail, tail, hash);
+            }
+            return true;
+        }
+
+    }
+
+    // ── MappedFile ───────────────────────────────────────────────────────
+
+    bool MappedFile::open(const std::string& path) {
+        close();
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) { CloseHandle(file); return false; }
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) { CloseHandle(file); return false; }
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view) { CloseHandle(mapping); CloseHandle(file); return false; }
+        mFile    = file;
+        mMapping = mapping;
+        mData    = static_cast<const uint8_t*>(view);
+        mSize    = size_t(size.QuadPart);
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) { ::close(fd); return false; }
+        void* view = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);    // 매핑은 fd 를 닫아도 유지됨
+        if (view == MAP_FAILED) return false;
+        madvise(view, size_t(st.st_size), MADV_SEQUENTIAL);
+        mData = static_cast<const uint8_t*>(view);
+        mSize = size_t(st.st_size);
+#endif
+        return true;
+    }
+
+    void MappedFile::close() {
+#ifdef _WIN32
+        if (mData)    UnmapViewOfFile(mData);
+        if (mMapping) CloseHandle(mMapping);
+        if (mFile)    CloseHandle(mFile);
+        mFile = mMapping = nullptr;
+#else
+        if (mData) munmap(const_cast<uint8_t*>(mData), mSize);
+#endif
+        mData = nullptr;
+        mSize = 0;
+    }
+
+    // ── parseObj ─────────────────────────────────────────────────────────
+
+    RawObj parseObj(const std::string& path, unsigned threads) {
+        MappedFile file;
+        if (!file.open(path)) {
+            std::cerr << "[PRISM] OBJ not found: " << path << std::endl;
+            return {};
+        }
+        const char* text = reinterpret_cast<const char*>(file.data());
+        const size_t size = file.size();
+
+        // 1) 줄 경계로 나눠 청크별 파싱
+        unsigned chunkCount = resolveThreads(threads, size, kMinChunkBytes);
+        std::vector<size_t> bounds(chunkCount + 1, size);
+        bounds[0] = 0;
+        for (unsigned c = 1; c < chunkCount; c++) {
+            size_t at = std::max(size * c / chunkCount, bounds[c - 1]);
+            const void* nl = at < size ? memchr(text + at, '\n', size - at) : nullptr;
+            bounds[c] = nl ? size_t(static_cast<const char*>(nl) - text) + 1 : size;
+        }
+        std::vector<ObjChunk> chunks(chunkCount);
+        parallelFor(chunkCount, [&](unsigned c) {
+            parseChunk(text + bounds[c], text + bounds[c + 1], chunks[c]);
+        });
+
+        // 2) 병합: 청크별 v / vn / 삼각형 오프셋 → 상대 인덱스 보정
+        std::vector<size_t> posBase(chunkCount + 1, 0), normBase(chunkCount + 1, 0), cornerBase(chunkCount + 1, 0);
+        for (unsigned c = 0; c < chunkCount; c++) {
+            posBase[c + 1]    = posBase[c]    + chunks[c].pos.size();
+            normBase[c + 1]   = normBase[c]   + chunks[c].normals.size();
+            cornerBase[c + 1] = cornerBase[c] + chunks[c].triV.size();
+        }
+        std::vector<Float3>  rawPos(posBase[chunkCount]), rawNorm(normBase[chunkCount]);
+        std::vector<int32_t> triV(cornerBase[chunkCount]), triN(cornerBase[chunkCount]);
+        parallelFor(chunkCount, [&](unsigned c) {
+            ObjChunk& chunk = chunks[c];
+            for (uint32_t at : chunk.relV) chunk.triV[at] += int32_t(posBase[c]);
+            for (uint32_t at : chunk.relN) chunk.triN[at] += int32_t(normBase[c]);
+            std::copy(chunk.pos.begin(),     chunk.pos.end(),     rawPos.begin()  + posBase[c]);
+            std::copy(chunk.normals.begin(), chunk.normals.end(), rawNorm.begin() + normBase[c]);
+            std::copy(chunk.triV.begin(),    chunk.triV.end(),    triV.begin()    + cornerBase[c]);
+            std::copy(chunk.triN.begin(),    chunk.triN.end(),    triN.begin()    + cornerBase[c]);
+            chunk = ObjChunk();
+        });
+        chunks.clear();
+        file.close();
+
+        // 범위 밖 정점 인덱스를 가진 삼각형은 버림
+        const bool   hasNormals = !rawNorm.empty();
+        const size_t triCount   = triV.size() / 3;
+        std::vector<uint8_t> valid(triCount);
+        for (size_t t = 0; t < triCount; t++) {
+            bool ok = true;
+            for (int j = 0; j < 3; j++) ok = ok && triV[t * 3 + j] >= 0 && size_t(triV[t * 3 + j]) < rawPos.size();
+            valid[t] = ok;
+        }
+
+        RawObj result;
+        unsigned workers = resolveThreads(threads, triCount, 1 << 16);
+
+        if (hasNormals) {
+            // 3) (v, vn) 쌍 중복 제거. 스레드마다 v 범위 하나를 맡아 그 범위의 코너만 해시에 넣음
+            //    (출력 순서: 범위 순 → 범위 안에서는 처음 나온 순. 같은 스레드 수면 항상 같은 결과)
+            std::vector<uint32_t> cornerIds(triV.size());
+            std::vector<std::vector<uint64_t>> uniqueKeys(workers);
+            parallelFor(workers, [&](unsigned w) {
+                const int32_t vBegin = int32_t(rawPos.size() * w / workers);
+                const int32_t vEnd   = int32_t(rawPos.size() * (w + 1) / workers);
+                CornerTable table(size_t(vEnd - vBegin));
+                std::vector<uint64_t>& keys = uniqueKeys[w];
+                for (size_t c = 0; c < triV.size(); c++) {
+                    int32_t v = triV[c];
+                    if (v < vBegin || v >= vEnd || !valid[c / 3]) continue;
+                    int32_t n = (triN[c] >= 0 && size_t(triN[c]) < rawNorm.size()) ? triN[c] : -1;
+                    uint64_t key = (uint64_t(uint32_t(v)) << 32) | uint32_t(n);
+                    uint32_t id;
+                    if (table.insert(key, (uint32_t)keys.size(), id)) keys.push_back(key);
+                    cornerIds[c] = id;
+                }
+            });
+            std::vector<uint32_t> idBase(workers + 1, 0);
+            for (unsigned w = 0; w < workers; w++) idBase[w + 1] = idBase[w] + (uint32_t)uniqueKeys[w].size();
+
+            result.pos.resize(idBase[workers]);
+            result.normals.resize(idBase[workers]);
+            parallelFor(workers, [&](unsigned w) {
+                const int32_t vBegin = int32_t(rawPos.size() * w / workers);
+                const int32_t vEnd   = int32_t(rawPos.size() * (w + 1) / workers);
+                for (size_t k = 0; k < uniqueKeys[w].size(); k++) {
+                    uint64_t key = uniqueKeys[w][k];
+                    int32_t  n   = int32_t(uint32_t(key));
+                    result.pos[idBase[w] + k]     = rawPos[size_t(key >> 32)];
+                    result.normals[idBase[w] + k] = n >= 0 ? rawNorm[size_t(n)] : Float3{ 0, 1, 0 };
+                }
+                for (size_t c = 0; c < triV.size(); c++) {
+                    if (triV[c] >= vBegin && triV[c] < vEnd && valid[c / 3]) cornerIds[c] += idBase[w];
+                }
+            });
+
+            result.indices.reserve(triV.size());
+            for (size_t t = 0; t < triCount; t++) {
+                if (!valid[t]) continue;
+                result.indices.insert(result.indices.end(), cornerIds.begin() + t * 3, cornerIds.begin() + t * 3 + 3);
+            }
+        }
+        else {
+            // 법선 없음 → 각 삼각형마다 face normal 계산 (flat shading)
+            std::vector<size_t> outBase(workers + 1, 0);
+            for (unsigned w = 0; w < workers; w++) {
+                size_t count = 0;
+                for (size_t t = triCount * w / workers; t < triCount * (w + 1) / workers; t++) count += valid[t];
+                outBase[w + 1] = outBase[w] + count * 3;
+            }
+            result.pos.resize(outBase[workers]);
+            result.normals.resize(outBase[workers]);
+            result.indices.resize(outBase[workers]);
+            parallelFor(workers, [&](unsigned w) {
+                size_t out = outBase[w];
+                for (size_t t = triCount * w / workers; t < triCount * (w + 1) / workers; t++) {
+                    if (!valid[t]) continue;
+                    Float3 a = rawPos[triV[t * 3 + 0]];
+                    Float3 b = rawPos[triV[t * 3 + 1]];
+                    Float3 c = rawPos[triV[t * 3 + 2]];
+                    Float3 e1{ b.x - a.x, b.y - a.y, b.z - a.z };
+                    Float3 e2{ c.x - a.x, c.y - a.y, c.z - a.z };
+                    Float3 faceNorm{ e1.y * e2.z - e1.z * e2.y, e1.z * e2.x - e1.x * e2.z, e1.x * e2.y - e1.y * e2.x };
+                    float len = std::sqrt(faceNorm.x * faceNorm.x + faceNorm.y * faceNorm.y + faceNorm.z * faceNorm.z);
+                    if (len > 1e-8f) faceNorm = { faceNorm.x / len, faceNorm.y / len, faceNorm.z / len };
+                    else faceNorm = { 0, 1, 0 };
+                    for (int j = 0; j < 3; j++, out++) {
+                        result.indices[out] = (uint32_t)out;
+                        result.pos[out]     = rawPos[triV[t * 3 + j]];
+                        result.normals[out] = faceNorm;
+                    }
+                }
+            });
+        }
+
+        // 4) 중심 정규화 (바운딩박스 center를 원점으로) + 정규화 뒤 AABB
+        if (!result.pos.empty()) {
+            unsigned boxWorkers = resolveThreads(threads, result.pos.size(), 1 << 18);
+            std::vector<Float3> mins(boxWorkers, { FLT_MAX, FLT_MAX, FLT_MAX }), maxs(boxWorkers, { -FLT_MAX, -FLT_MAX, -FLT_MAX });
+            parallelFor(boxWorkers, [&](unsigned w) {
+                Float3& lo = mins[w];
+                Float3& hi = maxs[w];
+                for (size_t i = result.pos.size() * w / boxWorkers; i < result.pos.size() * (w + 1) / boxWorkers; i++) {
+                    const Float3& p = result.pos[i];
+                    lo = { std::min(lo.x, p.x), std::min(lo.y, p.y), std::min(lo.z, p.z) };
+                    hi = { std::max(hi.x, p.x), std::max(hi.y, p.y), std::max(hi.z, p.z) };
+                }
+            });
+            Float3 minV = mins[0], maxV = maxs[0];
+            for (unsigned w = 1; w < boxWorkers; w++) {
+                minV = { std::min(minV.x, mins[w].x), std::min(minV.y, mins[w].y), std::min(minV.z, mins[w].z) };
+                maxV = { std::max(maxV.x, maxs[w].x), std::max(maxV.y, maxs[w].y), std::max(maxV.z, maxs[w].z) };
+            }
+            Float3 center{ (minV.x + maxV.x) * 0.5f, (minV.y + maxV.y) * 0.5f, (minV.z + maxV.z) * 0.5f };
+            parallelFor(boxWorkers, [&](unsigned w) {
+                for (size_t i = result.pos.size() * w / boxWorkers; i < result.pos.size() * (w + 1) / boxWorkers; i++) {
+                    Float3& p = result.pos[i];
+                    p.x -= center.x; p.y -= center.y; p.z -= center.z;
+                }
+            });
+            result.boundsMin = { minV.x - center.x, minV.y - center.y, minV.z - center.z };
+            result.boundsMax = { maxV.x - center.x, maxV.y - center.y, maxV.z - center.z };
+        }
+
+        return result;
+    }
+
+    // ── ObjMesh (바이너리 캐시) ─────────────────────────────────────────────
+
+    std::string meshCachePath(const std::string& objPath) {
+        return objPath + ".prismmesh";
+    }
+
+    bool ObjMesh::load(const std::string& objPath, bool writeCache) {
+        mCache.close();
+        mVertexStorage.clear();
+        mIndexStorage.clear();
+        mVertices    = nullptr;
+        mIndices     = nullptr;
+        mVertexCount = mIndexCount = 0;
+        mFromCache   = false;
+
+        uint64_t srcSize = 0, srcHash = 0;
+        int64_t  srcTime = 0;
+        bool     haveKey = false;
+        {
+            MappedFile source;
+            if (!source.open(objPath)) {
+                std::cerr << "[PRISM] OBJ not found: " << objPath << std::endl;
+                return false;
+            }
+            haveKey = sourceKey(objPath, source, srcSize, srcTime, srcHash);
+        }
+
+        // 캐시가 원본과 맞으면 매핑한 채로 그대로 씀
+        const std::string cachePath = meshCachePath(objPath);
+        if (haveKey && mCache.open(cachePath) && mCache.size() >= sizeof(MeshCacheHeader)) {
+            MeshCacheHeader h;
+            memcpy(&h, mCache.data(), sizeof(h));
+            size_t expected = sizeof(MeshCacheHeader) + size_t(h.vertexCount) * kMeshVertexFloats * sizeof(float)
+                            + size_t(h.indexCount) * sizeof(uint32_t);
+            if (h.magic == kMeshCacheMagic && h.version == kMeshCacheVersion && h.sourceSize == srcSize &&
+                h.sourceTime == srcTime && h.sourceHash == srcHash && mCache.size() == expected && h.vertexCount > 0) {
+                mVertices    = reinterpret_cast<const float*>(mCache.data() + sizeof(MeshCacheHeader));
+                mIndices     = reinterpret_cast<const uint32_t*>(mVertices + size_t(h.vertexCount) * kMeshVertexFloats);
+                mVertexCount = h.vertexCount;
+                mIndexCount  = h.indexCount;
+                mBoundsMin   = { h.boundsMin[0], h.boundsMin[1], h.boundsMin[2] };
+                mBoundsMax   = { h.boundsMax[0], h.boundsMax[1], h.boundsMax[2] };
+                mFromCache   = true;
+                return true;
+            }
+        }
+        mCache.close();
+
+        RawObj raw = parseObj(objPath);
+        if (raw.pos.empty()) return false;
+
+        mVertexStorage.resize(raw.pos.size() * kMeshVertexFloats);
+        for (size_t i = 0; i < raw.pos.size(); ++i) {
+            float* v = &mVertexStorage[i * kMeshVertexFloats];
+            v[0] = raw.pos[i].x;     v[1] = raw.pos[i].y;     v[2] = raw.pos[i].z;
+            v[3] = raw.normals[i].x; v[4] = raw.normals[i].y; v[5] = raw.normals[i].z;
+        }
+        mIndexStorage.swap(raw.indices);
+        mVertices    = mVertexStorage.data();
+        mIndices     = mIndexStorage.data();
+        mVertexCount = (uint32_t)raw.pos.size();
+        mIndexCount  = (uint32_t)mIndexStorage.size();
+        mBoundsMin   = raw.boundsMin;
+        mBoundsMax   = raw.boundsMax;
+
+        if (writeCache && haveKey) {
+            // 임시 파일에 쓴 뒤 교체 (쓰다 끊겨도 반쪽 캐시가 남지 않음). 실패해도 (읽기 전용 폴더 등) 로드는 성공
+            MeshCacheHeader h{};
+            h.magic       = kMeshCacheMagic;
+            h.version     = kMeshCacheVersion;
+            h.sourceSize  = srcSize;
+            h.sourceTime  = srcTime;
+            h.sourceHash  = srcHash;
+            h.vertexCount = mVertexCount;
+            h.indexCount  = mIndexCount;
+            memcpy(h.boundsMin, &mBoundsMin, sizeof(h.boundsMin));
+            memcpy(h.boundsMax, &mBoundsMax, sizeof(h.boundsMax));
+
+            const std::string tmpPath = cachePath + ".tmp";
+            std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+            out.write(reinterpret_cast<const char*>(mVertices), std::streamsize(size_t(mVertexCount) * kMeshVertexFloats * sizeof(float)));
+            out.write(reinterpret_cast<const char*>(mIndices),  std::streamsize(size_t(mIndexCount) * sizeof(uint32_t)));
+            bool ok = bool(out);
+            out.close();
+            std::error_code ec;
+            if (ok) std::filesystem::rename(tmpPath, cachePath, ec);
+            if (!ok || ec) {
+                std::filesystem::remove(tmpPath, ec);
+                std::cerr << "[PRISM] Mesh cache not written: " << cachePath << std::endl;
+            }
+        }
+        return true;
+    }
+
+}
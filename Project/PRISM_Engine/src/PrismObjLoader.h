@@ -0,0 +1,99 @@
+#pragma once
+
+#include "PrismScene.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Prism {
+
+    struct RawObj {
+        std::vector<Float3>   pos;
+        std::vector<Float3>   normals;
+        std::vector<uint32_t> indices;
+        Float3 boundsMin{ 0, 0, 0 };    // 중심 정규화 뒤 AABB
+        Float3 boundsMax{ 0, 0, 0 };
+    };
+
+    // v / vn / f 만 읽음. 다각형은 fan 삼각형화, 법선이 없으면 삼각형마다 face normal (flat shading)
+    // 바운딩박스 중심을 원점으로 옮겨서 반환. 파일이 없으면 빈 RawObj
+    // 파일을 줄 경계에서 나눠 스레드마다 파싱 (threads = 0 이면 hardware_concurrency, 작은 파일은 1)
+    RawObj parseObj(const std::string& path, unsigned threads = 0);
+
+    // 읽기 전용 파일 매핑 (Win32 CreateFileMapping / POSIX mmap)
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile() { close(); }
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool open(const std::string& path);
+        void close();
+
+        const uint8_t* data() const { return mData; }
+        size_t size() const { return mSize; }
+
+    private:
+        const uint8_t* mData = nullptr;
+        size_t         mSize = 0;
+#ifdef _WIN32
+        void* mFile    = nullptr;
+        void* mMapping = nullptr;
+#endif
+    };
+
+    // 바이너리 메시 캐시 ("<obj>.prismmesh", OBJ 옆)
+    // 헤더 + 인터리브 정점 (위치 3 + 법선 3 float, main.cpp 의 OGRE 정점 배치 그대로) + uint32 인덱스
+    // 원본 크기 / 수정 시각 / 앞뒤 64 KB 해시가 다르거나 버전이 다르면 무효 → 다시 파싱해서 덮어씀
+    struct MeshCacheHeader {
+        uint32_t magic;             // kMeshCacheMagic
+        uint32_t version;           // kMeshCacheVersion
+        uint64_t sourceSize;
+        int64_t  sourceTime;        // std::filesystem::last_write_time (파일 시스템 clock tick)
+        uint64_t sourceHash;        // 앞뒤 64 KB FNV-1a
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        float    boundsMin[3];
+        float    boundsMax[3];
+    };
+    static_assert(sizeof(MeshCacheHeader) == 64, "MeshCacheHeader layout");
+
+    const uint32_t kMeshCacheMagic   = 0x4853454D;   // "MESH"
+    const uint32_t kMeshCacheVersion = 1;
+    const uint32_t kMeshVertexFloats = 6;
+
+    // OBJ 한 개의 정점 / 인덱스. 캐시가 맞으면 매핑한 캐시 파일을 그대로 가리키고 (복사 없음),
+    // 아니면 parseObj 결과를 인터리브해서 들고 있다가 캐시를 씀
+    // vertices() / indices() 는 이 객체가 살아 있는 동안만 유효 (VaoManager / RTPipeline::buildBLAS 에 바로 넘길 것)
+    class ObjMesh {
+    public:
+        // 파일이 없거나 빈 메시면 false. writeCache = false 면 캐시를 읽기만 함
+        bool load(const std::string& objPath, bool writeCache = true);
+
+        const float*    vertices() const { return mVertices; }
+        const uint32_t* indices() const  { return mIndices; }
+        uint32_t vertexCount() const { return mVertexCount; }
+        uint32_t indexCount() const  { return mIndexCount; }
+        const Float3& boundsMin() const { return mBoundsMin; }
+        const Float3& boundsMax() const { return mBoundsMax; }
+        bool fromCache() const { return mFromCache; }
+
+    private:
+        MappedFile            mCache;
+        std::vector<float>    mVertexStorage;
+        std::vector<uint32_t> mIndexStorage;
+        const float*    mVertices = nullptr;
+        const uint32_t* mIndices  = nullptr;
+        uint32_t mVertexCount = 0;
+        uint32_t mIndexCount  = 0;
+        Float3   mBoundsMin{ 0, 0, 0 };
+        Float3   mBoundsMax{ 0, 0, 0 };
+        bool     mFromCache = false;
+    };
+
+    std::string meshCachePath(const std::string& objPath);
+
+}
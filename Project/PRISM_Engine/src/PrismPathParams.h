@@ -0,0 +1,35 @@
+#pragma once
+
+#include <algorithm>
+
+// 경로 종료 규칙: 전체 바운스 상한 + 재질별 최대 깊이 + Russian roulette
+// GPU (raygenbsdf.rgen TracePath, CameraUBO) 와 CPU 레퍼런스 (reference/RefPathTracer) 가 같이 씀
+// Ogre / Vulkan 의존 없음
+
+namespace Prism {
+
+    struct PathTerminationParams {
+        int  maxBounces       = 12;     // 경로 하나의 최대 세그먼트 수 (G-Buffer 가 거친 재질인 픽셀은 3)
+        bool russianRoulette  = true;
+        int  rouletteMinDepth = 3;      // 이 세그먼트 수부터 roulette (앞쪽 바운스는 기여가 커서 항상 진행)
+    };
+
+    // roulette 생존 확률 하한 (throughput 이 아주 작아도 이 확률로는 살아남고 1 / q 로 보정 → 불편 추정 유지)
+    constexpr float kRouletteMinSurvival = 0.05f;
+
+    // 재질별 최대 깊이 (SceneObject::maxDepth 가 0 일 때). 이 재질 면에서 경로를 더 이어갈 수 있는 세그먼트 수 상한
+    //   - 투과 (유리) : 안팎을 여러 번 드나들어야 하므로 길게
+    //   - 매끈 / 금속 : 반사 체인
+    //   - 거친 diffuse: 튈 때마다 albedo 만큼 줄어듦. 닫힌 Cornell 박스에서 4 로 자르면 밝기가 10% 빠지고 6 이면 2% 미만
+    inline int defaultMaterialMaxDepth(float specTrans, float roughness, float metallic) {
+        if (specTrans > 0.0f) return 12;
+        if (roughness < 0.35f || metallic > 0.3f) return 8;
+        return 6;
+    }
+
+    // Russian roulette 생존 확률 (raygenbsdf.rgen RouletteSurvival 과 같은 식)
+    inline float rouletteSurvival(float maxThroughput) {
+        return std::min(std::max(maxThroughput, kRouletteMinSurvival), 1.0f);
+    }
+
+}
@@ -1,11 +1,14 @@
 #include "PrismRTPipeline.h"
+#include "PrismMemoryPool.h"
 #include <OgreVulkanRenderSystem.h>
 #include <OgreVulkanDevice.h>
 #include <OgreLogManager.h>
 #include <OgreMesh2.h>
 #include <OgreSubMesh2.h>
+#include <OgreSceneNode.h>
 #include <Vao/OgreVaoManager.h>
 #include <Vao/OgreVertexArrayObject.h>
+#include <Vao/OgreVulkanBufferInterface.h>
 #include <Vao/OgreVertexBufferPacked.h>
 #include <Vao/OgreIndexBufferPacked.h>
 #include <Vao/OgreAsyncTicket.h>
@@ -22,6 +25,8 @@ namespace Prism {
     PFN_vkCmdBuildAccelerationStructuresKHR pfnCmdBuildAS = nullptr;
     PFN_vkGetBufferDeviceAddressKHR pfnGetBufferAddress = nullptr;
     PFN_vkGetAccelerationStructureDeviceAddressKHR pfnGetASDeviceAddress = nullptr;
+    PFN_vkCmdWriteAccelerationStructuresPropertiesKHR pfnCmdWriteASProperties = nullptr;
+    PFN_vkCmdCopyAccelerationStructureKHR pfnCmdCopyAS = nullptr;
 
     RTPipeline::RTPipeline(Ogre::VulkanRenderSystem* rs) : mRenderSystem(rs), mDevice(nullptr) {}
     RTPipeline::~RTPipeline() { cleanup(); }
@@ -37,12 +42,31 @@ namespace Prism {
             pfnCmdBuildAS = (PFN_vkCmdBuildAccelerationStructuresKHR)vkGetDeviceProcAddr(device, "vkCmdBuildAccelerationStructuresKHR");
             pfnGetBufferAddress = (PFN_vkGetBufferDeviceAddressKHR)vkGetDeviceProcAddr(device, "vkGetBufferDeviceAddressKHR");
             pfnGetASDeviceAddress = (PFN_vkGetAccelerationStructureDeviceAddressKHR)vkGetDeviceProcAddr(device, "vkGetAccelerationStructureDeviceAddressKHR");
+            pfnCmdWriteASProperties = (PFN_vkCmdWriteAccelerationStructuresPropertiesKHR)vkGetDeviceProcAddr(device, "vkCmdWriteAccelerationStructuresPropertiesKHR");
+            pfnCmdCopyAS = (PFN_vkCmdCopyAccelerationStructureKHR)vkGetDeviceProcAddr(device, "vkCmdCopyAccelerationStructureKHR");
 
             VkCommandPoolCreateInfo poolInfo = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
             poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
             poolInfo.queueFamilyIndex = mDevice->mGraphicsQueue.mFamilyIdx;
             vkCreateCommandPool(device, &poolInfo, nullptr, &mCommandPool);
 
+            mMemoryPool.initialize(device, mDevice->mPhysicalDevice);
+
+            // 배치 빌드에서 스크래치 버퍼 하나를 빌드별로 나눌 때의 정렬
+            VkPhysicalDeviceAccelerationStructurePropertiesKHR asProps = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_PROPERTIES_KHR };
+            VkPhysicalDeviceProperties2 props2 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2, &asProps };
+            vkGetPhysicalDeviceProperties2(mDevice->mPhysicalDevice, &props2);
+            mScratchAlignment = std::max<VkDeviceSize>(asProps.minAccelerationStructureScratchOffsetAlignment, 1);
+
+            // trace 시간 측정용 타임스탬프 (그래픽스 큐에서 못 쓰면 getTraceTimeMs 는 계속 0)
+            if (props2.properties.limits.timestampComputeAndGraphics && props2.properties.limits.timestampPeriod > 0.0f) {
+                VkQueryPoolCreateInfo qi = { VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO };
+                qi.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+                qi.queryCount = 2 * kFrameStatsSlots;
+                if (vkCreateQueryPool(device, &qi, nullptr, &mTimestampPool) == VK_SUCCESS)
+                    mTimestampPeriod = props2.properties.limits.timestampPeriod;
+            }
+
             createRTImages();
             createRTPipeline();
             createSBT();
@@ -56,22 +80,33 @@ namespace Prism {
             if (mRTPipeline != VK_NULL_HANDLE) vkDestroyPipeline(device, mRTPipeline, nullptr);
 
             // 다중 BLAS 정리
+            if (mBatch.open) flushUploadBatch();
             for (auto& mb : mMeshBLASes) {
                 if (pfnDestroyAS && mb.blas != VK_NULL_HANDLE) pfnDestroyAS(device, mb.blas, nullptr);
-                if (mb.blasBuffer  != VK_NULL_HANDLE) vkDestroyBuffer(device, mb.blasBuffer,  nullptr);
-                if (mb.blasMemory  != VK_NULL_HANDLE) vkFreeMemory(device,    mb.blasMemory,  nullptr);
-                if (mb.vertexBuffer != VK_NULL_HANDLE) vkDestroyBuffer(device, mb.vertexBuffer, nullptr);
-                if (mb.vertexMemory != VK_NULL_HANDLE) vkFreeMemory(device,    mb.vertexMemory, nullptr);
-                if (mb.indexBuffer  != VK_NULL_HANDLE) vkDestroyBuffer(device, mb.indexBuffer,  nullptr);
-                if (mb.indexMemory  != VK_NULL_HANDLE) vkFreeMemory(device,    mb.indexMemory,  nullptr);
+                destroyPooledBuffer(mb.blasBuffer,   mb.blasMemory);
+                destroyPooledBuffer(mb.vertexBuffer, mb.vertexMemory);
+                destroyPooledBuffer(mb.indexBuffer,  mb.indexMemory);
             }
             mMeshBLASes.clear();
 
+            // 변형 BLAS 정리 (정점 버퍼는 시뮬레이션 소유)
+            for (auto& db : mDeformableBLASes) {
+                if (pfnDestroyAS && db.blas != VK_NULL_HANDLE) pfnDestroyAS(device, db.blas, nullptr);
+                destroyPooledBuffer(db.blasBuffer,    db.blasMemory);
+                destroyPooledBuffer(db.indexBuffer,   db.indexMemory);
+                destroyPooledBuffer(db.scratchBuffer, db.scratchMemory);
+            }
+            mDeformableBLASes.clear();
+            mDeformableKeyToIndex.clear();
+
             if (pfnDestroyAS && mTopLevelAS != VK_NULL_HANDLE) pfnDestroyAS(device, mTopLevelAS, nullptr);
             if (mTLASBuffer    != VK_NULL_HANDLE) vkDestroyBuffer(device, mTLASBuffer,    nullptr);
             if (mTLASMemory    != VK_NULL_HANDLE) vkFreeMemory(device,    mTLASMemory,    nullptr);
+            if (mInstanceMapped) vkUnmapMemory(device, mInstanceMemory);
             if (mInstanceBuffer != VK_NULL_HANDLE) vkDestroyBuffer(device, mInstanceBuffer, nullptr);
             if (mInstanceMemory != VK_NULL_HANDLE) vkFreeMemory(device,    mInstanceMemory, nullptr);
+            if (mTLASScratchBuffer != VK_NULL_HANDLE) vkDestroyBuffer(device, mTLASScratchBuffer, nullptr);
+            if (mTLASScratchMemory != VK_NULL_HANDLE) vkFreeMemory(device,    mTLASScratchMemory, nullptr);
             if (mSBTBuffer     != VK_NULL_HANDLE) vkDestroyBuffer(device, mSBTBuffer,     nullptr);
             if (mSBTMemory     != VK_NULL_HANDLE) vkFreeMemory(device,    mSBTMemory,     nullptr);
             if (mDescriptorPool != VK_NULL_HANDLE) vkDestroyDescriptorPool(device, mDescriptorPool, nullptr);
@@ -84,6 +119,11 @@ namespace Prism {
             destroyImage(mStorageImage, mStorageImageView, mStorageImageMemory);
             destroyImage(mAccumImage,   mAccumImageView,   mAccumImageMemory);
             destroyImage(mDummyDepthImage, mDummyDepthView, mDummyDepthMemory);
+            destroyImage(mHistoryColorImage,   mHistoryColorView,   mHistoryColorMemory);
+            destroyImage(mSurfaceImage,        mSurfaceView,        mSurfaceMemory);
+            destroyImage(mHistorySurfaceImage, mHistorySurfaceView, mHistorySurfaceMemory);
+            destroyImage(mVarianceImage,        mVarianceView,        mVarianceMemory);
+            destroyImage(mHistoryVarianceImage, mHistoryVarianceView, mHistoryVarianceMemory);
             if (mDummySampler    != VK_NULL_HANDLE) vkDestroySampler(device, mDummySampler,    nullptr);
             if (mGBufferSampler  != VK_NULL_HANDLE) vkDestroySampler(device, mGBufferSampler,  nullptr);
 
@@ -95,18 +135,19 @@ namespace Prism {
             if (mMaterialMemory  != VK_NULL_HANDLE) vkFreeMemory(device,    mMaterialMemory,  nullptr);
             if (mObjDescBuffer   != VK_NULL_HANDLE) vkDestroyBuffer(device, mObjDescBuffer,   nullptr);
             if (mObjDescMemory   != VK_NULL_HANDLE) vkFreeMemory(device,    mObjDescMemory,   nullptr);
+            if (mLightBuffer     != VK_NULL_HANDLE) vkDestroyBuffer(device, mLightBuffer,     nullptr);
+            if (mLightMemory     != VK_NULL_HANDLE) vkFreeMemory(device,    mLightMemory,     nullptr);
+            if (mLightNodeBuffer != VK_NULL_HANDLE) vkDestroyBuffer(device, mLightNodeBuffer, nullptr);
+            if (mLightNodeMemory != VK_NULL_HANDLE) vkFreeMemory(device,    mLightNodeMemory, nullptr);
+            if (mFrameStatsMapped) vkUnmapMemory(device, mFrameStatsMemory);
+            if (mFrameStatsBuffer != VK_NULL_HANDLE) vkDestroyBuffer(device, mFrameStatsBuffer, nullptr);
+            if (mFrameStatsMemory != VK_NULL_HANDLE) vkFreeMemory(device,    mFrameStatsMemory, nullptr);
+            if (mTimestampPool != VK_NULL_HANDLE) vkDestroyQueryPool(device, mTimestampPool, nullptr);
+
+            mMemoryPool.cleanup();
         }
     }
 
-    uint32_t findMemoryType(VkPhysicalDevice physicalDevice, uint32_t typeFilter, VkMemoryPropertyFlags properties) {
-        VkPhysicalDeviceMemoryProperties memProperties;
-        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
-        for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-            if ((typeFilter & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties) return i;
-        }
-        return 0;
-    }
-
     void RTPipeline::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& targetBuffer, VkDeviceMemory& targetMemory) {
         VkDevice device = mDevice->mDevice;
         VkBufferCreateInfo bufferInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
@@ -137,6 +178,156 @@ namespace Prism {
         return pfnGetBufferAddress(mDevice->mDevice, &info);
     }
 
+    void RTPipeline::createPooledBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties,
+                                        VkBuffer& targetBuffer, GpuAllocation& targetAlloc) {
+        VkDevice device = mDevice->mDevice;
+        VkBufferCreateInfo bufferInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+        bufferInfo.size = size;
+        bufferInfo.usage = usage | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        vkCreateBuffer(device, &bufferInfo, nullptr, &targetBuffer);
+
+        VkMemoryRequirements memReqs;
+        vkGetBufferMemoryRequirements(device, targetBuffer, &memReqs);
+        targetAlloc = mMemoryPool.allocate(memReqs, properties);
+        vkBindBufferMemory(device, targetBuffer, targetAlloc.memory, targetAlloc.offset);
+    }
+
+    void RTPipeline::destroyPooledBuffer(VkBuffer& buffer, GpuAllocation& alloc) {
+        if (buffer != VK_NULL_HANDLE) vkDestroyBuffer(mDevice->mDevice, buffer, nullptr);
+        mMemoryPool.free(alloc);
+        buffer = VK_NULL_HANDLE;
+    }
+
+    void RTPipeline::beginUploadBatch() {
+        if (mBatch.open) return;
+        mBatch.cmd  = beginSingleTimeCommands();
+        mBatch.open = true;
+    }
+
+    void RTPipeline::queueUpload(VkBuffer dst, const void* src, VkDeviceSize size) {
+        bool implicit = !mBatch.open;
+        if (implicit) beginUploadBatch();
+        memcpy(queueUploadSpace(dst, size), src, size);
+        if (implicit) flushUploadBatch();
+    }
+
+    void* RTPipeline::queueUploadSpace(VkBuffer dst, VkDeviceSize size) {
+        // 스테이징도 풀에서 (HOST_VISIBLE 블록은 영구 매핑이라 map/unmap 없음)
+        StagingBuffer staging;
+        createPooledBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            staging.buffer, staging.alloc);
+
+        VkBufferCopy region = { 0, 0, size };
+        vkCmdCopyBuffer(mBatch.cmd, staging.buffer, dst, 1, &region);
+        mBatch.staging.push_back(staging);
+        mBatch.uploadBytes += size;
+        return staging.alloc.mapped;
+    }
+
+    void RTPipeline::queueBLASBuild(const VkAccelerationStructureGeometryKHR& geo,
+                                    const VkAccelerationStructureBuildGeometryInfoKHR& buildInfo,
+                                    const VkAccelerationStructureBuildRangeInfoKHR& range,
+                                    VkDeviceSize scratchSize) {
+        bool implicit = !mBatch.open;
+        if (implicit) beginUploadBatch();
+
+        // build info 는 geometry 포인터를 들고 있으므로 deque 로 주소 고정
+        mBatch.geometries.push_back(geo);
+        mBatch.builds.push_back(buildInfo);
+        mBatch.builds.back().pGeometries   = &mBatch.geometries.back();
+        mBatch.builds.back().geometryCount = 1;
+        mBatch.ranges.push_back(range);
+        mBatch.scratchSizes.push_back(scratchSize);   // 0 이면 호출 측 스크래치 사용 (scratchData 그대로)
+
+        if (implicit) flushUploadBatch();
+    }
+
+    void RTPipeline::flushUploadBatch() {
+        if (!mBatch.open) return;
+        VkCommandBuffer cmd = mBatch.cmd;
+
+        // 공유 정점 버퍼의 초기 데이터 복사가 OGRE 커맨드 버퍼에 남아 있으면 먼저 제출 (같은 큐 → 아래 배리어가 순서 보장)
+        if (mBatch.waitForOgreUploads) mDevice->commitAndNextCommandBuffer();
+
+        // 모든 복사 -> (빌드 입력 읽기, 셰이더 읽기)
+        VkMemoryBarrier copied = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+        copied.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        copied.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR | VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR,
+            0, 1, &copied, 0, nullptr, 0, nullptr);
+
+        // 빌드별 스크래치를 버퍼 하나에서 정렬해 나눠 줌
+        VkBuffer scratch = VK_NULL_HANDLE; GpuAllocation scratchAlloc;
+        if (!mBatch.builds.empty()) {
+            VkDeviceSize total = 0;
+            std::vector<VkDeviceSize> offsets(mBatch.builds.size(), 0);
+            for (size_t i = 0; i < mBatch.builds.size(); i++) {
+                if (mBatch.scratchSizes[i] == 0) continue;
+                offsets[i] = total;
+                total += (mBatch.scratchSizes[i] + mScratchAlignment - 1) / mScratchAlignment * mScratchAlignment;
+            }
+            if (total > 0) {
+                createPooledBuffer(total + mScratchAlignment, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, scratch, scratchAlloc);
+                VkDeviceAddress base = getBufferDeviceAddress(scratch);
+                base = (base + mScratchAlignment - 1) / mScratchAlignment * mScratchAlignment;
+                for (size_t i = 0; i < mBatch.builds.size(); i++) {
+                    if (mBatch.scratchSizes[i] != 0) mBatch.builds[i].scratchData.deviceAddress = base + offsets[i];
+                }
+            }
+
+            // 서로 독립인 BLAS 빌드를 한 번에 기록
+            std::vector<const VkAccelerationStructureBuildRangeInfoKHR*> pRanges(mBatch.ranges.size());
+            for (size_t i = 0; i < mBatch.ranges.size(); i++) pRanges[i] = &mBatch.ranges[i];
+            pfnCmdBuildAS(cmd, (uint32_t)mBatch.builds.size(), mBatch.builds.data(), pRanges.data());
+
+            VkMemoryBarrier built = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+            built.srcAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+            built.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR | VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR,
+                0, 1, &built, 0, nullptr, 0, nullptr);
+        }
+
+        // 압축 대상 BLAS 의 압축 후 크기 질의 (빌드 뒤 배리어가 AS_BUILD 단계 읽기를 이미 보장)
+        VkQueryPool compactQuery = VK_NULL_HANDLE;
+        uint32_t compactCount = (uint32_t)mBatch.compactMeshes.size();
+        if (compactCount > 0) {
+            VkQueryPoolCreateInfo qi = { VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO };
+            qi.queryType  = VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR;
+            qi.queryCount = compactCount;
+            vkCreateQueryPool(mDevice->mDevice, &qi, nullptr, &compactQuery);
+            vkCmdResetQueryPool(cmd, compactQuery, 0, compactCount);
+
+            std::vector<VkAccelerationStructureKHR> ases(compactCount);
+            for (uint32_t i = 0; i < compactCount; i++) ases[i] = mMeshBLASes[mBatch.compactMeshes[i]].blas;
+            pfnCmdWriteASProperties(cmd, compactCount, ases.data(), VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR, compactQuery, 0);
+        }
+
+        // 제출 1 회 + 펜스 대기 1 회
+        endSingleTimeCommands(cmd);
+
+        if (compactQuery != VK_NULL_HANDLE) {
+            std::vector<VkDeviceSize> compactSizes(compactCount, 0);
+            vkGetQueryPoolResults(mDevice->mDevice, compactQuery, 0, compactCount, sizeof(VkDeviceSize) * compactCount,
+                compactSizes.data(), sizeof(VkDeviceSize), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+            vkDestroyQueryPool(mDevice->mDevice, compactQuery, nullptr);
+            compactBLASes(mBatch.compactMeshes, compactSizes);
+        }
+
+        if (mBatch.staging.size() > 1 || mBatch.builds.size() > 1) {
+            Ogre::LogManager::getSingleton().logMessage("[PRISM] Upload batch: " + std::to_string(mBatch.staging.size()) + " copies ("
+                + std::to_string(mBatch.uploadBytes / 1024) + " KB), " + std::to_string(mBatch.builds.size()) + " BLAS builds, pool "
+                + std::to_string(mMemoryPool.getBlockCount()) + " blocks / " + std::to_string(mMemoryPool.getReservedBytes() >> 20) + " MB");
+        }
+
+        for (auto& st : mBatch.staging) destroyPooledBuffer(st.buffer, st.alloc);
+        destroyPooledBuffer(scratch, scratchAlloc);
+        mBatch = UploadBatch{};
+    }
+
     void RTPipeline::createRTPipeline() {
         VkDevice device = mDevice->mDevice;
         auto loadShader = [&](const std::string& path) -> VkShaderModule {
@@ -160,16 +351,26 @@ namespace Prism {
             VkDescriptorSetLayoutBinding bind{}; bind.binding = i; bind.descriptorType = t; bind.descriptorCount = 1; bind.stageFlags = s; b.push_back(bind);
         };
         // [2_LSM 바인딩 레이아웃]
+        // COMPUTE 가 붙은 바인딩은 wavefront 모드의 wavefront_shade.comp / wavefront_resolve.comp 도 읽음 (PrismWavefront.cpp)
+        const VkShaderStageFlags rgenCompute = VK_SHADER_STAGE_RAYGEN_BIT_KHR | VK_SHADER_STAGE_COMPUTE_BIT;
         add(0, VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, VK_SHADER_STAGE_RAYGEN_BIT_KHR);
-        add(1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_SHADER_STAGE_RAYGEN_BIT_KHR);
-        add(2, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_RAYGEN_BIT_KHR | VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR);
+        add(1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, rgenCompute);
+        add(2, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, rgenCompute | VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR);
         add(3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR); // Materials
         add(4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR); // ObjDescs
         add(5, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_RAYGEN_BIT_KHR); // Depth
-        add(6, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_SHADER_STAGE_RAYGEN_BIT_KHR); // Accum
-        add(7, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_RAYGEN_BIT_KHR); // G-Buffer albedo
+        add(6, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, rgenCompute); // Accum
+        add(7, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, rgenCompute); // G-Buffer albedo
         add(8, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_RAYGEN_BIT_KHR); // G-Buffer normal
         add(9, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_RAYGEN_BIT_KHR); // G-Buffer material
+        add(10, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_SHADER_STAGE_RAYGEN_BIT_KHR); // History color
+        add(11, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_SHADER_STAGE_RAYGEN_BIT_KHR); // Surface (normal + distance)
+        add(12, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_SHADER_STAGE_RAYGEN_BIT_KHR); // History surface
+        add(13, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, rgenCompute); // Lights
+        add(14, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, rgenCompute); // Light BVH nodes
+        add(15, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, rgenCompute);  // Variance (휘도 모멘트 + 샘플 수 맵)
+        add(16, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_SHADER_STAGE_RAYGEN_BIT_KHR);  // History variance
+        add(17, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, rgenCompute); // Frame stats (적응형 샘플링 + 경로 길이)
 
         VkDescriptorSetLayoutCreateInfo lci = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
         lci.bindingCount = (uint32_t)b.size(); lci.pBindings = b.data();
@@ -208,78 +409,161 @@ namespace Prism {
             return it->second;
         }
 
-        uint32_t meshIdx = (uint32_t)mMeshBLASes.size();
-        mMeshBLASes.push_back(MeshBlas{});
-        mMeshKeyToIndex[meshKey] = meshIdx;
-        MeshBlas& mb = mMeshBLASes.back();
-
         Ogre::SubMesh* subMesh = mesh->getSubMesh(0);
         Ogre::VertexArrayObject* vao = subMesh->mVao[0][0];
         Ogre::VertexBufferPacked* vBuf = vao->getVertexBuffers()[0];
         Ogre::IndexBufferPacked* iBuf = vao->getIndexBuffer();
 
+        // OGRE 버퍼를 읽어서 (shadow copy 가 없으면 GPU 읽기) 그대로 넘김
         size_t vertexCount = vBuf->getNumElements();
         size_t indexCount  = iBuf->getNumElements();
+        Ogre::AsyncTicketPtr vTicket = vBuf->readRequest(0, vertexCount);
+        Ogre::AsyncTicketPtr iTicket = iBuf->readRequest(0, indexCount);
+        uint32_t meshIdx = buildBLAS(meshKey, static_cast<const float*>(vTicket->map()),
+                                     uint32_t(vBuf->getBytesPerElement() / sizeof(float)), vertexCount,
+                                     static_cast<const uint32_t*>(iTicket->map()), indexCount);
+        vTicket->unmap();
+        iTicket->unmap();
+        return meshIdx;
+    }
+
+    uint32_t RTPipeline::buildBLAS(const std::string& meshKey, const float* vertices, uint32_t vertexStride,
+                                   size_t vertexCount, const uint32_t* indices, size_t indexCount) {
+        auto it = mMeshKeyToIndex.find(meshKey);
+        if (it != mMeshKeyToIndex.end()) {
+            Ogre::LogManager::getSingleton().logMessage("[PRISM] BLAS cache hit: " + meshKey);
+            return it->second;
+        }
+
+        uint32_t meshIdx = (uint32_t)mMeshBLASes.size();
+        mMeshBLASes.push_back(MeshBlas{});
+        mMeshKeyToIndex[meshKey] = meshIdx;
+        MeshBlas& mb = mMeshBLASes.back();
+        mb.key = meshKey;
+
         size_t rtBufferSize = vertexCount * sizeof(RTVertex);
-        size_t ogreStride  = vBuf->getBytesPerElement() / sizeof(float);
+        size_t indexBytes   = indexCount * sizeof(uint32_t);
 
-        // Vertex 버퍼 생성 및 업로드
-        createBuffer(rtBufferSize,
-            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR,
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-            mb.vertexBuffer, mb.vertexMemory);
+        // 배치 밖이면 이 메시만의 배치 (복사 + 빌드 + 압축을 한 번에)
+        bool implicitBatch = !mBatch.open;
+        if (implicitBatch) beginUploadBatch();
 
-        // Index 버퍼 생성 및 업로드
-        createBuffer(iBuf->getTotalSizeBytes(),
-            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR,
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        // Vertex / Index 버퍼 (DEVICE_LOCAL, 풀에서 할당) - 내용은 스테이징 복사로 배치에 기록
+        createPooledBuffer(rtBufferSize,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            mb.vertexBuffer, mb.vertexMemory);
+        createPooledBuffer(indexBytes,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
             mb.indexBuffer, mb.indexMemory);
 
-        // 정점 데이터 복사
-        Ogre::AsyncTicketPtr vTicket = vBuf->readRequest(0, vertexCount);
-        const float* ogreVData = static_cast<const float*>(vTicket->map());
-        void* data;
-        vkMapMemory(mDevice->mDevice, mb.vertexMemory, 0, rtBufferSize, 0, &data);
-        RTVertex* rtVData = static_cast<RTVertex*>(data);
+        // 정점 데이터: 스테이징에 RTVertex 로 바로 씀 (중간 사본 없음)
+        RTVertex* rtVData = static_cast<RTVertex*>(queueUploadSpace(mb.vertexBuffer, rtBufferSize));
         for (size_t i = 0; i < vertexCount; ++i) {
-            rtVData[i].pos[0]    = ogreVData[i * ogreStride + 0];
-            rtVData[i].pos[1]    = ogreVData[i * ogreStride + 1];
-            rtVData[i].pos[2]    = ogreVData[i * ogreStride + 2];
+            const float* src = vertices + i * vertexStride;
+            rtVData[i].pos[0]    = src[0];
+            rtVData[i].pos[1]    = src[1];
+            rtVData[i].pos[2]    = src[2];
             rtVData[i].pad1      = 1.0f;
-            rtVData[i].normal[0] = ogreVData[i * ogreStride + 3];
-            rtVData[i].normal[1] = ogreVData[i * ogreStride + 4];
-            rtVData[i].normal[2] = ogreVData[i * ogreStride + 5];
+            rtVData[i].normal[0] = src[3];
+            rtVData[i].normal[1] = src[4];
+            rtVData[i].normal[2] = src[5];
             rtVData[i].pad2      = 1.0f;
         }
-        vkUnmapMemory(mDevice->mDevice, mb.vertexMemory);
-        vTicket->unmap();
 
         // 인덱스 데이터 복사
-        Ogre::AsyncTicketPtr iTicket = iBuf->readRequest(0, indexCount);
-        const void* ogreIData = iTicket->map();
-        vkMapMemory(mDevice->mDevice, mb.indexMemory, 0, iBuf->getTotalSizeBytes(), 0, &data);
-        memcpy(data, ogreIData, iBuf->getTotalSizeBytes());
-        vkUnmapMemory(mDevice->mDevice, mb.indexMemory);
-        iTicket->unmap();
+        queueUpload(mb.indexBuffer, indices, indexBytes);
 
         // 디바이스 주소 저장
         mb.vertexAddress = getBufferDeviceAddress(mb.vertexBuffer);
         mb.indexAddress  = getBufferDeviceAddress(mb.indexBuffer);
 
-        // BLAS 빌드
+        queueMeshBLAS(meshIdx, sizeof(RTVertex), vertexCount, indexCount);
+        if (implicitBatch) flushUploadBatch();   // 압축되면 blasAddress 갱신됨
+
+        Ogre::LogManager::getSingleton().logMessage("[PRISM] BLAS queued: " + meshKey + " idx=" + std::to_string(meshIdx));
+        return meshIdx;
+    }
+
+    uint32_t RTPipeline::buildBLASShared(Ogre::MeshPtr mesh, const std::string& meshKey) {
+        auto it = mMeshKeyToIndex.find(meshKey);
+        if (it != mMeshKeyToIndex.end()) {
+            Ogre::LogManager::getSingleton().logMessage("[PRISM] BLAS cache hit: " + meshKey);
+            return it->second;
+        }
+
+        Ogre::VertexArrayObject* vao = mesh->getSubMesh(0)->mVao[0][0];
+        Ogre::VertexBufferPacked* vBuf = vao->getVertexBuffers()[0];
+        Ogre::IndexBufferPacked* iBuf = vao->getIndexBuffer();
+
+        // 공유 조건: 정점 0 바이트에 float3 위치, 12 바이트에 float3 법선 (closesthitbsdf.rchit 가 stride 로 읽음),
+        // 32 비트 인덱스, 프레임마다 영역이 바뀌지 않는 버퍼 (BT_IMMUTABLE / BT_DEFAULT)
+        const Ogre::VertexElement2Vec& elements = vBuf->getVertexElements();
+        auto isStatic = [](Ogre::BufferType type) { return type == Ogre::BT_IMMUTABLE || type == Ogre::BT_DEFAULT; };
+        bool shareable = iBuf && iBuf->getIndexType() == Ogre::IndexBufferPacked::IT_32BIT &&
+                         isStatic(vBuf->getBufferType()) && isStatic(iBuf->getBufferType()) &&
+                         elements.size() >= 2 &&
+                         elements[0].mSemantic == Ogre::VES_POSITION && elements[0].mType == Ogre::VET_FLOAT3 &&
+                         elements[1].mSemantic == Ogre::VES_NORMAL   && elements[1].mType == Ogre::VET_FLOAT3 &&
+                         mDevice->mDeviceExtraFeatures.bufferDeviceAddress;
+        if (!shareable) {
+            Ogre::LogManager::getSingleton().logMessage("[PRISM] BLAS: vertex layout not shareable, copying " + meshKey);
+            return buildBLAS(mesh, meshKey);
+        }
+
+        uint32_t meshIdx = (uint32_t)mMeshBLASes.size();
+        mMeshBLASes.push_back(MeshBlas{});
+        mMeshKeyToIndex[meshKey] = meshIdx;
+        MeshBlas& mb = mMeshBLASes.back();
+        mb.key            = meshKey;
+        mb.sharedGeometry = true;
+        mb.vertexStride   = vBuf->getBytesPerElement() / sizeof(float);
+        mb.normalOffset   = 3;
+
+        // OGRE 풀 버퍼 (VulkanVaoManager 가 SHADER_DEVICE_ADDRESS + AS_BUILD_INPUT 으로 만듦) 안의 위치
+        auto* vInterface = static_cast<Ogre::VulkanBufferInterface*>(vBuf->getBufferInterface());
+        auto* iInterface = static_cast<Ogre::VulkanBufferInterface*>(iBuf->getBufferInterface());
+        mb.vertexAddress = getBufferDeviceAddress(vInterface->getVboName()) + vBuf->_getFinalBufferStart() * vBuf->getBytesPerElement();
+        mb.indexAddress  = getBufferDeviceAddress(iInterface->getVboName()) + iBuf->_getFinalBufferStart() * iBuf->getBytesPerElement();
+
+        bool implicitBatch = !mBatch.open;
+        if (implicitBatch) beginUploadBatch();
+        // 초기 데이터는 OGRE 의 프레임 커맨드 버퍼에 복사로 기록되어 있음 → flush 에서 그것부터 제출
+        mBatch.waitForOgreUploads = true;
+        queueMeshBLAS(meshIdx, vBuf->getBytesPerElement(), vBuf->getNumElements(), iBuf->getNumElements());
+        if (implicitBatch) flushUploadBatch();
+
+        Ogre::LogManager::getSingleton().logMessage("[PRISM] BLAS queued (shared vertex buffer): " + meshKey + " idx=" + std::to_string(meshIdx));
+        return meshIdx;
+    }
+
+    ObjDesc RTPipeline::getMeshObjDesc(uint32_t meshIdx) const {
+        const MeshBlas& mb = mMeshBLASes[meshIdx];
+        ObjDesc desc;
+        desc.vertexAddress = mb.vertexAddress;
+        desc.indexAddress  = mb.indexAddress;
+        desc.vertexStride  = mb.vertexStride;
+        desc.normalOffset  = mb.normalOffset;
+        return desc;
+    }
+
+    void RTPipeline::queueMeshBLAS(uint32_t meshIdx, VkDeviceSize vertexStrideBytes, size_t vertexCount, size_t indexCount) {
+        MeshBlas& mb = mMeshBLASes[meshIdx];
         VkAccelerationStructureGeometryKHR geo = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR };
         geo.geometryType = VK_GEOMETRY_TYPE_TRIANGLES_KHR;
         geo.geometry.triangles.sType         = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_TRIANGLES_DATA_KHR;
         geo.geometry.triangles.vertexFormat  = VK_FORMAT_R32G32B32_SFLOAT;
         geo.geometry.triangles.vertexData.deviceAddress = mb.vertexAddress;
-        geo.geometry.triangles.vertexStride  = sizeof(RTVertex);
-        geo.geometry.triangles.maxVertex     = (uint32_t)vertexCount;
+        geo.geometry.triangles.vertexStride  = vertexStrideBytes;
+        geo.geometry.triangles.maxVertex     = (uint32_t)vertexCount - 1;   // 정점 수가 아니라 가장 큰 정점 인덱스
         geo.geometry.triangles.indexType     = VK_INDEX_TYPE_UINT32;
         geo.geometry.triangles.indexData.deviceAddress = mb.indexAddress;
 
         VkAccelerationStructureBuildGeometryInfoKHR buildInfo = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR };
         buildInfo.type          = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
         buildInfo.flags         = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR;
+        if (mCompactBLAS) buildInfo.flags |= VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR;
         buildInfo.geometryCount = 1;
         buildInfo.pGeometries   = &geo;
 
@@ -287,101 +571,506 @@ namespace Prism {
         VkAccelerationStructureBuildSizesInfoKHR sizes = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR };
         pfnGetASBuildSizes(mDevice->mDevice, VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR, &buildInfo, &maxPrimCount, &sizes);
 
-        createBuffer(sizes.accelerationStructureSize, VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, mb.blasBuffer, mb.blasMemory);
+        createPooledBuffer(sizes.accelerationStructureSize, VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, mb.blasBuffer, mb.blasMemory);
+        mb.buildSize = mb.blasSize = sizes.accelerationStructureSize;
 
         VkAccelerationStructureCreateInfoKHR ci = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR };
         ci.buffer = mb.blasBuffer; ci.size = sizes.accelerationStructureSize; ci.type = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
         pfnCreateAS(mDevice->mDevice, &ci, nullptr, &mb.blas);
 
-        VkBuffer scratch; VkDeviceMemory scratchMem;
-        createBuffer(sizes.buildScratchSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, scratch, scratchMem);
-
+        // 빌드는 배치에 넣음 (배치 밖이면 즉시 제출). 스크래치는 flushUploadBatch 가 빌드 전체에 한 번 할당
         buildInfo.mode                    = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
         buildInfo.dstAccelerationStructure = mb.blas;
-        buildInfo.scratchData.deviceAddress = getBufferDeviceAddress(scratch);
-
-        VkAccelerationStructureBuildRangeInfoKHR range = { maxPrimCount, 0, 0, 0 };
-        const VkAccelerationStructureBuildRangeInfoKHR* pRange = &range;
-        VkCommandBuffer cmd = beginSingleTimeCommands();
-        pfnCmdBuildAS(cmd, 1, &buildInfo, &pRange);
-        endSingleTimeCommands(cmd);
-
-        vkDestroyBuffer(mDevice->mDevice, scratch, nullptr);
-        vkFreeMemory(mDevice->mDevice, scratchMem, nullptr);
+        queueBLASBuild(geo, buildInfo, { maxPrimCount, 0, 0, 0 }, sizes.buildScratchSize);
+        if (mCompactBLAS) mBatch.compactMeshes.push_back(meshIdx);
 
         VkAccelerationStructureDeviceAddressInfoKHR addrInfo = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR };
         addrInfo.accelerationStructure = mb.blas;
         mb.blasAddress = pfnGetASDeviceAddress(mDevice->mDevice, &addrInfo);
+    }
 
-        Ogre::LogManager::getSingleton().logMessage("[PRISM] BLAS built: " + meshKey + " idx=" + std::to_string(meshIdx));
-        return meshIdx;
+    void RTPipeline::writeTLASInstance(uint32_t i) {
+        const RTObject& obj = mTLASObjects[i];
+        VkAccelerationStructureInstanceKHR& inst = mTLASInstances[i];
+        const Ogre::Matrix4& m = obj.transform;
+        for (int r = 0; r < 3; r++)
+            for (int c = 0; c < 4; c++)
+                inst.transform.matrix[r][c] = m[r][c];
+        inst.mask                            = obj.instanceMask;
+        inst.accelerationStructureReference  = obj.blasAddress;
+        inst.flags                           = VK_GEOMETRY_INSTANCE_TRIANGLE_FACING_CULL_DISABLE_BIT_KHR;
+        inst.instanceCustomIndex             = i;
+        inst.instanceShaderBindingTableRecordOffset = 0;
+        mTLASChangeSerial[i] = mTLASSerial;
+        mTLASDirty = true;
     }
 
-    void RTPipeline::buildTLAS(const std::vector<RTObject>& objects) {
+    bool RTPipeline::ensureTLASCapacity(uint32_t count) {
+        if (count <= mTLASCapacity && mTopLevelAS != VK_NULL_HANDLE) return false;
         VkDevice device = mDevice->mDevice;
 
-        uint32_t count = (uint32_t)objects.size();
-        std::vector<VkAccelerationStructureInstanceKHR> instances(count);
-
-        for (size_t i = 0; i < objects.size(); i++) {
-            const Ogre::Matrix4& m = objects[i].transform;
-            for (int r = 0; r < 3; r++)
-                for (int c = 0; c < 4; c++)
-                    instances[i].transform.matrix[r][c] = m[r][c];
-            instances[i].mask                            = objects[i].instanceMask;
-            instances[i].accelerationStructureReference  = objects[i].blasAddress;
-            instances[i].flags                           = VK_GEOMETRY_INSTANCE_TRIANGLE_FACING_CULL_DISABLE_BIT_KHR;
-            instances[i].instanceCustomIndex             = (uint32_t)i;
-            instances[i].instanceShaderBindingTableRecordOffset = 0;
-        }
-
-        VkDeviceSize instBufSize = sizeof(VkAccelerationStructureInstanceKHR) * count;
-        createBuffer(instBufSize,
+        // 이전 프레임이 아직 옛 TLAS 를 읽고 있을 수 있음 (용량 증가는 드묾)
+        if (mTopLevelAS != VK_NULL_HANDLE) {
+            vkDeviceWaitIdle(device);
+            pfnDestroyAS(device, mTopLevelAS, nullptr);
+            vkDestroyBuffer(device, mTLASBuffer, nullptr);        vkFreeMemory(device, mTLASMemory, nullptr);
+            vkDestroyBuffer(device, mTLASScratchBuffer, nullptr); vkFreeMemory(device, mTLASScratchMemory, nullptr);
+            vkUnmapMemory(device, mInstanceMemory);
+            vkDestroyBuffer(device, mInstanceBuffer, nullptr);    vkFreeMemory(device, mInstanceMemory, nullptr);
+        }
+        mTLASCapacity = std::max({ count, mTLASCapacity * 2, 16u });
+
+        // 인스턴스 버퍼는 in-flight 프레임 수만큼 영역을 나눠 GPU 가 읽는 중인 영역을 덮어쓰지 않음
+        Ogre::VaoManager* vaoMgr = mRenderSystem->getVaoManager();
+        mTLASRegionCount = std::max<uint32_t>(1u, vaoMgr->getDynamicBufferMultiplier());
+        mTLASRegionSerial.assign(mTLASRegionCount, 0);
+
+        VkDeviceSize regionSize = sizeof(VkAccelerationStructureInstanceKHR) * mTLASCapacity;
+        createBuffer(regionSize * mTLASRegionCount,
             VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR,
             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
             mInstanceBuffer, mInstanceMemory);
-        void* data;
-        vkMapMemory(device, mInstanceMemory, 0, instBufSize, 0, &data);
-        memcpy(data, instances.data(), instBufSize);
-        vkUnmapMemory(device, mInstanceMemory);
+        vkMapMemory(device, mInstanceMemory, 0, VK_WHOLE_SIZE, 0, (void**)&mInstanceMapped);
+        mInstanceAddress = getBufferDeviceAddress(mInstanceBuffer);
 
-        VkAccelerationStructureGeometryKHR geo = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR };
+        VkAccelerationStructureGeometryKHR geo;
+        VkAccelerationStructureBuildGeometryInfoKHR buildInfo;
+        fillTLASBuildInfo(0, geo, buildInfo);
+
+        VkAccelerationStructureBuildSizesInfoKHR sizes = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR };
+        pfnGetASBuildSizes(device, VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR, &buildInfo, &mTLASCapacity, &sizes);
+
+        createBuffer(sizes.accelerationStructureSize, VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, mTLASBuffer, mTLASMemory);
+        mTLASSize = sizes.accelerationStructureSize;
+
+        VkAccelerationStructureCreateInfoKHR ci = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR };
+        ci.buffer = mTLASBuffer; ci.size = sizes.accelerationStructureSize; ci.type = VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR;
+        pfnCreateAS(device, &ci, nullptr, &mTopLevelAS);
+
+        createBuffer(std::max(sizes.buildScratchSize, sizes.updateScratchSize), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, mTLASScratchBuffer, mTLASScratchMemory);
+        mTLASScratchAddress = getBufferDeviceAddress(mTLASScratchBuffer);
+
+        // 핸들이 바뀌었으므로 이미 만든 descriptor 의 binding 0 갱신
+        if (mDescriptorSet != VK_NULL_HANDLE) {
+            VkWriteDescriptorSetAccelerationStructureKHR asInfo = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_KHR };
+            asInfo.accelerationStructureCount = 1; asInfo.pAccelerationStructures = &mTopLevelAS;
+            VkWriteDescriptorSet w = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+            w.pNext = &asInfo; w.dstSet = mDescriptorSet; w.dstBinding = 0; w.descriptorCount = 1;
+            w.descriptorType = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+            vkUpdateDescriptorSets(device, 1, &w, 0, nullptr);
+        }
+
+        Ogre::LogManager::getSingleton().logMessage("[PRISM] TLAS capacity: " + std::to_string(mTLASCapacity)
+            + " instances x " + std::to_string(mTLASRegionCount) + " frames");
+        return true;
+    }
+
+    void RTPipeline::fillTLASBuildInfo(uint32_t region, VkAccelerationStructureGeometryKHR& geo,
+                                       VkAccelerationStructureBuildGeometryInfoKHR& buildInfo) const {
+        geo = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR };
         geo.geometryType = VK_GEOMETRY_TYPE_INSTANCES_KHR;
         geo.geometry.instances.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_INSTANCES_DATA_KHR;
-        geo.geometry.instances.data.deviceAddress = getBufferDeviceAddress(mInstanceBuffer);
+        geo.geometry.instances.data.deviceAddress = mInstanceAddress + sizeof(VkAccelerationStructureInstanceKHR) * mTLASCapacity * region;
 
-        VkAccelerationStructureBuildGeometryInfoKHR buildInfo = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR };
+        buildInfo = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR };
         buildInfo.type          = VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR;
-        buildInfo.flags         = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR;
+        buildInfo.flags         = VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR | VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR;
         buildInfo.geometryCount = 1;
         buildInfo.pGeometries   = &geo;
+        buildInfo.dstAccelerationStructure  = mTopLevelAS;
+        buildInfo.scratchData.deviceAddress = mTLASScratchAddress;
+    }
 
-        VkAccelerationStructureBuildSizesInfoKHR sizes = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR };
-        pfnGetASBuildSizes(device, VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR, &buildInfo, &count, &sizes);
+    void RTPipeline::buildTLAS(const std::vector<RTObject>& objects) {
+        uint32_t count = (uint32_t)objects.size();
+        ensureTLASCapacity(count);
 
-        createBuffer(sizes.accelerationStructureSize, VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, mTLASBuffer, mTLASMemory);
+        mTLASObjects = objects;
+        mTLASInstances.assign(count, VkAccelerationStructureInstanceKHR{});
+        mTLASChangeSerial.assign(count, 0);
+        mTLASSerial++;
+        for (uint32_t i = 0; i < count; i++) writeTLASInstance(i);
 
-        VkAccelerationStructureCreateInfoKHR ci = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR };
-        ci.buffer = mTLASBuffer; ci.size = sizes.accelerationStructureSize; ci.type = VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR;
-        pfnCreateAS(device, &ci, nullptr, &mTopLevelAS);
+        // 인스턴스 수가 바뀌면 UPDATE 불가 -> 다음 recordTLASUpdate 에서 전체 빌드
+        mTLASNeedsBuild = true;
+
+        Ogre::LogManager::getSingleton().logMessage("[PRISM] TLAS set with " + std::to_string(count) + " instances.");
+    }
+
+    void RTPipeline::setInstanceTransform(uint32_t instanceIdx, const Ogre::Matrix4& transform) {
+        RTObject& obj = mTLASObjects[instanceIdx];
+        if (obj.transform == transform) return;
+        obj.transform = transform;
+        writeTLASInstance(instanceIdx);
+    }
+
+    void RTPipeline::setInstanceMask(uint32_t instanceIdx, uint32_t mask) {
+        RTObject& obj = mTLASObjects[instanceIdx];
+        if (obj.instanceMask == mask) return;
+        obj.instanceMask = mask;
+        writeTLASInstance(instanceIdx);
+    }
 
-        VkBuffer scratch; VkDeviceMemory scratchMem;
-        createBuffer(sizes.buildScratchSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, scratch, scratchMem);
+    void RTPipeline::setInstanceRenderMode(uint32_t instanceIdx, int mode) {
+        if (instanceIdx >= mMaterials.size()) return;
+        float& value = mMaterials[instanceIdx].pbrParams2[2];
+        if (value == float(mode)) return;
+        value = float(mode);
+        if (std::find(mDirtyMaterials.begin(), mDirtyMaterials.end(), instanceIdx) == mDirtyMaterials.end())
+            mDirtyMaterials.push_back(instanceIdx);
+    }
 
-        buildInfo.mode                     = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
-        buildInfo.dstAccelerationStructure = mTopLevelAS;
-        buildInfo.scratchData.deviceAddress = getBufferDeviceAddress(scratch);
+    void RTPipeline::recordMaterialUpdates(VkCommandBuffer cmd) {
+        if (mDirtyMaterials.empty() || mMaterialBuffer == VK_NULL_HANDLE || cmd == VK_NULL_HANDLE) return;
+
+        // 이전 프레임 셰이더 읽기가 끝난 뒤 덮어씀
+        VkMemoryBarrier before = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+        before.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        before.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        vkCmdPipelineBarrier(cmd,
+            VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0, 1, &before, 0, nullptr, 0, nullptr);
+
+        for (uint32_t idx : mDirtyMaterials) {
+            vkCmdUpdateBuffer(cmd, mMaterialBuffer, sizeof(InstanceMaterial) * idx, sizeof(InstanceMaterial), &mMaterials[idx]);
+        }
+        mDirtyMaterials.clear();
+
+        VkMemoryBarrier after = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+        after.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        after.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(cmd,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, 1, &after, 0, nullptr, 0, nullptr);
+    }
+
+    void RTPipeline::recordTLASUpdate(VkCommandBuffer cmd) {
+        if (mTopLevelAS == VK_NULL_HANDLE || mTLASObjects.empty() || cmd == VK_NULL_HANDLE) return;
+
+        // SceneNode 에 묶인 인스턴스는 derived transform 이 바뀐 것만 dirty
+        for (uint32_t i = 0; i < (uint32_t)mTLASObjects.size(); i++) {
+            if (Ogre::SceneNode* node = mTLASObjects[i].node)
+                setInstanceTransform(i, node->_getFullTransform());
+        }
+        if (!mTLASDirty && !mTLASNeedsBuild) return;
+
+        // 이번 프레임 영역에, 그 영역을 마지막으로 쓴 뒤 바뀐 인스턴스만 복사
+        uint32_t region = mRenderSystem->getVaoManager()->_getDynamicBufferCurrentFrameNoWait() % mTLASRegionCount;
+        VkAccelerationStructureInstanceKHR* dst = mInstanceMapped + size_t(mTLASCapacity) * region;
+        uint32_t copied = 0;
+        for (uint32_t i = 0; i < (uint32_t)mTLASInstances.size(); i++) {
+            if (mTLASChangeSerial[i] > mTLASRegionSerial[region]) { dst[i] = mTLASInstances[i]; copied++; }
+        }
+        mTLASRegionSerial[region] = mTLASSerial;
+        mTLASSerial++;
+
+        VkAccelerationStructureGeometryKHR geo;
+        VkAccelerationStructureBuildGeometryInfoKHR buildInfo;
+        fillTLASBuildInfo(region, geo, buildInfo);
+        if (mTLASNeedsBuild || mTLASUpdatesSinceBuild >= kTLASMaxUpdates) {
+            buildInfo.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+            mTLASUpdatesSinceBuild = 0;
+        }
+        else {
+            buildInfo.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR;
+            buildInfo.srcAccelerationStructure = mTopLevelAS;
+            mTLASUpdatesSinceBuild++;
+        }
 
-        VkAccelerationStructureBuildRangeInfoKHR range = { count, 0, 0, 0 };
+        // 이전 프레임의 TLAS 빌드/트레이스가 끝난 뒤 스크래치와 TLAS 를 다시 씀
+        // (인스턴스 버퍼의 호스트 쓰기는 submit 시점에 보임)
+        VkMemoryBarrier before = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+        before.srcAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR | VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
+        before.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+        vkCmdPipelineBarrier(cmd,
+            VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR | VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR,
+            VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+            0, 1, &before, 0, nullptr, 0, nullptr);
+
+        VkAccelerationStructureBuildRangeInfoKHR range = { (uint32_t)mTLASObjects.size(), 0, 0, 0 };
         const VkAccelerationStructureBuildRangeInfoKHR* pRange = &range;
-        VkCommandBuffer cmd = beginSingleTimeCommands();
         pfnCmdBuildAS(cmd, 1, &buildInfo, &pRange);
+
+        VkMemoryBarrier after = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+        after.srcAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+        after.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
+        vkCmdPipelineBarrier(cmd,
+            VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+            VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR,
+            0, 1, &after, 0, nullptr, 0, nullptr);
+
+        mTLASNeedsBuild = false;
+        mTLASDirty = false;
+        mLastTLASCopyCount = copied;
+    }
+
+    void RTPipeline::fillDeformableBuildInfo(const DeformableBlas& db, VkAccelerationStructureGeometryKHR& geo,
+                                             VkAccelerationStructureBuildGeometryInfoKHR& buildInfo) const {
+        geo = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR };
+        geo.geometryType = VK_GEOMETRY_TYPE_TRIANGLES_KHR;
+        geo.geometry.triangles.sType         = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_TRIANGLES_DATA_KHR;
+        geo.geometry.triangles.vertexFormat  = VK_FORMAT_R32G32B32_SFLOAT;
+        geo.geometry.triangles.vertexData.deviceAddress = db.vertexAddress;
+        geo.geometry.triangles.vertexStride  = db.vertexStride;
+        geo.geometry.triangles.maxVertex     = db.vertexCount - 1;
+        geo.geometry.triangles.indexType     = VK_INDEX_TYPE_UINT32;
+        geo.geometry.triangles.indexData.deviceAddress = db.indexAddress;
+
+        buildInfo = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR };
+        buildInfo.type          = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+        // 재빌드는 maxRefits 프레임에 한 번이므로 트레이스 품질 쪽을 우선
+        buildInfo.flags         = VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR | VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR;
+        buildInfo.geometryCount = 1;
+        buildInfo.pGeometries   = &geo;
+        buildInfo.dstAccelerationStructure = db.blas;
+        buildInfo.scratchData.deviceAddress = db.scratchAddress;
+    }
+
+    uint32_t RTPipeline::registerDeformableMesh(const std::string& meshKey, VkBuffer vertexBuffer, VkDeviceSize offset,
+                                                uint32_t vertexStride, uint32_t vertexCount,
+                                                const std::vector<uint32_t>& indices,
+                                                const DeformableBlasParams& params) {
+        auto it = mDeformableKeyToIndex.find(meshKey);
+        if (it != mDeformableKeyToIndex.end()) return it->second;
+
+        if (vertexBuffer == VK_NULL_HANDLE || vertexCount == 0 || indices.size() < 3 || indices.size() % 3 != 0) {
+            throw std::runtime_error("PRISM: Invalid deformable mesh!");
+        }
+        // R32G32B32_SFLOAT 정점은 4 바이트 정렬이 필요
+        if (vertexStride < 3 * sizeof(float) || vertexStride % sizeof(float) != 0 || offset % sizeof(float) != 0) {
+            throw std::runtime_error("PRISM: Deformable vertex stride/offset must be 4-byte aligned float3!");
+        }
+
+        uint32_t deformIdx = (uint32_t)mDeformableBLASes.size();
+        mDeformableBLASes.push_back(DeformableBlas{});
+        mDeformableKeyToIndex[meshKey] = deformIdx;
+        DeformableBlas& db = mDeformableBLASes.back();
+
+        VkDevice device = mDevice->mDevice;
+        db.params         = params;
+        db.vertexAddress  = getBufferDeviceAddress(vertexBuffer) + offset;
+        db.vertexStride   = vertexStride;
+        db.vertexCount    = vertexCount;
+        db.primitiveCount = (uint32_t)(indices.size() / 3);
+
+        // 인덱스는 위상이 바뀌지 않으므로 한 번만 업로드
+        VkDeviceSize indexSize = sizeof(uint32_t) * indices.size();
+        createPooledBuffer(indexSize,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            db.indexBuffer, db.indexMemory);
+        queueUpload(db.indexBuffer, indices.data(), indexSize);
+        db.indexAddress = getBufferDeviceAddress(db.indexBuffer);
+
+        VkAccelerationStructureGeometryKHR geo;
+        VkAccelerationStructureBuildGeometryInfoKHR buildInfo;
+        fillDeformableBuildInfo(db, geo, buildInfo);
+
+        VkAccelerationStructureBuildSizesInfoKHR sizes = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR };
+        pfnGetASBuildSizes(device, VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR, &buildInfo, &db.primitiveCount, &sizes);
+
+        createPooledBuffer(sizes.accelerationStructureSize, VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, db.blasBuffer, db.blasMemory);
+        db.key      = meshKey;
+        db.blasSize = sizes.accelerationStructureSize;
+
+        VkAccelerationStructureCreateInfoKHR ci = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR };
+        ci.buffer = db.blasBuffer; ci.size = sizes.accelerationStructureSize; ci.type = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+        pfnCreateAS(device, &ci, nullptr, &db.blas);
+
+        // 빌드와 refit 이 번갈아 같은 스크래치를 쓰므로 둘 중 큰 쪽
+        // 스크래치 주소는 minAccelerationStructureScratchOffsetAlignment 정렬 필요 (풀 오프셋이라 여유를 두고 올림)
+        createPooledBuffer(std::max(sizes.buildScratchSize, sizes.updateScratchSize) + mScratchAlignment, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, db.scratchBuffer, db.scratchMemory);
+        db.scratchAddress = (getBufferDeviceAddress(db.scratchBuffer) + mScratchAlignment - 1) / mScratchAlignment * mScratchAlignment;
+
+        // 초기 빌드 (TLAS 가 이 BLAS 의 경계를 읽기 전에 끝나 있어야 함 - 배치 안이면 flushUploadBatch 에서)
+        fillDeformableBuildInfo(db, geo, buildInfo);
+        buildInfo.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+        queueBLASBuild(geo, buildInfo, { db.primitiveCount, 0, 0, 0 }, 0);
+
+        VkAccelerationStructureDeviceAddressInfoKHR addrInfo = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR };
+        addrInfo.accelerationStructure = db.blas;
+        db.blasAddress = pfnGetASDeviceAddress(device, &addrInfo);
+
+        Ogre::LogManager::getSingleton().logMessage("[PRISM] Deformable BLAS queued: " + meshKey + " idx=" + std::to_string(deformIdx)
+            + " tris=" + std::to_string(db.primitiveCount));
+        return deformIdx;
+    }
+
+    void RTPipeline::updateDeformableBounds(uint32_t deformIdx, const Ogre::Vector3& minPos, const Ogre::Vector3& maxPos) {
+        DeformableBlas& db = mDeformableBLASes[deformIdx];
+        for (int a = 0; a < 3; a++) db.currentExtent[a] = maxPos[a] - minPos[a];
+        // 첫 보고는 기준값으로 사용
+        if (db.builtExtent[0] == 0.0f && db.builtExtent[1] == 0.0f && db.builtExtent[2] == 0.0f) {
+            for (int a = 0; a < 3; a++) db.builtExtent[a] = db.currentExtent[a];
+        }
+    }
+
+    void RTPipeline::recordDeformableUpdates(VkCommandBuffer cmd) {
+        if (mDeformableBLASes.empty() || cmd == VK_NULL_HANDLE) return;
+
+        // 재빌드 판단: refit 횟수, 또는 보고된 AABB 축 길이 변화
+        auto needsRebuild = [](const DeformableBlas& db) {
+            if (db.forceRebuild || db.refitsSinceBuild >= db.params.maxRefits) return true;
+            const float ratio = db.params.rebuildExtentRatio;
+            if (ratio <= 1.0f) return false;
+            for (int a = 0; a < 3; a++) {
+                const float built = db.builtExtent[a], cur = db.currentExtent[a];
+                if (built <= 0.0f) continue;
+                if (cur > built * ratio || cur * ratio < built) return true;
+            }
+            return false;
+        };
+
+        std::vector<VkAccelerationStructureGeometryKHR> geos;
+        std::vector<VkAccelerationStructureBuildGeometryInfoKHR> infos;
+        std::vector<VkAccelerationStructureBuildRangeInfoKHR> ranges;
+        geos.reserve(mDeformableBLASes.size());   // pGeometries 가 가리키므로 재할당 금지
+        infos.reserve(mDeformableBLASes.size());
+        ranges.reserve(mDeformableBLASes.size());
+
+        for (auto& db : mDeformableBLASes) {
+            if (!db.dirty) continue;
+            geos.emplace_back();
+            infos.emplace_back();
+            fillDeformableBuildInfo(db, geos.back(), infos.back());
+            infos.back().pGeometries = &geos.back();
+
+            if (needsRebuild(db)) {
+                infos.back().mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+                db.refitsSinceBuild = 0;
+                db.rebuildCount++;
+                for (int a = 0; a < 3; a++) db.builtExtent[a] = db.currentExtent[a];
+            }
+            else {
+                // refit: 같은 AS 를 제자리에서 갱신 (주소가 그대로라 TLAS 인스턴스 참조도 유효)
+                infos.back().mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR;
+                infos.back().srcAccelerationStructure = db.blas;
+                db.refitsSinceBuild++;
+            }
+            ranges.push_back({ db.primitiveCount, 0, 0, 0 });
+            db.dirty = false;
+            db.forceRebuild = false;
+        }
+        if (infos.empty()) return;
+
+        // 시뮬레이션 compute 쓰기 -> AS 빌드 입력 읽기, 이전 프레임 빌드의 스크래치/AS 쓰기 -> 이번 빌드
+        VkMemoryBarrier before = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+        before.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+        before.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+        vkCmdPipelineBarrier(cmd,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR | VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR,
+            VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+            0, 1, &before, 0, nullptr, 0, nullptr);
+
+        // 변형 BLAS 는 서로 독립이므로 한 번에 기록
+        std::vector<const VkAccelerationStructureBuildRangeInfoKHR*> pRanges(ranges.size());
+        for (size_t i = 0; i < ranges.size(); i++) pRanges[i] = &ranges[i];
+        pfnCmdBuildAS(cmd, (uint32_t)infos.size(), infos.data(), pRanges.data());
+
+        VkMemoryBarrier blasDone = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+        blasDone.srcAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+        blasDone.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
+        vkCmdPipelineBarrier(cmd,
+            VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+            VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR | VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR,
+            0, 1, &blasDone, 0, nullptr, 0, nullptr);
+
+        // 인스턴스 AABB 가 BLAS 경계에서 나오므로 TLAS 도 갱신 (recordTLASUpdate 에서 UPDATE)
+        mTLASDirty = true;
+    }
+
+    void RTPipeline::compactBLASes(const std::vector<uint32_t>& meshIndices, const std::vector<VkDeviceSize>& compactSizes) {
+        VkDevice device = mDevice->mDevice;
+
+        // 압축본을 만들고 복사 (한 번 제출). 원본은 복사가 끝난 뒤 해제
+        struct Pending { uint32_t meshIdx; VkAccelerationStructureKHR as; VkBuffer buffer; GpuAllocation alloc; VkDeviceSize size; };
+        std::vector<Pending> pending;
+        VkCommandBuffer cmd = VK_NULL_HANDLE;
+        for (size_t i = 0; i < meshIndices.size(); i++) {
+            MeshBlas& mb = mMeshBLASes[meshIndices[i]];
+            VkDeviceSize compactSize = compactSizes[i];
+            if (compactSize == 0 || compactSize >= mb.blasSize) continue;
+
+            Pending p{ meshIndices[i], VK_NULL_HANDLE, VK_NULL_HANDLE, {}, compactSize };
+            createPooledBuffer(compactSize, VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, p.buffer, p.alloc);
+            VkAccelerationStructureCreateInfoKHR ci = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR };
+            ci.buffer = p.buffer; ci.size = compactSize; ci.type = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+            pfnCreateAS(device, &ci, nullptr, &p.as);
+
+            if (cmd == VK_NULL_HANDLE) cmd = beginSingleTimeCommands();
+            VkCopyAccelerationStructureInfoKHR copy = { VK_STRUCTURE_TYPE_COPY_ACCELERATION_STRUCTURE_INFO_KHR };
+            copy.src  = mb.blas;
+            copy.dst  = p.as;
+            copy.mode = VK_COPY_ACCELERATION_STRUCTURE_MODE_COMPACT_KHR;
+            pfnCmdCopyAS(cmd, &copy);
+            pending.push_back(p);
+        }
+        if (cmd == VK_NULL_HANDLE) return;
+
+        VkMemoryBarrier copied = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+        copied.srcAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+        copied.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+            VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR | VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR,
+            0, 1, &copied, 0, nullptr, 0, nullptr);
         endSingleTimeCommands(cmd);
 
-        vkDestroyBuffer(device, scratch, nullptr);
-        vkFreeMemory(device, scratchMem, nullptr);
+        VkDeviceSize before = 0, after = 0;
+        for (auto& p : pending) {
+            MeshBlas& mb = mMeshBLASes[p.meshIdx];
+            before += mb.blasSize;
+            after  += p.size;
+            pfnDestroyAS(device, mb.blas, nullptr);
+            destroyPooledBuffer(mb.blasBuffer, mb.blasMemory);
+
+            mb.blas       = p.as;
+            mb.blasBuffer = p.buffer;
+            mb.blasMemory = p.alloc;
+            mb.blasSize   = p.size;
+            VkAccelerationStructureDeviceAddressInfoKHR addrInfo = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR };
+            addrInfo.accelerationStructure = mb.blas;
+            mb.blasAddress = pfnGetASDeviceAddress(device, &addrInfo);
+        }
+        Ogre::LogManager::getSingleton().logMessage("[PRISM] BLAS compaction: " + std::to_string(pending.size()) + " BLAS, "
+            + std::to_string(before / 1024) + " KB -> " + std::to_string(after / 1024) + " KB");
+    }
 
-        Ogre::LogManager::getSingleton().logMessage("[PRISM] TLAS built with " + std::to_string(count) + " instances.");
+    ASMemoryReport RTPipeline::getASMemoryReport() const {
+        ASMemoryReport report;
+        for (const auto& mb : mMeshBLASes) {
+            report.blases.push_back({ mb.key, mb.buildSize, mb.blasSize, false });
+            report.blasBuildBytes += mb.buildSize;
+            report.blasBytes      += mb.blasSize;
+        }
+        for (const auto& db : mDeformableBLASes) {
+            report.blases.push_back({ db.key, db.blasSize, db.blasSize, true });
+            report.blasBuildBytes += db.blasSize;
+            report.blasBytes      += db.blasSize;
+        }
+        report.tlasBytes         = mTLASSize;
+        report.poolUsedBytes     = mMemoryPool.getUsedBytes();
+        report.poolReservedBytes = mMemoryPool.getReservedBytes();
+        report.poolBlocks        = mMemoryPool.getBlockCount();
+        return report;
+    }
+
+    void RTPipeline::logASMemoryReport() const {
+        ASMemoryReport report = getASMemoryReport();
+        auto kb = [](VkDeviceSize b) { return std::to_string(b / 1024) + " KB"; };
+        Ogre::LogManager& log = Ogre::LogManager::getSingleton();
+        log.logMessage("[PRISM] ── AS memory report ──");
+        for (const auto& e : report.blases) {
+            log.logMessage("[PRISM]   " + e.key + (e.deformable ? " (deformable)" : "") + ": " + kb(e.bytes)
+                + (e.bytes < e.buildBytes ? " (built " + kb(e.buildBytes) + ")" : ""));
+        }
+        VkDeviceSize saved = report.blasBuildBytes - report.blasBytes;
+        log.logMessage("[PRISM]   BLAS total: " + kb(report.blasBytes) + " (uncompacted " + kb(report.blasBuildBytes)
+            + ", saved " + kb(saved) + ")");
+        log.logMessage("[PRISM]   TLAS: " + kb(report.tlasBytes) + ", total AS: " + kb(report.blasBytes + report.tlasBytes));
+        log.logMessage("[PRISM]   Pool: " + kb(report.poolUsedBytes) + " used / " + kb(report.poolReservedBytes)
+            + " reserved in " + std::to_string(report.poolBlocks) + " blocks");
     }
 
     void RTPipeline::createSBT() {
@@ -437,6 +1126,13 @@ namespace Prism {
         createImg(1280, 720, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, mStorageImage, mStorageImageView, mStorageImageMemory);
         createImg(1280, 720, VK_FORMAT_R32G32B32A32_SFLOAT, VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, mAccumImage, mAccumImageView, mAccumImageMemory);
         createImg(1280, 720, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT, mDummyDepthImage, mDummyDepthView, mDummyDepthMemory);
+        // 재투영 history: 매 프레임 accum / surface 를 복사해 두고 다음 프레임 raygen 이 읽음
+        createImg(1280, 720, VK_FORMAT_R32G32B32A32_SFLOAT, VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, mHistoryColorImage, mHistoryColorView, mHistoryColorMemory);
+        createImg(1280, 720, VK_FORMAT_R16G16B16A16_SFLOAT, VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, mSurfaceImage, mSurfaceView, mSurfaceMemory);
+        createImg(1280, 720, VK_FORMAT_R16G16B16A16_SFLOAT, VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, mHistorySurfaceImage, mHistorySurfaceView, mHistorySurfaceMemory);
+        // 적응형 샘플링: 휘도 모멘트는 accum 과 같은 가중치로 누적하므로 같은 32-bit 정밀도
+        createImg(1280, 720, VK_FORMAT_R32G32B32A32_SFLOAT, VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, mVarianceImage, mVarianceView, mVarianceMemory);
+        createImg(1280, 720, VK_FORMAT_R32G32B32A32_SFLOAT, VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, mHistoryVarianceImage, mHistoryVarianceView, mHistoryVarianceMemory);
 
         VkSamplerCreateInfo samplerInfo = { VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO };
         samplerInfo.magFilter = VK_FILTER_LINEAR; samplerInfo.minFilter = VK_FILTER_LINEAR;
@@ -456,6 +1152,11 @@ namespace Prism {
         barrier(mStorageImage,    VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL, 0, VK_ACCESS_SHADER_WRITE_BIT);
         barrier(mAccumImage,      VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL, 0, VK_ACCESS_SHADER_WRITE_BIT);
         barrier(mDummyDepthImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL, 0, VK_ACCESS_SHADER_READ_BIT);
+        barrier(mHistoryColorImage,   VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL, 0, VK_ACCESS_SHADER_READ_BIT);
+        barrier(mSurfaceImage,        VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL, 0, VK_ACCESS_SHADER_WRITE_BIT);
+        barrier(mHistorySurfaceImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL, 0, VK_ACCESS_SHADER_READ_BIT);
+        barrier(mVarianceImage,        VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL, 0, VK_ACCESS_SHADER_WRITE_BIT);
+        barrier(mHistoryVarianceImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL, 0, VK_ACCESS_SHADER_READ_BIT);
         endSingleTimeCommands(cmd);
     }
 
@@ -469,7 +1170,8 @@ namespace Prism {
             if (mMaterialBuffer == VK_NULL_HANDLE) {
                 // 여유 있게 최대 64개 슬롯 확보
                 VkDeviceSize allocSize = sizeof(InstanceMaterial) * std::max(materials.size(), (size_t)64);
-                createBuffer(allocSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                // TRANSFER_DST: 실행 중 렌더 모드 갱신 (recordMaterialUpdates)
+                createBuffer(allocSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                     mMaterialBuffer, mMaterialMemory);
             }
@@ -477,6 +1179,8 @@ namespace Prism {
             vkMapMemory(device, mMaterialMemory, 0, matSize, 0, &data);
             memcpy(data, materials.data(), matSize);
             vkUnmapMemory(device, mMaterialMemory);
+            mMaterials = materials;
+            mDirtyMaterials.clear();
         }
 
         // ObjDesc Buffer
@@ -495,18 +1199,61 @@ namespace Prism {
         }
     }
 
+    void RTPipeline::createLightBuffers(const LightSet& lightSet) {
+        VkDevice device = mDevice->mDevice;
+
+        // 빈 씬이어도 바인딩이 유효하도록 최소 1 개 슬롯
+        auto upload = [&](const void* src, VkDeviceSize size, VkDeviceSize allocSize, VkBuffer& buffer, VkDeviceMemory& memory) {
+            if (buffer != VK_NULL_HANDLE) {
+                vkDestroyBuffer(device, buffer, nullptr);
+                vkFreeMemory(device, memory, nullptr);
+            }
+            createBuffer(allocSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                buffer, memory);
+            void* data;
+            vkMapMemory(device, memory, 0, allocSize, 0, &data);
+            memset(data, 0, allocSize);
+            if (size > 0) memcpy(data, src, size);
+            vkUnmapMemory(device, memory);
+        };
+
+        mLightCount     = lightSet.lightCount();
+        mLightNodeCount = lightSet.nodeCount();
+        upload(lightSet.lights.data(), sizeof(GpuLightEntry) * mLightCount,
+               sizeof(GpuLightEntry) * std::max(mLightCount, 1u), mLightBuffer, mLightMemory);
+        upload(lightSet.nodes.data(), sizeof(GpuLightNode) * mLightNodeCount,
+               sizeof(GpuLightNode) * std::max(mLightNodeCount, 1u), mLightNodeBuffer, mLightNodeMemory);
+
+        Ogre::LogManager::getSingleton().logMessage(
+            "[PRISM] Lights: " + std::to_string(mLightCount) + " (" + std::to_string(mLightNodeCount)
+            + " BVH nodes, total power " + std::to_string(lightSet.totalPower) + ")");
+    }
+
     void RTPipeline::createDescriptorSet() {
         VkDevice device = mDevice->mDevice;
         if (mCameraUBOBuffer == VK_NULL_HANDLE)
             createBuffer(sizeof(CameraUBO), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                 mCameraUBOBuffer, mCameraUBOMemory);
+        if (mLightBuffer == VK_NULL_HANDLE) createLightBuffers(LightSet());   // 광원 없는 씬
+        if (mFrameStatsBuffer == VK_NULL_HANDLE) {
+            // 프레임마다 vkCmdFillBuffer 로 슬롯 하나를 비우고 raygen 이 atomicAdd. 호스트는 영구 매핑으로 읽기만 함
+            VkDeviceSize statsSize = sizeof(GpuFrameStats) * kFrameStatsSlots;
+            createBuffer(statsSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                mFrameStatsBuffer, mFrameStatsMemory);
+            void* data;
+            vkMapMemory(device, mFrameStatsMemory, 0, statsSize, 0, &data);
+            memset(data, 0, statsSize);
+            mFrameStatsMapped = static_cast<GpuFrameStats*>(data);
+        }
 
         std::vector<VkDescriptorPoolSize> poolSizes = {
             { VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, 1 },
-            { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 2 },
+            { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 7 },                 // binding1(output) + 6(accum) + 10,11,12(history) + 15,16(variance)
             { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1 },
-            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2 },
+            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 5 },                // binding3(material) + 4(objdesc) + 13,14(lights) + 17(frame stats)
             { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4 }  // binding5(depth) + 7,8,9(gbuffer)
         };
         VkDescriptorPoolCreateInfo pci = { VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
@@ -522,9 +1269,17 @@ namespace Prism {
         VkDescriptorImageInfo  imgInfo{}; imgInfo.imageView = mStorageImageView; imgInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
         VkDescriptorImageInfo  accInfo{}; accInfo.imageView = mAccumImageView;   accInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
         VkDescriptorImageInfo  depInfo{}; depInfo.imageView = mDummyDepthView;   depInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL; depInfo.sampler = mDummySampler;
+        VkDescriptorImageInfo  hcInfo{};  hcInfo.imageView  = mHistoryColorView;   hcInfo.imageLayout  = VK_IMAGE_LAYOUT_GENERAL;
+        VkDescriptorImageInfo  sfInfo{};  sfInfo.imageView  = mSurfaceView;        sfInfo.imageLayout  = VK_IMAGE_LAYOUT_GENERAL;
+        VkDescriptorImageInfo  hsInfo{};  hsInfo.imageView  = mHistorySurfaceView; hsInfo.imageLayout  = VK_IMAGE_LAYOUT_GENERAL;
+        VkDescriptorImageInfo  vaInfo{};  vaInfo.imageView  = mVarianceView;        vaInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+        VkDescriptorImageInfo  hvInfo{};  hvInfo.imageView  = mHistoryVarianceView; hvInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
         VkDescriptorBufferInfo uboInfo{}; uboInfo.buffer = mCameraUBOBuffer; uboInfo.offset = 0; uboInfo.range = sizeof(CameraUBO);
         VkDescriptorBufferInfo matInfo{}; matInfo.buffer = mMaterialBuffer;  matInfo.offset = 0; matInfo.range = VK_WHOLE_SIZE;
         VkDescriptorBufferInfo objInfo{}; objInfo.buffer = mObjDescBuffer;   objInfo.offset = 0; objInfo.range = VK_WHOLE_SIZE;
+        VkDescriptorBufferInfo litInfo{}; litInfo.buffer = mLightBuffer;     litInfo.offset = 0; litInfo.range = VK_WHOLE_SIZE;
+        VkDescriptorBufferInfo lbvInfo{}; lbvInfo.buffer = mLightNodeBuffer; lbvInfo.offset = 0; lbvInfo.range = VK_WHOLE_SIZE;
+        VkDescriptorBufferInfo stsInfo{}; stsInfo.buffer = mFrameStatsBuffer; stsInfo.offset = 0; stsInfo.range = VK_WHOLE_SIZE;
 
         std::vector<VkWriteDescriptorSet> writes;
         auto w = [&](uint32_t b, VkDescriptorType t) {
@@ -542,6 +1297,17 @@ namespace Prism {
         VkWriteDescriptorSet w7 = w(7, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);     w7.pImageInfo  = &depInfo; writes.push_back(w7);
         VkWriteDescriptorSet w8 = w(8, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);     w8.pImageInfo  = &depInfo; writes.push_back(w8);
         VkWriteDescriptorSet w9 = w(9, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);     w9.pImageInfo  = &depInfo; writes.push_back(w9);
+        // 바인딩 10,11,12: 재투영 history
+        VkWriteDescriptorSet w10 = w(10, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE);            w10.pImageInfo = &hcInfo;  writes.push_back(w10);
+        VkWriteDescriptorSet w11 = w(11, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE);            w11.pImageInfo = &sfInfo;  writes.push_back(w11);
+        VkWriteDescriptorSet w12 = w(12, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE);            w12.pImageInfo = &hsInfo;  writes.push_back(w12);
+        // 바인딩 13,14: 광원 + light BVH
+        VkWriteDescriptorSet w13 = w(13, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);           w13.pBufferInfo = &litInfo; writes.push_back(w13);
+        VkWriteDescriptorSet w14 = w(14, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);           w14.pBufferInfo = &lbvInfo; writes.push_back(w14);
+        // 바인딩 15,16,17: 적응형 샘플링 (variance + history variance) + 프레임 통계
+        VkWriteDescriptorSet w15 = w(15, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE);            w15.pImageInfo = &vaInfo;  writes.push_back(w15);
+        VkWriteDescriptorSet w16 = w(16, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE);            w16.pImageInfo = &hvInfo;  writes.push_back(w16);
+        VkWriteDescriptorSet w17 = w(17, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);           w17.pBufferInfo = &stsInfo; writes.push_back(w17);
 
         vkUpdateDescriptorSets(device, (uint32_t)writes.size(), writes.data(), 0, nullptr);
     }
@@ -587,7 +1353,7 @@ namespace Prism {
         Ogre::LogManager::getSingleton().logMessage("[PRISM] G-Buffer bound: bindings 7,8,9 updated");
     }
 
-    void RTPipeline::updateCameraUBO(const Ogre::Matrix4& view, const Ogre::Matrix4& proj, const Ogre::Vector3& camPos, int frameCount) {
+    void RTPipeline::updateCameraUBO(const Ogre::Matrix4& view, const Ogre::Matrix4& proj, const Ogre::Vector3& camPos, int frameCount, bool cameraMoved) {
         if (mCameraUBOBuffer == VK_NULL_HANDLE) createDescriptorSet();
 
         // [DEBUG] 첫 프레임에서만 proj[1][1] 부호 확인
@@ -600,12 +1366,54 @@ namespace Prism {
         ubo.cameraPos[0] = camPos.x; ubo.cameraPos[1] = camPos.y; ubo.cameraPos[2] = camPos.z;
         ubo.frameCount = frameCount;
 
-        // [PRISM] Cornell Box는 면광원(emissive)으로 조명 → GpuLight는 보조
-        ubo.lights[0].position[0] = 0.0f; ubo.lights[0].position[1] = 11.0f; ubo.lights[0].position[2] = 0.0f;
-        ubo.lights[0].intensity = 0.0f; // 면광원(emissive)이 주광원이므로 GpuLight는 꺼둠
-        ubo.lights[0].color[0] = 1.0f; ubo.lights[0].color[1] = 1.0f; ubo.lights[0].color[2] = 1.0f;
-        ubo.lights[0].enabled = 0;
-        ubo.lightCount = 0;
+        // 광원은 바인딩 13, 14 (createLightBuffers). NEE 는 lightCount 가 0 이면 생략
+        ubo.lightCount     = (int)mLightCount;
+        ubo.lightNodeCount = (int)mLightNodeCount;
+
+        // 재투영: 이전 프레임 view-projection 으로 이번 1st hit 을 투영해 history 픽셀을 찾음
+        // 움직이는 동안은 최근 32 프레임 정도만 섞어 반사/하이라이트 잔상을 억제하고, 멈추면 다시 무제한에 가깝게 누적
+        ubo.historyReset = mHistoryValid ? 0 : 1;
+        ubo.maxHistory   = cameraMoved ? 32.0f : 65536.0f;
+        Ogre::Matrix4 prevVP = mPrevViewProj.transpose();
+        memcpy(ubo.prevViewProj, &prevVP[0][0], 64);
+        ubo.prevCameraPos[0] = mPrevCameraPos.x; ubo.prevCameraPos[1] = mPrevCameraPos.y; ubo.prevCameraPos[2] = mPrevCameraPos.z;
+
+        // 적응형 샘플링: history 가 minSamples 만큼 쌓이면 휘도 분산으로 픽셀별 경로 수를 정함
+        // 움직이는 동안은 history 가 짧게 유지되므로 대부분 픽셀이 1 경로로 돌아감
+        ubo.adaptiveSampling   = mAdaptiveParams.enabled ? 1 : 0;
+        ubo.adaptiveMinSamples = std::max(mAdaptiveParams.minSamples, 1);
+        ubo.adaptiveMaxSamples = std::max(mAdaptiveParams.maxSamples, 1);
+        ubo.adaptiveThreshold  = mAdaptiveParams.threshold;
+
+        // 통계 링에서 가장 오래된 슬롯 (kFrameStatsSlots - 1 프레임 전, 이미 GPU 가 끝낸 프레임) 회수
+        if (mFrameStatsMapped) {
+            const GpuFrameStats& slot = mFrameStatsMapped[uint32_t(frameCount + 1) % kFrameStatsSlots];
+            mAdaptiveStats.convergedPixels = slot.convergedPixels;
+            mAdaptiveStats.pathsTraced     = slot.pathsTraced;
+            mAdaptiveStats.pixels          = mRTWidth * mRTHeight;
+            mPathStats.paths                = slot.pathsTraced;
+            mPathStats.segments             = slot.pathSegments;
+            mPathStats.rouletteTerminations = slot.rouletteTerminations;
+        }
+        if (mTimestampPool != VK_NULL_HANDLE) {
+            uint32_t slot = uint32_t(frameCount + 1) % kFrameStatsSlots;
+            uint64_t ticks[2];
+            if (mTimestampWritten[slot] &&
+                vkGetQueryPoolResults(mDevice->mDevice, mTimestampPool, slot * 2, 2, sizeof(ticks), ticks, sizeof(uint64_t),
+                                      VK_QUERY_RESULT_64_BIT) == VK_SUCCESS && ticks[1] > ticks[0]) {
+                mTraceTimeMs = float(double(ticks[1] - ticks[0]) * mTimestampPeriod * 1e-6);
+            }
+        }
+
+        // 경로 종료: G-Buffer 가 매끈/금속인 픽셀의 바운스 상한 + roulette (재질별 깊이는 closesthit 이 payload 로 넘김)
+        ubo.maxBounces       = std::max(mPathParams.maxBounces, 1);
+        ubo.russianRoulette  = mPathParams.russianRoulette ? 1 : 0;
+        ubo.rouletteMinDepth = std::max(mPathParams.rouletteMinDepth, 1);
+
+        mPrevViewProj  = proj * view;
+        mPrevCameraPos = camPos;
+        mHistoryValid  = true;
+        mFrameCount    = frameCount;
 
         void* data;
         vkMapMemory(mDevice->mDevice, mCameraUBOMemory, 0, sizeof(CameraUBO), 0, &data);
@@ -624,14 +1432,98 @@ namespace Prism {
 
     void RTPipeline::endSingleTimeCommands(VkCommandBuffer cmd) {
         vkEndCommandBuffer(cmd);
+        // 큐 전체(OGRE 가 넣은 프레임 작업 포함)가 아니라 이 제출만 기다림
+        VkFenceCreateInfo fi = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+        VkFence fence; vkCreateFence(mDevice->mDevice, &fi, nullptr, &fence);
         VkSubmitInfo s = { VK_STRUCTURE_TYPE_SUBMIT_INFO }; s.commandBufferCount = 1; s.pCommandBuffers = &cmd;
-        vkQueueSubmit(mDevice->mGraphicsQueue.mQueue, 1, &s, VK_NULL_HANDLE);
-        vkQueueWaitIdle(mDevice->mGraphicsQueue.mQueue);
+        vkQueueSubmit(mDevice->mGraphicsQueue.mQueue, 1, &s, fence);
+        vkWaitForFences(mDevice->mDevice, 1, &fence, VK_TRUE, UINT64_MAX);
+        vkDestroyFence(mDevice->mDevice, fence, nullptr);
         vkFreeCommandBuffers(mDevice->mDevice, mCommandPool, 1, &cmd);
     }
 
+    void RTPipeline::recordHistoryCopy(VkCommandBuffer cmd) {
+        if (mHistoryColorImage == VK_NULL_HANDLE) return;
+
+        // 모든 이미지는 GENERAL 그대로 복사 (레이아웃 전환 없이 접근 마스크만 동기화)
+        auto barrier = [](VkImage img, VkAccessFlags src, VkAccessFlags dst) {
+            VkImageMemoryBarrier b = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
+            b.oldLayout = VK_IMAGE_LAYOUT_GENERAL; b.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+            b.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED; b.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            b.srcAccessMask = src; b.dstAccessMask = dst;
+            b.image = img; b.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+            return b;
+        };
+
+        // raygen 쓰기(accum, surface, variance) / 읽기(history) 완료 → 복사
+        VkImageMemoryBarrier pre[6] = {
+            barrier(mAccumImage,           VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT),
+            barrier(mSurfaceImage,         VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT),
+            barrier(mVarianceImage,        VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT),
+            barrier(mHistoryColorImage,    VK_ACCESS_SHADER_READ_BIT,  VK_ACCESS_TRANSFER_WRITE_BIT),
+            barrier(mHistorySurfaceImage,  VK_ACCESS_SHADER_READ_BIT,  VK_ACCESS_TRANSFER_WRITE_BIT),
+            barrier(mHistoryVarianceImage, VK_ACCESS_SHADER_READ_BIT,  VK_ACCESS_TRANSFER_WRITE_BIT),
+        };
+        // wavefront 모드는 resolve (compute) 가 accum / variance 를 씀
+        const VkPipelineStageFlags shaderStages = VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+        vkCmdPipelineBarrier(cmd, shaderStages, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0, 0, nullptr, 0, nullptr, 6, pre);
+
+        VkImageCopy region{};
+        region.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+        region.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+        region.extent = { mRTWidth, mRTHeight, 1 };
+        vkCmdCopyImage(cmd, mAccumImage,   VK_IMAGE_LAYOUT_GENERAL, mHistoryColorImage,   VK_IMAGE_LAYOUT_GENERAL, 1, &region);
+        vkCmdCopyImage(cmd, mSurfaceImage, VK_IMAGE_LAYOUT_GENERAL, mHistorySurfaceImage, VK_IMAGE_LAYOUT_GENERAL, 1, &region);
+        vkCmdCopyImage(cmd, mVarianceImage, VK_IMAGE_LAYOUT_GENERAL, mHistoryVarianceImage, VK_IMAGE_LAYOUT_GENERAL, 1, &region);
+
+        // 다음 프레임 raygen 이 다시 쓰고 읽을 수 있도록
+        VkImageMemoryBarrier post[6] = {
+            barrier(mAccumImage,           VK_ACCESS_TRANSFER_READ_BIT,  VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT),
+            barrier(mSurfaceImage,         VK_ACCESS_TRANSFER_READ_BIT,  VK_ACCESS_SHADER_WRITE_BIT),
+            barrier(mVarianceImage,        VK_ACCESS_TRANSFER_READ_BIT,  VK_ACCESS_SHADER_WRITE_BIT),
+            barrier(mHistoryColorImage,    VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT),
+            barrier(mHistorySurfaceImage,  VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT),
+            barrier(mHistoryVarianceImage, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT),
+        };
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, shaderStages,
+            0, 0, nullptr, 0, nullptr, 6, post);
+    }
+
+    void RTPipeline::recordFrameStatsReset(VkCommandBuffer cmd) {
+        if (mFrameStatsBuffer == VK_NULL_HANDLE) return;
+        VkDeviceSize slotOffset = sizeof(GpuFrameStats) * (uint32_t(mFrameCount) % kFrameStatsSlots);
+        vkCmdFillBuffer(cmd, mFrameStatsBuffer, slotOffset, sizeof(GpuFrameStats), 0);
+        VkBufferMemoryBarrier bb = { VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER };
+        bb.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        bb.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        bb.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED; bb.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        bb.buffer = mFrameStatsBuffer; bb.offset = slotOffset; bb.size = sizeof(GpuFrameStats);
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, 0, nullptr, 1, &bb, 0, nullptr);
+    }
+
+    void RTPipeline::recordTraceTimerBegin(VkCommandBuffer cmd) {
+        if (mTimestampPool == VK_NULL_HANDLE) return;
+        uint32_t slot = uint32_t(mFrameCount) % kFrameStatsSlots;
+        vkCmdResetQueryPool(cmd, mTimestampPool, slot * 2, 2);
+        vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, mTimestampPool, slot * 2);
+    }
+
+    void RTPipeline::recordTraceTimerEnd(VkCommandBuffer cmd) {
+        if (mTimestampPool == VK_NULL_HANDLE) return;
+        uint32_t slot = uint32_t(mFrameCount) % kFrameStatsSlots;
+        vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, mTimestampPool, slot * 2 + 1);
+        mTimestampWritten[slot] = true;
+    }
+
     void RTPipeline::recordRayTracingCommands(VkCommandBuffer cmd, VkDescriptorSet ds, uint32_t w, uint32_t h) {
         if (mRTPipeline == VK_NULL_HANDLE) return;
+
+        // 이번 프레임 통계 슬롯 비우기 → raygen atomicAdd
+        recordFrameStatsReset(cmd);
+
         vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR, mRTPipeline);
         vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR, mPipelineLayout, 0, 1, &ds, 0, nullptr);
         auto f = (PFN_vkCmdTraceRaysKHR)vkGetDeviceProcAddr(mDevice->mDevice, "vkCmdTraceRaysKHR");
@@ -5,29 +5,69 @@
 #include <OgreVulkanDevice.h>
 #include <OgreVector3.h>
 #include <OgreMatrix4.h>
+#include "PrismAdaptiveParams.h"
+#include "PrismMemoryPool.h"
+#include "PrismPathParams.h"
+#include "PrismLights.h"  // LightSet (바인딩 13, 14)
+#include "PrismScene.h"   // InstanceMaterial
 #include <array>
+#include <deque>
 #include <unordered_map>
 #include <string>
 #include <vector>
 
 namespace Prism {
 
-    // [2_LSM 호환] raygenbsdf.rgen / closesthitbsdf.rchit 과 레이아웃 일치 (std140)
-    struct GpuLight {
-        float position[3];
-        float intensity;
-        float color[3];
-        int   enabled;
-    };
-
+    // raygenbsdf.rgen / closesthitbsdf.rchit 과 레이아웃 일치 (std140)
+    // 광원은 UBO 고정 배열 대신 바인딩 13(광원) / 14(light BVH) 스토리지 버퍼 (PrismLights.h)
     struct CameraUBO {
         float viewInverse[16];
         float projInverse[16];
-        float cameraPos[3];
-        int   frameCount;       // offset 144
-        GpuLight lights[3];     // offset 160 (Light struct size is 32)
-        int   lightCount;       // offset 256
-        float padding[3];       // offset 260
+        float cameraPos[3];     // offset 128
+        int   frameCount;       // offset 140 (RNG 시드용, 카메라가 움직여도 계속 증가)
+        int   lightCount;       // offset 144 (바인딩 13 의 광원 수, 0 이면 NEE 생략)
+        int   lightNodeCount;   // offset 148 (바인딩 14 의 BVH 노드 수)
+        int   historyReset;     // offset 152 (1 이면 재투영 없이 누적 재시작)
+        float maxHistory;       // offset 156 (history 길이 상한 → 누적 가중치 하한 1 / maxHistory)
+        float prevViewProj[16]; // offset 160 (이전 프레임 proj * view, 재투영용)
+        float prevCameraPos[3]; // offset 224 (이전 프레임 카메라 위치, disocclusion 깊이 비교용)
+        float padding;          // offset 236
+        int   adaptiveSampling;   // offset 240 (0 이면 픽셀당 항상 1 경로, PrismAdaptiveParams.h)
+        int   adaptiveMinSamples; // offset 244
+        int   adaptiveMaxSamples; // offset 248
+        float adaptiveThreshold;  // offset 252
+        int   maxBounces;         // offset 256 (경로 세그먼트 상한, PrismPathParams.h)
+        int   russianRoulette;    // offset 260
+        int   rouletteMinDepth;   // offset 264
+        int   padding4;           // offset 268
+    };
+
+    // raygenbsdf.rgen: layout(binding=17) buffer FrameStatsBuffer 의 슬롯 하나 (프레임마다 다음 슬롯)
+    struct GpuFrameStats {
+        uint32_t convergedPixels;       // 이번 프레임 경로 0 (refresh 제외) 픽셀 수
+        uint32_t pathsTraced;           // 이번 프레임 쏜 경로 수
+        uint32_t pathSegments;          // 경로 세그먼트 (1st hit + 바운스 광선, 그림자 광선 제외) 합
+        uint32_t rouletteTerminations;  // Russian roulette 로 끊긴 경로 수
+    };
+
+    // 적응형 샘플링 통계 (GPU 가 몇 프레임 전에 쓴 값)
+    struct AdaptiveStats {
+        uint32_t convergedPixels = 0;
+        uint32_t pathsTraced     = 0;
+        uint32_t pixels          = 0;
+
+        float convergedPercent() const { return pixels ? 100.0f * float(convergedPixels) / float(pixels) : 0.0f; }
+        float pathsPerPixel() const { return pixels ? float(pathsTraced) / float(pixels) : 0.0f; }
+    };
+
+    // 경로 길이 통계 (GPU 가 몇 프레임 전에 쓴 값)
+    struct PathStats {
+        uint32_t paths                = 0;
+        uint32_t segments             = 0;
+        uint32_t rouletteTerminations = 0;
+
+        float averageLength() const { return paths ? float(segments) / float(paths) : 0.0f; }
+        float roulettePercent() const { return paths ? 100.0f * float(rouletteTerminations) / float(paths) : 0.0f; }
     };
 
     // closesthitbsdf.rchit 에서 직접 읽는 정점 구조체 (8 floats = 32 bytes)
@@ -42,13 +82,8 @@ namespace Prism {
     struct ObjDesc {
         uint64_t vertexAddress;
         uint64_t indexAddress;
-    };
-
-    // closesthitbsdf.rchit: layout(binding=3) buffer InstanceMaterials
-    struct InstanceMaterial {
-        float albedo[4];     // rgb: 색상, a: 투명도
-        float pbrParams1[4]; // x: emissive강도, y: roughness, z: metallic, w: padding
-        float pbrParams2[4]; // x: specTrans, y: ior, z,w: padding
+        uint32_t vertexStride = sizeof(RTVertex) / sizeof(float);   // float 단위 (OGRE 정점 버퍼 공유 메시는 6)
+        uint32_t normalOffset = 4;                                   // float 단위 (공유 메시는 3)
     };
 
     struct RTObject {
@@ -57,20 +92,81 @@ namespace Prism {
         Ogre::Matrix4 transform;
         uint32_t customIndex;
         uint32_t instanceMask = 0xFF;  // shadow ray cull mask용: emissive light = 0x02, 나머지 = 0xFF
+        Ogre::SceneNode* node = nullptr;  // 있으면 recordTLASUpdate 가 매 프레임 _getFullTransform() 으로 transform 갱신
     };
 
-    // 메시 하나당 BLAS + Vertex/Index 버퍼
+    // 메시 하나당 BLAS + Vertex/Index 버퍼 (메모리는 GpuMemoryPool 조각)
     struct MeshBlas {
         VkBuffer       vertexBuffer = VK_NULL_HANDLE;
-        VkDeviceMemory vertexMemory = VK_NULL_HANDLE;
+        GpuAllocation  vertexMemory;
         VkBuffer       indexBuffer  = VK_NULL_HANDLE;
-        VkDeviceMemory indexMemory  = VK_NULL_HANDLE;
+        GpuAllocation  indexMemory;
         VkBuffer       blasBuffer   = VK_NULL_HANDLE;
-        VkDeviceMemory blasMemory   = VK_NULL_HANDLE;
+        GpuAllocation  blasMemory;
         VkAccelerationStructureKHR blas = VK_NULL_HANDLE;
         VkDeviceAddress blasAddress     = 0;
         VkDeviceAddress vertexAddress   = 0;
         VkDeviceAddress indexAddress    = 0;
+        std::string     key;
+        VkDeviceSize    buildSize       = 0;   // vkGetAccelerationStructureBuildSizesKHR 최악 크기
+        VkDeviceSize    blasSize        = 0;   // 현재 크기 (압축했으면 압축 후)
+        // true 면 정점 / 인덱스가 OGRE VAO 버퍼 안에 있음 (buildBLASShared). vertexBuffer / indexBuffer 는 비어 있고 해제하지 않음
+        bool            sharedGeometry  = false;
+        uint32_t        vertexStride    = sizeof(RTVertex) / sizeof(float);
+        uint32_t        normalOffset    = 4;
+    };
+
+    // AS 메모리 보고 (logASMemoryReport)
+    struct ASMemoryReport {
+        struct Entry {
+            std::string  key;
+            VkDeviceSize buildBytes = 0;
+            VkDeviceSize bytes      = 0;
+            bool         deformable = false;
+        };
+        std::vector<Entry> blases;
+        VkDeviceSize blasBuildBytes    = 0;   // 압축 전 합
+        VkDeviceSize blasBytes         = 0;   // 현재 합
+        VkDeviceSize tlasBytes         = 0;
+        VkDeviceSize poolUsedBytes     = 0;   // 정점/인덱스/BLAS/스크래치 포함 풀 전체
+        VkDeviceSize poolReservedBytes = 0;
+        uint32_t     poolBlocks        = 0;
+    };
+
+    // 변형 메시(소프트바디) BLAS 의 재빌드 기준
+    // refit 은 토폴로지를 그대로 두고 노드 AABB 만 다시 맞추므로 변형이 쌓일수록 노드가 겹쳐 트레이스가 느려짐
+    struct DeformableBlasParams {
+        uint32_t maxRefits          = 60;    // 이 횟수만큼 refit 하면 다음 프레임은 전체 빌드 (0 이면 매 프레임 빌드)
+        float    rebuildExtentRatio = 1.5f;  // updateDeformableBounds 로 받은 AABB 의 축 길이가 마지막 빌드 대비 이 배율 이상 늘거나 줄면 빌드
+    };
+
+    // 시뮬레이션이 매 프레임 정점을 갱신하는 메시의 BLAS (ALLOW_UPDATE)
+    // 정점 버퍼는 외부(시뮬레이션) 소유라 여기서 해제하지 않음. 인덱스/AS/스크래치 버퍼만 소유
+    struct DeformableBlas {
+        VkDeviceAddress vertexAddress   = 0;   // 외부 버퍼 주소 + offset
+        uint32_t        vertexStride    = 0;
+        uint32_t        vertexCount     = 0;
+        uint32_t        primitiveCount  = 0;
+        VkBuffer       indexBuffer      = VK_NULL_HANDLE;
+        GpuAllocation  indexMemory;
+        VkBuffer       blasBuffer       = VK_NULL_HANDLE;
+        GpuAllocation  blasMemory;
+        VkBuffer       scratchBuffer    = VK_NULL_HANDLE;   // max(build, update) 크기, 프레임마다 재사용
+        GpuAllocation  scratchMemory;
+        VkAccelerationStructureKHR blas = VK_NULL_HANDLE;
+        VkDeviceAddress blasAddress     = 0;
+        VkDeviceAddress indexAddress    = 0;
+        VkDeviceAddress scratchAddress  = 0;
+        std::string     key;
+        VkDeviceSize    blasSize        = 0;   // refit 하려면 ALLOW_UPDATE 원본이 필요하므로 압축하지 않음
+
+        DeformableBlasParams params;
+        float    builtExtent[3]   = { 0.0f, 0.0f, 0.0f };   // 마지막 빌드 시점 AABB 축 길이 (updateDeformableBounds 를 안 쓰면 0)
+        float    currentExtent[3] = { 0.0f, 0.0f, 0.0f };
+        uint32_t refitsSinceBuild = 0;
+        uint32_t rebuildCount     = 0;
+        bool     dirty            = false;  // 이번 프레임 정점이 바뀜
+        bool     forceRebuild     = false;
     };
 
     class RTPipeline {
@@ -81,15 +177,71 @@ namespace Prism {
         void initialize();
         void cleanup();
 
+        // 업로드 배치: begin ~ flush 사이의 스테이징 복사와 BLAS 빌드를 커맨드 버퍼 하나에 모아 한 번 제출, 펜스 한 번 대기
+        // 배치 밖에서 부른 buildBLAS / registerDeformableMesh 는 각자 바로 제출 (펜스 대기)
+        // 배치 안에서 만든 BLAS 는 flush 전까지 빌드되지 않았으므로 TLAS 빌드(recordTLASUpdate) 전에 flush 필요
+        void beginUploadBatch();
+        void flushUploadBatch();
+
+        // BLAS 압축 (기본 켬): ALLOW_COMPACTION 으로 빌드하고 flushUploadBatch 에서 압축 크기를 질의해
+        // 딱 맞는 풀 조각으로 복사(COMPACT) 후 원본 해제. BLAS 주소가 바뀌므로 RTObject::blasAddress 는 flush 뒤에 읽을 것
+        // 변형 메시는 압축하지 않음
+        void setBLASCompaction(bool enable) { mCompactBLAS = enable; }
+        ASMemoryReport getASMemoryReport() const;
+        void logASMemoryReport() const;
+
         // Acceleration Structure Management
-        // meshKey로 캐시 확인 후 재사용, 반환값은 mMeshBLASes 인덱스
+        // meshKey로 캐시 확인 후 재사용, 반환값은 mMeshBLASes 인덱스 (BLAS 주소는 바로 유효, 내용은 flush 뒤)
         uint32_t buildBLAS(Ogre::MeshPtr mesh, const std::string& meshKey);
+        // 정점 / 인덱스를 직접 받는 버전 (OGRE 버퍼를 다시 읽지 않음. 매핑한 메시 캐시를 그대로 넘길 때)
+        // vertices: 정점마다 vertexStride 개 float, 위치 xyz 다음에 법선 xyz. 포인터는 호출 동안만 유효하면 됨
+        uint32_t buildBLAS(const std::string& meshKey, const float* vertices, uint32_t vertexStride,
+                           size_t vertexCount, const uint32_t* indices, size_t indexCount);
+        // 복사 없이 OGRE VAO 의 정점 / 인덱스 버퍼를 그대로 BLAS 입력과 ObjDesc 주소로 씀 (메시 메모리 / 업로드 한 번)
+        // 정점 배치가 (float3 위치, float3 법선, ...) 이고 32 비트 인덱스, BT_IMMUTABLE / BT_DEFAULT 여야 함. 아니면 buildBLAS(mesh) 로 복사
+        uint32_t buildBLASShared(Ogre::MeshPtr mesh, const std::string& meshKey);
+        // closesthitbsdf.rchit 의 ObjDesc (주소 + 정점 배치)
+        ObjDesc getMeshObjDesc(uint32_t meshIdx) const;
+        // TLAS 인스턴스 목록 설정. 인덱스 = objects 순서 (instanceCustomIndex)
+        // TLAS 는 한 번 만든 뒤 유지하고, 용량(예약 인스턴스 수)을 넘을 때만 다시 만듦. 실제 빌드는 다음 recordTLASUpdate 에서
         void buildTLAS(const std::vector<RTObject>& objects);
+        // 인스턴스 단위 갱신 (값이 같으면 무시). 바뀐 인스턴스만 다음 recordTLASUpdate 에서 인스턴스 버퍼로 복사
+        void setInstanceTransform(uint32_t instanceIdx, const Ogre::Matrix4& transform);
+        void setInstanceMask(uint32_t instanceIdx, uint32_t mask);
+        // 프레임 커맨드 버퍼에 TLAS UPDATE 기록 (인스턴스 수가 바뀌었거나 kTLASMaxUpdates 회 갱신했으면 BUILD)
+        // SceneNode 에 묶인 인스턴스의 transform 확인도 여기서 함. 바뀐 것이 없으면 아무것도 기록 안 함
+        void recordTLASUpdate(VkCommandBuffer cmdBuf);
+
+        // 인스턴스 렌더 모드 (InstanceMaterial.pbrParams2.z) 갱신. 값이 같으면 무시, 실제 복사는 다음 recordMaterialUpdates
+        void setInstanceRenderMode(uint32_t instanceIdx, int mode);
+        // 바뀐 재질만 vkCmdUpdateBuffer 로 바인딩 3 에 기록 (이전 프레임이 읽는 중인 버퍼를 호스트가 덮어쓰지 않도록)
+        // recordTLASUpdate 뒤, trace 전에 호출
+        void recordMaterialUpdates(VkCommandBuffer cmdBuf);
+
+        // 변형 메시 등록: 정점 위치를 시뮬레이션 storage buffer 에서 바로 읽는 BLAS (ALLOW_UPDATE), 반환값은 mDeformableBLASes 인덱스
+        // vertexBuffer 는 SHADER_DEVICE_ADDRESS + ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY 용도로 만든 버퍼,
+        // 첫 float3 가 위치. stride 가 sizeof(RTVertex) 이면 closesthitbsdf.rchit 가 같은 주소로 법선까지 읽을 수 있음
+        // 등록 시점(배치 안이면 flushUploadBatch 시점)에 초기 위치가 들어 있어야 함
+        uint32_t registerDeformableMesh(const std::string& meshKey, VkBuffer vertexBuffer, VkDeviceSize offset,
+                                        uint32_t vertexStride, uint32_t vertexCount,
+                                        const std::vector<uint32_t>& indices,
+                                        const DeformableBlasParams& params = {});
+        // 이번 프레임에 정점이 바뀌었음을 표시 (다음 recordDeformableUpdates 에서 refit)
+        void markDeformableDirty(uint32_t deformIdx) { mDeformableBLASes[deformIdx].dirty = true; }
+        // 위상이 크게 바뀐 경우 (텔레포트, 리셋 등) 다음 갱신을 전체 빌드로
+        void requestDeformableRebuild(uint32_t deformIdx) { mDeformableBLASes[deformIdx].dirty = mDeformableBLASes[deformIdx].forceRebuild = true; }
+        // 선택: CPU 가 알고 있는 현재 AABB 를 넘기면 rebuildExtentRatio 기준으로 재빌드 판단
+        void updateDeformableBounds(uint32_t deformIdx, const Ogre::Vector3& minPos, const Ogre::Vector3& maxPos);
+        // 프레임 커맨드 버퍼에 dirty 인 변형 BLAS 의 UPDATE(refit) 또는 BUILD 를 기록하고 TLAS 를 dirty 로 표시
+        // 시뮬레이션 compute 디스패치 뒤, recordTLASUpdate 전에 호출
+        void recordDeformableUpdates(VkCommandBuffer cmdBuf);
 
         // RT Execution
         void recordRayTracingCommands(VkCommandBuffer cmdBuf,
                                     VkDescriptorSet descriptorSet,
                                     uint32_t width, uint32_t height);
+        // 이번 프레임 통계 슬롯 (바인딩 17) 비우기. recordRayTracingCommands 가 부르고, wavefront 모드는 WavefrontTracer 가 부름
+        void recordFrameStatsReset(VkCommandBuffer cmdBuf);
 
         // Getters
         VkAccelerationStructureKHR getTLAS() const { return mTopLevelAS; }
@@ -97,21 +249,64 @@ namespace Prism {
         VkDeviceAddress getBLASAddress(uint32_t meshIdx) const { return mMeshBLASes[meshIdx].blasAddress; }
         VkDeviceAddress getMeshVertexAddress(uint32_t meshIdx) const { return mMeshBLASes[meshIdx].vertexAddress; }
         VkDeviceAddress getMeshIndexAddress(uint32_t meshIdx) const { return mMeshBLASes[meshIdx].indexAddress; }
+        VkDeviceAddress getDeformableBLASAddress(uint32_t deformIdx) const { return mDeformableBLASes[deformIdx].blasAddress; }
+        VkDeviceAddress getDeformableVertexAddress(uint32_t deformIdx) const { return mDeformableBLASes[deformIdx].vertexAddress; }
+        VkDeviceAddress getDeformableIndexAddress(uint32_t deformIdx) const { return mDeformableBLASes[deformIdx].indexAddress; }
+        uint32_t getDeformableRebuildCount(uint32_t deformIdx) const { return mDeformableBLASes[deformIdx].rebuildCount; }
+        uint32_t getTLASCapacity() const { return mTLASCapacity; }
+        uint32_t getLastTLASCopyCount() const { return mLastTLASCopyCount; }
         VkDescriptorSet getDescriptorSet() const { return mDescriptorSet; }
         VkPipelineLayout getPipelineLayout() const { return mPipelineLayout; }
+        // set 0 레이아웃 (wavefront 파이프라인이 같은 descriptor set 을 set 0 으로 씀)
+        VkDescriptorSetLayout getDescriptorSetLayout() const { return mDescriptorSetLayout; }
         VkImage getStorageImage() const { return mStorageImage; }
+        Ogre::VulkanDevice* getDevice() const { return mDevice; }
+        // 디노이저 입력 / 출력 (모두 GENERAL 레이아웃 유지)
+        VkImageView getStorageImageView() const { return mStorageImageView; }
+        VkImageView getAccumImageView() const { return mAccumImageView; }
+        VkImageView getSurfaceImageView() const { return mSurfaceView; }
         uint32_t getRTWidth() const { return mRTWidth; }
         uint32_t getRTHeight() const { return mRTHeight; }
 
         // 매 프레임 카메라 UBO 업데이트
+        // 이전 프레임 view-projection 을 같이 넘겨 raygen 이 accumImage history 를 재투영하게 함
+        // cameraMoved 이면 history 길이 상한을 낮춰 시점 의존 셰이딩(반사 등)의 잔상을 줄임
         void updateCameraUBO(const Ogre::Matrix4& view, const Ogre::Matrix4& proj,
-                             const Ogre::Vector3& camPos, int frameCount);
+                             const Ogre::Vector3& camPos, int frameCount, bool cameraMoved);
+        // 다음 프레임은 재투영 없이 누적을 새로 시작 (씬이 통째로 바뀌었을 때 등)
+        void resetHistory() { mHistoryValid = false; }
+
+        // 적응형 샘플링: 휘도 분산으로 픽셀별 경로 수 (0 ~ maxSamples) 를 정함. 다음 updateCameraUBO 부터 반영
+        void setAdaptiveSampling(const AdaptiveSamplingParams& params) { mAdaptiveParams = params; }
+        const AdaptiveSamplingParams& getAdaptiveSampling() const { return mAdaptiveParams; }
+        // 마지막으로 회수한 프레임 통계 (kFrameStatsSlots - 1 프레임 전)
+        const AdaptiveStats& getAdaptiveStats() const { return mAdaptiveStats; }
+
+        // 경로 종료 규칙 (바운스 상한, Russian roulette). 재질별 깊이는 InstanceMaterial.pbrParams1.w
+        void setPathTermination(const PathTerminationParams& params) { mPathParams = params; }
+        const PathTerminationParams& getPathTermination() const { return mPathParams; }
+        const PathStats& getPathStats() const { return mPathStats; }
+        // 마지막 updateCameraUBO 의 frameCount (통계 링 슬롯 = frameCount % 4)
+        int getFrameCount() const { return mFrameCount; }
+
+        // trace 단계 GPU 시간 (타임스탬프 쿼리, 통계 링과 같은 슬롯). trace 직전 / 직후에 호출
+        void recordTraceTimerBegin(VkCommandBuffer cmdBuf);
+        void recordTraceTimerEnd(VkCommandBuffer cmdBuf);
+        // 마지막으로 회수한 trace 시간 (ms, kFrameStatsSlots - 1 프레임 전). 타임스탬프를 못 쓰거나 아직 없으면 0
+        float getTraceTimeMs() const { return mTraceTimeMs; }
+
+        // traceRays 뒤에 호출: accumImage / surface / variance 이미지를 history 이미지로 복사 (다음 프레임 재투영 입력)
+        void recordHistoryCopy(VkCommandBuffer cmdBuf);
 
         // 씬 버퍼 생성 (buildTLAS 이후 호출)
         void createSceneBuffers(const std::vector<InstanceMaterial>& materials,
                                 const std::vector<ObjDesc>& objDescs);
 
-        // Descriptor Set 구성 (createSceneBuffers 이후 호출)
+        // 광원 목록 + light BVH 업로드 (createSceneBuffers 이후, createDescriptorSet 이전)
+        // 광원이 없어도 빈 버퍼를 만들어 바인딩 13, 14 를 채움
+        void createLightBuffers(const LightSet& lightSet);
+
+        // Descriptor Set 구성 (createSceneBuffers / createLightBuffers 이후 호출)
         void createDescriptorSet();
 
         // G-Buffer 텍스처 연동 (addWorkspace 이후 호출)
@@ -131,6 +326,29 @@ namespace Prism {
 
         VkCommandPool mCommandPool = VK_NULL_HANDLE;
 
+        // 메시 단위 버퍼(정점/인덱스/BLAS/스테이징/스크래치) 서브할당. 압축으로 비운 자리는 다음 BLAS 가 재사용
+        GpuMemoryPool mMemoryPool;
+        VkDeviceSize  mScratchAlignment = 256;
+        bool          mCompactBLAS = true;
+
+        struct StagingBuffer {
+            VkBuffer      buffer = VK_NULL_HANDLE;
+            GpuAllocation alloc;
+        };
+        struct UploadBatch {
+            VkCommandBuffer cmd  = VK_NULL_HANDLE;
+            bool            open = false;
+            std::vector<StagingBuffer> staging;                             // 제출 완료 후 해제
+            std::deque<VkAccelerationStructureGeometryKHR> geometries;      // builds[i].pGeometries 가 가리킴
+            std::vector<VkAccelerationStructureBuildGeometryInfoKHR> builds;
+            std::vector<VkAccelerationStructureBuildRangeInfoKHR> ranges;
+            std::vector<VkDeviceSize> scratchSizes;
+            std::vector<uint32_t> compactMeshes;                            // 빌드 뒤 압축할 mMeshBLASes 인덱스
+            VkDeviceSize uploadBytes = 0;
+            bool waitForOgreUploads = false;                                // buildBLASShared 가 OGRE 업로드에 의존
+        };
+        UploadBatch mBatch;
+
         VkPipeline mRTPipeline = VK_NULL_HANDLE;
         VkPipelineLayout mPipelineLayout = VK_NULL_HANDLE;
 
@@ -138,12 +356,36 @@ namespace Prism {
         std::unordered_map<std::string, uint32_t> mMeshKeyToIndex;
         std::vector<MeshBlas> mMeshBLASes;
 
+        // 변형 메시 BLAS
+        std::unordered_map<std::string, uint32_t> mDeformableKeyToIndex;
+        std::vector<DeformableBlas> mDeformableBLASes;
+
         // TLAS
         VkAccelerationStructureKHR mTopLevelAS = VK_NULL_HANDLE;
         VkBuffer mTLASBuffer = VK_NULL_HANDLE;
         VkDeviceMemory mTLASMemory = VK_NULL_HANDLE;
         VkBuffer mInstanceBuffer = VK_NULL_HANDLE;
         VkDeviceMemory mInstanceMemory = VK_NULL_HANDLE;
+        VkAccelerationStructureInstanceKHR* mInstanceMapped = nullptr;   // 영구 매핑, 프레임 영역 mTLASRegionCount 개
+        VkDeviceAddress mInstanceAddress = 0;
+        VkDeviceSize mTLASSize = 0;
+        VkBuffer mTLASScratchBuffer = VK_NULL_HANDLE;                    // max(build, update) 크기
+        VkDeviceMemory mTLASScratchMemory = VK_NULL_HANDLE;
+        VkDeviceAddress mTLASScratchAddress = 0;
+        uint32_t mTLASCapacity = 0;
+        uint32_t mTLASRegionCount = 1;
+
+        // 인스턴스 dirty 추적: 바뀔 때마다 mTLASSerial 을 기록하고, 프레임 영역별로 마지막으로 복사한 serial 과 비교
+        static constexpr uint32_t kTLASMaxUpdates = 120;   // UPDATE 가 이만큼 쌓이면 BUILD 로 트리 품질 회복
+        std::vector<RTObject> mTLASObjects;
+        std::vector<VkAccelerationStructureInstanceKHR> mTLASInstances;
+        std::vector<uint64_t> mTLASChangeSerial;
+        std::vector<uint64_t> mTLASRegionSerial;
+        uint64_t mTLASSerial = 0;
+        uint32_t mTLASUpdatesSinceBuild = 0;
+        uint32_t mLastTLASCopyCount = 0;
+        bool mTLASNeedsBuild = false;
+        bool mTLASDirty = false;
 
         // Camera UBO (Binding 2)
         VkBuffer       mCameraUBOBuffer = VK_NULL_HANDLE;
@@ -157,6 +399,16 @@ namespace Prism {
         // Material Buffer (Binding 3)
         VkBuffer       mMaterialBuffer = VK_NULL_HANDLE;
         VkDeviceMemory mMaterialMemory = VK_NULL_HANDLE;
+        std::vector<InstanceMaterial> mMaterials;       // CPU 사본 (setInstanceRenderMode)
+        std::vector<uint32_t>         mDirtyMaterials;
+
+        // Light Buffer (Binding 13) / Light BVH (Binding 14)
+        VkBuffer       mLightBuffer     = VK_NULL_HANDLE;
+        VkDeviceMemory mLightMemory     = VK_NULL_HANDLE;
+        VkBuffer       mLightNodeBuffer = VK_NULL_HANDLE;
+        VkDeviceMemory mLightNodeMemory = VK_NULL_HANDLE;
+        uint32_t       mLightCount      = 0;
+        uint32_t       mLightNodeCount  = 0;
 
         // Descriptor
         VkDescriptorPool mDescriptorPool = VK_NULL_HANDLE;
@@ -185,6 +437,51 @@ namespace Prism {
         VkDeviceMemory mAccumImageMemory = VK_NULL_HANDLE;
         VkImageView    mAccumImageView = VK_NULL_HANDLE;
 
+        // Temporal reprojection
+        // 10: 이전 프레임 accumImage (rgb: 누적 radiance, a: history 길이)
+        // 11: 이번 프레임 1st hit surface (xyz: world normal, w: 카메라~히트 거리, 하늘이면 -1)
+        // 12: 이전 프레임 surface
+        VkImage        mHistoryColorImage = VK_NULL_HANDLE;
+        VkDeviceMemory mHistoryColorMemory = VK_NULL_HANDLE;
+        VkImageView    mHistoryColorView = VK_NULL_HANDLE;
+        VkImage        mSurfaceImage = VK_NULL_HANDLE;
+        VkDeviceMemory mSurfaceMemory = VK_NULL_HANDLE;
+        VkImageView    mSurfaceView = VK_NULL_HANDLE;
+        VkImage        mHistorySurfaceImage = VK_NULL_HANDLE;
+        VkDeviceMemory mHistorySurfaceMemory = VK_NULL_HANDLE;
+        VkImageView    mHistorySurfaceView = VK_NULL_HANDLE;
+
+        // Adaptive sampling
+        // 15: 이번 프레임 휘도 모멘트 (r: E[L], g: E[L²], b: 이번 프레임 경로 수 = 샘플 수 맵, a: 수렴이면 1)
+        // 16: 이전 프레임 variance 이미지 (accumImage 와 같이 재투영)
+        // 17: 프레임 통계 버퍼 (GpuFrameStats 링. 프레임 n 은 슬롯 n % kFrameStatsSlots 에 쓰고, 호스트는 가장 오래된 슬롯을 읽음)
+        VkImage        mVarianceImage = VK_NULL_HANDLE;
+        VkDeviceMemory mVarianceMemory = VK_NULL_HANDLE;
+        VkImageView    mVarianceView = VK_NULL_HANDLE;
+        VkImage        mHistoryVarianceImage = VK_NULL_HANDLE;
+        VkDeviceMemory mHistoryVarianceMemory = VK_NULL_HANDLE;
+        VkImageView    mHistoryVarianceView = VK_NULL_HANDLE;
+
+        static constexpr uint32_t kFrameStatsSlots = 4;
+        VkBuffer          mFrameStatsBuffer = VK_NULL_HANDLE;
+        VkDeviceMemory    mFrameStatsMemory = VK_NULL_HANDLE;
+        GpuFrameStats* mFrameStatsMapped = nullptr;   // 영구 매핑 (HOST_COHERENT)
+        AdaptiveSamplingParams mAdaptiveParams;
+        AdaptiveStats          mAdaptiveStats;
+        PathTerminationParams  mPathParams;
+        PathStats              mPathStats;
+        int                    mFrameCount = 0;             // 마지막 updateCameraUBO 의 frameCount (통계 슬롯 선택)
+
+        // trace 타임스탬프: 슬롯마다 (begin, end) 2 개. 슬롯을 쓴 프레임에만 회수
+        VkQueryPool mTimestampPool = VK_NULL_HANDLE;
+        float       mTimestampPeriod = 0.0f;                // ns / tick
+        bool        mTimestampWritten[kFrameStatsSlots] = {};
+        float       mTraceTimeMs = 0.0f;
+
+        bool          mHistoryValid = false;    // false 면 다음 UBO 에 historyReset = 1
+        Ogre::Matrix4 mPrevViewProj = Ogre::Matrix4::IDENTITY;
+        Ogre::Vector3 mPrevCameraPos = Ogre::Vector3::ZERO;
+
         uint32_t mRTWidth = 1280;
         uint32_t mRTHeight = 720;
 
@@ -200,11 +497,39 @@ namespace Prism {
         void createSBT();
         void createRTImages();
 
+        // TLAS 버퍼/AS 를 count 이상으로 확보. 다시 만들었으면 true
+        bool ensureTLASCapacity(uint32_t count);
+        void writeTLASInstance(uint32_t instanceIdx);
+        void fillTLASBuildInfo(uint32_t region, VkAccelerationStructureGeometryKHR& geo,
+                               VkAccelerationStructureBuildGeometryInfoKHR& buildInfo) const;
+
+        // 변형 BLAS 의 geometry / build info (빌드와 refit 이 같은 입력을 써야 하므로 한 곳에서 채움)
+        void fillDeformableBuildInfo(const DeformableBlas& db, VkAccelerationStructureGeometryKHR& geo,
+                                     VkAccelerationStructureBuildGeometryInfoKHR& buildInfo) const;
+
         // Single-time command helpers
         VkCommandBuffer beginSingleTimeCommands();
         void endSingleTimeCommands(VkCommandBuffer cmdBuf);
 
+        // 배치에 스테이징 복사 / BLAS 빌드 추가 (배치가 없으면 하나 열어 바로 flush)
+        // scratchSize 가 0 이면 buildInfo.scratchData 를 그대로 사용
+        void queueUpload(VkBuffer dst, const void* src, VkDeviceSize size);
+        // 배치 안에서만: 스테이징을 잡아 dst 로의 복사를 기록하고 스테이징 포인터를 돌려줌 (호출자가 바로 채움)
+        void* queueUploadSpace(VkBuffer dst, VkDeviceSize size);
+        // mMeshBLASes[meshIdx] 의 vertexAddress / indexAddress 로 BLAS 를 만들어 배치에 빌드 추가
+        void queueMeshBLAS(uint32_t meshIdx, VkDeviceSize vertexStrideBytes, size_t vertexCount, size_t indexCount);
+        void queueBLASBuild(const VkAccelerationStructureGeometryKHR& geo,
+                            const VkAccelerationStructureBuildGeometryInfoKHR& buildInfo,
+                            const VkAccelerationStructureBuildRangeInfoKHR& range,
+                            VkDeviceSize scratchSize);
+
+        // 압축 크기(compactSizes[i], meshIndices[i] 순)로 BLAS 를 복사해 교체
+        void compactBLASes(const std::vector<uint32_t>& meshIndices, const std::vector<VkDeviceSize>& compactSizes);
+
         // Buffer utility
+        void createPooledBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties,
+                                VkBuffer& buffer, GpuAllocation& alloc);
+        void destroyPooledBuffer(VkBuffer& buffer, GpuAllocation& alloc);
         void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage,
                          VkMemoryPropertyFlags properties, VkBuffer& buffer,
                          VkDeviceMemory& bufferMemory);
@@ -0,0 +1,206 @@
+#include "PrismRenderModeScheduler.h"
+#include "PrismPathParams.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Prism {
+
+    namespace {
+
+        // 이동 평균 가중치 (GPU 시간 / 보정값)
+        const float kTimeSmoothing  = 0.1f;
+        const float kCalibSmoothing = 0.3f;
+        // 보정값이 아직 없을 때 (백만 광선당 ms, 보급형 RT GPU 대략값)
+        const float kDefaultMsPerMRay = 4.0f;
+
+        bool isGlossy(const SceneObject& obj) { return obj.roughness < 0.35f || obj.metallic > 0.3f; }
+
+        // clip 공간 점 (x, y, w). 근평면 뒤 (w <= kNearW) 는 화면에 없음
+        struct ClipPoint { float x, y, w; };
+        const float kNearW = 1e-4f;
+
+        ClipPoint transform(const float m[16], float x, float y, float z) {
+            return { m[0] * x + m[1] * y + m[2] * z + m[3],
+                     m[4] * x + m[5] * y + m[6] * z + m[7],
+                     m[12] * x + m[13] * y + m[14] * z + m[15] };
+        }
+
+    }
+
+    float projectedCoverage(const float viewProj[16], const Float3& boxMin, const Float3& boxMax) {
+        ClipPoint corners[8];
+        for (int i = 0; i < 8; i++) {
+            corners[i] = transform(viewProj, (i & 1) ? boxMax.x : boxMin.x,
+                                             (i & 2) ? boxMax.y : boxMin.y,
+                                             (i & 4) ? boxMax.z : boxMin.z);
+        }
+
+        // 근평면 앞 꼭짓점 + 근평면에 걸친 모서리 12 개의 교점으로 NDC 사각형을 만듦
+        float minX = 1e30f, minY = 1e30f, maxX = -1e30f, maxY = -1e30f;
+        auto addPoint = [&](const ClipPoint& p) {
+            float x = p.x / p.w, y = p.y / p.w;
+            minX = std::min(minX, x); maxX = std::max(maxX, x);
+            minY = std::min(minY, y); maxY = std::max(maxY, y);
+        };
+        for (const ClipPoint& c : corners) {
+            if (c.w > kNearW) addPoint(c);
+        }
+        for (int i = 0; i < 8; i++) {
+            for (int axis = 1; axis < 8; axis <<= 1) {
+                if (i & axis) continue;
+                const ClipPoint& a = corners[i];
+                const ClipPoint& b = corners[i | axis];
+                if ((a.w > kNearW) == (b.w > kNearW)) continue;
+                float t = (kNearW - a.w) / (b.w - a.w);
+                addPoint({ a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, kNearW });
+            }
+        }
+        if (minX > maxX) return 0.0f;     // 전부 카메라 뒤
+
+        float w = std::min(maxX, 1.0f) - std::max(minX, -1.0f);
+        float h = std::min(maxY, 1.0f) - std::max(minY, -1.0f);
+        if (w <= 0.0f || h <= 0.0f) return 0.0f;
+        return w * h * 0.25f;
+    }
+
+    int renderModeDepthCap(const SceneObject& obj, int maxBounces) {
+        int materialDepth = obj.maxDepth > 0 ? obj.maxDepth
+                          : defaultMaterialMaxDepth(obj.specTrans, obj.roughness, obj.metallic);
+        // raygenbsdf.rgen main(): G-Buffer 가 거친 재질인 픽셀은 min(3, maxBounces)
+        int pixelBounces = isGlossy(obj) ? maxBounces : std::min(3, maxBounces);
+        return std::max(std::min(materialDepth, pixelBounces), 1);
+    }
+
+    float renderModeCost(const SceneObject& obj, int mode, float pathLength, int maxBounces) {
+        float probe = isGlossy(obj) ? 1.0f : 0.0f;
+        switch (mode) {
+        case RENDER_MODE_PATH_TRACE: {
+            float cap = float(renderModeDepthCap(obj, maxBounces));
+            float length = pathLength > 0.0f ? std::min(pathLength, cap) : cap * 0.5f;
+            return 2.0f * std::max(length, 1.0f);
+        }
+        case RENDER_MODE_RT_SHADOW:
+            return 2.0f + probe + 0.25f;      // + Disney BRDF 평가 (광선 1/4 정도로 침)
+        default:
+            return 2.0f + probe;
+        }
+    }
+
+    float renderModeQualityLoss(const SceneObject& obj, int mode) {
+        if (mode == RENDER_MODE_PATH_TRACE) return 0.0f;
+        // 유리: 굴절이 통째로 사라짐. 매끈 / 금속: 반사 probe 가 한 번 튕김까지는 살림. 거친 diffuse: GI (color bleeding) 만 잃음
+        float loss = obj.specTrans > 0.0f ? 1.0f : (isGlossy(obj) ? 0.5f : 0.3f);
+        // mode 2 는 재질이 OGRE PBS 근사로 바뀜
+        return mode == RENDER_MODE_RASTER ? std::min(loss + 0.05f, 1.0f) : loss;
+    }
+
+    void RenderModeScheduler::setObjects(const std::vector<SceneObject>& objects) {
+        mObjects = objects;
+        mManualModes.resize(objects.size());
+        mLocked.resize(objects.size());
+        for (size_t i = 0; i < objects.size(); i++) {
+            mManualModes[i] = objects[i].renderMode;
+            // 면광원은 1st hit 이 emissive 로 보여야 하므로 모드를 건드리지 않음
+            mLocked[i] = objects[i].emissive > 0.0f;
+        }
+        mModes = mManualModes;
+        mStats = RenderModeStats();
+        for (int m : mModes) mStats.objectsPerMode[std::min(std::max(m, 0), RENDER_MODE_COUNT - 1)]++;
+        mMeasuredMs = 0.0f;
+    }
+
+    void RenderModeScheduler::recordFrameTime(float gpuMs) {
+        if (gpuMs <= 0.0f) return;
+        mMeasuredMs = mMeasuredMs > 0.0f ? mMeasuredMs + (gpuMs - mMeasuredMs) * kTimeSmoothing : gpuMs;
+        mStats.measuredMs = mMeasuredMs;
+    }
+
+    float RenderModeScheduler::predictRays(const std::vector<float>& coverage, const std::vector<int>& modes,
+                                           float pathLength, int maxBounces, uint32_t pixels) const {
+        // 1st hit 광선은 모든 픽셀 (하늘 포함), 오브젝트가 덮은 픽셀은 모드별 추가 광선
+        float rays = 0.0f;
+        for (size_t i = 0; i < mObjects.size(); i++) {
+            rays += coverage[i] * (renderModeCost(mObjects[i], modes[i], pathLength, maxBounces) - 1.0f);
+        }
+        return (rays + 1.0f) * float(pixels);
+    }
+
+    bool RenderModeScheduler::evaluate(const std::vector<float>& rawCoverage, float pathLength, int maxBounces, uint32_t pixels) {
+        if (!mBudget.enabled || mObjects.empty() || rawCoverage.size() != mObjects.size()) return false;
+        mStats.evaluations++;
+
+        // 가림을 무시한 점유율이라 합이 1 을 넘으면 (뒷벽 + 앞의 박스 등) 화면 전체로 정규화
+        std::vector<float> coverage = rawCoverage;
+        float total = 0.0f;
+        for (float c : coverage) total += c;
+        if (total > 1.0f) {
+            for (float& c : coverage) c /= total;
+        }
+
+        // 측정한 평균 경로 길이에는 래스터 픽셀 (세그먼트 1) 이 섞여 있으므로 지금 배정의 래스터 점유율만큼 빼서 PT 경로 길이로
+        float hybrid = 0.0f;
+        for (size_t i = 0; i < mObjects.size(); i++) {
+            if (mModes[i] != RENDER_MODE_PATH_TRACE) hybrid += coverage[i];
+        }
+        float ptLength = pathLength;
+        if (pathLength > 0.0f && hybrid < 0.95f) ptLength = std::max((pathLength - hybrid) / (1.0f - hybrid), 1.0f);
+
+        // 보정: 지금 배정의 예측 광선 수 ↔ 측정 시간
+        float currentRays = predictRays(coverage, mModes, ptLength, maxBounces, pixels);
+        if (mMeasuredMs > 0.0f && currentRays > 0.0f) {
+            float msPerMRay = mMeasuredMs / (currentRays * 1e-6f);
+            mStats.msPerMRay = mStats.msPerMRay > 0.0f ? mStats.msPerMRay + (msPerMRay - mStats.msPerMRay) * kCalibSmoothing : msPerMRay;
+        }
+        const float msPerRay = (mStats.msPerMRay > 0.0f ? mStats.msPerMRay : kDefaultMsPerMRay) * 1e-6f;
+        auto objectMs = [&](size_t i, int mode) {
+            return coverage[i] * float(pixels) * renderModeCost(mObjects[i], mode, ptLength, maxBounces) * msPerRay;
+        };
+
+        mStats.predictedMs = currentRays * msPerRay;
+        const float target = mBudget.targetMs;
+        bool overBudget  = mStats.predictedMs > target * (1.0f + mBudget.hysteresis);
+        bool underBudget = mStats.predictedMs < target * (1.0f - mBudget.hysteresis);
+        bool anyDowngraded = false;
+        for (size_t i = 0; i < mObjects.size(); i++) {
+            if (!mLocked[i] && mModes[i] != RENDER_MODE_PATH_TRACE) anyDowngraded = true;
+        }
+        if (!overBudget && !(underBudget && anyDowngraded)) return false;
+
+        // 모두 풀 PT 에서 시작해 "손실 / 절약 ms" 가 가장 작은 한 단계씩 내림
+        std::vector<int> modes = mManualModes;
+        for (size_t i = 0; i < mObjects.size(); i++) {
+            if (!mLocked[i]) modes[i] = RENDER_MODE_PATH_TRACE;
+        }
+        float predicted = predictRays(coverage, modes, ptLength, maxBounces, pixels) * msPerRay;
+        while (predicted > target) {
+            int best = -1;
+            float bestRatio = 0.0f, bestSaved = 0.0f;
+            for (size_t i = 0; i < mObjects.size(); i++) {
+                if (mLocked[i] || modes[i] + 1 >= RENDER_MODE_COUNT) continue;
+                float saved = objectMs(i, modes[i]) - objectMs(i, modes[i] + 1);
+                if (saved <= 0.0f) continue;    // 화면 밖 오브젝트
+                float loss = coverage[i] * (renderModeQualityLoss(mObjects[i], modes[i] + 1) - renderModeQualityLoss(mObjects[i], modes[i]));
+                float ratio = loss / saved;
+                if (best < 0 || ratio < bestRatio) { best = int(i); bestRatio = ratio; bestSaved = saved; }
+            }
+            if (best < 0) break;        // 더 내릴 수 있는 오브젝트가 없음 (예산 초과 그대로)
+            modes[best]++;
+            predicted -= bestSaved;
+        }
+
+        uint32_t changed = 0;
+        for (size_t i = 0; i < mObjects.size(); i++) {
+            if (modes[i] != mModes[i]) changed++;
+        }
+        if (changed == 0) return false;
+
+        mModes = modes;
+        mStats.predictedMs = predicted;
+        mStats.changes += changed;
+        for (int m = 0; m < RENDER_MODE_COUNT; m++) mStats.objectsPerMode[m] = 0;
+        for (int m : mModes) mStats.objectsPerMode[std::min(std::max(m, 0), RENDER_MODE_COUNT - 1)]++;
+        return true;
+    }
+
+}
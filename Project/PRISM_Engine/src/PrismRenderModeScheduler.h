@@ -0,0 +1,94 @@
+#pragma once
+
+#include "PrismScene.h"
+
+#include <cstdint>
+#include <vector>
+
+// 하이브리드 렌더 모드 자동 선택: SceneObject::renderMode 를 손으로 정하는 대신 RT 프레임 시간 예산에 맞춰 오브젝트마다 고름
+// 결과는 InstanceMaterial::pbrParams2[2] 로 (RTPipeline::setInstanceRenderMode). closesthitbsdf.rchit 이 그대로 읽음
+// Ogre / Vulkan 의존 없음
+//
+// 비용 모델 (단위 = 광선 하나, 픽셀당. raygenbsdf.rgen 의 분기를 그대로 셈)
+//   - 모든 픽셀: 1st hit 광선 1 개 (하늘 픽셀은 이것뿐)
+//   - mode 0 (풀 PT)            : 세그먼트마다 바운스 광선 + NEE 그림자 광선 → 2 * 경로 길이
+//                                 경로 길이 = GPU 가 잰 평균 길이를 재질 깊이 상한 (재질별 maxDepth, G-Buffer 바운스 규칙) 으로 자름
+//   - mode 1 (RT shadow + BRDF) : 그림자 광선 1 + 매끈 / 금속이면 반사 probe 1 + Disney BRDF 평가
+//   - mode 2 (래스터 + RT shadow): mode 1 과 같은 광선, BRDF 대신 G-Buffer 색
+// 광선 수 → ms 는 GPU 타임스탬프로 잰 trace 시간 / 예측 광선 수 (지수 이동 평균) 로 보정
+//
+// 선택: 모두 mode 0 에서 시작해 "화질 손실 / 줄어드는 ms" 가 가장 작은 오브젝트를 한 단계씩 (0 → 1 → 2) 내려 예산에 맞춤
+// 화질 손실 = 화면 점유율 * 재질 가중치 (유리는 굴절이 통째로 없어지므로 크고, 거친 diffuse 는 GI 만 잃으므로 작음)
+// 모드가 바뀌면 누적을 다시 시작해야 하므로 예측 시간이 목표 ± hysteresis 안이면 그대로 둠
+
+namespace Prism {
+
+    enum RenderMode : int {
+        RENDER_MODE_PATH_TRACE = 0,     // 풀 PT
+        RENDER_MODE_RT_SHADOW  = 1,     // RT shadow + Disney BRDF 직접조명 + 반사 probe
+        RENDER_MODE_RASTER     = 2,     // G-Buffer 래스터 색 + RT shadow + 반사 probe
+        RENDER_MODE_COUNT
+    };
+
+    struct RenderModeBudget {
+        bool  enabled    = true;
+        float targetMs   = 12.0f;       // RT trace 단계 GPU 시간 목표 (래스터 / 디노이저 / present 제외)
+        float hysteresis = 0.1f;        // 예측 시간이 목표의 ±10% 안이면 모드를 바꾸지 않음
+        int   interval   = 30;          // 재평가 주기 (프레임). GPU 시간은 몇 프레임 늦게 오므로 너무 짧으면 진동
+    };
+
+    struct RenderModeStats {
+        float    measuredMs  = 0.0f;    // GPU 타임스탬프 (이동 평균)
+        float    predictedMs = 0.0f;    // 지금 모드 배정의 예측 시간
+        float    msPerMRay   = 0.0f;    // 보정값: 백만 광선당 ms
+        uint32_t objectsPerMode[RENDER_MODE_COUNT] = {};
+        uint32_t changes     = 0;       // 누적 모드 변경 수 (오브젝트 단위)
+        uint32_t evaluations = 0;
+    };
+
+    // viewProj (행 우선, clip = viewProj * (x, y, z, 1)) 로 월드 AABB 를 투영한 화면 점유율 [0, 1]
+    // 가림은 무시. 카메라 근평면에 걸친 박스는 모서리를 근평면에서 잘라서 셈
+    float projectedCoverage(const float viewProj[16], const Float3& boxMin, const Float3& boxMax);
+
+    // 재질 깊이 상한: SceneObject::maxDepth (0 이면 defaultMaterialMaxDepth), 거친 재질은 G-Buffer 규칙으로 3
+    int renderModeDepthCap(const SceneObject& obj, int maxBounces);
+
+    // 픽셀당 광선 수 (위 비용 모델). pathLength = 풀 PT 경로의 평균 세그먼트 수 (GPU 측정)
+    float renderModeCost(const SceneObject& obj, int mode, float pathLength, int maxBounces);
+
+    // mode 0 대비 화질 손실 가중치 [0, 1] (화면 점유율을 곱해서 씀)
+    float renderModeQualityLoss(const SceneObject& obj, int mode);
+
+    class RenderModeScheduler {
+    public:
+        // objects = 재질 버퍼 순서 (InstanceMaterial 인덱스). emissive 오브젝트 (면광원) 는 손으로 정한 모드 그대로
+        void setObjects(const std::vector<SceneObject>& objects);
+
+        void setBudget(const RenderModeBudget& budget) { mBudget = budget; }
+        const RenderModeBudget& getBudget() const { return mBudget; }
+
+        // 매 프레임: GPU 가 잰 trace 시간 (ms, 0 이하면 아직 없음)
+        void recordFrameTime(float gpuMs);
+
+        // budget.interval 프레임마다 호출. coverage = 오브젝트별 화면 점유율, pathLength = GPU 평균 경로 길이 (PathStats)
+        // 모드가 바뀐 오브젝트가 있으면 true, modes 에 전체 배정 (재질 순서)
+        bool evaluate(const std::vector<float>& coverage, float pathLength, int maxBounces, uint32_t pixels);
+
+        // 현재 배정 (스케줄러가 꺼져 있으면 손으로 정한 SceneObject::renderMode)
+        const std::vector<int>& getModes() const { return mBudget.enabled ? mModes : mManualModes; }
+        const RenderModeStats& getStats() const { return mStats; }
+
+    private:
+        float predictRays(const std::vector<float>& coverage, const std::vector<int>& modes,
+                          float pathLength, int maxBounces, uint32_t pixels) const;
+
+        RenderModeBudget      mBudget;
+        RenderModeStats       mStats;
+        std::vector<SceneObject> mObjects;
+        std::vector<int>      mManualModes;
+        std::vector<int>      mModes;
+        std::vector<bool>     mLocked;
+        float                 mMeasuredMs = 0.0f;
+    };
+
+}
@@ -0,0 +1,95 @@
+#include "PrismScene.h"
+#include "PrismPathParams.h"
+
+namespace Prism {
+
+    InstanceMaterial makeInstanceMaterial(const SceneObject& obj) {
+        InstanceMaterial mat{};
+        mat.albedo[0] = obj.albedo.x; mat.albedo[1] = obj.albedo.y;
+        mat.albedo[2] = obj.albedo.z; mat.albedo[3] = 1.0f;
+        mat.pbrParams1[0] = obj.emissive;  mat.pbrParams1[1] = obj.roughness;
+        mat.pbrParams1[2] = obj.metallic;
+        mat.pbrParams1[3] = (float)(obj.maxDepth > 0 ? obj.maxDepth
+                                    : defaultMaterialMaxDepth(obj.specTrans, obj.roughness, obj.metallic));
+        mat.pbrParams2[0] = obj.specTrans; mat.pbrParams2[1] = obj.ior;
+        mat.pbrParams2[2] = (float)obj.renderMode;   // 0=풀PT  1=RTshadow+BRDF  2=GBuffer+RTshadow
+        mat.pbrParams2[3] = -1.0f;                   // 광원 오프셋 (applyLightOffsets 에서 채움)
+        return mat;
+    }
+
+    std::vector<SceneObject> makeCornellScene(const std::string& basePath) {
+        // ──────────────────────────────────────────────────────────────────
+        // 좌표 기준:
+        //   cube.obj 단위 큐브: [-0.5, +0.5] 범위, 중심 원점
+        //   바닥 상단 y = -1 + 0.1 = -0.9
+        //   박스 하단을 바닥에 맞추려면: center_y = -0.9 + scale_y / 2
+        //
+        // 박스 매질 목록:
+        //   왼쪽 tall  : 맑은 유리 (Clear Glass)     specTrans=1.0, IOR=1.52, rough=0.0
+        //   오른쪽 tall: 완전 거울 (Perfect Mirror)   metallic=1.0, rough=0.02
+        //   중앙       : 토끼 받침대 (Diffuse White)
+        //   왼앞 small : 황금 거친 금속 (Rough Gold)  metallic=1.0, rough=0.4
+        //   오른앞 small: 서리 유리 (Frosted Glass)   specTrans=0.9, rough=0.3
+        // ──────────────────────────────────────────────────────────────────
+        return {
+            // modelPath              pos                      scale               albedo                   rough  metal  specTr  ior   emit
+            // ── 방 구조 ──────────────────────────────────────────────────────────────────────────
+            // 바닥 top=−0.9 / 천장 bottom=11.9 → 벽은 y=−1.1~12.1 범위로 만들어 틈 제거
+            { basePath+"cube.obj", {  0,  -1,    0}, {20,    0.2f,  20  }, {0.8f, 0.8f, 0.8f}, 0.8f, 0.0f, 0.0f, 1.5f, 0.0f, 0 }, // 바닥   (mode0: 풀 PT)
+            { basePath+"cube.obj", {  0,  12,    0}, {20,    0.2f,  20  }, {1.0f, 1.0f, 1.0f}, 0.8f, 0.0f, 0.0f, 1.5f, 0.0f, 2 }, // 천장   (mode2)
+            { basePath+"cube.obj", {  0,   5.5f,-10}, {20.4f,13.2f,  0.2f},{0.9f, 0.9f, 0.9f},0.8f, 0.0f, 0.0f, 1.5f, 0.0f, 2 }, // 뒷벽   (mode2)
+            { basePath+"cube.obj", {-10,   5.5f,  0}, {0.2f, 13.2f, 20.4f},{0.8f, 0.1f, 0.1f},0.8f, 0.0f, 0.0f, 1.5f, 0.0f, 2 }, // 왼벽   (mode2: 빨강)
+            { basePath+"cube.obj", { 10,   5.5f,  0}, {0.2f, 13.2f, 20.4f},{0.1f, 0.8f, 0.1f},0.8f, 0.0f, 0.0f, 1.5f, 0.0f, 2 }, // 오른벽 (mode2: 초록)
+            { basePath+"cube.obj", {  0,  11.5f,  0}, {8,    0.1f,   8  }, {1.0f, 1.0f, 1.0f}, 0.5f, 0.0f, 0.0f, 1.5f, 4.0f, 0 }, // 면광원 (emissive, 풀PT)
+            // ── 오브젝트 박스들 ─────────────────────────────────────────────────────────────────
+            // 왼쪽 tall — 맑은 유리 (center_y = −0.9 + 6/2 = 2.1)
+            { basePath+"cube.obj", {-4.5f, 2.1f,  -6}, {3.5f, 6.0f, 3.5f}, {0.95f,0.97f,1.0f}, 0.0f, 0.0f, 1.0f,1.52f, 0.0f },
+            // 오른쪽 tall — 완전 거울 (metallic=1, rough≈0)
+            { basePath+"cube.obj", { 4.5f, 2.1f,  -6}, {3.5f, 6.0f, 3.5f}, {0.9f, 0.9f, 0.9f}, 0.02f,1.0f, 0.0f, 1.5f, 0.0f },
+            // 중앙 — 토끼 받침대 (center_y = −0.9+1 = 0.1, top=1.1)
+            { basePath+"cube.obj", {  0,   0.1f,  -5}, {3.0f, 2.0f, 3.0f}, {0.9f, 0.9f, 0.9f}, 0.8f, 0.0f, 0.0f, 1.5f, 0.0f },
+            // 왼쪽 앞 — 황금 거친 금속 (mode1: RT shadow + Disney BRDF)
+            { basePath+"cube.obj", { -6,  -0.15f,-2.5f},{2.0f, 1.5f, 2.0f},{1.0f,0.77f,0.34f}, 0.4f, 1.0f, 0.0f, 1.5f, 0.0f, 1 },
+            // 오른쪽 앞 — 서리 유리 (Frosted Glass, specTrans=0.9, rough=0.3)
+            { basePath+"cube.obj", {  6,  -0.15f,-2.5f},{2.0f, 1.5f, 2.0f},{0.9f, 0.9f, 1.0f}, 0.3f, 0.0f, 0.9f, 1.5f, 0.0f },
+            // ── 토끼 (받침대 위) ───────────────────────────────────────────────────────────────
+            // 받침대 top=1.1, bunny Y반높이(scale=8)≈0.62 → center_y≈1.72
+            { basePath+"bunny.obj",{  0,   1.7f,  -5}, {8.0f, 8.0f, 8.0f}, {0.9f, 0.9f, 0.9f}, 0.1f, 0.0f, 0.0f, 1.5f, 0.0f },
+        };
+    }
+
+    std::vector<SceneObject> makeCornellLightGrid(const std::string& basePath, int gridSize) {
+        std::vector<SceneObject> base = makeCornellScene(basePath);
+        if (gridSize <= 1) return base;
+
+        // 면광원 자리를 gridSize x gridSize 타일로 채움 (타일 사이 20% 간격)
+        std::vector<SceneObject> scene;
+        for (const SceneObject& obj : base) {
+            if (obj.emissive <= 0.0f) {
+                scene.push_back(obj);
+                continue;
+            }
+            float cellX = obj.scale.x / gridSize, cellZ = obj.scale.z / gridSize;
+            for (int z = 0; z < gridSize; z++) {
+                for (int x = 0; x < gridSize; x++) {
+                    SceneObject tile = obj;
+                    tile.position.x = obj.position.x - 0.5f * obj.scale.x + (x + 0.5f) * cellX;
+                    tile.position.z = obj.position.z - 0.5f * obj.scale.z + (z + 0.5f) * cellZ;
+                    tile.scale.x = cellX * 0.8f;
+                    tile.scale.z = cellZ * 0.8f;
+                    scene.push_back(tile);
+                }
+            }
+        }
+        return scene;
+    }
+
+    SceneCamera makeCornellCamera() {
+        // Cornell Box 앞에서 바라보기
+        SceneCamera cam;
+        cam.eye    = { 0.0f, 7.0f, 15.0f };
+        cam.target = { 0.0f, 5.0f, 0.0f };
+        return cam;
+    }
+
+}
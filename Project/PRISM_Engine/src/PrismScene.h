@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Ogre / Vulkan 을 포함하지 않는 씬 정의
+// PRISM_Engine(main.cpp) 과 CPU 레퍼런스 렌더러(reference/) 가 같은 씬 목록과 재질 레이아웃을 쓰도록 분리
+
+namespace Prism {
+
+    struct Float3 {
+        float x = 0.0f, y = 0.0f, z = 0.0f;
+    };
+
+    // closesthitbsdf.rchit: layout(binding=3) buffer InstanceMaterials
+    struct InstanceMaterial {
+        float albedo[4];     // rgb: 색상, a: 투명도
+        float pbrParams1[4]; // x: emissive강도, y: roughness, z: metallic, w: 최대 경로 깊이 (PrismPathParams.h)
+        float pbrParams2[4]; // x: specTrans, y: ior, z: renderMode, w: 첫 삼각형 광원 인덱스 (-1: 광원 아님, PrismLights.h)
+    };
+
+    struct SceneObject {
+        std::string modelPath;
+        Float3 position;
+        Float3 scale;
+        Float3 albedo;
+        float roughness = 0.5f;
+        float metallic  = 0.0f;
+        float specTrans = 0.0f;
+        float ior       = 1.5f;
+        float emissive   = 0.0f;
+        int   renderMode = 0;    // 0=풀PT  1=RT shadow+BRDF  2=GBuffer래스터+RTshadow
+        int   maxDepth   = 0;    // 이 면에서 경로를 이어갈 최대 세그먼트 수 (0 = defaultMaterialMaxDepth)
+    };
+
+    // 초기 카메라 (OGRE Camera 기본 FOVy = 45도)
+    struct SceneCamera {
+        Float3 eye;
+        Float3 target;
+        Float3 up{ 0.0f, 1.0f, 0.0f };
+        float fovY = 0.785398163f;
+    };
+
+    InstanceMaterial makeInstanceMaterial(const SceneObject& obj);
+
+    // Cornell Box + 다양한 매질 박스 씬. modelPath = basePath + "cube.obj" / "bunny.obj"
+    std::vector<SceneObject> makeCornellScene(const std::string& basePath);
+    // 같은 씬에서 천장 면광원만 gridSize x gridSize 개의 작은 면광원으로 나눈 것 (다광원 샘플링 검증용)
+    std::vector<SceneObject> makeCornellLightGrid(const std::string& basePath, int gridSize);
+    SceneCamera makeCornellCamera();
+
+}
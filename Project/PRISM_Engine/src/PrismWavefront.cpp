@@ -0,0 +1,364 @@
+#include "PrismWavefront.h"
+#include "PrismMemoryPool.h"
+#include <OgreVulkanDevice.h>
+#include <OgreLogManager.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Prism {
+
+    namespace {
+        // 바운스마다 비우는 카운터 앞부분 (rayCount 제외: trace 가 바로 다음 단계에서 씀)
+        constexpr VkDeviceSize kHitCountersBegin = offsetof(GpuWavefrontCounters, hitCount);
+        constexpr VkDeviceSize kHitCountersEnd   = offsetof(GpuWavefrontCounters, raysTraced);
+    }
+
+    WavefrontTracer::WavefrontTracer(RTPipeline* rtPipeline) : mRTPipeline(rtPipeline) {}
+    WavefrontTracer::~WavefrontTracer() { cleanup(); }
+
+    void WavefrontTracer::initialize() {
+        if (!mRTPipeline || !mRTPipeline->getDevice()) return;
+        mDevice = mRTPipeline->getDevice();
+        mWidth  = mRTPipeline->getRTWidth();
+        mHeight = mRTPipeline->getRTHeight();
+        mCmdTraceRays = (PFN_vkCmdTraceRaysKHR)vkGetDeviceProcAddr(mDevice->mDevice, "vkCmdTraceRaysKHR");
+
+        createBuffers();
+        createDescriptorSet();
+        createPipelines();
+        if (!mReady) return;
+        createSBT();
+
+        Ogre::LogManager::getSingleton().logMessage("[PRISM] Wavefront: " + std::to_string(mWidth) + "x" + std::to_string(mHeight)
+            + " paths, path state " + std::to_string(sizeof(GpuWavefrontPath) * mWidth * mHeight / (1024 * 1024)) + " MB");
+    }
+
+    void WavefrontTracer::cleanup() {
+        if (!mDevice || mDevice->mDevice == VK_NULL_HANDLE) return;
+        VkDevice device = mDevice->mDevice;
+
+        if (mRTPipelineHandle    != VK_NULL_HANDLE) vkDestroyPipeline(device, mRTPipelineHandle, nullptr);
+        if (mSortPipeline        != VK_NULL_HANDLE) vkDestroyPipeline(device, mSortPipeline, nullptr);
+        if (mShadePipeline       != VK_NULL_HANDLE) vkDestroyPipeline(device, mShadePipeline, nullptr);
+        if (mResolvePipeline     != VK_NULL_HANDLE) vkDestroyPipeline(device, mResolvePipeline, nullptr);
+        if (mPipelineLayout      != VK_NULL_HANDLE) vkDestroyPipelineLayout(device, mPipelineLayout, nullptr);
+        if (mDescriptorPool      != VK_NULL_HANDLE) vkDestroyDescriptorPool(device, mDescriptorPool, nullptr);
+        if (mDescriptorSetLayout != VK_NULL_HANDLE) vkDestroyDescriptorSetLayout(device, mDescriptorSetLayout, nullptr);
+        if (mSBTBuffer != VK_NULL_HANDLE) vkDestroyBuffer(device, mSBTBuffer, nullptr);
+        if (mSBTMemory != VK_NULL_HANDLE) vkFreeMemory(device, mSBTMemory, nullptr);
+        for (int i = 0; i < BIND_COUNT; i++) {
+            if (mBuffers[i] != VK_NULL_HANDLE) vkDestroyBuffer(device, mBuffers[i], nullptr);
+            if (mMemory[i]  != VK_NULL_HANDLE) vkFreeMemory(device, mMemory[i], nullptr);
+            mBuffers[i] = VK_NULL_HANDLE; mMemory[i] = VK_NULL_HANDLE;
+        }
+        if (mReadbackMapped) vkUnmapMemory(device, mReadbackMemory);
+        if (mReadbackBuffer != VK_NULL_HANDLE) vkDestroyBuffer(device, mReadbackBuffer, nullptr);
+        if (mReadbackMemory != VK_NULL_HANDLE) vkFreeMemory(device, mReadbackMemory, nullptr);
+
+        mRTPipelineHandle = mSortPipeline = mShadePipeline = mResolvePipeline = VK_NULL_HANDLE;
+        mPipelineLayout = VK_NULL_HANDLE;
+        mDescriptorPool = VK_NULL_HANDLE;
+        mDescriptorSetLayout = VK_NULL_HANDLE;
+        mSBTBuffer = VK_NULL_HANDLE; mSBTMemory = VK_NULL_HANDLE;
+        mReadbackBuffer = VK_NULL_HANDLE; mReadbackMemory = VK_NULL_HANDLE; mReadbackMapped = nullptr;
+        mReady = false;
+        mDevice = nullptr;
+    }
+
+    void WavefrontTracer::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties,
+                                       VkBuffer& buffer, VkDeviceMemory& memory, bool deviceAddress) {
+        VkDevice device = mDevice->mDevice;
+        VkBufferCreateInfo bufferInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+        bufferInfo.size = size;
+        bufferInfo.usage = usage;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        if (vkCreateBuffer(device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
+            throw std::runtime_error("PRISM: Failed to create wavefront buffer!");
+        }
+
+        VkMemoryRequirements memReqs;
+        vkGetBufferMemoryRequirements(device, buffer, &memReqs);
+
+        VkMemoryAllocateFlagsInfo flagsInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO };
+        flagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+
+        VkMemoryAllocateInfo allocInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, deviceAddress ? &flagsInfo : nullptr };
+        allocInfo.allocationSize = memReqs.size;
+        allocInfo.memoryTypeIndex = findMemoryType(mDevice->mPhysicalDevice, memReqs.memoryTypeBits, properties);
+        if (vkAllocateMemory(device, &allocInfo, nullptr, &memory) != VK_SUCCESS) {
+            throw std::runtime_error("PRISM: Wavefront buffer memory allocation failed!");
+        }
+        vkBindBufferMemory(device, buffer, memory, 0);
+    }
+
+    void WavefrontTracer::createBuffers() {
+        const VkDeviceSize pathCount = VkDeviceSize(mWidth) * mHeight;
+        const VkBufferUsageFlags storage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+
+        createBuffer(pathCount * sizeof(GpuWavefrontPath), storage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                     mBuffers[BIND_PATHS], mMemory[BIND_PATHS]);
+        // 큐 4 개: 원소 = 경로 인덱스. 경로당 한 바운스에 최대 한 번씩만 들어가므로 길이 = 경로 수
+        for (int q : { BIND_RAY_QUEUE, BIND_HIT_QUEUE, BIND_SORTED_QUEUE, BIND_SHADOW_QUEUE }) {
+            createBuffer(pathCount * sizeof(uint32_t), storage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, mBuffers[q], mMemory[q]);
+        }
+        // 카운터: vkCmdUpdateBuffer 로 비우고, hitDispatch 를 sort / shade 의 indirect 인자로, 프레임 끝에 readback 으로 복사
+        createBuffer(sizeof(GpuWavefrontCounters),
+                     storage | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, mBuffers[BIND_COUNTERS], mMemory[BIND_COUNTERS]);
+
+        createBuffer(sizeof(GpuWavefrontCounters) * kReadbackSlots, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, mReadbackBuffer, mReadbackMemory);
+        void* data = nullptr;
+        vkMapMemory(mDevice->mDevice, mReadbackMemory, 0, sizeof(GpuWavefrontCounters) * kReadbackSlots, 0, &data);
+        memset(data, 0, sizeof(GpuWavefrontCounters) * kReadbackSlots);
+        mReadbackMapped = static_cast<GpuWavefrontCounters*>(data);
+    }
+
+    void WavefrontTracer::createDescriptorSet() {
+        VkDevice device = mDevice->mDevice;
+
+        std::vector<VkDescriptorSetLayoutBinding> b;
+        for (uint32_t i = 0; i < BIND_COUNT; i++) {
+            VkDescriptorSetLayoutBinding bind{};
+            bind.binding = i; bind.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER; bind.descriptorCount = 1;
+            bind.stageFlags = VK_SHADER_STAGE_RAYGEN_BIT_KHR | VK_SHADER_STAGE_COMPUTE_BIT;
+            b.push_back(bind);
+        }
+        VkDescriptorSetLayoutCreateInfo lci = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
+        lci.bindingCount = (uint32_t)b.size(); lci.pBindings = b.data();
+        vkCreateDescriptorSetLayout(device, &lci, nullptr, &mDescriptorSetLayout);
+
+        VkDescriptorPoolSize poolSize = { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, BIND_COUNT };
+        VkDescriptorPoolCreateInfo pci = { VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+        pci.maxSets = 1; pci.poolSizeCount = 1; pci.pPoolSizes = &poolSize;
+        vkCreateDescriptorPool(device, &pci, nullptr, &mDescriptorPool);
+
+        VkDescriptorSetAllocateInfo ai = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+        ai.descriptorPool = mDescriptorPool; ai.descriptorSetCount = 1; ai.pSetLayouts = &mDescriptorSetLayout;
+        vkAllocateDescriptorSets(device, &ai, &mDescriptorSet);
+
+        VkDescriptorBufferInfo infos[BIND_COUNT] = {};
+        VkWriteDescriptorSet writes[BIND_COUNT] = {};
+        for (uint32_t i = 0; i < BIND_COUNT; i++) {
+            infos[i].buffer = mBuffers[i]; infos[i].offset = 0; infos[i].range = VK_WHOLE_SIZE;
+            writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].dstSet = mDescriptorSet; writes[i].dstBinding = i; writes[i].descriptorCount = 1;
+            writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER; writes[i].pBufferInfo = &infos[i];
+        }
+        vkUpdateDescriptorSets(device, BIND_COUNT, writes, 0, nullptr);
+    }
+
+    void WavefrontTracer::createPipelines() {
+        VkDevice device = mDevice->mDevice;
+
+        // set 0 = RTPipeline 레이아웃 (TLAS, 이미지, UBO, 광원 ...), set 1 = 큐
+        VkDescriptorSetLayout setLayouts[2] = { mRTPipeline->getDescriptorSetLayout(), mDescriptorSetLayout };
+        VkPushConstantRange pcr = { VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstants) };
+        VkPipelineLayoutCreateInfo plci = { VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
+        plci.setLayoutCount = 2; plci.pSetLayouts = setLayouts;
+        plci.pushConstantRangeCount = 1; plci.pPushConstantRanges = &pcr;
+        vkCreatePipelineLayout(device, &plci, nullptr, &mPipelineLayout);
+
+        auto loadShader = [&](const std::string& path) -> VkShaderModule {
+            std::ifstream file(path, std::ios::ate | std::ios::binary);
+            if (!file.is_open()) {
+                Ogre::LogManager::getSingleton().logMessage("[PRISM] Shader not found: " + path);
+                return VK_NULL_HANDLE;
+            }
+            size_t size = (size_t)file.tellg();
+            std::vector<char> buf(size); file.seekg(0); file.read(buf.data(), size);
+            VkShaderModuleCreateInfo ci = { VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO };
+            ci.codeSize = buf.size(); ci.pCode = reinterpret_cast<const uint32_t*>(buf.data());
+            VkShaderModule sm; vkCreateShaderModule(device, &ci, nullptr, &sm); return sm;
+        };
+        auto createCompute = [&](const std::string& path) -> VkPipeline {
+            VkShaderModule sm = loadShader(path);
+            if (sm == VK_NULL_HANDLE) return VK_NULL_HANDLE;
+            VkComputePipelineCreateInfo pci = { VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO };
+            pci.stage = { VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO };
+            pci.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT; pci.stage.module = sm; pci.stage.pName = "main";
+            pci.layout = mPipelineLayout;
+            VkPipeline pipeline = VK_NULL_HANDLE;
+            vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pci, nullptr, &pipeline);
+            vkDestroyShaderModule(device, sm, nullptr);
+            return pipeline;
+        };
+        mSortPipeline    = createCompute("shaders/wavefront_sort.comp.spv");
+        mShadePipeline   = createCompute("shaders/wavefront_shade.comp.spv");
+        mResolvePipeline = createCompute("shaders/wavefront_resolve.comp.spv");
+
+        // RT 파이프라인: raygen 3 개 (generate / trace / shadow) + 메가커널과 같은 miss / closesthit
+        const char* raygenPaths[STAGE_COUNT] = {
+            "shaders/wavefront_generate.rgen.spv", "shaders/wavefront_trace.rgen.spv", "shaders/wavefront_shadow.rgen.spv"
+        };
+        VkShaderModule modules[STAGE_COUNT + 2];
+        for (int i = 0; i < STAGE_COUNT; i++) modules[i] = loadShader(raygenPaths[i]);
+        modules[STAGE_COUNT]     = loadShader("shaders/miss.rmiss.spv");
+        modules[STAGE_COUNT + 1] = loadShader("shaders/closesthitbsdf.rchit.spv");
+
+        bool modulesLoaded = std::none_of(std::begin(modules), std::end(modules), [](VkShaderModule m) { return m == VK_NULL_HANDLE; });
+        if (modulesLoaded) {
+            std::vector<VkPipelineShaderStageCreateInfo> stages;
+            std::vector<VkRayTracingShaderGroupCreateInfoKHR> groups;
+            for (int i = 0; i < STAGE_COUNT + 2; i++) {
+                VkShaderStageFlagBits stage = i < STAGE_COUNT ? VK_SHADER_STAGE_RAYGEN_BIT_KHR
+                    : (i == STAGE_COUNT ? VK_SHADER_STAGE_MISS_BIT_KHR : VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR);
+                stages.push_back({ VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, nullptr, 0, stage, modules[i], "main" });
+
+                VkRayTracingShaderGroupCreateInfoKHR g = { VK_STRUCTURE_TYPE_RAY_TRACING_SHADER_GROUP_CREATE_INFO_KHR };
+                g.type = stage == VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR ? VK_RAY_TRACING_SHADER_GROUP_TYPE_TRIANGLES_HIT_GROUP_KHR
+                                                                      : VK_RAY_TRACING_SHADER_GROUP_TYPE_GENERAL_KHR;
+                g.generalShader      = stage == VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR ? VK_SHADER_UNUSED_KHR : uint32_t(i);
+                g.closestHitShader   = stage == VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR ? uint32_t(i) : VK_SHADER_UNUSED_KHR;
+                g.anyHitShader       = VK_SHADER_UNUSED_KHR;
+                g.intersectionShader = VK_SHADER_UNUSED_KHR;
+                groups.push_back(g);
+            }
+
+            // raygen 이 한 단계씩만 trace 하므로 재귀 깊이 1
+            VkRayTracingPipelineCreateInfoKHR rpci = { VK_STRUCTURE_TYPE_RAY_TRACING_PIPELINE_CREATE_INFO_KHR };
+            rpci.stageCount = (uint32_t)stages.size(); rpci.pStages = stages.data();
+            rpci.groupCount = (uint32_t)groups.size(); rpci.pGroups = groups.data();
+            rpci.maxPipelineRayRecursionDepth = 1;
+            rpci.layout = mPipelineLayout;
+            auto vkCreateRTPipelines = (PFN_vkCreateRayTracingPipelinesKHR)vkGetDeviceProcAddr(device, "vkCreateRayTracingPipelinesKHR");
+            vkCreateRTPipelines(device, VK_NULL_HANDLE, VK_NULL_HANDLE, 1, &rpci, nullptr, &mRTPipelineHandle);
+        }
+        for (VkShaderModule m : modules) {
+            if (m != VK_NULL_HANDLE) vkDestroyShaderModule(device, m, nullptr);
+        }
+
+        mReady = mRTPipelineHandle != VK_NULL_HANDLE && mSortPipeline != VK_NULL_HANDLE
+              && mShadePipeline != VK_NULL_HANDLE && mResolvePipeline != VK_NULL_HANDLE;
+        if (!mReady) {
+            Ogre::LogManager::getSingleton().logMessage("[PRISM] Wavefront: shaders missing, wavefront mode disabled");
+        }
+    }
+
+    void WavefrontTracer::createSBT() {
+        VkDevice device = mDevice->mDevice;
+        VkPhysicalDeviceRayTracingPipelinePropertiesKHR rtProps = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_PIPELINE_PROPERTIES_KHR };
+        VkPhysicalDeviceProperties2 props2 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2, &rtProps };
+        vkGetPhysicalDeviceProperties2(mDevice->mPhysicalDevice, &props2);
+
+        // 레코드 하나씩 shaderGroupBaseAlignment 로 정렬: raygen 3 개, miss, hit 순서
+        uint32_t hSize     = rtProps.shaderGroupHandleSize;
+        uint32_t hStride   = (hSize + rtProps.shaderGroupHandleAlignment - 1) & ~(rtProps.shaderGroupHandleAlignment - 1);
+        uint32_t bAlign    = rtProps.shaderGroupBaseAlignment;
+        uint32_t recordSize = (hStride + bAlign - 1) & ~(bAlign - 1);
+        const uint32_t groupCount = STAGE_COUNT + 2;
+
+        createBuffer(VkDeviceSize(recordSize) * groupCount,
+                     VK_BUFFER_USAGE_SHADER_BINDING_TABLE_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, mSBTBuffer, mSBTMemory, true);
+
+        std::vector<uint8_t> handles(hSize * groupCount);
+        auto vkGetRTHandles = (PFN_vkGetRayTracingShaderGroupHandlesKHR)vkGetDeviceProcAddr(device, "vkGetRayTracingShaderGroupHandlesKHR");
+        vkGetRTHandles(device, mRTPipelineHandle, 0, groupCount, handles.size(), handles.data());
+
+        uint8_t* mapped;
+        vkMapMemory(device, mSBTMemory, 0, VkDeviceSize(recordSize) * groupCount, 0, (void**)&mapped);
+        for (uint32_t g = 0; g < groupCount; g++) memcpy(mapped + g * recordSize, handles.data() + g * hSize, hSize);
+        vkUnmapMemory(device, mSBTMemory);
+
+        auto getAddress = (PFN_vkGetBufferDeviceAddressKHR)vkGetDeviceProcAddr(device, "vkGetBufferDeviceAddressKHR");
+        VkBufferDeviceAddressInfoKHR addrInfo = { VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO };
+        addrInfo.buffer = mSBTBuffer;
+        VkDeviceAddress sbtBase = getAddress(device, &addrInfo);
+        for (uint32_t s = 0; s < STAGE_COUNT; s++) mRaygenRegions[s] = { sbtBase + s * recordSize, recordSize, recordSize };
+        mMissRegion = { sbtBase + STAGE_COUNT * recordSize,       hStride, recordSize };
+        mHitRegion  = { sbtBase + (STAGE_COUNT + 1) * recordSize, hStride, recordSize };
+    }
+
+    void WavefrontTracer::traceRays(VkCommandBuffer cmd, uint32_t stage) {
+        // 큐 길이는 GPU 만 알고 있으므로 화면 크기로 launch (큐 밖 스레드는 바로 return)
+        mCmdTraceRays(cmd, &mRaygenRegions[stage], &mMissRegion, &mHitRegion, &mCallableRegion, mWidth, mHeight, 1);
+    }
+
+    void WavefrontTracer::dispatchHits(VkCommandBuffer cmd, VkPipeline pipeline) {
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+        vkCmdDispatchIndirect(cmd, mBuffers[BIND_COUNTERS], offsetof(GpuWavefrontCounters, hitDispatch));
+    }
+
+    void WavefrontTracer::recordWavefront(VkCommandBuffer cmd) {
+        if (!isEnabled()) return;
+        VkBuffer counters = mBuffers[BIND_COUNTERS];
+
+        // 카운터 전체 비우기 (hitDispatch y, z 는 1). 이전 프레임 readback 복사 → 이번 쓰기
+        GpuWavefrontCounters zero{};
+        zero.hitDispatch[1] = zero.hitDispatch[2] = 1;
+        mRTPipeline->recordFrameStatsReset(cmd);
+        vkCmdUpdateBuffer(cmd, counters, 0, sizeof(GpuWavefrontCounters), &zero);
+
+        // 단계 사이 배리어: 셰이더 쓰기 / 카운터 갱신 → 다음 단계 읽기 + indirect 인자
+        const VkPipelineStageFlags shaderStages = VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+        auto barrier = [&]() {
+            VkMemoryBarrier mb = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+            mb.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+            mb.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT
+                           | VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+            vkCmdPipelineBarrier(cmd, shaderStages | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                shaderStages | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                0, 1, &mb, 0, nullptr, 0, nullptr);
+        };
+        barrier();
+
+        VkDescriptorSet sets[2] = { mRTPipeline->getDescriptorSet(), mDescriptorSet };
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR, mPipelineLayout, 0, 2, sets, 0, nullptr);
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, mPipelineLayout, 0, 2, sets, 0, nullptr);
+        PushConstants pc = { mWidth, mHeight };
+        vkCmdPushConstants(cmd, mPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstants), &pc);
+
+        // 카메라 광선 + 1st hit → 히트 큐
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR, mRTPipelineHandle);
+        traceRays(cmd, STAGE_GENERATE);
+        barrier();
+
+        // 바운스: 메가커널 TracePath 의 세그먼트 상한만큼 (래스터 오브젝트의 probe 를 위해 최소 2)
+        const int bounces = std::max(mRTPipeline->getPathTermination().maxBounces, 2);
+        GpuWavefrontCounters hitReset{};
+        hitReset.hitDispatch[1] = hitReset.hitDispatch[2] = 1;
+        const uint32_t rayReset = 0;
+        for (int bounce = 0; bounce < bounces; bounce++) {
+            dispatchHits(cmd, mSortPipeline);
+            barrier();
+            dispatchHits(cmd, mShadePipeline);
+            barrier();
+            traceRays(cmd, STAGE_SHADOW);
+            barrier();
+
+            // 히트 / 그림자 큐와 bin 카운터 비우기 (광선 큐는 trace 가 읽은 뒤에)
+            vkCmdUpdateBuffer(cmd, counters, kHitCountersBegin, kHitCountersEnd - kHitCountersBegin,
+                              reinterpret_cast<const uint8_t*>(&hitReset) + kHitCountersBegin);
+            barrier();
+            if (bounce + 1 == bounces) break;
+
+            traceRays(cmd, STAGE_TRACE);
+            barrier();
+            vkCmdUpdateBuffer(cmd, counters, 0, sizeof(uint32_t), &rayReset);
+            barrier();
+        }
+
+        // 경로 radiance → accumImage + 톤매핑
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, mResolvePipeline);
+        vkCmdDispatch(cmd, (mWidth + 7) / 8, (mHeight + 7) / 8, 1);
+
+        // 통계: 카운터 → readback 링 (kReadbackSlots - 1 프레임 뒤에 읽음, RTPipeline 통계 링과 같은 규칙)
+        const uint32_t frame = uint32_t(mRTPipeline->getFrameCount());
+        VkBufferCopy region = { 0, sizeof(GpuWavefrontCounters) * (frame % kReadbackSlots), sizeof(GpuWavefrontCounters) };
+        vkCmdCopyBuffer(cmd, counters, mReadbackBuffer, 1, &region);
+
+        const GpuWavefrontCounters& slot = mReadbackMapped[(frame + 1) % kReadbackSlots];
+        mStats.pathsStarted = mRTPipeline->getAdaptiveStats().pathsTraced;
+        mStats.raysTraced   = slot.raysTraced;
+        mStats.shadowRays   = slot.shadowRays;
+        for (uint32_t b = 0; b < WAVEFRONT_BIN_COUNT; b++) mStats.binHits[b] = slot.binTotal[b];
+        mStats.bounces = uint32_t(bounces);
+    }
+
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include "PrismRTPipeline.h"
+#include "PrismWavefrontQueues.h"
+
+namespace Prism {
+
+    // Wavefront 경로 추적 (raygenbsdf.rgen 메가커널 대신 단계별 커널 + 큐)
+    //   1) wavefront_generate.rgen : 카메라 광선 + 1st hit, 재투영 / 적응형 결정 → 히트 큐
+    //   2) 바운스마다 wavefront_sort.comp (재질 bin 순 정렬) → wavefront_shade.comp (NEE / BSDF 샘플)
+    //      → wavefront_shadow.rgen (그림자 큐) → wavefront_trace.rgen (광선 큐 → 히트 큐)
+    //   3) wavefront_resolve.comp : 경로 radiance 를 accumImage 에 섞고 톤매핑
+    // set 0 은 RTPipeline 의 descriptor set 을 그대로 쓰고, 경로 상태 / 큐 / 카운터는 set 1 (이 클래스 소유)
+    // 큐 / 경로 구조체: PrismWavefrontQueues.h, CPU 레퍼런스: reference/RefWavefront.cpp
+    //
+    // 메가커널과 다른 점: 픽셀당 경로는 프레임당 최대 1 (적응형이 더 많이 요구해도 1)
+    // RT 단계는 큐 길이를 모르므로 화면 크기로 launch 하고 큐 밖 스레드는 바로 끝남
+    class WavefrontTracer {
+    public:
+        explicit WavefrontTracer(RTPipeline* rtPipeline);
+        ~WavefrontTracer();
+
+        // RTPipeline::initialize() + createDescriptorSet() 이후 호출
+        void initialize();
+        void cleanup();
+
+        // 켜져 있으면 RTPipeline::recordRayTracingCommands 대신 호출 (TLAS / G-Buffer 배리어 뒤, recordHistoryCopy 앞)
+        void recordWavefront(VkCommandBuffer cmdBuf);
+
+        void setEnabled(bool enabled) { mEnabled = enabled; }
+        bool isEnabled() const { return mEnabled && mReady; }
+
+        // kReadbackSlots - 1 프레임 전 통계 (recordWavefront 가 갱신)
+        const WavefrontStats& getStats() const { return mStats; }
+
+    private:
+        struct PushConstants {
+            uint32_t width;
+            uint32_t height;
+        };
+
+        // set 1 바인딩
+        enum { BIND_PATHS, BIND_RAY_QUEUE, BIND_HIT_QUEUE, BIND_SORTED_QUEUE, BIND_SHADOW_QUEUE, BIND_COUNTERS, BIND_COUNT };
+        // RT 단계 (raygen 셰이더 그룹 순서)
+        enum { STAGE_GENERATE, STAGE_TRACE, STAGE_SHADOW, STAGE_COUNT };
+        static constexpr uint32_t kReadbackSlots = 4;
+
+        void createBuffers();
+        void createPipelines();
+        void createSBT();
+        void createDescriptorSet();
+        void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties,
+                          VkBuffer& buffer, VkDeviceMemory& memory, bool deviceAddress = false);
+
+        void traceRays(VkCommandBuffer cmd, uint32_t stage);
+        void dispatchHits(VkCommandBuffer cmd, VkPipeline pipeline);
+
+        RTPipeline*         mRTPipeline;
+        Ogre::VulkanDevice* mDevice = nullptr;
+
+        bool mEnabled = false;
+        bool mReady = false;            // 셰이더가 모두 로드됨
+
+        VkBuffer       mBuffers[BIND_COUNT] = {};
+        VkDeviceMemory mMemory[BIND_COUNT]  = {};
+        VkBuffer       mReadbackBuffer = VK_NULL_HANDLE;    // GpuWavefrontCounters * kReadbackSlots (host visible)
+        VkDeviceMemory mReadbackMemory = VK_NULL_HANDLE;
+        GpuWavefrontCounters* mReadbackMapped = nullptr;
+
+        VkDescriptorSetLayout mDescriptorSetLayout = VK_NULL_HANDLE;
+        VkDescriptorPool      mDescriptorPool      = VK_NULL_HANDLE;
+        VkDescriptorSet       mDescriptorSet       = VK_NULL_HANDLE;
+        VkPipelineLayout      mPipelineLayout      = VK_NULL_HANDLE;
+        VkPipeline            mRTPipelineHandle    = VK_NULL_HANDLE;
+        VkPipeline            mSortPipeline        = VK_NULL_HANDLE;
+        VkPipeline            mShadePipeline       = VK_NULL_HANDLE;
+        VkPipeline            mResolvePipeline     = VK_NULL_HANDLE;
+
+        VkBuffer        mSBTBuffer = VK_NULL_HANDLE;
+        VkDeviceMemory  mSBTMemory = VK_NULL_HANDLE;
+        VkStridedDeviceAddressRegionKHR mRaygenRegions[STAGE_COUNT] = {};
+        VkStridedDeviceAddressRegionKHR mMissRegion{};
+        VkStridedDeviceAddressRegionKHR mHitRegion{};
+        VkStridedDeviceAddressRegionKHR mCallableRegion{};
+        PFN_vkCmdTraceRaysKHR mCmdTraceRays = nullptr;
+
+        WavefrontStats mStats;
+        uint32_t mWidth = 0;
+        uint32_t mHeight = 0;
+    };
+
+}
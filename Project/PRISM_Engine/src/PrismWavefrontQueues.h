@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstdint>
+
+// Wavefront 경로 추적의 큐 구조 (경로 상태 + 광선 / 히트 / 정렬 / 그림자 큐 + 카운터)
+// GPU (PrismWavefront, wavefront_*.rgen / wavefront_*.comp) 와 CPU 레퍼런스 (reference/RefWavefront) 가 같은 구조체를 씀
+// Ogre / Vulkan 의존 없음
+//
+// 경로 하나 = 픽셀 하나 (경로 인덱스 = y * width + x). 큐에는 경로 인덱스만 들어가고 데이터는 GpuWavefrontPath 에 있음
+// 한 바운스 = sort (히트 큐를 재질 bin 순으로) → shade (bin 순서대로) → shadow (그림자 큐) → trace (광선 큐 → 히트 큐)
+// 메가커널 (raygenbsdf.rgen TracePath) 과 같은 식, 같은 난수 순서라 결과가 같고 처리 순서만 다름
+
+namespace Prism {
+
+    // shade 단계의 재질 bin. 히트 큐를 이 순서로 정렬해서 같은 종류의 셰이딩이 이웃 스레드에 모이게 함
+    enum WavefrontBin : uint32_t {
+        WAVEFRONT_BIN_EMISSIVE = 0,     // 광원에 맞음: MIS 가중치만 계산하고 종료
+        WAVEFRONT_BIN_DIFFUSE,          // 거친 불투명 면
+        WAVEFRONT_BIN_GLOSSY,           // 매끈한 면 / 금속 (GGX 쪽 분기)
+        WAVEFRONT_BIN_TRANSMISSIVE,     // 유리 (BTDF 쪽 분기)
+        WAVEFRONT_BIN_RASTER,           // 하이브리드 mode 1/2 오브젝트의 1st hit (그림자 광선 + 반사 probe)
+        WAVEFRONT_BIN_PROBE,            // 래스터 오브젝트가 쏜 반사 probe 광선이 맞은 면 (emissive / albedo 만 읽고 종료)
+        WAVEFRONT_BIN_COUNT
+    };
+
+    // 경로 플래그 (GpuWavefrontPath::flags)
+    constexpr uint32_t kWavefrontPathPrevNee = 1u;     // 직전 정점에서 NEE 를 했음 (광원에 맞으면 MIS)
+    constexpr uint32_t kWavefrontPathProbe   = 2u;     // 이 광선은 경로가 아니라 래스터 오브젝트의 반사 probe
+
+    // 히트 하나의 bin (raygenbsdf.rgen TracePath 의 분기 순서와 같음)
+    inline uint32_t wavefrontBin(uint32_t flags, int32_t depth, float isRaster, bool emissive,
+                                 float specTrans, float roughness, float metallic) {
+        if (flags & kWavefrontPathProbe) return WAVEFRONT_BIN_PROBE;
+        if (depth == 0 && isRaster > 0.5f) return WAVEFRONT_BIN_RASTER;
+        if (emissive) return WAVEFRONT_BIN_EMISSIVE;
+        if (specTrans > 0.0f) return WAVEFRONT_BIN_TRANSMISSIVE;
+        if (roughness < 0.35f || metallic > 0.3f) return WAVEFRONT_BIN_GLOSSY;
+        return WAVEFRONT_BIN_DIFFUSE;
+    }
+
+    // 경로 상태 하나 (std430, 240 bytes). wavefront_*.rgen / wavefront_*.comp 의 WavefrontPath 와 레이아웃 일치
+    struct GpuWavefrontPath {
+        // ── 광선 + 경로 상태 (generate / shade 가 쓰고 trace 가 읽음) ──
+        float    origin[3];
+        int32_t  maxBounces;        // 이 픽셀의 세그먼트 상한 (G-Buffer 재질로 결정)
+        float    dir[3];
+        uint32_t seed;              // 경로마다 이어 쓰는 RNG 상태
+        float    throughput[3];
+        int32_t  depth;             // 이번 히트의 세그먼트 번호 (0 = 1st hit)
+        float    prevPos[3];        // 직전 정점 (BSDF 샘플이 면광원에 맞았을 때 MIS 용)
+        float    prevBsdfPdf;
+        float    prevN[3];
+        uint32_t flags;             // kWavefrontPath*
+        float    radiance[3];       // 이 경로가 지금까지 모은 radiance (resolve 가 누적 이미지에 섞음)
+        float    padding0;
+        // ── 히트 (trace 가 closesthit payload 를 그대로 씀) ──
+        float    hitPos[3];
+        float    hitT;
+        float    normal[3];
+        float    roughness;
+        float    geomNormal[3];
+        float    metallic;
+        float    albedo[3];
+        float    specTrans;
+        float    emissive[3];
+        float    ior;
+        int32_t  lightId;
+        int32_t  maxDepth;
+        float    isRaster;
+        uint32_t bin;               // WavefrontBin
+        // ── 그림자 광선 (shade 가 쓰고 shadow 단계가 읽음) ──
+        float    shadowOrigin[3];
+        float    shadowTMax;
+        float    shadowDir[3];
+        float    shadowOccludedScale;   // 가려졌을 때 shadowRadiance 에 곱할 값 (NEE 0, 래스터 mode 1/2 는 0.15)
+        float    shadowRadiance[3];     // 안 가려졌을 때 더할 radiance
+        float    padding1;
+    };
+    static_assert(sizeof(GpuWavefrontPath) == 240, "GpuWavefrontPath must match the std430 layout in wavefront shaders");
+
+    // 큐 카운터 (std430). 앞쪽 (rayCount ~ binCursor) 은 바운스마다 비우고 뒤쪽 합계는 프레임 단위
+    struct GpuWavefrontCounters {
+        uint32_t rayCount;                          // 광선 큐 길이 (shade / probe 가 추가, trace 가 소비)
+        uint32_t hitCount;                          // 히트 큐 길이 (generate / trace 가 추가)
+        uint32_t shadowCount;                       // 그림자 큐 길이 (shade 가 추가)
+        uint32_t padding;
+        uint32_t hitDispatch[4];                    // sort / shade 의 vkCmdDispatchIndirect (x = ceil(hitCount / 64), y, z = 1)
+        uint32_t binCount[WAVEFRONT_BIN_COUNT];     // bin 별 히트 수 (히트를 큐에 넣을 때 셈)
+        uint32_t binCursor[WAVEFRONT_BIN_COUNT];    // sort 의 bin 별 쓰기 위치
+        // ── 프레임 합계 (통계) ──
+        uint32_t raysTraced;                        // trace 단계 광선 수 (1st hit 제외, probe 포함)
+        uint32_t shadowRays;
+        uint32_t binTotal[WAVEFRONT_BIN_COUNT];     // bin 별 셰이딩한 히트 수
+    };
+
+    // shade / sort 의 스레드 그룹 크기 (hitDispatch 계산에 씀)
+    constexpr uint32_t kWavefrontGroupSize = 64;
+
+    // 프레임 하나의 wavefront 통계 (GPU 는 GpuWavefrontCounters 를 몇 프레임 뒤에 읽고, CPU 레퍼런스는 직접 셈)
+    struct WavefrontStats {
+        uint64_t pathsStarted = 0;                  // generate 가 만든 경로 수
+        uint64_t raysTraced = 0;
+        uint64_t shadowRays = 0;
+        uint64_t binHits[WAVEFRONT_BIN_COUNT] = {};
+        uint32_t bounces = 0;                       // 바운스 (sort → shade → shadow → trace) 반복 수
+
+        uint64_t shadedHits() const {
+            uint64_t sum = 0;
+            for (uint64_t n : binHits) sum += n;
+            return sum;
+        }
+        double binPercent(uint32_t bin) const {
+            uint64_t total = shadedHits();
+            return total ? 100.0 * double(binHits[bin]) / double(total) : 0.0;
+        }
+    };
+
+    inline const char* wavefrontBinName(uint32_t bin) {
+        static const char* const names[WAVEFRONT_BIN_COUNT] = { "emissive", "diffuse", "glossy", "transmissive", "raster", "probe" };
+        return bin < WAVEFRONT_BIN_COUNT ? names[bin] : "?";
+    }
+
+}
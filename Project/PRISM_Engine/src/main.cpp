@@ -1,13 +1,9 @@
 #include <iostream>
 #include <vector>
 #include <string>
-#include <fstream>
 #include <exception>
 #include <cmath>
 #include <algorithm>
-#include <cfloat>
-#include <sstream>
-#include <map>
 #include <unordered_map>
 
 #include <windows.h>
@@ -47,7 +43,13 @@
 #include <Compositor/OgreCompositorWorkspace.h>
 #include <Compositor/OgreCompositorNode.h>
 #include "PrismRTPipeline.h"
+#include "PrismDenoiser.h"
+#include "PrismWavefront.h"
 #include "PrismCompositorPass.h"
+#include "PrismLights.h"
+#include "PrismObjLoader.h"
+#include "PrismRenderModeScheduler.h"
+#include "PrismScene.h"
 
 #include <SDL.h>
 #include <SDL_syswm.h>
@@ -64,180 +66,40 @@ static Ogre::String GetBasePath() {
     return path.substr(0, path.find_last_of("\\/") + 1);
 }
 
-// ── OBJ 파서 ──────────────────────────────────────────────
+static Ogre::Vector3 ToOgre(const Prism::Float3& v) { return Ogre::Vector3(v.x, v.y, v.z); }
 
-struct RawObj {
-    std::vector<Ogre::Vector3> pos;
-    std::vector<Ogre::Vector3> normals;
-    std::vector<uint32_t>      indices;
-};
-
-// "v", "v/vt", "v//vn", "v/vt/vn" 토큰 파싱 → (vi, ni) (-1이면 없음)
-static void parseFaceToken(const std::string& tok, int& vi, int& ni) {
-    vi = -1; ni = -1;
-    size_t slash1 = tok.find('/');
-    if (slash1 == std::string::npos) {
-        vi = std::stoi(tok) - 1;
-        return;
-    }
-    vi = std::stoi(tok.substr(0, slash1)) - 1;
-    size_t slash2 = tok.find('/', slash1 + 1);
-    if (slash2 == std::string::npos) {
-        // v/vt  (법선 없음)
-    } else if (slash2 == slash1 + 1) {
-        // v//vn
-        if (slash2 + 1 < tok.size())
-            ni = std::stoi(tok.substr(slash2 + 1)) - 1;
-    } else {
-        // v/vt/vn
-        ni = std::stoi(tok.substr(slash2 + 1)) - 1;
-    }
-}
-
-static RawObj ParseObj(const std::string& path) {
-    std::vector<Ogre::Vector3> rawPos, rawNorm;
-
-    struct FaceTri { int v[3]; int vn[3]; };
-    std::vector<FaceTri> triangles;
-    bool hasNormals = false;
-
-    std::ifstream file(path);
-    if (!file.is_open()) {
-        std::cerr << "[PRISM] OBJ not found: " << path << std::endl;
-        return {};
-    }
-
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.empty()) continue;
-        std::istringstream ss(line);
-        std::string prefix; ss >> prefix;
-
-        if (prefix == "v") {
-            float x, y, z; ss >> x >> y >> z;
-            rawPos.push_back({x, y, z});
-        } else if (prefix == "vn") {
-            float x, y, z; ss >> x >> y >> z;
-            rawNorm.push_back({x, y, z});
-            hasNormals = true;
-        } else if (prefix == "f") {
-            std::vector<int> vis, vnis;
-            std::string tok;
-            while (ss >> tok) {
-                int vi = -1, ni = -1;
-                parseFaceToken(tok, vi, ni);
-                vis.push_back(vi);
-                vnis.push_back(ni);
-            }
-            // Fan triangulation
-            for (size_t i = 1; i + 1 < vis.size(); i++) {
-                FaceTri tri;
-                tri.v[0]  = vis[0];  tri.v[1]  = vis[i];  tri.v[2]  = vis[i+1];
-                tri.vn[0] = vnis[0]; tri.vn[1] = vnis[i]; tri.vn[2] = vnis[i+1];
-                triangles.push_back(tri);
-            }
-        }
-    }
-
-    std::vector<Ogre::Vector3> finalPos, finalNorm;
-    std::vector<uint32_t>      indices;
-
-    if (hasNormals) {
-        // (v_idx, vn_idx) 쌍으로 unique vertex 관리
-        std::map<std::pair<int,int>, uint32_t> uniqueMap;
-        for (auto& tri : triangles) {
-            for (int j = 0; j < 3; j++) {
-                auto key = std::make_pair(tri.v[j], tri.vn[j]);
-                auto it = uniqueMap.find(key);
-                if (it != uniqueMap.end()) {
-                    indices.push_back(it->second);
-                } else {
-                    uint32_t idx = (uint32_t)finalPos.size();
-                    uniqueMap[key] = idx;
-                    finalPos.push_back(rawPos[tri.v[j]]);
-                    Ogre::Vector3 n = (tri.vn[j] >= 0 && tri.vn[j] < (int)rawNorm.size())
-                        ? rawNorm[tri.vn[j]] : Ogre::Vector3(0, 1, 0);
-                    finalNorm.push_back(n);
-                    indices.push_back(idx);
-                }
-            }
-        }
-    } else {
-        // 법선 없음 → 각 삼각형마다 face normal 계산 (flat shading)
-        for (auto& tri : triangles) {
-            if (tri.v[0] < 0 || tri.v[1] < 0 || tri.v[2] < 0) continue;
-            if (tri.v[0] >= (int)rawPos.size() || tri.v[1] >= (int)rawPos.size() || tri.v[2] >= (int)rawPos.size()) continue;
-            Ogre::Vector3 a = rawPos[tri.v[0]];
-            Ogre::Vector3 b = rawPos[tri.v[1]];
-            Ogre::Vector3 c = rawPos[tri.v[2]];
-            Ogre::Vector3 faceNorm = (b - a).crossProduct(c - a);
-            float len = faceNorm.length();
-            if (len > 1e-8f) faceNorm /= len;
-            else faceNorm = Ogre::Vector3(0, 1, 0);
-            for (int j = 0; j < 3; j++) {
-                indices.push_back((uint32_t)finalPos.size());
-                finalPos.push_back(rawPos[tri.v[j]]);
-                finalNorm.push_back(faceNorm);
-            }
-        }
-    }
-
-    // 중심 정규화 (바운딩박스 center를 원점으로)
-    if (!finalPos.empty()) {
-        Ogre::Vector3 minV(FLT_MAX), maxV(-FLT_MAX);
-        for (auto& p : finalPos) { minV.makeFloor(p); maxV.makeCeil(p); }
-        Ogre::Vector3 center = (minV + maxV) * 0.5f;
-        for (auto& p : finalPos) p -= center;
-    }
-
-    return { finalPos, finalNorm, indices };
-}
+// ── OGRE 메시 헬퍼 (캐시 포함) ───────────────────────────
+// OBJ → Prism::ObjMesh (바이너리 캐시가 맞으면 매핑한 파일 그대로) → OGRE 정점 / 인덱스 버퍼
+// BLAS 와 closesthit 은 같은 OGRE 버퍼를 디바이스 주소로 읽음 (RTPipeline::buildBLASShared, GPU 메시 사본 없음)
 
-// ── 씬 오브젝트 정의 ──────────────────────────────────────
-
-struct SceneObject {
-    std::string   modelPath;
-    Ogre::Vector3 position;
-    Ogre::Vector3 scale;
-    Ogre::Vector3 albedo;
-    float roughness = 0.5f;
-    float metallic  = 0.0f;
-    float specTrans = 0.0f;
-    float ior       = 1.5f;
-    float emissive   = 0.0f;
-    int   renderMode = 0;    // 0=풀PT  1=RT shadow+BRDF  2=GBuffer래스터+RTshadow
+struct LoadedMesh {
+    Ogre::MeshPtr mesh;
+    uint32_t      blasIdx = 0;
 };
 
-// ── OGRE 메시 헬퍼 (캐시 포함) ───────────────────────────
-
-static std::unordered_map<std::string, Ogre::MeshPtr> sMeshCache;
+static std::unordered_map<std::string, LoadedMesh> sMeshCache;
 static int sMeshCounter = 0;
 
-static Ogre::MeshPtr loadMeshFromObj(const std::string& objPath, Ogre::VaoManager* vaoMgr) {
+static LoadedMesh loadMeshFromObj(const std::string& objPath, Ogre::VaoManager* vaoMgr, Prism::RTPipeline* rtPipeline) {
     // 캐시 확인
     auto it = sMeshCache.find(objPath);
     if (it != sMeshCache.end()) return it->second;
 
-    auto raw = ParseObj(objPath);
-    if (raw.pos.empty()) {
+    Prism::ObjMesh obj;
+    if (!obj.load(objPath)) {
         std::cerr << "[PRISM] Empty mesh: " << objPath << std::endl;
-        return Ogre::MeshPtr();
+        return LoadedMesh();
     }
 
     Ogre::VertexElement2Vec vElements;
     vElements.push_back(Ogre::VertexElement2(Ogre::VET_FLOAT3, Ogre::VES_POSITION));
     vElements.push_back(Ogre::VertexElement2(Ogre::VET_FLOAT3, Ogre::VES_NORMAL));
 
-    float* vData = static_cast<float*>(OGRE_MALLOC_SIMD(sizeof(float) * raw.pos.size() * 6, Ogre::MEMCATEGORY_GEOMETRY));
-    for (size_t i = 0; i < raw.pos.size(); ++i) {
-        vData[i*6+0] = raw.pos[i].x;     vData[i*6+1] = raw.pos[i].y;     vData[i*6+2] = raw.pos[i].z;
-        vData[i*6+3] = raw.normals[i].x; vData[i*6+4] = raw.normals[i].y; vData[i*6+5] = raw.normals[i].z;
-    }
-    auto vBuf = vaoMgr->createVertexBuffer(vElements, raw.pos.size(), Ogre::BT_DEFAULT, vData, true);
-
-    uint32_t* iData = static_cast<uint32_t*>(OGRE_MALLOC_SIMD(sizeof(uint32_t) * raw.indices.size(), Ogre::MEMCATEGORY_GEOMETRY));
-    memcpy(iData, raw.indices.data(), sizeof(uint32_t) * raw.indices.size());
-    auto iBuf = vaoMgr->createIndexBuffer(Ogre::IndexBufferPacked::IT_32BIT, raw.indices.size(), Ogre::BT_DEFAULT, iData, true);
+    // keepAsShadow = false: OGRE 가 생성 시 복사만 하고 포인터를 들고 있지 않음 (매핑 해제 가능)
+    auto vBuf = vaoMgr->createVertexBuffer(vElements, obj.vertexCount(), Ogre::BT_IMMUTABLE,
+                                           const_cast<float*>(obj.vertices()), false);
+    auto iBuf = vaoMgr->createIndexBuffer(Ogre::IndexBufferPacked::IT_32BIT, obj.indexCount(), Ogre::BT_IMMUTABLE,
+                                          const_cast<uint32_t*>(obj.indices()), false);
 
     Ogre::VertexBufferPackedVec vBuffers; vBuffers.push_back(vBuf);
     auto vao = vaoMgr->createVertexArrayObject(vBuffers, iBuf, Ogre::OT_TRIANGLE_LIST);
@@ -247,11 +109,19 @@ static Ogre::MeshPtr loadMeshFromObj(const std::string& objPath, Ogre::VaoManage
     auto sub  = mesh->createSubMesh();
     sub->mVao[0].push_back(vao);
     sub->mVao[1].push_back(vao);
-    mesh->_setBounds(Ogre::Aabb(Ogre::Vector3::ZERO, Ogre::Vector3(1, 1, 1)), true);
-
-    sMeshCache[objPath] = mesh;
-    std::cout << "[PRISM] Loaded mesh: " << objPath << " (" << raw.pos.size() << " verts, " << raw.indices.size()/3 << " tris)" << std::endl;
-    return mesh;
+    Ogre::Aabb bounds;
+    bounds.setExtents(ToOgre(obj.boundsMin()), ToOgre(obj.boundsMax()));
+    mesh->_setBounds(bounds, false);
+    mesh->_setBoundingSphereRadius(bounds.getRadiusOrigin());
+
+    LoadedMesh loaded;
+    loaded.mesh    = mesh;
+    loaded.blasIdx = rtPipeline->buildBLASShared(mesh, objPath);
+
+    sMeshCache[objPath] = loaded;
+    std::cout << "[PRISM] Loaded mesh: " << objPath << " (" << obj.vertexCount() << " verts, " << obj.indexCount()/3 << " tris"
+              << (obj.fromCache() ? ", cached" : "") << ")" << std::endl;
+    return loaded;
 }
 
 // ── PrismApp ─────────────────────────────────────────────
@@ -265,8 +135,14 @@ public:
     Ogre::SceneNode*  mCamNode  = nullptr;
     SDL_Window*       mSdlWin   = nullptr;
     Prism::RTPipeline* mRTPipeline = nullptr;
+    Prism::Denoiser*   mDenoiser   = nullptr;
+    Prism::WavefrontTracer* mWavefront = nullptr;
     Prism::RTCompositorPassProvider* mPassProvider = nullptr;
 
+    // 오브젝트별 렌더 모드 자동 선택 (재질 버퍼 순서. mModeItems 는 화면 점유율 계산용)
+    Prism::RenderModeScheduler mModeScheduler;
+    std::vector<Ogre::Item*>   mModeItems;
+
     bool setup() {
         SetUnhandledExceptionFilter(PrismCrashHandler);
 
@@ -289,7 +165,11 @@ public:
 
         mRTPipeline = new Prism::RTPipeline(static_cast<Ogre::VulkanRenderSystem*>(rs));
         mRTPipeline->initialize();
-        mPassProvider = new Prism::RTCompositorPassProvider(mRTPipeline, mWindow);
+        mDenoiser = new Prism::Denoiser(mRTPipeline);
+        mDenoiser->initialize();
+        mWavefront = new Prism::WavefrontTracer(mRTPipeline);
+        mWavefront->initialize();
+        mPassProvider = new Prism::RTCompositorPassProvider(mRTPipeline, mDenoiser, mWavefront, mWindow);
         auto comp = mRoot->getCompositorManager2();
         comp->setCompositorPassProvider(mPassProvider);
 
@@ -381,10 +261,10 @@ public:
                 sd->setAllLoadActions(Ogre::LoadAction::Clear);
             }
 
-            // [Pass 2] SwapChain 상태 정상화 + RT 패스
+            // [Pass 2] SwapChain 상태 정상화 + RT 패스 + 디노이저 + blit
             {
                 Ogre::CompositorTargetDef* rt = nodeDef->addTargetPass("rt0");
-                rt->setNumPasses(2);
+                rt->setNumPasses(4);
 
                 // PASS_SCENE: SwapChain RenderPass를 열어서 OGRE 내부 상태 정상화
                 // (RT blit이 정상적으로 동작하도록, 결과는 RT로 덮어씀)
@@ -393,8 +273,10 @@ public:
                 sd->setAllClearColours(Ogre::ColourValue(0.0f, 0.0f, 0.0f));
                 sd->setAllLoadActions(Ogre::LoadAction::Clear);
 
-                // PASS_CUSTOM: endAllEncoders() 후 RT 실행 → blit
+                // PASS_CUSTOM: endAllEncoders() 후 RT 실행 → SVGF 디노이즈 → blit
                 rt->addPass(Ogre::PASS_CUSTOM, "ray_tracing");
+                rt->addPass(Ogre::PASS_CUSTOM, "denoise");
+                rt->addPass(Ogre::PASS_CUSTOM, "rt_present");
             }
 
             comp->addWorkspaceDefinition("MainWS")->connectExternal(0, nodeDef->getName(), 0);
@@ -424,6 +306,9 @@ public:
                         albedoTex->getFinalTextureName(),
                         normalTex->getFinalTextureName(),
                         materialTex->getFinalTextureName());
+                    mDenoiser->setGBufferViews(
+                        normalTex->getDefaultDisplaySrv(),
+                        materialTex->getDefaultDisplaySrv());
                 }
             }
         }
@@ -455,65 +340,32 @@ public:
         std::string basePath = GetBasePath();
         Ogre::VaoManager* vaoMgr = mRoot->getRenderSystem()->getVaoManager();
 
-        // ──────────────────────────────────────────────────────────────────
-        // Cornell Box + 다양한 매질 박스 씬
-        //
-        // 좌표 기준:
-        //   cube.obj 단위 큐브: [-0.5, +0.5] 범위, 중심 원점
-        //   바닥 상단 y = -1 + 0.1 = -0.9
-        //   박스 하단을 바닥에 맞추려면: center_y = -0.9 + scale_y / 2
-        //
-        // 박스 매질 목록:
-        //   왼쪽 tall  : 맑은 유리 (Clear Glass)     specTrans=1.0, IOR=1.52, rough=0.0
-        //   오른쪽 tall: 완전 거울 (Perfect Mirror)   metallic=1.0, rough=0.02
-        //   중앙       : 토끼 받침대 (Diffuse White)
-        //   왼앞 small : 황금 거친 금속 (Rough Gold)  metallic=1.0, rough=0.4
-        //   오른앞 small: 서리 유리 (Frosted Glass)   specTrans=0.9, rough=0.3
-        // ──────────────────────────────────────────────────────────────────
-        std::vector<SceneObject> scene = {
-            // modelPath              pos                      scale               albedo                   rough  metal  specTr  ior   emit
-            // ── 방 구조 ──────────────────────────────────────────────────────────────────────────
-            // 바닥 top=−0.9 / 천장 bottom=11.9 → 벽은 y=−1.1~12.1 범위로 만들어 틈 제거
-            { basePath+"cube.obj", {  0,  -1,    0}, {20,    0.2f,  20  }, {0.8f, 0.8f, 0.8f}, 0.8f, 0.0f, 0.0f, 1.5f, 0.0f, 0 }, // 바닥   (mode0: 풀 PT)
-            { basePath+"cube.obj", {  0,  12,    0}, {20,    0.2f,  20  }, {1.0f, 1.0f, 1.0f}, 0.8f, 0.0f, 0.0f, 1.5f, 0.0f, 2 }, // 천장   (mode2)
-            { basePath+"cube.obj", {  0,   5.5f,-10}, {20.4f,13.2f,  0.2f},{0.9f, 0.9f, 0.9f},0.8f, 0.0f, 0.0f, 1.5f, 0.0f, 2 }, // 뒷벽   (mode2)
-            { basePath+"cube.obj", {-10,   5.5f,  0}, {0.2f, 13.2f, 20.4f},{0.8f, 0.1f, 0.1f},0.8f, 0.0f, 0.0f, 1.5f, 0.0f, 2 }, // 왼벽   (mode2: 빨강)
-            { basePath+"cube.obj", { 10,   5.5f,  0}, {0.2f, 13.2f, 20.4f},{0.1f, 0.8f, 0.1f},0.8f, 0.0f, 0.0f, 1.5f, 0.0f, 2 }, // 오른벽 (mode2: 초록)
-            { basePath+"cube.obj", {  0,  11.5f,  0}, {8,    0.1f,   8  }, {1.0f, 1.0f, 1.0f}, 0.5f, 0.0f, 0.0f, 1.5f, 4.0f, 0 }, // 면광원 (emissive, 풀PT)
-            // ── 오브젝트 박스들 ─────────────────────────────────────────────────────────────────
-            // 왼쪽 tall — 맑은 유리 (center_y = −0.9 + 6/2 = 2.1)
-            { basePath+"cube.obj", {-4.5f, 2.1f,  -6}, {3.5f, 6.0f, 3.5f}, {0.95f,0.97f,1.0f}, 0.0f, 0.0f, 1.0f,1.52f, 0.0f },
-            // 오른쪽 tall — 완전 거울 (metallic=1, rough≈0)
-            { basePath+"cube.obj", { 4.5f, 2.1f,  -6}, {3.5f, 6.0f, 3.5f}, {0.9f, 0.9f, 0.9f}, 0.02f,1.0f, 0.0f, 1.5f, 0.0f },
-            // 중앙 — 토끼 받침대 (center_y = −0.9+1 = 0.1, top=1.1)
-            { basePath+"cube.obj", {  0,   0.1f,  -5}, {3.0f, 2.0f, 3.0f}, {0.9f, 0.9f, 0.9f}, 0.8f, 0.0f, 0.0f, 1.5f, 0.0f },
-            // 왼쪽 앞 — 황금 거친 금속 (mode1: RT shadow + Disney BRDF)
-            { basePath+"cube.obj", { -6,  -0.15f,-2.5f},{2.0f, 1.5f, 2.0f},{1.0f,0.77f,0.34f}, 0.4f, 1.0f, 0.0f, 1.5f, 0.0f, 1 },
-            // 오른쪽 앞 — 서리 유리 (Frosted Glass, specTrans=0.9, rough=0.3)
-            { basePath+"cube.obj", {  6,  -0.15f,-2.5f},{2.0f, 1.5f, 2.0f},{0.9f, 0.9f, 1.0f}, 0.3f, 0.0f, 0.9f, 1.5f, 0.0f },
-            // ── 토끼 (받침대 위) ───────────────────────────────────────────────────────────────
-            // 받침대 top=1.1, bunny Y반높이(scale=8)≈0.62 → center_y≈1.72
-            { basePath+"bunny.obj",{  0,   1.7f,  -5}, {8.0f, 8.0f, 8.0f}, {0.9f, 0.9f, 0.9f}, 0.1f, 0.0f, 0.0f, 1.5f, 0.0f },
-        };
+        // Cornell Box + 다양한 매질 박스 씬 (PrismScene.cpp, CPU 레퍼런스 렌더러와 공유)
+        std::vector<Prism::SceneObject> scene = Prism::makeCornellScene(basePath);
 
         std::vector<Prism::RTObject>         rtObjects;
+        std::vector<uint32_t>                rtMeshIndices;   // rtObjects 순, BLAS 압축 뒤 주소 다시 읽기용
         std::vector<Prism::InstanceMaterial> materials;
         std::vector<Prism::ObjDesc>          objDescs;
+        std::vector<Prism::SceneObject>      loadedObjects;   // materials 순 (메시 로드 실패는 빠짐)
 
+        // 씬 전체의 정점/인덱스 업로드와 BLAS 빌드를 한 번에 제출
+        mRTPipeline->beginUploadBatch();
         for (size_t i = 0; i < scene.size(); i++) {
             auto& obj = scene[i];
 
             // 메시 로드 (같은 OBJ면 OGRE 메시 재사용)
-            Ogre::MeshPtr mesh = loadMeshFromObj(obj.modelPath, vaoMgr);
-            if (!mesh) continue;
+            LoadedMesh loaded = loadMeshFromObj(obj.modelPath, vaoMgr, mRTPipeline);
+            if (!loaded.mesh) continue;
+            Ogre::MeshPtr mesh = loaded.mesh;
 
             // OGRE SceneNode (래스터 패스 / G-Buffer 생성용)
             auto item = mSceneMgr->createItem(mesh);
             auto node = mSceneMgr->getRootSceneNode(Ogre::SCENE_DYNAMIC)->createChildSceneNode();
             if (item->getParentSceneNode()) item->detachFromParent();
             node->attachObject(item);
-            node->setPosition(obj.position);
-            node->setScale(obj.scale);
+            node->setPosition(ToOgre(obj.position));
+            node->setScale(ToOgre(obj.scale));
 
             // ── G-Buffer용 PBS 데이터블록 설정 ─────────────────────────────
             // roughness / metallic 을 HLMS PBS 에 주입 → custom_ps_posExecution 에서
@@ -536,12 +388,12 @@ public:
                 item->setDatablock(db);
             }
 
-            // BLAS 빌드 (같은 OBJ 경로면 캐시)
-            uint32_t meshIdx = mRTPipeline->buildBLAS(mesh, obj.modelPath);
+            // BLAS (loadMeshFromObj 가 배치에 넣음, 같은 OBJ 경로면 공유)
+            uint32_t meshIdx = loaded.blasIdx;
 
             // TRS Transform → Ogre::Matrix4
             Ogre::Matrix4 transform = Ogre::Matrix4::IDENTITY;
-            transform.makeTransform(obj.position, obj.scale, Ogre::Quaternion::IDENTITY);
+            transform.makeTransform(ToOgre(obj.position), ToOgre(obj.scale), Ogre::Quaternion::IDENTITY);
 
             // RT 오브젝트
             Prism::RTObject rtObj;
@@ -549,26 +401,20 @@ public:
             rtObj.blasAddress  = mRTPipeline->getBLASAddress(meshIdx);
             rtObj.transform    = transform;
             rtObj.customIndex  = (uint32_t)i;
+            rtObj.node         = node;   // 노드를 움직이면 다음 프레임 TLAS UPDATE 에 반영
             // emissive 오브젝트(면광원)는 shadow ray에서 제외: mask=0x02
             // shadow ray cullMask=0xFD (0xFF & ~0x02) 로 면광원을 건너뜀
             rtObj.instanceMask = (obj.emissive > 0.0f) ? 0x02u : 0xFFu;
             rtObjects.push_back(rtObj);
+            rtMeshIndices.push_back(meshIdx);
 
             // Material
-            Prism::InstanceMaterial mat{};
-            mat.albedo[0] = obj.albedo.x; mat.albedo[1] = obj.albedo.y;
-            mat.albedo[2] = obj.albedo.z; mat.albedo[3] = 1.0f;
-            mat.pbrParams1[0] = obj.emissive;  mat.pbrParams1[1] = obj.roughness;
-            mat.pbrParams1[2] = obj.metallic;  mat.pbrParams1[3] = 0.0f;
-            mat.pbrParams2[0] = obj.specTrans; mat.pbrParams2[1] = obj.ior;
-            mat.pbrParams2[2] = (float)obj.renderMode;   // 0=풀PT  1=RTshadow+BRDF  2=GBuffer+RTshadow
-            materials.push_back(mat);
+            materials.push_back(Prism::makeInstanceMaterial(obj));
+            loadedObjects.push_back(obj);
+            mModeItems.push_back(item);
 
             // ObjDesc (셰이더에서 정점/인덱스 직접 접근)
-            Prism::ObjDesc desc;
-            desc.vertexAddress = mRTPipeline->getMeshVertexAddress(meshIdx);
-            desc.indexAddress  = mRTPipeline->getMeshIndexAddress(meshIdx);
-            objDescs.push_back(desc);
+            objDescs.push_back(mRTPipeline->getMeshObjDesc(meshIdx));
         }
 
         // ── OGRE 씬 라이트 (G-Buffer 래스터용) ─────────────────────────────────────
@@ -588,15 +434,27 @@ public:
         }
 
         // TLAS, 씬 버퍼, Descriptor Set 구성
+        mRTPipeline->flushUploadBatch();
+        // flush 에서 BLAS 가 압축되어 옮겨졌을 수 있음
+        for (size_t k = 0; k < rtObjects.size(); k++)
+            rtObjects[k].blasAddress = mRTPipeline->getBLASAddress(rtMeshIndices[k]);
+        mRTPipeline->logASMemoryReport();
         mRTPipeline->buildTLAS(rtObjects);
+
+        // 면광원 삼각형 (+ 해석적 점광원) → 광원 버퍼 + light BVH. 재질 pbrParams2.w 에 광원 오프셋 기록
+        Prism::LightSet lightSet = Prism::buildLightSet(scene, {});
+        Prism::applyLightOffsets(lightSet, materials);
         mRTPipeline->createSceneBuffers(materials, objDescs);
+        mRTPipeline->createLightBuffers(lightSet);
+        mModeScheduler.setObjects(loadedObjects);
         mRTPipeline->createDescriptorSet();
 
         // 카메라 초기 위치 (Cornell Box 앞에서 바라보기)
         // OGRE Next 3.0: SceneNode::lookAt() = ASSERT, Camera::lookAt() = roll 뒤집힘
         // → 표준 lookAt 행렬로 Quaternion 직접 계산
         {
-            Ogre::Vector3 eye(0, 7, 15), target(0, 5, 0), worldUp(0, 1, 0);
+            Prism::SceneCamera cam = Prism::makeCornellCamera();
+            Ogre::Vector3 eye = ToOgre(cam.eye), target = ToOgre(cam.target), worldUp = ToOgre(cam.up);
             Ogre::Vector3 zAxis = (eye - target).normalisedCopy(); // -forward (카메라는 -Z forward)
             Ogre::Vector3 xAxis = worldUp.crossProduct(zAxis).normalisedCopy();
             Ogre::Vector3 yAxis = zAxis.crossProduct(xAxis);
@@ -610,6 +468,14 @@ public:
         }
     }
 
+    // 스케줄러 배정 (꺼져 있으면 손으로 정한 모드) 을 재질 버퍼에 반영. 모드가 바뀌면 누적 history 는 맞지 않으므로 새로 시작
+    void applyRenderModes() {
+        const std::vector<int>& modes = mModeScheduler.getModes();
+        for (size_t k = 0; k < modes.size(); k++)
+            mRTPipeline->setInstanceRenderMode((uint32_t)k, modes[k]);
+        mRTPipeline->resetHistory();
+    }
+
     void run() {
         bool bQuit = false;
         SDL_Event evt;
@@ -628,6 +494,43 @@ public:
             while (SDL_PollEvent(&evt)) {
                 if (evt.type == SDL_QUIT || (evt.type == SDL_KEYDOWN && evt.key.keysym.sym == SDLK_ESCAPE))
                     bQuit = true;
+                // N: 디노이저 켜기/끄기 (끄면 raygen 누적 결과가 그대로 보임)
+                if (evt.type == SDL_KEYDOWN && evt.key.keysym.sym == SDLK_n && mDenoiser) {
+                    mDenoiser->setEnabled(!mDenoiser->isEnabled());
+                    Ogre::LogManager::getSingleton().logMessage(
+                        mDenoiser->isEnabled() ? "[PRISM] Denoiser ON" : "[PRISM] Denoiser OFF");
+                }
+                // V: 적응형 샘플링 켜기/끄기 (끄면 모든 픽셀이 프레임당 1 경로)
+                if (evt.type == SDL_KEYDOWN && evt.key.keysym.sym == SDLK_v && mRTPipeline) {
+                    Prism::AdaptiveSamplingParams adaptive = mRTPipeline->getAdaptiveSampling();
+                    adaptive.enabled = !adaptive.enabled;
+                    mRTPipeline->setAdaptiveSampling(adaptive);
+                    Ogre::LogManager::getSingleton().logMessage(
+                        adaptive.enabled ? "[PRISM] Adaptive sampling ON" : "[PRISM] Adaptive sampling OFF");
+                }
+                // R: Russian roulette 켜기/끄기 (끄면 경로가 재질별 깊이 / maxBounces 까지 항상 진행)
+                if (evt.type == SDL_KEYDOWN && evt.key.keysym.sym == SDLK_r && mRTPipeline) {
+                    Prism::PathTerminationParams path = mRTPipeline->getPathTermination();
+                    path.russianRoulette = !path.russianRoulette;
+                    mRTPipeline->setPathTermination(path);
+                    Ogre::LogManager::getSingleton().logMessage(
+                        path.russianRoulette ? "[PRISM] Russian roulette ON" : "[PRISM] Russian roulette OFF");
+                }
+                // F: wavefront 경로 추적 켜기/끄기 (같은 이미지, 단계별 커널 + 재질 정렬 큐. 켜면 픽셀당 프레임당 1 경로)
+                if (evt.type == SDL_KEYDOWN && evt.key.keysym.sym == SDLK_f && mWavefront) {
+                    mWavefront->setEnabled(!mWavefront->isEnabled());
+                    Ogre::LogManager::getSingleton().logMessage(
+                        mWavefront->isEnabled() ? "[PRISM] Wavefront ON" : "[PRISM] Wavefront OFF");
+                }
+                // M: 렌더 모드 스케줄러 켜기/끄기 (끄면 SceneObject::renderMode 로 되돌림)
+                if (evt.type == SDL_KEYDOWN && evt.key.keysym.sym == SDLK_m && mRTPipeline) {
+                    Prism::RenderModeBudget budget = mModeScheduler.getBudget();
+                    budget.enabled = !budget.enabled;
+                    mModeScheduler.setBudget(budget);
+                    applyRenderModes();
+                    Ogre::LogManager::getSingleton().logMessage(
+                        budget.enabled ? "[PRISM] Render mode scheduler ON" : "[PRISM] Render mode scheduler OFF");
+                }
                 if (evt.type == SDL_MOUSEBUTTONDOWN && evt.button.button == SDL_BUTTON_RIGHT)
                     bRightMouseDown = true;
                 if (evt.type == SDL_MOUSEBUTTONUP && evt.button.button == SDL_BUTTON_RIGHT)
@@ -653,16 +556,75 @@ public:
                 bMoved = true;
             }
 
-            // 이동 시 누적 카운터 리셋 → 노이즈 누적 재시작
-            if (bMoved) frameCount = 0;
-            else frameCount++;
+            // 이동해도 누적은 재투영으로 이어감 (frameCount 는 RNG 시드용으로 계속 증가)
+            frameCount++;
 
             if (mRTPipeline)
                 mRTPipeline->updateCameraUBO(
                     mCamera->getViewMatrix(),
                     mCamera->getProjectionMatrixWithRSDepth(),
                     mCamNode->getPosition(),
-                    frameCount);
+                    frameCount,
+                    bMoved);
+
+            // 렌더 모드: 매 프레임 trace 시간을 쌓고, interval 프레임마다 화면 점유율로 다시 배정
+            if (mRTPipeline) {
+                mModeScheduler.recordFrameTime(mRTPipeline->getTraceTimeMs());
+                const Prism::RenderModeBudget& budget = mModeScheduler.getBudget();
+                if (budget.enabled && frameCount % std::max(budget.interval, 1) == 0) {
+                    Ogre::Matrix4 viewProj = mCamera->getProjectionMatrixWithRSDepth() * mCamera->getViewMatrix();
+                    float vp[16];
+                    for (int r = 0; r < 4; r++)
+                        for (int c = 0; c < 4; c++) vp[r * 4 + c] = float(viewProj[r][c]);
+                    std::vector<float> coverage(mModeItems.size());
+                    for (size_t k = 0; k < mModeItems.size(); k++) {
+                        Ogre::Aabb aabb = mModeItems[k]->getWorldAabbUpdated();
+                        Ogre::Vector3 lo = aabb.getMinimum(), hi = aabb.getMaximum();
+                        coverage[k] = Prism::projectedCoverage(vp, { lo.x, lo.y, lo.z }, { hi.x, hi.y, hi.z });
+                    }
+                    if (mModeScheduler.evaluate(coverage, mRTPipeline->getPathStats().averageLength(),
+                                                mRTPipeline->getPathTermination().maxBounces,
+                                                mRTPipeline->getRTWidth() * mRTPipeline->getRTHeight()))
+                        applyRenderModes();
+                }
+            }
+
+            // 프레임 통계 (몇 프레임 전 GPU 결과) 를 2 초 정도마다 로그
+            if (mRTPipeline && frameCount % 120 == 0) {
+                if (mRTPipeline->getAdaptiveSampling().enabled) {
+                    const Prism::AdaptiveStats& stats = mRTPipeline->getAdaptiveStats();
+                    Ogre::LogManager::getSingleton().logMessage(
+                        "[PRISM] Adaptive: " + Ogre::StringConverter::toString(stats.convergedPercent(), 3)
+                        + "% pixels converged, " + Ogre::StringConverter::toString(stats.pathsPerPixel(), 3) + " paths/pixel");
+                }
+                const Prism::PathStats& paths = mRTPipeline->getPathStats();
+                Ogre::LogManager::getSingleton().logMessage(
+                    "[PRISM] Paths: average length " + Ogre::StringConverter::toString(paths.averageLength(), 3)
+                    + " segments, " + Ogre::StringConverter::toString(paths.roulettePercent(), 3) + "% ended by roulette");
+                if (mModeScheduler.getBudget().enabled) {
+                    const Prism::RenderModeStats& rm = mModeScheduler.getStats();
+                    Ogre::LogManager::getSingleton().logMessage(
+                        "[PRISM] Render modes: PT " + Ogre::StringConverter::toString(rm.objectsPerMode[Prism::RENDER_MODE_PATH_TRACE])
+                        + ", RT shadow " + Ogre::StringConverter::toString(rm.objectsPerMode[Prism::RENDER_MODE_RT_SHADOW])
+                        + ", raster " + Ogre::StringConverter::toString(rm.objectsPerMode[Prism::RENDER_MODE_RASTER])
+                        + " objects, trace " + Ogre::StringConverter::toString(rm.measuredMs, 3)
+                        + " ms (predicted " + Ogre::StringConverter::toString(rm.predictedMs, 3)
+                        + ", target " + Ogre::StringConverter::toString(mModeScheduler.getBudget().targetMs, 3)
+                        + "), " + Ogre::StringConverter::toString(rm.changes) + " changes");
+                }
+                if (mWavefront && mWavefront->isEnabled()) {
+                    const Prism::WavefrontStats& wf = mWavefront->getStats();
+                    Ogre::String bins;
+                    for (uint32_t b = 0; b < Prism::WAVEFRONT_BIN_COUNT; b++) {
+                        bins += Ogre::String(b ? ", " : "") + Prism::wavefrontBinName(b) + " "
+                              + Ogre::StringConverter::toString(wf.binPercent(b), 3) + "%";
+                    }
+                    Ogre::LogManager::getSingleton().logMessage(
+                        "[PRISM] Wavefront: " + Ogre::StringConverter::toString(wf.bounces) + " bounce passes, "
+                        + Ogre::StringConverter::toString(size_t(wf.raysTraced)) + " queued rays, "
+                        + Ogre::StringConverter::toString(size_t(wf.shadowRays)) + " shadow rays (" + bins + ")");
+                }
+            }
 
             mSceneMgr->updateSceneGraph();
             if (!mRoot->renderOneFrame()) break;